@@ -0,0 +1,62 @@
+/**
+ * Copyright 2023 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+package com.nxp.allocprofiler;
+
+/**
+ * Control of the sampling allocation profiler of the BSP (alloc_profiler.h). The profiler samples the allocations
+ * every N bytes on average and estimates the allocations of each (type, method). The top allocation sites are printed
+ * on the debug console by {@link #dump()}.
+ */
+public class AllocProfilerNatives {
+
+	/** Index of the bytes allocated while the profiler runs in the values of {@link #getStats(long[])}. */
+	public static final int ALLOCATED = 0;
+	/** Index of the allocation rate in bytes per second. */
+	public static final int RATE = 1;
+	/** Index of the number of samples. */
+	public static final int SAMPLES = 2;
+	/** Index of the number of samples not aggregated (too many allocation sites). */
+	public static final int DROPPED = 3;
+	/** Number of values of {@link #getStats(long[])}. */
+	public static final int STATS = 4;
+
+	private AllocProfilerNatives() {
+		// natives only
+	}
+
+	/**
+	 * Starts the profiler.
+	 *
+	 * @param interval
+	 *            the mean number of bytes allocated between two samples, 0 for the default interval.
+	 */
+	public native static void start(int interval);
+
+	/**
+	 * Stops the profiler. The statistics are kept.
+	 */
+	public native static void stop();
+
+	/**
+	 * Clears the statistics.
+	 */
+	public native static void reset();
+
+	/**
+	 * Gets the statistics.
+	 *
+	 * @param stats
+	 *            the array to fill ({@link #STATS} values).
+	 * @return the number of values, -1 when the array is too small.
+	 */
+	public native static int getStats(long[] stats);
+
+	/**
+	 * Prints the statistics and the top allocation sites on the debug console.
+	 */
+	public native static void dump();
+
+}
@@ -17,11 +17,15 @@ import ej.microvg.VectorImage;
 import ej.mwt.animation.Animation;
 import ej.mwt.animation.Animator;
 
+import com.nxp.vectorimage.CompiledVectorImageNatives;
+
 /**
  *
  */
 public class AnimatedMascot {
 
+	private static final String MASCOT = "/images/mascot.xml"; //$NON-NLS-1$
+
 	private long startTime;
 
 	/**
@@ -42,10 +46,22 @@ public class AnimatedMascot {
 
 		final Matrix matrix = new Matrix();
 
-		final VectorImage mascot = VectorImage.getImage("/images/mascot.xml"); //$NON-NLS-1$
-
-		// Prepare matrix to scale the image to the display size
-		matrix.setScale(display.getWidth() / mascot.getWidth(), display.getHeight() / mascot.getHeight());
+		// Draw the image compiled with the BSP when available (no parsing, no allocation)
+		final int compiledMascot = CompiledVectorImageNatives.find(MASCOT);
+		final VectorImage mascot;
+		final int duration;
+		if (compiledMascot >= 0) {
+			mascot = null;
+			duration = CompiledVectorImageNatives.getDuration(compiledMascot);
+			// Prepare matrix to scale the image to the display size
+			matrix.setScale(display.getWidth() / CompiledVectorImageNatives.getWidth(compiledMascot),
+					display.getHeight() / CompiledVectorImageNatives.getHeight(compiledMascot));
+		} else {
+			mascot = VectorImage.getImage(MASCOT);
+			duration = (int) mascot.getDuration();
+			// Prepare matrix to scale the image to the display size
+			matrix.setScale(display.getWidth() / mascot.getWidth(), display.getHeight() / mascot.getHeight());
+		}
 
 		Animator animator = new Animator();
 		this.startTime = Util.platformTimeMillis();
@@ -61,13 +77,17 @@ public class AnimatedMascot {
 				int elapsed = (int) (currentTimeMillis - AnimatedMascot.this.startTime);
 
 				// Draw the image
-				VectorGraphicsPainter.drawAnimatedImage(g, mascot, matrix, elapsed);
+				if (mascot == null) {
+					CompiledVectorImageNatives.draw(g, compiledMascot, matrix, elapsed, GraphicsContext.OPAQUE);
+				} else {
+					VectorGraphicsPainter.drawAnimatedImage(g, mascot, matrix, elapsed);
+				}
 
 				// Flush the display
 				display.flush();
 
 				// Update startTime at the end of animation to loop back to start
-				if (mascot.getDuration() < (elapsed)) {
+				if (duration < (elapsed)) {
 					AnimatedMascot.this.startTime = Util.platformTimeMillis();
 				}
 				return true;
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2023 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+package com.nxp.jvmstats;
+
+/**
+ * CPU accounting of the Java threads and GC pause statistics measured by the BSP
+ * (jvm_stats.h). The times are in microseconds.
+ */
+public class JvmStatsNatives {
+
+	/** Index of the running time in the values of {@link #getThreadStats(int, long[])}. */
+	public static final int THREAD_RUNNING_TIME = 0;
+	/** Index of the number of times the thread has been scheduled. */
+	public static final int THREAD_SCHEDULED = 1;
+	/** Index of the average ready to running latency. */
+	public static final int THREAD_LATENCY_AVERAGE = 2;
+	/** Index of the worst ready to running latency. */
+	public static final int THREAD_LATENCY_MAX = 3;
+	/** Number of values of {@link #getThreadStats(int, long[])}. */
+	public static final int THREAD_STATS = 4;
+
+	/** Index of the number of GC pauses in the values of {@link #getGcStats(long[])}. */
+	public static final int GC_COUNT = 0;
+	/** Index of the cumulated GC pauses. */
+	public static final int GC_TOTAL_TIME = 1;
+	/** Index of the worst GC pause. */
+	public static final int GC_MAX_TIME = 2;
+	/** Number of values of {@link #getGcStats(long[])}. */
+	public static final int GC_STATS = 3;
+
+	private JvmStatsNatives() {
+		// natives only
+	}
+
+	/**
+	 * Gets the identifiers of the threads.
+	 *
+	 * @param ids
+	 *            the array to fill.
+	 * @return the number of identifiers.
+	 */
+	public native static int getThreadIds(int[] ids);
+
+	/**
+	 * Gets the statistics of a thread.
+	 *
+	 * @param threadId
+	 *            the thread identifier.
+	 * @param stats
+	 *            the array to fill ({@link #THREAD_STATS} values).
+	 * @return the number of values, -1 when the thread is unknown.
+	 */
+	public native static int getThreadStats(int threadId, long[] stats);
+
+	/**
+	 * Gets the GC statistics.
+	 *
+	 * @param stats
+	 *            the array to fill ({@link #GC_STATS} values).
+	 * @return the number of values, -1 when the array is too small.
+	 */
+	public native static int getGcStats(long[] stats);
+
+	/**
+	 * Gets the GC pause histogram: the element i counts the pauses from 2^i to 2^(i+1) microseconds.
+	 *
+	 * @param buckets
+	 *            the array to fill.
+	 * @return the number of buckets.
+	 */
+	public native static int getGcHistogram(int[] buckets);
+
+	/**
+	 * Gets the worst GC pauses, the longest first.
+	 *
+	 * @param durations
+	 *            the durations of the pauses.
+	 * @param times
+	 *            the start times of the pauses in milliseconds ({@code Util.platformTimeMillis()}).
+	 * @return the number of pauses.
+	 */
+	public native static int getWorstGcPauses(long[] durations, long[] times);
+
+	/**
+	 * Clears the statistics.
+	 */
+	public native static void reset();
+
+}
@@ -0,0 +1,87 @@
+/**
+ * Copyright 2023 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+package com.nxp.vectorimage;
+
+import ej.microui.display.GraphicsContext;
+import ej.microvg.Matrix;
+
+/**
+ * Drawing of the animated vector images compiled with the BSP (vg_blob.h). The images listed in the BSP build are
+ * compiled into read-only blobs by vg_compiler.py: drawing them does not parse the image nor allocate anything. The
+ * images that have not been compiled are drawn with {@link ej.microvg.VectorGraphicsPainter}.
+ */
+public class CompiledVectorImageNatives {
+
+	private CompiledVectorImageNatives() {
+		// natives only
+	}
+
+	/**
+	 * Finds a compiled image.
+	 *
+	 * @param name
+	 *            the resource name (e.g. "/images/mascot.xml").
+	 * @return the image, -1 when the image has not been compiled.
+	 */
+	public static int find(String name) {
+		byte[] bytes = name.getBytes();
+		byte[] cName = new byte[bytes.length + 1];
+		System.arraycopy(bytes, 0, cName, 0, bytes.length);
+		return find(cName);
+	}
+
+	/**
+	 * Draws a compiled image at a given time of its animation.
+	 *
+	 * @param g
+	 *            the graphics context.
+	 * @param image
+	 *            the image returned by {@link #find(String)}.
+	 * @param matrix
+	 *            the transformation of the image.
+	 * @param elapsed
+	 *            the time in the animation in milliseconds.
+	 * @param alpha
+	 *            the opacity (0 to 255).
+	 * @return 0 or a negative error code.
+	 */
+	public static int draw(GraphicsContext g, int image, Matrix matrix, int elapsed, int alpha) {
+		return draw(g.getSNIContext(), g.getTranslationX(), g.getTranslationY(), matrix.getSNIContext(), image,
+				elapsed, alpha);
+	}
+
+	private native static int find(byte[] name);
+
+	/**
+	 * Gets the width of a compiled image.
+	 *
+	 * @param image
+	 *            the image returned by {@link #find(String)}.
+	 * @return the width.
+	 */
+	public native static float getWidth(int image);
+
+	/**
+	 * Gets the height of a compiled image.
+	 *
+	 * @param image
+	 *            the image returned by {@link #find(String)}.
+	 * @return the height.
+	 */
+	public native static float getHeight(int image);
+
+	/**
+	 * Gets the duration of the animation of a compiled image.
+	 *
+	 * @param image
+	 *            the image returned by {@link #find(String)}.
+	 * @return the duration in milliseconds.
+	 */
+	public native static int getDuration(int image);
+
+	private native static int draw(byte[] gc, int x, int y, float[] matrix, int image, int elapsed, int alpha);
+
+}
@@ -0,0 +1,285 @@
+#!/usr/bin/env python3
+#
+# Copyright 2023 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""Selects the hottest functions of the BSP to copy them from the QSPI flash
+(execute in place) to the SRAM.
+
+The functions are ranked by profile samples per byte of code and packed into
+an SRAM budget. The selection is written as a linker script fragment that is
+included by the section ".ramfunc_hot" of mimxrt595_freertos-bsp_Debug.ld; the
+startup code copies this section to the SRAM with the initialized data.
+
+Inputs:
+- the map file of the build (-Xlinker -Map, see flags.cmake); the sources must
+  be compiled with -ffunction-sections so that each function has its own input
+  section ".text.<function>",
+- one or more profiles, in one of these text formats:
+  - PC samples: one sample per line, "<address>" or "<address> <count>" (hex
+    addresses, e.g. a J-Link or pyOCD PC sampling log),
+  - function samples: "<function>,<count>" lines (e.g. the CSV export of a
+    code profile).
+  Lines starting with '#' are ignored.
+
+The profile must have been captured with the build of the map file: the PC
+samples are resolved with the addresses of the map file. Functions that have
+already been moved to the SRAM by a previous selection are resolved the same
+way and stay candidates.
+
+The expected gain is an estimate: the share of the samples spent in the
+selected functions, and the resulting speedup when this code runs "speedup"
+times faster from the SRAM than from the flash (Amdahl's law). Measure the
+real gain on the board.
+
+Example:
+  hot_code.py --map debug/mimxrt595_freertos-bsp.map --profile pc.log \\
+      --budget 32K --output mimxrt595_freertos-bsp_Debug_hot_code.ld
+"""
+
+import argparse
+import bisect
+import collections
+import fnmatch
+import os
+import re
+import sys
+
+# Input section of a function placed by the linker, on one line or split on two
+# lines when the section name is long.
+SECTION_LINE = re.compile(r'^ (\.text\.\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$')
+SECTION_NAME_LINE = re.compile(r'^ (\.text\.\S+)$')
+SECTION_ADDRESS_LINE = re.compile(r'^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$')
+
+# First line of the placed sections (the discarded sections are listed before).
+MEMORY_MAP_START = 'Linker script and memory map'
+
+# Object file in an archive: "path/libname.a(member.o)".
+ARCHIVE_MEMBER = re.compile(r'^(.*\.a)\((.+)\)$')
+
+# Code alignment assumed for each moved function.
+ALIGNMENT = 4
+
+Section = collections.namedtuple('Section', 'name function address size obj')
+
+
+class Candidate(object):
+    """A function that can be moved and its samples."""
+
+    def __init__(self, section):
+        self.section = section
+        self.samples = 0
+
+    @property
+    def size(self):
+        # size taken in the SRAM, alignment included
+        return (self.section.size + ALIGNMENT - 1) & ~(ALIGNMENT - 1)
+
+    @property
+    def density(self):
+        return float(self.samples) / self.size
+
+
+def parse_size(text):
+    """Parses a size in bytes with an optional K or M suffix."""
+    match = re.match(r'^\s*(\d+)\s*([kKmM]?)\s*$', text)
+    if match is None:
+        raise argparse.ArgumentTypeError('invalid size: %s' % text)
+    factor = {'': 1, 'k': 1024, 'm': 1024 * 1024}[match.group(2).lower()]
+    return int(match.group(1)) * factor
+
+
+def parse_map(lines):
+    """Returns the function input sections placed by the linker."""
+    sections = []
+    placed = False
+    pending = None
+    for line in lines:
+        line = line.rstrip('\r\n')
+        if not placed:
+            placed = line.startswith(MEMORY_MAP_START)
+            continue
+        if pending is not None:
+            match = SECTION_ADDRESS_LINE.match(line)
+            if match is not None:
+                _add_section(sections, pending, match.group(1), match.group(2), match.group(3))
+            pending = None
+            continue
+        match = SECTION_LINE.match(line)
+        if match is not None:
+            _add_section(sections, match.group(1), match.group(2), match.group(3), match.group(4))
+            continue
+        match = SECTION_NAME_LINE.match(line)
+        if match is not None:
+            pending = match.group(1)
+    return sections
+
+
+def _add_section(sections, name, address, size, obj):
+    address = int(address, 16)
+    size = int(size, 16)
+    if size > 0:
+        # ".text.<function>"
+        sections.append(Section(name, name[len('.text.'):], address, size, obj.strip()))
+
+
+def parse_profile(lines):
+    """Returns the PC samples ({address: count}) and the function samples
+    ({function: count}) of a profile."""
+    pcs = collections.Counter()
+    functions = collections.Counter()
+    for number, line in enumerate(lines, 1):
+        line = line.strip()
+        if not line or line.startswith('#'):
+            continue
+        if ',' in line:
+            name, _, count = line.rpartition(',')
+            try:
+                functions[name.strip()] += int(count)
+            except ValueError:
+                # CSV header
+                continue
+        else:
+            fields = line.split()
+            try:
+                address = int(fields[0], 16)
+                count = int(fields[1]) if len(fields) > 1 else 1
+            except (ValueError, IndexError):
+                raise ValueError('line %d: invalid sample: %s' % (number, line))
+            pcs[address] += count
+    return pcs, functions
+
+
+def attribute_samples(sections, pcs, functions):
+    """Returns the candidates with their samples, and the total and unresolved
+    numbers of samples."""
+    candidates = [Candidate(section) for section in sorted(sections, key=lambda s: s.address)]
+    starts = [c.section.address for c in candidates]
+    total = 0
+    unresolved = 0
+
+    for address, count in pcs.items():
+        total += count
+        # clear the Thumb bit
+        address &= ~1
+        index = bisect.bisect_right(starts, address) - 1
+        if index >= 0 and address < candidates[index].section.address + candidates[index].section.size:
+            candidates[index].samples += count
+        else:
+            # in a section that cannot be moved (assembly, library without
+            # function sections, ROM) or outside the image
+            unresolved += count
+
+    by_function = collections.defaultdict(list)
+    for candidate in candidates:
+        by_function[candidate.section.function].append(candidate)
+    for function, count in functions.items():
+        total += count
+        matches = by_function.get(function)
+        if matches:
+            # static functions with the same name: share the samples
+            for candidate in matches:
+                candidate.samples += count // len(matches)
+        else:
+            unresolved += count
+
+    return candidates, total, unresolved
+
+
+def select(candidates, budget, excludes=()):
+    """Packs the densest candidates into the budget (greedy on the samples per
+    byte, a candidate that does not fit is skipped)."""
+    selection = []
+    used = 0
+    ranked = sorted((c for c in candidates if c.samples > 0), key=lambda c: (-c.density, c.section.address))
+    for candidate in ranked:
+        if any(fnmatch.fnmatchcase(candidate.section.function, pattern) for pattern in excludes):
+            continue
+        if used + candidate.size <= budget:
+            selection.append(candidate)
+            used += candidate.size
+    return selection, used
+
+
+def input_section(section):
+    """Returns the linker script input section description of a section."""
+    match = ARCHIVE_MEMBER.match(section.obj)
+    if match is not None:
+        pattern = '*%s:%s' % (os.path.basename(match.group(1)), match.group(2))
+    else:
+        pattern = '*%s' % os.path.basename(section.obj)
+    return '%s(%s)' % (pattern, section.name)
+
+
+def write_fragment(out, selection, budget, total):
+    out.write('/*\n')
+    out.write(' * Generated by projects/common/scripts/hot_code.py: do not edit.\n')
+    out.write(' * %d functions, %d bytes (budget %d bytes), %.1f%% of the samples.\n'
+              % (len(selection), sum(c.size for c in selection), budget, _share(selection, total) * 100.0))
+    out.write(' */\n')
+    for candidate in selection:
+        out.write('        %s\n' % input_section(candidate.section))
+
+
+def write_report(out, selection, used, budget, total, unresolved, speedup):
+    share = _share(selection, total)
+    out.write('%-40s %10s %8s %10s %8s\n' % ('function', 'samples', 'bytes', 'samples/B', 'cumul'))
+    cumulated = 0
+    for candidate in selection:
+        cumulated += candidate.samples
+        out.write('%-40s %10d %8d %10.3f %7.1f%%\n' % (candidate.section.function[:40], candidate.samples,
+                  candidate.size, candidate.density, 100.0 * cumulated / total if total else 0.0))
+    out.write('\n')
+    out.write('selected:   %d functions, %d / %d bytes of SRAM\n' % (len(selection), used, budget))
+    out.write('samples:    %d, %d outside the movable functions\n' % (total, unresolved))
+    out.write('coverage:   %.1f%% of the samples in the selected functions\n' % (share * 100.0))
+    out.write('estimate:   %.1f%% less time if the selected code runs %.1fx faster from SRAM\n'
+              % (expected_gain(share, speedup) * 100.0, speedup))
+
+
+def expected_gain(share, speedup):
+    """Returns the share of the time saved (Amdahl's law)."""
+    return 1.0 - ((1.0 - share) + (share / speedup))
+
+
+def _share(selection, total):
+    return float(sum(c.samples for c in selection)) / total if total else 0.0
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('--map', required=True, help='map file of the build')
+    parser.add_argument('--profile', required=True, action='append', help='PC or function samples (repeatable)')
+    parser.add_argument('--budget', type=parse_size, default=32 * 1024, help='SRAM budget in bytes (default 32K)')
+    parser.add_argument('--exclude', action='append', default=[], help='function name pattern never moved (repeatable)')
+    parser.add_argument('--speedup', type=float, default=2.0, help='assumed speedup of the moved code (default 2.0)')
+    parser.add_argument('--output', help='linker script fragment to write (default: none, report only)')
+    args = parser.parse_args(argv)
+
+    with open(args.map) as f:
+        sections = parse_map(f)
+    if not sections:
+        parser.error('no function section in %s (compile with -ffunction-sections)' % args.map)
+
+    pcs = collections.Counter()
+    functions = collections.Counter()
+    for path in args.profile:
+        with open(path) as f:
+            file_pcs, file_functions = parse_profile(f)
+        pcs.update(file_pcs)
+        functions.update(file_functions)
+
+    candidates, total, unresolved = attribute_samples(sections, pcs, functions)
+    selection, used = select(candidates, args.budget, args.exclude)
+
+    write_report(sys.stdout, selection, used, args.budget, total, unresolved, args.speedup)
+    if args.output:
+        with open(args.output, 'w') as f:
+            write_fragment(f, selection, args.budget, total)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
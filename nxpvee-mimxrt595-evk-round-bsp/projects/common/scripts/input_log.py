@@ -0,0 +1,254 @@
+#!/usr/bin/env python3
+#
+# Copyright 2023 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""Decodes the input log of the BSP: timeline of the MicroUI FIFO and input latencies.
+
+See projects/microej/ui/inc/input_log.h for the format. The input is the RTT
+stream of the channel INPUT_LOG_RTT_CHANNEL (e.g. saved with
+"JLinkRTTLogger -Device MIMXRT595S_M33 -If SWD -Speed 4000 -RTTChannel 4 input.bin").
+
+Each event added to the FIFO is matched with the read of its first element by the
+application (the FIFO index is reused only once the element is read). The latency
+of an input event is split in:
+- sample -> add: from the input sample (touch interrupt) to the FIFO (touch task,
+  move coalescing); a replaced element restarts from the newer sample,
+- add -> read: waiting in the FIFO,
+- sample -> read: from the input sample to the application,
+- sample -> flush: from the input sample to the read of the next display flush
+  event, i.e. until the frame that shows the input is flushed.
+
+Example:
+  input_log.py input.bin --timeline
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC_HEADER = 0x48474C49
+MAGIC_CHUNK = 0x43474C49
+
+HEADER = struct.Struct('<4I')
+CHUNK = struct.Struct('<4I')
+RECORD = struct.Struct('<IIIHBB')
+
+KIND_INIT = 0
+KIND_EVENT = 1
+KIND_DATA = 2
+KIND_REPLACE = 3
+KIND_READ = 4
+KIND_FULL = 5
+KIND_NAMES = {KIND_INIT: 'init', KIND_EVENT: 'add', KIND_DATA: 'data', KIND_REPLACE: 'replace',
+              KIND_READ: 'read', KIND_FULL: 'lost'}
+
+# MicroUI event types (bits 24 to 31 of the first element of an event)
+EVENT_TYPES = {0x00: 'Command', 0x01: 'Buttons', 0x02: 'Pointer', 0x03: 'State', 0x05: 'CallSerially',
+               0x06: 'Stop', 0x07: 'Input', 0x08: 'Show', 0x09: 'Hide', 0x0b: 'Flush', 0x0c: 'ForceFlush',
+               0x0d: 'Repaint', 0x0e: 'RepaintCurrent', 0x0f: 'Switch'}
+INPUT_TYPES = (0x00, 0x01, 0x02, 0x03, 0x07)
+FLUSH_TYPES = (0x0b, 0x0c)
+
+STAGES = ('sample -> add', 'add -> read', 'sample -> read', 'sample -> flush')
+
+
+def read_stream(data):
+    """Yields the headers (version, size), the records (position, fields) and the
+    number of records dropped before each chunk."""
+    offset = 0
+    dropped = 0
+    record_size = RECORD.size
+    while offset + 4 <= len(data):
+        magic, = struct.unpack_from('<I', data, offset)
+        if magic == MAGIC_HEADER and offset + HEADER.size <= len(data):
+            _, version, size, record_size = HEADER.unpack_from(data, offset)
+            offset += HEADER.size
+            dropped = 0
+            yield ('header', version, size)
+        elif magic == MAGIC_CHUNK and offset + CHUNK.size <= len(data):
+            _, position, records, total_dropped = CHUNK.unpack_from(data, offset)
+            offset += CHUNK.size
+            if total_dropped != dropped:
+                yield ('dropped', (total_dropped - dropped) & 0xFFFFFFFF)
+                dropped = total_dropped
+            for index in range(records):
+                if offset + record_size > len(data):
+                    # truncated capture
+                    return
+                yield ('record', (position + index) & 0xFFFFFFFF, RECORD.unpack_from(data, offset))
+                offset += record_size
+        else:
+            # skip the bytes of a capture that did not start on a block
+            offset += 4
+
+
+def event_name(element):
+    event_type = element >> 24
+    name = EVENT_TYPES.get(event_type, 'User 0x%02x' % event_type)
+    if event_type in INPUT_TYPES:
+        name += ' (generator %d)' % ((element >> 16) & 0xFF)
+    return name
+
+
+class Decoder(object):
+    """Rebuilds the timeline and measures the latencies."""
+
+    def __init__(self, timeline):
+        self.timeline = timeline
+        self.latencies = dict((stage, []) for stage in STAGES)
+        self.records = 0
+        self.dropped = 0
+        self.lost = 0
+        self.unmatched = 0
+        self.reset()
+
+    def reset(self):
+        self.last_time = None
+        self.time_offset = 0
+        self.start = None
+        self.pending = {}   # FIFO index of the first element -> event
+        self.owner = {}     # FIFO index of a data element -> index of its event
+        self.current = None
+        self.unflushed = []  # input events read and not flushed yet
+
+    def unwrap(self, time):
+        """Returns the time in microseconds since the start of the capture (the
+        record times are 32-bit)."""
+        if self.last_time is not None and time < self.last_time and self.last_time - time > 0x80000000:
+            self.time_offset += 1 << 32
+        self.last_time = time
+        time += self.time_offset
+        if self.start is None:
+            self.start = time
+        return time - self.start
+
+    def source(self, time, source):
+        """Returns the sample time of a record, None when unknown."""
+        if source == 0:
+            return None
+        # the sample precedes the record by less than 2^31 us
+        return time - ((self.last_time - source) & 0xFFFFFFFF)
+
+    def add(self, stage, value):
+        if value is not None and value >= 0:
+            self.latencies[stage].append(value)
+
+    def print_line(self, time, text):
+        if self.timeline:
+            print('%12.3f ms  %s' % (time / 1000.0, text))
+
+    def on_header(self, version, size):
+        self.reset()
+        self.print_line(0, '--- start (version %d, %d records)' % (version, size))
+
+    def on_dropped(self, count):
+        self.dropped += count
+        # the FIFO indexes can no longer be matched
+        self.pending.clear()
+        self.owner.clear()
+        self.current = None
+        self.unflushed = []
+        if self.timeline:
+            print('%15s  --- %d records dropped' % ('', count))
+
+    def on_record(self, position, fields):
+        time, data, source, index, kind, remaining = fields
+        time = self.unwrap(time)
+        self.records += 1
+        text = '%-7s [%03d] 0x%08x' % (KIND_NAMES.get(kind, '?%d' % kind), index, data)
+
+        if kind == KIND_INIT:
+            self.pending.clear()
+            self.owner.clear()
+            text = 'init    FIFO of %d elements' % data
+        elif kind == KIND_FULL:
+            self.lost += 1
+            text += ' %s: FIFO full' % event_name(data)
+        elif kind == KIND_EVENT:
+            event = {'add': time, 'sample': self.source(time, source), 'element': data}
+            if index in self.pending:
+                self.unmatched += 1
+            self.pending[index] = event
+            self.owner.pop(index, None)
+            self.current = index
+            text += ' %s' % event_name(data)
+            if event['sample'] is not None:
+                text += ', sampled %.3f ms before' % ((time - event['sample']) / 1000.0)
+        elif kind == KIND_DATA:
+            if self.current is not None:
+                self.owner[index] = self.current
+        elif kind == KIND_REPLACE:
+            event = self.pending.get(self.owner.get(index, index))
+            sample = self.source(time, source)
+            if event is not None and sample is not None:
+                # the event carries the newer sample
+                event['sample'] = sample
+                event['add'] = time
+        elif kind == KIND_READ:
+            self.owner.pop(index, None)
+            event = self.pending.pop(index, None)
+            if event is not None:
+                event_type = event['element'] >> 24
+                text += ' %s' % event_name(event['element'])
+                if event_type in INPUT_TYPES:
+                    self.add('add -> read', time - event['add'])
+                    if event['sample'] is not None:
+                        self.add('sample -> add', event['add'] - event['sample'])
+                        self.add('sample -> read', time - event['sample'])
+                        self.unflushed.append(event['sample'])
+                        text += ', %.3f ms after the sample' % ((time - event['sample']) / 1000.0)
+                elif event_type in FLUSH_TYPES:
+                    for sample in self.unflushed:
+                        self.add('sample -> flush', time - sample)
+                    if self.unflushed:
+                        text += ', %d inputs shown %.3f ms after the oldest sample' % (
+                            len(self.unflushed), (time - min(self.unflushed)) / 1000.0)
+                    self.unflushed = []
+        self.print_line(time, text)
+
+    def summary(self):
+        lines = ['%d records, %d dropped by the ring, %d events lost by MicroUI (FIFO full)'
+                 % (self.records, self.dropped, self.lost)]
+        if self.unmatched:
+            lines.append('%d events added twice at the same FIFO index before being read' % self.unmatched)
+        lines.append('%-16s %7s %9s %9s %9s %9s' % ('latency (ms)', 'count', 'min', 'avg', 'p95', 'max'))
+        for stage in STAGES:
+            values = sorted(self.latencies[stage])
+            if values:
+                p95 = values[min(len(values) - 1, (len(values) * 95) // 100)]
+                lines.append('%-16s %7d %9.3f %9.3f %9.3f %9.3f' % (
+                    stage, len(values), values[0] / 1000.0, sum(values) / len(values) / 1000.0,
+                    p95 / 1000.0, values[-1] / 1000.0))
+            else:
+                lines.append('%-16s %7d' % (stage, 0))
+        return '\n'.join(lines)
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('input', help='RTT stream of the input log')
+    parser.add_argument('--timeline', action='store_true', help='print each record')
+    args = parser.parse_args(argv)
+
+    with open(args.input, 'rb') as f:
+        data = f.read()
+    if len(data) < 4:
+        parser.error('%s: empty capture' % args.input)
+
+    decoder = Decoder(args.timeline)
+    for item in read_stream(data):
+        if item[0] == 'header':
+            decoder.on_header(*item[1:])
+        elif item[0] == 'dropped':
+            decoder.on_dropped(item[1])
+        else:
+            decoder.on_record(*item[1:])
+    print(decoder.summary())
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
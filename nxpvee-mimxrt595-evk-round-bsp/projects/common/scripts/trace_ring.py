@@ -0,0 +1,305 @@
+#!/usr/bin/env python3
+#
+# Copyright 2023 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""Converts the binary trace ring of the BSP to the Chrome trace event format.
+
+The output (JSON) is opened by Perfetto (https://ui.perfetto.dev) and
+chrome://tracing. See projects/microej/trace/inc/trace_ring.h for the formats.
+
+Inputs, detected from their first bytes:
+- the RTT stream of the channel TRACE_RING_RTT_CHANNEL (e.g. saved with
+  "JLinkRTTLogger -Device MIMXRT595S_M33 -If SWD -Speed 4000 -RTTChannel 3 trace.bin"),
+- the memory image of the ring saved by the debugger
+  (gdb: "dump binary value trace.bin TRACE_RING_image").
+
+An event and the next end of the same event make a slice; the events without
+end are instant events. The events are named from SystemView description files
+(e.g. projects/microej/SYSVIEW_RT595.txt for the group "RT595"), whose
+identifiers are relative to the group.
+
+Example:
+  trace_ring.py trace.bin --description RT595=../../microej/SYSVIEW_RT595.txt -o trace.json
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+MAGIC_IMAGE = 0x49475254
+MAGIC_HEADER = 0x48475254
+MAGIC_CHUNK = 0x43475254
+
+HEADER = struct.Struct('<6I')
+CHUNK = struct.Struct('<4I')
+EVENT = struct.Struct('<BBHIII')
+VALUES = struct.Struct('<B3x3I')
+RECORD_SIZE = 16
+GROUP_NAME_LENGTH = 16
+
+KIND_START = 0
+KIND_END = 1
+KIND_VALUES = 2
+KIND_MASK = 0x7
+FLAG_ABSOLUTE = 0x8
+COUNT_SHIFT = 4
+
+GROUP_MONITOR = 0xFF
+MONITOR_EVENTS = {500: 'New', 501: 'Exception'}
+
+# The exception number is the context of the events recorded in interrupt handlers.
+EXCEPTION_NAMES = {2: 'NMI', 3: 'HardFault', 11: 'SVCall', 14: 'PendSV', 15: 'SysTick'}
+MAX_EXCEPTION = 512
+
+DESCRIPTION_LINE = re.compile(r'^\s*(\d+)\s+(\S+)')
+
+
+class Header(object):
+    """The header of a memory image or of an RTT stream."""
+
+    def __init__(self, data, offset):
+        (self.magic, self.version, self.frequency, self.size, self.groups,
+         self.committed) = HEADER.unpack_from(data, offset)
+        self.names = []
+        offset += HEADER.size
+        for _ in range(self.groups):
+            name = data[offset:offset + GROUP_NAME_LENGTH].split(b'\0', 1)[0]
+            self.names.append(name.decode('ascii', 'replace'))
+            offset += GROUP_NAME_LENGTH
+        self.end = offset
+
+
+def read_image(data):
+    """Yields the header, then the (position, record) of the memory image."""
+    header = Header(data, 0)
+    yield header
+    first = max(0, header.committed - header.size)
+    for position in range(first, header.committed):
+        offset = header.end + (position % header.size) * RECORD_SIZE
+        yield position, data[offset:offset + RECORD_SIZE]
+
+
+def read_stream(data):
+    """Yields the headers and the (position, record) of the RTT stream, and the
+    number of lost records reported by each chunk."""
+    offset = 0
+    while offset + 4 <= len(data):
+        magic, = struct.unpack_from('<I', data, offset)
+        if magic == MAGIC_HEADER and offset + HEADER.size <= len(data):
+            header = Header(data, offset)
+            yield header
+            offset = header.end
+        elif magic == MAGIC_CHUNK and offset + CHUNK.size <= len(data):
+            _, position, records, lost = CHUNK.unpack_from(data, offset)
+            offset += CHUNK.size
+            if lost:
+                yield lost
+            for index in range(records):
+                record = data[offset:offset + RECORD_SIZE]
+                if len(record) < RECORD_SIZE:
+                    # truncated capture
+                    return
+                yield position + index, record
+                offset += RECORD_SIZE
+        else:
+            # skip the bytes of a capture that did not start on a block
+            offset += 4
+
+
+def read_descriptions(specs):
+    """Returns {group name: {event: name}} from "group=file" specifications."""
+    descriptions = {}
+    for spec in specs:
+        group, _, path = spec.partition('=')
+        names = descriptions.setdefault(group, {})
+        with open(path) as f:
+            for line in f:
+                match = DESCRIPTION_LINE.match(line)
+                if match is not None:
+                    names[int(match.group(1))] = match.group(2)
+    return descriptions
+
+
+class Decoder(object):
+    """Rebuilds the events of the records and converts them to trace events."""
+
+    def __init__(self, descriptions):
+        self.descriptions = descriptions
+        self.names = []
+        self.frequency = 1
+        self.trace = []
+        self.contexts = set()
+        self.open = {}
+        self.time = 0
+        self.synchronized = False
+        self.expected = None
+        self.event = None
+        self.lost = 0
+        self.skipped = 0
+        self.events = 0
+
+    def on_header(self, header):
+        self.names = header.names
+        self.frequency = header.frequency or 1
+
+    def on_lost(self, lost):
+        self.lost += lost
+        self.synchronized = False
+
+    def on_record(self, position, record):
+        if position != self.expected:
+            if self.expected is not None:
+                # records not captured
+                self.synchronized = False
+        self.expected = position + 1
+
+        kind = record[0] & KIND_MASK
+        if kind == KIND_VALUES:
+            if self.event is not None:
+                self.event['values'].extend(VALUES.unpack(record)[1:])
+                self._complete()
+            return
+
+        # a new event: flush the previous one even if some values are missing
+        self._flush()
+        type_, group, event, time, context, value = EVENT.unpack(record)
+        if type_ & FLAG_ABSOLUTE:
+            if self.synchronized:
+                # continue the 64-bit time with the 32-bit cycle counter
+                base = self.time & ~0xFFFFFFFF
+                time = base | time
+                if time < self.time:
+                    time += 1 << 32
+            self.time = time
+            self.synchronized = True
+        elif self.synchronized:
+            self.time += time
+        else:
+            # cannot be dated until the next absolute time
+            self.skipped += 1
+            return
+
+        count = type_ >> COUNT_SHIFT
+        self.event = {'kind': kind, 'group': group, 'event': event, 'time': self.time,
+                      'context': context, 'count': count, 'values': [value] if count else []}
+        self._complete()
+
+    def finish(self):
+        self._flush()
+        # the events without end
+        for stack in self.open.values():
+            for start in stack:
+                self._instant(start)
+        for context in sorted(self.contexts):
+            self.trace.append({'ph': 'M', 'name': 'thread_name', 'pid': 0, 'tid': context,
+                               'args': {'name': context_name(context)}})
+        self.trace.sort(key=lambda e: e.get('ts', -1))
+        return {'traceEvents': self.trace, 'displayTimeUnit': 'ns',
+                'otherData': {'lost records': self.lost, 'undated records': self.skipped}}
+
+    def _complete(self):
+        if self.event is not None and len(self.event['values']) >= self.event['count']:
+            self._flush()
+
+    def _flush(self):
+        event = self.event
+        self.event = None
+        if event is None:
+            return
+        del event['values'][event['count']:]
+        self.events += 1
+        self.contexts.add(event['context'])
+        key = (event['group'], event['event'])
+        if event['kind'] == KIND_START:
+            self.open.setdefault(key, []).append(event)
+        else:
+            stack = self.open.get(key)
+            if stack:
+                start = stack.pop()
+                args = self._args(start)
+                if event['values']:
+                    args['result'] = event['values']
+                self.trace.append({'ph': 'X', 'name': self._name(start), 'cat': self._group(start),
+                                   'pid': 0, 'tid': start['context'], 'ts': self._us(start['time']),
+                                   'dur': self._us(event['time'] - start['time']), 'args': args})
+            else:
+                # start lost or before the capture
+                event['name'] = 'end of ' + self._name(event)
+                self._instant(event)
+
+    def _instant(self, event):
+        self.trace.append({'ph': 'i', 's': 't', 'name': event.get('name') or self._name(event),
+                           'cat': self._group(event), 'pid': 0, 'tid': event['context'],
+                           'ts': self._us(event['time']), 'args': self._args(event)})
+
+    def _group(self, event):
+        group = event['group']
+        if group == GROUP_MONITOR:
+            return 'MicroEJ'
+        if group < len(self.names) and self.names[group]:
+            return self.names[group]
+        return 'group %d' % group
+
+    def _name(self, event):
+        group = self._group(event)
+        names = self.descriptions.get(group, MONITOR_EVENTS if event['group'] == GROUP_MONITOR else {})
+        return names.get(event['event'], '%s %d' % (group, event['event']))
+
+    def _args(self, event):
+        return {'values': event['values']} if event['values'] else {}
+
+    def _us(self, cycles):
+        return cycles * 1e6 / self.frequency
+
+
+def context_name(context):
+    if context < MAX_EXCEPTION:
+        if context >= 16:
+            return 'IRQ %d' % (context - 16)
+        return EXCEPTION_NAMES.get(context, 'exception %d' % context)
+    return 'task 0x%08x' % context
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('input', help='RTT stream or memory image')
+    parser.add_argument('--description', action='append', default=[],
+                        help='GROUP=FILE: SystemView description file of a group (repeatable)')
+    parser.add_argument('-o', '--output', help='JSON file to write (default: standard output)')
+    args = parser.parse_args(argv)
+
+    with open(args.input, 'rb') as f:
+        data = f.read()
+    if len(data) < 4:
+        parser.error('%s: empty capture' % args.input)
+
+    magic, = struct.unpack_from('<I', data, 0)
+    items = read_image(data) if magic == MAGIC_IMAGE else read_stream(data)
+
+    decoder = Decoder(read_descriptions(args.description))
+    for item in items:
+        if isinstance(item, Header):
+            decoder.on_header(item)
+        elif isinstance(item, int):
+            decoder.on_lost(item)
+        else:
+            decoder.on_record(*item)
+    trace = decoder.finish()
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(trace, f)
+    else:
+        json.dump(trace, sys.stdout)
+    sys.stderr.write('%d events, %d lost records, %d undated records\n'
+                     % (decoder.events, decoder.lost, decoder.skipped))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
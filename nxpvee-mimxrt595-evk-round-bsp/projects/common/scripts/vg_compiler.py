@@ -0,0 +1,882 @@
+#!/usr/bin/env python3
+#
+# Copyright 2023 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""Compiles animated vector images (Android Vector Drawable subset) into VGLite blobs.
+
+See projects/microej/vg/inc/vg_blob.h for the layout. Each image becomes one flat,
+read-only blob that the native side draws without any allocation:
+- the paths are encoded in the MicroVG path format of the BSP (MICROVG_PATH_HEADER_t
+  followed by the VGLite FP32 commands, bounds included), i.e. the bytes that
+  LLVG_PATH_IMPL_appendPathCommand*() would build at runtime,
+- the linear gradients carry their matrix and their 256-pixel ramp, prebuilt like
+  VGLITE_PATH_update_gradient() (porter-duff workaround and vg_lite_update_grad()),
+- the animators become keyframe tables: the motion paths are sampled by arc length
+  and the path interpolators are tabulated.
+
+Supported: <vector> (or <animated-vector> with an inline drawable), nested <group>
+(translate, scale, rotation, pivot), filled <path> (color or linear gradient, fill
+alpha, fill type) and the <objectAnimator> of the properties of the groups and of
+fillAlpha, fillColor and pathData (morphing) of the paths. Anything else (strokes,
+clip paths, arcs, repeated or sequential animators) is rejected: such images keep
+the runtime path.
+
+The output is a C file that registers the blobs under their resource name (path
+relative to --root, e.g. "/images/mascot.xml"), see VG_BLOB_find().
+
+Example:
+  vg_compiler.py --root src/main/resources src/main/resources/images/mascot.xml -o vg_blob_images.c
+  vg_compiler.py --dump 1250 src/main/resources/images/mascot.xml
+"""
+
+import argparse
+import math
+import os
+import re
+import struct
+import sys
+import xml.etree.ElementTree as ET
+
+ANDROID = '{http://schemas.android.com/apk/res/android}'
+
+MAGIC = 0x4C424756  # "VGBL"
+VERSION = 1
+
+HEADER = struct.Struct('<IHHffIHHHHHHHHIIIIIII')
+GROUP = struct.Struct('<BBHfffffff')
+ELEMENT = struct.Struct('<HhIIfB3x')
+TRACK = struct.Struct('<BBHHHI')
+KEYFRAME = struct.Struct('<IIHHII')
+GRADIENT_COUNT_MAX = 16  # VLC_MAX_GRAD
+GRADIENT = struct.Struct('<9fI16I16II')
+PATH_HEADER = struct.Struct('<HHBBBBffff')
+
+# vg_lite_format_t
+VG_LITE_FP32 = 3
+
+# VLC_OP_*
+VLC_OP_END = 0x00
+VLC_OP_MOVE = 0x02
+VLC_OP_LINE = 0x04
+VLC_OP_QUAD = 0x06
+VLC_OP_CUBIC = 0x08
+OPCODES = {'M': VLC_OP_MOVE, 'L': VLC_OP_LINE, 'Q': VLC_OP_QUAD, 'C': VLC_OP_CUBIC}
+
+# LLVG_FILLTYPE_*
+FILL_TYPES = {'nonZero': 0, 'evenOdd': 1}
+
+# track properties (VG_BLOB_PROPERTY_*): the group properties come first
+PROPERTY_TRANSLATE_X = 0
+PROPERTY_TRANSLATE_Y = 1
+PROPERTY_SCALE_X = 2
+PROPERTY_SCALE_Y = 3
+PROPERTY_ROTATION = 4
+PROPERTY_PIVOT_X = 5
+PROPERTY_PIVOT_Y = 6
+PROPERTY_TRANSLATE_XY = 7
+PROPERTY_FILL_ALPHA = 16
+PROPERTY_FILL_COLOR = 17
+PROPERTY_PATH = 18
+GROUP_PROPERTIES = {'translateX': PROPERTY_TRANSLATE_X, 'translateY': PROPERTY_TRANSLATE_Y,
+                    'scaleX': PROPERTY_SCALE_X, 'scaleY': PROPERTY_SCALE_Y,
+                    'rotation': PROPERTY_ROTATION, 'pivotX': PROPERTY_PIVOT_X,
+                    'pivotY': PROPERTY_PIVOT_Y, 'translateXY': PROPERTY_TRANSLATE_XY}
+ELEMENT_PROPERTIES = {'fillAlpha': PROPERTY_FILL_ALPHA, 'fillColor': PROPERTY_FILL_COLOR,
+                      'pathData': PROPERTY_PATH}
+
+# intervals of the interpolator tables
+INTERPOLATOR_SAMPLES = 128
+
+# segments of a curve when it is flattened (motion paths, interpolators)
+CURVE_STEPS = 32
+
+# maximal error (pixels) when the samples of a motion path are reduced
+MOTION_TOLERANCE = 0.05
+
+# VGLite source buffer alignment (gradient ramps)
+RAMP_ALIGNMENT = 64
+RAMP_WIDTH = 256  # VLC_GRADBUFFER_WIDTH
+
+# the named interpolators of the Android framework
+CUBIC_INTERPOLATORS = {
+    'fast_out_slow_in': (0.4, 0.0, 0.2, 1.0),
+    'fast_out_linear_in': (0.4, 0.0, 1.0, 1.0),
+    'linear_out_slow_in': (0.0, 0.0, 0.2, 1.0),
+}
+FUNCTION_INTERPOLATORS = {
+    'linear': lambda x: x,
+    'accelerate_decelerate': lambda x: math.cos((x + 1.0) * math.pi) / 2.0 + 0.5,
+    'accelerate': lambda x: x * x,
+    'decelerate': lambda x: 1.0 - (1.0 - x) * (1.0 - x),
+}
+# default interpolator of an animator (ValueAnimator)
+DEFAULT_INTERPOLATOR = 'accelerate_decelerate'
+
+NUMBER = r'[-+]?(?:\d+\.?\d*|\.\d+)(?:[eE][-+]?\d+)?'
+PATH_TOKEN = re.compile(r'([MmLlHhVvCcSsQqTtZzAa])|(%s)' % NUMBER)
+PATH_ARITY = {'M': 2, 'L': 2, 'H': 1, 'V': 1, 'C': 6, 'S': 4, 'Q': 4, 'T': 2, 'Z': 0, 'A': 7}
+
+
+class CompileError(Exception):
+    pass
+
+
+def f32(value):
+    """Rounds a value as a C float."""
+    return struct.unpack('<f', struct.pack('<f', value))[0]
+
+
+def attribute(node, name, default=None):
+    return node.get(ANDROID + name, default)
+
+
+def number(node, name, default):
+    value = attribute(node, name)
+    return default if value is None else float(value.replace('dp', '').replace('px', ''))
+
+
+def parse_color(text):
+    """Returns the ARGB value of "#RGB", "#ARGB", "#RRGGBB" or "#AARRGGBB"."""
+    if text is None or not text.startswith('#'):
+        raise CompileError('unsupported color "%s"' % text)
+    digits = text[1:]
+    if len(digits) in (3, 4):
+        digits = ''.join(c * 2 for c in digits)
+    if len(digits) == 6:
+        digits = 'ff' + digits
+    if len(digits) != 8:
+        raise CompileError('unsupported color "%s"' % text)
+    return int(digits, 16)
+
+
+# -----------------------------------------------------------------------------
+# Paths
+# -----------------------------------------------------------------------------
+
+def parse_path(text):
+    """Returns the absolute operations ('M', 'L', 'Q' or 'C', coordinates) of a path.
+    A command without arguments (e.g. the "c" that ends the subpaths of the exported
+    images) closes the subpath like "z"."""
+    tokens = [(m.group(1), m.group(2)) for m in PATH_TOKEN.finditer(text)]
+    commands = []
+    index = 0
+    while index < len(tokens):
+        command, value = tokens[index]
+        if command is None:
+            raise CompileError('path data: number %s without command' % value)
+        index += 1
+        args = []
+        while index < len(tokens) and tokens[index][0] is None:
+            args.append(float(tokens[index][1]))
+            index += 1
+        arity = PATH_ARITY[command.upper()]
+        if arity == 0 or not args:
+            commands.append(('Z', []))
+            continue
+        if len(args) % arity != 0:
+            raise CompileError('path data: command %s with %d arguments' % (command, len(args)))
+        for chunk in range(0, len(args), arity):
+            commands.append((command, args[chunk:chunk + arity]))
+            if command in 'Mm':
+                # the next pairs are implicit lines
+                command = 'L' if command == 'M' else 'l'
+
+    ops = []
+    x = y = start_x = start_y = 0.0
+    control = None  # last control point (S and T reflections)
+    previous = ''
+    for command, args in commands:
+        upper = command.upper()
+        relative = command.islower()
+        if upper == 'A':
+            raise CompileError('path data: arcs are not supported')
+        if upper == 'Z':
+            if (x, y) != (start_x, start_y) and ops:
+                # the fill closes the subpath: the next command starts from its start point
+                ops.append(('L', [start_x, start_y]))
+            x, y = start_x, start_y
+            control = None
+            previous = 'Z'
+            continue
+        if upper in 'HV':
+            if upper == 'H':
+                args = [args[0] + (x if relative else 0.0), y]
+            else:
+                args = [x, args[0] + (y if relative else 0.0)]
+            upper, relative = 'L', False
+        if relative:
+            args = [value + (x if i % 2 == 0 else y) for i, value in enumerate(args)]
+        if upper == 'S':
+            reflected = [2 * x - control[0], 2 * y - control[1]] if previous in 'CS' and control else [x, y]
+            args = reflected + args
+            upper = 'C'
+            command = 'S'
+        elif upper == 'T':
+            reflected = [2 * x - control[0], 2 * y - control[1]] if previous in 'QT' and control else [x, y]
+            args = reflected + args
+            upper = 'Q'
+            command = 'T'
+        if upper == 'M':
+            start_x, start_y = args[0], args[1]
+        ops.append((upper, args))
+        control = (args[-4], args[-3]) if upper in 'CQ' else None
+        x, y = args[-2], args[-1]
+        previous = command.upper()
+    if not ops or ops[0][0] != 'M':
+        raise CompileError('path data: the path must start with a move')
+    return ops
+
+
+def encode_path(ops):
+    """Returns the path in the MicroVG format of the BSP (header, FP32 commands,
+    VLC_OP_END), like LLVG_PATH_IMPL_appendPathCommand*()."""
+    data = bytearray()
+    xs = []
+    ys = []
+    for op, args in ops:
+        data += struct.pack('<I', OPCODES[op])
+        data += struct.pack('<%df' % len(args), *args)
+        xs += args[0::2]
+        ys += args[1::2]
+    data += struct.pack('<I', VLC_OP_END)
+    if len(data) + PATH_HEADER.size > 0xFFFF:
+        raise CompileError('path too large (%d bytes)' % len(data))
+    header = PATH_HEADER.pack(len(data), PATH_HEADER.size, VG_LITE_FP32, 0, 0, 0,
+                              min(xs), max(xs), min(ys), max(ys))
+    return bytes(header + data)
+
+
+def same_structure(ops1, ops2):
+    return [op for op, _ in ops1] == [op for op, _ in ops2]
+
+
+def flatten(ops, steps=CURVE_STEPS):
+    """Returns the points of a path, the curves split in segments."""
+    points = []
+    x = y = 0.0
+    for op, args in ops:
+        if op == 'M':
+            x, y = args
+            points.append((x, y))
+            continue
+        if op == 'L':
+            points.append((args[0], args[1]))
+        else:
+            p0 = (x, y)
+            controls = [(args[i], args[i + 1]) for i in range(0, len(args), 2)]
+            for step in range(1, steps + 1):
+                t = step / float(steps)
+                points.append(bezier([p0] + controls, t))
+        x, y = args[-2], args[-1]
+    return points
+
+
+def bezier(points, t):
+    """de Casteljau evaluation."""
+    while len(points) > 1:
+        points = [(a[0] + (b[0] - a[0]) * t, a[1] + (b[1] - a[1]) * t) for a, b in zip(points, points[1:])]
+    return points[0]
+
+
+# -----------------------------------------------------------------------------
+# Animations
+# -----------------------------------------------------------------------------
+
+def motion_points(text):
+    """Samples a motion path by arc length: returns (fraction, x, y) points, the
+    points on the linear interpolation of their neighbours removed."""
+    points = flatten(parse_path(text))
+    lengths = [0.0]
+    for a, b in zip(points, points[1:]):
+        lengths.append(lengths[-1] + math.hypot(b[0] - a[0], b[1] - a[1]))
+    total = lengths[-1]
+    if total == 0.0:
+        return [(0.0, points[0][0], points[0][1]), (1.0, points[0][0], points[0][1])]
+    samples = [(length / total, p[0], p[1]) for length, p in zip(lengths, points)]
+    # remove the duplicates (same fraction)
+    reduced = [samples[0]]
+    for sample in samples[1:]:
+        if sample[0] > reduced[-1][0]:
+            reduced.append(sample)
+    samples = reduced
+
+    def error(a, b, p):
+        ratio = (p[0] - a[0]) / (b[0] - a[0])
+        return math.hypot(a[1] + (b[1] - a[1]) * ratio - p[1], a[2] + (b[2] - a[2]) * ratio - p[2])
+
+    while len(samples) > 2:
+        errors = [error(samples[i - 1], samples[i + 1], samples[i]) for i in range(1, len(samples) - 1)]
+        best = min(range(len(errors)), key=errors.__getitem__)
+        if errors[best] >= MOTION_TOLERANCE:
+            break
+        # the error of the neighbours is computed again with the new segment
+        del samples[best + 1]
+    return samples
+
+
+def interpolator_key(animator):
+    """Returns a hashable description of the interpolator of an animator."""
+    for child in animator:
+        if child.get('name') == 'android:interpolator':
+            for interpolator in child:
+                if interpolator.tag != 'pathInterpolator':
+                    raise CompileError('unsupported interpolator <%s>' % interpolator.tag)
+                path = attribute(interpolator, 'pathData')
+                if path is not None:
+                    return ('path', path.strip())
+                controls = [attribute(interpolator, name) for name in ('controlX1', 'controlY1', 'controlX2', 'controlY2')]
+                if controls[0] is None:
+                    raise CompileError('pathInterpolator without path')
+                if controls[2] is None:
+                    # quadratic
+                    return ('path', 'M0,0 Q%s,%s 1,1' % (controls[0], controls[1]))
+                return ('path', 'M0,0 C%s,%s %s,%s 1,1' % tuple(controls))
+    name = attribute(animator, 'interpolator')
+    if name is None:
+        return ('function', DEFAULT_INTERPOLATOR)
+    name = name.split('/')[-1].replace('_interpolator', '')
+    if name in CUBIC_INTERPOLATORS:
+        return ('path', 'M0,0 C%g,%g %g,%g 1,1' % CUBIC_INTERPOLATORS[name])
+    if name in FUNCTION_INTERPOLATORS:
+        return ('function', name)
+    raise CompileError('unsupported interpolator "%s"' % name)
+
+
+def interpolator_table(key):
+    """Returns the INTERPOLATOR_SAMPLES + 1 values of an interpolator at regular
+    fractions (like android.view.animation.PathInterpolator: linear interpolation
+    between the points of the flattened curve)."""
+    kind, value = key
+    if kind == 'function':
+        function = FUNCTION_INTERPOLATORS[value]
+        return [function(i / float(INTERPOLATOR_SAMPLES)) for i in range(INTERPOLATOR_SAMPLES + 1)]
+    points = flatten(parse_path(value), 256)
+    table = []
+    segment = 0
+    for i in range(INTERPOLATOR_SAMPLES + 1):
+        x = i / float(INTERPOLATOR_SAMPLES)
+        while segment < len(points) - 2 and points[segment + 1][0] < x:
+            segment += 1
+        (x0, y0), (x1, y1) = points[segment], points[segment + 1]
+        table.append(y0 if x1 == x0 else y0 + (y1 - y0) * (x - x0) / (x1 - x0))
+    table[0] = 0.0
+    table[-1] = 1.0
+    return table
+
+
+# -----------------------------------------------------------------------------
+# Gradients
+# -----------------------------------------------------------------------------
+
+def gradient_of(path_node):
+    """Returns the linear gradient of a path (None for a color fill)."""
+    for child in path_node:
+        if child.get('name') == 'android:fillColor':
+            for gradient in child:
+                if gradient.tag == 'gradient':
+                    return gradient
+    return None
+
+
+def compile_gradient(node):
+    kind = attribute(node, 'type', 'linear')
+    if kind != 'linear':
+        raise CompileError('%s gradients are not supported' % kind)
+    if attribute(node, 'tileMode', 'clamp') != 'clamp':
+        raise CompileError('only the clamp tile mode is supported')
+    start_x, start_y = number(node, 'startX', 0.0), number(node, 'startY', 0.0)
+    end_x, end_y = number(node, 'endX', 0.0), number(node, 'endY', 0.0)
+
+    items = [(float(attribute(item, 'offset', '0')), parse_color(attribute(item, 'color')))
+             for item in node if item.tag == 'item']
+    if not items:
+        items = [(0.0, parse_color(attribute(node, 'startColor')))]
+        if attribute(node, 'centerColor') is not None:
+            items.append((number(node, 'centerX', 0.5), parse_color(attribute(node, 'centerColor'))))
+        items.append((1.0, parse_color(attribute(node, 'endColor'))))
+    if len(items) > GRADIENT_COUNT_MAX:
+        raise CompileError('gradient with more than %d colors' % GRADIENT_COUNT_MAX)
+    stops = [int(round(min(max(offset, 0.0), 1.0) * 255)) for offset, _ in items]
+    colors = [color for _, color in items]
+
+    # same matrix as MICROVG_VGLITE_HELPER_to_vg_lite_gradient(): translate, rotate
+    # and scale the ramp on the gradient vector
+    angle = math.atan2(end_y - start_y, end_x - start_x)
+    scale = math.hypot(end_x - start_x, end_y - start_y) / RAMP_WIDTH
+    cos_angle, sin_angle = math.cos(angle), math.sin(angle)
+    matrix = [cos_angle * scale, -sin_angle, start_x,
+              sin_angle * scale, cos_angle, start_y,
+              0.0, 0.0, 1.0]
+    return {'matrix': matrix, 'colors': colors, 'stops': stops}
+
+
+def porter_duff_workaround(color):
+    """DISPLAY_VGLITE_porter_duff_workaround_ARGB8888()."""
+    alpha = color >> 24
+    if alpha == 0:
+        return 0
+    if alpha == 0xFF:
+        return color
+    red, green, blue = [(alpha * ((color >> shift) & 0xFF)) // 0xFF for shift in (16, 8, 0)]
+    return (alpha << 24) | (red << 16) | (green << 8) | blue
+
+
+def c_div(a, b):
+    """C integer division (truncated)."""
+    quotient = abs(a) // abs(b)
+    return quotient if (a >= 0) == (b > 0) else -quotient
+
+
+def gradient_ramp(colors, stops):
+    """Returns the ramp of vg_lite_set_grad() + vg_lite_update_grad() for a
+    VG_LITE_BLEND_SRC_OVER drawing (colors premultiplied by the workaround)."""
+    valid_colors, valid_stops = [], []
+    for color, stop in zip(colors, stops):
+        if stop <= 255:
+            if not valid_stops or stop > valid_stops[-1]:
+                valid_stops.append(stop)
+                valid_colors.append(color)
+            elif stop == valid_stops[-1]:
+                valid_colors[-1] = color
+    colors = [porter_duff_workaround(c) for c in valid_colors]
+    stops = valid_stops
+    ramp = [0] * RAMP_WIDTH
+    if not colors:
+        stops, colors = [0, 255], [0xFF000000, 0xFFFFFFFF]
+    elif stops[0] != 0:
+        for i in range(stops[0]):
+            ramp[i] = colors[0]
+
+    def channels(color):
+        return [(color >> shift) & 0xFF for shift in (24, 16, 8, 0)]
+
+    c0 = channels(colors[0])
+    for i in range(len(colors) - 1):
+        ramp[stops[i]] = colors[i]
+        ds = stops[i + 1] - stops[i]
+        c1 = channels(colors[i + 1])
+        for j in range(1, ds):
+            a, r, g, b = [v0 + c_div((v1 - v0) * j, ds) for v0, v1 in zip(c0, c1)]
+            ramp[stops[i] + j] = ((a << 24) | (r << 16) | (g << 8) | b) & 0xFFFFFFFF
+        c0 = c1
+    for i in range(stops[-1], RAMP_WIDTH):
+        ramp[i] = colors[-1]
+    return ramp
+
+
+# -----------------------------------------------------------------------------
+# Image
+# -----------------------------------------------------------------------------
+
+class Image(object):
+    """An animated vector image: groups (pre-order), elements (document order),
+    tracks and the tables they refer to."""
+
+    def __init__(self, root):
+        if root.tag == 'animated-vector':
+            vector = None
+            for child in root:
+                if child.tag == '{http://schemas.android.com/aapt}attr' and child.get('name') == 'android:drawable':
+                    vector = child.find('vector')
+            if vector is None:
+                raise CompileError('animated-vector without inline drawable')
+            targets = [child for child in root if child.tag == 'target']
+        elif root.tag == 'vector':
+            vector = root
+            targets = []
+        else:
+            raise CompileError('unsupported root <%s>' % root.tag)
+
+        self.width = number(vector, 'width', 0.0)
+        self.height = number(vector, 'height', 0.0)
+        viewport_width = number(vector, 'viewportWidth', self.width)
+        viewport_height = number(vector, 'viewportHeight', self.height)
+        if self.width <= 0 or self.height <= 0 or viewport_width <= 0 or viewport_height <= 0:
+            raise CompileError('invalid vector size')
+
+        self.groups = []
+        self.elements = []
+        self.names = {}
+        self.gradients = []
+        # the root group maps the viewport on the image size
+        self.add_group(vector, 0, {'scaleX': self.width / viewport_width, 'scaleY': self.height / viewport_height})
+        self.visit(vector, 0, 1)
+
+        self.interpolators = []
+        self.tracks = []
+        self.duration = 0
+        for target in targets:
+            self.add_target(target)
+        self.tracks.sort(key=lambda track: (track['property'] >= PROPERTY_FILL_ALPHA, track['target'], track['property']))
+
+    def add_group(self, node, depth, values=None):
+        values = values or {}
+        group = {'depth': depth}
+        for name, default in (('translateX', 0.0), ('translateY', 0.0), ('scaleX', 1.0), ('scaleY', 1.0),
+                              ('rotation', 0.0), ('pivotX', 0.0), ('pivotY', 0.0)):
+            group[name] = values.get(name, number(node, name, default) if node.tag == 'group' else default)
+        name = attribute(node, 'name')
+        if name is not None and node.tag == 'group':
+            self.names[name] = ('group', len(self.groups))
+        self.groups.append(group)
+        return len(self.groups) - 1
+
+    def visit(self, node, group, depth):
+        for child in node:
+            if child.tag == 'group':
+                self.visit(child, self.add_group(child, depth), depth + 1)
+            elif child.tag == 'path':
+                self.add_element(child, group)
+            elif child.tag == 'clip-path':
+                raise CompileError('clip paths are not supported')
+            else:
+                raise CompileError('unsupported element <%s>' % child.tag)
+
+    def add_element(self, node, group):
+        if attribute(node, 'strokeColor') is not None or attribute(node, 'strokeWidth') is not None:
+            raise CompileError('strokes are not supported')
+        if attribute(node, 'trimPathStart') is not None or attribute(node, 'trimPathEnd') is not None:
+            raise CompileError('trim paths are not supported')
+        fill_type = attribute(node, 'fillType', 'nonZero')
+        if fill_type not in FILL_TYPES:
+            raise CompileError('unsupported fill type "%s"' % fill_type)
+        gradient = gradient_of(node)
+        if gradient is not None:
+            self.gradients.append(compile_gradient(gradient))
+            color = 0xFF000000
+        else:
+            color = parse_color(attribute(node, 'fillColor', '#00000000'))
+        element = {'group': group, 'ops': parse_path(attribute(node, 'pathData', '')),
+                   'color': color, 'alpha': number(node, 'fillAlpha', 1.0),
+                   'fill': FILL_TYPES[fill_type],
+                   'gradient': len(self.gradients) - 1 if gradient is not None else -1}
+        name = attribute(node, 'name')
+        if name is not None:
+            self.names[name] = ('element', len(self.elements))
+        self.elements.append(element)
+
+    def interpolator(self, animator):
+        key = interpolator_key(animator)
+        if key not in self.interpolators:
+            self.interpolators.append(key)
+        return self.interpolators.index(key)
+
+    def add_target(self, target):
+        name = attribute(target, 'name')
+        if name not in self.names:
+            raise CompileError('unknown target "%s"' % name)
+        kind, index = self.names[name]
+        animators = []
+        for child in target.iter():
+            if child.tag == 'set' and attribute(child, 'ordering', 'together') != 'together':
+                raise CompileError('sequential animator sets are not supported')
+            if child.tag == 'objectAnimator':
+                animators.append(child)
+
+        tracks = {}
+        for animator in animators:
+            if int(attribute(animator, 'repeatCount', '0')) != 0:
+                raise CompileError('repeated animators are not supported')
+            prop = attribute(animator, 'propertyName')
+            properties = GROUP_PROPERTIES if kind == 'group' else ELEMENT_PROPERTIES
+            if prop not in properties:
+                raise CompileError('unsupported property "%s" of %s "%s"' % (prop, kind, name))
+            start = int(attribute(animator, 'startOffset', '0'))
+            duration = int(attribute(animator, 'duration', '300'))
+            self.duration = max(self.duration, start + duration)
+            keyframe = {'start': start, 'duration': duration, 'interpolator': self.interpolator(animator)}
+
+            if prop == 'translateXY':
+                if (attribute(animator, 'propertyXName'), attribute(animator, 'propertyYName')) != ('translateX', 'translateY'):
+                    raise CompileError('unsupported motion path properties')
+                keyframe['points'] = motion_points(attribute(animator, 'pathData'))
+            elif prop == 'pathData':
+                keyframe['from'] = parse_path(attribute(animator, 'valueFrom'))
+                keyframe['to'] = parse_path(attribute(animator, 'valueTo'))
+                if not (same_structure(keyframe['from'], keyframe['to'])
+                        and same_structure(keyframe['from'], self.elements[index]['ops'])):
+                    raise CompileError('path "%s" cannot morph: different commands' % name)
+            elif prop == 'fillColor':
+                keyframe['from'] = parse_color(attribute(animator, 'valueFrom'))
+                keyframe['to'] = parse_color(attribute(animator, 'valueTo'))
+            else:
+                keyframe['from'] = float(attribute(animator, 'valueFrom'))
+                keyframe['to'] = float(attribute(animator, 'valueTo'))
+            tracks.setdefault(properties[prop], []).append(keyframe)
+
+        for prop, keyframes in tracks.items():
+            if prop == PROPERTY_FILL_COLOR and self.elements[index]['gradient'] >= 0:
+                raise CompileError('the color of a gradient cannot be animated')
+            keyframes.sort(key=lambda keyframe: keyframe['start'])
+            self.tracks.append({'property': prop, 'target': index, 'keyframes': keyframes})
+
+    # -------------------------------------------------------------------------
+    # Reference evaluation (same as vg_blob.c)
+    # -------------------------------------------------------------------------
+
+    def fraction(self, keyframe, elapsed):
+        if elapsed >= keyframe['start'] + keyframe['duration'] or keyframe['duration'] == 0:
+            x = 1.0
+        else:
+            x = (elapsed - keyframe['start']) / float(keyframe['duration'])
+        table = interpolator_table(self.interpolators[keyframe['interpolator']])
+        position = x * INTERPOLATOR_SAMPLES
+        i = int(position)
+        if i >= INTERPOLATOR_SAMPLES:
+            return table[INTERPOLATOR_SAMPLES]
+        return table[i] + (table[i + 1] - table[i]) * (position - i)
+
+    def evaluate(self, elapsed):
+        """Returns the group values and the elements (ops, color, alpha) at a time."""
+        groups = [dict(group) for group in self.groups]
+        elements = [dict(element) for element in self.elements]
+        for track in self.tracks:
+            current = [k for k in track['keyframes'] if k['start'] <= elapsed]
+            if not current:
+                continue
+            keyframe = current[-1]
+            f = self.fraction(keyframe, elapsed)
+            prop = track['property']
+            if prop == PROPERTY_TRANSLATE_XY:
+                points = keyframe['points']
+                for a, b in zip(points, points[1:]):
+                    if f <= b[0] or b is points[-1]:
+                        ratio = 0.0 if b[0] == a[0] else min(max((f - a[0]) / (b[0] - a[0]), 0.0), 1.0)
+                        groups[track['target']]['translateX'] = a[1] + (b[1] - a[1]) * ratio
+                        groups[track['target']]['translateY'] = a[2] + (b[2] - a[2]) * ratio
+                        break
+            elif prop < PROPERTY_FILL_ALPHA:
+                name = [n for n, p in GROUP_PROPERTIES.items() if p == prop][0]
+                groups[track['target']][name] = keyframe['from'] + (keyframe['to'] - keyframe['from']) * f
+            elif prop == PROPERTY_FILL_ALPHA:
+                elements[track['target']]['alpha'] = keyframe['from'] + (keyframe['to'] - keyframe['from']) * f
+            elif prop == PROPERTY_FILL_COLOR:
+                c0, c1 = keyframe['from'], keyframe['to']
+                color = 0
+                for shift in (24, 16, 8, 0):
+                    v0, v1 = (c0 >> shift) & 0xFF, (c1 >> shift) & 0xFF
+                    color |= int(v0 + (v1 - v0) * f + 0.5) << shift
+                elements[track['target']]['color'] = color
+            else:
+                ops0, ops1 = keyframe['from'], keyframe['to']
+                elements[track['target']]['ops'] = [
+                    (op, [v0 * (1 - f) + v1 * f for v0, v1 in zip(a0, a1)]) for (op, a0), (_, a1) in zip(ops0, ops1)]
+        return groups, elements
+
+    def matrices(self, groups):
+        """Returns the matrix of each group (row major, 9 values)."""
+        def multiply(a, b):
+            return [sum(a[r * 3 + k] * b[k * 3 + c] for k in range(3)) for r in range(3) for c in range(3)]
+
+        stack = []
+        result = []
+        for group in groups:
+            del stack[group['depth']:]
+            px, py = group['pivotX'], group['pivotY']
+            angle = math.radians(group['rotation'])
+            local = multiply(multiply(multiply(
+                [1, 0, group['translateX'] + px, 0, 1, group['translateY'] + py, 0, 0, 1],
+                [math.cos(angle), -math.sin(angle), 0, math.sin(angle), math.cos(angle), 0, 0, 0, 1]),
+                [group['scaleX'], 0, 0, 0, group['scaleY'], 0, 0, 0, 1]),
+                [1, 0, -px, 0, 1, -py, 0, 0, 1])
+            matrix = multiply(stack[-1], local) if stack else local
+            stack.append(matrix)
+            result.append(matrix)
+        return result
+
+    # -------------------------------------------------------------------------
+    # Blob
+    # -------------------------------------------------------------------------
+
+    def compile(self):
+        """Returns the blob."""
+        if len(self.groups) > 0xFFFF or len(self.elements) > 0xFFFF or len(self.tracks) > 0xFFFF:
+            raise CompileError('too many groups, elements or tracks')
+        if len(self.interpolators) > 0xFFFF or len(self.gradients) > 0x7FFF:
+            raise CompileError('too many interpolators or gradients')
+
+        groups_offset = HEADER.size
+        elements_offset = groups_offset + GROUP.size * len(self.groups)
+        tracks_offset = elements_offset + ELEMENT.size * len(self.elements)
+        keyframes_offset = tracks_offset + TRACK.size * len(self.tracks)
+        keyframe_count = sum(len(track['keyframes']) for track in self.tracks)
+        points_offset = keyframes_offset + KEYFRAME.size * keyframe_count
+        point_count = sum(len(k['points']) for t in self.tracks for k in t['keyframes'] if 'points' in k)
+        interpolators_offset = points_offset + 12 * point_count
+        gradients_offset = interpolators_offset + 4 * (INTERPOLATOR_SAMPLES + 1) * len(self.interpolators)
+        paths_offset = gradients_offset + GRADIENT.size * len(self.gradients)
+
+        # the identical paths (e.g. the first and the last shapes of a morphing) are shared
+        paths = bytearray()
+        path_offsets = {}
+
+        def path(ops):
+            encoded = encode_path(ops)
+            if encoded not in path_offsets:
+                path_offsets[encoded] = paths_offset + len(paths)
+                paths.extend(encoded)
+            return path_offsets[encoded]
+
+        elements = bytearray()
+        for element in self.elements:
+            elements += ELEMENT.pack(element['group'], element['gradient'], path(element['ops']),
+                                     element['color'], element['alpha'], element['fill'])
+
+        tracks = bytearray()
+        keyframes = bytearray()
+        points = bytearray()
+        max_path_size = 0
+        offset = keyframes_offset
+        for track in self.tracks:
+            tracks += TRACK.pack(track['property'], 0, track['target'], len(track['keyframes']), 0, offset)
+            offset += KEYFRAME.size * len(track['keyframes'])
+            for keyframe in track['keyframes']:
+                if track['property'] == PROPERTY_TRANSLATE_XY:
+                    values = (points_offset + len(points), len(keyframe['points']))
+                    for point in keyframe['points']:
+                        points += struct.pack('<3f', *point)
+                elif track['property'] == PROPERTY_PATH:
+                    values = (path(keyframe['from']), path(keyframe['to']))
+                    max_path_size = max(max_path_size, len(encode_path(keyframe['from'])))
+                elif track['property'] == PROPERTY_FILL_COLOR:
+                    values = (keyframe['from'], keyframe['to'])
+                else:
+                    values = struct.unpack('<2I', struct.pack('<2f', keyframe['from'], keyframe['to']))
+                keyframes += KEYFRAME.pack(keyframe['start'], keyframe['duration'], keyframe['interpolator'], 0, *values)
+
+        interpolators = bytearray()
+        for key in self.interpolators:
+            interpolators += struct.pack('<%df' % (INTERPOLATOR_SAMPLES + 1), *interpolator_table(key))
+
+        # the ramps follow the paths, aligned for the GPU
+        ramps_offset = paths_offset + len(paths)
+        ramps_offset = (ramps_offset + RAMP_ALIGNMENT - 1) & ~(RAMP_ALIGNMENT - 1)
+        gradients = bytearray()
+        ramps = bytearray()
+        for index, gradient in enumerate(self.gradients):
+            count = len(gradient['colors'])
+            padding = [0] * (GRADIENT_COUNT_MAX - count)
+            gradients += GRADIENT.pack(*(gradient['matrix'] + [count] + gradient['colors'] + padding
+                                         + gradient['stops'] + padding + [ramps_offset + len(ramps)]))
+            ramps += struct.pack('<%dI' % RAMP_WIDTH, *gradient_ramp(gradient['colors'], gradient['stops']))
+
+        groups = bytearray()
+        for group in self.groups:
+            groups += GROUP.pack(group['depth'], 0, 0, group['translateX'], group['translateY'],
+                                 group['scaleX'], group['scaleY'], group['rotation'],
+                                 group['pivotX'], group['pivotY'])
+
+        body = groups + elements + tracks + keyframes + points + interpolators + gradients + paths
+        if self.gradients:
+            body += bytes(ramps_offset - HEADER.size - len(body)) + ramps
+        size = HEADER.size + len(body)
+        header = HEADER.pack(MAGIC, VERSION, HEADER.size, self.width, self.height, self.duration,
+                             len(self.groups), len(self.elements), len(self.tracks), len(self.interpolators),
+                             len(self.gradients), max(group['depth'] for group in self.groups) + 1,
+                             INTERPOLATOR_SAMPLES, max_path_size,
+                             groups_offset, elements_offset, tracks_offset, interpolators_offset,
+                             gradients_offset, paths_offset, size)
+        return bytes(header + body)
+
+
+def load(path):
+    try:
+        return Image(ET.parse(path).getroot())
+    except ET.ParseError as e:
+        raise CompileError(str(e))
+
+
+# -----------------------------------------------------------------------------
+# Output
+# -----------------------------------------------------------------------------
+
+def c_identifier(name):
+    return re.sub(r'[^0-9A-Za-z_]', '_', name.strip('/'))
+
+
+def c_file(blobs):
+    lines = ['/*',
+             ' * VGLite blobs of the animated vector images (see vg_blob.h).',
+             ' * Generated by vg_compiler.py: do not edit.',
+             ' */',
+             '',
+             '#include "vg_blob.h"',
+             '']
+    for name, blob, _ in blobs:
+        lines.append('// %s: %d bytes' % (name, len(blob)))
+        lines.append('static const uint8_t vg_blob_%s[%d] __attribute__((aligned(%d))) = {' % (
+            c_identifier(name), len(blob), RAMP_ALIGNMENT))
+        for offset in range(0, len(blob), 16):
+            lines.append('\t' + ', '.join('0x%02x' % byte for byte in blob[offset:offset + 16]) + ',')
+        lines.append('};')
+        lines.append('')
+    lines.append('static const VG_BLOB_image_t vg_blob_images[] = {')
+    for name, _, _ in blobs:
+        lines.append('\t{ "%s", vg_blob_%s },' % (name, c_identifier(name)))
+    if not blobs:
+        lines.append('\t{ NULL, NULL },')
+    lines.append('};')
+    lines.append('')
+    lines.append('const VG_BLOB_image_t* VG_BLOB_get_images(uint32_t* count) {')
+    lines.append('\t*count = %du;' % len(blobs))
+    lines.append('\treturn vg_blob_images;')
+    lines.append('}')
+    return ('\n'.join(lines) + '\n').encode('ascii')
+
+
+def dump(image, elapsed):
+    """Prints the reference evaluation of an image: per element, the matrix, the
+    color (fill alpha applied), the gradient and the path commands."""
+    groups, elements = image.evaluate(elapsed)
+    matrices = image.matrices(groups)
+    print('time %d duration %d elements %d' % (elapsed, image.duration, len(elements)))
+    for index, element in enumerate(elements):
+        alpha = int(min(max(element['alpha'], 0.0), 1.0) * 255 + 0.5)
+        color = (element['color'] & 0xFFFFFF) | ((((element['color'] >> 24) * alpha) // 255) << 24)
+        print('element %d color 0x%08x gradient %d fill %d matrix %s' % (
+            index, color, element['gradient'], element['fill'], ' '.join('%.6g' % v for v in matrices[element['group']])))
+        print('path %s' % ' '.join('%s %s' % (op, ' '.join('%.9g' % f32(v) for v in args)) for op, args in element['ops']))
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('inputs', nargs='*', help='animated vector images (XML)')
+    parser.add_argument('-o', '--output', help='output C file')
+    parser.add_argument('--root', default='.', help='resources folder: the image names are relative to it')
+    parser.add_argument('--binary', action='store_true', help='write the blob of the single input instead of a C file')
+    parser.add_argument('--dump', metavar='TIME', type=int, help='print the reference evaluation of the single input at TIME ms')
+    args = parser.parse_args(argv)
+
+    if (args.dump is not None or args.binary) and len(args.inputs) != 1:
+        parser.error('--dump and --binary take a single input')
+    if args.dump is None and args.output is None:
+        parser.error('the output file is required')
+
+    blobs = []
+    for path in args.inputs:
+        try:
+            image = load(path)
+            blob = image.compile()
+        except (CompileError, ValueError, KeyError) as e:
+            parser.error('%s: %s' % (path, e))
+        if args.dump is not None:
+            dump(image, args.dump)
+            return 0
+        name = '/' + os.path.relpath(path, args.root).replace(os.sep, '/')
+        blobs.append((name, blob, image))
+
+    with open(args.output, 'wb') as f:
+        f.write(blobs[0][1] if args.binary else c_file(blobs))
+
+    for name, blob, image in blobs:
+        print('%s: %d groups, %d elements, %d tracks, %d interpolators, %d gradients, %d ms, %d bytes' % (
+            name, len(image.groups), len(image.elements), len(image.tracks), len(image.interpolators),
+            len(image.gradients), image.duration, len(blob)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,325 @@
+#!/usr/bin/env python3
+#
+# Copyright 2023 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""Converts a PNG image into an image of the BSP drawn by the GPU without conversion.
+
+Formats (see projects/microej/ui/inc/display_vglite.h for the layouts):
+- ARGB8888, ARGB4444, ARGB1555: premultiplied images (MicroUI custom formats 3, 5
+  and 6, DISPLAY_VGLITE_IMAGE_FORMAT_ARGB8888_PRE): the pixels in the byte order of
+  the MicroUI formats (little endian), the color channels multiplied by the alpha,
+  the lines aligned on 16 pixels (like the images of the image generator).
+- INDEX2, INDEX4, INDEX8: indexed images (MicroUI custom formats 0, 1 and 2,
+  DISPLAY_VGLITE_IMAGE_FORMAT_INDEX2): the palette of (1 << bpp) ARGB8888 colors
+  (unused entries are transparent) padded to 64 bytes, then the index lines
+  (DISPLAY_VGLITE_INDEXED_STRIDE()), the first pixel of a byte in its least
+  significant bits. The PNG must not hold more colors than the palette (reduce
+  them with an image editor or a quantizer first).
+- A4: MicroUI A4 images (alpha only, drawn with the foreground color): the alpha
+  on 4 bits, the first pixel of a byte in its least significant bits, the lines
+  aligned on 16 pixels. The image generator also produces this format.
+
+The MicroUI image header records the format: for the custom formats it is the
+flag that selects the native blit. The output is the image data (raw binary or C
+array), to be declared with the MicroUI format printed by this script.
+
+With --report, prints the data size of each PNG in each format instead (asset
+memory report).
+
+Examples:
+  vglite_image.py icon.png --format ARGB4444 --c-array icon -o icon.c
+  vglite_image.py --report images/*.png
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+# format -> (MicroUI custom format or None, display_vglite.h/MicroUI name, bits per pixel)
+FORMATS = {
+    'ARGB8888': (3, 'DISPLAY_VGLITE_IMAGE_FORMAT_ARGB8888_PRE', 32),
+    'ARGB4444': (5, 'DISPLAY_VGLITE_IMAGE_FORMAT_ARGB4444_PRE', 16),
+    'ARGB1555': (6, 'DISPLAY_VGLITE_IMAGE_FORMAT_ARGB1555_PRE', 16),
+    'INDEX8': (2, 'DISPLAY_VGLITE_IMAGE_FORMAT_INDEX8', 8),
+    'INDEX4': (1, 'DISPLAY_VGLITE_IMAGE_FORMAT_INDEX4', 4),
+    'INDEX2': (0, 'DISPLAY_VGLITE_IMAGE_FORMAT_INDEX2', 2),
+    'A4': (None, 'MICROUI_IMAGE_FORMAT_A4', 4),
+}
+
+INDEXED_FORMATS = ('INDEX8', 'INDEX4', 'INDEX2')
+
+# MICROUI_IMAGE_FORMAT_CUSTOM_0 is 255, MICROUI_IMAGE_FORMAT_CUSTOM_7 is 248
+MICROUI_IMAGE_FORMAT_CUSTOM_0 = 255
+MICROUI_IMAGE_FORMAT_A4 = 7
+
+ALIGNMENT_PIXELS = 16
+
+# VGLite source buffer alignment (and DISPLAY_VGLITE_CLUT_ALIGNMENT)
+DATA_ALIGNMENT = 64
+
+PNG_SIGNATURE = b'\x89PNG\r\n\x1a\n'
+
+
+def read_png(data):
+    """Decodes a non-interlaced PNG of 8 bits per channel (or a palette of up to
+    8 bits). Returns (width, height, pixels): the pixels are (a, r, g, b) tuples,
+    line by line."""
+    if data[:8] != PNG_SIGNATURE:
+        raise ValueError('not a PNG image')
+    offset = 8
+    chunks = {}
+    idat = b''
+    while offset + 8 <= len(data):
+        length, kind = struct.unpack_from('>I4s', data, offset)
+        body = data[offset + 8:offset + 8 + length]
+        offset += 12 + length
+        if kind == b'IDAT':
+            idat += body
+        elif kind == b'IEND':
+            break
+        else:
+            chunks[kind] = body
+
+    width, height, depth, color_type, _, _, interlace = struct.unpack('>IIBBBBB', chunks[b'IHDR'])
+    if interlace != 0:
+        raise ValueError('interlaced PNG images are not supported')
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color_type]
+    if depth != 8 and not (color_type == 3 and depth in (1, 2, 4)):
+        raise ValueError('PNG bit depth %d is not supported' % depth)
+
+    line_size = (width * channels * depth + 7) // 8
+    bpp = max(1, (channels * depth) // 8)
+    raw = zlib.decompress(idat)
+    lines = []
+    previous = bytearray(line_size)
+    for y in range(height):
+        start = y * (line_size + 1)
+        method = raw[start]
+        line = bytearray(raw[start + 1:start + 1 + line_size])
+        for i in range(line_size):
+            left = line[i - bpp] if i >= bpp else 0
+            up = previous[i]
+            up_left = previous[i - bpp] if i >= bpp else 0
+            if method == 1:
+                line[i] = (line[i] + left) & 0xFF
+            elif method == 2:
+                line[i] = (line[i] + up) & 0xFF
+            elif method == 3:
+                line[i] = (line[i] + ((left + up) >> 1)) & 0xFF
+            elif method == 4:
+                p = left + up - up_left
+                pa, pb, pc = abs(p - left), abs(p - up), abs(p - up_left)
+                predictor = left if pa <= pb and pa <= pc else (up if pb <= pc else up_left)
+                line[i] = (line[i] + predictor) & 0xFF
+        lines.append(line)
+        previous = line
+
+    palette = chunks.get(b'PLTE', b'')
+    transparency = chunks.get(b'tRNS', b'')
+    pixels = []
+    for line in lines:
+        for x in range(width):
+            if color_type == 3:
+                index = (line[(x * depth) // 8] >> (8 - depth - (x * depth) % 8)) & ((1 << depth) - 1)
+                r, g, b = palette[index * 3:index * 3 + 3]
+                a = transparency[index] if index < len(transparency) else 0xFF
+            elif color_type == 0:
+                r = g = b = line[x]
+                a = 0xFF
+            elif color_type == 4:
+                r = g = b = line[x * 2]
+                a = line[x * 2 + 1]
+            elif color_type == 2:
+                r, g, b = line[x * 3:x * 3 + 3]
+                a = 0xFF
+            else:
+                r, g, b, a = line[x * 4:x * 4 + 4]
+            pixels.append((a, r, g, b))
+    return width, height, pixels
+
+
+def premultiply(pixel, image_format):
+    """Returns the pixel value in the image format, the channels multiplied by the
+    alpha (no channel greater than the alpha)."""
+    a, r, g, b = pixel
+    if image_format == 'ARGB8888':
+        r, g, b = [(c * a + 127) // 255 for c in (r, g, b)]
+        return (a << 24) | (r << 16) | (g << 8) | b
+    if image_format == 'ARGB4444':
+        a4 = (a * 15 + 127) // 255
+        r, g, b = [(c * a4 + 127) // 255 for c in (r, g, b)]
+        return (a4 << 12) | (r << 8) | (g << 4) | b
+    # 1-bit alpha: the transparent pixels are black
+    if a < 128:
+        return 0
+    r, g, b = [(c * 31 + 127) // 255 for c in (r, g, b)]
+    return 0x8000 | (r << 10) | (g << 5) | b
+
+
+def stride(width, image_format):
+    """Returns the line size in bytes (DISPLAY_VGLITE_PREMULTIPLIED_STRIDE(),
+    DISPLAY_VGLITE_INDEXED_STRIDE())."""
+    size = ((width + ALIGNMENT_PIXELS - 1) & ~(ALIGNMENT_PIXELS - 1)) * FORMATS[image_format][2] // 8
+    if image_format in INDEXED_FORMATS:
+        # at least 8 bytes
+        size = (size + 7) & ~7
+    return size
+
+
+def clut_size(image_format):
+    """Returns the size in bytes of the palette area (DISPLAY_VGLITE_CLUT_SIZE())."""
+    return ((4 << FORMATS[image_format][2]) + DATA_ALIGNMENT - 1) // DATA_ALIGNMENT * DATA_ALIGNMENT
+
+
+def data_size(width, height, image_format):
+    """Returns the size in bytes of the image data."""
+    size = stride(width, image_format) * height
+    if image_format in INDEXED_FORMATS:
+        size += clut_size(image_format)
+    return size
+
+
+def microui_format(image_format):
+    """Returns the MicroUI image format value (MICROUI_ImageFormat)."""
+    custom = FORMATS[image_format][0]
+    return MICROUI_IMAGE_FORMAT_A4 if custom is None else MICROUI_IMAGE_FORMAT_CUSTOM_0 - custom
+
+
+def palette(pixels):
+    """Returns the distinct ARGB8888 colors of the pixels, in order of appearance
+    (the fully transparent pixels share the color 0)."""
+    colors = {}
+    for pixel in pixels:
+        colors.setdefault(argb8888(pixel), len(colors))
+    return list(colors)
+
+
+def argb8888(pixel):
+    """Returns the straight ARGB8888 color of a pixel (0 when fully transparent)."""
+    a, r, g, b = pixel
+    return 0 if a == 0 else (a << 24) | (r << 16) | (g << 8) | b
+
+
+def pack_pixels(values, bpp, line_size):
+    """Returns a line of values of bpp bits, the first one in the least significant
+    bits of a byte."""
+    line = bytearray(line_size)
+    per_byte = 8 // bpp
+    for x, value in enumerate(values):
+        line[x // per_byte] |= value << ((x % per_byte) * bpp)
+    return line
+
+
+def convert(width, height, pixels, image_format):
+    """Returns the image data. Raises ValueError when the pixels do not fit in the
+    palette of an indexed format."""
+    line_size = stride(width, image_format)
+    bpp = FORMATS[image_format][2]
+    data = bytearray()
+    if image_format in INDEXED_FORMATS:
+        colors = palette(pixels)
+        if len(colors) > (1 << bpp):
+            raise ValueError('%d colors, %s holds at most %d' % (len(colors), image_format, 1 << bpp))
+        indexes = {color: i for i, color in enumerate(colors)}
+        data += struct.pack('<%dI' % len(colors), *colors)
+        data += bytes(clut_size(image_format) - len(data))
+        for y in range(height):
+            data += pack_pixels([indexes[argb8888(p)] for p in pixels[y * width:(y + 1) * width]], bpp, line_size)
+    elif image_format == 'A4':
+        for y in range(height):
+            data += pack_pixels([(p[0] * 15 + 127) // 255 for p in pixels[y * width:(y + 1) * width]], bpp, line_size)
+    else:
+        pack = '<I' if bpp == 32 else '<H'
+        data += bytes(line_size * height)
+        for y in range(height):
+            for x in range(width):
+                struct.pack_into(pack, data, y * line_size + x * struct.calcsize(pack),
+                                 premultiply(pixels[y * width + x], image_format))
+    return bytes(data)
+
+
+def report(images):
+    """Returns the asset memory report: the data size of each image in each format
+    ('-' when the colors do not fit in the palette) and the totals."""
+    names = list(FORMATS)
+    rows = []
+    totals = dict.fromkeys(names, 0)
+    for name, width, height, pixels in images:
+        colors = len(palette(pixels))
+        sizes = []
+        for image_format in names:
+            if image_format in INDEXED_FORMATS and colors > (1 << FORMATS[image_format][2]):
+                sizes.append('-')
+            else:
+                size = data_size(width, height, image_format)
+                totals[image_format] += size
+                sizes.append(str(size))
+        rows.append([name, '%dx%d' % (width, height), str(colors)] + sizes)
+    rows.append(['total', '', ''] + [str(totals[image_format]) for image_format in names])
+    header = ['image', 'size', 'colors'] + names
+    widths = [max(len(row[i]) for row in rows + [header]) for i in range(len(header))]
+    lines = []
+    for row in [header] + rows:
+        lines.append('  '.join(cell.ljust(widths[0]) if i == 0 else cell.rjust(widths[i]) for i, cell in enumerate(row)))
+    return '\n'.join(lines) + '\n'
+
+
+def c_array(name, data, width, height, image_format):
+    _, macro, _ = FORMATS[image_format]
+    kind = 'premultiplied' if image_format.startswith('ARGB') else ('indexed' if image_format in INDEXED_FORMATS else 'alpha')
+    lines = ['/*',
+             ' * %dx%d %s %s image (%s, MicroUI format %d),' % (
+                 width, height, image_format, kind, macro, microui_format(image_format)),
+             ' * %d bytes per line. Generated by vglite_image.py.' % stride(width, image_format),
+             ' */',
+             'const unsigned char %s[%d] __attribute__((aligned(%d))) = {' % (name, len(data), DATA_ALIGNMENT)]
+    for offset in range(0, len(data), 16):
+        lines.append('\t' + ', '.join('0x%02x' % byte for byte in data[offset:offset + 16]) + ',')
+    lines.append('};')
+    return ('\n'.join(lines) + '\n').encode('ascii')
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('input', nargs='+', help='PNG image (several with --report)')
+    parser.add_argument('-o', '--output', help='output file')
+    parser.add_argument('--format', choices=sorted(FORMATS), default='ARGB8888', help='output format')
+    parser.add_argument('--c-array', metavar='NAME', help='write a C array instead of a raw binary')
+    parser.add_argument('--report', action='store_true', help='print the data size of the images in each format')
+    args = parser.parse_args(argv)
+    if not args.report and (len(args.input) != 1 or args.output is None):
+        parser.error('one input and an output are required (or --report)')
+
+    images = []
+    for path in args.input:
+        with open(path, 'rb') as f:
+            try:
+                images.append((path,) + read_png(f.read()))
+            except (ValueError, KeyError, zlib.error) as e:
+                parser.error('%s: %s' % (path, e))
+
+    if args.report:
+        sys.stdout.write(report(images))
+        return 0
+
+    _, width, height, pixels = images[0]
+    try:
+        data = convert(width, height, pixels, args.format)
+    except ValueError as e:
+        parser.error('%s: %s' % (args.input[0], e))
+    with open(args.output, 'wb') as f:
+        f.write(c_array(args.c_array, data, width, height, args.format) if args.c_array else data)
+
+    _, macro, _ = FORMATS[args.format]
+    print('%s: %dx%d, %s (MicroUI format %d), stride %d bytes, %d bytes' % (
+        args.output, width, height, macro, microui_format(args.format),
+        stride(width, args.format), len(data)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
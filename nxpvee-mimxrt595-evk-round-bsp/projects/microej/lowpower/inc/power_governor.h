@@ -0,0 +1,220 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined POWER_GOVERNOR_H
+#define POWER_GOVERNOR_H
+
+/*
+ * @file
+ * @brief Deadline-driven selection of the power profile.
+ *
+ * The decision logic only depends on the samples it is fed with (frame times,
+ * touch events, CPU load and their timestamps): it does not access any
+ * hardware nor OS service, so it can be replayed on a host against recorded
+ * frame-time traces.
+ *
+ * Levels are sorted from the slowest (index 0) to the fastest one. The
+ * governor picks the lowest level whose predicted frame time still meets the
+ * frame deadline:
+ * - it goes up as soon as a frame does not fit in the deadline at the current
+ *   level,
+ * - it goes down only after a number of consecutive frames would have fit at
+ *   the lower level (hysteresis),
+ * - a touch event boosts to the fastest level for a while, in anticipation of
+ *   the animation it triggers,
+ * - when no frame is rendered and the CPU load is low, it goes to the
+ *   slowest level.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "power_governor_configuration.h"
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Description of a performance level.
+ */
+typedef struct {
+	uint32_t profile;           // value given to power_manager_set_profile()
+	uint32_t speed_percent;     // throughput relative to the fastest level
+	uint32_t power_weight;      // relative active power, used for energy estimates
+} power_governor_level_t;
+
+/*
+ * @brief Governor tuning.
+ */
+typedef struct {
+	const power_governor_level_t* levels;
+	uint8_t level_count;
+	uint32_t frame_deadline_us;     // frame period to meet
+	uint32_t target_load_percent;   // max part of the deadline a frame may use
+	uint32_t down_hold_frames;      // consecutive frames required before going down
+	uint32_t touch_boost_us;        // time spent at the fastest level after a touch
+	uint32_t idle_timeout_us;       // time without frame before considering the screen idle
+	uint32_t idle_load_percent;     // CPU load under which an idle screen goes to the slowest level
+} power_governor_config_t;
+
+/*
+ * @brief Governor statistics.
+ */
+typedef struct {
+	uint32_t frames;            // frames reported
+	uint32_t missed_deadlines;  // frames longer than the deadline
+	uint32_t level_switches;    // number of level changes
+	uint32_t touch_boosts;      // number of touch boosts
+	uint64_t energy;            // sum of power_weight * time (in ms) spent at each level
+} power_governor_stats_t;
+
+/*
+ * @brief Governor state.
+ */
+typedef struct {
+	const power_governor_config_t* config;
+	uint8_t level;
+	uint32_t down_count;
+	int64_t boost_end_us;
+	int64_t last_frame_us;
+	int64_t last_update_us;
+	uint64_t energy_us;         // energy accumulator in power_weight * us
+	power_governor_stats_t stats;
+} power_governor_t;
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Initializes the governor state.
+ *
+ * @param[in] governor: the governor state.
+ * @param[in] config: the governor tuning (must stay valid while the governor is used).
+ * @param[in] level: the current level.
+ * @param[in] now_us: the current time in microseconds.
+ */
+void power_governor_init(power_governor_t* governor, const power_governor_config_t* config, uint8_t level, int64_t now_us);
+
+/*
+ * @brief Reports a rendered frame.
+ *
+ * @param[in] governor: the governor state.
+ * @param[in] now_us: the current time in microseconds.
+ * @param[in] render_us: time spent to render the frame at the current level.
+ * @param[in] flush_us: time spent to flush the frame at the current level.
+ *
+ * @return the level to apply.
+ */
+uint8_t power_governor_on_frame(power_governor_t* governor, int64_t now_us, uint32_t render_us, uint32_t flush_us);
+
+/*
+ * @brief Reports a touch event.
+ *
+ * @param[in] governor: the governor state.
+ * @param[in] now_us: the current time in microseconds.
+ *
+ * @return the level to apply.
+ */
+uint8_t power_governor_on_touch(power_governor_t* governor, int64_t now_us);
+
+/*
+ * @brief Reports the CPU load measured over the last period.
+ *
+ * @param[in] governor: the governor state.
+ * @param[in] now_us: the current time in microseconds.
+ * @param[in] load_percent: the CPU load (100 - idle ratio).
+ *
+ * @return the level to apply.
+ */
+uint8_t power_governor_on_load(power_governor_t* governor, int64_t now_us, uint32_t load_percent);
+
+/*
+ * @brief Gets the governor statistics.
+ *
+ * @param[in] governor: the governor state.
+ * @param[in] now_us: the current time in microseconds (to account the energy of the current level).
+ * @param[out] stats: the statistics.
+ */
+void power_governor_get_stats(power_governor_t* governor, int64_t now_us, power_governor_stats_t* stats);
+
+/*
+ * OS glue (power_governor_impl_FreeRTOS.c): feeds the system governor and
+ * applies its decisions with power_manager_set_profile(). These functions must
+ * be called from a task, never from an interrupt.
+ *
+ * The render time of a frame is measured from its first drawing to its flush
+ * request: the time MicroUI waits for an event between two frames is not
+ * accounted.
+ *
+ * A profile switch changes the main clock (CPU and GPU) and the MIPI-DSI
+ * clock: the decisions are only recorded by the notifications and applied by
+ * power_governor_switch_profile(), which the display stack calls when it
+ * cannot start a GPU, DMA or DSI transfer.
+ *
+ * When POWER_GOVERNOR_TRACE_ENABLED is set, the inputs of the governor are
+ * printed on the console with the level of the profile applied when they were
+ * measured (times in microseconds, the time on 32 bits):
+ * - "PG F <time> <level> <render_us> <flush_us>": a frame,
+ * - "PG T <time> <level>": a touch press,
+ * - "PG L <time> <level> <load_percent>": a CPU load sample.
+ */
+
+/*
+ * @brief Starts the system governor.
+ */
+void power_governor_start(void);
+
+/*
+ * @brief Reports a drawing accepted by the MicroUI task. The first drawing
+ * after a flush starts the render time of the frame and applies the pending
+ * level (see power_governor_switch_profile()).
+ */
+void power_governor_notify_drawing(void);
+
+/*
+ * @brief Reports the flush request of a frame (MicroUI task): ends the render
+ * time of the frame (0 when nothing has been drawn).
+ */
+void power_governor_notify_flush(void);
+
+/*
+ * @brief Reports the end of the flush of a frame (display task).
+ */
+void power_governor_notify_frame(void);
+
+/*
+ * @brief Applies the level decided by the governor.
+ *
+ * Must only be called when no GPU, DMA or DSI transfer can start during the
+ * call: by the MicroUI task before the first drawing of a frame, or by the
+ * display task before the transfers of a flush (MicroUI waits for the end of
+ * the flush). The switch is postponed to the next call while a transfer
+ * started before is still running.
+ */
+void power_governor_switch_profile(void);
+
+/*
+ * @brief Reports a touch press.
+ */
+void power_governor_notify_touch(void);
+
+/*
+ * @brief Reports the CPU load computed by the cpuload module.
+ */
+void power_governor_notify_load(uint32_t load_percent);
+
+#endif // !defined POWER_GOVERNOR_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,70 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined POWER_GOVERNOR_CONFIGURATION_H
+#define POWER_GOVERNOR_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Change value to disable/enable the power governor:
+ * 0: the power profile is only selected by the application
+ *    (PowerManagementHelperNative.setPerfProfile())
+ * 1: the power profile is selected according to the rendering load
+ */
+#ifndef POWER_GOVERNOR_ENABLED
+#define POWER_GOVERNOR_ENABLED 0
+#endif
+
+/*
+ * @brief Change value to disable/enable the trace of the governor inputs on the
+ * console: one line per frame, touch press and CPU load sample, replayed on the
+ * host by test_power_governor (see power_governor.h for the format).
+ */
+#ifndef POWER_GOVERNOR_TRACE_ENABLED
+#define POWER_GOVERNOR_TRACE_ENABLED 0
+#endif
+
+/*
+ * @brief Frame deadline in microseconds (60 fps).
+ */
+#define POWER_GOVERNOR_FRAME_DEADLINE_US (16667)
+
+/*
+ * @brief Part of the deadline (in percent) a frame is allowed to use before
+ * switching to a faster level.
+ */
+#define POWER_GOVERNOR_TARGET_LOAD_PERCENT (85)
+
+/*
+ * @brief Number of consecutive frames that must fit at a lower level before
+ * switching to it.
+ */
+#define POWER_GOVERNOR_DOWN_HOLD_FRAMES (30)
+
+/*
+ * @brief Time spent at the fastest level after a touch press (in microseconds).
+ */
+#define POWER_GOVERNOR_TOUCH_BOOST_US (500000)
+
+/*
+ * @brief Time without any frame after which the screen is considered idle (in microseconds).
+ */
+#define POWER_GOVERNOR_IDLE_TIMEOUT_US (200000)
+
+/*
+ * @brief CPU load (in percent) under which an idle screen switches to the slowest level.
+ */
+#define POWER_GOVERNOR_IDLE_LOAD_PERCENT (20)
+
+#endif // !defined POWER_GOVERNOR_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -9,6 +9,8 @@
 #ifndef _POWER_MANAGER_H_
 #define _POWER_MANAGER_H_
 
+#include <stdbool.h>
+
 #include "display_framebuffer.h"
 
 void power_manager_init(void);
@@ -38,6 +40,10 @@ typedef enum {
 } power_mode_t;
 power_mode_t power_manager_get_mode(uint32_t config[4]);
 
+/* Return true while a GPU, DMA or SDMA (DSI) transfer is running: the clocks of
+ * the power profiles must not be switched. */
+bool power_manager_is_transfer_ongoing(void);
+
 /* RAM partitions power on/off */
 
 typedef enum {
@@ -58,5 +64,6 @@ void power_manager_framebuffer_request_power_off(void);
 #define POWER_PROFILE_POWER_SAVING  0x00
 
 #define power_manager_set_profile Java_com_nxp_rt595_util_PowerManagementHelperNative_setPerfProfile
+int32_t power_manager_set_profile(uint32_t power_profile);
 
 #endif
@@ -28,6 +28,7 @@
 #include "fsl_power.h"
 
 #include "cpuload.h"
+#include "cpuload_runtime.h"
 #include "board.h"
 #include "fsl_gpio.h"
 #include "time_hardware_timer.h"
@@ -118,6 +119,7 @@ void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime)
          * So: stop it and restart it at the same time than Systick.
          */
         cpuload_enter_sleep();
+        cpuload_runtime_enter_sleep();
 
 #ifdef PM_DEBUG
         PRINTF("enter_sleep\n");
@@ -159,6 +161,7 @@ void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime)
            vTaskStepTick(stepTick);
 
             cpuload_exit_sleep();
+            cpuload_runtime_exit_sleep();
             SysTick->LOAD = (configCPU_CLOCK_HZ / configTICK_RATE_HZ) - 1UL;
             SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
         }
@@ -0,0 +1,169 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Deadline-driven power governor: decision logic (OS and hardware independent).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "power_governor.h"
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Accumulates the energy spent at the current level since the last update.
+ */
+static void __power_governor_account(power_governor_t* governor, int64_t now_us);
+
+/*
+ * @brief Changes the current level.
+ */
+static void __power_governor_set_level(power_governor_t* governor, uint8_t level);
+
+/*
+ * @brief Returns the lowest level whose predicted frame time fits in the budget
+ * (the fastest level when none fits).
+ */
+static uint8_t __power_governor_lowest_level(power_governor_t* governor, uint32_t busy_us);
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void power_governor_init(power_governor_t* governor, const power_governor_config_t* config, uint8_t level, int64_t now_us) {
+	(void)memset(governor, 0, sizeof(power_governor_t));
+	governor->config = config;
+	governor->level = level;
+	governor->boost_end_us = now_us;
+	governor->last_frame_us = now_us;
+	governor->last_update_us = now_us;
+}
+
+// See the header file for the function documentation
+uint8_t power_governor_on_frame(power_governor_t* governor, int64_t now_us, uint32_t render_us, uint32_t flush_us) {
+	const power_governor_config_t* config = governor->config;
+	uint32_t busy_us = render_us + flush_us;
+
+	__power_governor_account(governor, now_us);
+	governor->stats.frames++;
+	governor->last_frame_us = now_us;
+	if (busy_us > config->frame_deadline_us) {
+		governor->stats.missed_deadlines++;
+	}
+
+	if (now_us < governor->boost_end_us) {
+		// touch boost in progress
+		governor->down_count = 0;
+		return governor->level;
+	}
+
+	uint8_t lowest = __power_governor_lowest_level(governor, busy_us);
+	if (lowest > governor->level) {
+		// the frame does not fit at the current level: go up at once
+		__power_governor_set_level(governor, lowest);
+		governor->down_count = 0;
+	}
+	else if (lowest < governor->level) {
+		// the frame would fit at a lower level: go down one step after a while
+		governor->down_count++;
+		if (governor->down_count >= config->down_hold_frames) {
+			__power_governor_set_level(governor, governor->level - 1);
+			governor->down_count = 0;
+		}
+	}
+	else {
+		governor->down_count = 0;
+	}
+
+	return governor->level;
+}
+
+// See the header file for the function documentation
+uint8_t power_governor_on_touch(power_governor_t* governor, int64_t now_us) {
+	const power_governor_config_t* config = governor->config;
+
+	__power_governor_account(governor, now_us);
+	governor->boost_end_us = now_us + config->touch_boost_us;
+	governor->down_count = 0;
+	if (governor->level != (config->level_count - 1)) {
+		governor->stats.touch_boosts++;
+		__power_governor_set_level(governor, config->level_count - 1);
+	}
+	return governor->level;
+}
+
+// See the header file for the function documentation
+uint8_t power_governor_on_load(power_governor_t* governor, int64_t now_us, uint32_t load_percent) {
+	const power_governor_config_t* config = governor->config;
+
+	__power_governor_account(governor, now_us);
+	if ((now_us >= governor->boost_end_us)
+			&& ((now_us - governor->last_frame_us) >= config->idle_timeout_us)
+			&& (load_percent < config->idle_load_percent)) {
+		// nothing is rendered and the CPU is mostly idle
+		__power_governor_set_level(governor, 0);
+		governor->down_count = 0;
+	}
+	return governor->level;
+}
+
+// See the header file for the function documentation
+void power_governor_get_stats(power_governor_t* governor, int64_t now_us, power_governor_stats_t* stats) {
+	__power_governor_account(governor, now_us);
+	*stats = governor->stats;
+	stats->energy = governor->energy_us / 1000u;
+}
+
+// -----------------------------------------------------------------------------
+// Internal functions
+// -----------------------------------------------------------------------------
+
+// See the section 'Internal function definitions' for the function documentation
+static void __power_governor_account(power_governor_t* governor, int64_t now_us) {
+	if (now_us > governor->last_update_us) {
+		uint64_t elapsed_us = (uint64_t)(now_us - governor->last_update_us);
+		governor->energy_us += elapsed_us * governor->config->levels[governor->level].power_weight;
+		governor->last_update_us = now_us;
+	}
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static void __power_governor_set_level(power_governor_t* governor, uint8_t level) {
+	if (level != governor->level) {
+		governor->level = level;
+		governor->stats.level_switches++;
+	}
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static uint8_t __power_governor_lowest_level(power_governor_t* governor, uint32_t busy_us) {
+	const power_governor_config_t* config = governor->config;
+	uint64_t budget_us = ((uint64_t)config->frame_deadline_us * config->target_load_percent) / 100u;
+	// work done during the frame, in us at 100% speed
+	uint64_t work = (uint64_t)busy_us * config->levels[governor->level].speed_percent;
+	uint8_t level;
+
+	for (level = 0; level < (config->level_count - 1); level++) {
+		if ((work / config->levels[level].speed_percent) <= budget_us) {
+			break;
+		}
+	}
+	return level;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
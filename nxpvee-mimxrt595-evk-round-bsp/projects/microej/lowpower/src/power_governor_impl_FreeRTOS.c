@@ -0,0 +1,206 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Deadline-driven power governor: FreeRTOS glue.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include "power_governor.h"
+
+#if POWER_GOVERNOR_ENABLED == 1
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+#include "power_manager.h"
+#include "time_hardware_timer.h"
+
+#if POWER_GOVERNOR_TRACE_ENABLED == 1
+#include "fsl_debug_console.h"
+#endif
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#if POWER_GOVERNOR_TRACE_ENABLED == 1
+/*
+ * @brief Prints an input of the governor (see power_governor.h).
+ */
+#define POWER_GOVERNOR_TRACE(event, now_us, format, ...) \
+	PRINTF("PG " event " %u %u" format "\n", (unsigned int)(now_us), (unsigned int)__power_governor_applied_level, ##__VA_ARGS__)
+#else
+#define POWER_GOVERNOR_TRACE(event, now_us, format, ...)
+#endif
+
+// -----------------------------------------------------------------------------
+// Static Constants
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Available levels, from the slowest to the fastest one.
+ *
+ * The power saving profile runs the main clock from FRO_DIV2 with the PMIC
+ * in mode 2 (lower voltage). The power weights are rough relative figures to
+ * be calibrated with board measurements.
+ */
+static const power_governor_level_t __power_governor_levels[] = {
+		{ POWER_PROFILE_POWER_SAVING, 50, 35 },
+		{ POWER_PROFILE_MAX_PERFS, 100, 100 },
+};
+
+static const power_governor_config_t __power_governor_config = {
+		.levels = __power_governor_levels,
+		.level_count = sizeof(__power_governor_levels) / sizeof(__power_governor_levels[0]),
+		.frame_deadline_us = POWER_GOVERNOR_FRAME_DEADLINE_US,
+		.target_load_percent = POWER_GOVERNOR_TARGET_LOAD_PERCENT,
+		.down_hold_frames = POWER_GOVERNOR_DOWN_HOLD_FRAMES,
+		.touch_boost_us = POWER_GOVERNOR_TOUCH_BOOST_US,
+		.idle_timeout_us = POWER_GOVERNOR_IDLE_TIMEOUT_US,
+		.idle_load_percent = POWER_GOVERNOR_IDLE_LOAD_PERCENT,
+};
+
+// -----------------------------------------------------------------------------
+// Static Variables
+// -----------------------------------------------------------------------------
+
+static power_governor_t __power_governor;
+
+/*
+ * @brief Protects the governor state and serializes the profile switches.
+ */
+static SemaphoreHandle_t __power_governor_mutex;
+
+static uint8_t __power_governor_level;          // level decided by the governor
+static uint8_t __power_governor_applied_level;  // level of the current profile
+
+/*
+ * @brief Frame timings, written by the MicroUI task; the flush request hands
+ * them over to the display task.
+ */
+static bool __power_governor_drawing;           // a drawing has been done since the last flush request
+static int64_t __power_governor_render_start_us;
+static int64_t __power_governor_flush_start_us;
+static uint32_t __power_governor_render_us;
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Records the level decided by the governor. Must be called with the
+ * mutex taken.
+ */
+static void __power_governor_apply(uint8_t level);
+
+#endif // POWER_GOVERNOR_ENABLED == 1
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void power_governor_start(void) {
+#if POWER_GOVERNOR_ENABLED == 1
+	__power_governor_mutex = xSemaphoreCreateMutex();
+	// boot profile is POWER_PROFILE_MAX_PERFS
+	__power_governor_level = __power_governor_config.level_count - 1;
+	__power_governor_applied_level = __power_governor_level;
+	power_governor_init(&__power_governor, &__power_governor_config, __power_governor_level, time_hardware_timer_getTimeUs());
+#endif
+}
+
+// See the header file for the function documentation
+void power_governor_notify_drawing(void) {
+#if POWER_GOVERNOR_ENABLED == 1
+	if (!__power_governor_drawing) {
+		__power_governor_drawing = true;
+		power_governor_switch_profile();
+		__power_governor_render_start_us = time_hardware_timer_getTimeUs();
+	}
+#endif
+}
+
+// See the header file for the function documentation
+void power_governor_notify_flush(void) {
+#if POWER_GOVERNOR_ENABLED == 1
+	__power_governor_flush_start_us = time_hardware_timer_getTimeUs();
+	__power_governor_render_us = __power_governor_drawing ? (uint32_t)(__power_governor_flush_start_us - __power_governor_render_start_us) : 0;
+	__power_governor_drawing = false;
+#endif
+}
+
+// See the header file for the function documentation
+void power_governor_notify_frame(void) {
+#if POWER_GOVERNOR_ENABLED == 1
+	int64_t now_us = time_hardware_timer_getTimeUs();
+	uint32_t flush_us = (uint32_t)(now_us - __power_governor_flush_start_us);
+	POWER_GOVERNOR_TRACE("F", now_us, " %u %u", (unsigned int)__power_governor_render_us, (unsigned int)flush_us);
+	xSemaphoreTake(__power_governor_mutex, portMAX_DELAY);
+	__power_governor_apply(power_governor_on_frame(&__power_governor, now_us, __power_governor_render_us, flush_us));
+	xSemaphoreGive(__power_governor_mutex);
+#endif
+}
+
+// See the header file for the function documentation
+void power_governor_switch_profile(void) {
+#if POWER_GOVERNOR_ENABLED == 1
+	xSemaphoreTake(__power_governor_mutex, portMAX_DELAY);
+	if ((__power_governor_level != __power_governor_applied_level) && !power_manager_is_transfer_ongoing()) {
+		(void)power_manager_set_profile(__power_governor_levels[__power_governor_level].profile);
+		__power_governor_applied_level = __power_governor_level;
+	}
+	xSemaphoreGive(__power_governor_mutex);
+#endif
+}
+
+// See the header file for the function documentation
+void power_governor_notify_touch(void) {
+#if POWER_GOVERNOR_ENABLED == 1
+	int64_t now_us = time_hardware_timer_getTimeUs();
+	POWER_GOVERNOR_TRACE("T", now_us, "");
+	xSemaphoreTake(__power_governor_mutex, portMAX_DELAY);
+	__power_governor_apply(power_governor_on_touch(&__power_governor, now_us));
+	xSemaphoreGive(__power_governor_mutex);
+#endif
+}
+
+// See the header file for the function documentation
+void power_governor_notify_load(uint32_t load_percent) {
+#if POWER_GOVERNOR_ENABLED == 1
+	int64_t now_us = time_hardware_timer_getTimeUs();
+	POWER_GOVERNOR_TRACE("L", now_us, " %u", (unsigned int)load_percent);
+	xSemaphoreTake(__power_governor_mutex, portMAX_DELAY);
+	__power_governor_apply(power_governor_on_load(&__power_governor, now_us, load_percent));
+	xSemaphoreGive(__power_governor_mutex);
+#else
+	(void)load_percent;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// Internal functions
+// -----------------------------------------------------------------------------
+
+#if POWER_GOVERNOR_ENABLED == 1
+
+// See the section 'Internal function definitions' for the function documentation
+static void __power_governor_apply(uint8_t level) {
+	// applied by the next call to power_governor_switch_profile()
+	__power_governor_level = level;
+}
+
+#endif // POWER_GOVERNOR_ENABLED == 1
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -9,6 +9,7 @@
 #include <stdint.h>
 #include <sni.h>
 #include "board.h"
+#include "cpuload_runtime.h"
 #include "fsl_debug_console.h"
 #include "fsl_pca9420.h"
 #include "fsl_power.h"
@@ -501,6 +502,14 @@ power_mode_t power_manager_get_mode(uint32_t config[4])
 	return PM_DEEP_SLEEP;
 }
 
+/* The domains flag their transfers by forbidding the low power modes. */
+bool power_manager_is_transfer_ongoing(void)
+{
+	return (low_power_enabled[POWER_GPU] == LOW_POWER_FORBIDDEN)
+			|| (low_power_enabled[POWER_DMA] == LOW_POWER_FORBIDDEN)
+			|| (low_power_enabled[POWER_SDMA] == LOW_POWER_FORBIDDEN);
+}
+
 static int current_power_profile = POWER_PROFILE_MAX_PERFS; /* by default boot with max perfs.*/
 
 /* Native function called directly by Java apps to request a given power profile. */
@@ -550,6 +559,7 @@ int32_t power_manager_set_profile(uint32_t power_profile)
     BOARD_SetFlexspiClock(FLEXSPI0, 0U, 1U); // move back fkexspi to main clock
 
 	SystemCoreClock = CLOCK_GetFreq(kCLOCK_CoreSysClk);
+	cpuload_runtime_clock_changed();
 	current_power_profile = power_profile;
 
 #if (ENABLE_SVIEW == 1)
@@ -48,6 +48,9 @@ typedef void* OSAL_binary_semaphore_handle_t;
 /** @brief OS mutex handle */
 typedef void* OSAL_mutex_handle_t;
 
+/** @brief OS event handle */
+typedef void* OSAL_event_handle_t;
+
 /*
  * Each OSAL port has a unique osal_portmacro.h header file.
  *
@@ -252,6 +255,67 @@ OSAL_status_t OSAL_mutex_take(OSAL_mutex_handle_t* handle, uint32_t timeout);
  */
 OSAL_status_t OSAL_mutex_give(OSAL_mutex_handle_t* handle);
 
+/**
+ * @brief Create an OS event: a set of 32 flags that one task waits for. The flags are
+ * set by other tasks or by interrupt handlers (e.g. one flag per interrupt source) and
+ * stay set until the waiting task receives them. Setting a flag that is already set
+ * has no effect, like giving a binary semaphore that is already available.
+ *
+ * The FreeRTOS port wakes up the waiting task with its direct-to-task notification:
+ * a task that waits for events must not use its notification for another purpose.
+ *
+ * @param[in] name event name
+ * @param[in,out] handle pointer on an event handle
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_event_create(uint8_t* name, OSAL_event_handle_t* handle);
+
+/**
+ * @brief Delete an OS event.
+ *
+ * @param[in] handle pointer on the event handle
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_event_delete(OSAL_event_handle_t* handle);
+
+/**
+ * @brief Set flags of an OS event and wake up the task that waits for one of them.
+ * This method must not be called from an interrupt (@see OSAL_event_set_from_isr).
+ *
+ * @param[in] handle pointer on the event handle
+ * @param[in] flags flags to set
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_event_set(OSAL_event_handle_t* handle, uint32_t flags);
+
+/**
+ * @brief Set flags of an OS event from an interrupt handler. When the woken up task has
+ * a higher priority than the interrupted one, it is scheduled on the interrupt exit.
+ *
+ * @param[in] handle pointer on the event handle
+ * @param[in] flags flags to set
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_event_set_from_isr(OSAL_event_handle_t* handle, uint32_t flags);
+
+/**
+ * @brief Wait operation on OS event. Block the current task until at least one of the
+ * given flags is set or timeout occurred. The received flags are cleared, the other
+ * flags stay set for a next wait. Only one task at a time may wait for an event.
+ *
+ * @param[in] handle pointer on the event handle
+ * @param[in] flags flags to wait for
+ * @param[out] received the received flags (a subset of flags, 0 on timeout). NULL if not needed
+ * @param[in] timeout maximum time to wait until one of the flags is set, OSAL_INFINITE_TIME for infinite timeout
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_event_wait(OSAL_event_handle_t* handle, uint32_t flags, uint32_t* received, uint32_t timeout);
+
 /**
  * @brief Disable the OS scheduler context switching. Prevent the OS from
  * scheduling the current thread calling #OSAL_disable_context_switching while
@@ -24,6 +24,16 @@
 #include "task.h"
 #include "semphr.h"
 
+/**
+ * @brief An OS event: the flags and the task that waits for them. The flags are updated
+ * with atomic operations (also from the interrupt handlers); the notification of the
+ * waiting task only wakes it up.
+ */
+typedef struct
+{
+	uint32_t flags;
+	TaskHandle_t task;
+} OSAL_FreeRTOS_event_t;
 
 static TickType_t OSAL_FreeRTOS_convert_time_to_tick(uint32_t milliseconds);
 
@@ -427,6 +437,160 @@ OSAL_status_t OSAL_mutex_give(OSAL_mutex_handle_t* handle)
 	return OSAL_OK;
 }
 
+/**
+ * @brief Create an OS event: a set of 32 flags that one task waits for.
+ *
+ * @param[in] name event name
+ * @param[in,out] handle pointer on an event handle
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_event_create(uint8_t* name, OSAL_event_handle_t* handle)
+{
+	if(handle == NULL)
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_FreeRTOS_event_t* event = (OSAL_FreeRTOS_event_t*)pvPortMalloc(sizeof(OSAL_FreeRTOS_event_t));
+	if(event == NULL)
+	{
+		return OSAL_NOMEM;
+	}
+	event->flags = 0;
+	event->task = NULL;
+
+	*handle = (OSAL_event_handle_t)event;
+	return OSAL_OK;
+}
+
+/**
+ * @brief Delete an OS event.
+ *
+ * @param[in] handle pointer on the event handle
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_event_delete(OSAL_event_handle_t* handle)
+{
+	if(handle == NULL)
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	vPortFree(*handle);
+	return OSAL_OK;
+}
+
+/**
+ * @brief Set flags of an OS event and wake up the task that waits for one of them.
+ *
+ * @param[in] handle pointer on the event handle
+ * @param[in] flags flags to set
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_event_set(OSAL_event_handle_t* handle, uint32_t flags)
+{
+	if((handle == NULL) || (*handle == NULL))
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_FreeRTOS_event_t* event = (OSAL_FreeRTOS_event_t*)*handle;
+
+	// the flags are set before the task is read: a task that starts waiting meanwhile
+	// sees them (see OSAL_event_wait())
+	(void)__atomic_fetch_or(&event->flags, flags, __ATOMIC_SEQ_CST);
+	TaskHandle_t task = __atomic_load_n(&event->task, __ATOMIC_SEQ_CST);
+	if(task != NULL)
+	{
+		(void)xTaskNotifyGive(task);
+	}
+	return OSAL_OK;
+}
+
+/**
+ * @brief Set flags of an OS event from an interrupt handler.
+ *
+ * @param[in] handle pointer on the event handle
+ * @param[in] flags flags to set
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_event_set_from_isr(OSAL_event_handle_t* handle, uint32_t flags)
+{
+	if((handle == NULL) || (*handle == NULL))
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_FreeRTOS_event_t* event = (OSAL_FreeRTOS_event_t*)*handle;
+
+	(void)__atomic_fetch_or(&event->flags, flags, __ATOMIC_SEQ_CST);
+	TaskHandle_t task = __atomic_load_n(&event->task, __ATOMIC_SEQ_CST);
+	if(task != NULL)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+		vTaskNotifyGiveFromISR(task, &xHigherPriorityTaskWoken);
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+	}
+	return OSAL_OK;
+}
+
+/**
+ * @brief Wait operation on OS event. Block the current task until at least one of the
+ * given flags is set or timeout occurred. The received flags are cleared.
+ *
+ * @param[in] handle pointer on the event handle
+ * @param[in] flags flags to wait for
+ * @param[out] received the received flags (a subset of flags, 0 on timeout). NULL if not needed
+ * @param[in] timeout maximum time to wait until one of the flags is set
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_event_wait(OSAL_event_handle_t* handle, uint32_t flags, uint32_t* received, uint32_t timeout)
+{
+	if((handle == NULL) || (*handle == NULL) || (flags == 0u))
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_FreeRTOS_event_t* event = (OSAL_FreeRTOS_event_t*)*handle;
+	OSAL_status_t status = OSAL_OK;
+	uint32_t got;
+	TickType_t timeout_in_tick = OSAL_FreeRTOS_convert_time_to_tick(timeout);
+	TimeOut_t time_out;
+	vTaskSetTimeOutState(&time_out);
+
+	// the task is published before the flags are read: a flag set meanwhile notifies it
+	__atomic_store_n(&event->task, xTaskGetCurrentTaskHandle(), __ATOMIC_SEQ_CST);
+	do
+	{
+		got = __atomic_fetch_and(&event->flags, ~flags, __ATOMIC_SEQ_CST) & flags;
+		if(got == 0u)
+		{
+			if(xTaskCheckForTimeOut(&time_out, &timeout_in_tick) != pdFALSE)
+			{
+				status = OSAL_ERROR;
+			}
+			else
+			{
+				// woken up by any set of this event (or of another event this task waits
+				// for): the flags are checked again
+				(void)ulTaskNotifyTake(pdTRUE, timeout_in_tick);
+			}
+		}
+	}
+	while((got == 0u) && (status == OSAL_OK));
+
+	if(received != NULL)
+	{
+		*received = got;
+	}
+	return status;
+}
+
 /**
  * @brief Disable the OS scheduler context switching. Prevent the OS from
  * scheduling the current thread calling #OSAL_disable_context_switching while
@@ -0,0 +1,883 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/**
+ * @file
+ * @brief OS Abstraction Layer POSIX implementation (pthreads), used by the host
+ * build of the native layer (see projects/host). The task priorities are ignored
+ * and OSAL_disable_context_switching() only excludes the other tasks that disable
+ * the context switching: the host scheduler cannot be suspended.
+ */
+
+#if defined(__linux__)
+#define _GNU_SOURCE
+#else
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "osal.h"
+
+/** @brief Longest task name accepted by pthread_setname_np() (terminating 0 included). */
+#define OSAL_POSIX_TASK_NAME_LENGTH 16
+
+typedef struct {
+	pthread_t thread;
+	OSAL_task_entry_point_t entry_point;
+	void* parameters;
+	char name[OSAL_POSIX_TASK_NAME_LENGTH];
+} OSAL_posix_task_t;
+
+typedef struct {
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	uint32_t size;
+	uint32_t head;
+	uint32_t count;
+	void* messages[];
+} OSAL_posix_queue_t;
+
+typedef struct {
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	uint32_t count;
+	uint32_t max_count;
+} OSAL_posix_semaphore_t;
+
+typedef struct {
+	pthread_mutex_t mutex;
+} OSAL_posix_mutex_t;
+
+typedef struct {
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	uint32_t flags;
+} OSAL_posix_event_t;
+
+static pthread_once_t OSAL_posix_scheduler_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t OSAL_posix_scheduler_lock;
+
+static OSAL_status_t OSAL_posix_cond_create(pthread_mutex_t* mutex, pthread_cond_t* cond);
+static void OSAL_posix_cond_delete(pthread_mutex_t* mutex, pthread_cond_t* cond);
+static void OSAL_posix_deadline(clockid_t clock, uint32_t milliseconds, struct timespec* deadline);
+static OSAL_status_t OSAL_posix_wait(pthread_cond_t* cond, pthread_mutex_t* mutex, uint32_t timeout, const struct timespec* deadline);
+static OSAL_status_t OSAL_posix_semaphore_create(uint32_t initial_count, uint32_t max_count, void** handle);
+static OSAL_status_t OSAL_posix_semaphore_delete(void** handle);
+static OSAL_status_t OSAL_posix_semaphore_take(void** handle, uint32_t timeout);
+static OSAL_status_t OSAL_posix_semaphore_give(void** handle);
+static void OSAL_posix_scheduler_initialize(void);
+static void* OSAL_posix_task_start(void* args);
+
+/**
+ * @brief Create an OS task and start it.
+ *
+ * @param[in] entry_point function called at task startup
+ * @param[in] name the task name
+ * @param[in] stack task stack declared using OSAL_task_stack_declare() macro
+ * @param[in] priority task priority (ignored)
+ * @param[in] parameters task entry parameters. NULL if no entry parameters
+ * @param[in,out] handle pointer on a task handle
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_task_create(OSAL_task_entry_point_t entry_point, uint8_t* name, OSAL_task_stack_t stack, int32_t priority, void* parameters, OSAL_task_handle_t* handle)
+{
+	(void)priority;
+
+	if((handle == NULL) || (entry_point == NULL))
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_posix_task_t* task = malloc(sizeof(OSAL_posix_task_t));
+	if(task == NULL)
+	{
+		return OSAL_NOMEM;
+	}
+
+	task->entry_point = entry_point;
+	task->parameters = parameters;
+	task->name[0] = '\0';
+	if(name != NULL)
+	{
+		(void)strncpy(task->name, (char const*)name, sizeof(task->name) - 1);
+		task->name[sizeof(task->name) - 1] = '\0';
+	}
+
+	pthread_attr_t attr;
+	size_t stack_size = (size_t)stack;
+	(void)pthread_attr_init(&attr);
+	if(stack_size < (size_t)PTHREAD_STACK_MIN)
+	{
+		stack_size = (size_t)PTHREAD_STACK_MIN;
+	}
+	(void)pthread_attr_setstacksize(&attr, stack_size);
+
+	// the handle is valid when the task starts (a task may delete itself)
+	*handle = task;
+	int result = pthread_create(&task->thread, &attr, OSAL_posix_task_start, task);
+	(void)pthread_attr_destroy(&attr);
+	if(result != 0)
+	{
+		*handle = NULL;
+		free(task);
+		return OSAL_ERROR;
+	}
+
+	return OSAL_OK;
+}
+
+/**
+ * @brief Delete an OS task and release its resources (also when its entry point
+ * has returned). A task that deletes itself exits.
+ *
+ * @param[in] handle pointer on the task handle
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_task_delete(OSAL_task_handle_t* handle)
+{
+	if((handle == NULL) || (*handle == NULL))
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_posix_task_t* task = (OSAL_posix_task_t*)*handle;
+	pthread_t thread = task->thread;
+	free(task);
+
+	if(pthread_equal(thread, pthread_self()))
+	{
+		(void)pthread_detach(thread);
+		pthread_exit(NULL);
+	}
+
+	(void)pthread_cancel(thread);
+	(void)pthread_join(thread, NULL);
+	return OSAL_OK;
+}
+
+/**
+ * @brief Create an OS queue with a predefined queue size.
+ *
+ * @param[in,out] handle pointer on a queue handle
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_queue_create(uint8_t* name, uint32_t size, OSAL_queue_handle_t* handle)
+{
+	(void)name;
+
+	if((handle == NULL) || (size == 0u))
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_posix_queue_t* queue = malloc(sizeof(OSAL_posix_queue_t) + (size * sizeof(void*)));
+	if(queue == NULL)
+	{
+		return OSAL_NOMEM;
+	}
+
+	if(OSAL_posix_cond_create(&queue->mutex, &queue->cond) != OSAL_OK)
+	{
+		free(queue);
+		return OSAL_ERROR;
+	}
+	queue->size = size;
+	queue->head = 0;
+	queue->count = 0;
+
+	*handle = queue;
+	return OSAL_OK;
+}
+
+/**
+ * @brief Delete an OS queue.
+ *
+ * @param[in] handle pointer on the queue handle
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_queue_delete(OSAL_queue_handle_t* handle)
+{
+	if((handle == NULL) || (*handle == NULL))
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_posix_queue_t* queue = (OSAL_posix_queue_t*)*handle;
+	OSAL_posix_cond_delete(&queue->mutex, &queue->cond);
+	free(queue);
+	return OSAL_OK;
+}
+
+/**
+ * @brief Post a message in an OS queue. Does not block: fails when the queue is full.
+ *
+ * @param[in] handle pointer on the queue handle
+ * @param[in] msg message to post in the message queue
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_queue_post(OSAL_queue_handle_t* handle, void* msg)
+{
+	if((handle == NULL) || (*handle == NULL))
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_posix_queue_t* queue = (OSAL_posix_queue_t*)*handle;
+	OSAL_status_t status = OSAL_NOMEM;
+
+	(void)pthread_mutex_lock(&queue->mutex);
+	if(queue->count < queue->size)
+	{
+		queue->messages[(queue->head + queue->count) % queue->size] = msg;
+		queue->count++;
+		(void)pthread_cond_signal(&queue->cond);
+		status = OSAL_OK;
+	}
+	(void)pthread_mutex_unlock(&queue->mutex);
+	return status;
+}
+
+/**
+ * @brief Fetch a message from an OS queue. Blocks until a message arrived or a timeout occurred.
+ *
+ * @param[in] handle pointer on the queue handle
+ * @param[in,out] msg message fetched in the OS queue
+ * @param[in] timeout maximum time to wait for message arrival
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_queue_fetch(OSAL_queue_handle_t* handle, void** msg, uint32_t timeout)
+{
+	if((handle == NULL) || (*handle == NULL) || (msg == NULL))
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_posix_queue_t* queue = (OSAL_posix_queue_t*)*handle;
+	OSAL_status_t status = OSAL_OK;
+	struct timespec deadline;
+	OSAL_posix_deadline(CLOCK_MONOTONIC, timeout, &deadline);
+
+	(void)pthread_mutex_lock(&queue->mutex);
+	while((queue->count == 0u) && (status == OSAL_OK))
+	{
+		status = OSAL_posix_wait(&queue->cond, &queue->mutex, timeout, &deadline);
+	}
+	if(queue->count != 0u)
+	{
+		*msg = queue->messages[queue->head];
+		queue->head = (queue->head + 1u) % queue->size;
+		queue->count--;
+		status = OSAL_OK;
+	}
+	(void)pthread_mutex_unlock(&queue->mutex);
+	return status;
+}
+
+/**
+ * @brief Create an OS counter semaphore with a semaphore count initial value.
+ *
+ * @param[in] name counter semaphore name
+ * @param[in] initial_count counter semaphore initial count value
+ * @param[in] max_count counter semaphore maximum count value
+ * @param[in,out] handle pointer on a counter semaphore handle
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_counter_semaphore_create(uint8_t* name, uint32_t initial_count, uint32_t max_count, OSAL_counter_semaphore_handle_t* handle)
+{
+	(void)name;
+	return OSAL_posix_semaphore_create(initial_count, max_count, handle);
+}
+
+/**
+ * @brief Delete an OS counter semaphore.
+ *
+ * @param[in] handle pointer on the counter semaphore handle
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_counter_semaphore_delete(OSAL_counter_semaphore_handle_t* handle)
+{
+	return OSAL_posix_semaphore_delete(handle);
+}
+
+/**
+ * @brief Take operation on OS counter semaphore. Block the current task until counter semaphore
+ * become available or timeout occurred. Decrease the counter semaphore count value by 1 and
+ * block the current task if count value equals to 0.
+ *
+ * @param[in] handle pointer on the counter semaphore handle
+ * @param[in] timeout maximum time to wait until the counter semaphore become available
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_counter_semaphore_take(OSAL_counter_semaphore_handle_t* handle, uint32_t timeout)
+{
+	return OSAL_posix_semaphore_take(handle, timeout);
+}
+
+/**
+ * @brief Give operation on OS counter semaphore. Increase the counter semaphore count value by 1 and unblock the current task if count value.
+ * equals to 0.
+ *
+ * @param[in] handle pointer on the counter semaphore handle
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_counter_semaphore_give(OSAL_counter_semaphore_handle_t* handle)
+{
+	return OSAL_posix_semaphore_give(handle);
+}
+
+/**
+ * @brief Create an OS binary semaphore with a semaphore count initial value (0 or 1).
+ *
+ * @param[in] name counter semaphore name
+ * @param[in] initial_count counter semaphore initial count value
+ * @param[in,out] handle pointer on a binary semaphore handle
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_binary_semaphore_create(uint8_t* name, uint32_t initial_count, OSAL_binary_semaphore_handle_t* handle)
+{
+	(void)name;
+	return OSAL_posix_semaphore_create((initial_count != 0u) ? 1u : 0u, 1u, handle);
+}
+
+/**
+ * @brief Delete an OS binary semaphore.
+ *
+ * @param[in] handle pointer on the binary semaphore handle
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_binary_semaphore_delete(OSAL_binary_semaphore_handle_t* handle)
+{
+	return OSAL_posix_semaphore_delete(handle);
+}
+
+/**
+ * @brief Take operation on OS binary semaphore. Block the current task until binary semaphore
+ * become available or timeout occurred. Decrease the binary semaphore count value by 1 and
+ * block the current task if count value equals to 0.
+ *
+ * @param[in] handle pointer on the binary semaphore handle
+ * @param[in] timeout maximum time to wait until the binary semaphore become available
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_binary_semaphore_take(OSAL_binary_semaphore_handle_t* handle, uint32_t timeout)
+{
+	return OSAL_posix_semaphore_take(handle, timeout);
+}
+
+/**
+ * @brief Give operation on OS binary semaphore. Increase the binary semaphore count value by 1 and unblock the current task if count value.
+ * equals to 0.
+ *
+ * @param[in] handle pointer on the binary semaphore handle
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_binary_semaphore_give(OSAL_binary_semaphore_handle_t* handle)
+{
+	return OSAL_posix_semaphore_give(handle);
+}
+
+/**
+ * @brief Create an OS mutex.
+ *
+ * @param[in] name mutex name
+ * @param[in,out] handle pointer on a mutex handle
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_mutex_create(uint8_t* name, OSAL_mutex_handle_t* handle)
+{
+	(void)name;
+
+	if(handle == NULL)
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_posix_mutex_t* mutex = malloc(sizeof(OSAL_posix_mutex_t));
+	if(mutex == NULL)
+	{
+		return OSAL_NOMEM;
+	}
+
+	// like a FreeRTOS mutex: not recursive, only given by its holder
+	pthread_mutexattr_t attr;
+	(void)pthread_mutexattr_init(&attr);
+	(void)pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ERRORCHECK);
+	int result = pthread_mutex_init(&mutex->mutex, &attr);
+	(void)pthread_mutexattr_destroy(&attr);
+	if(result != 0)
+	{
+		free(mutex);
+		return OSAL_ERROR;
+	}
+
+	*handle = mutex;
+	return OSAL_OK;
+}
+
+/**
+ * @brief Delete an OS mutex.
+ *
+ * @param[in] handle pointer on the mutex handle
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_mutex_delete(OSAL_mutex_handle_t* handle)
+{
+	if((handle == NULL) || (*handle == NULL))
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_posix_mutex_t* mutex = (OSAL_posix_mutex_t*)*handle;
+	(void)pthread_mutex_destroy(&mutex->mutex);
+	free(mutex);
+	return OSAL_OK;
+}
+
+/**
+ * @brief Take operation on OS mutex.
+ *
+ * @param[in] handle pointer on the mutex handle
+ * @param[in] timeout maximum time to wait until the mutex become available
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_mutex_take(OSAL_mutex_handle_t* handle, uint32_t timeout)
+{
+	if((handle == NULL) || (*handle == NULL))
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_posix_mutex_t* mutex = (OSAL_posix_mutex_t*)*handle;
+	int result;
+
+	if(timeout == OSAL_INFINITE_TIME)
+	{
+		result = pthread_mutex_lock(&mutex->mutex);
+	}
+	else if(timeout == 0u)
+	{
+		result = pthread_mutex_trylock(&mutex->mutex);
+	}
+	else
+	{
+		// pthread_mutex_timedlock() waits until a CLOCK_REALTIME deadline
+		struct timespec deadline;
+		OSAL_posix_deadline(CLOCK_REALTIME, timeout, &deadline);
+		result = pthread_mutex_timedlock(&mutex->mutex, &deadline);
+	}
+
+	if(result != 0)
+	{
+		return OSAL_ERROR;
+	}
+	return OSAL_OK;
+}
+
+/**
+ * @brief Give operation on OS mutex.
+ *
+ * @param[in] handle pointer on the mutex handle
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_mutex_give(OSAL_mutex_handle_t* handle)
+{
+	if((handle == NULL) || (*handle == NULL))
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_posix_mutex_t* mutex = (OSAL_posix_mutex_t*)*handle;
+	if(pthread_mutex_unlock(&mutex->mutex) != 0)
+	{
+		return OSAL_ERROR;
+	}
+	return OSAL_OK;
+}
+
+/**
+ * @brief Create an OS event: a set of 32 flags that one task waits for.
+ *
+ * @param[in] name event name
+ * @param[in,out] handle pointer on an event handle
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_event_create(uint8_t* name, OSAL_event_handle_t* handle)
+{
+	(void)name;
+
+	if(handle == NULL)
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_posix_event_t* event = malloc(sizeof(OSAL_posix_event_t));
+	if(event == NULL)
+	{
+		return OSAL_NOMEM;
+	}
+
+	if(OSAL_posix_cond_create(&event->mutex, &event->cond) != OSAL_OK)
+	{
+		free(event);
+		return OSAL_ERROR;
+	}
+	event->flags = 0u;
+
+	*handle = event;
+	return OSAL_OK;
+}
+
+/**
+ * @brief Delete an OS event.
+ *
+ * @param[in] handle pointer on the event handle
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_event_delete(OSAL_event_handle_t* handle)
+{
+	if((handle == NULL) || (*handle == NULL))
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_posix_event_t* event = (OSAL_posix_event_t*)*handle;
+	OSAL_posix_cond_delete(&event->mutex, &event->cond);
+	free(event);
+	return OSAL_OK;
+}
+
+/**
+ * @brief Set flags of an OS event and wake up the task that waits for one of them.
+ *
+ * @param[in] handle pointer on the event handle
+ * @param[in] flags flags to set
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_event_set(OSAL_event_handle_t* handle, uint32_t flags)
+{
+	if((handle == NULL) || (*handle == NULL))
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_posix_event_t* event = (OSAL_posix_event_t*)*handle;
+	(void)pthread_mutex_lock(&event->mutex);
+	event->flags |= flags;
+	(void)pthread_cond_signal(&event->cond);
+	(void)pthread_mutex_unlock(&event->mutex);
+	return OSAL_OK;
+}
+
+/**
+ * @brief Set flags of an OS event from an interrupt handler. On the host, the
+ * "interrupts" are threads (e.g. a simulated GPU): same as #OSAL_event_set.
+ *
+ * @param[in] handle pointer on the event handle
+ * @param[in] flags flags to set
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_event_set_from_isr(OSAL_event_handle_t* handle, uint32_t flags)
+{
+	return OSAL_event_set(handle, flags);
+}
+
+/**
+ * @brief Wait operation on OS event. Block the current task until at least one of the
+ * given flags is set or timeout occurred. The received flags are cleared.
+ *
+ * @param[in] handle pointer on the event handle
+ * @param[in] flags flags to wait for
+ * @param[out] received the received flags (a subset of flags, 0 on timeout). NULL if not needed
+ * @param[in] timeout maximum time to wait until one of the flags is set
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_event_wait(OSAL_event_handle_t* handle, uint32_t flags, uint32_t* received, uint32_t timeout)
+{
+	if((handle == NULL) || (*handle == NULL) || (flags == 0u))
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_posix_event_t* event = (OSAL_posix_event_t*)*handle;
+	OSAL_status_t status = OSAL_OK;
+	struct timespec deadline;
+	OSAL_posix_deadline(CLOCK_MONOTONIC, timeout, &deadline);
+
+	(void)pthread_mutex_lock(&event->mutex);
+	while(((event->flags & flags) == 0u) && (status == OSAL_OK))
+	{
+		status = OSAL_posix_wait(&event->cond, &event->mutex, timeout, &deadline);
+	}
+	uint32_t got = event->flags & flags;
+	event->flags &= ~got;
+	(void)pthread_mutex_unlock(&event->mutex);
+
+	if(received != NULL)
+	{
+		*received = got;
+	}
+	return (got != 0u) ? OSAL_OK : OSAL_ERROR;
+}
+
+/**
+ * @brief Disable the OS scheduler context switching. On the host, the scheduler
+ * cannot be suspended: the calls are serialized by a recursive lock, so the
+ * sections between #OSAL_disable_context_switching and #OSAL_enable_context_switching
+ * exclude each other.
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_disable_context_switching(void)
+{
+	(void)pthread_once(&OSAL_posix_scheduler_once, OSAL_posix_scheduler_initialize);
+	if(pthread_mutex_lock(&OSAL_posix_scheduler_lock) != 0)
+	{
+		return OSAL_ERROR;
+	}
+	return OSAL_OK;
+}
+
+/**
+ * @brief Reenable the OS scheduling that was disabled by #OSAL_disable_context_switching.
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_enable_context_switching(void)
+{
+	(void)pthread_once(&OSAL_posix_scheduler_once, OSAL_posix_scheduler_initialize);
+	if(pthread_mutex_unlock(&OSAL_posix_scheduler_lock) != 0)
+	{
+		return OSAL_ERROR;
+	}
+	return OSAL_OK;
+}
+
+/**
+ * @brief Asleep the current task during specified number of milliseconds.
+ *
+ * @param[in] milliseconds number of milliseconds
+ *
+ * @return operation status (@see OSAL_status_t)
+ */
+OSAL_status_t OSAL_sleep(uint32_t milliseconds)
+{
+	struct timespec delay;
+	delay.tv_sec = (time_t)(milliseconds / 1000u);
+	delay.tv_nsec = (long)(milliseconds % 1000u) * 1000000L;
+
+	// resume after the signals
+	while((nanosleep(&delay, &delay) != 0) && (errno == EINTR))
+	{
+	}
+	return OSAL_OK;
+}
+
+static OSAL_status_t OSAL_posix_cond_create(pthread_mutex_t* mutex, pthread_cond_t* cond)
+{
+	pthread_condattr_t attr;
+
+	if(pthread_mutex_init(mutex, NULL) != 0)
+	{
+		return OSAL_ERROR;
+	}
+
+	// the timeouts do not depend on the changes of the wall clock
+	(void)pthread_condattr_init(&attr);
+	(void)pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	int result = pthread_cond_init(cond, &attr);
+	(void)pthread_condattr_destroy(&attr);
+	if(result != 0)
+	{
+		(void)pthread_mutex_destroy(mutex);
+		return OSAL_ERROR;
+	}
+	return OSAL_OK;
+}
+
+static void OSAL_posix_cond_delete(pthread_mutex_t* mutex, pthread_cond_t* cond)
+{
+	(void)pthread_cond_destroy(cond);
+	(void)pthread_mutex_destroy(mutex);
+}
+
+static void OSAL_posix_deadline(clockid_t clock, uint32_t milliseconds, struct timespec* deadline)
+{
+	(void)clock_gettime(clock, deadline);
+	if(milliseconds != OSAL_INFINITE_TIME)
+	{
+		deadline->tv_sec += (time_t)(milliseconds / 1000u);
+		deadline->tv_nsec += (long)(milliseconds % 1000u) * 1000000L;
+		if(deadline->tv_nsec >= 1000000000L)
+		{
+			deadline->tv_sec++;
+			deadline->tv_nsec -= 1000000000L;
+		}
+	}
+}
+
+static OSAL_status_t OSAL_posix_wait(pthread_cond_t* cond, pthread_mutex_t* mutex, uint32_t timeout, const struct timespec* deadline)
+{
+	int result;
+
+	if(timeout == 0u)
+	{
+		result = ETIMEDOUT;
+	}
+	else if(timeout == OSAL_INFINITE_TIME)
+	{
+		result = pthread_cond_wait(cond, mutex);
+	}
+	else
+	{
+		result = pthread_cond_timedwait(cond, mutex, deadline);
+	}
+
+	// the callers check their condition again: spurious wakeups are harmless
+	return (result == ETIMEDOUT) ? OSAL_ERROR : OSAL_OK;
+}
+
+static OSAL_status_t OSAL_posix_semaphore_create(uint32_t initial_count, uint32_t max_count, void** handle)
+{
+	if((handle == NULL) || (max_count == 0u) || (initial_count > max_count))
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_posix_semaphore_t* semaphore = malloc(sizeof(OSAL_posix_semaphore_t));
+	if(semaphore == NULL)
+	{
+		return OSAL_NOMEM;
+	}
+
+	if(OSAL_posix_cond_create(&semaphore->mutex, &semaphore->cond) != OSAL_OK)
+	{
+		free(semaphore);
+		return OSAL_ERROR;
+	}
+	semaphore->count = initial_count;
+	semaphore->max_count = max_count;
+
+	*handle = semaphore;
+	return OSAL_OK;
+}
+
+static OSAL_status_t OSAL_posix_semaphore_delete(void** handle)
+{
+	if((handle == NULL) || (*handle == NULL))
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_posix_semaphore_t* semaphore = (OSAL_posix_semaphore_t*)*handle;
+	OSAL_posix_cond_delete(&semaphore->mutex, &semaphore->cond);
+	free(semaphore);
+	return OSAL_OK;
+}
+
+static OSAL_status_t OSAL_posix_semaphore_take(void** handle, uint32_t timeout)
+{
+	if((handle == NULL) || (*handle == NULL))
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_posix_semaphore_t* semaphore = (OSAL_posix_semaphore_t*)*handle;
+	OSAL_status_t status = OSAL_OK;
+	struct timespec deadline;
+	OSAL_posix_deadline(CLOCK_MONOTONIC, timeout, &deadline);
+
+	(void)pthread_mutex_lock(&semaphore->mutex);
+	while((semaphore->count == 0u) && (status == OSAL_OK))
+	{
+		status = OSAL_posix_wait(&semaphore->cond, &semaphore->mutex, timeout, &deadline);
+	}
+	if(semaphore->count != 0u)
+	{
+		semaphore->count--;
+		status = OSAL_OK;
+	}
+	(void)pthread_mutex_unlock(&semaphore->mutex);
+	return status;
+}
+
+static OSAL_status_t OSAL_posix_semaphore_give(void** handle)
+{
+	if((handle == NULL) || (*handle == NULL))
+	{
+		return OSAL_WRONG_ARGS;
+	}
+
+	OSAL_posix_semaphore_t* semaphore = (OSAL_posix_semaphore_t*)*handle;
+	OSAL_status_t status = OSAL_ERROR;
+
+	(void)pthread_mutex_lock(&semaphore->mutex);
+	if(semaphore->count < semaphore->max_count)
+	{
+		semaphore->count++;
+		(void)pthread_cond_signal(&semaphore->cond);
+		status = OSAL_OK;
+	}
+	(void)pthread_mutex_unlock(&semaphore->mutex);
+	return status;
+}
+
+static void OSAL_posix_scheduler_initialize(void)
+{
+	pthread_mutexattr_t attr;
+	(void)pthread_mutexattr_init(&attr);
+	(void)pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	(void)pthread_mutex_init(&OSAL_posix_scheduler_lock, &attr);
+	(void)pthread_mutexattr_destroy(&attr);
+}
+
+static void* OSAL_posix_task_start(void* args)
+{
+	const OSAL_posix_task_t* task = (const OSAL_posix_task_t*)args;
+	OSAL_task_entry_point_t entry_point = task->entry_point;
+	void* parameters = task->parameters;
+
+#if defined(__linux__)
+	// named for the debuggers and profilers
+	if(task->name[0] != '\0')
+	{
+		(void)pthread_setname_np(pthread_self(), task->name);
+	}
+#endif
+
+	// the task may delete itself: its handle is not used anymore
+	return entry_point(parameters);
+}
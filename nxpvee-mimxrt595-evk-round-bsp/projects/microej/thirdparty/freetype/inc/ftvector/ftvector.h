@@ -28,8 +28,21 @@
 #define FT_PARAM_TAG_VGLITE_COLOR           FT_MAKE_TAG( 'c', 'o', 'l', 'o' )
 #define FT_PARAM_TAG_VGLITE_GRADIENT        FT_MAKE_TAG( 'g', 'r', 'a', 'd' )
 
+// Starts a glyph run (data: the matrix of the run) or draws the pending run and
+// ends it (data: NULL). During a run, FT_PARAM_TAG_VGLITE_MATRIX gives the position
+// of the next glyph relative to the run matrix and the glyphs are gathered in a
+// single path, drawn when the run ends, when the color, the gradient, the blend or
+// the destination changes, or when the next glyph does not fit in the run.
+#define FT_PARAM_TAG_VGLITE_RUN             FT_MAKE_TAG( 'r', 'u', 'n', ' ' )
+
 #define FT_VGLITE_PATH_POOL_CHUNK       0x100
 
+// Largest glyph run path in bytes (the path is copied in the command buffer for
+// each tessellation pass of the run: keep it far below the command buffer size)
+#ifndef FT_VGLITE_RUN_MAX_SIZE
+#define FT_VGLITE_RUN_MAX_SIZE          0x2000
+#endif
+
 // Internal debug define to print to console the glyphs outlines path strings
 // path strings can then be observed with https://yqnn.github.io/svg-path-editor
 //#define FT_VGLITE_LOG_OUTLINES
@@ -99,6 +99,11 @@ typedef struct  vglite_TWorker_ {
 	vg_lite_color_t vg_lite_color;
 	vg_lite_linear_gradient_t* vg_lite_gradient;
 
+	// glyph run: NULL matrix when the glyphs are drawn one by one
+	vg_lite_matrix_t* vglite_run_matrix;
+	vg_lite_path_t vglite_run_path;
+	uint32_t vglite_run_pool_size;
+
 	FT_Glyph_Metrics    *metrics;
 } vglite_TWorker, *vglite_PWorker;
 
@@ -110,25 +115,25 @@ typedef struct vglite_TRaster_ {
 
 static vglite_TRaster _raster;
 
-static FT_Error vglite_extend_path(int extra_length){
+static FT_Error vglite_extend_path(vg_lite_path_t* path, uint32_t* pool_size, int extra_length){
 	FT_Error error = FT_ERR( Ok );
 	// cppcheck-suppress [unreadVariable] "memory" is used by "FT_REALLOC"
 	FT_Memory memory = _raster.memory;
 	uint32_t new_path_length;
 
-	new_path_length = _worker.vglite_path.path_length + extra_length;
+	new_path_length = path->path_length + extra_length;
 
-	while ( new_path_length > _worker.vglite_path_pool_size ) {
-		if ( FT_ERR( Ok )  != FT_REALLOC( _worker.vglite_path.path, _worker.vglite_path_pool_size, _worker.vglite_path_pool_size + (uint32_t)FT_VGLITE_PATH_POOL_CHUNK ) ) {
+	while ( new_path_length > *pool_size ) {
+		if ( FT_ERR( Ok )  != FT_REALLOC( path->path, *pool_size, *pool_size + (uint32_t)FT_VGLITE_PATH_POOL_CHUNK ) ) {
 			error = FT_ERR( Out_Of_Memory );
 			break;
 		}
 
-		_worker.vglite_path_pool_size += (uint32_t)FT_VGLITE_PATH_POOL_CHUNK;
+		*pool_size += (uint32_t)FT_VGLITE_PATH_POOL_CHUNK;
 	};
 
 	if ( FT_ERR( Ok ) == error ) {
-		_worker.vglite_path.path_length = new_path_length;
+		path->path_length = new_path_length;
 	}
 
 	return error;
@@ -142,7 +147,7 @@ static FT_Error vglite_get_path_slot(void **slot, int extra_length) {
 
 	_prev_path_length = _worker.vglite_path.path_length;
 
-	error = vglite_extend_path(extra_length);
+	error = vglite_extend_path(&_worker.vglite_path, &_worker.vglite_path_pool_size, extra_length);
 	if ( FT_ERR( Ok ) == error ) {
 		*slot = &(((uint8_t *) _worker.vglite_path.path) [_prev_path_length]);;
 	}
@@ -320,6 +325,131 @@ FT_DEFINE_OUTLINE_FUNCS(func_interface,
 		0
 )
 
+static void vglite_draw( vg_lite_path_t* path, vg_lite_fill_t fill_rule, vg_lite_matrix_t* matrix )
+{
+	void* target = _worker.vglite_dest;
+
+	if(_worker.vg_lite_gradient == MICROVG_HELPER_NULL_GRADIENT){
+		FT_VGLITE_TRACE_INIT_GPU_START(DRAW);
+		VG_DRAWER_draw_path(target, path, fill_rule, matrix, _worker.vg_lite_blend, _worker.vg_lite_color);
+		FT_VGLITE_TRACE_INIT_GPU_END();
+	}
+	else {
+		FT_VGLITE_TRACE_INIT_GPU_START(DRAW_GRAD);
+		VG_DRAWER_draw_gradient(target, path, fill_rule, matrix, _worker.vg_lite_gradient, _worker.vg_lite_blend);
+		FT_VGLITE_TRACE_INIT_GPU_END();
+	}
+}
+
+static void vglite_transform_point( const vg_lite_matrix_t* matrix, float x, float y, float* dest )
+{
+	dest[0] = (matrix->m[0][0] * x) + (matrix->m[0][1] * y) + matrix->m[0][2];
+	dest[1] = (matrix->m[1][0] * x) + (matrix->m[1][1] * y) + matrix->m[1][2];
+}
+
+/* draws the glyphs gathered in the run */
+static void vglite_flush_run( void )
+{
+	if ( 0 != _worker.vglite_run_path.path_length ) {
+		// the run path has been sized to hold its end command
+		uint32_t* path_end = (uint32_t*)&(((uint8_t *) _worker.vglite_run_path.path) [_worker.vglite_run_path.path_length]);
+		*path_end = VGLITE_CMD_END;
+		_worker.vglite_run_path.path_length += sizeof(uint32_t);
+		_worker.vglite_run_path.path_changed = 1;
+
+		FT_TRACE7(( "Send run to gpu\n" ));
+		vglite_draw( &_worker.vglite_run_path, VG_LITE_FILL_NON_ZERO, _worker.vglite_run_matrix );
+
+		_worker.vglite_run_path.path_length = 0;
+	}
+}
+
+/*
+ * appends the glyph path to the run: its S16 coordinates are transformed by the
+ * glyph matrix into FP32 coordinates (same layout: each command and coordinate
+ * takes 4 bytes instead of 2) and its end command is removed
+ */
+static FT_Error vglite_append_glyph( void )
+{
+	FT_Error error;
+	uint32_t glyph_length = (_worker.vglite_path.path_length - sizeof(path_end_16_t)) * 2u;
+	uint32_t run_length = _worker.vglite_run_path.path_length;
+
+	if ( (run_length + glyph_length + sizeof(uint32_t)) > (uint32_t)FT_VGLITE_RUN_MAX_SIZE ) {
+		vglite_flush_run();
+		run_length = 0;
+	}
+
+	// extend with the end command of the run
+	error = vglite_extend_path(&_worker.vglite_run_path, &_worker.vglite_run_pool_size, glyph_length + sizeof(uint32_t));
+	if ( FT_ERR( Ok ) == error ) {
+		const int16_t* src = (const int16_t*)_worker.vglite_path.path;
+		const int16_t* src_end = &src[glyph_length / sizeof(uint32_t)];
+		uint32_t* dest = (uint32_t*)&(((uint8_t *) _worker.vglite_run_path.path) [run_length]);
+		const vg_lite_matrix_t* matrix = _worker.vglite_matrix;
+		float* bbox = _worker.vglite_run_path.bounding_box;
+		float corner[2];
+
+		while ( src < src_end ) {
+			int16_t cmd = *src;
+			int points = (VGLITE_CMD_CUBIC_TO == cmd) ? 3 : ((VGLITE_CMD_QUAD_TO == cmd) ? 2 : 1);
+
+			*dest = (uint32_t)cmd;
+			dest++;
+			src++;
+			for ( int i = 0; i < points; i++ ) {
+				// cppcheck-suppress [misra-c2012-11.3] the FP32 coordinates are 32-bit aligned
+				vglite_transform_point( matrix, (float)src[0], (float)src[1], (float*)dest );
+				dest += 2;
+				src += 2;
+			}
+		}
+
+		// the run bounding box holds the transformed glyph bounding box
+		for ( int i = 0; i < 4; i++ ) {
+			const float* glyph_bbox = _worker.vglite_path.bounding_box;
+			vglite_transform_point( matrix, glyph_bbox[(i & 1) * 2], glyph_bbox[1 + ((i >> 1) * 2)], corner );
+			if ( (0u == run_length) && (0 == i) ) {
+				bbox[0] = bbox[2] = corner[0];
+				bbox[1] = bbox[3] = corner[1];
+			}
+			else {
+				bbox[0] = (corner[0] < bbox[0]) ? corner[0] : bbox[0];
+				bbox[1] = (corner[1] < bbox[1]) ? corner[1] : bbox[1];
+				bbox[2] = (corner[0] > bbox[2]) ? corner[0] : bbox[2];
+				bbox[3] = (corner[1] > bbox[3]) ? corner[1] : bbox[3];
+			}
+		}
+
+		_worker.vglite_run_path.quality = _worker.vglite_path.quality;
+		// keep room for the end command
+		_worker.vglite_run_path.path_length -= sizeof(uint32_t);
+	}
+	else {
+		_worker.vglite_run_path.path_length = run_length;
+	}
+
+	return error;
+}
+
+/* draws the glyph alone during a run: the glyph matrix is relative to the run matrix */
+static void vglite_draw_run_glyph( vg_lite_fill_t fill_rule )
+{
+	const vg_lite_matrix_t* run = _worker.vglite_run_matrix;
+	const vg_lite_matrix_t* glyph = _worker.vglite_matrix;
+	vg_lite_matrix_t matrix;
+
+	vglite_flush_run();
+
+	for ( int row = 0; row < 3; row++ ) {
+		for ( int column = 0; column < 3; column++ ) {
+			matrix.m[row][column] = (run->m[row][0] * glyph->m[0][column]) + (run->m[row][1] * glyph->m[1][column]) + (run->m[row][2] * glyph->m[2][column]);
+		}
+	}
+
+	vglite_draw( &_worker.vglite_path, fill_rule, &matrix );
+}
+
 static int
 vglite_convert_glyph( void )
 {
@@ -355,17 +485,17 @@ vglite_convert_glyph( void )
 			vg_lite_fill_t vg_lite_fill_rule = (_worker.outline.flags & FT_OUTLINE_EVEN_ODD_FILL) ? VG_LITE_FILL_EVEN_ODD : VG_LITE_FILL_NON_ZERO;
 
 			//    vg_lite_translate(offX, offY, _worker.vglite_matrix);
-			if(_worker.vg_lite_gradient == MICROVG_HELPER_NULL_GRADIENT){
-				FT_VGLITE_TRACE_INIT_GPU_START(DRAW);
-				void* target = _worker.vglite_dest;
-				VG_DRAWER_draw_path(target, &_worker.vglite_path, vg_lite_fill_rule, _worker.vglite_matrix, _worker.vg_lite_blend, _worker.vg_lite_color);
-				FT_VGLITE_TRACE_INIT_GPU_END();
+			if ( NULL == _worker.vglite_run_matrix ) {
+				vglite_draw( &_worker.vglite_path, vg_lite_fill_rule, _worker.vglite_matrix );
+			}
+			else if ( (VG_LITE_FILL_NON_ZERO != vg_lite_fill_rule)
+					|| ((((_worker.vglite_path.path_length - sizeof(path_end_16_t)) * 2u) + sizeof(uint32_t)) > (uint32_t)FT_VGLITE_RUN_MAX_SIZE)
+					|| (FT_ERR( Ok ) != vglite_append_glyph()) ) {
+				// the even-odd glyphs would cancel their neighbors where they overlap
+				vglite_draw_run_glyph( vg_lite_fill_rule );
 			}
 			else {
-				FT_VGLITE_TRACE_INIT_GPU_START(DRAW_GRAD);
-				void* target = _worker.vglite_dest;
-				VG_DRAWER_draw_gradient(target, &_worker.vglite_path, vg_lite_fill_rule, _worker.vglite_matrix, _worker.vg_lite_gradient, _worker.vg_lite_blend);
-				FT_VGLITE_TRACE_INIT_GPU_END();
+				// drawn with the next glyphs
 			}
 			//    vg_lite_translate(0, offY, _worker.vglite_matrix);
 		}
@@ -418,6 +548,11 @@ vglite_reset(   FT_Raster  raster,
 
 	(void)memset(&_worker.vglite_path, 0, sizeof(_worker.vglite_path));
 
+	_worker.vglite_run_matrix = NULL;
+	_worker.vglite_run_pool_size = 0;
+	(void)memset(&_worker.vglite_run_path, 0, sizeof(_worker.vglite_run_path));
+	_worker.vglite_run_path.format = VG_LITE_FP32;
+
 	_worker.vglite_path.bounding_box[0] = -4000; // Left
 	_worker.vglite_path.bounding_box[1] = -4000; // Top
 	_worker.vglite_path.bounding_box[2] = 4000; // Right
@@ -451,6 +586,11 @@ static void vglite_done( FT_Raster  raster )
 		FT_FREE( _worker.vglite_path.path );
 		_worker.vglite_path_pool_size = 0;
 	}
+
+	if ( NULL != _worker.vglite_run_path.path ) {
+		FT_FREE( _worker.vglite_run_path.path );
+		_worker.vglite_run_pool_size = 0;
+	}
 }
 
 FT_DEFINE_RASTER_FUNCS(ft_vglite_raster,
@@ -485,6 +625,9 @@ static FT_Error ft_vglite_set_mode(FT_Renderer render, FT_ULong  mode_tag, FT_Po
 
 	switch (mode_tag){
 	case FT_PARAM_TAG_VGLITE_DESTINATION:{
+		if ( data != _worker.vglite_dest ) {
+			vglite_flush_run();
+		}
 		_worker.vglite_dest = data;
 		ret = FT_ERR(Ok);
 		break;
@@ -505,18 +648,25 @@ static FT_Error ft_vglite_set_mode(FT_Renderer render, FT_ULong  mode_tag, FT_Po
 		break;
 	}
 	case FT_PARAM_TAG_VGLITE_BLEND:{
+		vglite_flush_run();
 		_worker.vg_lite_blend = (vg_lite_blend_t) (uint32_t) data;
 		ret = FT_ERR(Ok);
 		break;
 	}
 	case FT_PARAM_TAG_VGLITE_COLOR:{
 		// convert the color only once, see FT_PARAM_TAG_VGLITE_DESTINATION
-		_worker.vg_lite_color = (uint32_t) data;
-		VG_DRAWER_update_color(_worker.vglite_dest, &_worker.vg_lite_color, _worker.vg_lite_blend);
+		vg_lite_color_t color = (uint32_t) data;
+		VG_DRAWER_update_color(_worker.vglite_dest, &color, _worker.vg_lite_blend);
+		if ( color != _worker.vg_lite_color ) {
+			// the consecutive layers of the same color stay in the run
+			vglite_flush_run();
+			_worker.vg_lite_color = color;
+		}
 		ret = FT_ERR(Ok);
 		break;
 	}
 	case FT_PARAM_TAG_VGLITE_GRADIENT:{
+		vglite_flush_run();
 		_worker.vg_lite_gradient = data;
 		if (MICROVG_HELPER_NULL_GRADIENT != data) {
 			VG_DRAWER_update_gradient(_worker.vglite_dest, _worker.vg_lite_gradient, _worker.vg_lite_blend);
@@ -524,6 +674,12 @@ static FT_Error ft_vglite_set_mode(FT_Renderer render, FT_ULong  mode_tag, FT_Po
 		ret = FT_ERR(Ok);
 		break;
 	}
+	case FT_PARAM_TAG_VGLITE_RUN:{
+		vglite_flush_run();
+		_worker.vglite_run_matrix = data;
+		ret = FT_ERR(Ok);
+		break;
+	}
 	default:{
 		/* we simply pass it to the raster */
 		ret = render->clazz->raster_class->raster_set_mode(render->raster, mode_tag, data);
@@ -0,0 +1,162 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined ALLOC_PROFILER_H
+#define ALLOC_PROFILER_H
+
+/*
+ * @file
+ * @brief Sampling allocation profiler aggregated by type and call site.
+ *
+ * The MicroEJ monitor hook LLMJVM_MONITOR_IMPL_on_allocate() (see
+ * LLMJVM_MONITOR_sysview.c) reports each Java allocation. The profiler samples
+ * the allocated bytes as a Poisson process: a countdown of bytes, drawn from an
+ * exponential distribution of mean ALLOC_PROFILER_SAMPLING_INTERVAL, is decreased
+ * by each allocation and the allocation that reaches 0 is sampled. An allocation
+ * of s bytes is sampled with the probability p = 1 - exp(-s / interval): each
+ * sample accounts for 1 / p allocations and s / p bytes, so the estimates are
+ * unbiased whatever the sizes of the allocations.
+ *
+ * The samples are aggregated by (type, method) in a fixed-size table. The
+ * profiler keeps the list of the ALLOC_PROFILER_TOP sites that allocate the most
+ * bytes and the allocation rate in bytes per second. The types and methods are
+ * the addresses of the Java types and methods: they are resolved with the map
+ * file of the application (SOAR.map).
+ *
+ * The statistics are printed by ALLOC_PROFILER_dump() (periodically by the
+ * monitor task when MONITOR_ENABLED is set, or from the debugger: "call
+ * ALLOC_PROFILER_dump()").
+ *
+ * The profiler is updated by the MicroJvm task only. The statistics may be read
+ * from another task (some values may be torn).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "alloc_profiler_configuration.h"
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief An allocation site: the estimates of the allocations of a type by a method.
+ */
+typedef struct {
+	void* type;                 // address of the Java type
+	void* method;               // address of the Java method
+	uint32_t samples;           // number of sampled allocations
+	uint32_t count;             // estimated number of allocations
+	uint64_t bytes;             // estimated number of bytes
+} ALLOC_PROFILER_site_t;
+
+/*
+ * @brief Profiler statistics.
+ */
+typedef struct {
+	bool running;               // true when the profiler is started
+	uint32_t interval;          // mean number of bytes between two samples
+	uint64_t allocated;         // bytes allocated while the profiler runs
+	uint32_t samples;           // number of samples
+	uint32_t dropped;           // samples not aggregated (table full)
+	uint32_t sites;             // number of sites in the table
+	uint32_t rate;              // allocation rate in bytes per second
+} ALLOC_PROFILER_stats_t;
+
+// -----------------------------------------------------------------------------
+// Global variables
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief The state read by ALLOC_PROFILER_on_allocate().
+ */
+extern struct ALLOC_PROFILER_state {
+	int32_t countdown;          // bytes to allocate before the next sample
+	bool running;               // true when the profiler is started
+} ALLOC_PROFILER_state;
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Initializes the profiler and starts it when ALLOC_PROFILER_AUTO_START is set.
+ */
+void ALLOC_PROFILER_initialize(void);
+
+/*
+ * @brief Starts the profiler.
+ *
+ * @param[in] interval: the mean number of bytes between two samples, 0 for
+ * ALLOC_PROFILER_SAMPLING_INTERVAL.
+ */
+void ALLOC_PROFILER_start(uint32_t interval);
+
+/*
+ * @brief Stops the profiler (the statistics are kept).
+ */
+void ALLOC_PROFILER_stop(void);
+
+/*
+ * @brief Clears the statistics.
+ */
+void ALLOC_PROFILER_reset(void);
+
+/*
+ * @brief Samples an allocation. Called by ALLOC_PROFILER_on_allocate() when the
+ * countdown reaches 0.
+ *
+ * @return true when the allocation is sampled (false when the profiler is stopped).
+ */
+bool ALLOC_PROFILER_sample(void* type, int32_t size, void* method);
+
+/*
+ * @brief Called on each Java allocation.
+ *
+ * @param[in] type: the allocated type.
+ * @param[in] size: the allocated size in bytes.
+ * @param[in] method: the allocating method.
+ *
+ * @return true when the allocation is sampled.
+ */
+static inline bool ALLOC_PROFILER_on_allocate(void* type, int32_t size, void* method) {
+	ALLOC_PROFILER_state.countdown -= size;
+	return (ALLOC_PROFILER_state.countdown <= 0) && ALLOC_PROFILER_sample(type, size, method);
+}
+
+/*
+ * @brief Gets the sites that allocate the most bytes, the most first.
+ *
+ * @param[out] sites: the sites.
+ * @param[in] max: the maximum number of sites to get.
+ *
+ * @return the number of sites (ALLOC_PROFILER_TOP at most).
+ */
+uint32_t ALLOC_PROFILER_get_top(ALLOC_PROFILER_site_t* sites, uint32_t max);
+
+/*
+ * @brief Gets the profiler statistics.
+ *
+ * @param[out] stats: the statistics.
+ */
+void ALLOC_PROFILER_get_stats(ALLOC_PROFILER_stats_t* stats);
+
+/*
+ * @brief Prints the statistics and the top sites on the debug console.
+ */
+void ALLOC_PROFILER_dump(void);
+
+#endif // !defined ALLOC_PROFILER_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,80 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined ALLOC_PROFILER_CONFIGURATION_H
+#define ALLOC_PROFILER_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Set to 1 to build the sampling allocation profiler (see alloc_profiler.h).
+ * When built and not started, it costs a subtraction and a test per allocation.
+ */
+#ifndef ALLOC_PROFILER_ENABLED
+#define ALLOC_PROFILER_ENABLED 1
+#endif
+
+/*
+ * @brief Set to 1 to start the profiler at the JVM start, otherwise it is started
+ * by the application (com.nxp.allocprofiler.AllocProfilerNatives) or from the
+ * debugger ("call ALLOC_PROFILER_start(0)").
+ */
+#ifndef ALLOC_PROFILER_AUTO_START
+#define ALLOC_PROFILER_AUTO_START 0
+#endif
+
+/*
+ * @brief Default mean number of bytes allocated between two samples.
+ */
+#ifndef ALLOC_PROFILER_SAMPLING_INTERVAL
+#define ALLOC_PROFILER_SAMPLING_INTERVAL (8 * 1024)
+#endif
+
+/*
+ * @brief Number of entries of the (type, method) table (power of 2). The samples
+ * of the sites that do not fit are counted as dropped.
+ */
+#ifndef ALLOC_PROFILER_TABLE_SIZE
+#define ALLOC_PROFILER_TABLE_SIZE (64)
+#endif
+
+/*
+ * @brief Number of sites of the top list (the sites that allocate the most bytes).
+ */
+#ifndef ALLOC_PROFILER_TOP
+#define ALLOC_PROFILER_TOP (8)
+#endif
+
+/*
+ * @brief Period of the allocation rate measurement in milliseconds.
+ */
+#ifndef ALLOC_PROFILER_RATE_PERIOD
+#define ALLOC_PROFILER_RATE_PERIOD (1000)
+#endif
+
+/*
+ * @brief Seed of the random generator of the sampling intervals (not 0).
+ */
+#ifndef ALLOC_PROFILER_SEED
+#define ALLOC_PROFILER_SEED (0x2545F491u)
+#endif
+
+/*
+ * @brief Time of the allocation rate measurement in milliseconds.
+ */
+#ifndef ALLOC_PROFILER_GET_TIME_MS
+#include "LLMJVM_impl.h"
+#define ALLOC_PROFILER_GET_TIME_MS() LLMJVM_IMPL_getCurrentTime(MICROEJ_TRUE)
+#endif
+
+#endif // !defined ALLOC_PROFILER_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
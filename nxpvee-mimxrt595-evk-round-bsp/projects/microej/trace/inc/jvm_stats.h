@@ -0,0 +1,163 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined JVM_STATS_H
+#define JVM_STATS_H
+
+/*
+ * @file
+ * @brief Java thread CPU accounting and GC pause statistics.
+ *
+ * The MicroEJ monitor hooks (LLMJVM_MONITOR_sysview.c) report the state changes
+ * of the Java threads and the GC start and stop, timed with a cycle counter:
+ * - the running time of each Java thread (GC pauses excluded),
+ * - the latency between the ready and running states of each Java thread,
+ * - a histogram of the GC pauses (log2 buckets of microseconds) and the worst
+ *   pauses with their time.
+ *
+ * The statistics are available without debugger: polled by the application
+ * (com.nxp.jvmstats.JvmStatsNatives, see jvm_stats_natives.c) and printed by
+ * JVM_STATS_dump() (periodically by the monitor task when MONITOR_ENABLED is set,
+ * or from the debugger: "call JVM_STATS_dump()").
+ *
+ * The hooks are called by the MicroJvm task: the statistics are updated by this
+ * task only. They may be read from another task (some values may be torn).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "jvm_stats_configuration.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief States reported by the monitor hooks (values of MJVM_MONITOR_state_t).
+ */
+#define JVM_STATS_STATE_READY (1)
+#define JVM_STATS_STATE_RUNNING (2)
+#define JVM_STATS_STATE_WAITING (3)
+#define JVM_STATS_STATE_MONITOR_QUEUED (4)
+#define JVM_STATS_STATE_TERMINATED (6)
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Statistics of a Java thread. The times are in microseconds.
+ */
+typedef struct {
+	int32_t id;                 // Java thread identifier
+	bool terminated;            // true when the thread has terminated
+	uint64_t running_time;      // cumulated running time
+	uint32_t scheduled;         // number of times the thread has been scheduled
+	uint64_t latency_total;     // cumulated ready to running latencies
+	uint32_t latency_count;     // number of ready to running latencies
+	uint32_t latency_max;       // worst ready to running latency
+} JVM_STATS_thread_t;
+
+/*
+ * @brief A GC pause.
+ */
+typedef struct {
+	uint32_t duration;          // duration in microseconds
+	int64_t time;               // start time in milliseconds (Java platform time)
+} JVM_STATS_pause_t;
+
+/*
+ * @brief GC statistics. The times are in microseconds.
+ */
+typedef struct {
+	uint32_t count;                                 // number of GC
+	uint64_t total_time;                            // cumulated GC pauses
+	uint32_t histogram[JVM_STATS_GC_BUCKETS];       // pauses by duration (see JVM_STATS_GC_BUCKETS)
+	JVM_STATS_pause_t worst[JVM_STATS_GC_WORST];    // worst pauses, the longest first
+} JVM_STATS_gc_t;
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Initializes the statistics and starts the cycle counter.
+ */
+void JVM_STATS_initialize(void);
+
+/*
+ * @brief Clears the statistics (the threads are kept).
+ */
+void JVM_STATS_reset(void);
+
+/*
+ * @brief Called when a Java thread is created.
+ *
+ * @param[in] thread_id: the Java thread identifier.
+ */
+void JVM_STATS_on_thread_create(int32_t thread_id);
+
+/*
+ * @brief Called when the state of a Java thread changes.
+ *
+ * @param[in] thread_id: the Java thread identifier.
+ * @param[in] state: the new state (JVM_STATS_STATE_*).
+ */
+void JVM_STATS_on_thread_state_changed(int32_t thread_id, int32_t state);
+
+/*
+ * @brief Called when the GC starts.
+ */
+void JVM_STATS_on_gc_start(void);
+
+/*
+ * @brief Called when the GC stops.
+ */
+void JVM_STATS_on_gc_stop(void);
+
+/*
+ * @brief Gets the statistics of the Java threads.
+ *
+ * @param[out] threads: the statistics of the threads.
+ * @param[in] max: the maximum number of threads to get.
+ *
+ * @return the number of threads.
+ */
+uint32_t JVM_STATS_get_threads(JVM_STATS_thread_t* threads, uint32_t max);
+
+/*
+ * @brief Gets the statistics of a Java thread.
+ *
+ * @param[in] thread_id: the Java thread identifier.
+ * @param[out] thread: the statistics of the thread.
+ *
+ * @return false when the thread is unknown.
+ */
+bool JVM_STATS_get_thread(int32_t thread_id, JVM_STATS_thread_t* thread);
+
+/*
+ * @brief Gets the GC statistics.
+ *
+ * @param[out] gc: the GC statistics.
+ */
+void JVM_STATS_get_gc(JVM_STATS_gc_t* gc);
+
+/*
+ * @brief Prints the statistics on the debug console.
+ */
+void JVM_STATS_dump(void);
+
+#endif // !defined JVM_STATS_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,78 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined JVM_STATS_CONFIGURATION_H
+#define JVM_STATS_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Set to 1 to account the CPU time of the Java threads and the GC pauses
+ * (see jvm_stats.h). Off by default: each Java thread state change and GC then
+ * reads the cycle counter and updates the statistics in the MicroJvm task.
+ */
+#ifndef JVM_STATS_ENABLED
+#define JVM_STATS_ENABLED 0
+#endif
+
+/*
+ * @brief Maximum number of Java threads accounted. When a thread is created and
+ * all the entries are used, the entry of a terminated thread is reused.
+ */
+#ifndef JVM_STATS_MAX_THREADS
+#define JVM_STATS_MAX_THREADS (16)
+#endif
+
+/*
+ * @brief Number of buckets of the GC pause histogram. The bucket i counts the
+ * pauses from 2^i to 2^(i+1) microseconds (the bucket 0 also counts the shorter
+ * pauses and the last bucket the longer pauses).
+ */
+#ifndef JVM_STATS_GC_BUCKETS
+#define JVM_STATS_GC_BUCKETS (20)
+#endif
+
+/*
+ * @brief Number of worst GC pauses kept.
+ */
+#ifndef JVM_STATS_GC_WORST
+#define JVM_STATS_GC_WORST (4)
+#endif
+
+/*
+ * @brief Cycle counter (32-bit, extended to 64-bit on each event: at least one
+ * Java thread switch, GC or query must occur during each counter period, i.e.
+ * 21 seconds at 200 MHz) and its frequency. The DWT cycle counter is started
+ * by JVM_STATS_initialize().
+ */
+#ifndef JVM_STATS_GET_CYCLES
+#include "fsl_device_registers.h"
+#define JVM_STATS_GET_CYCLES() (DWT->CYCCNT)
+#define JVM_STATS_GET_FREQUENCY() (SystemCoreClock)
+#define JVM_STATS_START_CYCLES() \
+	do { \
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; \
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk; \
+	} while (0)
+#endif
+
+/*
+ * @brief Time of the worst GC pauses in milliseconds, on the time base of the
+ * Java platform time (the cycle counter stops in sleep modes).
+ */
+#ifndef JVM_STATS_GET_TIME_MS
+#include "LLMJVM_impl.h"
+#define JVM_STATS_GET_TIME_MS() LLMJVM_IMPL_getCurrentTime(MICROEJ_TRUE)
+#endif
+
+#endif // !defined JVM_STATS_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
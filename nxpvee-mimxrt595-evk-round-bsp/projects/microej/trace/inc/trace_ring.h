@@ -0,0 +1,210 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined TRACE_RING_H
+#define TRACE_RING_H
+
+/*
+ * @file
+ * @brief Binary trace ring: lock-free recording of the trace events in RAM.
+ *
+ * Each event takes one 16-byte record, followed by one record for each three
+ * additional values (an event has ten values at most). A record holds the time
+ * elapsed since the previous record in cycles of the DWT cycle counter, except
+ * every TRACE_RING_SYNC_INTERVAL records and after a long idle period, where it
+ * holds the absolute value of the cycle counter.
+ *
+ * The records are reserved with a compare and swap of a single word that holds
+ * the index of the next record and the time of the last reservation: an interrupt
+ * that records an event in the middle of another recording takes the next records
+ * and the elapsed times stay consistent. There is no lock and no interrupt masking.
+ * The ring is written by the core that runs the BSP only (Cortex-M33): each core
+ * that records events needs its own ring.
+ *
+ * The oldest records are overwritten when the ring is full. The ring is read:
+ * - over RTT, by TRACE_RING_drain() (called in the FreeRTOS idle hook when
+ *   TRACE_RING_DRAIN_ON_IDLE is set). TRACE_RING_dump() sends the whole ring
+ *   again. Save the channel TRACE_RING_RTT_CHANNEL with the J-Link RTT Logger.
+ * - by the debugger, at any time (even after a fault), by saving the memory
+ *   image TRACE_RING_image: "dump binary value trace.bin TRACE_RING_image".
+ *
+ * projects/common/scripts/trace_ring.py converts both formats to the Chrome
+ * trace event format (JSON), opened by Perfetto and chrome://tracing.
+ *
+ * RTT stream format (little endian): a TRACE_RING_header_t followed by the group
+ * names, then chunks: a TRACE_RING_chunk_t followed by its records.
+ * Memory image: a TRACE_RING_header_t, the group names, then the ring of records
+ * (the record at position p is at index p % size).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include "trace_ring_configuration.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Magic numbers: "TRGI", "TRGH" and "TRGC".
+ */
+#define TRACE_RING_MAGIC_IMAGE (0x49475254u)
+#define TRACE_RING_MAGIC_HEADER (0x48475254u)
+#define TRACE_RING_MAGIC_CHUNK (0x43475254u)
+
+#define TRACE_RING_VERSION (1u)
+
+/*
+ * @brief Kinds of record (bits 0 to 2 of the type of a record).
+ */
+#define TRACE_RING_KIND_START (0u)  // event (LLTRACE_IMPL_record_event_*())
+#define TRACE_RING_KIND_END (1u)    // end of event (LLTRACE_IMPL_record_event_end*())
+#define TRACE_RING_KIND_VALUES (2u) // additional values of the previous event
+
+/*
+ * @brief Set in the type of a record whose time is the absolute value of the cycle counter.
+ */
+#define TRACE_RING_FLAG_ABSOLUTE (1u << 3)
+
+/*
+ * @brief Number of values of an event (bits 4 to 7 of the type of a record).
+ */
+#define TRACE_RING_COUNT_SHIFT (4u)
+#define TRACE_RING_MAX_VALUES (10u)
+
+/*
+ * @brief Group of the events of the MicroEJ monitor (identifiers of SYSVIEW_MicroEJ.txt).
+ */
+#define TRACE_RING_GROUP_MONITOR (0xFFu)
+
+/*
+ * @brief Maximum length of a group name, including the terminating null character.
+ */
+#define TRACE_RING_GROUP_NAME_LENGTH (16)
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief A 16-byte record.
+ */
+typedef union {
+	struct {
+		uint8_t type;       // kind, flags and number of values
+		uint8_t group;      // event group
+		uint16_t event;     // event identifier in the group
+		uint32_t time;      // cycles since the previous record, or absolute cycle counter
+		uint32_t context;   // current task or exception number
+		uint32_t value;     // first value
+	} event;
+	struct {
+		uint8_t type;       // TRACE_RING_KIND_VALUES
+		uint8_t reserved[3];
+		uint32_t values[3]; // next values of the event
+	} values;
+} TRACE_RING_record_t;
+
+/*
+ * @brief Header of the memory image and of the RTT stream.
+ */
+typedef struct {
+	uint32_t magic;     // TRACE_RING_MAGIC_IMAGE or TRACE_RING_MAGIC_HEADER
+	uint32_t version;   // TRACE_RING_VERSION
+	uint32_t frequency; // frequency of the cycle counter in Hz
+	uint32_t size;      // number of records of the ring
+	uint32_t groups;    // number of group names that follow
+	uint32_t committed; // number of records written since the start
+	char names[TRACE_RING_MAX_GROUPS][TRACE_RING_GROUP_NAME_LENGTH];
+} TRACE_RING_header_t;
+
+/*
+ * @brief Header of a chunk of records in the RTT stream.
+ */
+typedef struct {
+	uint32_t magic;     // TRACE_RING_MAGIC_CHUNK
+	uint32_t position;  // position of the first record since the start
+	uint32_t records;   // number of records that follow
+	uint32_t lost;      // records overwritten before being drained since the previous chunk
+} TRACE_RING_chunk_t;
+
+/*
+ * @brief Trace ring statistics.
+ */
+typedef struct {
+	uint32_t records;   // records written
+	uint32_t drained;   // records sent over RTT
+	uint32_t lost;      // records overwritten before being drained
+} TRACE_RING_stats_t;
+
+// -----------------------------------------------------------------------------
+// Global variables
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief The memory image of the ring, read by the debugger.
+ */
+extern struct TRACE_RING_image {
+	TRACE_RING_header_t header;
+	TRACE_RING_record_t records[TRACE_RING_SIZE];
+} TRACE_RING_image;
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Initializes the ring and starts the cycle counter.
+ */
+void TRACE_RING_initialize(void);
+
+/*
+ * @brief Sets the name of a group, used by the decoder.
+ *
+ * @param[in] group: the group (lower than TRACE_RING_MAX_GROUPS).
+ * @param[in] name: the name of the group (truncated to TRACE_RING_GROUP_NAME_LENGTH - 1 characters).
+ */
+void TRACE_RING_set_group_name(uint32_t group, const char* name);
+
+/*
+ * @brief Records an event. May be called from any task and interrupt handler.
+ *
+ * @param[in] kind: TRACE_RING_KIND_START or TRACE_RING_KIND_END.
+ * @param[in] group: the group of the event.
+ * @param[in] event: the identifier of the event in the group.
+ * @param[in] values: the values of the event.
+ * @param[in] count: the number of values (TRACE_RING_MAX_VALUES at most).
+ */
+void TRACE_RING_record(uint32_t kind, uint32_t group, uint32_t event, const uint32_t* values, uint32_t count);
+
+/*
+ * @brief Sends the records written since the previous drain over RTT, as long as
+ * the RTT buffer has room. Must be called by a single task.
+ */
+void TRACE_RING_drain(void);
+
+/*
+ * @brief Sends the whole content of the ring over RTT again, in the next drains.
+ */
+void TRACE_RING_dump(void);
+
+/*
+ * @brief Gets the trace ring statistics.
+ *
+ * @param[out] stats: the statistics.
+ */
+void TRACE_RING_get_stats(TRACE_RING_stats_t* stats);
+
+#endif // !defined TRACE_RING_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
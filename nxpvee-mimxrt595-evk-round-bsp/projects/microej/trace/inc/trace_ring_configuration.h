@@ -0,0 +1,105 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined TRACE_RING_CONFIGURATION_H
+#define TRACE_RING_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Set to 1 to record the events of the Trace library (LLTRACE_IMPL_record_event_*())
+ * and of the MicroEJ monitor (allocations, exceptions) in the trace ring instead
+ * of sending them to SystemView (see trace_ring.h). The RTOS events are still sent
+ * to SystemView.
+ */
+#ifndef TRACE_RING_ENABLED
+#define TRACE_RING_ENABLED 0
+#endif
+
+/*
+ * @brief Number of 16-byte records of the ring: a power of two, 4096 at most.
+ */
+#ifndef TRACE_RING_SIZE
+#define TRACE_RING_SIZE (1024)
+#endif
+
+/*
+ * @brief Interval in records between two records that hold an absolute timestamp
+ * (a power of two). After lost records, the decoder resumes at the next absolute
+ * timestamp.
+ */
+#ifndef TRACE_RING_SYNC_INTERVAL
+#define TRACE_RING_SYNC_INTERVAL (64)
+#endif
+
+/*
+ * @brief Maximum number of event groups whose name is kept for the decoder.
+ */
+#ifndef TRACE_RING_MAX_GROUPS
+#define TRACE_RING_MAX_GROUPS (8)
+#endif
+
+/*
+ * @brief Set to 1 to drain the ring over RTT in the FreeRTOS idle hook. When set
+ * to 0, the ring is a flight recorder: read it with the debugger (see trace_ring.h)
+ * or call TRACE_RING_drain().
+ */
+#ifndef TRACE_RING_DRAIN_ON_IDLE
+#define TRACE_RING_DRAIN_ON_IDLE 1
+#endif
+
+/*
+ * @brief Maximum number of records sent in one RTT write.
+ */
+#ifndef TRACE_RING_DRAIN_RECORDS
+#define TRACE_RING_DRAIN_RECORDS (64)
+#endif
+
+/*
+ * @brief RTT up channel used to drain the ring (the channel 0 is the terminal, the
+ * channel 1 is used by SystemView and the channel 2 by the display list dump).
+ */
+#define TRACE_RING_RTT_CHANNEL (3)
+
+/*
+ * @brief Size in bytes of the RTT up buffer.
+ */
+#define TRACE_RING_RTT_BUFFER_SIZE (4 * 1024)
+
+/*
+ * @brief Timestamp source: the cycle counter of the DWT, its frequency and its
+ * start (called by TRACE_RING_initialize()).
+ */
+#ifndef TRACE_RING_GET_TIMESTAMP
+#include "fsl_device_registers.h"
+#define TRACE_RING_GET_TIMESTAMP() (DWT->CYCCNT)
+#define TRACE_RING_GET_FREQUENCY() (SystemCoreClock)
+#define TRACE_RING_START_TIMESTAMP() \
+	do { \
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; \
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk; \
+	} while (0)
+#endif
+
+/*
+ * @brief Context of an event: the exception number in an interrupt handler, the
+ * handle of the current task otherwise.
+ */
+#ifndef TRACE_RING_GET_CONTEXT
+#include "FreeRTOS.h"
+#include "task.h"
+#define TRACE_RING_GET_CONTEXT() \
+	((0u != __get_IPSR()) ? __get_IPSR() : (uint32_t)(uintptr_t)xTaskGetCurrentTaskHandle())
+#endif
+
+#endif // !defined TRACE_RING_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
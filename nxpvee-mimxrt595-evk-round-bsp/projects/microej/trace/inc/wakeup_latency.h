@@ -0,0 +1,147 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined WAKEUP_LATENCY_H
+#define WAKEUP_LATENCY_H
+
+/*
+ * @file
+ * @brief Latency between an interrupt and the task it wakes up.
+ *
+ * The interrupt handler stamps the cycle counter with WAKEUP_LATENCY_signal()
+ * just before waking up the task; the task calls WAKEUP_LATENCY_woken() just
+ * after its wait returns. The probes do not depend on the wake-up mechanism
+ * (semaphore, OSAL event), so the figures of two mechanisms are comparable. When
+ * the interrupt fires several times before the task runs, the latency is measured
+ * from the last interrupt. A task woken up by another task is not measured.
+ *
+ * The statistics (count, min, average and max in microseconds) are printed by
+ * WAKEUP_LATENCY_dump() (periodically by the monitor task when MONITOR_ENABLED
+ * is set, or from the debugger: "call WAKEUP_LATENCY_dump()").
+ *
+ * Each source is measured by one task. The statistics may be read from another
+ * task (some values may be torn).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "wakeup_latency_configuration.h"
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief The measured wake-ups.
+ */
+typedef enum {
+	WAKEUP_LATENCY_VM,          // LLMJVM_IMPL_wakeupVM() -> LLMJVM_IMPL_idleVM()
+	WAKEUP_LATENCY_GPU,         // GPU interrupt -> DISPLAY_VGLITE_start_operation()
+	WAKEUP_LATENCY_GRAPHICS,    // end of a GPU drawing or of a flush -> Graphics Engine
+	WAKEUP_LATENCY_TOUCH,       // touch interrupt -> touch task
+	WAKEUP_LATENCY_SOURCES
+} WAKEUP_LATENCY_source_t;
+
+/*
+ * @brief Latency statistics of a source, in microseconds.
+ */
+typedef struct {
+	uint32_t count;             // number of measured wake-ups
+	uint32_t min;
+	uint32_t avg;
+	uint32_t max;
+} WAKEUP_LATENCY_stats_t;
+
+// -----------------------------------------------------------------------------
+// Global variables
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief The stamps written by WAKEUP_LATENCY_signal().
+ */
+extern struct WAKEUP_LATENCY_state {
+	volatile uint32_t stamp[WAKEUP_LATENCY_SOURCES];    // cycle counter at the last interrupt
+	volatile bool pending[WAKEUP_LATENCY_SOURCES];      // true until the task is woken up
+} WAKEUP_LATENCY_state;
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Starts the cycle counter.
+ */
+void WAKEUP_LATENCY_initialize(void);
+
+/*
+ * @brief Clears the statistics.
+ */
+void WAKEUP_LATENCY_reset(void);
+
+/*
+ * @brief Adds a latency to the statistics of a source. Called by
+ * WAKEUP_LATENCY_woken().
+ *
+ * @param[in] source: the source.
+ * @param[in] cycles: the latency in cycles.
+ */
+void WAKEUP_LATENCY_add(WAKEUP_LATENCY_source_t source, uint32_t cycles);
+
+/*
+ * @brief Called by an interrupt handler before waking up the task.
+ *
+ * @param[in] source: the source.
+ */
+static inline void WAKEUP_LATENCY_signal(WAKEUP_LATENCY_source_t source) {
+#if defined(WAKEUP_LATENCY_ENABLED) && (WAKEUP_LATENCY_ENABLED != 0)
+	WAKEUP_LATENCY_state.stamp[source] = WAKEUP_LATENCY_GET_CYCLES();
+	WAKEUP_LATENCY_state.pending[source] = true;
+#else
+	(void)source;
+#endif
+}
+
+/*
+ * @brief Called by the task when its wait returns.
+ *
+ * @param[in] source: the source.
+ */
+static inline void WAKEUP_LATENCY_woken(WAKEUP_LATENCY_source_t source) {
+#if defined(WAKEUP_LATENCY_ENABLED) && (WAKEUP_LATENCY_ENABLED != 0)
+	if (WAKEUP_LATENCY_state.pending[source]) {
+		uint32_t now = WAKEUP_LATENCY_GET_CYCLES();
+		WAKEUP_LATENCY_state.pending[source] = false;
+		WAKEUP_LATENCY_add(source, now - WAKEUP_LATENCY_state.stamp[source]);
+	}
+#else
+	(void)source;
+#endif
+}
+
+/*
+ * @brief Gets the latency statistics of a source.
+ *
+ * @param[in] source: the source.
+ * @param[out] stats: the statistics.
+ */
+void WAKEUP_LATENCY_get_stats(WAKEUP_LATENCY_source_t source, WAKEUP_LATENCY_stats_t* stats);
+
+/*
+ * @brief Prints the statistics of the sources on the debug console.
+ */
+void WAKEUP_LATENCY_dump(void);
+
+#endif // !defined WAKEUP_LATENCY_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,44 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined WAKEUP_LATENCY_CONFIGURATION_H
+#define WAKEUP_LATENCY_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Set to 1 to measure the latency between the interrupts and the tasks
+ * they wake up (see wakeup_latency.h). It costs a read of the cycle counter in
+ * the interrupt handler and in the woken up task.
+ */
+#ifndef WAKEUP_LATENCY_ENABLED
+#define WAKEUP_LATENCY_ENABLED 1
+#endif
+
+/*
+ * @brief Cycle counter (32-bit: the latencies longer than a counter period, i.e.
+ * 21 seconds at 200 MHz, are wrong) and its frequency. The DWT cycle counter is
+ * started by WAKEUP_LATENCY_initialize().
+ */
+#ifndef WAKEUP_LATENCY_GET_CYCLES
+#include "fsl_device_registers.h"
+#define WAKEUP_LATENCY_GET_CYCLES() (DWT->CYCCNT)
+#define WAKEUP_LATENCY_GET_FREQUENCY() (SystemCoreClock)
+#define WAKEUP_LATENCY_START_CYCLES() \
+	do { \
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; \
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk; \
+	} while (0)
+#endif
+
+#endif // !defined WAKEUP_LATENCY_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -23,6 +23,9 @@
 #include <string.h>
 #include "LLMJVM_MONITOR_sysview.h"
 #include "LLTRACE_sysview_configuration.h"
+#include "trace_ring.h"
+#include "jvm_stats.h"
+#include "alloc_profiler.h"
 
 
 /* Defines -------------------------------------------------------------------*/
@@ -103,6 +106,12 @@ void LLMJVM_MONITOR_IMPL_initialize(bool auto_start) {
 	}
 	SEGGER_SYSVIEW_OnTaskCreate(THREAD_GC_UID);
 	LLMJVM_MONITOR_SYSTEMVIEW_send_gc_thread_info();
+#if JVM_STATS_ENABLED == 1
+	JVM_STATS_initialize();
+#endif
+#if ALLOC_PROFILER_ENABLED == 1
+	ALLOC_PROFILER_initialize();
+#endif
 }
 
 void LLMJVM_MONITOR_IMPL_on_shutdown(void) {
@@ -110,6 +119,9 @@ void LLMJVM_MONITOR_IMPL_on_shutdown(void) {
 }
 
 void LLMJVM_MONITOR_IMPL_on_thread_create(int32_t thread_id) {
+#if JVM_STATS_ENABLED == 1
+	JVM_STATS_on_thread_create(thread_id);
+#endif
 	SEGGER_SYSVIEW_OnTaskCreate(thread_id);
 	LLMJVM_MONITOR_SYSTEMVIEW_send_thread_info(thread_id);
 }
@@ -119,6 +131,9 @@ void LLMJVM_MONITOR_IMPL_on_thread_modified(int32_t thread_id) {
 }
 
 void LLMJVM_MONITOR_IMPL_on_thread_state_changed(int32_t thread_id, MJVM_MONITOR_state_t new_state) {
+#if JVM_STATS_ENABLED == 1
+	JVM_STATS_on_thread_state_changed(thread_id, (int32_t)new_state);
+#endif
 	switch(new_state){
 		case MJVM_MONITOR_STATE_READY:{
 			SEGGER_SYSVIEW_OnTaskStartReady(thread_id);
@@ -151,21 +166,43 @@ void LLMJVM_MONITOR_IMPL_on_idle(void) {
 }
 
 void LLMJVM_MONITOR_IMPL_on_gc_start(int32_t current_thread_id) {
+#if JVM_STATS_ENABLED == 1
+	JVM_STATS_on_gc_start();
+#endif
 	SEGGER_SYSVIEW_OnTaskStartExec(THREAD_GC_UID);
 }
 
 void LLMJVM_MONITOR_IMPL_on_gc_stop(int32_t current_thread_id) {
+#if JVM_STATS_ENABLED == 1
+	JVM_STATS_on_gc_stop();
+#endif
 	SEGGER_SYSVIEW_OnTaskStartExec(current_thread_id);
 }
 
 void LLMJVM_MONITOR_IMPL_on_allocate(void* type, int32_t size, void* method, void* instruction_address, int32_t total_memory, int32_t free_memory, bool immortal) {
-	if(MICROEJ_TRACE_ENABLE_ALLOCATIONS){
+#if ALLOC_PROFILER_ENABLED == 1
+	// when the profiler runs, only the sampled allocations are traced
+	bool traced = ALLOC_PROFILER_on_allocate(type, size, method) || !ALLOC_PROFILER_state.running;
+#else
+	bool traced = true;
+#endif
+	if(MICROEJ_TRACE_ENABLE_ALLOCATIONS && traced){
+#if TRACE_RING_ENABLED == 1
+		uint32_t values[] = { (uint32_t)size, (uint32_t)free_memory, (uint32_t)(total_memory-free_memory) };
+		TRACE_RING_record(TRACE_RING_KIND_START, TRACE_RING_GROUP_MONITOR, MICROEJ_TRACE_API_ID_OFFSET + apiID_ALLOCATE, values, 3);
+#else
 		SEGGER_SYSVIEW_RecordU32x3(MICROEJ_TRACE_API_ID_OFFSET + apiID_ALLOCATE, size, free_memory, total_memory-free_memory);
+#endif
 	}
 }
 
 void LLMJVM_MONITOR_IMPL_on_exception(void* exception_type, void* throw_method, void* throw_instruction_address, void* catch_method, void* catch_instruction_address, const char* message) {
 	if(MICROEJ_TRACE_ENABLE_EXCEPTIONS){
+#if TRACE_RING_ENABLED == 1
+		uint32_t values[] = { (uint32_t)exception_type, (uint32_t)throw_method, (uint32_t)throw_instruction_address, (uint32_t)catch_method, (uint32_t)catch_instruction_address };
+		TRACE_RING_record(TRACE_RING_KIND_START, TRACE_RING_GROUP_MONITOR, MICROEJ_TRACE_API_ID_OFFSET + apiID_EXCEPTION, values, 5);
+#else
 		SEGGER_SYSVIEW_RecordU32x5(MICROEJ_TRACE_API_ID_OFFSET + apiID_EXCEPTION, (U32)exception_type, (U32)throw_method, (U32)throw_instruction_address, (U32)catch_method, (U32)catch_instruction_address);
+#endif
 	}
 }
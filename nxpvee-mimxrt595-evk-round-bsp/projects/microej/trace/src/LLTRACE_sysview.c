@@ -21,6 +21,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include "LLTRACE_sysview_configuration.h"
+#include "trace_ring.h"
 
 
 /* Defines -------------------------------------------------------------------*/
@@ -34,6 +35,11 @@ char* LLTRACE_module_names[MICROEJ_TRACE_MAX_NB_MODULES][MICROEJ_TRACE_MAX_MODUL
 int32_t LLTRACE_next_free_module_offset = 0;
 bool LLTRACE_started = false;
 
+/**
+ * Group of a module in the trace ring: its offset in LLTRACE_modules
+ */
+#define LLTRACE_RING_GROUP(module) ((uint32_t)((module) - LLTRACE_modules))
+
 /* Private functions ---------------------------------------------------------*/
 
 /* Public functions ----------------------------------------------------------*/
@@ -84,6 +90,9 @@ int32_t LLTRACE_IMPL_declare_event_group(const char* group_name, int32_t nb_even
 		module->pNext = NULL; // set by SystemView
 
 		SEGGER_SYSVIEW_RegisterModule(module);
+#if TRACE_RING_ENABLED == 1
+		TRACE_RING_set_group_name(module_offset, group_name);
+#endif
 		return (int32_t)module;
 	}
 	else {
@@ -94,66 +103,129 @@ int32_t LLTRACE_IMPL_declare_event_group(const char* group_name, int32_t nb_even
 
 void LLTRACE_IMPL_record_event_void(int32_t group_id, int32_t event_id) {
 	SEGGER_SYSVIEW_MODULE* module = (SEGGER_SYSVIEW_MODULE*) group_id;
+#if TRACE_RING_ENABLED == 1
+	TRACE_RING_record(TRACE_RING_KIND_START, LLTRACE_RING_GROUP(module), event_id, NULL, 0);
+#else
 	SEGGER_SYSVIEW_RecordVoid(module->EventOffset + event_id);
+#endif
 }
 
 void LLTRACE_IMPL_record_event_u32(int32_t group_id, int32_t event_id, uint32_t value0) {
 	SEGGER_SYSVIEW_MODULE* module = (SEGGER_SYSVIEW_MODULE*) group_id;
+#if TRACE_RING_ENABLED == 1
+	uint32_t values[] = { value0 };
+	TRACE_RING_record(TRACE_RING_KIND_START, LLTRACE_RING_GROUP(module), event_id, values, 1);
+#else
 	SEGGER_SYSVIEW_RecordU32(module->EventOffset + event_id, value0);
+#endif
 }
 
 void LLTRACE_IMPL_record_event_u32x2(int32_t group_id, int32_t event_id, uint32_t value1, uint32_t value2) {
 	SEGGER_SYSVIEW_MODULE* module = (SEGGER_SYSVIEW_MODULE*) group_id;
+#if TRACE_RING_ENABLED == 1
+	uint32_t values[] = { value1, value2 };
+	TRACE_RING_record(TRACE_RING_KIND_START, LLTRACE_RING_GROUP(module), event_id, values, 2);
+#else
 	SEGGER_SYSVIEW_RecordU32x2(module->EventOffset + event_id, value1, value2);
+#endif
 }
 
 void LLTRACE_IMPL_record_event_u32x3(int32_t group_id, int32_t event_id, uint32_t value1, uint32_t value2, uint32_t value3) {
 	SEGGER_SYSVIEW_MODULE* module = (SEGGER_SYSVIEW_MODULE*) group_id;
+#if TRACE_RING_ENABLED == 1
+	uint32_t values[] = { value1, value2, value3 };
+	TRACE_RING_record(TRACE_RING_KIND_START, LLTRACE_RING_GROUP(module), event_id, values, 3);
+#else
 	SEGGER_SYSVIEW_RecordU32x3(module->EventOffset + event_id, value1, value2, value3);
+#endif
 }
 
 void LLTRACE_IMPL_record_event_u32x4(int32_t group_id, int32_t event_id, uint32_t value1, uint32_t value2, uint32_t value3, uint32_t value4) {
 	SEGGER_SYSVIEW_MODULE* module = (SEGGER_SYSVIEW_MODULE*) group_id;
+#if TRACE_RING_ENABLED == 1
+	uint32_t values[] = { value1, value2, value3, value4 };
+	TRACE_RING_record(TRACE_RING_KIND_START, LLTRACE_RING_GROUP(module), event_id, values, 4);
+#else
 	SEGGER_SYSVIEW_RecordU32x4(module->EventOffset + event_id, value1, value2, value3, value4);
+#endif
 }
 
 void LLTRACE_IMPL_record_event_u32x5(int32_t group_id, int32_t event_id, uint32_t value1, uint32_t value2, uint32_t value3, uint32_t value4, uint32_t value5) {
 	SEGGER_SYSVIEW_MODULE* module = (SEGGER_SYSVIEW_MODULE*) group_id;
+#if TRACE_RING_ENABLED == 1
+	uint32_t values[] = { value1, value2, value3, value4, value5 };
+	TRACE_RING_record(TRACE_RING_KIND_START, LLTRACE_RING_GROUP(module), event_id, values, 5);
+#else
 	SEGGER_SYSVIEW_RecordU32x5(module->EventOffset + event_id, value1, value2, value3, value4, value5);
+#endif
 }
 
 void LLTRACE_IMPL_record_event_u32x6(int32_t group_id, int32_t event_id, uint32_t value1, uint32_t value2, uint32_t value3, uint32_t value4, uint32_t value5, uint32_t value6) {
 	SEGGER_SYSVIEW_MODULE* module = (SEGGER_SYSVIEW_MODULE*) group_id;
+#if TRACE_RING_ENABLED == 1
+	uint32_t values[] = { value1, value2, value3, value4, value5, value6 };
+	TRACE_RING_record(TRACE_RING_KIND_START, LLTRACE_RING_GROUP(module), event_id, values, 6);
+#else
 	SEGGER_SYSVIEW_RecordU32x6(module->EventOffset + event_id, value1, value2, value3, value4, value5, value6);
+#endif
 }
 
 void LLTRACE_IMPL_record_event_u32x7(int32_t group_id, int32_t event_id, uint32_t value1, uint32_t value2, uint32_t value3, uint32_t value4, uint32_t value5, uint32_t value6, uint32_t value7) {
 	SEGGER_SYSVIEW_MODULE* module = (SEGGER_SYSVIEW_MODULE*) group_id;
+#if TRACE_RING_ENABLED == 1
+	uint32_t values[] = { value1, value2, value3, value4, value5, value6, value7 };
+	TRACE_RING_record(TRACE_RING_KIND_START, LLTRACE_RING_GROUP(module), event_id, values, 7);
+#else
 	SEGGER_SYSVIEW_RecordU32x7(module->EventOffset + event_id, value1, value2, value3, value4, value5, value6, value7);
+#endif
 }
 
 void LLTRACE_IMPL_record_event_u32x8(int32_t group_id, int32_t event_id, uint32_t value1, uint32_t value2, uint32_t value3, uint32_t value4, uint32_t value5, uint32_t value6, uint32_t value7, uint32_t value8) {
 	SEGGER_SYSVIEW_MODULE* module = (SEGGER_SYSVIEW_MODULE*) group_id;
+#if TRACE_RING_ENABLED == 1
+	uint32_t values[] = { value1, value2, value3, value4, value5, value6, value7, value8 };
+	TRACE_RING_record(TRACE_RING_KIND_START, LLTRACE_RING_GROUP(module), event_id, values, 8);
+#else
 	SEGGER_SYSVIEW_RecordU32x8(module->EventOffset + event_id, value1, value2, value3, value4, value5, value6, value7, value8);
+#endif
 }
 
 void LLTRACE_IMPL_record_event_u32x9(int32_t group_id, int32_t event_id, uint32_t value1, uint32_t value2, uint32_t value3, uint32_t value4, uint32_t value5, uint32_t value6, uint32_t value7, uint32_t value8, uint32_t value9) {
 	SEGGER_SYSVIEW_MODULE* module = (SEGGER_SYSVIEW_MODULE*) group_id;
+#if TRACE_RING_ENABLED == 1
+	uint32_t values[] = { value1, value2, value3, value4, value5, value6, value7, value8, value9 };
+	TRACE_RING_record(TRACE_RING_KIND_START, LLTRACE_RING_GROUP(module), event_id, values, 9);
+#else
 	SEGGER_SYSVIEW_RecordU32x9(module->EventOffset + event_id, value1, value2, value3, value4, value5, value6, value7, value8, value9);
+#endif
 }
 
 void LLTRACE_IMPL_record_event_u32x10(int32_t group_id, int32_t event_id, uint32_t value1, uint32_t value2, uint32_t value3, uint32_t value4, uint32_t value5, uint32_t value6, uint32_t value7, uint32_t value8, uint32_t value9, uint32_t value10){
 	SEGGER_SYSVIEW_MODULE* module = (SEGGER_SYSVIEW_MODULE*) group_id;
+#if TRACE_RING_ENABLED == 1
+	uint32_t values[] = { value1, value2, value3, value4, value5, value6, value7, value8, value9, value10 };
+	TRACE_RING_record(TRACE_RING_KIND_START, LLTRACE_RING_GROUP(module), event_id, values, 10);
+#else
 	SEGGER_SYSVIEW_RecordU32x10(module->EventOffset + event_id, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10);
+#endif
 }
 
 void LLTRACE_IMPL_record_event_end(int32_t group_id, int32_t event_id){
 	SEGGER_SYSVIEW_MODULE* module = (SEGGER_SYSVIEW_MODULE*) group_id;
+#if TRACE_RING_ENABLED == 1
+	TRACE_RING_record(TRACE_RING_KIND_END, LLTRACE_RING_GROUP(module), event_id, NULL, 0);
+#else
 	SEGGER_SYSVIEW_RecordEndCall(module->EventOffset + event_id);
+#endif
 }
 
 void LLTRACE_IMPL_record_event_end_u32(int32_t group_id, int32_t event_id, uint32_t value1){
 	SEGGER_SYSVIEW_MODULE* module = (SEGGER_SYSVIEW_MODULE*) group_id;
+#if TRACE_RING_ENABLED == 1
+	uint32_t values[] = { value1 };
+	TRACE_RING_record(TRACE_RING_KIND_END, LLTRACE_RING_GROUP(module), event_id, values, 1);
+#else
 	SEGGER_SYSVIEW_RecordEndCallU32(module->EventOffset + event_id, value1);
+#endif
 }
 
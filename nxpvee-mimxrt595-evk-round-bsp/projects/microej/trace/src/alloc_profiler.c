@@ -0,0 +1,365 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Sampling allocation profiler aggregated by type and call site.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <math.h>
+#include <string.h>
+
+#include "alloc_profiler.h"
+
+#if defined(ALLOC_PROFILER_ENABLED) && (ALLOC_PROFILER_ENABLED != 0)
+
+#include "fsl_debug_console.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#if (ALLOC_PROFILER_TABLE_SIZE & (ALLOC_PROFILER_TABLE_SIZE - 1)) != 0
+#error "ALLOC_PROFILER_TABLE_SIZE must be a power of 2"
+#endif
+
+/*
+ * @brief Bits of the fractional part of the estimated number of allocations.
+ */
+#define ALLOC_PROFILER_COUNT_SHIFT (8)
+
+/*
+ * @brief Longest sampling interval drawn (the exponential distribution is
+ * truncated far beyond its mean).
+ */
+#define ALLOC_PROFILER_MAX_COUNTDOWN (0x3FFFFFFF)
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief An entry of the (type, method) table.
+ */
+typedef struct {
+	void* type;                 // NULL for a free entry
+	void* method;
+	uint32_t samples;
+	uint64_t count;             // estimated number of allocations (fixed point, see ALLOC_PROFILER_COUNT_SHIFT)
+	uint64_t bytes;             // estimated number of bytes
+} alloc_profiler_entry_t;
+
+// -----------------------------------------------------------------------------
+// Global variables
+// -----------------------------------------------------------------------------
+
+struct ALLOC_PROFILER_state ALLOC_PROFILER_state = {
+	.countdown = INT32_MAX,
+	.running = false,
+};
+
+// -----------------------------------------------------------------------------
+// Private fields
+// -----------------------------------------------------------------------------
+
+static alloc_profiler_entry_t table[ALLOC_PROFILER_TABLE_SIZE];
+static alloc_profiler_entry_t* top[ALLOC_PROFILER_TOP];    // the most first
+static uint32_t top_count;
+static uint32_t site_count;
+static uint32_t samples;
+static uint32_t dropped;
+
+static uint32_t interval = ALLOC_PROFILER_SAMPLING_INTERVAL;
+static int32_t drawn;                   // countdown drawn at the last sample
+static uint64_t allocated;              // bytes allocated until the last sample
+static uint32_t random_state = ALLOC_PROFILER_SEED;
+
+static int64_t rate_time;               // start of the current rate period
+static uint64_t rate_allocated;         // bytes allocated at the start of the current rate period
+static uint32_t rate;                   // rate of the last period (bytes per second)
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Draws the number of bytes to allocate before the next sample from an
+ * exponential distribution of mean interval and rearms the countdown.
+ */
+static void __alloc_profiler_draw(void);
+
+/*
+ * @brief Gets the number of bytes allocated while the profiler runs.
+ */
+static uint64_t __alloc_profiler_get_allocated(void);
+
+/*
+ * @brief Gets the entry of a site.
+ *
+ * @return the entry or NULL when the table is full.
+ */
+static alloc_profiler_entry_t* __alloc_profiler_get_entry(void* type, void* method);
+
+/*
+ * @brief Moves an entry whose bytes have grown up in the top list.
+ */
+static void __alloc_profiler_update_top(alloc_profiler_entry_t* entry);
+
+/*
+ * @brief Measures the allocation rate at the end of each period.
+ */
+static void __alloc_profiler_update_rate(void);
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void ALLOC_PROFILER_initialize(void) {
+#if ALLOC_PROFILER_AUTO_START == 1
+	ALLOC_PROFILER_start(0);
+#endif
+}
+
+// See the header file for the function documentation
+void ALLOC_PROFILER_start(uint32_t sampling_interval) {
+	if (!ALLOC_PROFILER_state.running) {
+		interval = (0u == sampling_interval) ? (uint32_t)ALLOC_PROFILER_SAMPLING_INTERVAL : sampling_interval;
+		rate_time = ALLOC_PROFILER_GET_TIME_MS();
+		rate_allocated = allocated;
+		rate = 0;
+		__alloc_profiler_draw();
+		ALLOC_PROFILER_state.running = true;
+	}
+}
+
+// See the header file for the function documentation
+void ALLOC_PROFILER_stop(void) {
+	if (ALLOC_PROFILER_state.running) {
+		allocated = __alloc_profiler_get_allocated();
+		ALLOC_PROFILER_state.running = false;
+		ALLOC_PROFILER_state.countdown = INT32_MAX;
+	}
+}
+
+// See the header file for the function documentation
+void ALLOC_PROFILER_reset(void) {
+	(void)memset(table, 0, sizeof(table));
+	top_count = 0;
+	site_count = 0;
+	samples = 0;
+	dropped = 0;
+	// the bytes of the current sampling interval are accounted from now
+	drawn = ALLOC_PROFILER_state.countdown;
+	allocated = 0;
+	rate_time = ALLOC_PROFILER_GET_TIME_MS();
+	rate_allocated = 0;
+	rate = 0;
+}
+
+// See the header file for the function documentation
+bool ALLOC_PROFILER_sample(void* type, int32_t size, void* method) {
+	bool sampled = ALLOC_PROFILER_state.running;
+
+	if (!sampled) {
+		// stopped: the countdown has been decreased by 2 GB
+		ALLOC_PROFILER_state.countdown = INT32_MAX;
+	}
+	else {
+		allocated = __alloc_profiler_get_allocated();
+		__alloc_profiler_draw();
+		samples++;
+
+		// probability to sample this allocation: weight of the sample
+		float p = -expm1f(-(float)size / (float)interval);
+		if (p < (1.0f / (float)ALLOC_PROFILER_MAX_COUNTDOWN)) {
+			p = 1.0f / (float)ALLOC_PROFILER_MAX_COUNTDOWN;
+		}
+
+		alloc_profiler_entry_t* entry = __alloc_profiler_get_entry(type, method);
+		if (NULL == entry) {
+			dropped++;
+		}
+		else {
+			entry->samples++;
+			entry->count += (uint64_t)(((float)(1u << ALLOC_PROFILER_COUNT_SHIFT) / p) + 0.5f);
+			entry->bytes += (uint64_t)(((float)size / p) + 0.5f);
+			__alloc_profiler_update_top(entry);
+		}
+
+		__alloc_profiler_update_rate();
+	}
+	return sampled;
+}
+
+// See the header file for the function documentation
+uint32_t ALLOC_PROFILER_get_top(ALLOC_PROFILER_site_t* sites, uint32_t max) {
+	uint32_t count = (top_count < max) ? top_count : max;
+
+	for (uint32_t i = 0; i < count; i++) {
+		const alloc_profiler_entry_t* entry = top[i];
+		sites[i].type = entry->type;
+		sites[i].method = entry->method;
+		sites[i].samples = entry->samples;
+		sites[i].count = (uint32_t)((entry->count + (1u << (ALLOC_PROFILER_COUNT_SHIFT - 1))) >> ALLOC_PROFILER_COUNT_SHIFT);
+		sites[i].bytes = entry->bytes;
+	}
+	return count;
+}
+
+// See the header file for the function documentation
+void ALLOC_PROFILER_get_stats(ALLOC_PROFILER_stats_t* stats) {
+	stats->running = ALLOC_PROFILER_state.running;
+	stats->interval = interval;
+	stats->allocated = __alloc_profiler_get_allocated();
+	stats->samples = samples;
+	stats->dropped = dropped;
+	stats->sites = site_count;
+	stats->rate = rate;
+
+	if (stats->running) {
+		int64_t elapsed = ALLOC_PROFILER_GET_TIME_MS() - rate_time;
+		if (elapsed >= (2 * ALLOC_PROFILER_RATE_PERIOD)) {
+			// no sample since more than a period: the last rate is outdated
+			stats->rate = (uint32_t)(((stats->allocated - rate_allocated) * 1000u) / (uint64_t)elapsed);
+		}
+	}
+}
+
+// See the header file for the function documentation
+void ALLOC_PROFILER_dump(void) {
+	ALLOC_PROFILER_stats_t stats;
+	ALLOC_PROFILER_site_t s[ALLOC_PROFILER_TOP];
+
+	ALLOC_PROFILER_get_stats(&stats);
+	PRINTF("alloc: %s, %u KB, %u B/s, %u samples (%u dropped) every %u B, %u sites\n",
+			stats.running ? "running" : "stopped", (unsigned int)(stats.allocated / 1024u), (unsigned int)stats.rate,
+			(unsigned int)stats.samples, (unsigned int)stats.dropped, (unsigned int)stats.interval, (unsigned int)stats.sites);
+
+	uint32_t count = ALLOC_PROFILER_get_top(s, ALLOC_PROFILER_TOP);
+	if (0u != count) {
+		PRINTF("  type       method      count(est) bytes(est) samples\n");
+		for (uint32_t i = 0; i < count; i++) {
+			PRINTF("  0x%08x 0x%08x %10u %10u %7u\n", (unsigned int)(uintptr_t)s[i].type, (unsigned int)(uintptr_t)s[i].method,
+					(unsigned int)s[i].count, (unsigned int)s[i].bytes, (unsigned int)s[i].samples);
+		}
+	}
+}
+
+// -----------------------------------------------------------------------------
+// Internal functions
+// -----------------------------------------------------------------------------
+
+// See the section 'Internal function definitions' for the function documentation
+static void __alloc_profiler_draw(void) {
+	// xorshift32
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+
+	// uniform in ]0, 1]
+	float u = ((float)(random_state >> 8) + 1.0f) * (1.0f / 16777216.0f);
+	float x = ceilf(-logf(u) * (float)interval);
+	if (x > (float)ALLOC_PROFILER_MAX_COUNTDOWN) {
+		x = (float)ALLOC_PROFILER_MAX_COUNTDOWN;
+	}
+	else if (x < 1.0f) {
+		x = 1.0f;
+	}
+	else {
+		// in range
+	}
+
+	drawn = (int32_t)x;
+	ALLOC_PROFILER_state.countdown = drawn;
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static uint64_t __alloc_profiler_get_allocated(void) {
+	uint64_t a = allocated;
+	if (ALLOC_PROFILER_state.running) {
+		// bytes of the current sampling interval (the countdown is negative after the sampled allocation)
+		a += (uint64_t)((int64_t)drawn - (int64_t)ALLOC_PROFILER_state.countdown);
+	}
+	return a;
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static alloc_profiler_entry_t* __alloc_profiler_get_entry(void* type, void* method) {
+	uint32_t hash = ((uint32_t)(uintptr_t)type * 2654435761u) ^ ((uint32_t)(uintptr_t)method * 2246822519u);
+	hash ^= hash >> 16;
+
+	alloc_profiler_entry_t* entry = NULL;
+	for (uint32_t i = 0; (i < (uint32_t)ALLOC_PROFILER_TABLE_SIZE) && (NULL == entry); i++) {
+		alloc_profiler_entry_t* e = &table[(hash + i) & (ALLOC_PROFILER_TABLE_SIZE - 1)];
+		if (NULL == e->type) {
+			// first sample of this site
+			e->type = type;
+			e->method = method;
+			site_count++;
+			entry = e;
+		}
+		else if ((e->type == type) && (e->method == method)) {
+			entry = e;
+		}
+		else {
+			// collision: linear probing
+		}
+	}
+	return entry;
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static void __alloc_profiler_update_top(alloc_profiler_entry_t* entry) {
+	// the bytes only grow: the entries out of the list allocate less than its last entry
+	uint32_t i = 0;
+	while ((i < top_count) && (top[i] != entry)) {
+		i++;
+	}
+
+	if (i == top_count) {
+		if (top_count < (uint32_t)ALLOC_PROFILER_TOP) {
+			top_count++;
+		}
+		else if (entry->bytes > top[ALLOC_PROFILER_TOP - 1]->bytes) {
+			i = ALLOC_PROFILER_TOP - 1;
+		}
+		else {
+			// not in the list
+			i = ALLOC_PROFILER_TOP;
+		}
+	}
+
+	if (i < (uint32_t)ALLOC_PROFILER_TOP) {
+		while ((i > 0u) && (top[i - 1u]->bytes < entry->bytes)) {
+			top[i] = top[i - 1u];
+			i--;
+		}
+		top[i] = entry;
+	}
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static void __alloc_profiler_update_rate(void) {
+	int64_t now = ALLOC_PROFILER_GET_TIME_MS();
+	int64_t elapsed = now - rate_time;
+	if (elapsed >= ALLOC_PROFILER_RATE_PERIOD) {
+		rate = (uint32_t)(((allocated - rate_allocated) * 1000u) / (uint64_t)elapsed);
+		rate_time = now;
+		rate_allocated = allocated;
+	}
+}
+
+#endif // ALLOC_PROFILER_ENABLED
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
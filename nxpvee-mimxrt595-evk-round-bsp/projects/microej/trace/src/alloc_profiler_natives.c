@@ -0,0 +1,118 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Natives of com.nxp.allocprofiler.AllocProfilerNatives: control of the
+ * sampling allocation profiler by the application (see alloc_profiler.h).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <sni.h>
+
+#include "alloc_profiler.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Values returned by getStats().
+ */
+#define STATS_ALLOCATED (0)
+#define STATS_RATE (1)
+#define STATS_SAMPLES (2)
+#define STATS_DROPPED (3)
+#define STATS_VALUES (4)
+
+// -----------------------------------------------------------------------------
+// Java natives
+// -----------------------------------------------------------------------------
+
+#if defined(ALLOC_PROFILER_ENABLED) && (ALLOC_PROFILER_ENABLED != 0)
+
+/*
+ * @brief Starts the profiler with a mean sampling interval in bytes (0 for the
+ * default interval).
+ */
+void Java_com_nxp_allocprofiler_AllocProfilerNatives_start(jint interval) {
+	ALLOC_PROFILER_start((interval < 0) ? 0u : (uint32_t)interval);
+}
+
+/*
+ * @brief Stops the profiler.
+ */
+void Java_com_nxp_allocprofiler_AllocProfilerNatives_stop(void) {
+	ALLOC_PROFILER_stop();
+}
+
+/*
+ * @brief Clears the statistics.
+ */
+void Java_com_nxp_allocprofiler_AllocProfilerNatives_reset(void) {
+	ALLOC_PROFILER_reset();
+}
+
+/*
+ * @brief Gets the statistics: bytes allocated while the profiler runs, allocation
+ * rate (bytes per second), number of samples and of dropped samples.
+ *
+ * @return the number of values, -1 when the array is too small.
+ */
+jint Java_com_nxp_allocprofiler_AllocProfilerNatives_getStats(jlong* values) {
+	ALLOC_PROFILER_stats_t stats;
+	jint ret = -1;
+
+	if ((uint32_t)SNI_getArrayLength(values) >= (uint32_t)STATS_VALUES) {
+		ALLOC_PROFILER_get_stats(&stats);
+		values[STATS_ALLOCATED] = (jlong)stats.allocated;
+		values[STATS_RATE] = (jlong)stats.rate;
+		values[STATS_SAMPLES] = (jlong)stats.samples;
+		values[STATS_DROPPED] = (jlong)stats.dropped;
+		ret = STATS_VALUES;
+	}
+	return ret;
+}
+
+/*
+ * @brief Prints the statistics and the top allocation sites on the debug console.
+ */
+void Java_com_nxp_allocprofiler_AllocProfilerNatives_dump(void) {
+	ALLOC_PROFILER_dump();
+}
+
+#else // ALLOC_PROFILER_ENABLED
+
+void Java_com_nxp_allocprofiler_AllocProfilerNatives_start(jint interval) {
+	(void)interval;
+}
+
+void Java_com_nxp_allocprofiler_AllocProfilerNatives_stop(void) {
+	// nothing to do
+}
+
+void Java_com_nxp_allocprofiler_AllocProfilerNatives_reset(void) {
+	// nothing to do
+}
+
+jint Java_com_nxp_allocprofiler_AllocProfilerNatives_getStats(jlong* values) {
+	(void)values;
+	return -1;
+}
+
+void Java_com_nxp_allocprofiler_AllocProfilerNatives_dump(void) {
+	// nothing to do
+}
+
+#endif // ALLOC_PROFILER_ENABLED
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
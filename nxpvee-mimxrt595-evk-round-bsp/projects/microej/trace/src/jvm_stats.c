@@ -0,0 +1,393 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Java thread CPU accounting and GC pause statistics.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "jvm_stats.h"
+
+#if defined(JVM_STATS_ENABLED) && (JVM_STATS_ENABLED != 0)
+
+#include "fsl_debug_console.h"
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief A Java thread. The times are in cycles.
+ */
+typedef struct {
+	bool used;                  // false for a free entry
+	int32_t id;
+	bool terminated;
+	bool ready;                 // true when the thread waits for the CPU
+	uint64_t ready_since;       // time of the last ready state
+	uint64_t running_since;     // start of the current running period
+	uint64_t running_time;
+	uint32_t scheduled;
+	uint64_t latency_total;
+	uint32_t latency_count;
+	uint64_t latency_max;
+} jvm_stats_thread_t;
+
+// -----------------------------------------------------------------------------
+// Private fields
+// -----------------------------------------------------------------------------
+
+static jvm_stats_thread_t threads[JVM_STATS_MAX_THREADS];
+static jvm_stats_thread_t* running;     // the running thread, NULL when none
+static bool gc_running;                 // true between the GC start and stop
+static uint64_t gc_start;               // start of the current GC (cycles)
+static int64_t gc_start_time;           // start of the current GC (platform time)
+static JVM_STATS_gc_t gc;
+
+static uint32_t cycles_last;            // last value of the cycle counter
+static uint64_t cycles_high;            // high part of the 64-bit time
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Gets the current time in cycles and updates the extension of the cycle
+ * counter. Only called by the MicroJvm task.
+ */
+static uint64_t __jvm_stats_now(void);
+
+/*
+ * @brief Gets the current time in cycles without updating the extension of the
+ * cycle counter (may be called by any task).
+ */
+static uint64_t __jvm_stats_peek(void);
+
+/*
+ * @brief Converts cycles to microseconds.
+ */
+static uint64_t __jvm_stats_to_us(uint64_t cycles);
+
+/*
+ * @brief Gets the entry of a thread.
+ *
+ * @param[in] create: true to create the entry of an unknown thread.
+ *
+ * @return the entry or NULL.
+ */
+static jvm_stats_thread_t* __jvm_stats_get_thread(int32_t thread_id, bool create);
+
+/*
+ * @brief Ends the running period of the running thread.
+ */
+static void __jvm_stats_stop_running(uint64_t now);
+
+/*
+ * @brief Adds a GC pause to the histogram and to the worst pauses.
+ */
+static void __jvm_stats_add_pause(uint32_t duration, int64_t time);
+
+/*
+ * @brief Converts the statistics of a thread.
+ */
+static void __jvm_stats_convert(const jvm_stats_thread_t* entry, JVM_STATS_thread_t* thread, uint64_t now);
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void JVM_STATS_initialize(void) {
+	JVM_STATS_START_CYCLES();
+	cycles_last = JVM_STATS_GET_CYCLES();
+}
+
+// See the header file for the function documentation
+void JVM_STATS_reset(void) {
+	uint64_t now = __jvm_stats_now();
+
+	for (uint32_t i = 0; i < (uint32_t)JVM_STATS_MAX_THREADS; i++) {
+		jvm_stats_thread_t* entry = &threads[i];
+		entry->running_time = 0;
+		entry->scheduled = 0;
+		entry->latency_total = 0;
+		entry->latency_count = 0;
+		entry->latency_max = 0;
+		entry->running_since = now;
+	}
+	(void)memset(&gc, 0, sizeof(gc));
+}
+
+// See the header file for the function documentation
+void JVM_STATS_on_thread_create(int32_t thread_id) {
+	jvm_stats_thread_t* entry = __jvm_stats_get_thread(thread_id, true);
+	if ((NULL != entry) && entry->terminated) {
+		// identifier of a terminated thread reused
+		if (running == entry) {
+			running = NULL;
+		}
+		(void)memset(entry, 0, sizeof(jvm_stats_thread_t));
+		entry->used = true;
+		entry->id = thread_id;
+	}
+}
+
+// See the header file for the function documentation
+void JVM_STATS_on_thread_state_changed(int32_t thread_id, int32_t state) {
+	uint64_t now = __jvm_stats_now();
+	jvm_stats_thread_t* entry = __jvm_stats_get_thread(thread_id, JVM_STATS_STATE_TERMINATED != state);
+
+	if (NULL != entry) {
+		if (JVM_STATS_STATE_RUNNING == state) {
+			if (running != entry) {
+				// the running thread may be preempted without notification
+				__jvm_stats_stop_running(now);
+			}
+			if (entry->ready) {
+				uint64_t latency = now - entry->ready_since;
+				entry->latency_total += latency;
+				entry->latency_count++;
+				if (latency > entry->latency_max) {
+					entry->latency_max = latency;
+				}
+				entry->ready = false;
+			}
+			entry->scheduled++;
+			entry->running_since = now;
+			running = entry;
+		}
+		else {
+			if (running == entry) {
+				__jvm_stats_stop_running(now);
+			}
+			if (JVM_STATS_STATE_READY == state) {
+				if (!entry->ready) {
+					entry->ready = true;
+					entry->ready_since = now;
+				}
+			}
+			else {
+				entry->ready = false;
+				entry->terminated = (JVM_STATS_STATE_TERMINATED == state);
+			}
+		}
+	}
+}
+
+// See the header file for the function documentation
+void JVM_STATS_on_gc_start(void) {
+	uint64_t now = __jvm_stats_now();
+
+	if (!gc_running) {
+		if (NULL != running) {
+			// the GC pause is not accounted to the running thread
+			running->running_time += now - running->running_since;
+		}
+		gc_running = true;
+		gc_start = now;
+		gc_start_time = JVM_STATS_GET_TIME_MS();
+	}
+}
+
+// See the header file for the function documentation
+void JVM_STATS_on_gc_stop(void) {
+	uint64_t now = __jvm_stats_now();
+
+	if (gc_running) {
+		uint64_t duration = __jvm_stats_to_us(now - gc_start);
+		gc_running = false;
+		if (NULL != running) {
+			running->running_since = now;
+		}
+		__jvm_stats_add_pause((duration > UINT32_MAX) ? UINT32_MAX : (uint32_t)duration, gc_start_time);
+	}
+}
+
+// See the header file for the function documentation
+uint32_t JVM_STATS_get_threads(JVM_STATS_thread_t* thread, uint32_t max) {
+	uint64_t now = __jvm_stats_peek();
+	uint32_t count = 0;
+
+	for (uint32_t i = 0; (i < (uint32_t)JVM_STATS_MAX_THREADS) && (count < max); i++) {
+		if (threads[i].used) {
+			__jvm_stats_convert(&threads[i], &thread[count], now);
+			count++;
+		}
+	}
+	return count;
+}
+
+// See the header file for the function documentation
+bool JVM_STATS_get_thread(int32_t thread_id, JVM_STATS_thread_t* thread) {
+	const jvm_stats_thread_t* entry = __jvm_stats_get_thread(thread_id, false);
+	if (NULL != entry) {
+		__jvm_stats_convert(entry, thread, __jvm_stats_peek());
+	}
+	return NULL != entry;
+}
+
+// See the header file for the function documentation
+void JVM_STATS_get_gc(JVM_STATS_gc_t* g) {
+	*g = gc;
+}
+
+// See the header file for the function documentation
+void JVM_STATS_dump(void) {
+	JVM_STATS_thread_t thread;
+	uint64_t now = __jvm_stats_peek();
+
+	PRINTF("thread   running(ms) scheduled latency avg(us) max(us)\n");
+	for (uint32_t i = 0; i < (uint32_t)JVM_STATS_MAX_THREADS; i++) {
+		if (threads[i].used) {
+			__jvm_stats_convert(&threads[i], &thread, now);
+			PRINTF("%6d%s %11u %9u %11u %7u\n", (int)thread.id, thread.terminated ? "*" : " ",
+					(unsigned int)(thread.running_time / 1000u), (unsigned int)thread.scheduled,
+					(unsigned int)((0u == thread.latency_count) ? 0u : (thread.latency_total / thread.latency_count)),
+					(unsigned int)thread.latency_max);
+		}
+	}
+
+	PRINTF("gc: %u pauses, %u ms\n", (unsigned int)gc.count, (unsigned int)(gc.total_time / 1000u));
+	for (uint32_t i = 0; i < (uint32_t)JVM_STATS_GC_BUCKETS; i++) {
+		if (0u != gc.histogram[i]) {
+			// the last bucket also counts the longer pauses
+			PRINTF("  %8u us%s: %u\n", (unsigned int)(1u << i), (i == ((uint32_t)JVM_STATS_GC_BUCKETS - 1u)) ? "+" : "",
+					(unsigned int)gc.histogram[i]);
+		}
+	}
+	for (uint32_t i = 0; (i < (uint32_t)JVM_STATS_GC_WORST) && (0u != gc.worst[i].duration); i++) {
+		PRINTF("  worst: %u us at %u ms\n", (unsigned int)gc.worst[i].duration, (unsigned int)gc.worst[i].time);
+	}
+}
+
+// -----------------------------------------------------------------------------
+// Internal functions
+// -----------------------------------------------------------------------------
+
+// See the section 'Internal function definitions' for the function documentation
+static uint64_t __jvm_stats_now(void) {
+	uint32_t cycles = JVM_STATS_GET_CYCLES();
+	if (cycles < cycles_last) {
+		cycles_high += (uint64_t)1u << 32;
+	}
+	cycles_last = cycles;
+	return cycles_high | cycles;
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static uint64_t __jvm_stats_peek(void) {
+	uint64_t high = cycles_high;
+	uint32_t cycles = JVM_STATS_GET_CYCLES();
+	if (cycles < cycles_last) {
+		high += (uint64_t)1u << 32;
+	}
+	return high | cycles;
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static uint64_t __jvm_stats_to_us(uint64_t cycles) {
+	uint64_t frequency = JVM_STATS_GET_FREQUENCY();
+	return ((cycles / frequency) * 1000000u) + (((cycles % frequency) * 1000000u) / frequency);
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static jvm_stats_thread_t* __jvm_stats_get_thread(int32_t thread_id, bool create) {
+	jvm_stats_thread_t* entry = NULL;
+	jvm_stats_thread_t* free_entry = NULL;
+	jvm_stats_thread_t* terminated_entry = NULL;
+
+	for (uint32_t i = 0; (i < (uint32_t)JVM_STATS_MAX_THREADS) && (NULL == entry); i++) {
+		jvm_stats_thread_t* e = &threads[i];
+		if (!e->used) {
+			if (NULL == free_entry) {
+				free_entry = e;
+			}
+		}
+		else if (e->id == thread_id) {
+			entry = e;
+		}
+		else if (e->terminated && (NULL == terminated_entry)) {
+			terminated_entry = e;
+		}
+		else {
+			// another thread
+		}
+	}
+
+	if ((NULL == entry) && create) {
+		entry = (NULL != free_entry) ? free_entry : terminated_entry;
+		if (NULL != entry) {
+			(void)memset(entry, 0, sizeof(jvm_stats_thread_t));
+			entry->used = true;
+			entry->id = thread_id;
+		}
+	}
+	return entry;
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static void __jvm_stats_stop_running(uint64_t now) {
+	if (NULL != running) {
+		if (!gc_running) {
+			// during a GC, the running time has been accounted at its start
+			running->running_time += now - running->running_since;
+		}
+		running = NULL;
+	}
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static void __jvm_stats_add_pause(uint32_t duration, int64_t time) {
+	uint32_t bucket = (0u == duration) ? 0u : (31u - (uint32_t)__builtin_clz(duration));
+	if (bucket >= (uint32_t)JVM_STATS_GC_BUCKETS) {
+		bucket = JVM_STATS_GC_BUCKETS - 1;
+	}
+
+	gc.count++;
+	gc.total_time += duration;
+	gc.histogram[bucket]++;
+
+	// insert in the worst pauses, the longest first
+	int32_t i = JVM_STATS_GC_WORST - 1;
+	if (duration > gc.worst[i].duration) {
+		while ((i > 0) && (duration > gc.worst[i - 1].duration)) {
+			gc.worst[i] = gc.worst[i - 1];
+			i--;
+		}
+		gc.worst[i].duration = duration;
+		gc.worst[i].time = time;
+	}
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static void __jvm_stats_convert(const jvm_stats_thread_t* entry, JVM_STATS_thread_t* thread, uint64_t now) {
+	uint64_t running_time = entry->running_time;
+	if ((running == entry) && !gc_running) {
+		// current running period
+		running_time += now - entry->running_since;
+	}
+
+	thread->id = entry->id;
+	thread->terminated = entry->terminated;
+	thread->running_time = __jvm_stats_to_us(running_time);
+	thread->scheduled = entry->scheduled;
+	thread->latency_total = __jvm_stats_to_us(entry->latency_total);
+	thread->latency_count = entry->latency_count;
+	thread->latency_max = (uint32_t)__jvm_stats_to_us(entry->latency_max);
+}
+
+#endif // JVM_STATS_ENABLED
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,195 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Natives of com.nxp.jvmstats.JvmStatsNatives: Java thread CPU accounting
+ * and GC pause statistics polled by the application (see jvm_stats.h).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <sni.h>
+
+#include "jvm_stats.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Values returned by getThreadStats().
+ */
+#define THREAD_STATS_RUNNING_TIME (0)
+#define THREAD_STATS_SCHEDULED (1)
+#define THREAD_STATS_LATENCY_AVERAGE (2)
+#define THREAD_STATS_LATENCY_MAX (3)
+#define THREAD_STATS_COUNT (4)
+
+/*
+ * @brief Values returned by getGcStats().
+ */
+#define GC_STATS_COUNT (0)
+#define GC_STATS_TOTAL_TIME (1)
+#define GC_STATS_MAX_TIME (2)
+#define GC_STATS_VALUES (3)
+
+// -----------------------------------------------------------------------------
+// Java natives
+// -----------------------------------------------------------------------------
+
+#if defined(JVM_STATS_ENABLED) && (JVM_STATS_ENABLED != 0)
+
+/*
+ * @brief Gets the identifiers of the Java threads.
+ *
+ * @return the number of identifiers.
+ */
+jint Java_com_nxp_jvmstats_JvmStatsNatives_getThreadIds(jint* ids) {
+	JVM_STATS_thread_t threads[JVM_STATS_MAX_THREADS];
+	uint32_t count = JVM_STATS_get_threads(threads, JVM_STATS_MAX_THREADS);
+	uint32_t length = (uint32_t)SNI_getArrayLength(ids);
+
+	if (count > length) {
+		count = length;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		ids[i] = threads[i].id;
+	}
+	return (jint)count;
+}
+
+/*
+ * @brief Gets the statistics of a Java thread: running time (us), number of times
+ * scheduled, average and worst ready to running latencies (us).
+ *
+ * @return the number of values, -1 when the thread is unknown.
+ */
+jint Java_com_nxp_jvmstats_JvmStatsNatives_getThreadStats(jint thread_id, jlong* stats) {
+	JVM_STATS_thread_t thread;
+	jint ret = -1;
+
+	if (((uint32_t)SNI_getArrayLength(stats) >= (uint32_t)THREAD_STATS_COUNT) && JVM_STATS_get_thread(thread_id, &thread)) {
+		stats[THREAD_STATS_RUNNING_TIME] = (jlong)thread.running_time;
+		stats[THREAD_STATS_SCHEDULED] = (jlong)thread.scheduled;
+		stats[THREAD_STATS_LATENCY_AVERAGE] = (0u == thread.latency_count) ? 0 : (jlong)(thread.latency_total / thread.latency_count);
+		stats[THREAD_STATS_LATENCY_MAX] = (jlong)thread.latency_max;
+		ret = THREAD_STATS_COUNT;
+	}
+	return ret;
+}
+
+/*
+ * @brief Gets the GC statistics: number of pauses, cumulated and worst pause (us).
+ *
+ * @return the number of values, -1 when the array is too small.
+ */
+jint Java_com_nxp_jvmstats_JvmStatsNatives_getGcStats(jlong* stats) {
+	JVM_STATS_gc_t gc;
+	jint ret = -1;
+
+	if ((uint32_t)SNI_getArrayLength(stats) >= (uint32_t)GC_STATS_VALUES) {
+		JVM_STATS_get_gc(&gc);
+		stats[GC_STATS_COUNT] = (jlong)gc.count;
+		stats[GC_STATS_TOTAL_TIME] = (jlong)gc.total_time;
+		stats[GC_STATS_MAX_TIME] = (jlong)gc.worst[0].duration;
+		ret = GC_STATS_VALUES;
+	}
+	return ret;
+}
+
+/*
+ * @brief Gets the GC pause histogram: the element i counts the pauses from 2^i
+ * to 2^(i+1) microseconds.
+ *
+ * @return the number of buckets.
+ */
+jint Java_com_nxp_jvmstats_JvmStatsNatives_getGcHistogram(jint* buckets) {
+	JVM_STATS_gc_t gc;
+	uint32_t count = (uint32_t)SNI_getArrayLength(buckets);
+
+	JVM_STATS_get_gc(&gc);
+	if (count > (uint32_t)JVM_STATS_GC_BUCKETS) {
+		count = JVM_STATS_GC_BUCKETS;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		buckets[i] = (jint)gc.histogram[i];
+	}
+	return (jint)count;
+}
+
+/*
+ * @brief Gets the worst GC pauses, the longest first: their duration (us) and
+ * their start time (ms, platform time).
+ *
+ * @return the number of pauses.
+ */
+jint Java_com_nxp_jvmstats_JvmStatsNatives_getWorstGcPauses(jlong* durations, jlong* times) {
+	JVM_STATS_gc_t gc;
+	uint32_t max = (uint32_t)SNI_getArrayLength(durations);
+	uint32_t count = 0;
+
+	if ((uint32_t)SNI_getArrayLength(times) < max) {
+		max = (uint32_t)SNI_getArrayLength(times);
+	}
+
+	JVM_STATS_get_gc(&gc);
+	while ((count < max) && (count < (uint32_t)JVM_STATS_GC_WORST) && (0u != gc.worst[count].duration)) {
+		durations[count] = (jlong)gc.worst[count].duration;
+		times[count] = (jlong)gc.worst[count].time;
+		count++;
+	}
+	return (jint)count;
+}
+
+/*
+ * @brief Clears the statistics.
+ */
+void Java_com_nxp_jvmstats_JvmStatsNatives_reset(void) {
+	JVM_STATS_reset();
+}
+
+#else // JVM_STATS_ENABLED
+
+jint Java_com_nxp_jvmstats_JvmStatsNatives_getThreadIds(jint* ids) {
+	(void)ids;
+	return 0;
+}
+
+jint Java_com_nxp_jvmstats_JvmStatsNatives_getThreadStats(jint thread_id, jlong* stats) {
+	(void)thread_id;
+	(void)stats;
+	return -1;
+}
+
+jint Java_com_nxp_jvmstats_JvmStatsNatives_getGcStats(jlong* stats) {
+	(void)stats;
+	return -1;
+}
+
+jint Java_com_nxp_jvmstats_JvmStatsNatives_getGcHistogram(jint* buckets) {
+	(void)buckets;
+	return 0;
+}
+
+jint Java_com_nxp_jvmstats_JvmStatsNatives_getWorstGcPauses(jlong* durations, jlong* times) {
+	(void)durations;
+	(void)times;
+	return 0;
+}
+
+void Java_com_nxp_jvmstats_JvmStatsNatives_reset(void) {
+	// nothing to do
+}
+
+#endif // JVM_STATS_ENABLED
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,275 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Binary trace ring: lock-free recording, RTT drain.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "trace_ring.h"
+
+#if defined(TRACE_RING_ENABLED) && (TRACE_RING_ENABLED != 0)
+
+#include "SEGGER_RTT.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief The reservation word holds the index of the next record (modulo 4096) in
+ * its low bits and the low bits of the time of the last reservation in its high
+ * bits: an elapsed time lower than TIME_MASK cycles (5 ms at 200 MHz) is encoded
+ * as a delta, a longer one as an absolute time.
+ */
+#define INDEX_BITS (12u)
+#define INDEX_MASK ((1u << INDEX_BITS) - 1u)
+#define TIME_MASK (0xFFFFFFFFu >> INDEX_BITS)
+
+#define RECORD_MASK ((uint32_t)TRACE_RING_SIZE - 1u)
+#define SYNC_MASK ((uint32_t)TRACE_RING_SYNC_INTERVAL - 1u)
+
+#if ((TRACE_RING_SIZE & (TRACE_RING_SIZE - 1)) != 0) || (TRACE_RING_SIZE > (1 << 12))
+#error "TRACE_RING_SIZE must be a power of two, 4096 at most"
+#endif
+
+#if ((TRACE_RING_SYNC_INTERVAL & (TRACE_RING_SYNC_INTERVAL - 1)) != 0) || (TRACE_RING_SYNC_INTERVAL > TRACE_RING_SIZE)
+#error "TRACE_RING_SYNC_INTERVAL must be a power of two, TRACE_RING_SIZE at most"
+#endif
+
+// -----------------------------------------------------------------------------
+// Global variables
+// -----------------------------------------------------------------------------
+
+struct TRACE_RING_image TRACE_RING_image;
+
+// -----------------------------------------------------------------------------
+// Private fields
+// -----------------------------------------------------------------------------
+
+static volatile uint32_t ring_state;    // reservation word (see INDEX_BITS)
+static volatile uint32_t ring_last;     // absolute time of a recent reservation
+
+static uint32_t drain_position;         // position of the next record to drain
+static uint32_t drain_lost;             // lost records not reported yet
+static bool drain_started;              // true when the stream header has been sent
+static TRACE_RING_stats_t stats;
+
+/*
+ * @brief A chunk being sent: the chunk header followed by its records.
+ */
+static struct {
+	TRACE_RING_chunk_t chunk;
+	TRACE_RING_record_t records[TRACE_RING_DRAIN_RECORDS];
+} drain_buffer;
+
+static uint8_t rtt_buffer[TRACE_RING_RTT_BUFFER_SIZE];
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Tells whether the records [first, first + count[ include a record whose
+ * index is a multiple of TRACE_RING_SYNC_INTERVAL.
+ */
+static inline bool __trace_ring_crosses_sync(uint32_t first, uint32_t count);
+
+/*
+ * @brief Gets the position of the next record to reserve.
+ *
+ * @return false when a recording is in progress.
+ */
+static bool __trace_ring_get_end(uint32_t* end);
+
+/*
+ * @brief Sends the stream header over RTT.
+ *
+ * @return true when the header has been sent.
+ */
+static bool __trace_ring_send_header(void);
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void TRACE_RING_initialize(void) {
+	TRACE_RING_START_TIMESTAMP();
+
+	TRACE_RING_image.header.magic = TRACE_RING_MAGIC_IMAGE;
+	TRACE_RING_image.header.version = TRACE_RING_VERSION;
+	TRACE_RING_image.header.frequency = TRACE_RING_GET_FREQUENCY();
+	TRACE_RING_image.header.size = TRACE_RING_SIZE;
+	TRACE_RING_image.header.groups = TRACE_RING_MAX_GROUPS;
+}
+
+// See the header file for the function documentation
+void TRACE_RING_set_group_name(uint32_t group, const char* name) {
+	if (group < (uint32_t)TRACE_RING_MAX_GROUPS) {
+		char* dest = TRACE_RING_image.header.names[group];
+		(void)strncpy(dest, name, TRACE_RING_GROUP_NAME_LENGTH - 1);
+		dest[TRACE_RING_GROUP_NAME_LENGTH - 1] = '\0';
+		// send the new name
+		drain_started = false;
+	}
+}
+
+// See the header file for the function documentation
+void TRACE_RING_record(uint32_t kind, uint32_t group, uint32_t event, const uint32_t* values, uint32_t count) {
+	// one record, then one record for each three additional values
+	uint32_t records = 1u + ((count + 1u) / 3u);
+	uint32_t state;
+	uint32_t now;
+	uint32_t last;
+	uint32_t next;
+
+	// Reserve the records. The reservation fails when an interrupt has reserved
+	// records in the meantime: the time is read again and stays ordered with the
+	// previous reservation. The time of a recent reservation is read first: it is
+	// not after the previous reservation.
+	do {
+		last = ring_last;
+		state = ring_state;
+		now = TRACE_RING_GET_TIMESTAMP();
+		next = (now << INDEX_BITS) | ((state + records) & INDEX_MASK);
+	} while (!__atomic_compare_exchange_n(&ring_state, &state, next, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+	ring_last = now;
+
+	uint32_t first = state & INDEX_MASK;
+	TRACE_RING_record_t* record = &TRACE_RING_image.records[first & RECORD_MASK];
+	bool absolute = ((now - last) >= TIME_MASK) || __trace_ring_crosses_sync(first, records);
+
+	record->event.type = (uint8_t)(kind | (count << TRACE_RING_COUNT_SHIFT) | (absolute ? TRACE_RING_FLAG_ABSOLUTE : 0u));
+	record->event.group = (uint8_t)group;
+	record->event.event = (uint16_t)event;
+	record->event.time = absolute ? now : ((now - (state >> INDEX_BITS)) & TIME_MASK);
+	record->event.context = TRACE_RING_GET_CONTEXT();
+	record->event.value = (count > 0u) ? values[0] : 0u;
+
+	uint32_t value = 1u;
+	for (uint32_t r = 1u; r < records; r++) {
+		record = &TRACE_RING_image.records[(first + r) & RECORD_MASK];
+		record->values.type = (uint8_t)TRACE_RING_KIND_VALUES;
+		for (uint32_t v = 0; v < 3u; v++) {
+			record->values.values[v] = (value < count) ? values[value] : 0u;
+			value++;
+		}
+	}
+
+	// the records are written before being counted
+	__atomic_signal_fence(__ATOMIC_RELEASE);
+	(void)__atomic_fetch_add(&TRACE_RING_image.header.committed, records, __ATOMIC_RELAXED);
+}
+
+// See the header file for the function documentation
+void TRACE_RING_drain(void) {
+	bool more = drain_started || __trace_ring_send_header();
+	uint32_t end;
+
+	while (more && __trace_ring_get_end(&end)) {
+		if ((end - drain_position) > (uint32_t)TRACE_RING_SIZE) {
+			// overwritten before being drained
+			drain_lost += end - drain_position - (uint32_t)TRACE_RING_SIZE;
+			drain_position = end - (uint32_t)TRACE_RING_SIZE;
+		}
+
+		uint32_t count = end - drain_position;
+		if (count > (uint32_t)TRACE_RING_DRAIN_RECORDS) {
+			count = TRACE_RING_DRAIN_RECORDS;
+		}
+
+		if (0u == count) {
+			more = false;
+		}
+		else {
+			for (uint32_t r = 0; r < count; r++) {
+				drain_buffer.records[r] = TRACE_RING_image.records[(drain_position + r) & RECORD_MASK];
+			}
+
+			// the records may have been overwritten during the copy: retry from the
+			// new end of the ring
+			uint32_t reserved = end + ((ring_state - end) & INDEX_MASK);
+			if ((reserved - drain_position) <= (uint32_t)TRACE_RING_SIZE) {
+				drain_buffer.chunk.magic = TRACE_RING_MAGIC_CHUNK;
+				drain_buffer.chunk.position = drain_position;
+				drain_buffer.chunk.records = count;
+				drain_buffer.chunk.lost = drain_lost;
+
+				// all or nothing (no block skip mode): retry in the next drain when
+				// the RTT buffer is full
+				uint32_t size = sizeof(TRACE_RING_chunk_t) + (count * sizeof(TRACE_RING_record_t));
+				if (0u == SEGGER_RTT_Write(TRACE_RING_RTT_CHANNEL, &drain_buffer, size)) {
+					more = false;
+				}
+				else {
+					drain_position += count;
+					stats.drained += count;
+					stats.lost += drain_lost;
+					drain_lost = 0;
+				}
+			}
+		}
+	}
+}
+
+// See the header file for the function documentation
+void TRACE_RING_dump(void) {
+	uint32_t end = TRACE_RING_image.header.committed;
+	drain_position = (end > (uint32_t)TRACE_RING_SIZE) ? (end - (uint32_t)TRACE_RING_SIZE) : 0u;
+}
+
+// See the header file for the function documentation
+void TRACE_RING_get_stats(TRACE_RING_stats_t* s) {
+	*s = stats;
+	s->records = TRACE_RING_image.header.committed;
+}
+
+// -----------------------------------------------------------------------------
+// Internal functions
+// -----------------------------------------------------------------------------
+
+// See the section 'Internal function definitions' for the function documentation
+static inline bool __trace_ring_crosses_sync(uint32_t first, uint32_t count) {
+	uint32_t before = (first - 1u) & INDEX_MASK & ~SYNC_MASK;
+	uint32_t after = (first + count - 1u) & INDEX_MASK & ~SYNC_MASK;
+	return before != after;
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static bool __trace_ring_get_end(uint32_t* end) {
+	// the records are counted once written: the count gives the end of the ring
+	// when no recording has been interrupted
+	uint32_t committed = TRACE_RING_image.header.committed;
+	__atomic_signal_fence(__ATOMIC_ACQUIRE);
+	*end = committed;
+	return 0u == ((ring_state ^ committed) & INDEX_MASK);
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static bool __trace_ring_send_header(void) {
+	TRACE_RING_header_t header = TRACE_RING_image.header;
+
+	(void)SEGGER_RTT_ConfigUpBuffer(TRACE_RING_RTT_CHANNEL, "TraceRing", rtt_buffer, sizeof(rtt_buffer), SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+
+	header.magic = TRACE_RING_MAGIC_HEADER;
+	drain_started = 0u != SEGGER_RTT_Write(TRACE_RING_RTT_CHANNEL, &header, sizeof(header));
+	return drain_started;
+}
+
+#endif // TRACE_RING_ENABLED
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,141 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Latency between an interrupt and the task it wakes up.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "wakeup_latency.h"
+
+#if defined(WAKEUP_LATENCY_ENABLED) && (WAKEUP_LATENCY_ENABLED != 0)
+
+#include "fsl_debug_console.h"
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief The latencies of a source, in cycles.
+ */
+typedef struct {
+	uint32_t count;
+	uint32_t min;
+	uint32_t max;
+	uint64_t total;
+} wakeup_latency_source_t;
+
+// -----------------------------------------------------------------------------
+// Global variables
+// -----------------------------------------------------------------------------
+
+struct WAKEUP_LATENCY_state WAKEUP_LATENCY_state;
+
+// -----------------------------------------------------------------------------
+// Private fields
+// -----------------------------------------------------------------------------
+
+static wakeup_latency_source_t sources[WAKEUP_LATENCY_SOURCES];
+
+static const char* const source_names[WAKEUP_LATENCY_SOURCES] = {
+	"vm",
+	"gpu",
+	"graphics",
+	"touch",
+};
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Converts cycles to microseconds.
+ */
+static uint32_t __wakeup_latency_to_us(uint64_t cycles);
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void WAKEUP_LATENCY_initialize(void) {
+	WAKEUP_LATENCY_START_CYCLES();
+	WAKEUP_LATENCY_reset();
+}
+
+// See the header file for the function documentation
+void WAKEUP_LATENCY_reset(void) {
+	(void)memset(sources, 0, sizeof(sources));
+	for (uint32_t i = 0; i < (uint32_t)WAKEUP_LATENCY_SOURCES; i++) {
+		sources[i].min = UINT32_MAX;
+	}
+}
+
+// See the header file for the function documentation
+void WAKEUP_LATENCY_add(WAKEUP_LATENCY_source_t source, uint32_t cycles) {
+	wakeup_latency_source_t* s = &sources[source];
+
+	s->count++;
+	s->total += cycles;
+	if (cycles < s->min) {
+		s->min = cycles;
+	}
+	if (cycles > s->max) {
+		s->max = cycles;
+	}
+}
+
+// See the header file for the function documentation
+void WAKEUP_LATENCY_get_stats(WAKEUP_LATENCY_source_t source, WAKEUP_LATENCY_stats_t* stats) {
+	wakeup_latency_source_t s = sources[source];
+
+	stats->count = s.count;
+	if (0u == s.count) {
+		stats->min = 0;
+		stats->avg = 0;
+		stats->max = 0;
+	}
+	else {
+		stats->min = __wakeup_latency_to_us(s.min);
+		stats->avg = __wakeup_latency_to_us(s.total / s.count);
+		stats->max = __wakeup_latency_to_us(s.max);
+	}
+}
+
+// See the header file for the function documentation
+void WAKEUP_LATENCY_dump(void) {
+	WAKEUP_LATENCY_stats_t stats;
+
+	PRINTF("wakeup      count min(us) avg(us) max(us)\n");
+	for (uint32_t i = 0; i < (uint32_t)WAKEUP_LATENCY_SOURCES; i++) {
+		WAKEUP_LATENCY_get_stats((WAKEUP_LATENCY_source_t)i, &stats);
+		PRINTF("%-8s %8u %7u %7u %7u\n", source_names[i], (unsigned int)stats.count,
+				(unsigned int)stats.min, (unsigned int)stats.avg, (unsigned int)stats.max);
+	}
+}
+
+// -----------------------------------------------------------------------------
+// Internal functions
+// -----------------------------------------------------------------------------
+
+// See the section 'Internal function definitions' for the function documentation
+static uint32_t __wakeup_latency_to_us(uint64_t cycles) {
+	return (uint32_t)((cycles * 1000000u) / WAKEUP_LATENCY_GET_FREQUENCY());
+}
+
+#endif // WAKEUP_LATENCY_ENABLED
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,122 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined CMDBUF_TUNER_H
+#define CMDBUF_TUNER_H
+
+/*
+ * @file
+ * @brief Sizing of the VGLite command buffers from their usage.
+ *
+ * The tuner is fed at each frame with the command buffer usage of the frame
+ * (bytes, flushes forced by a full command buffer, largest command buffer) and
+ * returns the size to apply. It does not access any hardware nor OS service,
+ * so it can be replayed on a host against recorded usage traces.
+ *
+ * - a frame with a forced flush doubles the size (up to the maximum),
+ * - after a number of consecutive frames without forced flush, the size
+ *   shrinks to the peak usage of these frames plus a margin (down to the
+ *   minimum).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include "cmdbuf_tuner_configuration.h"
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Tuner limits.
+ */
+typedef struct {
+	uint32_t min_size;              // smallest size in bytes
+	uint32_t max_size;              // largest size in bytes
+	uint32_t granule;               // sizes are multiples of this value
+	uint32_t headroom_percent;      // margin kept above the peak usage when shrinking
+	uint32_t shrink_hold_frames;    // consecutive frames without forced flush before shrinking
+} cmdbuf_tuner_config_t;
+
+/*
+ * @brief Command buffer usage statistics.
+ */
+typedef struct {
+	uint32_t frames;            // frames reported
+	uint64_t bytes;             // command bytes of all the frames
+	uint32_t max_frame_bytes;   // command bytes of the heaviest frame
+	uint32_t flushes;           // command buffers submitted
+	uint32_t forced_flushes;    // command buffers submitted because they were full
+	uint32_t peak_usage;        // largest command buffer submitted
+	uint32_t grows;             // number of size increases
+	uint32_t shrinks;           // number of size decreases
+	uint32_t size;              // current size
+} cmdbuf_tuner_stats_t;
+
+/*
+ * @brief Tuner state.
+ */
+typedef struct {
+	const cmdbuf_tuner_config_t* config;
+	uint32_t size;
+	uint32_t calm_frames;       // consecutive frames without forced flush
+	uint32_t window_peak;       // peak usage of these frames
+	cmdbuf_tuner_stats_t stats;
+} cmdbuf_tuner_t;
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Initializes the tuner state.
+ *
+ * @param[in] tuner: the tuner state.
+ * @param[in] config: the tuner limits (must stay valid while the tuner is used).
+ * @param[in] size: the current command buffer size.
+ */
+void cmdbuf_tuner_init(cmdbuf_tuner_t* tuner, const cmdbuf_tuner_config_t* config, uint32_t size);
+
+/*
+ * @brief Reports the command buffer usage of a frame.
+ *
+ * @param[in] tuner: the tuner state.
+ * @param[in] bytes: the command bytes submitted during the frame.
+ * @param[in] flushes: the command buffers submitted during the frame.
+ * @param[in] forced_flushes: the command buffers submitted because they were full.
+ * @param[in] peak_usage: the largest command buffer submitted during the frame.
+ *
+ * @return the command buffer size to apply.
+ */
+uint32_t cmdbuf_tuner_on_frame(cmdbuf_tuner_t* tuner, uint32_t bytes, uint32_t flushes, uint32_t forced_flushes, uint32_t peak_usage);
+
+/*
+ * @brief Reports the size actually applied (the allocation of the size returned
+ * by cmdbuf_tuner_on_frame() may fail).
+ *
+ * @param[in] tuner: the tuner state.
+ * @param[in] size: the command buffer size in use.
+ */
+void cmdbuf_tuner_set_size(cmdbuf_tuner_t* tuner, uint32_t size);
+
+/*
+ * @brief Gets the usage statistics.
+ *
+ * @param[in] tuner: the tuner state.
+ * @param[out] stats: the statistics.
+ */
+void cmdbuf_tuner_get_stats(cmdbuf_tuner_t* tuner, cmdbuf_tuner_stats_t* stats);
+
+#endif // !defined CMDBUF_TUNER_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,57 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined CMDBUF_TUNER_CONFIGURATION_H
+#define CMDBUF_TUNER_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Change value to disable/enable the command buffer sizing:
+ * 0: the VGLite command buffers keep the size given at startup (the usage
+ *    statistics are still collected)
+ * 1: the command buffers are resized between frames according to their usage
+ */
+#ifndef CMDBUF_TUNER_ENABLED
+#define CMDBUF_TUNER_ENABLED 0
+#endif
+
+/*
+ * @brief Smallest command buffer size in bytes.
+ */
+#define CMDBUF_TUNER_MIN_SIZE (32 * 1024)
+
+/*
+ * @brief Largest command buffer size in bytes.
+ *
+ * @Warning: each command buffer of the ring is allocated in the VGLite heap,
+ * next to the tesselation buffer.
+ */
+#define CMDBUF_TUNER_MAX_SIZE (192 * 1024)
+
+/*
+ * @brief Command buffer sizes are multiples of this value (in bytes).
+ */
+#define CMDBUF_TUNER_GRANULE (16 * 1024)
+
+/*
+ * @brief Margin (in percent of the peak usage) kept when shrinking.
+ */
+#define CMDBUF_TUNER_HEADROOM_PERCENT (50)
+
+/*
+ * @brief Number of consecutive frames without forced flush before shrinking.
+ */
+#define CMDBUF_TUNER_SHRINK_HOLD_FRAMES (120)
+
+#endif // !defined CMDBUF_TUNER_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
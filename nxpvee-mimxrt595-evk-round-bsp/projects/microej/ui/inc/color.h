@@ -148,13 +148,13 @@ extern "C" {
  */
 #define COLOR_SET_COLOR(alpha, red, green, blue, format) \
 	(uint32_t) ( 0\
-			| (((alpha) & COLOR_ ## format ## _ALPHA_MASK) \
+			| (((uint32_t)(alpha) & COLOR_ ## format ## _ALPHA_MASK) \
 				<< (COLOR_ ## format ## _ALPHA_OFFSET)) \
-			| (((red) & COLOR_ ## format ## _RED_MASK) \
+			| (((uint32_t)(red) & COLOR_ ## format ## _RED_MASK) \
 				<< (COLOR_ ## format ## _RED_OFFSET)) \
-			| (((green) & COLOR_ ## format ## _GREEN_MASK) \
+			| (((uint32_t)(green) & COLOR_ ## format ## _GREEN_MASK) \
 				<< (COLOR_ ## format ## _GREEN_OFFSET)) \
-			| (((blue) & COLOR_ ## format ## _BLUE_MASK) \
+			| (((uint32_t)(blue) & COLOR_ ## format ## _BLUE_MASK) \
 				<< (COLOR_ ## format ## _BLUE_OFFSET)) \
 				)
 
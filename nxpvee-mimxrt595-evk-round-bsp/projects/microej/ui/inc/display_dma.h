@@ -52,6 +52,13 @@ void DISPLAY_DMA_initialize(const framebuffer_t * framebuffers[]);
  */
 void DISPLAY_DMA_start(framebuffer_t *src, framebuffer_t *dst, int ymin, int ymax);
 
+/*
+ * @brief: Gets the number of bytes copied by a DMA transfer
+ *
+ * @return the number of bytes
+ */
+uint32_t DISPLAY_DMA_get_transfer_size(void);
+
 // -----------------------------------------------------------------------------
 // EOF
 // -----------------------------------------------------------------------------
@@ -72,6 +72,13 @@ void DISPLAY_IMPL_initialized(void);
  */
 void DISPLAY_IMPL_error(bool critical, const char* format, ...);
 
+/*
+ * @brief Notifies a drawing has been accepted by LLUI_DISPLAY_requestDrawing()
+ * and is about to be performed. Called by the MicroUI task for every drawing:
+ * the implementation must be short.
+ */
+void DISPLAY_IMPL_notify_drawing(void);
+
 /*
  * @brief Notifies the GPU will be used just after this call. The implementation
  * must ensure the GPU can be used (power management, clocks, etc.).
@@ -0,0 +1,243 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined DISPLAY_LIST_H
+#define DISPLAY_LIST_H
+
+/*
+ * @file
+ * @brief Display list of a frame: compact binary record of the drawings.
+ *
+ * The painters (LLUI_PAINTER_impl.c, LLDW_PAINTER_impl.c, LLVG_PATH_PAINTER_vglite.c,
+ * LLVG_FONT_PAINTER_freetype_vglite.c, LLVG_FONT_PAINTER_freetype_bitmap.c,
+ * LLVG_BVI_impl.c and vg_blob_natives.c) record each accepted drawing with its
+ * destination, its clip, its color and its arguments. The content of the MicroVG
+ * arrays (path data, gradients, matrices, strings) is recorded as a hash and the
+ * images as their buffer address (not their content).
+ *
+ * The display list is a diagnostic: it only observes the drawings, each frame is
+ * rendered and flushed as usual. A frame is not skipped when its display list is
+ * the same as the previous one, because two identical display lists do not prove
+ * identical pixels:
+ * - the strings drawn by the Graphics Engine itself are not recorded;
+ * - an image may have been modified at the same address;
+ * - the drawings that blend (anti-aliased edges, images, translucent colors) give
+ * another result when drawn again over the same back buffer.
+ *
+ * The dumps (DISPLAY_LIST_dump()) show the frames whose records are repeated (the
+ * frame hash is a hint, the records are compared offline): they are the frames the
+ * application can avoid to render.
+ *
+ * The display lists can be dumped over RTT (see DISPLAY_LIST_dump()) and parsed
+ * offline with DISPLAY_LIST_parse(), which does not access any hardware nor OS
+ * service.
+ *
+ * Dump format (little endian), for each frame: a DISPLAY_LIST_frame_t header
+ * followed by its records. Each record is a DISPLAY_LIST_record_t header followed
+ * by its 32-bit arguments.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <LLUI_DISPLAY.h>
+#include <sni.h>
+
+#include "display_list_configuration.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Identifies the beginning of a frame in a dump: "DLST".
+ */
+#define DISPLAY_LIST_MAGIC (0x54534C44u)
+
+/*
+ * @brief Frame flags.
+ */
+#define DISPLAY_LIST_FLAG_TRUNCATED (1u << 0) // some records did not fit in the buffer
+#define DISPLAY_LIST_FLAG_FOREIGN (1u << 1)   // some drawings were not done in the back buffer
+
+/*
+ * @brief Identifiers of the MicroVG drawings. The MicroUI and Drawing drawings use
+ * the identifiers of their LOG_DRAW events (1 to 19 and 100 to 204).
+ */
+#define DISPLAY_LIST_OP_VG_PATH (300)
+#define DISPLAY_LIST_OP_VG_GRADIENT (301)
+#define DISPLAY_LIST_OP_VG_STRING (302)
+#define DISPLAY_LIST_OP_VG_STRING_GRADIENT (303)
+#define DISPLAY_LIST_OP_VG_STRING_ON_CIRCLE (304)
+#define DISPLAY_LIST_OP_VG_STRING_ON_CIRCLE_GRADIENT (305)
+#define DISPLAY_LIST_OP_VG_COMPILED_IMAGE (306)
+#define DISPLAY_LIST_OP_VG_BUFFERED_IMAGE (307)
+#define DISPLAY_LIST_OP_VG_BUFFERED_IMAGE_CLEAR (308)
+#define DISPLAY_LIST_OP_VG_BITMAP_STRING (309)
+
+#if defined(DISPLAY_LIST_ENABLED) && (DISPLAY_LIST_ENABLED != 0)
+
+/*
+ * @brief Records a drawing. The arguments are a list of 32-bit values.
+ */
+#define DISPLAY_LIST_RECORD(op, gc, ...) \
+	do { \
+		const int32_t display_list_args[] = { __VA_ARGS__ }; \
+		DISPLAY_LIST_record((uint16_t)(op), (gc), display_list_args, sizeof(display_list_args) / sizeof(int32_t)); \
+	} while (false)
+
+#else
+
+#define DISPLAY_LIST_RECORD(op, gc, ...) ((void)0)
+
+#endif // DISPLAY_LIST_ENABLED
+
+/*
+ * @brief Arguments that describe a MicroUI image: buffer address, size and format
+ * (the content of the image is not recorded).
+ */
+#define DISPLAY_LIST_IMAGE(img) \
+	(int32_t)(uintptr_t)LLUI_DISPLAY_getBufferAddress(img), (int32_t)(img)->width, (int32_t)(img)->height, (int32_t)(img)->format
+
+/*
+ * @brief Argument that describes the content of a Java array (0 for a null array).
+ */
+#define DISPLAY_LIST_ARRAY(a) \
+	(int32_t)(((a) == NULL) ? 0u : DISPLAY_LIST_hash((a), (uint32_t)SNI_getArrayLength(a) * sizeof(*(a))))
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Header of a recorded drawing.
+ */
+typedef struct {
+	uint16_t op;        // drawing identifier
+	uint16_t size;      // size in bytes of the record (header and arguments)
+	uint32_t target;    // address of the destination buffer
+	int16_t clip_x1;    // clip of the graphics context
+	int16_t clip_y1;
+	int16_t clip_x2;
+	int16_t clip_y2;
+	uint32_t color;     // foreground color of the graphics context
+} DISPLAY_LIST_record_t;
+
+/*
+ * @brief Header of a frame in a dump.
+ */
+typedef struct {
+	uint32_t magic;     // DISPLAY_LIST_MAGIC
+	uint32_t frame;     // frame number
+	uint32_t hash;      // hash of all the records of the frame
+	uint32_t records;   // number of records of the frame
+	uint32_t size;      // size in bytes of the records that follow
+	uint32_t flags;     // DISPLAY_LIST_FLAG_*
+} DISPLAY_LIST_frame_t;
+
+/*
+ * @brief Display list statistics.
+ */
+typedef struct {
+	uint32_t frames;            // frames recorded
+	uint32_t truncated_frames;  // frames whose records did not fit in the buffer
+	uint32_t dumped_frames;     // frames dumped over RTT
+	uint32_t max_records;       // largest number of records in a frame
+	uint32_t max_size;          // largest display list in bytes
+} DISPLAY_LIST_stats_t;
+
+/*
+ * @brief Functions called by DISPLAY_LIST_parse().
+ */
+typedef struct {
+	void (*on_frame)(const DISPLAY_LIST_frame_t* frame, void* user);
+	void (*on_record)(const DISPLAY_LIST_record_t* record, const int32_t* args, uint32_t count, void* user);
+} DISPLAY_LIST_visitor_t;
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Starts the recording of a frame.
+ *
+ * @param[in] back_buffer: the buffer where the frame is drawn.
+ */
+void DISPLAY_LIST_start_frame(const uint8_t* back_buffer);
+
+/*
+ * @brief Records a drawing (use DISPLAY_LIST_RECORD()).
+ *
+ * @param[in] op: the drawing identifier.
+ * @param[in] gc: the graphics context of the drawing.
+ * @param[in] args: the arguments of the drawing.
+ * @param[in] count: the number of arguments.
+ */
+void DISPLAY_LIST_record(uint16_t op, MICROUI_GraphicsContext* gc, const int32_t* args, uint32_t count);
+
+/*
+ * @brief Ends the recording of a frame and dumps it when requested. The frame is
+ * flushed as usual.
+ */
+void DISPLAY_LIST_end_frame(void);
+
+/*
+ * @brief Requests to dump the display lists of the next frames over RTT (only when
+ * DISPLAY_LIST_DUMP_ENABLED is set).
+ *
+ * @param[in] frames: the number of frames to dump.
+ */
+void DISPLAY_LIST_dump(uint32_t frames);
+
+/*
+ * @brief Gets the display list statistics.
+ *
+ * @param[out] stats: the statistics.
+ */
+void DISPLAY_LIST_get_stats(DISPLAY_LIST_stats_t* stats);
+
+/*
+ * @brief Parses dumped display lists.
+ *
+ * @param[in] data: the dumped data (32-bit aligned).
+ * @param[in] size: the size in bytes of the dumped data.
+ * @param[in] visitor: the functions called for each frame and each record.
+ * @param[in] user: the user data given to the visitor.
+ *
+ * @return the number of bytes parsed (the complete frames).
+ */
+uint32_t DISPLAY_LIST_parse(const uint8_t* data, uint32_t size, const DISPLAY_LIST_visitor_t* visitor, void* user);
+
+/*
+ * @brief Computes the hash (FNV-1a) of a memory area.
+ *
+ * @param[in] data: the memory area.
+ * @param[in] size: the size in bytes of the memory area.
+ *
+ * @return the hash.
+ */
+uint32_t DISPLAY_LIST_hash(const void* data, uint32_t size);
+
+/*
+ * @brief Gets the bits of a float argument.
+ */
+static inline int32_t DISPLAY_LIST_float(float value) {
+	int32_t bits;
+	(void)memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+#endif // !defined DISPLAY_LIST_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
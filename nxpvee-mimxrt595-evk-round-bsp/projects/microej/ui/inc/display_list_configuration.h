@@ -0,0 +1,55 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined DISPLAY_LIST_CONFIGURATION_H
+#define DISPLAY_LIST_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Set to 1 to record the display list of each frame (see display_list.h).
+ */
+#ifndef DISPLAY_LIST_ENABLED
+#define DISPLAY_LIST_ENABLED 0
+#endif
+
+/*
+ * @brief Size in bytes of the buffer that holds the display list of a frame.
+ * The records that do not fit are only hashed (the dump of the frame is
+ * truncated).
+ */
+#ifndef DISPLAY_LIST_BUFFER_SIZE
+#define DISPLAY_LIST_BUFFER_SIZE (8 * 1024)
+#endif
+
+/*
+ * @brief Set to 1 to allow to dump the display lists over RTT (see
+ * DISPLAY_LIST_dump()).
+ */
+#ifndef DISPLAY_LIST_DUMP_ENABLED
+#define DISPLAY_LIST_DUMP_ENABLED 0
+#endif
+
+/*
+ * @brief RTT up channel used to dump the display lists (the channel 0 is the
+ * terminal and the channel 1 is used by SystemView).
+ */
+#define DISPLAY_LIST_DUMP_RTT_CHANNEL (2)
+
+/*
+ * @brief Size in bytes of the RTT up buffer. A frame is dumped only when the
+ * whole frame fits in the free space of the buffer.
+ */
+#define DISPLAY_LIST_DUMP_RTT_BUFFER_SIZE (16 * 1024)
+
+#endif // !defined DISPLAY_LIST_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
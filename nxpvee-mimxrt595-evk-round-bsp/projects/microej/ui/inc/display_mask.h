@@ -0,0 +1,121 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined DISPLAY_MASK_H
+#define DISPLAY_MASK_H
+
+/*
+ * @file
+ * @brief Visible area of the round display.
+ *
+ * The display is a circle inscribed in the square frame buffer: the pixels in the
+ * corners are never visible. The visible area is described by a table that gives
+ * the first and the last visible pixels of each row. The table is computed from
+ * the display geometry (see display_mask_configuration.h) and includes all the
+ * pixels touched by the circle.
+ *
+ * The table is used to:
+ * - cull the drawings fully outside the visible area and narrow the scissor to the
+ *   visible part of the clip (drawing_vglite.c and LLVG_vglite.c),
+ * - only copy the visible pixels when the back buffer is restored (display_dma.c).
+ *
+ * The table does not depend on any hardware nor OS service and can be checked on
+ * a workstation against the mask of the front panel.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "display_mask_configuration.h"
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Visible pixels of a row (none when xmin > xmax).
+ */
+typedef struct {
+	int16_t xmin;   // first visible pixel
+	int16_t xmax;   // last visible pixel
+} DISPLAY_MASK_span_t;
+
+/*
+ * @brief Display mask statistics.
+ */
+typedef struct {
+	uint32_t culled;            // rectangles fully outside the visible area
+	uint32_t frames;            // frames flushed
+	uint64_t bytes;             // bytes moved by all the flushes
+	uint32_t last_frame_bytes;  // bytes moved by the last flush
+	uint32_t max_frame_bytes;   // largest number of bytes moved by a flush
+} DISPLAY_MASK_stats_t;
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Computes the visible pixels of each row from the display geometry.
+ */
+void DISPLAY_MASK_initialize(void);
+
+/*
+ * @brief Gets the visible pixels of a row.
+ *
+ * @param[in] y: the row, between 0 and FRAME_BUFFER_HEIGHT - 1.
+ *
+ * @return the visible pixels of the row.
+ */
+DISPLAY_MASK_span_t DISPLAY_MASK_get_span(int32_t y);
+
+/*
+ * @brief Narrows a rectangle to the bounding box of its visible part.
+ *
+ * @param[in,out] x1: the left pixel of the rectangle.
+ * @param[in,out] y1: the top pixel of the rectangle.
+ * @param[in,out] x2: the right pixel of the rectangle.
+ * @param[in,out] y2: the bottom pixel of the rectangle.
+ *
+ * @return false when the rectangle is fully outside the visible area (the
+ * rectangle is not modified).
+ */
+bool DISPLAY_MASK_clip(int* x1, int* y1, int* x2, int* y2);
+
+/*
+ * @brief Tells whether a buffer is one of the frame buffers.
+ *
+ * @param[in] buffer: the buffer address.
+ *
+ * @return true when the buffer is displayed.
+ */
+bool DISPLAY_MASK_is_display(const void* buffer);
+
+/*
+ * @brief Counts the bytes moved by a flush (transfer to the display and restore
+ * of the back buffer).
+ *
+ * @param[in] bytes: the number of bytes moved.
+ */
+void DISPLAY_MASK_notify_flush(uint32_t bytes);
+
+/*
+ * @brief Gets the display mask statistics.
+ *
+ * @param[out] stats: the statistics.
+ */
+void DISPLAY_MASK_get_stats(DISPLAY_MASK_stats_t* stats);
+
+#endif // !defined DISPLAY_MASK_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,65 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined DISPLAY_MASK_CONFIGURATION_H
+#define DISPLAY_MASK_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include "display_configuration.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Set to 1 to skip the pixels outside the round display: the drawings
+ * fully outside are culled, the scissor is narrowed to the visible area and the
+ * back buffer restore only copies the visible pixels (see display_mask.h).
+ *
+ * RAM cost: the back buffer restore uses one DMA descriptor per row in each
+ * direction, 2 x 392 descriptors of 16 bytes (about 12.5 KB, instead of about
+ * 2.5 KB without the mask), plus the table of the rows (392 x 4 bytes).
+ */
+#ifndef DISPLAY_MASK_ENABLED
+#define DISPLAY_MASK_ENABLED 1
+#endif
+
+/*
+ * @brief Center of the visible circle, in pixels from the top-left corner of the
+ * frame buffer.
+ */
+#ifndef DISPLAY_MASK_CENTER_X
+#define DISPLAY_MASK_CENTER_X (FRAME_BUFFER_WIDTH / 2.0f)
+#endif
+#ifndef DISPLAY_MASK_CENTER_Y
+#define DISPLAY_MASK_CENTER_Y (FRAME_BUFFER_HEIGHT / 2.0f)
+#endif
+
+/*
+ * @brief Radius of the visible circle, in pixels.
+ */
+#ifndef DISPLAY_MASK_RADIUS
+#define DISPLAY_MASK_RADIUS (FRAME_BUFFER_WIDTH / 2.0f)
+#endif
+
+/*
+ * @brief Number of pixels kept visible on both sides of each row, outside the
+ * circle. The rows already include all the pixels touched by the circle (this
+ * matches the mask of the front panel, mask_392.png).
+ */
+#ifndef DISPLAY_MASK_MARGIN
+#define DISPLAY_MASK_MARGIN (0)
+#endif
+
+#endif // !defined DISPLAY_MASK_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -26,6 +26,73 @@ extern "C" {
 #include <LLUI_PAINTER_impl.h>
 
 #include "vglite_window.h"
+#include "cmdbuf_tuner.h"
+#include "tess_tuner.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief MicroUI custom formats of the indexed images (drawn by the GPU with a
+ * CLUT).
+ *
+ * Image data layout:
+ * - the palette: (1 << bpp) ARGB8888 colors (unused entries are transparent),
+ * padded to DISPLAY_VGLITE_CLUT_ALIGNMENT bytes,
+ * - the indexes: DISPLAY_VGLITE_INDEXED_STRIDE() bytes per line, the first pixel
+ * of a byte in its least significant bits.
+ */
+#define DISPLAY_VGLITE_IMAGE_FORMAT_INDEX2	(MICROUI_IMAGE_FORMAT_CUSTOM_0)
+#define DISPLAY_VGLITE_IMAGE_FORMAT_INDEX4	(MICROUI_IMAGE_FORMAT_CUSTOM_1)
+#define DISPLAY_VGLITE_IMAGE_FORMAT_INDEX8	(MICROUI_IMAGE_FORMAT_CUSTOM_2)
+
+/*
+ * @brief Alignment of the indexes after the palette (VGLite source buffer alignment)
+ */
+#define DISPLAY_VGLITE_CLUT_ALIGNMENT		(64u)
+
+/*
+ * @brief Size in bytes of the palette area of an indexed image
+ */
+#define DISPLAY_VGLITE_CLUT_SIZE(bpp)		((((4u << (bpp)) + DISPLAY_VGLITE_CLUT_ALIGNMENT - 1u) / DISPLAY_VGLITE_CLUT_ALIGNMENT) * DISPLAY_VGLITE_CLUT_ALIGNMENT)
+
+/*
+ * @brief Line size in bytes of an indexed image: 16 pixels, and at least 8 bytes
+ */
+#define DISPLAY_VGLITE_INDEXED_STRIDE(width, bpp)	((((((((uint32_t)(width)) + 15u) & ~15u) * (bpp)) / 8u) + 7u) & ~7u)
+
+/*
+ * @brief MicroUI custom formats of the premultiplied images (the color channels
+ * are already multiplied by the alpha, see common/scripts/vglite_image.py).
+ *
+ * The GCNanoLite-V reads the image pixels as premultiplied: these images are
+ * blitted by the GPU without conversion and blended by the CPU without division,
+ * whereas the transparent ARGB images are drawn by the CPU (see
+ * VGLITE_USE_GPU_FOR_TRANSPARENT_IMAGES).
+ *
+ * Image data layout: the pixels in the byte order of the MicroUI formats ARGB8888,
+ * ARGB4444 and ARGB1555 (little endian), DISPLAY_VGLITE_PREMULTIPLIED_STRIDE()
+ * bytes per line.
+ *
+ * MICROUI_IMAGE_FORMAT_CUSTOM_4 is the format of the buffered vector images
+ * (LLVG_BVI_impl.c).
+ */
+#define DISPLAY_VGLITE_IMAGE_FORMAT_ARGB8888_PRE	(MICROUI_IMAGE_FORMAT_CUSTOM_3)
+#define DISPLAY_VGLITE_IMAGE_FORMAT_ARGB4444_PRE	(MICROUI_IMAGE_FORMAT_CUSTOM_5)
+#define DISPLAY_VGLITE_IMAGE_FORMAT_ARGB1555_PRE	(MICROUI_IMAGE_FORMAT_CUSTOM_6)
+
+/*
+ * @brief Line size in bytes of a premultiplied image: 16 pixels (same alignment
+ * as the images of the image generator)
+ */
+#define DISPLAY_VGLITE_PREMULTIPLIED_STRIDE(width, bpp)	((((((uint32_t)(width)) + 15u) & ~15u) * (bpp)) / 8u)
+
+/*
+ * @brief Factor of DISPLAY_VGLITE_scale_premultiplied() for an alpha: 0..255 -> 0..256
+ * (the scaled channels never exceed the alpha)
+ */
+#define DISPLAY_VGLITE_ALPHA_FACTOR(alpha)	(((uint32_t)(alpha)) + (((uint32_t)(alpha)) >> 7))
 
 // -----------------------------------------------------------------------------
 // API
@@ -40,6 +107,28 @@ extern "C" {
  */
 void DISPLAY_VGLITE_start_operation(bool wakeup_graphics_engine);
 
+/*
+ * @brief Reports the end of a frame: collects the command buffer usage of the
+ * frame and, when CMDBUF_TUNER_ENABLED is set, resizes the command buffers.
+ *
+ * Must be called by the Graphics Engine between two frames.
+ */
+void DISPLAY_VGLITE_frame_done(void);
+
+/*
+ * @brief Gets the command buffer usage statistics.
+ *
+ * @param[out] stats: the statistics.
+ */
+void DISPLAY_VGLITE_get_command_buffer_stats(cmdbuf_tuner_stats_t* stats);
+
+/*
+ * @brief Gets the tessellation window usage statistics.
+ *
+ * @param[out] stats: the statistics.
+ */
+void DISPLAY_VGLITE_get_tessellation_stats(tess_tuner_stats_t* stats);
+
 /*
  * @brief Enables hardware rendering
  * @see VGLITE_OPTION_TOGGLE_GPU
@@ -107,6 +196,86 @@ vg_lite_buffer_t* DISPLAY_VGLITE_configure_destination(MICROUI_GraphicsContext*
  */
 bool DISPLAY_VGLITE_configure_source(vg_lite_buffer_t *buffer, MICROUI_Image* image);
 
+/*
+ * @brief Gets the bits per pixel of an indexed image.
+ *
+ * @param[in] image: the image
+ *
+ * @return 2, 4 or 8 for an indexed image, 0 otherwise
+ */
+uint32_t DISPLAY_VGLITE_get_indexed_bpp(MICROUI_Image* image);
+
+/*
+ * @brief Gets the palette of an indexed image ((1 << bpp) ARGB8888 colors).
+ *
+ * @param[in] image: the indexed image
+ *
+ * @return the palette address
+ */
+uint32_t* DISPLAY_VGLITE_get_clut(MICROUI_Image* image);
+
+/*
+ * @brief Gets the first line of indexes of an indexed image.
+ *
+ * @param[in] image: the indexed image
+ *
+ * @return the indexes address
+ */
+uint8_t* DISPLAY_VGLITE_get_indexes(MICROUI_Image* image);
+
+/*
+ * @brief Reads a pixel of an indexed image.
+ *
+ * @param[in] image: the indexed image
+ * @param[in] x: the pixel column
+ * @param[in] y: the pixel line
+ *
+ * @return the ARGB8888 palette color of the pixel
+ */
+uint32_t DISPLAY_VGLITE_read_indexed_pixel(MICROUI_Image* image, uint32_t x, uint32_t y);
+
+/*
+ * @brief Gets the bits per pixel of a premultiplied image.
+ *
+ * @param[in] image: the image
+ *
+ * @return 32 or 16 for a premultiplied image, 0 otherwise
+ */
+uint32_t DISPLAY_VGLITE_get_premultiplied_bpp(MICROUI_Image* image);
+
+/*
+ * @brief Reads a pixel of a premultiplied image.
+ *
+ * @param[in] image: the premultiplied image
+ * @param[in] x: the pixel column
+ * @param[in] y: the pixel line
+ *
+ * @return the premultiplied ARGB8888 color (no channel greater than the alpha)
+ */
+uint32_t DISPLAY_VGLITE_read_premultiplied_pixel(MICROUI_Image* image, uint32_t x, uint32_t y);
+
+/*
+ * @brief Multiplies the four channels of a premultiplied color by a factor (global
+ * alpha of a drawing): two channels per multiplication, no division.
+ *
+ * @param[in] color: the premultiplied ARGB8888 color
+ * @param[in] factor: the factor, from 0 to 256 (identity), see DISPLAY_VGLITE_ALPHA_FACTOR()
+ *
+ * @return the scaled color
+ */
+uint32_t DISPLAY_VGLITE_scale_premultiplied(uint32_t color, uint32_t factor);
+
+/*
+ * @brief Blends a premultiplied color on a background: source + background *
+ * (1 - source alpha), no division.
+ *
+ * @param[in] color: the premultiplied ARGB8888 color
+ * @param[in] background: the ARGB8888 background color
+ *
+ * @return the blended color
+ */
+uint32_t DISPLAY_VGLITE_blend_premultiplied(uint32_t color, uint32_t background);
+
 /*
  * @brief RT595 Porter-Duff operators seems to not be functional
  * When using transparency, the colors passed to the RT595
@@ -0,0 +1,183 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined INPUT_LOG_H
+#define INPUT_LOG_H
+
+/*
+ * @file
+ * @brief Input log: timeline of the MicroUI FIFO in a lock-free ring.
+ *
+ * The MicroUI FIFO logger (LLUI_INPUT_LOG_impl.c) records each element added to
+ * the FIFO, replaced, read by the application and each event lost because the
+ * FIFO is full. A record holds the time in microseconds, the element and its
+ * index in the FIFO. The record of the first element of an event and the record
+ * of a replaced element also hold the time when the input has been sampled
+ * (INPUT_LOG_set_source_time(), called by the touch helper before sending the
+ * event).
+ *
+ * The ring has a single producer and a single consumer, with no lock and no
+ * interrupt masking:
+ * - the producer is the MicroUI input engine: it calls the logger in its critical
+ *   section (LLUI_INPUT_IMPL_enterCriticalSection()), so the tasks and the
+ *   interrupt handlers that send events are serialized;
+ * - the consumer is INPUT_LOG_drain() (called in the FreeRTOS idle hook when
+ *   INPUT_LOG_DRAIN_ON_IDLE is set) or INPUT_LOG_read().
+ * The records are not overwritten: when the ring is full, the new records are
+ * dropped and counted. The producer also keeps the peak occupancy of the ring.
+ *
+ * Save the channel INPUT_LOG_RTT_CHANNEL with the J-Link RTT Logger;
+ * projects/common/scripts/input_log.py prints the timeline of the events and the
+ * input latencies.
+ *
+ * RTT stream format (little endian): an INPUT_LOG_header_t, then chunks: an
+ * INPUT_LOG_chunk_t followed by its records.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "input_log_configuration.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Magic numbers: "ILGH" and "ILGC".
+ */
+#define INPUT_LOG_MAGIC_HEADER (0x48474C49u)
+#define INPUT_LOG_MAGIC_CHUNK (0x43474C49u)
+
+#define INPUT_LOG_VERSION (1u)
+
+/*
+ * @brief Kinds of record.
+ */
+#define INPUT_LOG_KIND_INIT (0u)    // FIFO initialized (data: FIFO length)
+#define INPUT_LOG_KIND_EVENT (1u)   // first element of an event added
+#define INPUT_LOG_KIND_DATA (2u)    // next element of an event added
+#define INPUT_LOG_KIND_REPLACE (3u) // element replaced by a newer one
+#define INPUT_LOG_KIND_READ (4u)    // element read by the application
+#define INPUT_LOG_KIND_FULL (5u)    // FIFO full: event lost
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief A 16-byte record.
+ */
+typedef struct {
+	uint32_t time;      // time in microseconds
+	uint32_t data;      // FIFO element
+	uint32_t source;    // EVENT and REPLACE: sample time of the input (0 if unknown)
+	uint16_t index;     // index of the element in the FIFO
+	uint8_t kind;       // INPUT_LOG_KIND_*
+	uint8_t remaining;  // EVENT and DATA: number of elements of the event that follow (255 at most)
+} INPUT_LOG_record_t;
+
+/*
+ * @brief Header of the RTT stream.
+ */
+typedef struct {
+	uint32_t magic;     // INPUT_LOG_MAGIC_HEADER
+	uint32_t version;   // INPUT_LOG_VERSION
+	uint32_t size;      // number of records of the ring
+	uint32_t record;    // size of a record in bytes
+} INPUT_LOG_header_t;
+
+/*
+ * @brief Header of a chunk of records in the RTT stream.
+ */
+typedef struct {
+	uint32_t magic;     // INPUT_LOG_MAGIC_CHUNK
+	uint32_t position;  // position of the first record since the start
+	uint32_t records;   // number of records that follow
+	uint32_t dropped;   // records dropped since the start
+} INPUT_LOG_chunk_t;
+
+/*
+ * @brief Input log statistics.
+ */
+typedef struct {
+	uint32_t logged;    // records written
+	uint32_t dropped;   // records dropped (ring full)
+	uint32_t peak;      // peak number of records in the ring
+	uint32_t drained;   // records read or sent over RTT
+	uint32_t lost;      // events lost by MicroUI (FIFO full)
+} INPUT_LOG_stats_t;
+
+// -----------------------------------------------------------------------------
+// Global variables
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief The sample time set by INPUT_LOG_set_source_time().
+ */
+extern volatile uint32_t INPUT_LOG_source_time;
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Sets the sample time of the next input event: the time when the driver
+ * has sampled the input (e.g. touch interrupt). It is recorded with the next event
+ * added to the FIFO or the next element replaced.
+ *
+ * @param[in] time: the sample time in microseconds (INPUT_LOG_GET_TIME_US() time base).
+ */
+static inline void INPUT_LOG_set_source_time(uint32_t time) {
+#if defined(INPUT_LOG_ENABLED) && (INPUT_LOG_ENABLED != 0)
+	INPUT_LOG_source_time = time;
+#else
+	(void)time;
+#endif
+}
+
+/*
+ * @brief Records an operation on the FIFO. Called by the producer only.
+ *
+ * @param[in] kind: the kind of record (INPUT_LOG_KIND_*).
+ * @param[in] data: the FIFO element.
+ * @param[in] index: the index of the element in the FIFO.
+ * @param[in] remaining: the number of elements of the event that follow.
+ */
+void INPUT_LOG_record(uint32_t kind, uint32_t data, uint32_t index, uint32_t remaining);
+
+/*
+ * @brief Reads the oldest record. Called by the consumer only.
+ *
+ * @param[out] record: the record.
+ *
+ * @return false when the log is empty.
+ */
+bool INPUT_LOG_read(INPUT_LOG_record_t* record);
+
+/*
+ * @brief Sends the records over RTT, as long as the RTT buffer has room. Called
+ * by the consumer only.
+ */
+void INPUT_LOG_drain(void);
+
+/*
+ * @brief Gets the input log statistics.
+ *
+ * @param[out] stats: the statistics.
+ */
+void INPUT_LOG_get_stats(INPUT_LOG_stats_t* stats);
+
+#endif // !defined INPUT_LOG_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
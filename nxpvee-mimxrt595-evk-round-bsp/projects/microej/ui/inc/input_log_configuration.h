@@ -0,0 +1,73 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined INPUT_LOG_CONFIGURATION_H
+#define INPUT_LOG_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Set to 1 to record the MicroUI FIFO activity in the input log (see
+ * input_log.h).
+ */
+#ifndef INPUT_LOG_ENABLED
+#define INPUT_LOG_ENABLED 1
+#endif
+
+/*
+ * @brief Number of 16-byte records of the ring: a power of two. The records
+ * logged while the ring is full are dropped (and counted).
+ */
+#ifndef INPUT_LOG_SIZE
+#define INPUT_LOG_SIZE (128)
+#endif
+
+/*
+ * @brief Set to 1 to drain the log over RTT in the FreeRTOS idle hook. When set
+ * to 0, call INPUT_LOG_drain() or read the records with INPUT_LOG_read().
+ */
+#ifndef INPUT_LOG_DRAIN_ON_IDLE
+#define INPUT_LOG_DRAIN_ON_IDLE 1
+#endif
+
+/*
+ * @brief Maximum number of records sent in one RTT write.
+ */
+#ifndef INPUT_LOG_DRAIN_RECORDS
+#define INPUT_LOG_DRAIN_RECORDS (16)
+#endif
+
+/*
+ * @brief RTT up channel used to drain the log (the channels 0 to 3 are used by
+ * the terminal, SystemView, the display list dump and the trace ring).
+ */
+#ifndef INPUT_LOG_RTT_CHANNEL
+#define INPUT_LOG_RTT_CHANNEL (4)
+#endif
+
+/*
+ * @brief Size in bytes of the RTT up buffer.
+ */
+#ifndef INPUT_LOG_RTT_BUFFER_SIZE
+#define INPUT_LOG_RTT_BUFFER_SIZE (1024)
+#endif
+
+/*
+ * @brief Time of the records in microseconds (32 low bits).
+ */
+#ifndef INPUT_LOG_GET_TIME_US
+#include "time_hardware_timer.h"
+#define INPUT_LOG_GET_TIME_US() ((uint32_t)time_hardware_timer_getTimeUs())
+#endif
+
+#endif // !defined INPUT_LOG_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
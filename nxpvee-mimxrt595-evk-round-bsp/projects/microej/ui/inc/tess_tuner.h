@@ -0,0 +1,148 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined TESS_TUNER_H
+#define TESS_TUNER_H
+
+/*
+ * @file
+ * @brief Sizing of the VGLite tessellation window from the drawings.
+ *
+ * VGLite tessellates a path once for each tessellation window that covers its
+ * bounding box: a full screen path drawn with a 256x256 window takes four
+ * passes on a 392x392 display. A larger window needs fewer passes but its
+ * buffer (about 8 bytes per pixel) takes more of the VGLite heap.
+ *
+ * The tuner is fed at each frame with the tessellation usage of the frame
+ * (passes, drawings larger than the window, largest bounding box) and returns
+ * the window to apply. It does not access any hardware nor OS service, so it
+ * can be replayed on a host against recorded usage traces.
+ *
+ * - a frame with a drawing larger than the window grows the window to the
+ *   smallest one that covers this drawing within the memory budget (when it
+ *   reduces its number of passes),
+ * - after a number of consecutive frames without drawing larger than the
+ *   window, the window shrinks to the largest drawing of these frames.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include "tess_tuner_configuration.h"
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Tuner limits.
+ */
+typedef struct {
+	uint32_t min_size;              // smallest width and height in pixels
+	uint32_t max_width;             // largest width in pixels
+	uint32_t max_height;            // largest height in pixels
+	uint32_t max_bytes;             // largest tessellation buffer in bytes
+	uint32_t shrink_hold_frames;    // consecutive frames without split drawing before shrinking
+} tess_tuner_config_t;
+
+/*
+ * @brief Tessellation usage statistics.
+ */
+typedef struct {
+	uint32_t frames;            // frames reported
+	uint64_t draws;             // drawings of all the frames
+	uint64_t passes;            // tessellation passes of all the frames
+	uint32_t split_draws;       // drawings larger than the window
+	uint32_t max_passes;        // largest number of passes of a drawing
+	uint32_t grows;             // number of window increases
+	uint32_t shrinks;           // number of window decreases
+	uint32_t width;             // current window
+	uint32_t height;
+	uint32_t bytes;             // estimated size of the current tessellation buffer
+} tess_tuner_stats_t;
+
+/*
+ * @brief Tuner state.
+ */
+typedef struct {
+	const tess_tuner_config_t* config;
+	uint32_t width;
+	uint32_t height;
+	uint32_t calm_frames;       // consecutive frames without split drawing
+	uint32_t window_width;      // largest drawing of these frames
+	uint32_t window_height;
+	tess_tuner_stats_t stats;
+} tess_tuner_t;
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Initializes the tuner state.
+ *
+ * @param[in] tuner: the tuner state.
+ * @param[in] config: the tuner limits (must stay valid while the tuner is used).
+ * @param[in] width: the current tessellation window width.
+ * @param[in] height: the current tessellation window height.
+ */
+void tess_tuner_init(tess_tuner_t* tuner, const tess_tuner_config_t* config, uint32_t width, uint32_t height);
+
+/*
+ * @brief Reports the tessellation usage of a frame.
+ *
+ * @param[in] tuner: the tuner state.
+ * @param[in] draws: the path drawings of the frame.
+ * @param[in] passes: the tessellation passes of these drawings.
+ * @param[in] split_draws: the drawings that needed more than one pass.
+ * @param[in] max_passes: the largest number of passes of a drawing.
+ * @param[in] max_width: the largest bounding box width of a drawing.
+ * @param[in] max_height: the largest bounding box height of a drawing.
+ * @param[out] width: the tessellation window width to apply.
+ * @param[out] height: the tessellation window height to apply.
+ */
+void tess_tuner_on_frame(tess_tuner_t* tuner, uint32_t draws, uint32_t passes, uint32_t split_draws, uint32_t max_passes,
+		uint32_t max_width, uint32_t max_height, uint32_t* width, uint32_t* height);
+
+/*
+ * @brief Reports the window actually applied (the allocation of the window
+ * returned by tess_tuner_on_frame() may fail).
+ *
+ * @param[in] tuner: the tuner state.
+ * @param[in] width: the tessellation window width in use.
+ * @param[in] height: the tessellation window height in use.
+ */
+void tess_tuner_set_size(tess_tuner_t* tuner, uint32_t width, uint32_t height);
+
+/*
+ * @brief Gets the usage statistics.
+ *
+ * @param[in] tuner: the tuner state.
+ * @param[out] stats: the statistics.
+ */
+void tess_tuner_get_stats(tess_tuner_t* tuner, tess_tuner_stats_t* stats);
+
+/*
+ * @brief Estimates the size of the tessellation buffer of a window (same layout
+ * as the VGLite kernel: 8 bytes per pixel plus a 1/512 cache level, without the
+ * second cache level of the GPU revisions that have one).
+ *
+ * @param[in] width: the window width.
+ * @param[in] height: the window height.
+ *
+ * @return the size in bytes.
+ */
+uint32_t tess_tuner_bytes(uint32_t width, uint32_t height);
+
+#endif // !defined TESS_TUNER_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,65 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined TESS_TUNER_CONFIGURATION_H
+#define TESS_TUNER_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include "display_configuration.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Change value to disable/enable the tessellation window sizing:
+ * 0: the VGLite tessellation window keeps the size given at startup (the
+ *    usage statistics are still collected)
+ * 1: the tessellation window is resized between frames according to the
+ *    bounding boxes of the drawings
+ */
+#ifndef TESS_TUNER_ENABLED
+#define TESS_TUNER_ENABLED 0
+#endif
+
+/*
+ * @brief Smallest tessellation window width and height in pixels.
+ */
+#define TESS_TUNER_MIN_SIZE (64)
+
+/*
+ * @brief Largest tessellation window width and height in pixels: a window as
+ * large as the frame buffer tessellates any drawing in one pass.
+ */
+#define TESS_TUNER_MAX_WIDTH (((FRAME_BUFFER_WIDTH) + 15) & ~15)
+#define TESS_TUNER_MAX_HEIGHT (((FRAME_BUFFER_HEIGHT) + 15) & ~15)
+
+/*
+ * @brief Largest tessellation buffer in bytes (about 8 bytes per pixel of the
+ * window). When the window that covers the largest drawing does not fit, the
+ * window keeps the width of the drawing and the drawing is tessellated by
+ * horizontal bands.
+ *
+ * @Warning: the tessellation buffer is allocated in the VGLite heap, next to
+ * the command buffers.
+ */
+#define TESS_TUNER_MAX_BYTES (512 * 1024)
+
+/*
+ * @brief Number of consecutive frames without drawing larger than the window
+ * before shrinking the window to the largest drawing of these frames.
+ */
+#define TESS_TUNER_SHRINK_HOLD_FRAMES (120)
+
+#endif // !defined TESS_TUNER_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,97 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined TOUCH_FILTER_H
+#define TOUCH_FILTER_H
+
+/*
+ * @file
+ * @brief Touch velocity estimation and position prediction.
+ *
+ * The filter is fed with timestamped touch samples and extrapolates the touch
+ * position to a given time (typically the expected display time of the frame
+ * that will handle the event). It has no hardware nor OS dependency.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Prediction modes.
+ */
+typedef enum {
+	// no prediction: the last sample is returned
+	TOUCH_FILTER_NONE = 0,
+	// last sample extrapolated with a smoothed finite-difference velocity
+	TOUCH_FILTER_LINEAR = 1,
+	// alpha-beta filter (steady-state Kalman filter of a constant velocity model)
+	TOUCH_FILTER_ALPHA_BETA = 2,
+} touch_filter_mode_t;
+
+/*
+ * @brief Filter state.
+ */
+typedef struct {
+	touch_filter_mode_t mode;
+	float velocity_smoothing;   // LINEAR: weight of the new velocity sample (0..1]
+	float alpha;                // ALPHA_BETA: position correction gain
+	float beta;                 // ALPHA_BETA: velocity correction gain
+	int64_t max_horizon_us;     // maximum extrapolation time
+	float x;                    // estimated position (pixels)
+	float y;
+	float vx;                   // estimated velocity (pixels per microsecond)
+	float vy;
+	int64_t t_us;               // timestamp of the last sample
+	uint32_t samples;           // samples since the last reset
+} touch_filter_t;
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Restarts the estimation from a first sample (touch press).
+ *
+ * @param[in] filter: the filter state (tuning fields must be set).
+ * @param[in] x: the sample X coordinate.
+ * @param[in] y: the sample Y coordinate.
+ * @param[in] t_us: the sample timestamp in microseconds.
+ */
+void touch_filter_reset(touch_filter_t* filter, int32_t x, int32_t y, int64_t t_us);
+
+/*
+ * @brief Updates the estimation with a new sample.
+ *
+ * @param[in] filter: the filter state.
+ * @param[in] x: the sample X coordinate.
+ * @param[in] y: the sample Y coordinate.
+ * @param[in] t_us: the sample timestamp in microseconds.
+ */
+void touch_filter_update(touch_filter_t* filter, int32_t x, int32_t y, int64_t t_us);
+
+/*
+ * @brief Predicts the touch position at a given time.
+ *
+ * @param[in] filter: the filter state.
+ * @param[in] t_us: the time to predict the position at, in microseconds.
+ * @param[out] x: the predicted X coordinate.
+ * @param[out] y: the predicted Y coordinate.
+ */
+void touch_filter_predict(const touch_filter_t* filter, int64_t t_us, int32_t* x, int32_t* y);
+
+#endif // !defined TOUCH_FILTER_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
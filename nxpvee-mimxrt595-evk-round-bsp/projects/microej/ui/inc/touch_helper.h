@@ -13,6 +13,23 @@
 // -----------------------------------------------------------------------------
 
 #include <stdint.h>
+#include <stdbool.h>
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Touch-to-flush latency counters: time between the sample of an event
+ * sent to MicroUI and the end of the next display flush.
+ */
+typedef struct {
+	uint32_t samples;           // number of latency measures
+	uint32_t last_us;           // last latency
+	uint32_t average_us;        // moving average of the latency
+	uint32_t max_us;            // maximum latency
+	uint32_t coalesced_moves;   // moves replaced by a newer one before being sent
+} touch_latency_stats_t;
 
 /* API -----------------------------------------------------------------------*/
 
@@ -24,6 +41,16 @@
  */
 void TOUCH_HELPER_pressed(int32_t x, int32_t y);
 
+/*
+ * @brief Notifies to an event handler a touch has been pressed, with the time
+ * the sample has been taken (touch controller interrupt).
+ *
+ * @param x the pointer X coordinate
+ * @param y the pointer Y coordinate
+ * @param timestamp_us the sample time in microseconds (time_hardware_timer_getTimeUs())
+ */
+void TOUCH_HELPER_pressed_at(int32_t x, int32_t y, int64_t timestamp_us);
+
 /*
  * @brief Notifies to an event handler a touch has moved.
  *
@@ -37,6 +64,41 @@ void TOUCH_HELPER_moved(int32_t x, int32_t y);
  */
 void TOUCH_HELPER_released(void);
 
+/*
+ * @brief Notifies that the display has been flushed: closes the latency measure
+ * of the last event sent and sends the pending move (if any).
+ *
+ * Must be called from the same task than the other functions.
+ *
+ * @param timestamp_us the flush time in microseconds (time_hardware_timer_getTimeUs())
+ */
+void TOUCH_HELPER_flushed(int64_t timestamp_us);
+
+/*
+ * @brief Notifies that no flush happened during TOUCH_COALESCING_MAX_HOLD_US
+ * after an event: sends the pending move (if any) without latency measure.
+ *
+ * @param timestamp_us the current time in microseconds (time_hardware_timer_getTimeUs())
+ */
+void TOUCH_HELPER_flush_timeout(int64_t timestamp_us);
+
+/*
+ * @brief Tells whether TOUCH_HELPER_flushed() has something to do.
+ *
+ * May be called from another task (display task): an event is marked as
+ * waiting for a flush before it is sent to MicroUI.
+ *
+ * @return true when an event is waiting for a flush
+ */
+bool TOUCH_HELPER_is_waiting_flush(void);
+
+/*
+ * @brief Gets the touch-to-flush latency counters.
+ *
+ * @param[out] stats the counters
+ */
+void TOUCH_HELPER_get_latency_stats(touch_latency_stats_t* stats);
+
 #endif // !defined TOUCH_HELPER_H
 
 // -----------------------------------------------------------------------------
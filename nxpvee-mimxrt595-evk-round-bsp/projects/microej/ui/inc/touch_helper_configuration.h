@@ -22,6 +22,40 @@
  */
 #define MOVE_PIXEL_LIMIT		2
 
+/*
+ * @brief Set to 1 to coalesce the move events: while a move event has been
+ * sent and no frame has been flushed since, the next moves only update a pending
+ * position, which is sent after the next flush (only the latest position per
+ * frame is delivered).
+ */
+#define TOUCH_COALESCING_ENABLED	1
+
+/*
+ * @brief Maximum time (in microseconds) a pending move waits for a flush. Bounds
+ * the delay of the moves when the application does not redraw on moves.
+ */
+#define TOUCH_COALESCING_MAX_HOLD_US	(50000)
+
+/*
+ * @brief Touch position prediction (see touch_filter.h):
+ * TOUCH_FILTER_NONE, TOUCH_FILTER_LINEAR or TOUCH_FILTER_ALPHA_BETA.
+ * The position sent to MicroUI is extrapolated to the expected display time of
+ * the event (sample time + measured touch-to-flush latency).
+ */
+#define TOUCH_PREDICTION_MODE		TOUCH_FILTER_NONE
+
+/*
+ * @brief Maximum extrapolation time (in microseconds).
+ */
+#define TOUCH_PREDICTION_MAX_US		(40000)
+
+/*
+ * @brief Tuning of the prediction filters.
+ */
+#define TOUCH_PREDICTION_VELOCITY_SMOOTHING	(0.5f)
+#define TOUCH_PREDICTION_ALPHA		(0.85f)
+#define TOUCH_PREDICTION_BETA		(0.75f)
+
 #endif // !defined TOUCH_HELPER_CONFIGURATION_H
 
 // -----------------------------------------------------------------------------
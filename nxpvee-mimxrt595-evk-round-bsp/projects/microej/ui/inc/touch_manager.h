@@ -28,6 +28,12 @@ void TOUCH_MANAGER_initialize(void);
  */
 void TOUCH_MANAGER_interrupt(void);
 
+/*
+ * @brief Notifies the touch manager that a frame has been flushed: held touch
+ * moves are sent and the touch-to-flush latency is measured.
+ */
+void TOUCH_MANAGER_frame_flushed(void);
+
 #endif // !defined TOUCH_MANAGER_H
 
 // -----------------------------------------------------------------------------
@@ -63,6 +63,15 @@ extern "C" {
 		+ 1 * MEJ_VGLITE_PATH_END_LENGTH(t)		/* end command */ \
 	)
 
+/*
+ * @brief Length of a VGLite band between two thick shape lines
+ */
+#define MEJ_VGLITE_PATH_THICK_SHAPE_LINE_BAND_LENGTH(t) \
+	(0 \
+		+ 2 * (MEJ_VGLITE_PATH_THICK_SHAPE_LINE_LENGTH(t) - MEJ_VGLITE_PATH_END_LENGTH(t))	/* 2 outlines */ \
+		+ 1 * MEJ_VGLITE_PATH_END_LENGTH(t)		/* end command */ \
+	)
+
 /*
  * @brief Length of a VGLite ellipse path
  */
@@ -117,6 +126,15 @@ extern "C" {
 		+ 1 * MEJ_VGLITE_PATH_END_LENGTH(t)					/* end command */ \
 	)
 
+/*
+ * @brief Maximum length of a VGLite band between two filled ellipse arcs
+ */
+#define MEJ_VGLITE_PATH_CIRCLE_ARC_BAND_MAX_LENGTH(t) \
+	(0 \
+		+ 2 * (MEJ_VGLITE_PATH_CIRCLE_ARC_MAX_LENGTH(t) - MEJ_VGLITE_PATH_END_LENGTH(t))	/* 2 outlines */ \
+		+ 1 * MEJ_VGLITE_PATH_END_LENGTH(t)					/* end command */ \
+	)
+
 /*
  * @brief Size of a rounded cap: 2 cubic curves
  */
@@ -234,6 +252,11 @@ typedef uint8_t vglite_path_line_t[MEJ_VGLITE_PATH_LINE_LENGTH(s16_t)];
  */
 typedef uint8_t vglite_path_thick_shape_line_t[MEJ_VGLITE_PATH_THICK_SHAPE_LINE_LENGTH(s16_t)];
 
+/*
+ * @brief Fixed array size to store a band between two thick shape lines
+ */
+typedef uint8_t vglite_path_thick_shape_line_band_t[MEJ_VGLITE_PATH_THICK_SHAPE_LINE_BAND_LENGTH(s16_t)];
+
 /*
  * @brief Fixed array size to store a ellipse
  */
@@ -259,6 +282,11 @@ typedef uint8_t vglite_path_rounded_rectangle_t[MEJ_VGLITE_PATH_ROUND_RECT_LENGT
  */
 typedef uint8_t vglite_path_thick_ellipse_arc_t[MEJ_VGLITE_PATH_CIRCLE_ARC_MAX_LENGTH(s16_t)];
 
+/*
+ * @brief Fixed array size to store a band between two thick ellipse arcs
+ */
+typedef uint8_t vglite_path_thick_ellipse_arc_band_t[MEJ_VGLITE_PATH_CIRCLE_ARC_BAND_MAX_LENGTH(s16_t)];
+
 // -----------------------------------------------------------------------------
 // API
 // -----------------------------------------------------------------------------
@@ -323,6 +351,36 @@ int VGLITE_PATH_compute_thick_shape_ellipse_arc(
 		float32_t arc_angle_degree,
 		int caps);
 
+/*
+ * @brief Computes the band between two thick ellipse arcs of the same diameter
+ *
+ * The path holds the outlines of both thick ellipse arcs (see
+ * VGLITE_PATH_compute_thick_shape_ellipse_arc()): it must be filled with the
+ * VG_LITE_FILL_EVEN_ODD rule. With the same caps, the band surrounds the inner arc
+ * on both sides and around the rounded caps.
+ * @param[out] band_shape: vg_lite path to compute
+ * @param[in]: diameter_w: diameter of the ellipse arcs
+ * @param[in]: diameter_h: diameter of the ellipse arcs
+ * @param[in]: thickness_out: thickness of the outer ellipse arc
+ * @param[in]: thickness_in: thickness of the inner ellipse arc (smaller than thickness_out)
+ * @param[in]: start_angle_degree: starting angle of the ellipse arcs in degrees
+ * @param[in]: arc_angle_degree: angle of the ellipse arcs in degrees
+ * @param[in]: caps of the start and end of the ellipse arcs, bits [0:1] contains the starting cap, bits [2:3] contains the ending cap.
+ *
+ * @return:
+ * 	-1: an error occured,
+ * 	otherwise: number of bytes written in the path
+ */
+int VGLITE_PATH_compute_thick_shape_ellipse_arc_band(
+		vg_lite_path_t *band_shape,
+		int diameter_w,
+		int diameter_h,
+		int thickness_out,
+		int thickness_in,
+		float32_t start_angle_degree,
+		float32_t arc_angle_degree,
+		int caps);
+
 /*
  * @brief Computes a ellipse
  *
@@ -465,6 +523,34 @@ int VGLITE_PATH_compute_thick_shape_line(
 		int caps,
 		vg_lite_matrix_t *matrix);
 
+/*
+ * @brief Computes the band between two thick shape lines of the same length
+ *
+ * The path holds the outlines of both thick shape lines (see
+ * VGLITE_PATH_compute_thick_shape_line()): it must be filled with the
+ * VG_LITE_FILL_EVEN_ODD rule. With the same caps, the band surrounds the inner line
+ * on both sides and around the rounded caps.
+ * @param[out] band_shape: vg_lite path to compute
+ * @param[in]: x: horizontal coordinate of the end point of the lines
+ * @param[in]: y: vertical coordinate of the end point of the lines
+ * @param[in]: thickness_out: thickness of the outer line
+ * @param[in]: thickness_in: thickness of the inner line (smaller than thickness_out)
+ * @param[in]: caps: caps of the start and end of the lines, bits [0:1] contains the starting cap, bits [2:3] contains the ending cap.
+ * @param[out]: matrix: matrix to be updated with rotation atan2(y, x)
+ *
+ * @return:
+ * 	-1: an error occured,
+ * 	otherwise: number of bytes written in the path
+ */
+int VGLITE_PATH_compute_thick_shape_line_band(
+		vg_lite_path_t *band_shape,
+		int x,
+		int y,
+		int thickness_out,
+		int thickness_in,
+		int caps,
+		vg_lite_matrix_t *matrix);
+
 /*
  * @brief Function to update a color to be compatible with VG-Lite.
  *
@@ -27,6 +27,10 @@
 // use graphical engine functions to synchronize drawings
 #include "LLUI_DISPLAY.h"
 
+// notifies the drawings and records them in the display list of the frame
+#include "display_impl.h"
+#include "display_list.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -39,6 +43,12 @@ extern "C" {
 #define LOG_DRAW_START(fn) LLUI_DISPLAY_logDrawingStart(CONCAT_DEFINES(LOG_DRAW_, fn))
 #define LOG_DRAW_END(fn) LLUI_DISPLAY_logDrawingEnd(CONCAT_DEFINES(LOG_DRAW_, fn))
 
+// macro to notify a drawing and to record it in the display list (identified by its LOG_DRAW_EVENT identifier)
+#define RECORD_DRAW(fn, ...) do { \
+		DISPLAY_IMPL_notify_drawing(); \
+		DISPLAY_LIST_RECORD(CONCAT_DEFINES(LOG_DRAW_, fn), gc, __VA_ARGS__); \
+	} while (0)
+
 /*
  * LOG_DRAW_EVENT logs identifiers
  */
@@ -65,6 +75,7 @@ extern "C" {
 void LLDW_PAINTER_IMPL_drawThickFadedPoint(MICROUI_GraphicsContext* gc, jint x, jint y, jint thickness, jint fade) {
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickFadedPoint)) {
 		LOG_DRAW_START(drawThickFadedPoint);
+		RECORD_DRAW(drawThickFadedPoint, x, y, thickness, fade);
 		LLUI_DISPLAY_setDrawingStatus(DW_DRAWING_drawThickFadedPoint(gc, x, y, thickness, fade));
 		LOG_DRAW_END(drawThickFadedPoint);
 	}
@@ -73,6 +84,7 @@ void LLDW_PAINTER_IMPL_drawThickFadedPoint(MICROUI_GraphicsContext* gc, jint x,
 void LLDW_PAINTER_IMPL_drawThickFadedLine(MICROUI_GraphicsContext* gc, jint startX, jint startY, jint endX, jint endY, jint thickness, jint fade, DRAWING_Cap startCap, DRAWING_Cap endCap) {
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickFadedLine)) {
 		LOG_DRAW_START(drawThickFadedLine);
+		RECORD_DRAW(drawThickFadedLine, startX, startY, endX, endY, thickness, fade, (int32_t)startCap, (int32_t)endCap);
 		LLUI_DISPLAY_setDrawingStatus(DW_DRAWING_drawThickFadedLine(gc, startX, startY, endX, endY, thickness, fade, startCap, endCap));
 		LOG_DRAW_END(drawThickFadedLine);
 	}
@@ -81,6 +93,7 @@ void LLDW_PAINTER_IMPL_drawThickFadedLine(MICROUI_GraphicsContext* gc, jint star
 void LLDW_PAINTER_IMPL_drawThickFadedCircle(MICROUI_GraphicsContext* gc, jint x, jint y, jint diameter, jint thickness, jint fade) {
 	if ((diameter > 0) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickFadedCircle)) {
 		LOG_DRAW_START(drawThickFadedCircle);
+		RECORD_DRAW(drawThickFadedCircle, x, y, diameter, thickness, fade);
 		LLUI_DISPLAY_setDrawingStatus(DW_DRAWING_drawThickFadedCircle(gc, x, y, diameter, thickness, fade));
 		LOG_DRAW_END(drawThickFadedCircle);
 	}
@@ -89,6 +102,7 @@ void LLDW_PAINTER_IMPL_drawThickFadedCircle(MICROUI_GraphicsContext* gc, jint x,
 void LLDW_PAINTER_IMPL_drawThickFadedCircleArc(MICROUI_GraphicsContext* gc, jint x, jint y, jint diameter, jfloat startAngle, jfloat arcAngle, jint thickness, jint fade, DRAWING_Cap start, DRAWING_Cap end) {
 	if ((diameter > 0) && (int32_t)arcAngle != 0 && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickFadedCircleArc)) {
 		LOG_DRAW_START(drawThickFadedCircleArc);
+		RECORD_DRAW(drawThickFadedCircleArc, x, y, diameter, DISPLAY_LIST_float(startAngle), DISPLAY_LIST_float(arcAngle), thickness, fade, (int32_t)start, (int32_t)end);
 		LLUI_DISPLAY_setDrawingStatus(DW_DRAWING_drawThickFadedCircleArc(gc, x, y, diameter, startAngle, arcAngle, thickness, fade, start, end));
 		LOG_DRAW_END(drawThickFadedCircleArc);
 	}
@@ -97,6 +111,7 @@ void LLDW_PAINTER_IMPL_drawThickFadedCircleArc(MICROUI_GraphicsContext* gc, jint
 void LLDW_PAINTER_IMPL_drawThickFadedEllipse(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height, jint thickness, jint fade) {
 	if ((width > 0) && (height > 0) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickFadedEllipse)) {
 		LOG_DRAW_START(drawThickFadedEllipse);
+		RECORD_DRAW(drawThickFadedEllipse, x, y, width, height, thickness, fade);
 		LLUI_DISPLAY_setDrawingStatus(DW_DRAWING_drawThickFadedEllipse(gc, x, y, width, height, thickness, fade));
 		LOG_DRAW_END(drawThickFadedEllipse);
 	}
@@ -105,6 +120,7 @@ void LLDW_PAINTER_IMPL_drawThickFadedEllipse(MICROUI_GraphicsContext* gc, jint x
 void LLDW_PAINTER_IMPL_drawThickLine(MICROUI_GraphicsContext* gc, jint startX, jint startY, jint endX, jint endY, jint thickness) {
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickLine)) {
 		LOG_DRAW_START(drawThickLine);
+		RECORD_DRAW(drawThickLine, startX, startY, endX, endY, thickness);
 		LLUI_DISPLAY_setDrawingStatus(DW_DRAWING_drawThickLine(gc, startX, startY, endX, endY, thickness));
 		LOG_DRAW_END(drawThickLine);
 	}
@@ -113,6 +129,7 @@ void LLDW_PAINTER_IMPL_drawThickLine(MICROUI_GraphicsContext* gc, jint startX, j
 void LLDW_PAINTER_IMPL_drawThickCircle(MICROUI_GraphicsContext* gc, jint x, jint y, jint diameter, jint thickness) {
 	if ((diameter > 0) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickCircle)) {
 		LOG_DRAW_START(drawThickCircle);
+		RECORD_DRAW(drawThickCircle, x, y, diameter, thickness);
 		LLUI_DISPLAY_setDrawingStatus(DW_DRAWING_drawThickCircle(gc, x, y, diameter, thickness));
 		LOG_DRAW_END(drawThickCircle);
 	}
@@ -121,6 +138,7 @@ void LLDW_PAINTER_IMPL_drawThickCircle(MICROUI_GraphicsContext* gc, jint x, jint
 void LLDW_PAINTER_IMPL_drawThickEllipse(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height, jint thickness) {
 	if ((width > 0) && (height > 0) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickEllipse)) {
 		LOG_DRAW_START(drawThickEllipse);
+		RECORD_DRAW(drawThickEllipse, x, y, width, height, thickness);
 		LLUI_DISPLAY_setDrawingStatus(DW_DRAWING_drawThickEllipse(gc, x, y, width, height, thickness));
 		LOG_DRAW_END(drawThickEllipse);
 	}
@@ -129,6 +147,7 @@ void LLDW_PAINTER_IMPL_drawThickEllipse(MICROUI_GraphicsContext* gc, jint x, jin
 void LLDW_PAINTER_IMPL_drawThickCircleArc(MICROUI_GraphicsContext* gc, jint x, jint y, jint diameter, jfloat startAngle, jfloat arcAngle, jint thickness) {
 	if ((diameter > 0) && ((int32_t)arcAngle != 0) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickCircleArc)) {
 		LOG_DRAW_START(drawThickCircleArc);
+		RECORD_DRAW(drawThickCircleArc, x, y, diameter, DISPLAY_LIST_float(startAngle), DISPLAY_LIST_float(arcAngle), thickness);
 		LLUI_DISPLAY_setDrawingStatus(DW_DRAWING_drawThickCircleArc(gc, x, y, diameter, startAngle, arcAngle, thickness));
 		LOG_DRAW_END(drawThickCircleArc);
 	}
@@ -137,6 +156,7 @@ void LLDW_PAINTER_IMPL_drawThickCircleArc(MICROUI_GraphicsContext* gc, jint x, j
 void LLDW_PAINTER_IMPL_drawFlippedImage(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint regionX, jint regionY, jint width, jint height, jint x, jint y, DRAWING_Flip transformation, jint alpha) {
 	if (!LLUI_DISPLAY_isClosed(img) && (alpha > 0) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawFlippedImage)) {
 		LOG_DRAW_START(drawFlippedImage);
+		RECORD_DRAW(drawFlippedImage, DISPLAY_LIST_IMAGE(img), regionX, regionY, width, height, x, y, (int32_t)transformation, alpha);
 		LLUI_DISPLAY_setDrawingStatus(DW_DRAWING_drawFlippedImage(gc, img, regionX, regionY, width, height, x, y, transformation, alpha));
 		LOG_DRAW_END(drawFlippedImage);
 	}
@@ -145,6 +165,7 @@ void LLDW_PAINTER_IMPL_drawFlippedImage(MICROUI_GraphicsContext* gc, MICROUI_Ima
 void LLDW_PAINTER_IMPL_drawRotatedImageNearestNeighbor(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jint rotationX, jint rotationY, jfloat angle, jint alpha) {
 	if (!LLUI_DISPLAY_isClosed(img) && (alpha > 0) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawRotatedImageNearestNeighbor)) {
 		LOG_DRAW_START(drawRotatedImageNearestNeighbor);
+		RECORD_DRAW(drawRotatedImageNearestNeighbor, DISPLAY_LIST_IMAGE(img), x, y, rotationX, rotationY, DISPLAY_LIST_float(angle), alpha);
 		LLUI_DISPLAY_setDrawingStatus(DW_DRAWING_drawRotatedImageNearestNeighbor(gc, img, x, y, rotationX, rotationY, angle, alpha));
 		LOG_DRAW_END(drawRotatedImageNearestNeighbor);
 	}
@@ -153,6 +174,7 @@ void LLDW_PAINTER_IMPL_drawRotatedImageNearestNeighbor(MICROUI_GraphicsContext*
 void LLDW_PAINTER_IMPL_drawRotatedImageBilinear(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jint rotationX, jint rotationY, jfloat angle, jint alpha) {
 	if (!LLUI_DISPLAY_isClosed(img) && (alpha > 0) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawRotatedImageBilinear)) {
 		LOG_DRAW_START(drawRotatedImageBilinear);
+		RECORD_DRAW(drawRotatedImageBilinear, DISPLAY_LIST_IMAGE(img), x, y, rotationX, rotationY, DISPLAY_LIST_float(angle), alpha);
 		LLUI_DISPLAY_setDrawingStatus(DW_DRAWING_drawRotatedImageBilinear(gc, img, x, y, rotationX, rotationY, angle, alpha));
 		LOG_DRAW_END(drawRotatedImageBilinear);
 	}
@@ -161,6 +183,7 @@ void LLDW_PAINTER_IMPL_drawRotatedImageBilinear(MICROUI_GraphicsContext* gc, MIC
 void LLDW_PAINTER_IMPL_drawScaledImageNearestNeighbor(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jfloat factorX, jfloat factorY, jint alpha) {
 	if (!LLUI_DISPLAY_isClosed(img) && (alpha > 0) && (factorX > 0.f) && (factorY > 0.f) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawScaledImageNearestNeighbor)) {
 		LOG_DRAW_START(drawScaledImageNearestNeighbor);
+		RECORD_DRAW(drawScaledImageNearestNeighbor, DISPLAY_LIST_IMAGE(img), x, y, DISPLAY_LIST_float(factorX), DISPLAY_LIST_float(factorY), alpha);
 		LLUI_DISPLAY_setDrawingStatus(DW_DRAWING_drawScaledImageNearestNeighbor(gc, img, x, y, factorX, factorY, alpha));
 		LOG_DRAW_END(drawScaledImageNearestNeighbor);
 	}
@@ -169,6 +192,7 @@ void LLDW_PAINTER_IMPL_drawScaledImageNearestNeighbor(MICROUI_GraphicsContext* g
 void LLDW_PAINTER_IMPL_drawScaledImageBilinear(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jfloat factorX, jfloat factorY, jint alpha) {
 	if (!LLUI_DISPLAY_isClosed(img) && (alpha > 0) && (factorX > 0.f) && (factorY > 0.f) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawScaledImageBilinear)) {
 		LOG_DRAW_START(drawScaledImageBilinear);
+		RECORD_DRAW(drawScaledImageBilinear, DISPLAY_LIST_IMAGE(img), x, y, DISPLAY_LIST_float(factorX), DISPLAY_LIST_float(factorY), alpha);
 		LLUI_DISPLAY_setDrawingStatus(DW_DRAWING_drawScaledImageBilinear(gc, img, x, y, factorX, factorY, alpha));
 		LOG_DRAW_END(drawScaledImageBilinear);
 	}
@@ -19,13 +19,19 @@
 #include <LLUI_DISPLAY_impl.h>
 
 #include <FreeRTOS.h>
-#include <semphr.h>
+#include <task.h>
 
 #include "display_dma.h"
+#include "display_list.h"
+#include "display_mask.h"
 #include "display_utils.h"
 #include "display_vglite.h"
 #include "display_impl.h"
 #include "framerate.h"
+#include "osal.h"
+#include "power_governor.h"
+#include "touch_manager.h"
+#include "wakeup_latency.h"
 
 #include "fsl_dc_fb_dsi_cmd.h"
 
@@ -44,6 +50,16 @@
 #define DISPLAY_TASK_PRIORITY    (12)                       /** Should be > tskIDLE_PRIORITY & < configTIMER_TASK_PRIORITY */
 #define DISPLAY_TASK_STACK_SIZE  (DISPLAY_STACK_SIZE / 4)
 
+/*
+ * @brief Flag of the display task event: a flush is requested
+ */
+#define DISPLAY_TASK_FLUSH       (1u << 0)
+
+/*
+ * @brief Flag of the MicroUI binary semaphores (one OSAL event per semaphore)
+ */
+#define DISPLAY_SEMAPHORE_GIVEN  (1u << 0)
+
 // -----------------------------------------------------------------------------
 // Global Variables
 // -----------------------------------------------------------------------------
@@ -56,9 +72,9 @@ uint32_t vglite_heap_size     = VGLITE_HEAP_SZ;
 uint32_t vglite_cmd_buff_size = VGLITE_COMMAND_BUFFER_SZ;
 
 /*
- * @brief: Semaphore to synchronize the display flush with MicroUI
+ * @brief: Event to synchronize the display flush with MicroUI
  */
-static SemaphoreHandle_t sync_flush;
+static OSAL_event_handle_t sync_flush;
 static uint8_t* dirty_area_addr;	// Address of the source framebuffer
 static int32_t dirty_area_ymin;	// Top-most coordinate of the area to synchronize
 static int32_t dirty_area_ymax;	// Bottom-most coordinate of the area to synchronize
@@ -112,10 +128,15 @@ static void __display_task(void * pvParameters) {
 	(void)pvParameters;
 
 	do {
-		xSemaphoreTake(sync_flush, portMAX_DELAY);
+		(void)OSAL_event_wait(&sync_flush, DISPLAY_TASK_FLUSH, NULL, OSAL_INFINITE_TIME);
 
 		vg_lite_window_t* window = DISPLAY_VGLITE_get_window();
 
+		// MicroUI waits for the end of the flush: once the GPU has finished the
+		// frame, no transfer can start before the ones of this flush
+		vg_lite_finish();
+		power_governor_switch_profile();
+
 		// Two actions:
 		// 1- wait for the end of previous swap (if not already done): wait the
 		// end of sending of current frame buffer to display
@@ -126,6 +147,9 @@ static void __display_task(void * pvParameters) {
 		// Increment framerate
 		framerate_increment();
 
+		// the dirty lines are sent to the display (then the back buffer is restored)
+		uint32_t flush_bytes = (uint32_t)(dirty_area_ymax - dirty_area_ymin + 1) * FRAME_BUFFER_WIDTH * FRAME_BUFFER_BYTE_PER_PIXEL;
+
 #if defined (FRAME_BUFFER_COUNT) && (FRAME_BUFFER_COUNT > 1)
 		vg_lite_buffer_t *current_buffer = VGLITE_GetRenderTarget(window);
 
@@ -138,9 +162,17 @@ static void __display_task(void * pvParameters) {
 				current_buffer->memory,
 				dirty_area_ymin,
 				dirty_area_ymax);
+		flush_bytes += DISPLAY_DMA_get_transfer_size();
 #else
 		LLUI_DISPLAY_flushDone(false);
 #endif
+		DISPLAY_MASK_notify_flush(flush_bytes);
+
+		// Feed the power governor with the frame timings
+		power_governor_notify_frame();
+
+		// Release the touch events held until this frame
+		TOUCH_MANAGER_frame_flushed();
 
 	} while (1);
 }
@@ -167,6 +199,9 @@ void LLUI_DISPLAY_IMPL_initialize(LLUI_DISPLAY_SInitData* init_data) {
 	 * Init DMA *
 	 ************/
 
+	// the DMA only copies the visible pixels
+	DISPLAY_MASK_initialize();
+
 #if defined (FRAME_BUFFER_COUNT) && (FRAME_BUFFER_COUNT > 1)
 	static void ** tmp;
 
@@ -186,7 +221,9 @@ void LLUI_DISPLAY_IMPL_initialize(LLUI_DISPLAY_SInitData* init_data) {
 	 * Init task *
 	 *************/
 
-	sync_flush = xSemaphoreCreateBinary();
+	if (OSAL_OK != OSAL_event_create((uint8_t*)"Display", &sync_flush)) {
+		DISPLAY_IMPL_error(true, "failed to create the display event\n");
+	}
 	if (NULL == xTaskCreate(
 			__display_task,
 			"Display",
@@ -203,13 +240,22 @@ void LLUI_DISPLAY_IMPL_initialize(LLUI_DISPLAY_SInitData* init_data) {
 
 	vg_lite_window_t* window = DISPLAY_VGLITE_get_window();
 	vg_lite_buffer_t *buffer = VGLITE_GetRenderTarget(window);
-	init_data->binary_semaphore_0 = (void*)xSemaphoreCreateBinary();
-	init_data->binary_semaphore_1 = (void*)xSemaphoreCreateBinary();
+	// the MicroUI binary semaphores are only taken by the Graphics Engine (MicroJvm
+	// task) and given by it or by the interrupts (GPU, DMA): they are OSAL events
+	static OSAL_event_handle_t semaphores[2];
+	if ((OSAL_OK != OSAL_event_create((uint8_t*)"MicroUI 0", &semaphores[0]))
+			|| (OSAL_OK != OSAL_event_create((uint8_t*)"MicroUI 1", &semaphores[1]))) {
+		DISPLAY_IMPL_error(true, "failed to create the MicroUI semaphores\n");
+	}
+	init_data->binary_semaphore_0 = (void*)&semaphores[0];
+	init_data->binary_semaphore_1 = (void*)&semaphores[1];
 	init_data->lcd_width = window->width;
 	init_data->lcd_height = window->height;
 	init_data->memory_width = FRAME_BUFFER_STRIDE_PIXELS;
 	init_data->back_buffer_address = (uint8_t*)buffer->memory;
 
+	DISPLAY_LIST_start_frame(init_data->back_buffer_address);
+
 	// notify that the display is initialized
 	DISPLAY_IMPL_initialized();
 }
@@ -222,7 +268,14 @@ uint8_t* LLUI_DISPLAY_IMPL_flush(MICROUI_GraphicsContext* gc, uint8_t* addr, uin
 	(void)xmin;
 	(void)xmax;
 
+	// all the drawings of the frame have been submitted: adapt the command buffers
+	DISPLAY_VGLITE_frame_done();
+
+	DISPLAY_LIST_end_frame();
 	uint8_t* ret = (uint8_t*) DISPLAY_VGLITE_get_next_graphics_buffer()->memory;
+	DISPLAY_LIST_start_frame(ret);
+
+	power_governor_notify_flush();
 
 	// store dirty area to restore after the flush
 	dirty_area_addr = addr;
@@ -230,29 +283,26 @@ uint8_t* LLUI_DISPLAY_IMPL_flush(MICROUI_GraphicsContext* gc, uint8_t* addr, uin
 	dirty_area_ymax = ymax;
 
 	// wakeup display task
-	xSemaphoreGive(sync_flush);
+	(void)OSAL_event_set(&sync_flush, DISPLAY_TASK_FLUSH);
 
 	return ret;
 }
 
 // See the header file for the function documentation
 void LLUI_DISPLAY_IMPL_binarySemaphoreTake(void* sem) {
-	xSemaphoreTake((SemaphoreHandle_t)sem, portMAX_DELAY);
+	(void)OSAL_event_wait((OSAL_event_handle_t*)sem, DISPLAY_SEMAPHORE_GIVEN, NULL, OSAL_INFINITE_TIME);
+	WAKEUP_LATENCY_woken(WAKEUP_LATENCY_GRAPHICS);
 }
 
 // See the header file for the function documentation
 void LLUI_DISPLAY_IMPL_binarySemaphoreGive(void* sem, bool under_isr) {
 
 	if (under_isr) {
-		portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
-		xSemaphoreGiveFromISR((SemaphoreHandle_t)sem, &xHigherPriorityTaskWoken);
-		if(xHigherPriorityTaskWoken != pdFALSE ) {
-			// Force a context switch here.
-			portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-		}
+		WAKEUP_LATENCY_signal(WAKEUP_LATENCY_GRAPHICS);
+		(void)OSAL_event_set_from_isr((OSAL_event_handle_t*)sem, DISPLAY_SEMAPHORE_GIVEN);
 	}
 	else  {
-		xSemaphoreGive((SemaphoreHandle_t)sem);
+		(void)OSAL_event_set((OSAL_event_handle_t*)sem, DISPLAY_SEMAPHORE_GIVEN);
 	}
 }
 
@@ -15,6 +15,8 @@
  * element and event's data. When an event is detected, the logger calls
  * microui_event_decoder.h functions.
  *
+ * The logger also records the FIFO activity in the input log (see input_log.h).
+ *
  * @see LLUI_INPUT_impl.h file comment
  * @author MicroEJ Developer Team
  * @version 2.0.0
@@ -35,11 +37,13 @@
 // deport event description to another file
 #include "microui_event_decoder.h"
 
+#include "input_log.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-#ifdef MICROUIEVENTDECODER_ENABLED
+#if defined(MICROUIEVENTDECODER_ENABLED) || (defined(INPUT_LOG_ENABLED) && (INPUT_LOG_ENABLED != 0))
 
 // -----------------------------------------------------------------------------
 // Macros and Defines
@@ -50,10 +54,21 @@ extern "C" {
  */
 #define QUEUE_LOG_MAX_SIZE 100
 
+/*
+ * @brief Records a FIFO operation in the input log.
+ */
+#if defined(INPUT_LOG_ENABLED) && (INPUT_LOG_ENABLED != 0)
+#define INPUT_LOG(kind, data, index, remaining) INPUT_LOG_record((kind), (data), (index), (remaining))
+#else
+#define INPUT_LOG(kind, data, index, remaining)
+#endif
+
 // -----------------------------------------------------------------------------
 // Global Variables
 // -----------------------------------------------------------------------------
 
+#ifdef MICROUIEVENTDECODER_ENABLED
+
 /*
  * @brief Pointer on event's data decoder.
  */
@@ -65,27 +80,33 @@ static MICROUI_EVENT_DECODER_decode_event_data fct_decode_data;
 static uint8_t queue_log[QUEUE_LOG_MAX_SIZE];
 
 /*
- * @brief true when a new event is logged, false when the event's data is logged.
+ * @brief Current event to decode.
  */
-static bool queue_is_first_element;
+static uint32_t dump_current_event;
+
+#endif // MICROUIEVENTDECODER_ENABLED
 
 /*
- * @brief Current event to decode.
+ * @brief true when a new event is logged, false when the event's data is logged.
  */
-static uint32_t dump_current_event;
+static bool queue_is_first_element;
 
 // -----------------------------------------------------------------------------
 // LLUI_INPUT_impl.h functions
 // -----------------------------------------------------------------------------
 
 void LLUI_INPUT_IMPL_log_queue_init(uint32_t length) {
+#ifdef MICROUIEVENTDECODER_ENABLED
 	assert(length <= (uint32_t)QUEUE_LOG_MAX_SIZE);
 	(void)memset((void*)queue_log, 0, length);
+#endif
 	queue_is_first_element = true;
+	INPUT_LOG(INPUT_LOG_KIND_INIT, length, 0, 0);
 }
 
 void LLUI_INPUT_IMPL_log_queue_full(uint32_t data) {
-	// queue is full, nothing to log
+	// queue is full: the event is lost
+	INPUT_LOG(INPUT_LOG_KIND_FULL, data, 0, 0);
 	(void)data;
 }
 
@@ -94,12 +115,18 @@ void LLUI_INPUT_IMPL_log_queue_add(uint32_t data, uint32_t index, uint32_t remai
 	(void)queue_length;
 
 	if (queue_is_first_element) {
+#ifdef MICROUIEVENTDECODER_ENABLED
 		// start new event: set the event size in array
 		queue_log[index] = (uint8_t)(remaining_elements + (uint32_t)1);
+#endif
+		INPUT_LOG(INPUT_LOG_KIND_EVENT, data, index, remaining_elements);
 	}
 	else {
+#ifdef MICROUIEVENTDECODER_ENABLED
 		// continue previous event: drop data
 		queue_log[index] = 0;
+#endif
+		INPUT_LOG(INPUT_LOG_KIND_DATA, data, index, remaining_elements);
 	}
 
 	// prepare next log
@@ -107,7 +134,8 @@ void LLUI_INPUT_IMPL_log_queue_add(uint32_t data, uint32_t index, uint32_t remai
 }
 
 void LLUI_INPUT_IMPL_log_queue_replace(uint32_t old, uint32_t data, uint32_t index, uint32_t queue_length) {
-	// previous event has been replaced, nothing to log
+	// previous event has been replaced
+	INPUT_LOG(INPUT_LOG_KIND_REPLACE, data, index, 0);
 	(void)old;
 	(void)data;
 	(void)index;
@@ -115,11 +143,14 @@ void LLUI_INPUT_IMPL_log_queue_replace(uint32_t old, uint32_t data, uint32_t ind
 }
 
 void LLUI_INPUT_IMPL_log_queue_read(uint32_t data, uint32_t index) {
-	// event has been read, nothing to log
+	// event has been read
+	INPUT_LOG(INPUT_LOG_KIND_READ, data, index, 0);
 	(void)data;
 	(void)index;
 }
 
+#ifdef MICROUIEVENTDECODER_ENABLED
+
 void LLUI_INPUT_IMPL_log_dump(bool log_type, uint32_t log, uint32_t index) {
 	if (log_type) {
 		// log is an event or a data event
@@ -178,6 +209,8 @@ void LLUI_INPUT_IMPL_log_dump(bool log_type, uint32_t log, uint32_t index) {
 
 #endif // MICROUIEVENTDECODER_ENABLED
 
+#endif // MICROUIEVENTDECODER_ENABLED || INPUT_LOG_ENABLED
+
 // -----------------------------------------------------------------------------
 // EOF
 // -----------------------------------------------------------------------------
@@ -27,6 +27,10 @@
 // use graphical engine functions to synchronize drawings
 #include "LLUI_DISPLAY.h"
 
+// notifies the drawings and records them in the display list of the frame
+#include "display_impl.h"
+#include "display_list.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -39,6 +43,12 @@ extern "C" {
 #define LOG_DRAW_START(fn) LLUI_DISPLAY_logDrawingStart(CONCAT_DEFINES(LOG_DRAW_, fn))
 #define LOG_DRAW_END(fn) LLUI_DISPLAY_logDrawingEnd(CONCAT_DEFINES(LOG_DRAW_, fn))
 
+// macro to notify a drawing and to record it in the display list (identified by its LOG_DRAW_EVENT identifier)
+#define RECORD_DRAW(fn, ...) do { \
+		DISPLAY_IMPL_notify_drawing(); \
+		DISPLAY_LIST_RECORD(CONCAT_DEFINES(LOG_DRAW_, fn), gc, __VA_ARGS__); \
+	} while (0)
+
 /*
  * LOG_DRAW_EVENT logs identifiers
  */
@@ -89,6 +99,7 @@ void LLUI_PAINTER_IMPL_writePixel(MICROUI_GraphicsContext* gc, jint x, jint y) {
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_writePixel)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(writePixel);
+		RECORD_DRAW(writePixel, x, y);
 		if (LLUI_DISPLAY_isPixelInClip(gc, x, y)) {
 			LLUI_DISPLAY_configureClip(gc, false/* point is in clip */);
 			status = UI_DRAWING_writePixel(gc, x, y);
@@ -106,6 +117,7 @@ void LLUI_PAINTER_IMPL_writePixel(MICROUI_GraphicsContext* gc, jint x, jint y) {
 void LLUI_PAINTER_IMPL_drawLine(MICROUI_GraphicsContext* gc, jint startX, jint startY, jint endX, jint endY) {
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawLine)) {
 		LOG_DRAW_START(drawLine);
+		RECORD_DRAW(drawLine, startX, startY, endX, endY);
 		// cannot reduce/clip line: may be endX < startX and / or endY < startY
 		LLUI_DISPLAY_setDrawingStatus(UI_DRAWING_drawLine(gc, startX, startY, endX, endY));
 		LOG_DRAW_END(drawLine);
@@ -117,6 +129,7 @@ void LLUI_PAINTER_IMPL_drawHorizontalLine(MICROUI_GraphicsContext* gc, jint x, j
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawHorizontalLine)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(drawHorizontalLine);
+		RECORD_DRAW(drawHorizontalLine, x, y, length);
 
 		jint x1 = x;
 		jint x2 = x + length - 1;
@@ -140,6 +153,7 @@ void LLUI_PAINTER_IMPL_drawVerticalLine(MICROUI_GraphicsContext* gc, jint x, jin
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawVerticalLine)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(drawVerticalLine);
+		RECORD_DRAW(drawVerticalLine, x, y, length);
 
 		jint y1 = y;
 		jint y2 = y + length - 1;
@@ -163,6 +177,7 @@ void LLUI_PAINTER_IMPL_drawRectangle(MICROUI_GraphicsContext* gc, jint x, jint y
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawRectangle)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(drawRectangle);
+		RECORD_DRAW(drawRectangle, x, y, width, height);
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if ((width > 0) && (height > 0)) {
@@ -189,6 +204,7 @@ void LLUI_PAINTER_IMPL_fillRectangle(MICROUI_GraphicsContext* gc, jint x, jint y
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_fillRectangle)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(fillRectangle);
+		RECORD_DRAW(fillRectangle, x, y, width, height);
 
 		jint x1 = x;
 		jint x2 = x + width - 1;
@@ -214,6 +230,7 @@ void LLUI_PAINTER_IMPL_drawRoundedRectangle(MICROUI_GraphicsContext* gc, jint x,
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawRoundedRectangle)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(drawRoundedRectangle);
+		RECORD_DRAW(drawRoundedRectangle, x, y, width, height, cornerEllipseWidth, cornerEllipseHeight);
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if ((width > 0) && (height > 0)) {
@@ -235,6 +252,7 @@ void LLUI_PAINTER_IMPL_fillRoundedRectangle(MICROUI_GraphicsContext* gc, jint x,
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_fillRoundedRectangle)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(fillRoundedRectangle);
+		RECORD_DRAW(fillRoundedRectangle, x, y, width, height, cornerEllipseWidth, cornerEllipseHeight);
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if ((width > 0) && (height > 0)) {
@@ -256,6 +274,7 @@ void LLUI_PAINTER_IMPL_drawCircleArc(MICROUI_GraphicsContext* gc, jint x, jint y
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawCircleArc)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(drawCircleArc);
+		RECORD_DRAW(drawCircleArc, x, y, diameter, DISPLAY_LIST_float(startAngle), DISPLAY_LIST_float(arcAngle));
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if ((diameter > 0) && ((int32_t)arcAngle != 0)) {
@@ -277,6 +296,7 @@ void LLUI_PAINTER_IMPL_drawEllipseArc(MICROUI_GraphicsContext* gc, jint x, jint
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawEllipseArc)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(drawEllipseArc);
+		RECORD_DRAW(drawEllipseArc, x, y, width, height, DISPLAY_LIST_float(startAngle), DISPLAY_LIST_float(arcAngle));
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if ((width > 0) && (height > 0) && ((int32_t)arcAngle != 0)) {
@@ -298,6 +318,7 @@ void LLUI_PAINTER_IMPL_fillCircleArc(MICROUI_GraphicsContext* gc, jint x, jint y
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_fillCircleArc)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(fillCircleArc);
+		RECORD_DRAW(fillCircleArc, x, y, diameter, DISPLAY_LIST_float(startAngle), DISPLAY_LIST_float(arcAngle));
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if ((diameter > 0) && ((int32_t)arcAngle != 0)) {
@@ -319,6 +340,7 @@ void LLUI_PAINTER_IMPL_fillEllipseArc(MICROUI_GraphicsContext* gc, jint x, jint
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_fillEllipseArc)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(fillEllipseArc);
+		RECORD_DRAW(fillEllipseArc, x, y, width, height, DISPLAY_LIST_float(startAngle), DISPLAY_LIST_float(arcAngle));
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if ((width > 0) && (height > 0) && ((int32_t)arcAngle != 0)) {
@@ -340,6 +362,7 @@ void LLUI_PAINTER_IMPL_drawEllipse(MICROUI_GraphicsContext* gc, jint x, jint y,
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawEllipse)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(drawEllipse);
+		RECORD_DRAW(drawEllipse, x, y, width, height);
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if ((width > 0) && (height > 0)) {
@@ -361,6 +384,7 @@ void LLUI_PAINTER_IMPL_fillEllipse(MICROUI_GraphicsContext* gc, jint x, jint y,
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_fillEllipse)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(fillEllipse);
+		RECORD_DRAW(fillEllipse, x, y, width, height);
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if ((width > 0) && (height > 0)) {
@@ -382,6 +406,7 @@ void LLUI_PAINTER_IMPL_drawCircle(MICROUI_GraphicsContext* gc, jint x, jint y, j
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawCircle)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(drawCircle);
+		RECORD_DRAW(drawCircle, x, y, diameter);
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if (diameter > 0) {
@@ -403,6 +428,7 @@ void LLUI_PAINTER_IMPL_fillCircle(MICROUI_GraphicsContext* gc, jint x, jint y, j
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_fillCircle)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(fillCircle);
+		RECORD_DRAW(fillCircle, x, y, diameter);
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if (diameter > 0) {
@@ -424,6 +450,7 @@ void LLUI_PAINTER_IMPL_drawImage(MICROUI_GraphicsContext* gc, MICROUI_Image* img
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawImage)) {
 		DRAWING_Status status = DRAWING_DONE;
 		LOG_DRAW_START(drawImage);
+		RECORD_DRAW(drawImage, DISPLAY_LIST_IMAGE(img), regionX, regionY, width, height, x, y, alpha);
 
 		// tests on parameters and clip are performed after suspend to prevent to perform it several times
 		if (!LLUI_DISPLAY_isClosed(img) && (alpha > 0)) {
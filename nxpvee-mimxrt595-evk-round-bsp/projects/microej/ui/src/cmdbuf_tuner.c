@@ -0,0 +1,120 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief VGLite command buffer sizing: decision logic (OS and hardware independent).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "cmdbuf_tuner.h"
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Rounds up a size to the granule and clamps it to the limits.
+ */
+static uint32_t __cmdbuf_tuner_fit(const cmdbuf_tuner_config_t* config, uint64_t size);
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void cmdbuf_tuner_init(cmdbuf_tuner_t* tuner, const cmdbuf_tuner_config_t* config, uint32_t size) {
+	(void)memset(tuner, 0, sizeof(cmdbuf_tuner_t));
+	tuner->config = config;
+	tuner->size = size;
+}
+
+// See the header file for the function documentation
+uint32_t cmdbuf_tuner_on_frame(cmdbuf_tuner_t* tuner, uint32_t bytes, uint32_t flushes, uint32_t forced_flushes, uint32_t peak_usage) {
+	const cmdbuf_tuner_config_t* config = tuner->config;
+
+	tuner->stats.frames++;
+	tuner->stats.bytes += bytes;
+	tuner->stats.flushes += flushes;
+	tuner->stats.forced_flushes += forced_flushes;
+	if (bytes > tuner->stats.max_frame_bytes) {
+		tuner->stats.max_frame_bytes = bytes;
+	}
+	if (peak_usage > tuner->stats.peak_usage) {
+		tuner->stats.peak_usage = peak_usage;
+	}
+
+	if (forced_flushes > (uint32_t)0) {
+		// a drawing did not fit in a command buffer: grow at once
+		uint32_t size = __cmdbuf_tuner_fit(config, (uint64_t)tuner->size * 2u);
+		if (size > tuner->size) {
+			tuner->size = size;
+			tuner->stats.grows++;
+		}
+		tuner->calm_frames = 0;
+		tuner->window_peak = 0;
+	}
+	else {
+		if (peak_usage > tuner->window_peak) {
+			tuner->window_peak = peak_usage;
+		}
+		tuner->calm_frames++;
+
+		if (tuner->calm_frames >= config->shrink_hold_frames) {
+			// shrink to the peak usage of the last frames plus a margin
+			uint64_t target = (uint64_t)tuner->window_peak * (100u + config->headroom_percent) / 100u;
+			uint32_t size = __cmdbuf_tuner_fit(config, target);
+			if (size < tuner->size) {
+				tuner->size = size;
+				tuner->stats.shrinks++;
+			}
+			tuner->calm_frames = 0;
+			tuner->window_peak = 0;
+		}
+	}
+
+	return tuner->size;
+}
+
+// See the header file for the function documentation
+void cmdbuf_tuner_set_size(cmdbuf_tuner_t* tuner, uint32_t size) {
+	tuner->size = size;
+}
+
+// See the header file for the function documentation
+void cmdbuf_tuner_get_stats(cmdbuf_tuner_t* tuner, cmdbuf_tuner_stats_t* stats) {
+	*stats = tuner->stats;
+	stats->size = tuner->size;
+}
+
+// -----------------------------------------------------------------------------
+// Internal functions
+// -----------------------------------------------------------------------------
+
+// See the section 'Internal function definitions' for the function documentation
+static uint32_t __cmdbuf_tuner_fit(const cmdbuf_tuner_config_t* config, uint64_t size) {
+	uint64_t ret = ((size + config->granule - 1u) / config->granule) * config->granule;
+
+	if (ret < config->min_size) {
+		ret = config->min_size;
+	}
+	else if (ret > config->max_size) {
+		ret = config->max_size;
+	}
+	// else: size within the limits
+
+	return (uint32_t)ret;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
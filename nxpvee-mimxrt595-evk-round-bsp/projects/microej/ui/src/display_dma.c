@@ -20,6 +20,7 @@
 
 #include "display_dma.h"
 #include "display_impl.h"
+#include "display_mask.h"
 #include "vglite_window.h"
 
 #include "fsl_dma.h"
@@ -34,6 +35,13 @@
 /* @brief Width of one element in a DMA transfer (DMA spec) */
 #define DISPLAY_DMA_TRANSFER_WIDTH      (4U)
 
+#if defined(DISPLAY_MASK_ENABLED) && (DISPLAY_MASK_ENABLED != 0)
+
+/* @brief Number of descriptors in the DMA chain: one per line, only the visible pixels are copied */
+#define DISPLAY_DMA_NB_DESCS            (FRAME_BUFFER_HEIGHT)
+
+#else
+
 /* @brief Number of lines per DMA transfer */
 #define DISPLAY_DMA_NB_LINES            (DISPLAY_DMA_MAX_TRANSFER / FRAME_BUFFER_STRIDE_BYTE)
 
@@ -52,6 +60,8 @@
 #define DISPLAY_LAST_DMA_TRANSFER_LENGTH     \
 	(DISPLAY_LAST_DMA_NB_LINES * FRAME_BUFFER_STRIDE_BYTE)
 
+#endif // DISPLAY_MASK_ENABLED
+
 // -----------------------------------------------------------------------------
 // Global Variables
 // -----------------------------------------------------------------------------
@@ -68,6 +78,9 @@ static dma_descriptor_t __attribute__((aligned(16U))) dma_descriptors[2 * DISPLA
 static dma_descriptor_t __attribute__((aligned(16U))) dma_descriptors[2 * DISPLAY_DMA_NB_DESCS];
 #endif
 
+/* @brief Number of bytes copied by a DMA transfer */
+static uint32_t transfer_size;
+
 #endif // DISPLAY_DMA_ENABLED != 0
 
 // -----------------------------------------------------------------------------
@@ -83,6 +96,20 @@ static dma_descriptor_t __attribute__((aligned(16U))) dma_descriptors[2 * DISPLA
  */
 static void __dma_callback(dma_handle_t *handle, void *param, bool transfer_done, uint32_t tcds);
 
+#if defined(DISPLAY_MASK_ENABLED) && (DISPLAY_MASK_ENABLED != 0)
+/*
+ * @brief: Sets up a DMA chain that copies the visible pixels of each line (the
+ * lines are extended to the DMA transfer width)
+ *
+ * @param[in] descriptors: the DISPLAY_DMA_NB_DESCS descriptors of the chain
+ * @param[in] fb_src: the source framebuffer
+ * @param[in] fb_dst: the destination framebuffer
+ *
+ * @return the number of bytes copied by the chain
+ */
+static uint32_t __setup_visible_descriptors(dma_descriptor_t *descriptors, framebuffer_t const * fb_src, framebuffer_t const * fb_dst);
+#endif
+
 // -----------------------------------------------------------------------------
 // display_dma.h
 // -----------------------------------------------------------------------------
@@ -98,6 +125,9 @@ void DISPLAY_DMA_initialize(const framebuffer_t * framebuffers[]) {
 
 	// Initialize the dma descriptors
 	for (int i = 0; i < 2; i++) {
+#if defined(DISPLAY_MASK_ENABLED) && (DISPLAY_MASK_ENABLED != 0)
+		transfer_size = __setup_visible_descriptors(&(dma_descriptors[i*DISPLAY_DMA_NB_DESCS]), framebuffers[i], framebuffers[1-i]);
+#else
 		framebuffer_t const * fb_src = framebuffers[i];
 		framebuffer_t const * fb_dst = framebuffers[1-i];
 		int offset = i*DISPLAY_DMA_NB_DESCS;
@@ -168,6 +198,8 @@ void DISPLAY_DMA_initialize(const framebuffer_t * framebuffers[]) {
 					(void *) &(fb_dst->p[y]),
 					NULL);
 #endif
+		transfer_size = FRAME_BUFFER_HEIGHT * FRAME_BUFFER_STRIDE_BYTE;
+#endif // DISPLAY_MASK_ENABLED
 	}
 }
 
@@ -193,6 +225,11 @@ void DISPLAY_DMA_start(framebuffer_t *src, framebuffer_t *dst, int ymin, int yma
 	DMA_StartTransfer(&g_DMA_Handle);
 }
 
+// See the header file for the function documentation
+uint32_t DISPLAY_DMA_get_transfer_size(void) {
+	return transfer_size;
+}
+
 // -----------------------------------------------------------------------------
 // Internal functions
 // -----------------------------------------------------------------------------
@@ -213,6 +250,54 @@ static void __dma_callback(dma_handle_t *handle, void *param, bool transfer_done
 	}
 }
 
+#if defined(DISPLAY_MASK_ENABLED) && (DISPLAY_MASK_ENABLED != 0)
+// See the section 'Internal function definitions' for the function documentation
+static uint32_t __setup_visible_descriptors(dma_descriptor_t *descriptors, framebuffer_t const * fb_src, framebuffer_t const * fb_dst) {
+	uint32_t size = 0;
+	int nb_descs = 0;
+	int d = 0;
+
+	for (int y = 0; y < FRAME_BUFFER_HEIGHT; y++) {
+		DISPLAY_MASK_span_t span = DISPLAY_MASK_get_span(y);
+		if (span.xmin <= span.xmax) {
+			nb_descs++;
+		}
+	}
+
+	for (int y = 0; y < FRAME_BUFFER_HEIGHT; y++) {
+		DISPLAY_MASK_span_t span = DISPLAY_MASK_get_span(y);
+
+		if (span.xmin <= span.xmax) {
+			// visible pixels extended to the transfer width
+			uint32_t start = ((uint32_t)span.xmin * FRAME_BUFFER_BYTE_PER_PIXEL) & ~(DISPLAY_DMA_TRANSFER_WIDTH - 1U);
+			uint32_t end = ALIGN(((uint32_t)span.xmax + 1U) * FRAME_BUFFER_BYTE_PER_PIXEL, DISPLAY_DMA_TRANSFER_WIDTH);
+			bool last = (d == (nb_descs - 1));
+
+			DMA_SetupDescriptor(
+					&(descriptors[d]),
+					DMA_CHANNEL_XFER(
+						!last, false, last, false,
+						DISPLAY_DMA_TRANSFER_WIDTH,
+						kDMA_AddressInterleave1xWidth,
+						kDMA_AddressInterleave1xWidth,
+						end - start
+						),
+						// cppcheck-suppress [misra-c2012-11.8] cast to (void *) is valid
+					(void *) &(((uint8_t *) &(fb_src->p[y]))[start]),
+						// cppcheck-suppress [misra-c2012-11.8] cast to (void *) is valid
+					(void *) &(((uint8_t *) &(fb_dst->p[y]))[start]),
+					last ? NULL : &(descriptors[d+1])
+					);
+
+			size += end - start;
+			d++;
+		}
+	}
+
+	return size;
+}
+#endif // DISPLAY_MASK_ENABLED
+
 #endif // DISPLAY_DMA_ENABLED != 0
 
 // -----------------------------------------------------------------------------
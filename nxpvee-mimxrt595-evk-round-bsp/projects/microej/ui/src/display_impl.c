@@ -18,6 +18,7 @@
 
 #include "fsl_debug_console.h"
 #include "power_manager.h"
+#include "power_governor.h"
 #include "trace_platform.h"
 #include "event_generator.h"
 #include "mej_log.h"
@@ -53,6 +54,11 @@ void DISPLAY_IMPL_error(bool critical, const char* format, ...) {
 	while (critical){}
 }
 
+void DISPLAY_IMPL_notify_drawing(void) {
+   // the render time of a frame starts with its first drawing
+   power_governor_notify_drawing();
+}
+
 void DISPLAY_IMPL_notify_gpu_start(void) {
    power_manager_enable_low_power(POWER_GPU, LOW_POWER_FORBIDDEN);
 }
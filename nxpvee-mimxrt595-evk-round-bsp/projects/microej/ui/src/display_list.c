@@ -0,0 +1,249 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Display list of a frame: recording and dump.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "display_list.h"
+
+#if defined(DISPLAY_LIST_DUMP_ENABLED) && (DISPLAY_LIST_DUMP_ENABLED != 0)
+#include "SEGGER_RTT.h"
+#endif
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define FNV_OFFSET_BASIS (2166136261u)
+#define FNV_PRIME (16777619u)
+
+/*
+ * @brief Size of the frame header, stored in front of the records to dump a
+ * frame with a single write.
+ */
+#define FRAME_HEADER_SIZE (sizeof(DISPLAY_LIST_frame_t))
+
+// -----------------------------------------------------------------------------
+// Private fields
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief The frame header followed by the records of the frame.
+ */
+static uint32_t display_list[(FRAME_HEADER_SIZE + DISPLAY_LIST_BUFFER_SIZE) / sizeof(uint32_t)];
+
+static uint32_t back_buffer;        // address of the buffer where the frame is drawn
+static uint32_t dump_frames;        // number of frames still to dump
+static DISPLAY_LIST_stats_t stats;
+
+#if defined(DISPLAY_LIST_DUMP_ENABLED) && (DISPLAY_LIST_DUMP_ENABLED != 0)
+static uint8_t dump_buffer[DISPLAY_LIST_DUMP_RTT_BUFFER_SIZE];
+static bool dump_initialized;
+#endif
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Gets the header of the current frame.
+ */
+static inline DISPLAY_LIST_frame_t* __display_list_frame(void);
+
+/*
+ * @brief Continues the hash of a memory area.
+ */
+static uint32_t __display_list_hash(uint32_t hash, const void* data, uint32_t size);
+
+/*
+ * @brief Dumps the current frame over RTT.
+ */
+static void __display_list_dump(void);
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void DISPLAY_LIST_start_frame(const uint8_t* buffer) {
+	DISPLAY_LIST_frame_t* frame = __display_list_frame();
+
+	back_buffer = (uint32_t)(uintptr_t)buffer;
+	frame->magic = DISPLAY_LIST_MAGIC;
+	frame->frame = stats.frames;
+	frame->hash = FNV_OFFSET_BASIS;
+	frame->records = 0;
+	frame->size = 0;
+	frame->flags = 0;
+}
+
+// See the header file for the function documentation
+void DISPLAY_LIST_record(uint16_t op, MICROUI_GraphicsContext* gc, const int32_t* args, uint32_t count) {
+	DISPLAY_LIST_frame_t* frame = __display_list_frame();
+	DISPLAY_LIST_record_t record;
+	uint32_t args_size = count * sizeof(int32_t);
+
+	record.op = op;
+	record.size = (uint16_t)(sizeof(DISPLAY_LIST_record_t) + args_size);
+	record.target = (uint32_t)(uintptr_t)LLUI_DISPLAY_getBufferAddress(&gc->image);
+	record.clip_x1 = (int16_t)gc->clip_x1;
+	record.clip_y1 = (int16_t)gc->clip_y1;
+	record.clip_x2 = (int16_t)gc->clip_x2;
+	record.clip_y2 = (int16_t)gc->clip_y2;
+	record.color = (uint32_t)gc->foreground_color;
+
+	if (record.target != back_buffer) {
+		// drawing in an image: the content of the image may differ from the previous frame
+		frame->flags |= DISPLAY_LIST_FLAG_FOREIGN;
+	}
+
+	frame->hash = __display_list_hash(frame->hash, &record, sizeof(DISPLAY_LIST_record_t));
+	frame->hash = __display_list_hash(frame->hash, args, args_size);
+	frame->records++;
+
+	if ((frame->size + record.size) <= (uint32_t)DISPLAY_LIST_BUFFER_SIZE) {
+		uint8_t* dest = &((uint8_t*)display_list)[FRAME_HEADER_SIZE + frame->size];
+		(void)memcpy(dest, &record, sizeof(DISPLAY_LIST_record_t));
+		(void)memcpy(dest + sizeof(DISPLAY_LIST_record_t), args, args_size);
+		frame->size += record.size;
+	}
+	else {
+		// only hashed: the dump of the frame is truncated
+		frame->flags |= DISPLAY_LIST_FLAG_TRUNCATED;
+	}
+}
+
+// See the header file for the function documentation
+void DISPLAY_LIST_end_frame(void) {
+	DISPLAY_LIST_frame_t* frame = __display_list_frame();
+
+	stats.frames++;
+	if (0u != (frame->flags & DISPLAY_LIST_FLAG_TRUNCATED)) {
+		stats.truncated_frames++;
+	}
+	if (frame->records > stats.max_records) {
+		stats.max_records = frame->records;
+	}
+	if (frame->size > stats.max_size) {
+		stats.max_size = frame->size;
+	}
+
+	if (dump_frames > 0u) {
+		dump_frames--;
+		__display_list_dump();
+	}
+}
+
+// See the header file for the function documentation
+void DISPLAY_LIST_dump(uint32_t frames) {
+	dump_frames = frames;
+}
+
+// See the header file for the function documentation
+void DISPLAY_LIST_get_stats(DISPLAY_LIST_stats_t* s) {
+	*s = stats;
+}
+
+// See the header file for the function documentation
+uint32_t DISPLAY_LIST_parse(const uint8_t* data, uint32_t size, const DISPLAY_LIST_visitor_t* visitor, void* user) {
+	uint32_t offset = 0;
+	bool valid = true;
+
+	while (valid && ((offset + FRAME_HEADER_SIZE) <= size)) {
+		DISPLAY_LIST_frame_t frame;
+		(void)memcpy(&frame, &data[offset], FRAME_HEADER_SIZE);
+
+		if ((DISPLAY_LIST_MAGIC != frame.magic) || ((offset + FRAME_HEADER_SIZE + frame.size) > size)) {
+			// corrupted or incomplete frame
+			valid = false;
+		}
+		else {
+			uint32_t record_offset = offset + FRAME_HEADER_SIZE;
+			uint32_t end = record_offset + frame.size;
+
+			if (NULL != visitor->on_frame) {
+				visitor->on_frame(&frame, user);
+			}
+
+			while (valid && ((record_offset + sizeof(DISPLAY_LIST_record_t)) <= end)) {
+				DISPLAY_LIST_record_t record;
+				(void)memcpy(&record, &data[record_offset], sizeof(DISPLAY_LIST_record_t));
+
+				if ((record.size < sizeof(DISPLAY_LIST_record_t)) || ((record_offset + record.size) > end)
+						|| (0u != (record.size % sizeof(int32_t)))) {
+					valid = false;
+				}
+				else {
+					uint32_t args_size = record.size - sizeof(DISPLAY_LIST_record_t);
+					// cppcheck-suppress [misra-c2012-11.3] the records are 32-bit aligned in an aligned dump
+					const int32_t* args = (const int32_t*)&data[record_offset + sizeof(DISPLAY_LIST_record_t)];
+					if (NULL != visitor->on_record) {
+						visitor->on_record(&record, args, args_size / sizeof(int32_t), user);
+					}
+					record_offset += record.size;
+				}
+			}
+
+			if (valid) {
+				offset = end;
+			}
+		}
+	}
+
+	return offset;
+}
+
+// See the header file for the function documentation
+uint32_t DISPLAY_LIST_hash(const void* data, uint32_t size) {
+	return __display_list_hash(FNV_OFFSET_BASIS, data, size);
+}
+
+// -----------------------------------------------------------------------------
+// Internal functions
+// -----------------------------------------------------------------------------
+
+// See the section 'Internal function definitions' for the function documentation
+static inline DISPLAY_LIST_frame_t* __display_list_frame(void) {
+	return (DISPLAY_LIST_frame_t*)display_list;
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static uint32_t __display_list_hash(uint32_t hash, const void* data, uint32_t size) {
+	const uint8_t* bytes = (const uint8_t*)data;
+	for (uint32_t i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static void __display_list_dump(void) {
+#if defined(DISPLAY_LIST_DUMP_ENABLED) && (DISPLAY_LIST_DUMP_ENABLED != 0)
+	if (!dump_initialized) {
+		(void)SEGGER_RTT_ConfigUpBuffer(DISPLAY_LIST_DUMP_RTT_CHANNEL, "DisplayList", dump_buffer, sizeof(dump_buffer), SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+		dump_initialized = true;
+	}
+
+	// the whole frame is written or nothing (no block skip mode)
+	if (0u != SEGGER_RTT_Write(DISPLAY_LIST_DUMP_RTT_CHANNEL, display_list, FRAME_HEADER_SIZE + __display_list_frame()->size)) {
+		stats.dumped_frames++;
+	}
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
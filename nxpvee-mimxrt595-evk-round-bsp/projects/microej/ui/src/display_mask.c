@@ -0,0 +1,200 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Visible area of the round display: table of the visible pixels of each
+ * row and rectangle culling.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <math.h>
+
+#include "display_mask.h"
+#include "display_framebuffer.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+
+// -----------------------------------------------------------------------------
+// Private fields
+// -----------------------------------------------------------------------------
+
+static DISPLAY_MASK_span_t spans[FRAME_BUFFER_HEIGHT];
+
+static int32_t visible_ymin;    // first row with visible pixels
+static int32_t visible_ymax;    // last row with visible pixels
+static int32_t widest_row;      // row with the most visible pixels
+static DISPLAY_MASK_stats_t stats;
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Computes the visible pixels of a row: the pixels touched by the circle.
+ */
+static DISPLAY_MASK_span_t __display_mask_compute_span(int32_t y);
+
+/*
+ * @brief Tells whether the visible pixels of a row overlap the columns [x1, x2].
+ */
+static inline bool __display_mask_overlaps(int32_t y, int32_t x1, int32_t x2);
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void DISPLAY_MASK_initialize(void) {
+	int32_t widest = -1;
+
+	visible_ymin = FRAME_BUFFER_HEIGHT;
+	visible_ymax = -1;
+	widest_row = 0;
+
+	for (int32_t y = 0; y < FRAME_BUFFER_HEIGHT; y++) {
+		DISPLAY_MASK_span_t span = __display_mask_compute_span(y);
+		int32_t width = (int32_t)span.xmax - (int32_t)span.xmin + 1;
+
+		spans[y] = span;
+		if (width > 0) {
+			visible_ymin = MIN(visible_ymin, y);
+			visible_ymax = y;
+			if (width > widest) {
+				widest = width;
+				widest_row = y;
+			}
+		}
+	}
+}
+
+// See the header file for the function documentation
+DISPLAY_MASK_span_t DISPLAY_MASK_get_span(int32_t y) {
+	return spans[y];
+}
+
+// See the header file for the function documentation
+bool DISPLAY_MASK_clip(int* x1, int* y1, int* x2, int* y2) {
+	int32_t top = MAX((int32_t)*y1, visible_ymin);
+	int32_t bottom = MIN((int32_t)*y2, visible_ymax);
+	bool ret = false;
+
+	if (top <= bottom) {
+		// the rows get narrower when moving away from the widest row: the rectangle
+		// row the closest to the widest row holds all the visible columns
+		int32_t row = MIN(MAX(widest_row, top), bottom);
+		int32_t left = MAX((int32_t)*x1, (int32_t)spans[row].xmin);
+		int32_t right = MIN((int32_t)*x2, (int32_t)spans[row].xmax);
+
+		if (left <= right) {
+			// skip the top and bottom rows whose visible pixels are outside the columns
+			while (!__display_mask_overlaps(top, left, right)) {
+				top++;
+			}
+			while (!__display_mask_overlaps(bottom, left, right)) {
+				bottom--;
+			}
+
+			*x1 = (int)left;
+			*y1 = (int)top;
+			*x2 = (int)right;
+			*y2 = (int)bottom;
+			ret = true;
+		}
+	}
+
+	if (!ret) {
+		stats.culled++;
+	}
+
+	return ret;
+}
+
+// See the header file for the function documentation
+bool DISPLAY_MASK_is_display(const void* buffer) {
+	bool ret = false;
+	for (int32_t i = 0; i < FRAME_BUFFER_COUNT; i++) {
+		if (buffer == (const void*)s_frameBufferAddress[i]) {
+			ret = true;
+		}
+	}
+	return ret;
+}
+
+// See the header file for the function documentation
+void DISPLAY_MASK_notify_flush(uint32_t bytes) {
+	stats.frames++;
+	stats.bytes += bytes;
+	stats.last_frame_bytes = bytes;
+	stats.max_frame_bytes = MAX(stats.max_frame_bytes, bytes);
+}
+
+// See the header file for the function documentation
+void DISPLAY_MASK_get_stats(DISPLAY_MASK_stats_t* s) {
+	*s = stats;
+}
+
+// -----------------------------------------------------------------------------
+// Internal functions
+// -----------------------------------------------------------------------------
+
+// See the section 'Internal function definitions' for the function documentation
+static DISPLAY_MASK_span_t __display_mask_compute_span(int32_t y) {
+	DISPLAY_MASK_span_t span = { .xmin = 0, .xmax = FRAME_BUFFER_WIDTH - 1 };
+
+#if defined(DISPLAY_MASK_ENABLED) && (DISPLAY_MASK_ENABLED != 0)
+	const float cx = DISPLAY_MASK_CENTER_X;
+	const float cy = DISPLAY_MASK_CENTER_Y;
+	const float r = DISPLAY_MASK_RADIUS;
+	float dy;
+
+	// vertical distance between the center and the closest point of the row [y, y + 1]
+	if ((float)(y + 1) <= cy) {
+		dy = cy - (float)(y + 1);
+	}
+	else if ((float)y >= cy) {
+		dy = (float)y - cy;
+	}
+	else {
+		dy = 0.f;
+	}
+
+	if (dy >= r) {
+		// row fully outside the circle
+		span.xmin = 1;
+		span.xmax = 0;
+	}
+	else {
+		float half_width = sqrtf((r * r) - (dy * dy));
+		int32_t xmin = (int32_t)floorf(cx - half_width) - DISPLAY_MASK_MARGIN;
+		int32_t xmax = (int32_t)ceilf(cx + half_width) - 1 + DISPLAY_MASK_MARGIN;
+		span.xmin = (int16_t)MAX(xmin, 0);
+		span.xmax = (int16_t)MIN(xmax, FRAME_BUFFER_WIDTH - 1);
+	}
+#else
+	(void)y;
+#endif
+
+	return span;
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static inline bool __display_mask_overlaps(int32_t y, int32_t x1, int32_t x2) {
+	return ((int32_t)spans[y].xmin <= x2) && ((int32_t)spans[y].xmax >= x1);
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -40,6 +40,10 @@ BSP_DECLARE_WEAK_FCNT void DISPLAY_IMPL_error(bool critical, const char* format,
 	while (critical){}
 }
 
+BSP_DECLARE_WEAK_FCNT void DISPLAY_IMPL_notify_drawing(void) {
+	// does nothing by default
+}
+
 BSP_DECLARE_WEAK_FCNT void DISPLAY_IMPL_notify_gpu_start(void) {
 	// does nothing by default
 }
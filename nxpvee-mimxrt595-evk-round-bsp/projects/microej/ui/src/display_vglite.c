@@ -27,6 +27,8 @@
 #include "display_impl.h"
 #include "display_configuration.h"
 #include "color.h"
+#include "osal.h"
+#include "wakeup_latency.h"
 
 #include "vg_lite_hal.h"
 
@@ -59,6 +61,11 @@
  */
 #define VG_LITE_UNKNOWN_FORMAT		((vg_lite_buffer_format_t) -1)
 
+/*
+ * @brief Flag of the vglite operation event: the GPU operation is done
+ */
+#define VG_LITE_OPERATION_DONE		(1u << 0)
+
 /*
  * @brief Width of the Tesselation window
  *
@@ -105,14 +112,51 @@ static bool hardware_rendering;
 static volatile bool vg_lite_operation_wakeup_graphics_engine;
 
 /*
- * @brief vglite operation semaphore
+ * @brief fence of the GPU operation in progress, 0 when there is no operation to wait for
+ */
+static volatile vg_lite_fence_t vg_lite_operation_fence;
+
+/*
+ * @brief command buffer sizing from the usage of each frame
+ */
+static cmdbuf_tuner_t cmdbuf_tuner;
+
+/*
+ * @brief tessellation window sizing from the drawings of each frame
+ */
+static tess_tuner_t tess_tuner;
+
+/*
+ * @brief vglite operation event, waited by the caller of DISPLAY_VGLITE_start_operation()
  */
-static SemaphoreHandle_t vg_lite_operation_semaphore;
+static OSAL_event_handle_t vg_lite_operation_event;
 
 // -----------------------------------------------------------------------------
 // Static Constants
 // -----------------------------------------------------------------------------
 
+/*
+ * @brief Command buffer sizing limits
+ */
+static const cmdbuf_tuner_config_t cmdbuf_tuner_config = {
+		.min_size = CMDBUF_TUNER_MIN_SIZE,
+		.max_size = CMDBUF_TUNER_MAX_SIZE,
+		.granule = CMDBUF_TUNER_GRANULE,
+		.headroom_percent = CMDBUF_TUNER_HEADROOM_PERCENT,
+		.shrink_hold_frames = CMDBUF_TUNER_SHRINK_HOLD_FRAMES,
+};
+
+/*
+ * @brief Tessellation window sizing limits
+ */
+static const tess_tuner_config_t tess_tuner_config = {
+		.min_size = TESS_TUNER_MIN_SIZE,
+		.max_width = TESS_TUNER_MAX_WIDTH,
+		.max_height = TESS_TUNER_MAX_HEIGHT,
+		.max_bytes = TESS_TUNER_MAX_BYTES,
+		.shrink_hold_frames = TESS_TUNER_SHRINK_HOLD_FRAMES,
+};
+
 /*
  * @brief LUT to convert MicroUI image format to VGLite image format
  */
@@ -139,6 +183,14 @@ const vg_lite_buffer_format_t __microui_to_vg_lite_format[] = {
  */
 static void __gpu_irq_callback(void);
 
+/*
+ * @brief Notifies the end of the GPU operation: wakes up the Graphics Engine or
+ * the caller of DISPLAY_VGLITE_start_operation()
+ *
+ * @param[in] under_isr: true when called from the GPU interrupt
+ */
+static void __operation_done(bool under_isr);
+
 /*
  * @brief Configures a vg_lite buffer for a RGB565 image
  *
@@ -161,6 +213,27 @@ static void __buffer_set_address_and_size(MICROUI_Image* image, vg_lite_buffer_t
  */
 static vg_lite_buffer_format_t __convert_format(MICROUI_ImageFormat microui_format);
 
+/*
+ * @brief Configures a source buffer for an indexed image and loads its palette
+ * in the GPU CLUT.
+ *
+ * @param[in] buffer: buffer to configure
+ * @param[in] image: the indexed image
+ * @param[in] bpp: the image bits per pixel
+ *
+ * @return false if the GPU does not support indexed images, true on success
+ */
+static bool __configure_indexed_source(vg_lite_buffer_t *buffer, MICROUI_Image* image, uint32_t bpp);
+
+/*
+ * @brief Configures a source buffer for a premultiplied image.
+ *
+ * @param[in] buffer: buffer to configure
+ * @param[in] image: the premultiplied image
+ * @param[in] bpp: the image bits per pixel
+ */
+static void __configure_premultiplied_source(vg_lite_buffer_t *buffer, MICROUI_Image* image, uint32_t bpp);
+
 // -----------------------------------------------------------------------------
 // display_vglite.h functions
 // -----------------------------------------------------------------------------
@@ -192,9 +265,69 @@ void DISPLAY_VGLITE_init(void) {
 	// Enable by default hardware rendering
 	DISPLAY_VGLITE_enable_hardware_rendering();
 
-	vg_lite_operation_semaphore = xSemaphoreCreateBinary();
+	if (OSAL_OK != OSAL_event_create((uint8_t*)"vglite", &vg_lite_operation_event)) {
+		DISPLAY_IMPL_error(true, "failed to create the vglite operation event");
+	}
 
 	vg_lite_hal_register_irq_callback(&__gpu_irq_callback);
+
+	vg_lite_command_stats_t command_stats;
+	(void)vg_lite_get_command_stats(&command_stats, 1);
+	cmdbuf_tuner_init(&cmdbuf_tuner, &cmdbuf_tuner_config, command_stats.size);
+
+	vg_lite_tessellation_stats_t tessellation_stats;
+	(void)vg_lite_get_tessellation_stats(&tessellation_stats, 1);
+	tess_tuner_init(&tess_tuner, &tess_tuner_config, tessellation_stats.width, tessellation_stats.height);
+}
+
+// See the header file for the function documentation
+void DISPLAY_VGLITE_frame_done(void) {
+	vg_lite_command_stats_t command_stats;
+
+	(void)vg_lite_get_command_stats(&command_stats, 1);
+	uint32_t size = cmdbuf_tuner_on_frame(&cmdbuf_tuner, command_stats.bytes, command_stats.flushes,
+			command_stats.forced_flushes, command_stats.peak_usage);
+
+#if defined (CMDBUF_TUNER_ENABLED) && (CMDBUF_TUNER_ENABLED != 0)
+	if (size != command_stats.size) {
+		// the previous size is kept when the VGLite heap cannot hold the new one
+		(void)vg_lite_set_command_buffer_size(size);
+		(void)vg_lite_get_command_stats(&command_stats, 1);
+		cmdbuf_tuner_set_size(&cmdbuf_tuner, command_stats.size);
+	}
+#else
+	(void)size;
+#endif
+
+	vg_lite_tessellation_stats_t tessellation_stats;
+	uint32_t width;
+	uint32_t height;
+
+	(void)vg_lite_get_tessellation_stats(&tessellation_stats, 1);
+	tess_tuner_on_frame(&tess_tuner, tessellation_stats.draws, tessellation_stats.passes, tessellation_stats.split_draws,
+			tessellation_stats.max_passes, tessellation_stats.max_width, tessellation_stats.max_height, &width, &height);
+
+#if defined (TESS_TUNER_ENABLED) && (TESS_TUNER_ENABLED != 0)
+	if ((width != tessellation_stats.width) || (height != tessellation_stats.height)) {
+		// the previous window is kept when the VGLite heap cannot hold the new one
+		(void)vg_lite_set_tessellation_size(width, height);
+		(void)vg_lite_get_tessellation_stats(&tessellation_stats, 1);
+		tess_tuner_set_size(&tess_tuner, tessellation_stats.width, tessellation_stats.height);
+	}
+#else
+	(void)width;
+	(void)height;
+#endif
+}
+
+// See the header file for the function documentation
+void DISPLAY_VGLITE_get_command_buffer_stats(cmdbuf_tuner_stats_t* stats) {
+	cmdbuf_tuner_get_stats(&cmdbuf_tuner, stats);
+}
+
+// See the header file for the function documentation
+void DISPLAY_VGLITE_get_tessellation_stats(tess_tuner_stats_t* stats) {
+	tess_tuner_get_stats(&tess_tuner, stats);
 }
 
 // See the header file for the function documentation
@@ -259,9 +392,18 @@ bool DISPLAY_VGLITE_configure_source(vg_lite_buffer_t *buffer, MICROUI_Image* im
 	if (!LLUI_DISPLAY_isLCD(image)){ // else: frame buffer does not respect VGLite alignment
 #endif
 
-		vg_lite_buffer_format_t format = __convert_format((MICROUI_ImageFormat)image->format);
+		vg_lite_buffer_format_t format = __convert_format((MICROUI_ImageFormat)(uint8_t)image->format);
+		uint32_t indexed_bpp = DISPLAY_VGLITE_get_indexed_bpp(image);
+		uint32_t premultiplied_bpp = DISPLAY_VGLITE_get_premultiplied_bpp(image);
 
-		if (VG_LITE_UNKNOWN_FORMAT != format) {
+		if ((uint32_t)0 != indexed_bpp) {
+			ret = __configure_indexed_source(buffer, image, indexed_bpp);
+		}
+		else if ((uint32_t)0 != premultiplied_bpp) {
+			__configure_premultiplied_source(buffer, image, premultiplied_bpp);
+			ret = true;
+		}
+		else if (VG_LITE_UNKNOWN_FORMAT != format) {
 
 			__buffer_default_configuration(buffer);
 			__buffer_set_address_and_size(image, buffer);
@@ -281,16 +423,34 @@ bool DISPLAY_VGLITE_configure_source(vg_lite_buffer_t *buffer, MICROUI_Image* im
 
 // See the header file for the function documentation
 void DISPLAY_VGLITE_start_operation(bool wakeup_graphics_engine) {
+	vg_lite_fence_t fence;
+	bool done;
+
 	DISPLAY_IMPL_notify_gpu_start();
 	vg_lite_operation_wakeup_graphics_engine = wakeup_graphics_engine;
 
 	// VG drawing has been added to the GPU commands list: ask to start VG operation
-	vg_lite_flush();
+	// (queued behind the command buffers the GPU is still executing)
+	(void)vg_lite_flush_async(&fence);
+
+	// only the interrupt of this fence ends the operation; the GPU may already
+	// have executed it
+	taskENTER_CRITICAL();
+	done = (0 != vg_lite_fence_is_signaled(fence));
+	if (!done) {
+		vg_lite_operation_fence = fence;
+	}
+	taskEXIT_CRITICAL();
+
+	if (done) {
+		__operation_done(false);
+	}
 
 	if (!wakeup_graphics_engine) {
 		// active waiting until the GPU interrupt is thrown
 
-		(void)xSemaphoreTake(vg_lite_operation_semaphore, portMAX_DELAY);
+		(void)OSAL_event_wait(&vg_lite_operation_event, VG_LITE_OPERATION_DONE, NULL, OSAL_INFINITE_TIME);
+		WAKEUP_LATENCY_woken(WAKEUP_LATENCY_GPU);
 	}
 }
 
@@ -337,25 +497,35 @@ void vg_lite_draw_notify_render_area(uint32_t x, uint32_t y, uint32_t right, uin
 
 // See the section 'Internal function definitions' for the function documentation
 static void __gpu_irq_callback(void) {
-	portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
-
 	uint8_t it = interrupt_enter();
+	vg_lite_fence_t fence = vg_lite_operation_fence;
+
+	// ignore the interrupts of the other command buffers (previous operations,
+	// full command buffers flushed in the middle of a drawing)
+	if (((vg_lite_fence_t)0 != fence) && (0 != vg_lite_fence_is_signaled(fence))) {
+		vg_lite_operation_fence = 0;
+		__operation_done(true);
+	}
+
+	interrupt_leave(it);
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static void __operation_done(bool under_isr) {
 	DISPLAY_IMPL_notify_gpu_stop();
 
 	if (vg_lite_operation_wakeup_graphics_engine) {
 		// wake up the Graphics Engine
-		LLUI_DISPLAY_notifyAsynchronousDrawingEnd(true);
+		LLUI_DISPLAY_notifyAsynchronousDrawingEnd(under_isr);
 	}
-	else {
+	else if (under_isr) {
 		// wake up the caller of DISPLAY_VGLITE_start_operation()
-		xSemaphoreGiveFromISR(vg_lite_operation_semaphore, &xHigherPriorityTaskWoken);
-		if(xHigherPriorityTaskWoken != pdFALSE ) {
-			// Force a context switch here.
-			portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-		}
+		WAKEUP_LATENCY_signal(WAKEUP_LATENCY_GPU);
+		(void)OSAL_event_set_from_isr(&vg_lite_operation_event, VG_LITE_OPERATION_DONE);
+	}
+	else {
+		(void)OSAL_event_set(&vg_lite_operation_event, VG_LITE_OPERATION_DONE);
 	}
-	interrupt_leave(it);
-
 }
 
 // See the section 'Internal function definitions' for the function documentation
@@ -384,6 +554,56 @@ static void __buffer_set_address_and_size(MICROUI_Image* image, vg_lite_buffer_t
 	b->address = (uint32_t)LLUI_DISPLAY_getBufferAddress(image);
 }
 
+// See the section 'Internal function definitions' for the function documentation
+static bool __configure_indexed_source(vg_lite_buffer_t *buffer, MICROUI_Image* image, uint32_t bpp) {
+	bool ret = false;
+	vg_lite_buffer_format_t format = (bpp == (uint32_t)2) ? VG_LITE_INDEX_2 : ((bpp == (uint32_t)4) ? VG_LITE_INDEX_4 : VG_LITE_INDEX_8);
+
+	// the CLUT is a GPU state: it is pushed in the command buffer before the blit
+	if (VG_LITE_SUCCESS == vg_lite_set_CLUT((uint32_t)1 << bpp, DISPLAY_VGLITE_get_clut(image))) {
+		__buffer_default_configuration(buffer);
+		buffer->width = image->width;
+		buffer->height = image->height;
+		buffer->stride = DISPLAY_VGLITE_INDEXED_STRIDE(image->width, bpp);
+		buffer->memory = (void*)DISPLAY_VGLITE_get_indexes(image);
+		buffer->address = (uint32_t)buffer->memory;
+		buffer->image_mode = VG_LITE_MULTIPLY_IMAGE_MODE;
+		buffer->transparency_mode = VG_LITE_IMAGE_TRANSPARENT;
+		buffer->format = format;
+		ret = true;
+	}
+	// else: no index format on this GPU
+
+	return ret;
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static void __configure_premultiplied_source(vg_lite_buffer_t *buffer, MICROUI_Image* image, uint32_t bpp) {
+	MICROUI_ImageFormat format;
+
+	switch ((MICROUI_ImageFormat)(uint8_t)image->format) {
+	case DISPLAY_VGLITE_IMAGE_FORMAT_ARGB8888_PRE:
+		format = MICROUI_IMAGE_FORMAT_ARGB8888;
+		break;
+	case DISPLAY_VGLITE_IMAGE_FORMAT_ARGB4444_PRE:
+		format = MICROUI_IMAGE_FORMAT_ARGB4444;
+		break;
+	default:
+		format = MICROUI_IMAGE_FORMAT_ARGB1555;
+		break;
+	}
+
+	__buffer_default_configuration(buffer);
+	__buffer_set_address_and_size(image, buffer);
+
+	// no premultiply state to change: without the PE premultiply feature (GCNanoLite-V),
+	// vg_lite_blit() flags the RGBA sources as premultiplied
+	buffer->image_mode = VG_LITE_MULTIPLY_IMAGE_MODE;
+	buffer->transparency_mode = VG_LITE_IMAGE_TRANSPARENT;
+	buffer->format = __convert_format(format);
+	buffer->stride = DISPLAY_VGLITE_PREMULTIPLIED_STRIDE(image->width, bpp);
+}
+
 // See the section 'Internal function definitions' for the function documentation
 vg_lite_buffer_format_t __convert_format(MICROUI_ImageFormat microui_format) {
 	vg_lite_buffer_format_t vg_lite_format = VG_LITE_UNKNOWN_FORMAT;
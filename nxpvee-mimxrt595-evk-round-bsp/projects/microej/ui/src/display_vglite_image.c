@@ -0,0 +1,137 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Layouts of the indexed and premultiplied images of display_vglite.h
+ * (CLUT, indexes and pixels), shared by the GPU configuration and the software
+ * drawings.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include <LLUI_DISPLAY.h>
+
+#include "display_vglite.h"
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+uint32_t DISPLAY_VGLITE_get_indexed_bpp(MICROUI_Image* image) {
+	uint32_t bpp;
+
+	// jbyte is signed: the custom formats (0xf8 to 0xff) are read unsigned
+	switch ((MICROUI_ImageFormat)(uint8_t)image->format) {
+	case DISPLAY_VGLITE_IMAGE_FORMAT_INDEX2:
+		bpp = 2;
+		break;
+	case DISPLAY_VGLITE_IMAGE_FORMAT_INDEX4:
+		bpp = 4;
+		break;
+	case DISPLAY_VGLITE_IMAGE_FORMAT_INDEX8:
+		bpp = 8;
+		break;
+	default:
+		bpp = 0;
+		break;
+	}
+
+	return bpp;
+}
+
+// See the header file for the function documentation
+uint32_t* DISPLAY_VGLITE_get_clut(MICROUI_Image* image) {
+	return (uint32_t*)LLUI_DISPLAY_getBufferAddress(image);
+}
+
+// See the header file for the function documentation
+uint8_t* DISPLAY_VGLITE_get_indexes(MICROUI_Image* image) {
+	return (uint8_t*)LLUI_DISPLAY_getBufferAddress(image) + DISPLAY_VGLITE_CLUT_SIZE(DISPLAY_VGLITE_get_indexed_bpp(image));
+}
+
+// See the header file for the function documentation
+uint32_t DISPLAY_VGLITE_read_indexed_pixel(MICROUI_Image* image, uint32_t x, uint32_t y) {
+	uint32_t bpp = DISPLAY_VGLITE_get_indexed_bpp(image);
+	const uint8_t* line = DISPLAY_VGLITE_get_indexes(image) + (y * DISPLAY_VGLITE_INDEXED_STRIDE(image->width, bpp));
+	uint32_t pixels_per_byte = (uint32_t)8 / bpp;
+	uint32_t index = ((uint32_t)line[x / pixels_per_byte] >> ((x % pixels_per_byte) * bpp)) & (((uint32_t)1 << bpp) - (uint32_t)1);
+
+	return DISPLAY_VGLITE_get_clut(image)[index];
+}
+
+// See the header file for the function documentation
+uint32_t DISPLAY_VGLITE_get_premultiplied_bpp(MICROUI_Image* image) {
+	uint32_t bpp;
+
+	switch ((MICROUI_ImageFormat)(uint8_t)image->format) {
+	case DISPLAY_VGLITE_IMAGE_FORMAT_ARGB8888_PRE:
+		bpp = 32;
+		break;
+	case DISPLAY_VGLITE_IMAGE_FORMAT_ARGB4444_PRE:
+	case DISPLAY_VGLITE_IMAGE_FORMAT_ARGB1555_PRE:
+		bpp = 16;
+		break;
+	default:
+		bpp = 0;
+		break;
+	}
+
+	return bpp;
+}
+
+// See the header file for the function documentation
+uint32_t DISPLAY_VGLITE_read_premultiplied_pixel(MICROUI_Image* image, uint32_t x, uint32_t y) {
+	uint32_t bpp = DISPLAY_VGLITE_get_premultiplied_bpp(image);
+	const uint8_t* line = (const uint8_t*)LLUI_DISPLAY_getBufferAddress(image) + (y * DISPLAY_VGLITE_PREMULTIPLIED_STRIDE(image->width, bpp));
+	uint32_t color;
+
+	if ((uint32_t)32 == bpp) {
+		color = ((const uint32_t*)line)[x];
+	}
+	else {
+		uint32_t pixel = ((const uint16_t*)line)[x];
+
+		if (DISPLAY_VGLITE_IMAGE_FORMAT_ARGB4444_PRE == (MICROUI_ImageFormat)(uint8_t)image->format) {
+			// 0xN -> 0xNN
+			color = ((pixel & (uint32_t)0xf000) << 12) | ((pixel & (uint32_t)0x0f00) << 8) | ((pixel & (uint32_t)0x00f0) << 4) | (pixel & (uint32_t)0x000f);
+			color |= color << 4;
+		}
+		else {
+			// the transparent pixels are black
+			uint32_t red = (pixel >> 10) & (uint32_t)0x1f;
+			uint32_t green = (pixel >> 5) & (uint32_t)0x1f;
+			uint32_t blue = pixel & (uint32_t)0x1f;
+			color = ((pixel & (uint32_t)0x8000) != (uint32_t)0) ? (uint32_t)0xff000000 : (uint32_t)0;
+			color |= (((red << 3) | (red >> 2)) << 16) | (((green << 3) | (green >> 2)) << 8) | ((blue << 3) | (blue >> 2));
+		}
+	}
+
+	return color;
+}
+
+// See the header file for the function documentation
+uint32_t DISPLAY_VGLITE_scale_premultiplied(uint32_t color, uint32_t factor) {
+	// red and blue, then alpha and green: two channels per multiplication
+	uint32_t rb = (((color & (uint32_t)0x00ff00ff) * factor) >> 8) & (uint32_t)0x00ff00ff;
+	uint32_t ag = (((color >> 8) & (uint32_t)0x00ff00ff) * factor) & (uint32_t)0xff00ff00;
+	return ag | rb;
+}
+
+// See the header file for the function documentation
+uint32_t DISPLAY_VGLITE_blend_premultiplied(uint32_t color, uint32_t background) {
+	return color + DISPLAY_VGLITE_scale_premultiplied(background, (uint32_t)256 - DISPLAY_VGLITE_ALPHA_FACTOR(color >> 24));
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -16,6 +16,8 @@
 // Includes
 // -----------------------------------------------------------------------------
 
+#include <string.h>
+
 #include <LLUI_DISPLAY.h>
 
 #include "ui_drawing_soft.h"
@@ -25,6 +27,7 @@
 
 #include "display_configuration.h"
 #include "display_impl.h"
+#include "display_mask.h"
 #include "display_vglite.h"
 #include "vglite_path.h"
 
@@ -52,10 +55,12 @@
 static union {
 	vglite_path_line_t line; // line
 	vglite_path_thick_shape_line_t thick_shape_line; // thick shape line
+	vglite_path_thick_shape_line_band_t thick_shape_line_band; // fade band of a thick shape line
 	vglite_path_ellipse_t ellipse[2]; // ellipse (in & out)
 	vglite_path_ellipse_arc_t ellipse_arc; // ellipse arc
 	vglite_path_rounded_rectangle_t rounded_rectangle[2]; // round rect (in & out)
 	vglite_path_thick_ellipse_arc_t thick_ellipse_arc; // anti aliased ellipse arc
+	vglite_path_thick_ellipse_arc_band_t thick_ellipse_arc_band; // fade band of a thick ellipse arc
 } __shape_paths;
 
 /*
@@ -234,6 +239,165 @@ static DRAWING_Status __draw_thick_shape_ellipse_arc(
 		DRAWING_Cap start,
 		DRAWING_Cap end);
 
+/*
+ * @brief Draws the path of a thick arc without starting the GPU operation.
+ *
+ * @param[in] target: the drawer target
+ * @param[in] center_x: the horizontal coordinate of the arc center
+ * @param[in] center_y: the vertical coordinate of the arc center
+ * @param[in] diameter_w: the horizontal diameter in half pixels
+ * @param[in] diameter_h: the vertical diameter in half pixels
+ * @param[in] thickness: the arc thickness in half pixels
+ * @param[in] start_angle_deg: the beginning angle of the arc to draw
+ * @param[in] arc_angle: the angular extent of the arc from start_angle_deg
+ * @param[in] caps: the VGLITE_PATH caps
+ * @param[in] color: the arc color
+ *
+ * @return the VGLite error.
+ */
+static vg_lite_error_t __draw_thick_arc_path(
+		void* target,
+		int center_x,
+		int center_y,
+		int diameter_w,
+		int diameter_h,
+		int thickness,
+		float start_angle_deg,
+		float arc_angle,
+		int caps,
+		vg_lite_color_t color);
+
+/*
+ * @brief Draws the band between two thick arcs of the same diameter without
+ * starting the GPU operation.
+ *
+ * @param[in] target ... diameter_h: see __draw_thick_arc_path()
+ * @param[in] thickness_out: the thickness of the outer arc in half pixels
+ * @param[in] thickness_in: the thickness of the inner arc in half pixels
+ * @param[in] start_angle_deg ... color: see __draw_thick_arc_path()
+ *
+ * @return the VGLite error.
+ */
+static vg_lite_error_t __draw_thick_arc_band(
+		void* target,
+		int center_x,
+		int center_y,
+		int diameter_w,
+		int diameter_h,
+		int thickness_out,
+		int thickness_in,
+		float start_angle_deg,
+		float arc_angle,
+		int caps,
+		vg_lite_color_t color);
+
+/*
+ * @brief Draws a ring (or a filled ellipse) without starting the GPU operation.
+ *
+ * @param[in] target: the drawer target
+ * @param[in] matrix: the matrix that places the ring center (scaled by DRAWING_SCALE_DIV)
+ * @param[in] diameter_out_w: the outer horizontal diameter (radius in half pixels)
+ * @param[in] diameter_out_h: the outer vertical diameter
+ * @param[in] diameter_in_w: the inner horizontal diameter (<= 0 to fill the ellipse)
+ * @param[in] diameter_in_h: the inner vertical diameter
+ * @param[in] color: the ring color
+ *
+ * @return the VGLite error.
+ */
+static vg_lite_error_t __draw_ring(
+		void* target,
+		vg_lite_matrix_t* matrix,
+		int diameter_out_w, int diameter_out_h,
+		int diameter_in_w, int diameter_in_h,
+		vg_lite_color_t color);
+
+/*
+ * @brief Gets the color of a fade band.
+ *
+ * The alpha decreases linearly from the shape edge: the band is covered at the
+ * level of its middle. The bands are one pixel wide: where a band edge is a pixel
+ * edge, the pixels get the ramp at their center. Thinner bands would not smooth
+ * the ramp: two bands sharing a pixel are blended one over the other by the GPU
+ * antialiasing, which darkens the pixel (see test_faded_drawings.c).
+ *
+ * @param[in] target: the drawer target
+ * @param[in] color: the shape color
+ * @param[in] band: the band index, 0 for the band next to the shape
+ * @param[in] fade: the fade width in pixels (number of bands)
+ *
+ * @return the band color ready for the GPU.
+ */
+static vg_lite_color_t __get_fade_color(void* target, jint color, int band, int fade);
+
+/*
+ * @brief Draws a thick faded ellipse using the GPU: the ring (or the filled
+ * ellipse) and one concentric one-pixel band per fade pixel on each side.
+ *
+ * @param[in] gc: the MicroUI GraphicsContext target.
+ * @param[in] x: the x coordinate of the upper-left corner of the ellipse line
+ * @param[in] y: the y coordinate of the upper-left corner of the ellipse line
+ * @param[in] width: the horizontal diameter of the ellipse line (0 for a point)
+ * @param[in] height: the vertical diameter of the ellipse line (0 for a point)
+ * @param[in] thickness: the ellipse line thickness.
+ * @param[in] fade: the fade width in pixels.
+ *
+ * @return the drawing status.
+ */
+static DRAWING_Status __draw_faded_ellipse(
+		MICROUI_GraphicsContext* gc,
+		int x, int y,
+		int width, int height,
+		int thickness, int fade);
+
+/*
+ * @brief Draws a thick faded line using the GPU.
+ *
+ * Without rounded cap, the line is widened by the fade on each side and filled
+ * with a linear gradient across its width. With a rounded cap (no radial gradient
+ * on this GPU), the line is drawn with one one-pixel band per fade pixel around
+ * it, rounded caps included.
+ *
+ * @param[in] gc ... end: see __thick_line()
+ * @param[in] fade: the fade width in pixels.
+ *
+ * @return the drawing status.
+ */
+static DRAWING_Status __draw_faded_line(
+		MICROUI_GraphicsContext* gc,
+		int x1,
+		int y1,
+		int x2,
+		int y2,
+		int thickness,
+		int fade,
+		DRAWING_Cap start,
+		DRAWING_Cap end);
+
+/*
+ * @brief Draws a thick faded circle arc using the GPU: the arc and one one-pixel
+ * band per fade pixel around it. The fade follows the caps:
+ * it goes around the rounded caps and stops at the other caps.
+ *
+ * The fade must not reach the arc center (thickness + 2 * fade < diameter).
+ *
+ * @param[in] gc ... thickness: see __draw_thick_shape_ellipse_arc()
+ * @param[in] fade: the fade width in pixels.
+ * @param[in] start ... end: see __draw_thick_shape_ellipse_arc()
+ *
+ * @return the drawing status.
+ */
+static DRAWING_Status __draw_faded_circle_arc(
+		MICROUI_GraphicsContext* gc,
+		int x,
+		int y,
+		int diameter,
+		float start_angle_deg,
+		float arc_angle,
+		int thickness,
+		int fade,
+		DRAWING_Cap start,
+		DRAWING_Cap end);
+
 /*
  * @brief Rotates an image using the GPU
  *
@@ -331,6 +495,21 @@ static bool __prepare_gpu_draw_image(MICROUI_GraphicsContext* gc, MICROUI_Image*
  */
 static void __soft_draw_image(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x_src, jint y_src, jint width, jint height, jint x_dest, jint y_dest, jint alpha);
 
+/*
+ * Draws a region of an indexed image (see DISPLAY_VGLITE_IMAGE_FORMAT_INDEX2) without the GPU.
+ *
+ * @param[in] gc ... alpha: see __soft_draw_image()
+ */
+static void __soft_draw_indexed_image(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x_src, jint y_src, jint width, jint height, jint x_dest, jint y_dest, jint alpha);
+
+/*
+ * Draws a region of a premultiplied image (see DISPLAY_VGLITE_IMAGE_FORMAT_ARGB8888_PRE)
+ * without the GPU.
+ *
+ * @param[in] gc ... alpha: see __soft_draw_image()
+ */
+static void __soft_draw_premultiplied_image(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x_src, jint y_src, jint width, jint height, jint x_dest, jint y_dest, jint alpha);
+
 /*
  * Draws a region of an image at another position by using the GPU.
  *
@@ -899,14 +1078,16 @@ DRAWING_Status DW_DRAWING_drawThickFadedPoint(
 		jint fade) {
 
 	DRAWING_Status ret;
-	if ((fade > 1) // No radial gradient with hardware
 #ifdef VGLITE_OPTION_TOGGLE_GPU
-			|| !DISPLAY_VGLITE_is_hardware_rendering_enabled()
-#endif // VGLITE_OPTION_TOGGLE_GPU
-	) {
+	if (!DISPLAY_VGLITE_is_hardware_rendering_enabled()) {
 		DW_DRAWING_SOFT_drawThickFadedPoint(gc, x, y, thickness,fade);
 		ret = DRAWING_DONE;
 	}
+	else
+#endif // VGLITE_OPTION_TOGGLE_GPU
+	if (fade > 1) {
+		ret = __draw_faded_ellipse(gc, x, y, 0, 0, thickness, fade);
+	}
 	else{
 		ret = __fill_ellipse(gc, x - (thickness/2), y - (thickness/2), thickness, thickness);
 	}
@@ -926,15 +1107,17 @@ DRAWING_Status DW_DRAWING_drawThickFadedLine(
 		DRAWING_Cap end) {
 	DRAWING_Status ret;
 
-	if ((fade > 1) // No radial gradient with hardware
 #ifdef VGLITE_OPTION_TOGGLE_GPU
-			|| !DISPLAY_VGLITE_is_hardware_rendering_enabled()
-#endif // VGLITE_OPTION_TOGGLE_GPU
-	) {
+	if (!DISPLAY_VGLITE_is_hardware_rendering_enabled()) {
 		DW_DRAWING_SOFT_drawThickFadedLine(
 				gc, x1, y1, x2, y2, thickness, fade, start, end);
 		ret = DRAWING_DONE;
 	}
+	else
+#endif // VGLITE_OPTION_TOGGLE_GPU
+	if (fade > 1) {
+		ret = __draw_faded_line(gc, x1, y1, x2, y2, thickness, fade, start, end);
+	}
 	else {
 		ret = __thick_line(
 				gc,
@@ -960,15 +1143,17 @@ DRAWING_Status DW_DRAWING_drawThickFadedCircle(
 	int diameter_in;
 	DRAWING_Status ret;
 
-	if ((fade > 1) // No radial gradient with hardware
 #ifdef VGLITE_OPTION_TOGGLE_GPU
-			|| !DISPLAY_VGLITE_is_hardware_rendering_enabled()
-#endif // VGLITE_OPTION_TOGGLE_GPU
-	) {
+	if (!DISPLAY_VGLITE_is_hardware_rendering_enabled()) {
 		DW_DRAWING_SOFT_drawThickFadedCircle(
 				gc, x, y, diameter, thickness, fade);
 		ret = DRAWING_DONE;
 	}
+	else
+#endif // VGLITE_OPTION_TOGGLE_GPU
+	if (fade > 1) {
+		ret = __draw_faded_ellipse(gc, x, y, diameter, diameter, thickness, fade);
+	}
 	else {
 
 		diameter_out = diameter + thickness;
@@ -998,7 +1183,7 @@ DRAWING_Status DW_DRAWING_drawThickFadedCircleArc(
 		DRAWING_Cap end) {
 	DRAWING_Status ret;
 
-	if ((fade > 1) // No radial gradient with hardware
+	if (((fade > 1) && ((thickness + (2 * fade)) >= diameter)) // the fade bands would cross the center
 #ifdef VGLITE_OPTION_TOGGLE_GPU
 			|| !DISPLAY_VGLITE_is_hardware_rendering_enabled()
 #endif // VGLITE_OPTION_TOGGLE_GPU
@@ -1015,6 +1200,15 @@ DRAWING_Status DW_DRAWING_drawThickFadedCircleArc(
 				end );
 		ret = DRAWING_DONE;
 	}
+	else if (fade > 1) {
+		ret = __draw_faded_circle_arc(
+				gc,
+				x, y,
+				diameter,
+				start_angle_deg, arc_angle,
+				thickness, fade,
+				start, end);
+	}
 	else {
 		ret = __draw_thick_shape_ellipse_arc(
 				gc,
@@ -1041,11 +1235,8 @@ DRAWING_Status DW_DRAWING_drawThickFadedEllipse(
 	int diameter_in_h;
 	DRAWING_Status ret;
 
-	if ((fade > 1) // No radial gradient with hardware
 #ifdef VGLITE_OPTION_TOGGLE_GPU
-			|| !DISPLAY_VGLITE_is_hardware_rendering_enabled()
-#endif // VGLITE_OPTION_TOGGLE_GPU
-	) {
+	if (!DISPLAY_VGLITE_is_hardware_rendering_enabled()) {
 		DW_DRAWING_SOFT_drawThickFadedEllipse(
 				gc,
 				x, y,
@@ -1053,6 +1244,11 @@ DRAWING_Status DW_DRAWING_drawThickFadedEllipse(
 				thickness, fade);
 		ret = DRAWING_DONE;
 	}
+	else
+#endif // VGLITE_OPTION_TOGGLE_GPU
+	if (fade > 1) {
+		ret = __draw_faded_ellipse(gc, x, y, width, height, thickness, fade);
+	}
 	else {
 
 		diameter_out_w = width + thickness;
@@ -1528,42 +1724,52 @@ static bool __check_clip(
 		int y2,
 		bool update_drawing_limits) {
 	bool ret;
+	bool scissor = LLUI_DISPLAY_isClipEnabled(gc);
+	int clip_x1 = gc->clip_x1;
+	int clip_y1 = gc->clip_y1;
+	int clip_x2 = gc->clip_x2;
+	int clip_y2 = gc->clip_y2;
 
-	if (LLUI_DISPLAY_isClipEnabled(gc))	{
+	if (scissor) {
+		// false when drawing is fully outside the clip, nothing to draw
+		ret = LLUI_DISPLAY_clipRectangle(gc, &x1, &y1, &x2, &y2);
+	}
+	else {
+		// clip is disabled (vglite lib already crops to the buffer bounds)
+		ret = true;
+	}
 
-		if (LLUI_DISPLAY_clipRectangle(gc, &x1, &y1, &x2, &y2)) {
-			// drawing fully or partially fits the clip:
+#if defined(DISPLAY_MASK_ENABLED) && (DISPLAY_MASK_ENABLED != 0)
+	if (ret && DISPLAY_MASK_is_display(LLUI_DISPLAY_getBufferAddress(&gc->image))) {
+		// the corners of the round display are not visible: cull the drawings fully
+		// outside the visible area and narrow the scissor to the visible part of the clip
+		if (!scissor) {
+			clip_x1 = 0;
+			clip_y1 = 0;
+			clip_x2 = gc->image.width - 1;
+			clip_y2 = gc->image.height - 1;
+			scissor = true;
+		}
+		ret = DISPLAY_MASK_clip(&x1, &y1, &x2, &y2) && DISPLAY_MASK_clip(&clip_x1, &clip_y1, &clip_x2, &clip_y2);
+	}
+#endif
+
+	if (ret) {
+		// drawing fully or partially fits the clip:
 
+		if (scissor) {
 			// enable scissor for next vglite drawing
 			vg_lite_enable_scissor();
-			vg_lite_set_scissor(gc->clip_x1, gc->clip_y1, gc->clip_x2 - gc->clip_x1 + 1, gc->clip_y2 - gc->clip_y1 + 1);
-
-			if (update_drawing_limits) {
-				// update flush limits (cropped to the clip)
-				LLUI_DISPLAY_setDrawingLimits(x1, y1, x2, y2);
-			}
-
-			// perform drawing
-			ret = true;
+			vg_lite_set_scissor(clip_x1, clip_y1, clip_x2 - clip_x1 + 1, clip_y2 - clip_y1 + 1);
 		}
 		else {
-			// drawing is fully outside the clip, nothing to draw
-			ret = false;
+			vg_lite_disable_scissor();
 		}
-	}
-	else {
-		// clip is disabled :
-
-		// disable scissor (vglite lib already crops to the buffer bounds)
-		vg_lite_disable_scissor();
 
 		if (update_drawing_limits) {
-			// update flush limits
+			// update flush limits (cropped to the clip)
 			LLUI_DISPLAY_setDrawingLimits(x1, y1, x2, y2);
 		}
-
-		// perform drawing
-		ret = true;
 	}
 
 	return ret;
@@ -1906,7 +2112,6 @@ static DRAWING_Status __draw_thick_shape_ellipse_arc(
 		DRAWING_Cap start,
 		DRAWING_Cap end) {
 
-	vg_lite_path_t shape_vg_path;
 	DRAWING_Status ret;
 
 	// Check if there is something to draw and clip drawing limits
@@ -1922,40 +2127,423 @@ static DRAWING_Status __draw_thick_shape_ellipse_arc(
 		int m_diameter_w = diameter_w + 1;
 		int m_diameter_h = diameter_h + 1;
 		int m_thickness = thickness + 1;
-		int translate_x = x + (m_diameter_w / 2);
-		int translate_y = y + (m_diameter_h / 2);
-
-		vg_lite_matrix_t matrix;
-		vg_lite_identity(&matrix);
-		vg_lite_translate(translate_x, translate_y, &matrix);
-		vg_lite_rotate(-start_angle_deg, &matrix);
-		vg_lite_scale(DRAWING_SCALE_DIV, DRAWING_SCALE_DIV, &matrix);
 
 		int caps = 0;
 		caps |= MEJ_VGLITE_PATH_SET_CAPS_START(start);
 		caps |= MEJ_VGLITE_PATH_SET_CAPS_END(end);
 
-		// Compute the thick shape path
-		shape_vg_path.path = &__shape_paths.thick_ellipse_arc;
-		shape_vg_path.path_length = sizeof(__shape_paths.thick_ellipse_arc);
-
-		(void)VGLITE_PATH_compute_thick_shape_ellipse_arc(
-				&shape_vg_path,
+		void* target = VG_DRAWER_configure_target(gc);
+		vg_lite_error_t vg_lite_error = __draw_thick_arc_path(
+				target,
+				x + (m_diameter_w / 2),
+				y + (m_diameter_h / 2),
 				DRAWING_SCALE_FACTOR * m_diameter_w,
 				DRAWING_SCALE_FACTOR * m_diameter_h,
 				DRAWING_SCALE_FACTOR * m_thickness,
-				0,
+				start_angle_deg,
 				arc_angle,
-				caps);
+				caps,
+				gc->foreground_color);
+		ret = VG_DRAWER_post_operation(target, vg_lite_error);
+	}
+	else {
+		ret = DRAWING_DONE;
+	}
+	return ret;
+}
 
-		void* target = VG_DRAWER_configure_target(gc);
-		vg_lite_error_t vg_lite_error = VG_DRAWER_draw_path(
+// See the section 'Internal function definitions' for the function documentation
+static vg_lite_error_t __draw_thick_arc_path(
+		void* target,
+		int center_x,
+		int center_y,
+		int diameter_w,
+		int diameter_h,
+		int thickness,
+		float start_angle_deg,
+		float arc_angle,
+		int caps,
+		vg_lite_color_t color) {
+
+	vg_lite_path_t shape_vg_path;
+	vg_lite_matrix_t matrix;
+
+	vg_lite_identity(&matrix);
+	vg_lite_translate(center_x, center_y, &matrix);
+	vg_lite_rotate(-start_angle_deg, &matrix);
+	vg_lite_scale(DRAWING_SCALE_DIV, DRAWING_SCALE_DIV, &matrix);
+
+	// Compute the thick shape path
+	shape_vg_path.path = &__shape_paths.thick_ellipse_arc;
+	shape_vg_path.path_length = sizeof(__shape_paths.thick_ellipse_arc);
+
+	(void)VGLITE_PATH_compute_thick_shape_ellipse_arc(
+			&shape_vg_path,
+			diameter_w,
+			diameter_h,
+			thickness,
+			0,
+			arc_angle,
+			caps);
+
+	// the path is copied in the command buffer: it can be reused for the next drawing
+	return VG_DRAWER_draw_path(
+			target,
+			&shape_vg_path,
+			VG_LITE_FILL_NON_ZERO,
+			&matrix,
+			VG_LITE_BLEND_SRC_OVER,
+			color);
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static vg_lite_error_t __draw_ring(
+		void* target,
+		vg_lite_matrix_t* matrix,
+		int diameter_out_w, int diameter_out_h,
+		int diameter_in_w, int diameter_in_h,
+		vg_lite_color_t color) {
+
+	vg_lite_path_t shape_vg_path;
+	vg_lite_error_t ret;
+	bool filled = (diameter_in_w <= 0) || (diameter_in_h <= 0);
+
+	shape_vg_path.path = &__shape_paths.ellipse[0];
+	shape_vg_path.path_length = sizeof(__shape_paths.ellipse);
+	int path_offset = VGLITE_PATH_compute_ellipse(
+			&shape_vg_path, 0,
+			diameter_out_w, diameter_out_h,
+			filled);
+
+	if (!filled && (0 <= path_offset)) {
+		path_offset = VGLITE_PATH_compute_ellipse(
+				&shape_vg_path,
+				path_offset,
+				diameter_in_w, diameter_in_h,
+				true);
+	}
+
+	if (0 > path_offset) {
+		DISPLAY_IMPL_error(false, "Error during path computation");
+		ret = VG_LITE_INVALID_ARGUMENT;
+	}
+	else {
+		ret = VG_DRAWER_draw_path(
 				target,
 				&shape_vg_path,
-				VG_LITE_FILL_NON_ZERO,
-				&matrix,
+				VG_LITE_FILL_EVEN_ODD,
+				matrix,
 				VG_LITE_BLEND_SRC_OVER,
+				color);
+	}
+	return ret;
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static vg_lite_error_t __draw_thick_arc_band(
+		void* target,
+		int center_x,
+		int center_y,
+		int diameter_w,
+		int diameter_h,
+		int thickness_out,
+		int thickness_in,
+		float start_angle_deg,
+		float arc_angle,
+		int caps,
+		vg_lite_color_t color) {
+
+	vg_lite_path_t shape_vg_path;
+	vg_lite_matrix_t matrix;
+
+	vg_lite_identity(&matrix);
+	vg_lite_translate(center_x, center_y, &matrix);
+	vg_lite_rotate(-start_angle_deg, &matrix);
+	vg_lite_scale(DRAWING_SCALE_DIV, DRAWING_SCALE_DIV, &matrix);
+
+	shape_vg_path.path = &__shape_paths.thick_ellipse_arc_band;
+	shape_vg_path.path_length = sizeof(__shape_paths.thick_ellipse_arc_band);
+
+	(void)VGLITE_PATH_compute_thick_shape_ellipse_arc_band(
+			&shape_vg_path,
+			diameter_w,
+			diameter_h,
+			thickness_out,
+			thickness_in,
+			0,
+			arc_angle,
+			caps);
+
+	return VG_DRAWER_draw_path(
+			target,
+			&shape_vg_path,
+			VG_LITE_FILL_EVEN_ODD,
+			&matrix,
+			VG_LITE_BLEND_SRC_OVER,
+			color);
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static vg_lite_color_t __get_fade_color(void* target, jint color, int band, int fade) {
+	uint32_t alpha = ((uint32_t)0xff * (uint32_t)((2 * (fade - band)) - 1)) / (uint32_t)(2 * fade);
+	vg_lite_color_t fade_color = (alpha << 24) | ((uint32_t)color & (uint32_t)0x00ffffff);
+	VG_DRAWER_update_color(target, &fade_color, VG_LITE_BLEND_SRC_OVER);
+	return fade_color;
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static DRAWING_Status __draw_faded_ellipse(
+		MICROUI_GraphicsContext* gc,
+		int x, int y,
+		int width, int height,
+		int thickness, int fade) {
+
+	DRAWING_Status ret;
+	int extent = (thickness / 2) + fade;
+
+	// Check if there is something to draw and clip drawing limits
+	if (__check_clip(gc, x - extent, y - extent, x + width + extent, y + height + extent, false)) {
+
+		vg_lite_matrix_t matrix;
+		vg_lite_identity(&matrix);
+		vg_lite_translate((vg_lite_float_t)x + ((vg_lite_float_t)width / 2.0f), (vg_lite_float_t)y + ((vg_lite_float_t)height / 2.0f), &matrix);
+		vg_lite_scale(DRAWING_SCALE_DIV, DRAWING_SCALE_DIV, &matrix);
+
+		// the radius in half pixels is the diameter in pixels
+		int out_w = width + thickness;
+		int out_h = height + thickness;
+		int in_w = width - thickness;
+		int in_h = height - thickness;
+
+		void* target = VG_DRAWER_configure_target(gc);
+		vg_lite_error_t vg_lite_error = VG_LITE_SUCCESS;
+
+		// inner bands (from the center): the outermost drawing is the last one to
+		// give the biggest drawing limits to the graphics engine
+		for (int band = fade - 1; (VG_LITE_SUCCESS == vg_lite_error) && (band >= 0); band--) {
+			int band_in_w = in_w - (2 * (band + 1));
+			int band_in_h = in_h - (2 * (band + 1));
+			if ((band_in_w >= 0) && (band_in_h >= 0)) {
+				vg_lite_error = __draw_ring(
+						target, &matrix,
+						band_in_w + 2, band_in_h + 2,
+						band_in_w, band_in_h,
+						__get_fade_color(target, gc->foreground_color, band, fade));
+			}
+			// else: band beyond the center
+		}
+
+		if (VG_LITE_SUCCESS == vg_lite_error) {
+			vg_lite_error = __draw_ring(target, &matrix, out_w, out_h, in_w, in_h, gc->foreground_color);
+		}
+
+		// outer bands
+		for (int band = 0; (VG_LITE_SUCCESS == vg_lite_error) && (band < fade); band++) {
+			vg_lite_error = __draw_ring(
+					target, &matrix,
+					out_w + (2 * (band + 1)), out_h + (2 * (band + 1)),
+					out_w + (2 * band), out_h + (2 * band),
+					__get_fade_color(target, gc->foreground_color, band, fade));
+		}
+
+		ret = VG_DRAWER_post_operation(target, vg_lite_error);
+	}
+	else {
+		ret = DRAWING_DONE;
+	}
+	return ret;
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static DRAWING_Status __draw_faded_line(
+		MICROUI_GraphicsContext* gc,
+		int x1,
+		int y1,
+		int x2,
+		int y2,
+		int thickness,
+		int fade,
+		DRAWING_Cap start,
+		DRAWING_Cap end) {
+
+	vg_lite_path_t shape_vg_path;
+	vg_lite_matrix_t matrix;
+	DRAWING_Status ret;
+	int faded_thickness = thickness + (2 * fade);
+
+	// Check if there is something to draw and clip drawing limits
+	if (__check_clip(
+			gc,
+			MIN(x1, x2) - (faded_thickness / 2),
+			MIN(y1, y2) - (faded_thickness / 2),
+			MAX(x1, x2) + (faded_thickness / 2),
+			MAX(y1, y2) + (faded_thickness / 2),
+			false)) {
+
+		int caps = 0;
+		caps |= MEJ_VGLITE_PATH_SET_CAPS_START(start);
+		caps |= MEJ_VGLITE_PATH_SET_CAPS_END(end);
+
+		vg_lite_identity(&matrix);
+		vg_lite_translate(x1, y1, &matrix);
+
+		void* target = VG_DRAWER_configure_target(gc);
+		vg_lite_error_t vg_lite_error;
+
+		if ((DRAWING_ENDOFLINE_ROUNDED == start) || (DRAWING_ENDOFLINE_ROUNDED == end)) {
+			// no radial gradient for the caps: bands around the line, in half pixels
+			int step = 2 * DRAWING_SCALE_FACTOR;
+			int m_thickness = DRAWING_SCALE_FACTOR * thickness;
+			vg_lite_matrix_t line_matrix;
+
+			vg_lite_scale(DRAWING_SCALE_DIV, DRAWING_SCALE_DIV, &matrix);
+
+			// the matrix is rotated along the line
+			line_matrix = matrix;
+			shape_vg_path.path = &__shape_paths.thick_shape_line;
+			shape_vg_path.path_length = sizeof(__shape_paths.thick_shape_line);
+			(void)VGLITE_PATH_compute_thick_shape_line(
+					&shape_vg_path, DRAWING_SCALE_FACTOR * (x2 - x1), DRAWING_SCALE_FACTOR * (y2 - y1), m_thickness, caps, &line_matrix);
+			vg_lite_error = VG_DRAWER_draw_path(
+					target,
+					&shape_vg_path,
+					VG_LITE_FILL_NON_ZERO,
+					&line_matrix,
+					VG_LITE_BLEND_SRC_OVER,
+					gc->foreground_color);
+
+			for (int band = 0; (VG_LITE_SUCCESS == vg_lite_error) && (band < fade); band++) {
+				line_matrix = matrix;
+				shape_vg_path.path = &__shape_paths.thick_shape_line_band;
+				shape_vg_path.path_length = sizeof(__shape_paths.thick_shape_line_band);
+				(void)VGLITE_PATH_compute_thick_shape_line_band(
+						&shape_vg_path, DRAWING_SCALE_FACTOR * (x2 - x1), DRAWING_SCALE_FACTOR * (y2 - y1),
+						m_thickness + (step * (band + 1)), m_thickness + (step * band), caps, &line_matrix);
+				vg_lite_error = VG_DRAWER_draw_path(
+						target,
+						&shape_vg_path,
+						VG_LITE_FILL_EVEN_ODD,
+						&line_matrix,
+						VG_LITE_BLEND_SRC_OVER,
+						__get_fade_color(target, gc->foreground_color, band, fade));
+			}
+
+			ret = VG_DRAWER_post_operation(target, vg_lite_error);
+		}
+		else {
+			vg_lite_linear_gradient_t gradient;
+
+			shape_vg_path.path = &__shape_paths.thick_shape_line;
+			shape_vg_path.path_length = sizeof(__shape_paths.thick_shape_line);
+
+			// the matrix is rotated along the line
+			(void)VGLITE_PATH_compute_thick_shape_line(
+					&shape_vg_path, x2 - x1, y2 - y1, faded_thickness, caps, &matrix);
+
+			// this call allocates in VGLite buffer
+			(void)memset(&gradient, 0, sizeof(vg_lite_linear_gradient_t));
+			vg_lite_error = vg_lite_init_grad(&gradient);
+			if (VG_LITE_SUCCESS == vg_lite_error) {
+				// GPU displays ABGR instead of ARGB and vice versa
+				gradient.image.format = VG_LITE_RGBA8888;
+
+				// ramps: transparent -> opaque on the fade width, opaque on the line thickness
+				uint32_t ramp = ((uint32_t)fade * (uint32_t)(VLC_GRADBUFFER_WIDTH - 1)) / (uint32_t)faded_thickness;
+				uint32_t stops[] = { 0, ramp, (uint32_t)(VLC_GRADBUFFER_WIDTH - 1) - ramp, (uint32_t)(VLC_GRADBUFFER_WIDTH - 1) };
+				uint32_t color = (uint32_t)gc->foreground_color & (uint32_t)0x00ffffff;
+				uint32_t colors[] = { color, color | (uint32_t)0xff000000, color | (uint32_t)0xff000000, color };
+				(void)vg_lite_set_grad(&gradient, sizeof(stops) / sizeof(stops[0]), colors, stops);
+
+				// the gradient goes across the line: from the top to the bottom of the line shape
+				vg_lite_matrix_t* gradient_matrix = vg_lite_get_grad_matrix(&gradient);
+				*gradient_matrix = matrix;
+				vg_lite_translate(0, (vg_lite_float_t)(-(faded_thickness / 2)), gradient_matrix);
+				vg_lite_rotate(90, gradient_matrix);
+				vg_lite_scale((vg_lite_float_t)faded_thickness / (vg_lite_float_t)VLC_GRADBUFFER_WIDTH, 1, gradient_matrix);
+
+				VG_DRAWER_update_gradient(target, &gradient, VG_LITE_BLEND_SRC_OVER);
+				vg_lite_error = VG_DRAWER_draw_gradient(
+						target,
+						&shape_vg_path,
+						VG_LITE_FILL_NON_ZERO,
+						&matrix,
+						&gradient,
+						VG_LITE_BLEND_SRC_OVER);
+			}
+			ret = VG_DRAWER_post_operation(target, vg_lite_error);
+
+			// vg_lite_init_grad allocates a buffer in VGLite buffer, we must free it
+			// (like the MicroVG drawings: the next drawing waits for the end of this one).
+			// No error even if init_grad has failed because vg_lite_clear_grad checks
+			// the allocation.
+			vg_lite_clear_grad(&gradient);
+		}
+	}
+	else {
+		ret = DRAWING_DONE;
+	}
+	return ret;
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static DRAWING_Status __draw_faded_circle_arc(
+		MICROUI_GraphicsContext* gc,
+		int x,
+		int y,
+		int diameter,
+		float start_angle_deg,
+		float arc_angle,
+		int thickness,
+		int fade,
+		DRAWING_Cap start,
+		DRAWING_Cap end) {
+
+	DRAWING_Status ret;
+
+	// same tunning as __draw_thick_shape_ellipse_arc()
+	int m_diameter = diameter + 1;
+	int m_thickness = thickness + 1;
+	int center_x = x + (m_diameter / 2);
+	int center_y = y + (m_diameter / 2);
+
+	// outer radius of the last band (rounded up), the same on each side of the center
+	int extent = ((m_diameter + m_thickness + 1) / 2) + fade;
+
+	// Check if there is something to draw and clip drawing limits
+	if (__check_clip(
+			gc,
+			center_x - extent,
+			center_y - extent,
+			center_x + extent,
+			center_y + extent,
+			false)) {
+
+		// in half pixels: the thickness grows on both sides
+		int step = 2 * DRAWING_SCALE_FACTOR;
+		int diameter_hp = DRAWING_SCALE_FACTOR * m_diameter;
+		int thickness_hp = DRAWING_SCALE_FACTOR * m_thickness;
+		int caps = 0;
+		caps |= MEJ_VGLITE_PATH_SET_CAPS_START(start);
+		caps |= MEJ_VGLITE_PATH_SET_CAPS_END(end);
+
+		void* target = VG_DRAWER_configure_target(gc);
+		vg_lite_error_t vg_lite_error = __draw_thick_arc_path(
+				target, center_x, center_y,
+				diameter_hp, diameter_hp, thickness_hp,
+				start_angle_deg, arc_angle, caps,
 				gc->foreground_color);
+
+		// the outermost drawing is the last one to give the biggest drawing limits
+		// to the graphics engine
+		for (int band = 0; (VG_LITE_SUCCESS == vg_lite_error) && (band < fade); band++) {
+			vg_lite_error = __draw_thick_arc_band(
+					target, center_x, center_y,
+					diameter_hp, diameter_hp,
+					thickness_hp + (step * (band + 1)), thickness_hp + (step * band),
+					start_angle_deg, arc_angle, caps,
+					__get_fade_color(target, gc->foreground_color, band, fade));
+		}
+
 		ret = VG_DRAWER_post_operation(target, vg_lite_error);
 	}
 	else {
@@ -2130,7 +2718,7 @@ static bool __configure_source(vg_lite_buffer_t *buffer, MICROUI_Image* img) {
 #endif // VGLITE_OPTION_TOGGLE_GPU
 
 #ifndef VGLITE_USE_GPU_FOR_TRANSPARENT_IMAGES
-		if (LLUI_DISPLAY_isTransparent(img) && (MICROUI_IMAGE_FORMAT_A8 != img->format) && (MICROUI_IMAGE_FORMAT_A4 != img->format)) {
+		if (LLUI_DISPLAY_isTransparent(img) && (MICROUI_IMAGE_FORMAT_A8 != img->format) && (MICROUI_IMAGE_FORMAT_A4 != img->format) && ((uint32_t)0 == DISPLAY_VGLITE_get_indexed_bpp(img)) && ((uint32_t)0 == DISPLAY_VGLITE_get_premultiplied_bpp(img))) {
 			// No MSAA with hardware
 			ret = false;
 		}
@@ -2211,6 +2799,13 @@ static bool __prepare_gpu_draw_image(MICROUI_GraphicsContext* gc, MICROUI_Image*
 
 	bool gpu_compatible;
 
+#ifdef VGLITE_USE_MULTIPLE_DRAWERS
+	if (LLUI_DISPLAY_isCustomFormat(gc->image.format) && ((uint32_t)0 != DISPLAY_VGLITE_get_indexed_bpp(img))) {
+		// the CLUT cannot be stored in a custom drawer
+		gpu_compatible = false;
+	}
+	else
+#endif // VGLITE_USE_MULTIPLE_DRAWERS
 	if(__configure_source(&source_buffer, img)) {
 
 		*target = VG_DRAWER_configure_target(gc);
@@ -2238,13 +2833,79 @@ static bool __prepare_gpu_draw_image(MICROUI_GraphicsContext* gc, MICROUI_Image*
 static inline void __soft_draw_image(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x_src, jint y_src, jint width, jint height, jint x_dest, jint y_dest, jint alpha){
 
 #ifdef VGLITE_USE_MULTIPLE_DRAWERS
-	if (!LLUI_DISPLAY_isCustomFormat(gc->image.format)) {
-		UI_DRAWING_SOFT_drawImage(gc, img, x_src, y_src, width, height, x_dest, y_dest, alpha);
+	if (LLUI_DISPLAY_isCustomFormat(gc->image.format)) {
+		// unsupported functionality, the drawing is abandoned!
 	}
-	// else: unsupported functionality, the drawing is abandoned!
-#else // VGLITE_USE_MULTIPLE_DRAWERS
-	UI_DRAWING_SOFT_drawImage(gc, img, x_src, y_src, width, height, x_dest, y_dest, alpha);
+	else
 #endif // VGLITE_USE_MULTIPLE_DRAWERS
+	if ((uint32_t)0 != DISPLAY_VGLITE_get_indexed_bpp(img)) {
+		// the software algorithms do not know this custom format
+		__soft_draw_indexed_image(gc, img, x_src, y_src, width, height, x_dest, y_dest, alpha);
+	}
+	else if ((uint32_t)0 != DISPLAY_VGLITE_get_premultiplied_bpp(img)) {
+		__soft_draw_premultiplied_image(gc, img, x_src, y_src, width, height, x_dest, y_dest, alpha);
+	}
+	else {
+		UI_DRAWING_SOFT_drawImage(gc, img, x_src, y_src, width, height, x_dest, y_dest, alpha);
+	}
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static void __soft_draw_indexed_image(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x_src, jint y_src, jint width, jint height, jint x_dest, jint y_dest, jint alpha){
+
+	jint original_foreground_color = gc->foreground_color;
+
+	for (jint y = 0; y < height; y++) {
+		for (jint x = 0; x < width; x++) {
+			uint32_t color = DISPLAY_VGLITE_read_indexed_pixel(img, (uint32_t)(x_src + x), (uint32_t)(y_src + y));
+			uint32_t pixel_alpha = ((color >> 24) * (uint32_t)alpha) / (uint32_t)0xff;
+
+			if ((uint32_t)0 != pixel_alpha) {
+				if ((uint32_t)0xff != pixel_alpha) {
+					uint32_t background = LLUI_DISPLAY_readPixel(&gc->image, x_dest + x, y_dest + y);
+					color = LLUI_DISPLAY_blend(color, background, pixel_alpha);
+				}
+				gc->foreground_color = (jint)color;
+				UI_DRAWING_writePixel(gc, x_dest + x, y_dest + y);
+			}
+			// else: transparent pixel
+		}
+	}
+
+	// restore the configured color
+	gc->foreground_color = original_foreground_color;
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static void __soft_draw_premultiplied_image(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x_src, jint y_src, jint width, jint height, jint x_dest, jint y_dest, jint alpha){
+
+	uint32_t global_factor = DISPLAY_VGLITE_ALPHA_FACTOR(alpha);
+	jint original_foreground_color = gc->foreground_color;
+
+	for (jint y = 0; y < height; y++) {
+		for (jint x = 0; x < width; x++) {
+			uint32_t color = DISPLAY_VGLITE_read_premultiplied_pixel(img, (uint32_t)(x_src + x), (uint32_t)(y_src + y));
+			uint32_t pixel_alpha;
+
+			if ((uint32_t)256 != global_factor) {
+				color = DISPLAY_VGLITE_scale_premultiplied(color, global_factor);
+			}
+			pixel_alpha = color >> 24;
+
+			if ((uint32_t)0 != pixel_alpha) {
+				if ((uint32_t)0xff != pixel_alpha) {
+					uint32_t background = LLUI_DISPLAY_readPixel(&gc->image, x_dest + x, y_dest + y);
+					color = DISPLAY_VGLITE_blend_premultiplied(color, background);
+				}
+				gc->foreground_color = (jint)color;
+				UI_DRAWING_writePixel(gc, x_dest + x, y_dest + y);
+			}
+			// else: transparent pixel
+		}
+	}
+
+	// restore the configured color
+	gc->foreground_color = original_foreground_color;
 }
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,201 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Input log: single-producer single-consumer ring, RTT drain.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>
+
+#include "input_log.h"
+
+#if defined(INPUT_LOG_ENABLED) && (INPUT_LOG_ENABLED != 0)
+
+#include "SEGGER_RTT.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define RECORD_MASK ((uint32_t)INPUT_LOG_SIZE - 1u)
+
+#if ((INPUT_LOG_SIZE & (INPUT_LOG_SIZE - 1)) != 0) || (INPUT_LOG_SIZE < 2)
+#error "INPUT_LOG_SIZE must be a power of two"
+#endif
+
+// -----------------------------------------------------------------------------
+// Global variables
+// -----------------------------------------------------------------------------
+
+volatile uint32_t INPUT_LOG_source_time;
+
+// -----------------------------------------------------------------------------
+// Private fields
+// -----------------------------------------------------------------------------
+
+static INPUT_LOG_record_t ring[INPUT_LOG_SIZE];
+
+/*
+ * @brief Positions since the start: the producer writes ring_head, the consumer
+ * writes ring_tail. Each one publishes its records (or free room) with a release
+ * store read by the other one with an acquire load.
+ */
+static uint32_t ring_head;
+static uint32_t ring_tail;
+
+// written by the producer, read by INPUT_LOG_get_stats()
+static uint32_t ring_dropped;
+static uint32_t ring_peak;
+static uint32_t ring_lost;
+
+static bool drain_started;      // true when the stream header has been sent
+
+/*
+ * @brief A chunk being sent: the chunk header followed by its records.
+ */
+static struct {
+	INPUT_LOG_chunk_t chunk;
+	INPUT_LOG_record_t records[INPUT_LOG_DRAIN_RECORDS];
+} drain_buffer;
+
+static uint8_t rtt_buffer[INPUT_LOG_RTT_BUFFER_SIZE];
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Sends the stream header over RTT.
+ *
+ * @return true when the header has been sent.
+ */
+static bool __input_log_send_header(void);
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void INPUT_LOG_record(uint32_t kind, uint32_t data, uint32_t index, uint32_t remaining) {
+	uint32_t head = ring_head;
+	uint32_t used = head - __atomic_load_n(&ring_tail, __ATOMIC_ACQUIRE);
+
+	if (INPUT_LOG_KIND_FULL == kind) {
+		__atomic_store_n(&ring_lost, ring_lost + 1u, __ATOMIC_RELAXED);
+	}
+
+	if (used >= (uint32_t)INPUT_LOG_SIZE) {
+		__atomic_store_n(&ring_dropped, ring_dropped + 1u, __ATOMIC_RELAXED);
+	}
+	else {
+		INPUT_LOG_record_t* record = &ring[head & RECORD_MASK];
+		uint32_t source = 0;
+
+		if ((INPUT_LOG_KIND_EVENT == kind) || (INPUT_LOG_KIND_REPLACE == kind)) {
+			source = INPUT_LOG_source_time;
+			INPUT_LOG_source_time = 0;
+		}
+		record->time = INPUT_LOG_GET_TIME_US();
+		record->data = data;
+		record->source = source;
+		record->index = (uint16_t)index;
+		record->kind = (uint8_t)kind;
+		record->remaining = (uint8_t)((remaining > 0xFFu) ? 0xFFu : remaining);
+
+		__atomic_store_n(&ring_head, head + 1u, __ATOMIC_RELEASE);
+
+		if ((used + 1u) > ring_peak) {
+			__atomic_store_n(&ring_peak, used + 1u, __ATOMIC_RELAXED);
+		}
+	}
+}
+
+// See the header file for the function documentation
+bool INPUT_LOG_read(INPUT_LOG_record_t* record) {
+	uint32_t tail = ring_tail;
+	bool ret = tail != __atomic_load_n(&ring_head, __ATOMIC_ACQUIRE);
+
+	if (ret) {
+		*record = ring[tail & RECORD_MASK];
+		__atomic_store_n(&ring_tail, tail + 1u, __ATOMIC_RELEASE);
+	}
+	return ret;
+}
+
+// See the header file for the function documentation
+void INPUT_LOG_drain(void) {
+	bool more = drain_started || __input_log_send_header();
+
+	while (more) {
+		uint32_t tail = ring_tail;
+		uint32_t count = __atomic_load_n(&ring_head, __ATOMIC_ACQUIRE) - tail;
+		if (count > (uint32_t)INPUT_LOG_DRAIN_RECORDS) {
+			count = INPUT_LOG_DRAIN_RECORDS;
+		}
+
+		if (0u == count) {
+			more = false;
+		}
+		else {
+			for (uint32_t r = 0; r < count; r++) {
+				drain_buffer.records[r] = ring[(tail + r) & RECORD_MASK];
+			}
+			drain_buffer.chunk.magic = INPUT_LOG_MAGIC_CHUNK;
+			drain_buffer.chunk.position = tail;
+			drain_buffer.chunk.records = count;
+			drain_buffer.chunk.dropped = __atomic_load_n(&ring_dropped, __ATOMIC_RELAXED);
+
+			// all or nothing (no block skip mode): the records stay in the ring until
+			// the RTT buffer has room
+			uint32_t size = sizeof(INPUT_LOG_chunk_t) + (count * sizeof(INPUT_LOG_record_t));
+			if (0u == SEGGER_RTT_Write(INPUT_LOG_RTT_CHANNEL, &drain_buffer, size)) {
+				more = false;
+			}
+			else {
+				__atomic_store_n(&ring_tail, tail + count, __ATOMIC_RELEASE);
+			}
+		}
+	}
+}
+
+// See the header file for the function documentation
+void INPUT_LOG_get_stats(INPUT_LOG_stats_t* stats) {
+	stats->drained = __atomic_load_n(&ring_tail, __ATOMIC_ACQUIRE);
+	stats->logged = __atomic_load_n(&ring_head, __ATOMIC_ACQUIRE);
+	stats->dropped = __atomic_load_n(&ring_dropped, __ATOMIC_RELAXED);
+	stats->peak = __atomic_load_n(&ring_peak, __ATOMIC_RELAXED);
+	stats->lost = __atomic_load_n(&ring_lost, __ATOMIC_RELAXED);
+}
+
+// -----------------------------------------------------------------------------
+// Internal functions
+// -----------------------------------------------------------------------------
+
+// See the section 'Internal function definitions' for the function documentation
+static bool __input_log_send_header(void) {
+	INPUT_LOG_header_t header;
+
+	(void)SEGGER_RTT_ConfigUpBuffer(INPUT_LOG_RTT_CHANNEL, "InputLog", rtt_buffer, sizeof(rtt_buffer), SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+
+	header.magic = INPUT_LOG_MAGIC_HEADER;
+	header.version = INPUT_LOG_VERSION;
+	header.size = INPUT_LOG_SIZE;
+	header.record = sizeof(INPUT_LOG_record_t);
+	drain_started = 0u != SEGGER_RTT_Write(INPUT_LOG_RTT_CHANNEL, &header, sizeof(header));
+	return drain_started;
+}
+
+#endif // INPUT_LOG_ENABLED
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,189 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief VGLite tessellation window sizing: decision logic (OS and hardware independent).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "tess_tuner.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief The window sizes are multiples of this value (VGLite alignment).
+ */
+#define TESS_TUNER_GRANULE (16u)
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Rounds up a size to the granule and clamps it to the limits.
+ */
+static uint32_t __tess_tuner_clamp(uint32_t size, uint32_t min_size, uint32_t max_size);
+
+/*
+ * @brief Gets the number of passes to tessellate a drawing with a window.
+ */
+static uint32_t __tess_tuner_passes(uint32_t width, uint32_t height, uint32_t draw_width, uint32_t draw_height);
+
+/*
+ * @brief Gets the smallest window that tessellates a drawing with the fewest
+ * passes within the memory budget.
+ */
+static void __tess_tuner_fit(const tess_tuner_config_t* config, uint32_t draw_width, uint32_t draw_height, uint32_t* width, uint32_t* height);
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void tess_tuner_init(tess_tuner_t* tuner, const tess_tuner_config_t* config, uint32_t width, uint32_t height) {
+	(void)memset(tuner, 0, sizeof(tess_tuner_t));
+	tuner->config = config;
+	tuner->width = width;
+	tuner->height = height;
+}
+
+// See the header file for the function documentation
+void tess_tuner_on_frame(tess_tuner_t* tuner, uint32_t draws, uint32_t passes, uint32_t split_draws, uint32_t max_passes,
+		uint32_t max_width, uint32_t max_height, uint32_t* width, uint32_t* height) {
+	const tess_tuner_config_t* config = tuner->config;
+	uint32_t new_width;
+	uint32_t new_height;
+
+	tuner->stats.frames++;
+	tuner->stats.draws += draws;
+	tuner->stats.passes += passes;
+	tuner->stats.split_draws += split_draws;
+	if (max_passes > tuner->stats.max_passes) {
+		tuner->stats.max_passes = max_passes;
+	}
+
+	if (split_draws > (uint32_t)0) {
+		// a drawing did not fit in the window: grow at once when it saves passes
+		__tess_tuner_fit(config, max_width, max_height, &new_width, &new_height);
+		if (__tess_tuner_passes(new_width, new_height, max_width, max_height)
+				< __tess_tuner_passes(tuner->width, tuner->height, max_width, max_height)) {
+			tuner->width = new_width;
+			tuner->height = new_height;
+			tuner->stats.grows++;
+		}
+		tuner->calm_frames = 0;
+		tuner->window_width = 0;
+		tuner->window_height = 0;
+	}
+	else {
+		if (max_width > tuner->window_width) {
+			tuner->window_width = max_width;
+		}
+		if (max_height > tuner->window_height) {
+			tuner->window_height = max_height;
+		}
+		tuner->calm_frames++;
+
+		if (tuner->calm_frames >= config->shrink_hold_frames) {
+			// shrink to the largest drawing of the last frames
+			__tess_tuner_fit(config, tuner->window_width, tuner->window_height, &new_width, &new_height);
+			if (tess_tuner_bytes(new_width, new_height) < tess_tuner_bytes(tuner->width, tuner->height)) {
+				tuner->width = new_width;
+				tuner->height = new_height;
+				tuner->stats.shrinks++;
+			}
+			tuner->calm_frames = 0;
+			tuner->window_width = 0;
+			tuner->window_height = 0;
+		}
+	}
+
+	*width = tuner->width;
+	*height = tuner->height;
+}
+
+// See the header file for the function documentation
+void tess_tuner_set_size(tess_tuner_t* tuner, uint32_t width, uint32_t height) {
+	tuner->width = width;
+	tuner->height = height;
+}
+
+// See the header file for the function documentation
+void tess_tuner_get_stats(tess_tuner_t* tuner, tess_tuner_stats_t* stats) {
+	*stats = tuner->stats;
+	stats->width = tuner->width;
+	stats->height = tuner->height;
+	stats->bytes = tess_tuner_bytes(tuner->width, tuner->height);
+}
+
+// See the header file for the function documentation
+uint32_t tess_tuner_bytes(uint32_t width, uint32_t height) {
+	uint32_t stride = ((width * 8u) + 63u) & ~63u;
+	uint32_t buffer_size = stride * ((height + 15u) & ~15u);
+	// each bit of the cache level represents 64 bytes of the buffer
+	uint32_t l1_size = ((((buffer_size / 64u) + 63u) & ~63u) / 8u + 63u) & ~63u;
+	return buffer_size + l1_size;
+}
+
+// -----------------------------------------------------------------------------
+// Internal functions
+// -----------------------------------------------------------------------------
+
+// See the section 'Internal function definitions' for the function documentation
+static uint32_t __tess_tuner_clamp(uint32_t size, uint32_t min_size, uint32_t max_size) {
+	uint32_t ret = ((size + TESS_TUNER_GRANULE - 1u) / TESS_TUNER_GRANULE) * TESS_TUNER_GRANULE;
+
+	if (ret < min_size) {
+		ret = min_size;
+	}
+	else if (ret > max_size) {
+		ret = max_size;
+	}
+	// else: size within the limits
+
+	return ret;
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static uint32_t __tess_tuner_passes(uint32_t width, uint32_t height, uint32_t draw_width, uint32_t draw_height) {
+	return ((draw_width + width - 1u) / width) * ((draw_height + height - 1u) / height);
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static void __tess_tuner_fit(const tess_tuner_config_t* config, uint32_t draw_width, uint32_t draw_height, uint32_t* width, uint32_t* height) {
+	uint32_t w = __tess_tuner_clamp(draw_width, config->min_size, config->max_width);
+	uint32_t h = __tess_tuner_clamp(draw_height, config->min_size, config->max_height);
+
+	// keep the width of the drawing and tessellate it by horizontal bands
+	while ((h > config->min_size) && (tess_tuner_bytes(w, h) > config->max_bytes)) {
+		h -= TESS_TUNER_GRANULE;
+	}
+	while ((w > config->min_size) && (tess_tuner_bytes(w, h) > config->max_bytes)) {
+		w -= TESS_TUNER_GRANULE;
+	}
+
+	if (draw_height > h) {
+		// same number of bands with the smallest height
+		uint32_t bands = (draw_height + h - 1u) / h;
+		h = __tess_tuner_clamp((draw_height + bands - 1u) / bands, config->min_size, h);
+	}
+
+	*width = w;
+	*height = h;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,95 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include "touch_filter.h"
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void touch_filter_reset(touch_filter_t* filter, int32_t x, int32_t y, int64_t t_us) {
+	filter->x = (float)x;
+	filter->y = (float)y;
+	filter->vx = 0.f;
+	filter->vy = 0.f;
+	filter->t_us = t_us;
+	filter->samples = 1;
+}
+
+// See the header file for the function documentation
+void touch_filter_update(touch_filter_t* filter, int32_t x, int32_t y, int64_t t_us) {
+	int64_t dt_us = t_us - filter->t_us;
+
+	if (dt_us <= 0) {
+		// same report (or clock issue): only keep the latest position
+		filter->x = (float)x;
+		filter->y = (float)y;
+		return;
+	}
+
+	float dt = (float)dt_us;
+
+	if (filter->mode == TOUCH_FILTER_ALPHA_BETA) {
+		// predict then correct with the residual
+		float px = filter->x + (filter->vx * dt);
+		float py = filter->y + (filter->vy * dt);
+		float rx = (float)x - px;
+		float ry = (float)y - py;
+		filter->x = px + (filter->alpha * rx);
+		filter->y = py + (filter->alpha * ry);
+		filter->vx += (filter->beta * rx) / dt;
+		filter->vy += (filter->beta * ry) / dt;
+	}
+	else {
+		float vx = ((float)x - filter->x) / dt;
+		float vy = ((float)y - filter->y) / dt;
+		if (filter->samples == 1) {
+			// first velocity sample
+			filter->vx = vx;
+			filter->vy = vy;
+		}
+		else {
+			filter->vx += filter->velocity_smoothing * (vx - filter->vx);
+			filter->vy += filter->velocity_smoothing * (vy - filter->vy);
+		}
+		filter->x = (float)x;
+		filter->y = (float)y;
+	}
+
+	filter->t_us = t_us;
+	filter->samples++;
+}
+
+// See the header file for the function documentation
+void touch_filter_predict(const touch_filter_t* filter, int64_t t_us, int32_t* x, int32_t* y) {
+	float px = filter->x;
+	float py = filter->y;
+
+	if ((filter->mode != TOUCH_FILTER_NONE) && (filter->samples > 1)) {
+		int64_t horizon_us = t_us - filter->t_us;
+		if (horizon_us > filter->max_horizon_us) {
+			horizon_us = filter->max_horizon_us;
+		}
+		if (horizon_us > 0) {
+			px += filter->vx * (float)horizon_us;
+			py += filter->vy * (float)horizon_us;
+		}
+	}
+
+	// round to nearest
+	*x = (int32_t)((px >= 0.f) ? (px + 0.5f) : (px - 0.5f));
+	*y = (int32_t)((py >= 0.f) ? (py + 0.5f) : (py - 0.5f));
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
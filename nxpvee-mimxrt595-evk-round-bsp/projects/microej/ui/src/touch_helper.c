@@ -25,8 +25,13 @@
 
 #include "LLUI_INPUT.h"
 #include "microej.h"
+#include "touch_helper.h"
 #include "touch_helper_configuration.h"
+#include "touch_filter.h"
 #include "event_generator.h"
+#include "display_configuration.h"
+#include "time_hardware_timer.h"
+#include "input_log.h"
 
 // -----------------------------------------------------------------------------
 // Macros and Defines
@@ -48,6 +53,13 @@
 #define KEEP_FIRST_MOVE(px,x,py,y)	(KEEP_PIXEL(px,x,py,y, FIRST_MOVE_PIXEL_LIMIT))
 #define KEEP_MOVE(px,x,py,y)		(KEEP_PIXEL(px,x,py,y, MOVE_PIXEL_LIMIT))
 
+#define CLAMP(v,max)				((v) < 0 ? 0 : ((v) > (max) ? (max) : (v)))
+
+/*
+ * @brief Weight (in 1/256) of a new latency sample in the latency average
+ */
+#define LATENCY_AVERAGE_WEIGHT		(32)
+
 // -----------------------------------------------------------------------------
 // Global Variables
 // -----------------------------------------------------------------------------
@@ -56,11 +68,79 @@ static uint8_t touch_pressed = MICROEJ_FALSE;
 static uint8_t touch_moved = MICROEJ_FALSE;	// == MICROEJ_TRUE after the first "move" event
 static uint16_t previous_touch_x, previous_touch_y;
 
+/*
+ * @brief Velocity estimation and position prediction
+ */
+static touch_filter_t touch_filter = {
+		.mode = TOUCH_PREDICTION_MODE,
+		.velocity_smoothing = TOUCH_PREDICTION_VELOCITY_SMOOTHING,
+		.alpha = TOUCH_PREDICTION_ALPHA,
+		.beta = TOUCH_PREDICTION_BETA,
+		.max_horizon_us = TOUCH_PREDICTION_MAX_US,
+};
+
+/*
+ * @brief Move waiting for the next flush to be sent
+ */
+static uint8_t pending_move = MICROEJ_FALSE;
+static int32_t pending_move_x, pending_move_y;
+static int64_t pending_move_timestamp_us;
+
+/*
+ * @brief Sample timestamp of the last event sent and not flushed yet (0 if none)
+ */
+static int64_t unflushed_timestamp_us = 0;
+
+/*
+ * @brief MICROEJ_TRUE when an event waits for a flush (unflushed event or
+ * pending move): the only state read by the display task (a single byte is
+ * read and written atomically)
+ */
+static volatile uint8_t waiting_flush = MICROEJ_FALSE;
+
+/*
+ * @brief Time the last move has been sent
+ */
+static int64_t last_move_sent_us;
+
+static touch_latency_stats_t latency_stats;
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Sends a move event at the position predicted for its display time.
+ */
+static void __touch_helper_send_move(int32_t x, int32_t y, int64_t timestamp_us, int64_t now_us);
+
+/*
+ * @brief Sends the pending move, if any.
+ */
+static void __touch_helper_send_pending_move(int64_t now_us);
+
+/*
+ * @brief Marks an event as waiting for the next flush. Must be called before
+ * the event is sent: a flush that ends once the event is in the MicroUI queue
+ * must find the marker.
+ */
+static void __touch_helper_mark_unflushed(int64_t timestamp_us);
+
+/*
+ * @brief Publishes whether an event waits for a flush to the display task.
+ */
+static void __touch_helper_update_waiting_flush(void);
+
 // -----------------------------------------------------------------------------
 // Public functions
 // -----------------------------------------------------------------------------
 
 void TOUCH_HELPER_pressed(int32_t x, int32_t y)
+{
+	TOUCH_HELPER_pressed_at(x, y, time_hardware_timer_getTimeUs());
+}
+
+void TOUCH_HELPER_pressed_at(int32_t x, int32_t y, int64_t timestamp_us)
 {
 	// here, pen is down for sure
 
@@ -79,6 +159,8 @@ void TOUCH_HELPER_pressed(int32_t x, int32_t y)
 			keep_pixel = KEEP_FIRST_MOVE(previous_touch_x, x, previous_touch_y, y);
 		}
 
+		touch_filter_update(&touch_filter, x, y, timestamp_us);
+
 		if (keep_pixel == MICROEJ_TRUE)
 		{
 			// store the new pixel
@@ -86,14 +168,41 @@ void TOUCH_HELPER_pressed(int32_t x, int32_t y)
 			previous_touch_y = y;
 			touch_moved = MICROEJ_TRUE;
 
-			// send a MicroUI touch event (don't care if event is lost)
-			EVENT_GENERATOR_touch_moved(x, y);
+			int64_t now_us = time_hardware_timer_getTimeUs();
+#if TOUCH_COALESCING_ENABLED == 1
+			if ((unflushed_timestamp_us != 0) && ((now_us - last_move_sent_us) < TOUCH_COALESCING_MAX_HOLD_US))
+			{
+				// the previous move has not been displayed yet: only keep the latest position
+				if (pending_move == MICROEJ_TRUE)
+				{
+					latency_stats.coalesced_moves++;
+				}
+				pending_move_x = x;
+				pending_move_y = y;
+				pending_move_timestamp_us = timestamp_us;
+				pending_move = MICROEJ_TRUE;
+				__touch_helper_update_waiting_flush();
+			}
+			else
+#endif
+			{
+				if (pending_move == MICROEJ_TRUE)
+				{
+					// held for too long: replaced by the latest position
+					latency_stats.coalesced_moves++;
+					pending_move = MICROEJ_FALSE;
+				}
+				__touch_helper_send_move(x, y, timestamp_us, now_us);
+			}
 		}
 		// else: same position; no need to send an event
 	}
 	else
 	{
 		// pen was up => press event
+		int64_t previous_unflushed_us = unflushed_timestamp_us;
+		__touch_helper_mark_unflushed(timestamp_us);
+		INPUT_LOG_set_source_time((uint32_t)timestamp_us);
 		if (EVENT_GENERATOR_touch_pressed(x, y) == LLUI_INPUT_OK)
 		{
 			// the event has been managed: we can store the new touch state
@@ -102,8 +211,15 @@ void TOUCH_HELPER_pressed(int32_t x, int32_t y)
 			previous_touch_y = y;
 			touch_pressed = MICROEJ_TRUE;
 			touch_moved = MICROEJ_FALSE;
+			pending_move = MICROEJ_FALSE;
+			touch_filter_reset(&touch_filter, x, y, timestamp_us);
 		}
-		// else: event has been lost: stay in "release" state
+		else
+		{
+			// event has been lost: stay in "release" state
+			unflushed_timestamp_us = previous_unflushed_us;
+		}
+		__touch_helper_update_waiting_flush();
 	}
 }
 
@@ -119,6 +235,9 @@ void TOUCH_HELPER_released(void)
 
 	if (touch_pressed == MICROEJ_TRUE)
 	{
+		// the last position must be sent before the release
+		__touch_helper_send_pending_move(time_hardware_timer_getTimeUs());
+
 		// pen was down => release event
 		if (EVENT_GENERATOR_touch_released() == LLUI_INPUT_OK)
 		{
@@ -131,6 +250,104 @@ void TOUCH_HELPER_released(void)
 	// else: pen was already up
 }
 
+void TOUCH_HELPER_flushed(int64_t timestamp_us)
+{
+	int64_t sample_timestamp_us = unflushed_timestamp_us;
+
+	if (sample_timestamp_us != 0)
+	{
+		// an event sent before this flush has been displayed
+		uint32_t latency_us = (uint32_t)(timestamp_us - sample_timestamp_us);
+		unflushed_timestamp_us = 0;
+		__touch_helper_update_waiting_flush();
+
+		latency_stats.samples++;
+		latency_stats.last_us = latency_us;
+		if (latency_stats.samples == 1)
+		{
+			latency_stats.average_us = latency_us;
+		}
+		else
+		{
+			latency_stats.average_us = (uint32_t)((((int64_t)latency_stats.average_us * (256 - LATENCY_AVERAGE_WEIGHT))
+					+ ((int64_t)latency_us * LATENCY_AVERAGE_WEIGHT)) / 256);
+		}
+		if (latency_us > latency_stats.max_us)
+		{
+			latency_stats.max_us = latency_us;
+		}
+	}
+
+	__touch_helper_send_pending_move(timestamp_us);
+}
+
+void TOUCH_HELPER_flush_timeout(int64_t timestamp_us)
+{
+	// nothing has been displayed: the latency measure is dropped
+	unflushed_timestamp_us = 0;
+	__touch_helper_update_waiting_flush();
+	__touch_helper_send_pending_move(timestamp_us);
+}
+
+bool TOUCH_HELPER_is_waiting_flush(void)
+{
+	return waiting_flush == MICROEJ_TRUE;
+}
+
+void TOUCH_HELPER_get_latency_stats(touch_latency_stats_t* stats)
+{
+	*stats = latency_stats;
+}
+
+// -----------------------------------------------------------------------------
+// Internal functions
+// -----------------------------------------------------------------------------
+
+// See the section 'Internal function definitions' for the function documentation
+static void __touch_helper_send_move(int32_t x, int32_t y, int64_t timestamp_us, int64_t now_us)
+{
+	if (touch_filter.mode != TOUCH_FILTER_NONE)
+	{
+		// extrapolate to the expected display time of the event
+		touch_filter_predict(&touch_filter, timestamp_us + latency_stats.average_us, &x, &y);
+		x = CLAMP(x, FRAME_BUFFER_WIDTH - 1);
+		y = CLAMP(y, FRAME_BUFFER_HEIGHT - 1);
+	}
+
+	// send a MicroUI touch event (don't care if event is lost)
+	__touch_helper_mark_unflushed(timestamp_us);
+	INPUT_LOG_set_source_time((uint32_t)timestamp_us);
+	EVENT_GENERATOR_touch_moved(x, y);
+
+	last_move_sent_us = now_us;
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static void __touch_helper_send_pending_move(int64_t now_us)
+{
+	if (pending_move == MICROEJ_TRUE)
+	{
+		pending_move = MICROEJ_FALSE;
+		__touch_helper_send_move(pending_move_x, pending_move_y, pending_move_timestamp_us, now_us);
+	}
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static void __touch_helper_mark_unflushed(int64_t timestamp_us)
+{
+	if (unflushed_timestamp_us == 0)
+	{
+		unflushed_timestamp_us = timestamp_us;
+	}
+	__touch_helper_update_waiting_flush();
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static void __touch_helper_update_waiting_flush(void)
+{
+	waiting_flush = ((unflushed_timestamp_us != 0) || (pending_move == MICROEJ_TRUE)) ? MICROEJ_TRUE : MICROEJ_FALSE;
+}
+
 // -----------------------------------------------------------------------------
 // EOF
 // -----------------------------------------------------------------------------
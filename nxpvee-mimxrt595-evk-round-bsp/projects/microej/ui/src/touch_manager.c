@@ -14,7 +14,6 @@
 
 #include "display_support.h"
 #include "FreeRTOS.h"
-#include "semphr.h"
 #include "board.h"
 
 #include "fsl_gpio.h"
@@ -23,12 +22,18 @@
 #include "fsl_ft3267.h"
 
 #include "touch_helper.h"
+#include "touch_helper_configuration.h"
+#include "touch_manager.h"
+#include "power_governor.h"
+#include "time_hardware_timer.h"
+#include "wakeup_latency.h"
 
 #include "mej_log.h"
 
 // RTOS
 #include "FreeRTOS.h"
-#include "semphr.h"
+#include "task.h"
+#include "osal.h"
 
 
 // -----------------------------------------------------------------------------
@@ -45,6 +50,12 @@
  */
 #define TOUCH_STACK_SIZE  (128)
 
+/*
+ * @brief Flags of the touch task event: touch interrupt, display flushed
+ */
+#define TOUCH_EVENT_INTERRUPT  (1u << 0)
+#define TOUCH_EVENT_FLUSH      (1u << 1)
+
 // -----------------------------------------------------------------------------
 // Internal function definitions
 // -----------------------------------------------------------------------------
@@ -52,7 +63,7 @@
 /**
  * Retrieves the touch state and coordinates
  */
-static void __touch_manager_read(void);
+static void __touch_manager_read(int64_t timestamp_us);
 
 /**
  * Touch thread routine
@@ -64,6 +75,11 @@ static void __touch_manager_task(void *pvParameters);
  */
 void __touch_manager_pull_reset_pin(bool pullUp);
 
+/*
+ * @brief Gets the full time of a 32-bit time taken less than 2^31 us ago
+ */
+static int64_t __touch_manager_get_time_us(uint32_t time_us);
+
 // -----------------------------------------------------------------------------
 // Static Constants
 // -----------------------------------------------------------------------------
@@ -80,12 +96,23 @@ static const ft3267_config_t s_touchConfig = {
 // -----------------------------------------------------------------------------
 
 static ft3267_handle_t s_touchHandle;
-static volatile bool s_touchEvent = false;
 
 /*
- * @brief vglite operation semaphore
+ * @brief Time of the last touch interrupt (the touch sample time), on 32 bits:
+ * written by the interrupt and read by the touch task in a single access
  */
-static SemaphoreHandle_t touch_interrupt_sem;
+static volatile uint32_t s_touchTimestamp;
+
+/*
+ * @brief Time of the last display flush, on 32 bits: written by the display
+ * task and read by the touch task in a single access
+ */
+static volatile uint32_t s_flushTimestamp;
+
+/*
+ * @brief touch task event (touch interrupt and display flush)
+ */
+static OSAL_event_handle_t touch_event;
 
 // -----------------------------------------------------------------------------
 // Public functions
@@ -109,7 +136,11 @@ void TOUCH_MANAGER_initialize(void)
 		assert(false);
 	}
 
-	touch_interrupt_sem = xSemaphoreCreateBinary();
+	if (OSAL_OK != OSAL_event_create((uint8_t*)"Touch", &touch_event))
+	{
+		PRINTF("Touch event creation failed\r\n");
+		assert(false);
+	}
 
 	GPIO_PinInit(GPIO, BOARD_MIPI_PANEL_TOUCH_INT_PORT, BOARD_MIPI_PANEL_TOUCH_INT_PIN, &intPinConfig);
 	GPIO_SetPinInterruptConfig(GPIO, BOARD_MIPI_PANEL_TOUCH_INT_PORT, BOARD_MIPI_PANEL_TOUCH_INT_PIN, &intPinIntConfig);
@@ -127,13 +158,21 @@ void TOUCH_MANAGER_interrupt(void)
 		GPIO_PortClearInterruptFlags(GPIO, BOARD_MIPI_PANEL_TOUCH_INT_PORT, kGPIO_InterruptA,
 				(1UL << BOARD_MIPI_PANEL_TOUCH_INT_PIN));
 
-		portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
-		xSemaphoreGiveFromISR(touch_interrupt_sem, &xHigherPriorityTaskWoken);
-		if(xHigherPriorityTaskWoken != pdFALSE )
-		{
-			// Force a context switch here.
-			portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-		}
+		s_touchTimestamp = (uint32_t)time_hardware_timer_getTimeUs();
+
+		WAKEUP_LATENCY_signal(WAKEUP_LATENCY_TOUCH);
+		(void)OSAL_event_set_from_isr(&touch_event, TOUCH_EVENT_INTERRUPT);
+	}
+}
+
+// See the header file for the function documentation
+void TOUCH_MANAGER_frame_flushed(void)
+{
+	// only wake up the touch task when it is waiting for this flush
+	if (TOUCH_HELPER_is_waiting_flush())
+	{
+		s_flushTimestamp = (uint32_t)time_hardware_timer_getTimeUs();
+		(void)OSAL_event_set(&touch_event, TOUCH_EVENT_FLUSH);
 	}
 }
 
@@ -142,7 +181,7 @@ void TOUCH_MANAGER_interrupt(void)
 // -----------------------------------------------------------------------------
 
 // See the section 'Internal function definitions' for the function documentation
-static void __touch_manager_read(void)
+static void __touch_manager_read(int64_t timestamp_us)
 {
 	touch_event_t touch_event;
 	int touch_x;
@@ -150,9 +189,15 @@ static void __touch_manager_read(void)
 
 	if (kStatus_Success == FT3267_GetSingleTouch(&s_touchHandle, &touch_event, &touch_x, &touch_y))
 	{
+		if (touch_event == kTouch_Down)
+		{
+			// Anticipate the animation triggered by the press
+			power_governor_notify_touch();
+		}
+
 		if (touch_event == kTouch_Down || touch_event == kTouch_Contact)
 		{
-			TOUCH_HELPER_pressed(FRAME_BUFFER_WIDTH - touch_x, FRAME_BUFFER_HEIGHT - touch_y);
+			TOUCH_HELPER_pressed_at(FRAME_BUFFER_WIDTH - touch_x, FRAME_BUFFER_HEIGHT - touch_y, timestamp_us);
 		}
 		else if (touch_event== kTouch_Up)
 		{
@@ -167,14 +212,35 @@ static void __touch_manager_task(void *pvParameters)
 {
 	while (1)
 	{
-		/* Suspend ourselves */
-		(void)xSemaphoreTake(touch_interrupt_sem, portMAX_DELAY);
+		/* Suspend ourselves; a held move must be sent even if no flush comes */
+		uint32_t timeout = TOUCH_HELPER_is_waiting_flush() ? (TOUCH_COALESCING_MAX_HOLD_US / 1000) : OSAL_INFINITE_TIME;
+		uint32_t events;
+		if (OSAL_OK != OSAL_event_wait(&touch_event, TOUCH_EVENT_INTERRUPT | TOUCH_EVENT_FLUSH, &events, timeout))
+		{
+			TOUCH_HELPER_flush_timeout(time_hardware_timer_getTimeUs());
+			continue;
+		}
 
 		/* We have been woken up, lets work ! */
-		__touch_manager_read();
+		if (0u != (events & TOUCH_EVENT_FLUSH))
+		{
+			TOUCH_HELPER_flushed(__touch_manager_get_time_us(s_flushTimestamp));
+		}
+		if (0u != (events & TOUCH_EVENT_INTERRUPT))
+		{
+			WAKEUP_LATENCY_woken(WAKEUP_LATENCY_TOUCH);
+			__touch_manager_read(__touch_manager_get_time_us(s_touchTimestamp));
+		}
 	}
 }
 
+// See the section 'Internal function definitions' for the function documentation
+static int64_t __touch_manager_get_time_us(uint32_t time_us)
+{
+	int64_t now_us = time_hardware_timer_getTimeUs();
+	return now_us - (int64_t)(uint32_t)((uint32_t)now_us - time_us);
+}
+
 // See the section 'Internal function definitions' for the function documentation
 void __touch_manager_pull_reset_pin(bool pullUp)
 {
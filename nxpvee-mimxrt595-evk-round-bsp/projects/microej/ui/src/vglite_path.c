@@ -421,6 +421,9 @@ static int __multiple_quarter_curve_to(
  * 		bits[2-3] represent the cap of the end of the shape,
  * 		See DRAWING_ENDOFLINE_XXX for caps values
  *
+ * The outline is appended to the path without end command: several outlines can
+ * be computed in the same path.
+ *
  * @return: -1 if there is not enough memory in the buffer, otherwise the new path_offset
  */
 static int __approximate_ellipse_arc(
@@ -432,6 +435,30 @@ static int __approximate_ellipse_arc(
 		float32_t arc_angle_rad,
 		int caps);
 
+/*
+ * @brief Normalizes the angles of an ellipse arc: positive arc angle of at most
+ * 360 degrees, start angle in the range [0, 360[. The caps are swapped when the
+ * arc is reversed.
+ *
+ * @param[in,out] start_angle_deg: the angle of the beginning of the arc in degrees
+ * @param[in,out] arc_angle_deg: the arc angle in degrees
+ * @param[in,out] caps: the caps of the start and the end of the arc
+ */
+static void __normalize_arc(float32_t* start_angle_deg, float32_t* arc_angle_deg, int* caps);
+
+/*
+ * @brief Computes the outline of a thick horizontal line from (0, 0) to
+ * (length, 0).
+ *
+ * The outline is appended to the path without end command: several outlines can
+ * be computed in the same path.
+ *
+ * @param[in]: length: the line length
+ * @param[in]: thickness: the line thickness
+ * @param[in]: caps: caps of the start and end of the line (see __approximate_ellipse_arc())
+ */
+static void __thick_shape_line_outline(int length, int thickness, int caps);
+
 /*
  * @brief Normalize an angle so that it is in the range [0, 360[
  *
@@ -755,80 +782,46 @@ int VGLITE_PATH_compute_thick_shape_line(
 		int thickness,
 		int caps,
 		vg_lite_matrix_t *matrix) {
-	int length;
-	int top;
-	int bottom;
-	int cap;
-
 	// Compute the length of the line: sqrt(dx^2 + dy^2)
-	length = (int) mej_sqrt_f32((x*x) + (y*y));
+	int length = (int) mej_sqrt_f32((x*x) + (y*y));
 
 	// Compute line angle with x axis
 	vg_lite_rotate(MEJ_RAD2DEG(atan2(y, x)), matrix);
 
 	int half_thickness = thickness / 2;
-	top = -half_thickness;
-	bottom = thickness - half_thickness;
 
 	// Initialize the drawing context
 	__init_drawing(thick_line_shape, 0);
 
-	// Move to top
-	(void)__move_to(0, top);
+	__thick_shape_line_outline(length, thickness, caps);
 
-	// Line to upper end side
-	(void)__line_to(length, top);
+	return __update_path(thick_line_shape, true, true,
+			-half_thickness, -half_thickness, length + half_thickness, thickness - half_thickness);
+}
 
-	cap = MEJ_VGLITE_PATH_GET_CAPS_END(caps);
-	switch(cap) {
-	case DRAWING_ENDOFLINE_ROUNDED:
-	{
-		// Cubics for end cap
-		__set_quarter_curve_tangent_axis(__horizontal);
-		(void)__quarter_curve_to(length + half_thickness, 0);
-		(void)__quarter_curve_to(length, bottom);
-		break;
-	}
-	case DRAWING_ENDOFLINE_NONE:
-	case DRAWING_ENDOFLINE_PERPENDICULAR:
-	{
-		// Compute line cap
-		(void)__line_to(length, bottom);
-		break;
-	}
-	default:
-		DISPLAY_IMPL_error(false, "Unknown cap: %d", cap);
-		break;
-	}
+// See the header file for the function documentation
+int VGLITE_PATH_compute_thick_shape_line_band(
+		vg_lite_path_t *band_shape,
+		int x,
+		int y,
+		int thickness_out,
+		int thickness_in,
+		int caps,
+		vg_lite_matrix_t *matrix) {
+	int length = (int) mej_sqrt_f32((x*x) + (y*y));
 
-	// Line to bottom origin
-	(void)__line_to(0, bottom);
+	vg_lite_rotate(MEJ_RAD2DEG(atan2(y, x)), matrix);
 
-	// Cubics for start cap
-	cap = MEJ_VGLITE_PATH_GET_CAPS_START(caps);
-	switch(cap) {
-	case DRAWING_ENDOFLINE_ROUNDED:
-	{
-		// Cubics for end cap
-		__set_quarter_curve_tangent_axis(__horizontal);
-		(void)__quarter_curve_to(-half_thickness, 0);
-		(void)__quarter_curve_to(0, top);
-		break;
-	}
-	case DRAWING_ENDOFLINE_NONE:
-	case DRAWING_ENDOFLINE_PERPENDICULAR:
-	{
-		// Compute line cap
-		(void)__line_to(0, top);
-		break;
-	}
-	default:
-		DISPLAY_IMPL_error(false, "Unknown cap: %d", cap);
-		break;
-	}
+	int half_thickness = thickness_out / 2;
 
-	return __update_path(thick_line_shape, true, true,
-			-half_thickness, top, length + half_thickness, bottom);
+	__init_drawing(band_shape, 0);
+
+	// the band is the area between both outlines (even-odd fill)
+	__thick_shape_line_outline(length, thickness_out, caps);
+	__thick_shape_line_outline(length, thickness_in, caps);
+
+	return __update_path(band_shape, true, true,
+			-half_thickness, -half_thickness, length + half_thickness, thickness_out - half_thickness);
 }
 
 // See the header file for the function documentation
@@ -840,27 +833,11 @@ int VGLITE_PATH_compute_thick_shape_ellipse_arc(
 		float32_t start_angle_deg,
 		float32_t arc_angle_deg,
 		int caps) {
-	int path_length;
-
 	float32_t l_arc_angle_deg = arc_angle_deg;
 	float32_t l_start_angle_deg = start_angle_deg;
 	int l_caps = caps;
 
-	if (l_arc_angle_deg < 0) {
-		// invert start angle and end angle
-		l_start_angle_deg += l_arc_angle_deg;
-		l_arc_angle_deg = -l_arc_angle_deg;
-		int cap1 = MEJ_VGLITE_PATH_GET_CAPS_START(l_caps);
-		int cap2 = MEJ_VGLITE_PATH_GET_CAPS_END(l_caps);
-		l_caps = 0;
-		l_caps |= MEJ_VGLITE_PATH_SET_CAPS_START(cap2);
-		l_caps |= MEJ_VGLITE_PATH_SET_CAPS_END(cap1);
-	}
-
-	if (l_arc_angle_deg > 360) {
-		l_arc_angle_deg = 360;
-	}
-	l_start_angle_deg = __normalize_angle(l_start_angle_deg);
+	__normalize_arc(&l_start_angle_deg, &l_arc_angle_deg, &l_caps);
 
 	float32_t start_angle_rad = MEJ_DEG2RAD(l_start_angle_deg);
 	float32_t arc_angle_rad = MEJ_DEG2RAD(l_arc_angle_deg);
@@ -873,7 +850,7 @@ int VGLITE_PATH_compute_thick_shape_ellipse_arc(
 	// Initialize the drawing context
 	__init_drawing(thick_ellipse_arc_shape, 0);
 
-	path_length = __approximate_ellipse_arc(
+	(void)__approximate_ellipse_arc(
 			radius_out_w,
 			radius_out_h,
 			radius_in_w,
@@ -882,8 +859,6 @@ int VGLITE_PATH_compute_thick_shape_ellipse_arc(
 			arc_angle_rad,
 			l_caps);
 
-	thick_ellipse_arc_shape->path_length = path_length;
-
 	return __update_path(thick_ellipse_arc_shape, true, true,
 			-radius_out_w,
 			-radius_out_h,
@@ -891,6 +866,55 @@ int VGLITE_PATH_compute_thick_shape_ellipse_arc(
 			+radius_out_h);
 }
 
+// See the header file for the function documentation
+int VGLITE_PATH_compute_thick_shape_ellipse_arc_band(
+		vg_lite_path_t *band_shape,
+		int diameter_w,
+		int diameter_h,
+		int thickness_out,
+		int thickness_in,
+		float32_t start_angle_deg,
+		float32_t arc_angle_deg,
+		int caps) {
+	float32_t l_arc_angle_deg = arc_angle_deg;
+	float32_t l_start_angle_deg = start_angle_deg;
+	int l_caps = caps;
+
+	__normalize_arc(&l_start_angle_deg, &l_arc_angle_deg, &l_caps);
+
+	float32_t start_angle_rad = MEJ_DEG2RAD(l_start_angle_deg);
+	float32_t arc_angle_rad = MEJ_DEG2RAD(l_arc_angle_deg);
+
+	int radius_out_w = (diameter_w + thickness_out)/2;
+	int radius_out_h = (diameter_h + thickness_out)/2;
+
+	__init_drawing(band_shape, 0);
+
+	// the band is the area between both outlines (even-odd fill)
+	(void)__approximate_ellipse_arc(
+			radius_out_w,
+			radius_out_h,
+			((diameter_w - thickness_out)/2) + 1,
+			((diameter_h - thickness_out)/2) + 1,
+			start_angle_rad,
+			arc_angle_rad,
+			l_caps);
+	(void)__approximate_ellipse_arc(
+			(diameter_w + thickness_in)/2,
+			(diameter_h + thickness_in)/2,
+			((diameter_w - thickness_in)/2) + 1,
+			((diameter_h - thickness_in)/2) + 1,
+			start_angle_rad,
+			arc_angle_rad,
+			l_caps);
+
+	return __update_path(band_shape, true, true,
+			-radius_out_w,
+			-radius_out_h,
+			+radius_out_w,
+			+radius_out_h);
+}
+
 // See the header file for the function documentation
 inline void VGLITE_PATH_update_color(vg_lite_color_t* color, vg_lite_blend_t blend) {
 	if (VG_LITE_BLEND_SRC_OVER == blend){
@@ -1187,8 +1211,7 @@ static int __approximate_ellipse_arc(
 		break;
 	}
 
-	// End path
-	return __end();
+	return __ctxt.offset;
 }
 
 // See the section 'Internal function definitions' for the function documentation
@@ -1404,6 +1427,86 @@ int __update_path(vg_lite_path_t *path,
 	return __ctxt.offset;
 }
 
+// See the section 'Internal function definitions' for the function documentation
+static void __normalize_arc(float32_t* start_angle_deg, float32_t* arc_angle_deg, int* caps) {
+	if (*arc_angle_deg < 0) {
+		// invert start angle and end angle
+		*start_angle_deg += *arc_angle_deg;
+		*arc_angle_deg = -*arc_angle_deg;
+		int cap1 = MEJ_VGLITE_PATH_GET_CAPS_START(*caps);
+		int cap2 = MEJ_VGLITE_PATH_GET_CAPS_END(*caps);
+		*caps = 0;
+		*caps |= MEJ_VGLITE_PATH_SET_CAPS_START(cap2);
+		*caps |= MEJ_VGLITE_PATH_SET_CAPS_END(cap1);
+	}
+
+	if (*arc_angle_deg > 360) {
+		*arc_angle_deg = 360;
+	}
+	*start_angle_deg = __normalize_angle(*start_angle_deg);
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static void __thick_shape_line_outline(int length, int thickness, int caps) {
+	int half_thickness = thickness / 2;
+	int top = -half_thickness;
+	int bottom = thickness - half_thickness;
+
+	// Move to top
+	(void)__move_to(0, top);
+
+	// Line to upper end side
+	(void)__line_to(length, top);
+
+	int cap = MEJ_VGLITE_PATH_GET_CAPS_END(caps);
+	switch(cap) {
+	case DRAWING_ENDOFLINE_ROUNDED:
+	{
+		// Cubics for end cap
+		__set_quarter_curve_tangent_axis(__horizontal);
+		(void)__quarter_curve_to(length + half_thickness, 0);
+		(void)__quarter_curve_to(length, bottom);
+		break;
+	}
+	case DRAWING_ENDOFLINE_NONE:
+	case DRAWING_ENDOFLINE_PERPENDICULAR:
+	{
+		// Compute line cap
+		(void)__line_to(length, bottom);
+		break;
+	}
+	default:
+		DISPLAY_IMPL_error(false, "Unknown cap: %d", cap);
+		break;
+	}
+
+	// Line to bottom origin
+	(void)__line_to(0, bottom);
+
+	// Cubics for start cap
+	cap = MEJ_VGLITE_PATH_GET_CAPS_START(caps);
+	switch(cap) {
+	case DRAWING_ENDOFLINE_ROUNDED:
+	{
+		// Cubics for end cap
+		__set_quarter_curve_tangent_axis(__horizontal);
+		(void)__quarter_curve_to(-half_thickness, 0);
+		(void)__quarter_curve_to(0, top);
+		break;
+	}
+	case DRAWING_ENDOFLINE_NONE:
+	case DRAWING_ENDOFLINE_PERPENDICULAR:
+	{
+		// Compute line cap
+		(void)__line_to(0, top);
+		break;
+	}
+	default:
+		DISPLAY_IMPL_error(false, "Unknown cap: %d", cap);
+		break;
+	}
+}
+
 // See the section 'Internal function definitions' for the function documentation
 static float32_t __normalize_angle(float32_t angle) {
 	float32_t l_angle = fmod(angle, 360);
@@ -30,7 +30,7 @@ extern "C" {
  * This value must not be changed by the user of the CCO.
  * This value must be incremented by the implementor of the CCO when a configuration define is added, deleted or modified.
  */
-#define MICROVG_CONFIGURATION_VERSION (1)
+#define MICROVG_CONFIGURATION_VERSION (2)
 
 // -----------------------------------------------------------------------------
 // MicroVG's LinearGradient Options
@@ -162,6 +162,18 @@ extern "C" {
  */
 #define VG_FEATURE_FONT_EXTERNAL
 
+/*
+ * @brief Uncomment this define to draw the glyphs of a string as a single path
+ * (one GPU drawing per string instead of one per glyph).
+ *
+ * The glyphs are gathered until the path reaches FT_VGLITE_RUN_MAX_SIZE bytes
+ * (see ftvector.h) or until the color changes (multi-layer colored glyphs). The
+ * run path is allocated in the freetype heap.
+ *
+ * Only used by the vector renderer (VG_FEATURE_FONT_FREETYPE_VECTOR).
+ */
+#define VG_FEATURE_FONT_GLYPH_RUN
+
 /*
  * @brief Configure this define to set the freetype heap size
  *
@@ -0,0 +1,260 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined VG_BLOB_H
+#define VG_BLOB_H
+
+/*
+ * @file
+ * @brief Animated vector images compiled offline into read-only VGLite blobs.
+ *
+ * projects/common/scripts/vg_compiler.py compiles the animated vector images
+ * (Android Vector Drawable subset) at build time into one flat blob per image,
+ * placed in flash with the code. The blob holds everything the GPU needs, already
+ * in its final format:
+ * - the paths in the MicroVG path format (MICROVG_PATH_HEADER_t, bounds included,
+ *   followed by the VGLite FP32 commands): drawn from the flash as is,
+ * - the linear gradients: matrix, colors and 256-pixel ramp (ARGB8888, aligned for
+ *   the GPU, colors premultiplied like VGLITE_PATH_update_gradient() does for a
+ *   SRC_OVER drawing),
+ * - the animations: one track per animated property, made of keyframes (start,
+ *   duration, interpolator, values); the motion paths are sampled by arc length
+ *   and the interpolators are tabulated.
+ *
+ * Drawing an image at a given time (VG_BLOB_draw()) does not allocate anything:
+ * the group matrices are computed in a stack (VG_BLOB_MAX_DEPTH), the morphed paths
+ * in a static buffer (VG_BLOB_MORPH_BUFFER_SIZE) and the gradients drawn with an
+ * opacity in a static ramp. Unlike the MicroVG images, there is no parsing nor
+ * element list to build at load time: VG_BLOB_find() only checks the blob header
+ * and the gradients.
+ *
+ * Blob layout (little endian, offsets from the start of the blob):
+ * - VG_BLOB_header_t,
+ * - the groups (VG_BLOB_group_t), in pre-order: a group follows its parent; the
+ *   group 0 maps the viewport on the image size,
+ * - the elements (VG_BLOB_element_t), in drawing order,
+ * - the tracks (VG_BLOB_track_t): the tracks of the groups then the tracks of the
+ *   elements, sorted by target,
+ * - the keyframes (VG_BLOB_keyframe_t) and the points of the motion paths
+ *   (VG_BLOB_point_t),
+ * - the interpolators: interpolator_samples + 1 floats each, the interpolated
+ *   fraction at regular fractions from 0 to 1,
+ * - the gradients (VG_BLOB_gradient_t),
+ * - the paths (the identical paths are shared),
+ * - the gradient ramps (aligned on 64 bytes).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "vg_lite.h"
+
+#include "vg_blob_configuration.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Magic number of a blob: "VGBL".
+ */
+#define VG_BLOB_MAGIC (0x4C424756u)
+
+#define VG_BLOB_VERSION (1u)
+
+/*
+ * @brief Animated properties. The group properties are lower than
+ * VG_BLOB_PROPERTY_FILL_ALPHA.
+ */
+#define VG_BLOB_PROPERTY_TRANSLATE_X (0u)
+#define VG_BLOB_PROPERTY_TRANSLATE_Y (1u)
+#define VG_BLOB_PROPERTY_SCALE_X (2u)
+#define VG_BLOB_PROPERTY_SCALE_Y (3u)
+#define VG_BLOB_PROPERTY_ROTATION (4u)
+#define VG_BLOB_PROPERTY_PIVOT_X (5u)
+#define VG_BLOB_PROPERTY_PIVOT_Y (6u)
+#define VG_BLOB_PROPERTY_TRANSLATE_XY (7u)  // motion path: translate X and Y
+#define VG_BLOB_PROPERTY_FILL_ALPHA (16u)
+#define VG_BLOB_PROPERTY_FILL_COLOR (17u)
+#define VG_BLOB_PROPERTY_PATH (18u)         // morphing
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Header of a blob (64 bytes).
+ */
+typedef struct {
+	uint32_t magic;                 // VG_BLOB_MAGIC
+	uint16_t version;               // VG_BLOB_VERSION
+	uint16_t header_size;           // sizeof(VG_BLOB_header_t)
+	float width;                    // image size
+	float height;
+	uint32_t duration;              // duration of the animation in milliseconds
+	uint16_t group_count;
+	uint16_t element_count;
+	uint16_t track_count;
+	uint16_t interpolator_count;
+	uint16_t gradient_count;
+	uint16_t max_depth;             // depth of the deepest group + 1
+	uint16_t interpolator_samples;  // an interpolator holds interpolator_samples + 1 floats
+	uint16_t max_path_size;         // size of the largest morphed path (header included)
+	uint32_t groups_offset;
+	uint32_t elements_offset;
+	uint32_t tracks_offset;
+	uint32_t interpolators_offset;
+	uint32_t gradients_offset;
+	uint32_t paths_offset;
+	uint32_t size;                  // size of the blob
+} VG_BLOB_header_t;
+
+/*
+ * @brief A group: its local matrix is translate(translate + pivot) * rotate *
+ * scale * translate(-pivot), concatenated to the matrix of its parent (the last
+ * group of lower depth that precedes it).
+ */
+typedef struct {
+	uint8_t depth;
+	uint8_t padding1;
+	uint16_t padding2;
+	float translate_x;
+	float translate_y;
+	float scale_x;
+	float scale_y;
+	float rotation;                 // degrees
+	float pivot_x;
+	float pivot_y;
+} VG_BLOB_group_t;
+
+/*
+ * @brief A filled path.
+ */
+typedef struct {
+	uint16_t group;
+	int16_t gradient;               // index of the gradient, -1 for a color fill
+	uint32_t path_offset;           // MicroVG path (MICROVG_PATH_HEADER_t)
+	uint32_t color;                 // ARGB8888 (opaque black for a gradient)
+	float alpha;                    // fill alpha (0.0 to 1.0)
+	uint8_t fill_rule;              // LLVG_FILLTYPE_*
+	uint8_t padding[3];
+} VG_BLOB_element_t;
+
+/*
+ * @brief The keyframes of an animated property.
+ */
+typedef struct {
+	uint8_t property;               // VG_BLOB_PROPERTY_*
+	uint8_t padding1;
+	uint16_t target;                // index of the group or of the element
+	uint16_t keyframe_count;
+	uint16_t padding2;
+	uint32_t keyframes_offset;      // keyframes sorted by start
+} VG_BLOB_track_t;
+
+/*
+ * @brief An animator: from its start until its end, the property goes from the
+ * first value to the second one. After its end (and until the start of the next
+ * keyframe), the property keeps the second value. Before the first keyframe, the
+ * property keeps the value of the group or of the element.
+ */
+typedef struct {
+	uint32_t start;                 // milliseconds
+	uint32_t duration;              // milliseconds
+	uint16_t interpolator;          // index of the interpolator
+	uint16_t padding;
+	uint32_t from;                  // float, ARGB8888 color, path offset or point offset (motion path)
+	uint32_t to;                    // float, ARGB8888 color, path offset or number of points (motion path)
+} VG_BLOB_keyframe_t;
+
+/*
+ * @brief A point of a motion path.
+ */
+typedef struct {
+	float fraction;                 // fraction of the length of the path
+	float x;
+	float y;
+} VG_BLOB_point_t;
+
+/*
+ * @brief A linear gradient.
+ */
+typedef struct {
+	float matrix[9];                // position of the ramp in the path coordinates
+	uint32_t count;                 // number of colors (VLC_MAX_GRAD at most)
+	uint32_t colors[16];            // ARGB8888
+	uint32_t stops[16];             // 0 to 255
+	uint32_t ramp_offset;           // 256 ARGB8888 pixels, colors premultiplied
+} VG_BLOB_gradient_t;
+
+/*
+ * @brief An image registered by the file generated by vg_compiler.py.
+ */
+typedef struct {
+	const char* name;               // resource name, e.g. "/images/mascot.xml"
+	const uint8_t* blob;
+} VG_BLOB_image_t;
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Gets the images compiled with the application. Implemented by the file
+ * generated by vg_compiler.py; the default (weak) implementation returns no image.
+ *
+ * @param[out] count: the number of images.
+ *
+ * @return the images.
+ */
+const VG_BLOB_image_t* VG_BLOB_get_images(uint32_t* count);
+
+/*
+ * @brief Finds a compiled image by its resource name. The blob must be valid and
+ * fit the configuration (VG_BLOB_MAX_DEPTH, VG_BLOB_MORPH_BUFFER_SIZE).
+ *
+ * @param[in] name: the resource name.
+ *
+ * @return the blob, NULL when the image has not been compiled (or cannot be drawn).
+ */
+const VG_BLOB_header_t* VG_BLOB_find(const char* name);
+
+/*
+ * @brief Checks that a blob is valid and fits the configuration.
+ *
+ * @param[in] blob: the blob.
+ *
+ * @return true when the blob can be drawn.
+ */
+bool VG_BLOB_check(const VG_BLOB_header_t* blob);
+
+/*
+ * @brief Draws an image at a given time of its animation. The caller has requested
+ * the drawing (LLUI_DISPLAY_requestDrawing()), set the clip and configured the
+ * destination; this function adds the drawings to the GPU command buffer and does
+ * not start the GPU operation (see VG_DRAWER_post_operation()).
+ *
+ * @param[in] target: the destination returned by VG_DRAWER_configure_target(): a
+ * GPU buffer, not a custom drawer (the morphed paths and the ramps are not kept).
+ * @param[in] blob: the image.
+ * @param[in] matrix: the transformation of the image (3x3, row major).
+ * @param[in] elapsed: the time in the animation in milliseconds.
+ * @param[in] alpha: the opacity (0 to 255).
+ *
+ * @return VG_LITE_SUCCESS or the error of the first drawing that has failed.
+ */
+vg_lite_error_t VG_BLOB_draw(void* target, const VG_BLOB_header_t* blob, const float* matrix, int32_t elapsed, uint32_t alpha);
+
+#endif // !defined VG_BLOB_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,36 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined VG_BLOB_CONFIGURATION_H
+#define VG_BLOB_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Maximum depth of the groups of an image (the root group included). The
+ * matrices of the groups being drawn are kept in a stack of this depth.
+ */
+#ifndef VG_BLOB_MAX_DEPTH
+#define VG_BLOB_MAX_DEPTH (16)
+#endif
+
+/*
+ * @brief Size in bytes of the buffer of the morphed paths: an image whose largest
+ * morphed path does not fit is rejected by VG_BLOB_find(). The buffer is reused by
+ * each morphed path: VGLite copies the path data in the command buffer.
+ */
+#ifndef VG_BLOB_MORPH_BUFFER_SIZE
+#define VG_BLOB_MORPH_BUFFER_SIZE (1024)
+#endif
+
+#endif // !defined VG_BLOB_CONFIGURATION_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
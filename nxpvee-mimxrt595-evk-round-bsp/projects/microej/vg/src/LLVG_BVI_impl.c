@@ -37,6 +37,8 @@
 #include "bsp_util.h"
 #include "vg_lite.h"
 #include "vg_lite_kernel.h"
+#include "display_impl.h"
+#include "display_list.h"
 #include "display_vglite.h"
 #include "vglite_path.h"
 #include "microvg_vglite_helper.h"
@@ -875,6 +877,9 @@ void LLVG_BVI_IMPL_clear(MICROUI_GraphicsContext* gc) {
 	// cppcheck-suppress [misra-c2012-14.4] ignore warning
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLVG_BVI_IMPL_clear)) {
 
+		DISPLAY_IMPL_notify_drawing();
+		DISPLAY_LIST_RECORD(DISPLAY_LIST_OP_VG_BUFFERED_IMAGE_CLEAR, gc, 0);
+
 		// map a struct on graphics context's pixel area
 		BVI_resource* bvi = MAP_BVI(&gc->image);
 
@@ -895,6 +900,9 @@ void LLVG_BVI_IMPL_draw(MICROUI_GraphicsContext* gc, MICROUI_GraphicsContext* so
 
 	if ((alpha > (uint32_t)0) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLVG_BVI_IMPL_draw)) {
 
+		DISPLAY_IMPL_notify_drawing();
+		DISPLAY_LIST_RECORD(DISPLAY_LIST_OP_VG_BUFFERED_IMAGE, gc, DISPLAY_LIST_IMAGE(&source->image), x, y, DISPLAY_LIST_ARRAY(matrix), (int32_t)alpha);
+
 		vg_lite_matrix_t vg_lite_matrix;
 		jfloat* mapped_matrix = MAP_VGLITE_MATRIX(&vg_lite_matrix);
 
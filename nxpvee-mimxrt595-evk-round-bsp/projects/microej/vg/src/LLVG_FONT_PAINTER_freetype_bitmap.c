@@ -34,6 +34,8 @@
 #include "microvg_font_freetype.h"
 #include "microvg_helper.h"
 #include "freetype_bitmap_helper.h"
+#include "display_impl.h"
+#include "display_list.h"
 #include "bsp_util.h"
 
 // -----------------------------------------------------------------------------
@@ -175,6 +177,10 @@ void __draw_string(MICROUI_GraphicsContext* gc, FT_Face face, jfloat size, jchar
 
 	} else {
 
+		DISPLAY_IMPL_notify_drawing();
+		DISPLAY_LIST_RECORD(DISPLAY_LIST_OP_VG_BITMAP_STRING, gc, (int32_t)DISPLAY_LIST_hash(text, (uint32_t)length * sizeof(jchar)),
+				(int32_t)(uintptr_t)face, DISPLAY_LIST_float(size), x, y, alpha, blend, DISPLAY_LIST_float(letterSpacing));
+
 		local_freetype_context.library = library;
 		local_freetype_context.renderer = renderer;
 		local_freetype_context.face = face;
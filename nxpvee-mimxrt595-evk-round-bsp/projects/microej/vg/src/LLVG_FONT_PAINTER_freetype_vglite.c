@@ -40,6 +40,8 @@
 #include "microvg_vglite_helper.h"
 #include "vg_lite.h"
 #include "ftvector/ftvector.h"
+#include "display_impl.h"
+#include "display_list.h"
 #include "display_vglite.h"
 #include "vglite_path.h"
 
@@ -93,6 +95,15 @@ static void __set_renderer(MICROUI_GraphicsContext* gc, vg_lite_matrix_t* matrix
  */
 static void __set_color(int color);
 
+/*
+ * @brief Starts or ends a glyph run: the glyphs rendered during a run are drawn
+ * as a single path.
+ *
+ * @param[in] matrix: the matrix of the run (the glyph matrices are relative to it)
+ * or NULL to draw the pending glyphs and end the run.
+ */
+static void __set_run(vg_lite_matrix_t* matrix);
+
 /*
  * @brief Updates the angle to use for the next glyph when drawn on an arc.
  * When drawing on an arc, the glyph position is defined by its angle. We thus
@@ -144,6 +155,9 @@ jint LLVG_FONT_PAINTER_IMPL_draw_string(MICROUI_GraphicsContext* gc, jchar* text
 	}
 	else {
 		if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&(LLVG_FONT_PAINTER_IMPL_draw_string))){
+			DISPLAY_IMPL_notify_drawing();
+			DISPLAY_LIST_RECORD(DISPLAY_LIST_OP_VG_STRING, gc, DISPLAY_LIST_ARRAY(text), faceHandle, DISPLAY_LIST_float(size),
+					DISPLAY_LIST_float(x), DISPLAY_LIST_float(y), DISPLAY_LIST_ARRAY(matrix), alpha, blend, DISPLAY_LIST_float(letterSpacing));
 			int color = (gc->foreground_color & 0x00FFFFFF) + (int)(((unsigned int) alpha) << 24);
 			jfloat* local_matrix = MICROVG_HELPER_check_matrix(matrix);
 			__draw_string(gc, text, faceHandle, size, x, y, local_matrix, blend, color, MICROVG_HELPER_NULL_GRADIENT, letterSpacing, 0, 0);
@@ -164,6 +178,10 @@ jint LLVG_FONT_PAINTER_IMPL_draw_string_gradient(MICROUI_GraphicsContext* gc, jc
 	}
 	else {
 		if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&(LLVG_FONT_PAINTER_IMPL_draw_string_gradient))){
+			DISPLAY_IMPL_notify_drawing();
+			DISPLAY_LIST_RECORD(DISPLAY_LIST_OP_VG_STRING_GRADIENT, gc, DISPLAY_LIST_ARRAY(text), faceHandle, DISPLAY_LIST_float(size),
+					DISPLAY_LIST_float(x), DISPLAY_LIST_float(y), DISPLAY_LIST_ARRAY(matrix), alpha, blend, DISPLAY_LIST_float(letterSpacing),
+					DISPLAY_LIST_ARRAY(gradientData), DISPLAY_LIST_ARRAY(gradientMatrix));
 
 			vg_lite_linear_gradient_t gradient = {0};
 			jfloat* local_gradient_matrix = MICROVG_HELPER_check_matrix(gradientMatrix);
@@ -199,6 +217,9 @@ jint LLVG_FONT_PAINTER_IMPL_draw_string_on_circle(MICROUI_GraphicsContext* gc, j
 	}
 	else {
 		if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&(LLVG_FONT_PAINTER_IMPL_draw_string_on_circle))){
+			DISPLAY_IMPL_notify_drawing();
+			DISPLAY_LIST_RECORD(DISPLAY_LIST_OP_VG_STRING_ON_CIRCLE, gc, DISPLAY_LIST_ARRAY(text), faceHandle, DISPLAY_LIST_float(size),
+					x, y, DISPLAY_LIST_ARRAY(matrix), alpha, blend, DISPLAY_LIST_float(letterSpacing), DISPLAY_LIST_float(radius), direction);
 			int color = (gc->foreground_color & 0x00FFFFFF) + (int)(((unsigned int) alpha) << 24);
 			__draw_string(gc, text, faceHandle, size, x, y, matrix, blend, color, MICROVG_HELPER_NULL_GRADIENT, letterSpacing, radius, direction);
 		}
@@ -218,6 +239,10 @@ jint LLVG_FONT_PAINTER_IMPL_draw_string_on_circle_gradient(MICROUI_GraphicsConte
 	}
 	else {
 		if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&(LLVG_FONT_PAINTER_IMPL_draw_string_on_circle_gradient))){
+			DISPLAY_IMPL_notify_drawing();
+			DISPLAY_LIST_RECORD(DISPLAY_LIST_OP_VG_STRING_ON_CIRCLE_GRADIENT, gc, DISPLAY_LIST_ARRAY(text), faceHandle, DISPLAY_LIST_float(size),
+					x, y, DISPLAY_LIST_ARRAY(matrix), alpha, blend, DISPLAY_LIST_float(letterSpacing), DISPLAY_LIST_float(radius), direction,
+					DISPLAY_LIST_ARRAY(gradientData), DISPLAY_LIST_ARRAY(gradientMatrix));
 
 			vg_lite_linear_gradient_t gradient = {0};
 			jfloat* local_gradient_matrix = MICROVG_HELPER_check_matrix(gradientMatrix);
@@ -286,6 +311,14 @@ static void __set_color(int color) {
 	set_mode(renderer, FT_PARAM_TAG_VGLITE_COLOR, (void *)color);
 }
 
+static void __set_run(vg_lite_matrix_t* matrix) {
+
+	FT_Renderer renderer = FT_Get_Renderer(library, FT_GLYPH_FORMAT_OUTLINE);
+	FT_Renderer_SetModeFunc set_mode = renderer->clazz->set_mode;
+
+	set_mode(renderer, FT_PARAM_TAG_VGLITE_RUN, (void *)matrix);
+}
+
 static float __get_angle(float advance, float radius){
 	return (advance/radius) * 180.0f / M_PI;
 }
@@ -385,6 +418,11 @@ static void __draw_string(MICROUI_GraphicsContext* gc, jchar* text, jint faceHan
 
 		__set_renderer(gc, &localGlyphMatrix, color, gradient, MICROVG_VGLITE_HELPER_get_blend(blend));
 
+#ifdef VG_FEATURE_FONT_GLYPH_RUN
+		// the glyphs are positioned relative to the string matrix and drawn together
+		__set_run(&localMatrix);
+#endif
+
 		// Layout variables
 		int glyph_index ; // current glyph index
 		int previous_glyph_index = 0; // previous glyph index for kerning
@@ -412,7 +450,11 @@ static void __draw_string(MICROUI_GraphicsContext* gc, jchar* text, jint faceHan
 				}
 			}
 
+#ifdef VG_FEATURE_FONT_GLYPH_RUN
+			LLVG_MATRIX_IMPL_identity(vglocalGlyphMatrix);
+#else
 			LLVG_MATRIX_IMPL_copy(vglocalGlyphMatrix, vgLocalMatrix);
+#endif
 
 			if(0.f == radius) {
 				LLVG_MATRIX_IMPL_translate(vglocalGlyphMatrix, advanceX + offset_x, baselineposition + advanceY  + offset_y);
@@ -446,6 +488,10 @@ static void __draw_string(MICROUI_GraphicsContext* gc, jchar* text, jint faceHan
 			previous_glyph_index = glyph_index;
 		}
 
+#ifdef VG_FEATURE_FONT_GLYPH_RUN
+		__set_run(NULL);
+#endif
+
 		DISPLAY_VGLITE_start_operation(true);
 
 		LLUI_DISPLAY_setDrawingStatus(DRAWING_RUNNING);
@@ -30,6 +30,8 @@
 #include "microvg_vglite_helper.h"
 #include "vg_lite.h"
 #include "color.h"
+#include "display_impl.h"
+#include "display_list.h"
 #include "display_vglite.h"
 #include "vglite_path.h"
 
@@ -148,6 +150,9 @@ jint LLVG_PATH_PAINTER_IMPL_drawPath(MICROUI_GraphicsContext* gc, jbyte* pathDat
 	jint ret = LLVG_SUCCESS;
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&(LLVG_PATH_PAINTER_IMPL_drawPath)) && MICROVG_VGLITE_HELPER_enable_vg_lite_scissor(gc)) {
 
+		DISPLAY_IMPL_notify_drawing();
+		DISPLAY_LIST_RECORD(DISPLAY_LIST_OP_VG_PATH, gc, DISPLAY_LIST_ARRAY(pathData), x, y, DISPLAY_LIST_ARRAY(matrix), fillRule, blend, color);
+
 		vg_lite_path_t path = PATH_TO_VGLITEPATH(pathData);
 		void* target = VG_DRAWER_configure_target(gc);
 		vg_lite_blend_t vg_lite_blend = MICROVG_VGLITE_HELPER_get_blend(blend);
@@ -189,6 +194,10 @@ jint LLVG_PATH_PAINTER_IMPL_drawGradient(MICROUI_GraphicsContext* gc, jbyte* pat
 	jint ret = LLVG_SUCCESS;
 	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&(LLVG_PATH_PAINTER_IMPL_drawGradient)) && MICROVG_VGLITE_HELPER_enable_vg_lite_scissor(gc)) {
 
+		DISPLAY_IMPL_notify_drawing();
+		DISPLAY_LIST_RECORD(DISPLAY_LIST_OP_VG_GRADIENT, gc, DISPLAY_LIST_ARRAY(pathData), x, y, DISPLAY_LIST_ARRAY(matrix), fillRule, alpha, blend,
+				DISPLAY_LIST_ARRAY(gradientData), DISPLAY_LIST_ARRAY(gradientMatrix));
+
 		vg_lite_path_t path = PATH_TO_VGLITEPATH(pathData);
 		void* target = VG_DRAWER_configure_target(gc);
 
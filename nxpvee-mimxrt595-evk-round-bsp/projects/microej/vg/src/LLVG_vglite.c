@@ -28,6 +28,7 @@
 #include "microvg_vglite_helper.h"
 #include "vg_lite.h"
 #include "color.h"
+#include "display_mask.h"
 #include "display_vglite.h"
 #include "bsp_util.h"
 
@@ -148,15 +149,24 @@ vg_lite_blend_t MICROVG_VGLITE_HELPER_get_blend(jint blend) {
 // See the header file for the function documentation
 bool MICROVG_VGLITE_HELPER_enable_vg_lite_scissor(MICROUI_GraphicsContext* gc)
 {
-    int32_t width =  gc->clip_x2 - gc->clip_x1 + 1;
-    int32_t height =  gc->clip_y2 - gc->clip_y1 + 1;
+    int x1 = gc->clip_x1;
+    int y1 = gc->clip_y1;
+    int x2 = gc->clip_x2;
+    int y2 = gc->clip_y2;
 
-    bool ret;
-    if ((width > 0) && (height > 0))
+    bool ret = (x1 <= x2) && (y1 <= y2);
+
+#if defined(DISPLAY_MASK_ENABLED) && (DISPLAY_MASK_ENABLED != 0)
+    if (ret && DISPLAY_MASK_is_display(LLUI_DISPLAY_getBufferAddress(&gc->image))) {
+        // the corners of the round display are not visible
+        ret = DISPLAY_MASK_clip(&x1, &y1, &x2, &y2);
+    }
+#endif
+
+    if (ret)
     {
         vg_lite_enable_scissor();
-        vg_lite_set_scissor(gc->clip_x1, gc->clip_y1, width, height);
-        ret = true;
+        vg_lite_set_scissor(x1, y1, x2 - x1 + 1, y2 - y1 + 1);
     }
     else {
 	    // drawing is useless
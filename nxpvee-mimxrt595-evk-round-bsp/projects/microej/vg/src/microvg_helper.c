@@ -39,7 +39,7 @@
 	#error "Undefined MICROVG_CONFIGURATION_VERSION, it must be defined in microvg_configuration.h"
 #endif
 
-#if defined MICROVG_CONFIGURATION_VERSION && MICROVG_CONFIGURATION_VERSION != 1
+#if defined MICROVG_CONFIGURATION_VERSION && MICROVG_CONFIGURATION_VERSION != 2
 	#error "Version of the configuration file microvg_configuration.h is not compatible with this implementation."
 #endif
 
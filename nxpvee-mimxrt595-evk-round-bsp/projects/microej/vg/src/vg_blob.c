@@ -0,0 +1,395 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Drawing of the animated vector images compiled by vg_compiler.py (see
+ * vg_blob.h).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <string.h>
+
+#include <LLVG_MATRIX_impl.h>
+#include <LLVG_PATH_impl.h>
+
+#include "vg_blob.h"
+#include "bsp_util.h"
+#include "display_vglite.h"
+#include "microvg_helper.h"
+#include "microvg_path.h"
+#include "microvg_vglite_helper.h"
+#include "vg_drawer.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Gets a table of the blob.
+ */
+#define BLOB_AT(blob, offset, type) ((const type*)(const void*)(((const uint8_t*)(blob)) + (offset)))
+
+/*
+ * @brief The blend of the vector images.
+ */
+#define BLOB_BLEND VG_LITE_BLEND_SRC_OVER
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief The animated values of a group.
+ */
+typedef struct {
+	float translate_x;
+	float translate_y;
+	float scale_x;
+	float scale_y;
+	float rotation;
+	float pivot_x;
+	float pivot_y;
+} group_values_t;
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief The matrices of the current group and of its ancestors, by depth.
+ */
+static float __matrices[VG_BLOB_MAX_DEPTH][LLVG_MATRIX_SIZE];
+
+/*
+ * @brief The morphed path being drawn (the GPU reads a copy in the command buffer).
+ */
+static uint32_t __morph_buffer[VG_BLOB_MORPH_BUFFER_SIZE / sizeof(uint32_t)];
+
+/*
+ * @brief The ramp of the gradients drawn with an opacity: the GPU reads it, so the
+ * drawings that use it are flushed before it is updated.
+ */
+static uint32_t __ramp[VLC_GRADBUFFER_WIDTH] __attribute__((aligned(64)));
+
+static vg_lite_linear_gradient_t __gradient;
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Gets the keyframe of a track at a time: the last one that has started.
+ *
+ * @return the keyframe, NULL before the first keyframe.
+ */
+static const VG_BLOB_keyframe_t* __get_keyframe(const VG_BLOB_header_t* blob, const VG_BLOB_track_t* track, int32_t elapsed) {
+	const VG_BLOB_keyframe_t* keyframes = BLOB_AT(blob, track->keyframes_offset, VG_BLOB_keyframe_t);
+	const VG_BLOB_keyframe_t* ret = NULL;
+	for (uint32_t i = 0; (i < track->keyframe_count) && ((int32_t)keyframes[i].start <= elapsed); i++) {
+		ret = &keyframes[i];
+	}
+	return ret;
+}
+
+/*
+ * @brief Gets the interpolated fraction of a keyframe at a time (after its start).
+ */
+static float __get_fraction(const VG_BLOB_header_t* blob, const VG_BLOB_keyframe_t* keyframe, int32_t elapsed) {
+	uint32_t samples = blob->interpolator_samples;
+	const float* table = BLOB_AT(blob, blob->interpolators_offset, float) + ((uint32_t)keyframe->interpolator * (samples + 1u));
+	uint32_t time = (uint32_t)elapsed - keyframe->start;
+	float ret = table[samples];
+
+	if (time < keyframe->duration) {
+		float position = ((float)time / (float)keyframe->duration) * (float)samples;
+		uint32_t index = (uint32_t)position;
+		if (index < samples) {
+			ret = table[index] + ((table[index + 1u] - table[index]) * (position - (float)index));
+		}
+	}
+	return ret;
+}
+
+/*
+ * @brief Interpolates two floats.
+ */
+static inline float __lerp(uint32_t from, uint32_t to, float fraction) {
+	float f0 = UINT32_t_TO_JFLOAT(from);
+	float f1 = UINT32_t_TO_JFLOAT(to);
+	return f0 + ((f1 - f0) * fraction);
+}
+
+/*
+ * @brief Interpolates two ARGB8888 colors channel by channel.
+ */
+static uint32_t __lerp_color(uint32_t from, uint32_t to, float fraction) {
+	uint32_t ret = 0;
+	for (uint32_t shift = 0; shift < 32u; shift += 8u) {
+		float c0 = (float)((from >> shift) & 0xffu);
+		float c1 = (float)((to >> shift) & 0xffu);
+		ret |= ((uint32_t)(c0 + ((c1 - c0) * fraction) + 0.5f)) << shift;
+	}
+	return ret;
+}
+
+/*
+ * @brief Gets the position of a motion path at a fraction of its length.
+ */
+static void __get_motion(const VG_BLOB_header_t* blob, const VG_BLOB_keyframe_t* keyframe, float fraction, float* x, float* y) {
+	const VG_BLOB_point_t* points = BLOB_AT(blob, keyframe->from, VG_BLOB_point_t);
+	uint32_t i = 1;
+	while (((i + 1u) < keyframe->to) && (fraction > points[i].fraction)) {
+		i++;
+	}
+	const VG_BLOB_point_t* a = &points[i - 1u];
+	const VG_BLOB_point_t* b = &points[i];
+	float ratio = 0.0f;
+	if (b->fraction > a->fraction) {
+		ratio = (fraction - a->fraction) / (b->fraction - a->fraction);
+		ratio = (ratio < 0.0f) ? 0.0f : ((ratio > 1.0f) ? 1.0f : ratio);
+	}
+	*x = a->x + ((b->x - a->x) * ratio);
+	*y = a->y + ((b->y - a->y) * ratio);
+}
+
+/*
+ * @brief Computes the matrix of a group at a time (the matrix of its parent is in
+ * the stack) and consumes the tracks of the group.
+ */
+static void __update_group(const VG_BLOB_header_t* blob, uint32_t index, const VG_BLOB_track_t** track,
+		const VG_BLOB_track_t* tracks_end, const float* matrix, int32_t elapsed) {
+	const VG_BLOB_group_t* group = &BLOB_AT(blob, blob->groups_offset, VG_BLOB_group_t)[index];
+	group_values_t values = {
+		group->translate_x, group->translate_y, group->scale_x, group->scale_y,
+		group->rotation, group->pivot_x, group->pivot_y
+	};
+	float* values_array = (float*)&values;
+
+	for (; (*track < tracks_end) && ((*track)->property < VG_BLOB_PROPERTY_FILL_ALPHA) && ((*track)->target == index); (*track)++) {
+		const VG_BLOB_keyframe_t* keyframe = __get_keyframe(blob, *track, elapsed);
+		if (NULL != keyframe) {
+			float fraction = __get_fraction(blob, keyframe, elapsed);
+			if (VG_BLOB_PROPERTY_TRANSLATE_XY == (*track)->property) {
+				__get_motion(blob, keyframe, fraction, &values.translate_x, &values.translate_y);
+			}
+			else {
+				// the properties are in the order of the fields
+				values_array[(*track)->property] = __lerp(keyframe->from, keyframe->to, fraction);
+			}
+		}
+	}
+
+	float* group_matrix = __matrices[group->depth];
+	LLVG_MATRIX_IMPL_copy(group_matrix, (0u == group->depth) ? (jfloat*)matrix : __matrices[group->depth - 1u]);
+	LLVG_MATRIX_IMPL_translate(group_matrix, values.translate_x + values.pivot_x, values.translate_y + values.pivot_y);
+	if (0.0f != values.rotation) {
+		LLVG_MATRIX_IMPL_rotate(group_matrix, values.rotation);
+	}
+	LLVG_MATRIX_IMPL_scale(group_matrix, values.scale_x, values.scale_y);
+	if ((0.0f != values.pivot_x) || (0.0f != values.pivot_y)) {
+		LLVG_MATRIX_IMPL_translate(group_matrix, -values.pivot_x, -values.pivot_y);
+	}
+}
+
+/*
+ * @brief Fills a VGLite path with a MicroVG path.
+ */
+static void __to_vglite_path(vg_lite_path_t* path, const MICROVG_PATH_HEADER_t* header) {
+	(void)memset(path, 0, sizeof(vg_lite_path_t));
+	path->bounding_box[0] = header->bounds_xmin;
+	path->bounding_box[1] = header->bounds_ymin;
+	path->bounding_box[2] = header->bounds_xmax;
+	path->bounding_box[3] = header->bounds_ymax;
+	path->quality = VG_LITE_UPPER;
+	path->format = (vg_lite_format_t)header->format;
+	path->path_length = (int32_t)header->data_size;
+	path->path = (void*)&(((uint8_t*)header)[header->data_offset]);
+	path->path_changed = 1;
+}
+
+/*
+ * @brief Points a gradient's image to a ramp.
+ */
+static void __set_ramp(vg_lite_linear_gradient_t* gradient, const uint32_t* ramp) {
+	(void)memset(&gradient->image, 0, sizeof(vg_lite_buffer_t));
+	gradient->image.width = VLC_GRADBUFFER_WIDTH;
+	gradient->image.height = 1;
+	gradient->image.stride = VLC_GRADBUFFER_WIDTH * sizeof(uint32_t);
+	// GPU displays ABGR instead of ARGB and vice versa
+	gradient->image.format = VG_LITE_RGBA8888;
+	gradient->image.memory = (void*)ramp;
+	gradient->image.address = (uint32_t)(uintptr_t)ramp;
+}
+
+// -----------------------------------------------------------------------------
+// vg_blob.h functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+BSP_DECLARE_WEAK_FCNT const VG_BLOB_image_t* VG_BLOB_get_images(uint32_t* count) {
+	// spec: no image compiled with the application
+	*count = 0;
+	return NULL;
+}
+
+// See the header file for the function documentation
+bool VG_BLOB_check(const VG_BLOB_header_t* blob) {
+	bool ret = (NULL != blob)
+			&& (VG_BLOB_MAGIC == blob->magic)
+			&& (VG_BLOB_VERSION == blob->version)
+			&& (sizeof(VG_BLOB_header_t) == blob->header_size)
+			&& (0u < blob->group_count)
+			&& (0u < blob->interpolator_samples)
+			&& (VG_BLOB_MAX_DEPTH >= blob->max_depth)
+			&& (VG_BLOB_MORPH_BUFFER_SIZE >= blob->max_path_size);
+
+	if (ret) {
+		// the colors of a gradient drawn with an opacity are copied in a VLC_MAX_GRAD array
+		const VG_BLOB_gradient_t* gradients = BLOB_AT(blob, blob->gradients_offset, VG_BLOB_gradient_t);
+		for (uint32_t i = 0; (i < blob->gradient_count) && ret; i++) {
+			ret = (0u < gradients[i].count) && (VLC_MAX_GRAD >= gradients[i].count);
+		}
+	}
+	return ret;
+}
+
+// See the header file for the function documentation
+const VG_BLOB_header_t* VG_BLOB_find(const char* name) {
+	uint32_t count;
+	const VG_BLOB_image_t* images = VG_BLOB_get_images(&count);
+	const VG_BLOB_header_t* ret = NULL;
+
+	for (uint32_t i = 0; (i < count) && (NULL == ret); i++) {
+		if (0 == strcmp(images[i].name, name)) {
+			ret = (const VG_BLOB_header_t*)(const void*)images[i].blob;
+			if (!VG_BLOB_check(ret)) {
+				// compiled for another configuration: keep the MicroVG image
+				ret = NULL;
+			}
+		}
+	}
+	return ret;
+}
+
+// See the header file for the function documentation
+vg_lite_error_t VG_BLOB_draw(void* target, const VG_BLOB_header_t* blob, const float* matrix, int32_t elapsed, uint32_t alpha) {
+	const VG_BLOB_element_t* elements = BLOB_AT(blob, blob->elements_offset, VG_BLOB_element_t);
+	const VG_BLOB_group_t* groups = BLOB_AT(blob, blob->groups_offset, VG_BLOB_group_t);
+	const VG_BLOB_gradient_t* gradients = BLOB_AT(blob, blob->gradients_offset, VG_BLOB_gradient_t);
+	const VG_BLOB_track_t* tracks_end = BLOB_AT(blob, blob->tracks_offset, VG_BLOB_track_t) + blob->track_count;
+	const VG_BLOB_track_t* group_track = BLOB_AT(blob, blob->tracks_offset, VG_BLOB_track_t);
+	const VG_BLOB_track_t* element_track = group_track;
+	uint32_t next_group = 0;
+	int32_t ramp_gradient = -1; // gradient in __ramp
+	uint32_t ramp_alpha = 0;
+	vg_lite_error_t ret = VG_LITE_SUCCESS;
+
+	while ((element_track < tracks_end) && (element_track->property < VG_BLOB_PROPERTY_FILL_ALPHA)) {
+		element_track++;
+	}
+
+	for (uint32_t index = 0; (index < blob->element_count) && (VG_LITE_SUCCESS == ret); index++) {
+		const VG_BLOB_element_t* element = &elements[index];
+
+		// the groups that precede the element (its ancestors are the last ones of each depth)
+		while (next_group <= element->group) {
+			__update_group(blob, next_group, &group_track, tracks_end, matrix, elapsed);
+			next_group++;
+		}
+
+		const MICROVG_PATH_HEADER_t* path_data = BLOB_AT(blob, element->path_offset, MICROVG_PATH_HEADER_t);
+		uint32_t color = element->color;
+		float fill_alpha = element->alpha;
+
+		for (; (element_track < tracks_end) && (element_track->target == index); element_track++) {
+			const VG_BLOB_keyframe_t* keyframe = __get_keyframe(blob, element_track, elapsed);
+			if (NULL != keyframe) {
+				float fraction = __get_fraction(blob, keyframe, elapsed);
+				if (VG_BLOB_PROPERTY_FILL_ALPHA == element_track->property) {
+					fill_alpha = __lerp(keyframe->from, keyframe->to, fraction);
+				}
+				else if (VG_BLOB_PROPERTY_FILL_COLOR == element_track->property) {
+					color = __lerp_color(keyframe->from, keyframe->to, fraction);
+				}
+				else if (0.0f >= fraction) {
+					path_data = BLOB_AT(blob, keyframe->from, MICROVG_PATH_HEADER_t);
+				}
+				else if (1.0f <= fraction) {
+					path_data = BLOB_AT(blob, keyframe->to, MICROVG_PATH_HEADER_t);
+				}
+				else {
+					// same result as a MicroVG path morphing
+					(void)LLVG_PATH_IMPL_mergePaths((jbyte*)__morph_buffer, (jbyte*)BLOB_AT(blob, keyframe->from, uint8_t),
+							(jbyte*)BLOB_AT(blob, keyframe->to, uint8_t), fraction);
+					path_data = (const MICROVG_PATH_HEADER_t*)(const void*)__morph_buffer;
+				}
+			}
+		}
+
+		fill_alpha = (fill_alpha < 0.0f) ? 0.0f : ((fill_alpha > 1.0f) ? 1.0f : fill_alpha);
+		uint32_t element_alpha = ((uint32_t)((fill_alpha * 255.0f) + 0.5f) * alpha) / 255u;
+		color = MICROVG_HELPER_apply_alpha(color, element_alpha);
+
+		if (0u != (color >> 24)) {
+			vg_lite_path_t path;
+			vg_lite_matrix_t vg_lite_matrix;
+			__to_vglite_path(&path, path_data);
+			LLVG_MATRIX_IMPL_copy(MAP_VGLITE_MATRIX(&vg_lite_matrix), __matrices[groups[element->group].depth]);
+			vg_lite_fill_t fill_rule = MICROVG_VGLITE_HELPER_get_fill_rule(element->fill_rule);
+
+			if (0 > element->gradient) {
+				vg_lite_color_t vg_lite_color = color;
+				VG_DRAWER_update_color(target, &vg_lite_color, BLOB_BLEND);
+				ret = VG_DRAWER_draw_path(target, &path, fill_rule, &vg_lite_matrix, BLOB_BLEND, vg_lite_color);
+			}
+			else {
+				const VG_BLOB_gradient_t* gradient = &gradients[element->gradient];
+				vg_lite_linear_gradient_t rom_gradient;
+				vg_lite_linear_gradient_t* vg_lite_gradient;
+
+				if (0xffu == element_alpha) {
+					// the ramp of the blob is drawn as is
+					vg_lite_gradient = &rom_gradient;
+					__set_ramp(vg_lite_gradient, BLOB_AT(blob, gradient->ramp_offset, uint32_t));
+				}
+				else {
+					vg_lite_gradient = &__gradient;
+					if ((ramp_gradient != element->gradient) || (ramp_alpha != element_alpha)) {
+						if (0 <= ramp_gradient) {
+							// the previous drawings read the ramp
+							DISPLAY_VGLITE_start_operation(false);
+						}
+						// cppcheck-suppress [misra-c2012-18.8] the size is a define
+						uint32_t colors[VLC_MAX_GRAD];
+						for (uint32_t i = 0; i < gradient->count; i++) {
+							colors[i] = MICROVG_HELPER_apply_alpha(gradient->colors[i], element_alpha);
+						}
+						__set_ramp(&__gradient, __ramp);
+						(void)vg_lite_set_grad(&__gradient, gradient->count, colors, (uint32_t*)gradient->stops);
+						VG_DRAWER_update_gradient(target, &__gradient, BLOB_BLEND);
+						ramp_gradient = element->gradient;
+						ramp_alpha = element_alpha;
+					}
+				}
+
+				jfloat* gradient_matrix = MAP_VGLITE_GRADIENT_MATRIX(vg_lite_gradient);
+				LLVG_MATRIX_IMPL_copy(gradient_matrix, MAP_VGLITE_MATRIX(&vg_lite_matrix));
+				LLVG_MATRIX_IMPL_concatenate(gradient_matrix, (jfloat*)gradient->matrix);
+				ret = VG_DRAWER_draw_gradient(target, &path, fill_rule, &vg_lite_matrix, vg_lite_gradient, BLOB_BLEND);
+			}
+		}
+	}
+	return ret;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
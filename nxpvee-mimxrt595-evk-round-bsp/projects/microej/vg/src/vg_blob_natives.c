@@ -0,0 +1,173 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Natives of com.nxp.vectorimage.CompiledVectorImageNatives: drawing of the
+ * animated vector images compiled with the application (see vg_blob.h).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <sni.h>
+
+#include <LLUI_DISPLAY.h>
+#include <LLVG_MATRIX_impl.h>
+
+#include "vg_blob.h"
+#include "display_impl.h"
+#include "display_list.h"
+#include "microvg_vglite_helper.h"
+#include "vg_drawer.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Values returned by draw().
+ */
+#define RET_SUCCESS (0)
+#define RET_ERROR_IMAGE (-1)
+#define RET_ERROR_VGLITE (-2)
+#define RET_ERROR_DESTINATION (-3)
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Gets a compiled image by its index.
+ *
+ * @return the blob, NULL when the index is invalid.
+ */
+static const VG_BLOB_header_t* __get_blob(jint image) {
+	uint32_t count;
+	const VG_BLOB_image_t* images = VG_BLOB_get_images(&count);
+	const VG_BLOB_header_t* ret = NULL;
+	if ((0 <= image) && ((uint32_t)image < count)) {
+		ret = (const VG_BLOB_header_t*)(const void*)images[image].blob;
+	}
+	return ret;
+}
+
+// -----------------------------------------------------------------------------
+// Java natives
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Finds a compiled image.
+ *
+ * @param[in] name: the resource name, null-terminated.
+ *
+ * @return the index of the image, -1 when the image has not been compiled.
+ */
+jint Java_com_nxp_vectorimage_CompiledVectorImageNatives_find(jbyte* name) {
+	uint32_t count;
+	const VG_BLOB_header_t* blob = VG_BLOB_find((const char*)name);
+	const VG_BLOB_image_t* images = VG_BLOB_get_images(&count);
+	jint ret = -1;
+
+	for (uint32_t i = 0; (NULL != blob) && (i < count) && (0 > ret); i++) {
+		if ((const void*)images[i].blob == (const void*)blob) {
+			ret = (jint)i;
+		}
+	}
+	return ret;
+}
+
+/*
+ * @brief Gets the width of a compiled image.
+ */
+jfloat Java_com_nxp_vectorimage_CompiledVectorImageNatives_getWidth(jint image) {
+	const VG_BLOB_header_t* blob = __get_blob(image);
+	return (NULL == blob) ? 0.0f : blob->width;
+}
+
+/*
+ * @brief Gets the height of a compiled image.
+ */
+jfloat Java_com_nxp_vectorimage_CompiledVectorImageNatives_getHeight(jint image) {
+	const VG_BLOB_header_t* blob = __get_blob(image);
+	return (NULL == blob) ? 0.0f : blob->height;
+}
+
+/*
+ * @brief Gets the duration of the animation of a compiled image in milliseconds.
+ */
+jint Java_com_nxp_vectorimage_CompiledVectorImageNatives_getDuration(jint image) {
+	const VG_BLOB_header_t* blob = __get_blob(image);
+	return (NULL == blob) ? 0 : (jint)blob->duration;
+}
+
+/*
+ * @brief Draws a compiled image at a given time of its animation.
+ *
+ * @param[in] gc: the destination.
+ * @param[in] x: the translation of the graphics context.
+ * @param[in] y: the translation of the graphics context.
+ * @param[in] matrix: the transformation of the image.
+ * @param[in] image: the index of the image.
+ * @param[in] elapsed: the time in the animation in milliseconds.
+ * @param[in] alpha: the opacity (0 to 255).
+ *
+ * @return RET_SUCCESS or an error code (the destination cannot be a buffered
+ * vector image).
+ */
+jint Java_com_nxp_vectorimage_CompiledVectorImageNatives_draw(MICROUI_GraphicsContext* gc, jint x, jint y, jfloat* matrix,
+		jint image, jint elapsed, jint alpha) {
+	const VG_BLOB_header_t* blob = __get_blob(image);
+	jint ret = RET_SUCCESS;
+
+	if (NULL == blob) {
+		ret = RET_ERROR_IMAGE;
+	}
+#ifdef VGLITE_USE_MULTIPLE_DRAWERS
+	else if (LLUI_DISPLAY_isCustomFormat(gc->image.format)) {
+		// the morphed paths and the ramps are not kept: a custom drawer cannot record them
+		ret = RET_ERROR_DESTINATION;
+	}
+#endif // VGLITE_USE_MULTIPLE_DRAWERS
+	else if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&(Java_com_nxp_vectorimage_CompiledVectorImageNatives_draw))
+			&& MICROVG_VGLITE_HELPER_enable_vg_lite_scissor(gc)) {
+
+		DISPLAY_IMPL_notify_drawing();
+		DISPLAY_LIST_RECORD(DISPLAY_LIST_OP_VG_COMPILED_IMAGE, gc, image, x, y, DISPLAY_LIST_ARRAY(matrix), elapsed, alpha);
+
+		void* target = VG_DRAWER_configure_target(gc);
+		jfloat image_matrix[LLVG_MATRIX_SIZE];
+
+		if((0 != x) || (0 != y)) {
+			// Create translate matrix for initial x,y translation from graphicscontext.
+			LLVG_MATRIX_IMPL_setTranslate(image_matrix, x, y);
+			LLVG_MATRIX_IMPL_concatenate(image_matrix, matrix);
+		}
+		else {
+			// use original matrix
+			LLVG_MATRIX_IMPL_copy(image_matrix, matrix);
+		}
+
+		uint32_t opacity = (alpha < 0) ? 0u : ((alpha > 0xff) ? 0xffu : (uint32_t)alpha);
+		vg_lite_error_t vg_lite_error = VG_BLOB_draw(target, blob, image_matrix, (elapsed < 0) ? 0 : elapsed, opacity);
+
+		// start the GPU operation (or report the error)
+		LLUI_DISPLAY_setDrawingStatus(VG_DRAWER_post_operation(target, vg_lite_error));
+		if (VG_LITE_SUCCESS != vg_lite_error) {
+			ret = RET_ERROR_VGLITE;
+		}
+	}
+	else {
+		// nothing to draw
+	}
+	return ret;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
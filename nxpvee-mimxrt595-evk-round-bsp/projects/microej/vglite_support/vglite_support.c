@@ -26,6 +26,19 @@
  ******************************************************************************/
 #define MAX_CONTIGUOUS_SIZE         0x100000
 #define VG_LITE_COMMAND_BUFFER_SIZE (128 << 10)
+/*
+ * Command buffers in the ring: the CPU fills one while the GPU executes the others
+ * (at most CMDBUF_COUNT, the capacity set by the build).
+ *
+ * MicroUI waits for the end of a drawing before the next one (see
+ * DISPLAY_VGLITE_start_operation()): at most one command buffer is in flight while
+ * the CPU fills the next one, and a third one never saves a stall (measured by the
+ * host test test_command_queue on a simulated GPU). A deeper ring only helps when
+ * several command buffers are flushed without waiting (a drawing that fills a whole
+ * command buffer), and each command buffer takes VG_LITE_COMMAND_BUFFER_SIZE of the
+ * VGLite heap.
+ */
+#define VG_LITE_COMMAND_BUFFER_COUNT 2
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -116,5 +129,7 @@ status_t BOARD_PrepareVGLiteController(void)
 
     vg_lite_set_command_buffer_size(vglite_cmd_buff_size);
 
+    vg_lite_set_command_buffer_count(VG_LITE_COMMAND_BUFFER_COUNT);
+
     return kStatus_Success;
 }
@@ -86,7 +86,10 @@
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
 /* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS           0
+/* Run time clock: DWT cycle counter, tickless sleep included (see cpuload_runtime.h) */
+#define configGENERATE_RUN_TIME_STATS           1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() cpuload_runtime_initialize()
+#define portGET_RUN_TIME_COUNTER_VALUE()        cpuload_runtime_get_counter()
 #define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
@@ -130,6 +133,9 @@
     /* Clock manager provides in this variable system core clock frequency */
     #include <stdint.h>
     extern uint32_t SystemCoreClock;
+    /* Run time stats clock (cpuload_runtime.c) */
+    void cpuload_runtime_initialize(void);
+    uint32_t cpuload_runtime_get_counter(void);
 #endif
 
 
@@ -0,0 +1,53 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined ARM_MATH_H
+#define ARM_MATH_H
+
+/*
+ * @file
+ * @brief Host build: the subset of CMSIS-DSP used by the UI/VG native layer,
+ * implemented with the C library.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+typedef float float32_t;
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define PI (3.14159265358979f)
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+static inline float32_t arm_sin_f32(float32_t x) {
+	return sinf(x);
+}
+
+static inline float32_t arm_cos_f32(float32_t x) {
+	return cosf(x);
+}
+
+#endif // !defined ARM_MATH_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
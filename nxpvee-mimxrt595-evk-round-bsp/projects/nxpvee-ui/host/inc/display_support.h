@@ -0,0 +1,20 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined DISPLAY_SUPPORT_H
+#define DISPLAY_SUPPORT_H
+
+/*
+ * @file
+ * @brief Host build: there is no display controller (included by vglite_window.h).
+ */
+
+#endif // !defined DISPLAY_SUPPORT_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,52 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined FSL_COMMON_H
+#define FSL_COMMON_H
+
+/*
+ * @file
+ * @brief Host build: the subset of the MCUXpresso SDK common definitions used by
+ * the UI/VG native layer.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+typedef int32_t status_t;
+
+enum {
+	kStatus_Success = 0,
+	kStatus_Fail = 1,
+};
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#ifndef MIN
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+
+#ifndef MAX
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+
+#endif // !defined FSL_COMMON_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
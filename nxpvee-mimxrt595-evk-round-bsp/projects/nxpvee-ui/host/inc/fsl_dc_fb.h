@@ -0,0 +1,20 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined FSL_DC_FB_H
+#define FSL_DC_FB_H
+
+/*
+ * @file
+ * @brief Host build: there is no display controller (included by display_framebuffer.c).
+ */
+
+#endif // !defined FSL_DC_FB_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
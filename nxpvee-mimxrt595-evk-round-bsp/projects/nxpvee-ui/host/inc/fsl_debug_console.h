@@ -0,0 +1,32 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined FSL_DEBUG_CONSOLE_H
+#define FSL_DEBUG_CONSOLE_H
+
+/*
+ * @file
+ * @brief Host build: the debug console is the standard output.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdio.h>
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define PRINTF printf
+
+#endif // !defined FSL_DEBUG_CONSOLE_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,33 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined FSL_FBDEV_H
+#define FSL_FBDEV_H
+
+/*
+ * @file
+ * @brief Host build: there is no frame buffer device (vg_lite_display_t of
+ * vglite_window.h only).
+ */
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+typedef struct {
+	void* unused;
+} fbdev_t;
+
+typedef struct {
+	void* unused;
+} fbdev_fb_info_t;
+
+#endif // !defined FSL_FBDEV_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,21 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined VGLITE_SUPPORT_H
+#define VGLITE_SUPPORT_H
+
+/*
+ * @file
+ * @brief Host build: the GPU is the software VGLite HAL (VGLiteKernel/soft), it
+ * needs no board support (included by vglite_window.h).
+ */
+
+#endif // !defined VGLITE_SUPPORT_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
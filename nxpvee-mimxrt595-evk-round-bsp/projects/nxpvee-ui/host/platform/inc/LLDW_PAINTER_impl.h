@@ -0,0 +1,35 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined LLDW_PAINTER_IMPL_H
+#define LLDW_PAINTER_IMPL_H
+
+/*
+ * @file
+ * @brief Host build: stand-in for the Drawing painter header generated by the
+ * platform build.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <LLUI_DISPLAY.h>
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#ifndef CONCAT_DEFINES
+#define CONCAT_DEFINES(a, b) a##b
+#endif
+
+#endif // !defined LLDW_PAINTER_IMPL_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
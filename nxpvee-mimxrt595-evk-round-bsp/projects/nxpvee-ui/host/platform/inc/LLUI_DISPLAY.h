@@ -0,0 +1,114 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined LLUI_DISPLAY_H
+#define LLUI_DISPLAY_H
+
+/*
+ * @file
+ * @brief Host build: stand-in for the MicroUI display header generated by the
+ * platform build. The functions are the MicroUI runtime: the test program that
+ * links the host library provides the ones it uses.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>
+
+#include <sni.h>
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+typedef enum {
+	MICROUI_IMAGE_FORMAT_LCD = 0,
+	MICROUI_IMAGE_FORMAT_ARGB8888 = 2,
+	MICROUI_IMAGE_FORMAT_RGB888 = 3,
+	MICROUI_IMAGE_FORMAT_RGB565 = 4,
+	MICROUI_IMAGE_FORMAT_ARGB1555 = 5,
+	MICROUI_IMAGE_FORMAT_ARGB4444 = 6,
+	MICROUI_IMAGE_FORMAT_A4 = 7,
+	MICROUI_IMAGE_FORMAT_A8 = 8,
+	MICROUI_IMAGE_FORMAT_A2 = 11,
+	MICROUI_IMAGE_FORMAT_A1 = 12,
+	MICROUI_IMAGE_FORMAT_CUSTOM_7 = 0xf8,
+	MICROUI_IMAGE_FORMAT_CUSTOM_6 = 0xf9,
+	MICROUI_IMAGE_FORMAT_CUSTOM_5 = 0xfa,
+	MICROUI_IMAGE_FORMAT_CUSTOM_4 = 0xfb,
+	MICROUI_IMAGE_FORMAT_CUSTOM_3 = 0xfc,
+	MICROUI_IMAGE_FORMAT_CUSTOM_2 = 0xfd,
+	MICROUI_IMAGE_FORMAT_CUSTOM_1 = 0xfe,
+	MICROUI_IMAGE_FORMAT_CUSTOM_0 = 0xff,
+} MICROUI_ImageFormat;
+
+typedef struct {
+	jchar width;
+	jchar height;
+	jbyte format;
+} MICROUI_Image;
+
+typedef struct {
+	MICROUI_Image image;
+	jint foreground_color;
+	jint background_color;
+	jint clip_x1;
+	jint clip_y1;
+	jint clip_x2;
+	jint clip_y2;
+} MICROUI_GraphicsContext;
+
+typedef enum {
+	DRAWING_DONE,
+	DRAWING_RUNNING,
+} DRAWING_Status;
+
+typedef enum {
+	DRAWING_ENDOFLINE_NONE,
+	DRAWING_ENDOFLINE_ROUNDED,
+	DRAWING_ENDOFLINE_PERPENDICULAR,
+} DRAWING_Cap;
+
+typedef enum {
+	DRAWING_FLIP_NONE,
+	DRAWING_FLIP_90,
+	DRAWING_FLIP_180,
+	DRAWING_FLIP_270,
+	DRAWING_FLIP_MIRROR,
+	DRAWING_FLIP_MIRROR_90,
+	DRAWING_FLIP_MIRROR_180,
+	DRAWING_FLIP_MIRROR_270,
+} DRAWING_Flip;
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+uint8_t* LLUI_DISPLAY_getBufferAddress(MICROUI_Image* image);
+uint32_t LLUI_DISPLAY_getStrideInBytes(MICROUI_Image* image);
+uint32_t LLUI_DISPLAY_getStrideInPixels(MICROUI_Image* image);
+bool LLUI_DISPLAY_isTransparent(MICROUI_Image* image);
+bool LLUI_DISPLAY_isLCD(MICROUI_Image* image);
+bool LLUI_DISPLAY_isCustomFormat(jbyte format);
+uint32_t LLUI_DISPLAY_readPixel(MICROUI_Image* image, jint x, jint y);
+uint32_t LLUI_DISPLAY_blend(uint32_t foreground, uint32_t background, uint32_t alpha);
+bool LLUI_DISPLAY_isClipEnabled(MICROUI_GraphicsContext* gc);
+bool LLUI_DISPLAY_isPixelInClip(MICROUI_GraphicsContext* gc, jint x, jint y);
+bool LLUI_DISPLAY_clipRectangle(MICROUI_GraphicsContext* gc, jint* x1, jint* y1, jint* x2, jint* y2);
+void LLUI_DISPLAY_setDrawingLimits(jint x1, jint y1, jint x2, jint y2);
+bool LLUI_DISPLAY_requestDrawing(MICROUI_GraphicsContext* gc, SNI_callback callback);
+void LLUI_DISPLAY_setDrawingStatus(DRAWING_Status status);
+void LLUI_DISPLAY_flushDone(bool from_isr);
+void LLUI_DISPLAY_notifyAsynchronousDrawingEnd(bool from_isr);
+
+#endif // !defined LLUI_DISPLAY_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
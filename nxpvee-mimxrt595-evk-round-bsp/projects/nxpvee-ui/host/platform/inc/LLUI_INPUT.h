@@ -0,0 +1,37 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined LLUI_INPUT_H
+#define LLUI_INPUT_H
+
+/*
+ * @file
+ * @brief Host build: stand-in for the MicroUI input header generated by the
+ * platform build (status of the input events). The event generators are
+ * provided by the test program that uses them.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <sni.h>
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+// the event has been added to the MicroUI events queue
+#define LLUI_INPUT_OK (0)
+// the MicroUI events queue is full: the event has been lost
+#define LLUI_INPUT_NOK (-1)
+
+#endif // !defined LLUI_INPUT_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
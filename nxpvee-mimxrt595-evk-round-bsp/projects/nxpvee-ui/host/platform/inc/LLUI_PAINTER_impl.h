@@ -0,0 +1,33 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined LLUI_PAINTER_IMPL_H
+#define LLUI_PAINTER_IMPL_H
+
+/*
+ * @file
+ * @brief Host build: stand-in for the MicroUI painter header generated by the
+ * platform build.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <LLUI_DISPLAY.h>
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define CONCAT_DEFINES(a, b) a##b
+
+#endif // !defined LLUI_PAINTER_IMPL_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,26 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined LLVG_FONT_PAINTER_IMPL_H
+#define LLVG_FONT_PAINTER_IMPL_H
+
+/*
+ * @file
+ * @brief Host build: stand-in for the MicroVG header generated by the platform build.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include "llvg_common.h"
+
+#endif // !defined LLVG_FONT_PAINTER_IMPL_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
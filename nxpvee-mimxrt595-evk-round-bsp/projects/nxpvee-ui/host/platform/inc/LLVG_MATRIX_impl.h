@@ -0,0 +1,46 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined LLVG_MATRIX_IMPL_H
+#define LLVG_MATRIX_IMPL_H
+
+/*
+ * @file
+ * @brief Host build: stand-in for the MicroVG matrix header generated by the platform
+ * build (implemented by vg/src/LLVG_MATRIX_impl.c).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include "llvg_common.h"
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+void LLVG_MATRIX_IMPL_identity(jfloat* matrix);
+void LLVG_MATRIX_IMPL_copy(jfloat* dest, jfloat* src);
+void LLVG_MATRIX_IMPL_setTranslate(jfloat* matrix, jfloat x, jfloat y);
+void LLVG_MATRIX_IMPL_setScale(jfloat* matrix, jfloat sx, jfloat sy);
+void LLVG_MATRIX_IMPL_setRotate(jfloat* matrix, jfloat degrees);
+void LLVG_MATRIX_IMPL_setConcat(jfloat* dest, jfloat* a, jfloat* b);
+void LLVG_MATRIX_IMPL_translate(jfloat* matrix, jfloat x, jfloat y);
+void LLVG_MATRIX_IMPL_scale(jfloat* matrix, jfloat scaleX, jfloat scaleY);
+void LLVG_MATRIX_IMPL_rotate(jfloat* matrix, jfloat angleDegrees);
+void LLVG_MATRIX_IMPL_concatenate(jfloat* matrix, jfloat* other);
+void LLVG_MATRIX_IMPL_postTranslate(jfloat* matrix, jfloat dx, jfloat dy);
+void LLVG_MATRIX_IMPL_postScale(jfloat* matrix, jfloat sx, jfloat sy);
+void LLVG_MATRIX_IMPL_postRotate(jfloat* matrix, jfloat degrees);
+void LLVG_MATRIX_IMPL_postConcat(jfloat* matrix, jfloat* other);
+
+#endif // !defined LLVG_MATRIX_IMPL_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,39 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined LLVG_PATH_IMPL_H
+#define LLVG_PATH_IMPL_H
+
+/*
+ * @file
+ * @brief Host build: stand-in for the MicroVG path header generated by the platform
+ * build (implemented by vg/src/LLVG_PATH_impl.c).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include "llvg_common.h"
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+jint LLVG_PATH_IMPL_initializePath(jbyte* jpath, jint length);
+jint LLVG_PATH_IMPL_appendPathCommand1(jbyte* jpath, jint length, jint cmd, jfloat x, jfloat y);
+jint LLVG_PATH_IMPL_appendPathCommand2(jbyte* jpath, jint length, jint cmd, jfloat x1, jfloat y1, jfloat x2, jfloat y2);
+jint LLVG_PATH_IMPL_appendPathCommand3(jbyte* jpath, jint length, jint cmd, jfloat x1, jfloat y1, jfloat x2, jfloat y2,
+		jfloat x3, jfloat y3);
+void LLVG_PATH_IMPL_reopenPath(jbyte* jpath);
+jint LLVG_PATH_IMPL_mergePaths(jbyte* jpathDest, jbyte* jpathSrc1, jbyte* jpathSrc2, jfloat ratio);
+
+#endif // !defined LLVG_PATH_IMPL_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,36 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined DW_DRAWING_H
+#define DW_DRAWING_H
+
+/*
+ * @file
+ * @brief Host build: stand-in for the Drawing header of the platform.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <LLUI_DISPLAY.h>
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+DRAWING_Status DW_DRAWING_drawThickFadedPoint(MICROUI_GraphicsContext* gc, jint x, jint y, jint thickness, jint fade);
+DRAWING_Status DW_DRAWING_drawThickFadedLine(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2, jint thickness, jint fade, DRAWING_Cap start, DRAWING_Cap end);
+DRAWING_Status DW_DRAWING_drawThickFadedCircle(MICROUI_GraphicsContext* gc, jint x, jint y, jint diameter, jint thickness, jint fade);
+DRAWING_Status DW_DRAWING_drawThickFadedCircleArc(MICROUI_GraphicsContext* gc, jint x, jint y, jint diameter, jfloat startAngle, jfloat arcAngle, jint thickness, jint fade, DRAWING_Cap start, DRAWING_Cap end);
+DRAWING_Status DW_DRAWING_drawThickFadedEllipse(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height, jint thickness, jint fade);
+
+#endif // !defined DW_DRAWING_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
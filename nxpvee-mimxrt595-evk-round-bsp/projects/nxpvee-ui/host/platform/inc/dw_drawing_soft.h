@@ -0,0 +1,46 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined DW_DRAWING_SOFT_H
+#define DW_DRAWING_SOFT_H
+
+/*
+ * @file
+ * @brief Host build: stand-in for the software Drawing drawings of the platform (the
+ * Graphics Engine is not part of the host build).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <LLUI_DISPLAY.h>
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+void DW_DRAWING_SOFT_drawThickFadedPoint();
+void DW_DRAWING_SOFT_drawThickFadedLine();
+void DW_DRAWING_SOFT_drawThickFadedCircle();
+void DW_DRAWING_SOFT_drawThickFadedCircleArc();
+void DW_DRAWING_SOFT_drawThickFadedEllipse();
+void DW_DRAWING_SOFT_drawThickLine();
+void DW_DRAWING_SOFT_drawThickCircle();
+void DW_DRAWING_SOFT_drawThickEllipse();
+void DW_DRAWING_SOFT_drawThickCircleArc();
+void DW_DRAWING_SOFT_drawFlippedImage();
+void DW_DRAWING_SOFT_drawRotatedImageNearestNeighbor();
+void DW_DRAWING_SOFT_drawRotatedImageBilinear();
+void DW_DRAWING_SOFT_drawScaledImageNearestNeighbor();
+void DW_DRAWING_SOFT_drawScaledImageBilinear();
+
+#endif // !defined DW_DRAWING_SOFT_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
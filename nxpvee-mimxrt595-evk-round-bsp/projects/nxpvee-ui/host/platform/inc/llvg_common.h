@@ -0,0 +1,67 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined LLVG_COMMON_H
+#define LLVG_COMMON_H
+
+/*
+ * @file
+ * @brief Host build: stand-in for the MicroVG constants generated by the platform
+ * build.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <LLUI_DISPLAY.h>
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define LLVG_SUCCESS 0
+#define LLVG_DATA_OVERFLOW -1
+
+#define LLVG_MATRIX_SIZE 9
+
+#define LLVG_PATH_CMD_CLOSE 0
+#define LLVG_PATH_CMD_MOVE 1
+#define LLVG_PATH_CMD_MOVE_REL 2
+#define LLVG_PATH_CMD_LINE 3
+#define LLVG_PATH_CMD_LINE_REL 4
+#define LLVG_PATH_CMD_QUAD 5
+#define LLVG_PATH_CMD_QUAD_REL 6
+#define LLVG_PATH_CMD_CUBIC 7
+#define LLVG_PATH_CMD_CUBIC_REL 8
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+enum {
+	LLVG_FILLTYPE_WINDING,
+	LLVG_FILLTYPE_EVEN_ODD,
+};
+
+enum {
+	LLVG_BLEND_SRC,
+	LLVG_BLEND_SRC_OVER,
+	LLVG_BLEND_DST_OVER,
+	LLVG_BLEND_SRC_IN,
+	LLVG_BLEND_DST_IN,
+	LLVG_BLEND_DST_OUT,
+	LLVG_BLEND_SCREEN,
+	LLVG_BLEND_MULTIPLY,
+	LLVG_BLEND_PLUS,
+};
+
+#endif // !defined LLVG_COMMON_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,35 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined MICROUI_CONSTANTS_H
+#define MICROUI_CONSTANTS_H
+
+/*
+ * @file
+ * @brief Host build: stand-in for the MicroUI constants generated by the platform
+ * build.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <LLUI_DISPLAY.h>
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define MICROUI_EVENTGEN_COMMANDS 0
+#define MICROUI_EVENTGEN_BUTTONS 1
+#define MICROUI_EVENTGEN_TOUCH 2
+
+#endif // !defined MICROUI_CONSTANTS_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
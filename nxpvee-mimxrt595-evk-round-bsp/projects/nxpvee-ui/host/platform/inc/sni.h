@@ -0,0 +1,60 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined SNI_H
+#define SNI_H
+
+/*
+ * @file
+ * @brief Host build: stand-in for the MicroEJ SNI header generated by the platform
+ * build (Java types and the SNI functions used by the natives).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+typedef int8_t jbyte;
+typedef uint16_t jchar;
+typedef int16_t jshort;
+typedef int32_t jint;
+typedef int64_t jlong;
+typedef float jfloat;
+typedef double jdouble;
+typedef uint8_t jboolean;
+
+typedef void (*SNI_callback)(void);
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define JTRUE ((jboolean)1)
+#define JFALSE ((jboolean)0)
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Gets the length of a Java array (provided by the test program).
+ */
+int32_t SNI_getArrayLength(const void* array);
+
+#endif // !defined SNI_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,47 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined UI_DRAWING_SOFT_H
+#define UI_DRAWING_SOFT_H
+
+/*
+ * @file
+ * @brief Host build: stand-in for the software MicroUI drawings of the platform
+ * (the Graphics Engine is not part of the host build).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <LLUI_DISPLAY.h>
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+void UI_DRAWING_SOFT_drawLine();
+void UI_DRAWING_SOFT_drawHorizontalLine();
+void UI_DRAWING_SOFT_drawVerticalLine();
+void UI_DRAWING_SOFT_fillRectangle();
+void UI_DRAWING_SOFT_drawRoundedRectangle();
+void UI_DRAWING_SOFT_fillRoundedRectangle();
+void UI_DRAWING_SOFT_drawCircleArc();
+void UI_DRAWING_SOFT_drawEllipseArc();
+void UI_DRAWING_SOFT_fillCircleArc();
+void UI_DRAWING_SOFT_fillEllipseArc();
+void UI_DRAWING_SOFT_drawEllipse();
+void UI_DRAWING_SOFT_fillEllipse();
+void UI_DRAWING_SOFT_drawCircle();
+void UI_DRAWING_SOFT_fillCircle();
+void UI_DRAWING_SOFT_drawImage();
+
+#endif // !defined UI_DRAWING_SOFT_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
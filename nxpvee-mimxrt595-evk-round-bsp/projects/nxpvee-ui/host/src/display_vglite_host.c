@@ -0,0 +1,271 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host build: the subset of display_vglite.h and display_impl.h used by the
+ * portable UI/VG sources, on the software VGLite HAL (VGLiteKernel/soft).
+ *
+ * The GPU executes the command buffers synchronously: an operation is done when
+ * vg_lite_finish() returns. The destination and source buffers are mapped with
+ * vg_lite_map() because the host addresses do not fit in the 32-bit GPU addresses
+ * on a 64-bit host.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <LLUI_DISPLAY.h>
+
+#include "display_vglite.h"
+#include "display_impl.h"
+#include "color.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Size of the tessellation window (same as display_vglite.c)
+ */
+#define DISPLAY_VGLITE_TESSELATION_WIDTH	256
+#define DISPLAY_VGLITE_TESSELATION_HEIGHT	256
+
+/*
+ * @brief To check if the image format is known (same as display_vglite.c)
+ */
+#define VG_LITE_UNKNOWN_FORMAT		((vg_lite_buffer_format_t) -1)
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief VGLite destination buffer (there is only one destination at any time)
+ */
+static vg_lite_buffer_t destination_buffer;
+
+/*
+ * @brief Mapping of the last source image (there is only one source per drawing)
+ */
+static vg_lite_buffer_t source_mapping;
+
+/*
+ * @brief LUT to convert MicroUI image format to VGLite image format (same as display_vglite.c)
+ */
+static const vg_lite_buffer_format_t __microui_to_vg_lite_format[] = {
+		VG_LITE_RGB565,	        // MICROUI_IMAGE_FORMAT_LCD = 0,
+		VG_LITE_UNKNOWN_FORMAT,	// UNKNOWN = 1,
+		VG_LITE_RGBA8888,		// MICROUI_IMAGE_FORMAT_ARGB8888 = 2,
+		VG_LITE_UNKNOWN_FORMAT,	// MICROUI_IMAGE_FORMAT_RGB888 = 3, unsupported
+		VG_LITE_RGB565,			// MICROUI_IMAGE_FORMAT_RGB565 = 4,
+		VG_LITE_RGBA5551,	// MICROUI_IMAGE_FORMAT_ARGB1555 = 5
+		VG_LITE_RGBA4444,		// MICROUI_IMAGE_FORMAT_ARGB4444 = 6,
+		VG_LITE_A4,				// MICROUI_IMAGE_FORMAT_A4 = 7,
+		VG_LITE_A8,				// MICROUI_IMAGE_FORMAT_A8 = 8,
+		// outside of the table ... MICROUI_IMAGE_FORMAT_CUSTOM = 255,
+};
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+static vg_lite_buffer_format_t __convert_format(MICROUI_ImageFormat microui_format) {
+	vg_lite_buffer_format_t vg_lite_format = VG_LITE_UNKNOWN_FORMAT;
+	if (microui_format < (sizeof(__microui_to_vg_lite_format) / sizeof(__microui_to_vg_lite_format[0]))) {
+		vg_lite_format = __microui_to_vg_lite_format[microui_format];
+	}
+
+	return vg_lite_format;
+}
+
+/*
+ * Gives the GPU address of a source buffer: the memory is mapped until another
+ * source is drawn.
+ */
+static void __map_source(vg_lite_buffer_t* buffer) {
+	if ((buffer->memory != source_mapping.memory) || (buffer->stride != source_mapping.stride) || (buffer->height != source_mapping.height)) {
+		// the commands of the previous source use its mapping
+		(void)vg_lite_finish();
+		if (NULL != source_mapping.handle) {
+			(void)vg_lite_unmap(&source_mapping);
+		}
+
+		source_mapping = *buffer;
+		source_mapping.handle = NULL;
+		source_mapping.address = 0;
+		if (VG_LITE_SUCCESS != vg_lite_map(&source_mapping)) {
+			DISPLAY_IMPL_error(true, "cannot map the source %p", buffer->memory);
+		}
+	}
+	// else: same source than previous drawing: nothing to do
+
+	buffer->address = source_mapping.address;
+}
+
+// -----------------------------------------------------------------------------
+// display_vglite.h functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void DISPLAY_VGLITE_init(void) {
+	vg_lite_error_t ret = vg_lite_init(DISPLAY_VGLITE_TESSELATION_WIDTH, DISPLAY_VGLITE_TESSELATION_HEIGHT);
+	if (VG_LITE_SUCCESS != ret) {
+		DISPLAY_IMPL_error(true, "vg_lite engine init failed: vg_lite_init() returned error %d", ret);
+	}
+
+	(void)memset(&destination_buffer, 0, sizeof(destination_buffer));
+	destination_buffer.tiled = VG_LITE_LINEAR;
+	destination_buffer.format = VG_LITE_RGB565;
+	destination_buffer.image_mode = VG_LITE_NORMAL_IMAGE_MODE;
+	destination_buffer.transparency_mode = VG_LITE_IMAGE_OPAQUE;
+}
+
+// See the header file for the function documentation
+vg_lite_buffer_t* DISPLAY_VGLITE_configure_destination(MICROUI_GraphicsContext* gc) {
+	MICROUI_Image* image = &gc->image;
+	void* memory = (void*)LLUI_DISPLAY_getBufferAddress(image);
+
+	if (memory != destination_buffer.memory) {
+		// the commands of the previous destination use its mapping
+		(void)vg_lite_finish();
+		if (NULL != destination_buffer.handle) {
+			(void)vg_lite_unmap(&destination_buffer);
+		}
+
+		destination_buffer.width = image->width;
+		destination_buffer.height = image->height;
+		destination_buffer.stride = LLUI_DISPLAY_getStrideInBytes(image);
+		destination_buffer.memory = memory;
+		destination_buffer.address = 0;
+		if (VG_LITE_SUCCESS != vg_lite_map(&destination_buffer)) {
+			DISPLAY_IMPL_error(true, "cannot map the destination %p", memory);
+		}
+	}
+	// else: we target the same destination than previous drawing: nothing to do
+
+	return &destination_buffer;
+}
+
+// See the header file for the function documentation
+bool DISPLAY_VGLITE_configure_source(vg_lite_buffer_t *buffer, MICROUI_Image* image) {
+	MICROUI_ImageFormat image_format = (MICROUI_ImageFormat)(uint8_t)image->format;
+	uint32_t indexed_bpp = DISPLAY_VGLITE_get_indexed_bpp(image);
+	uint32_t premultiplied_bpp = DISPLAY_VGLITE_get_premultiplied_bpp(image);
+	bool ret = true;
+
+	(void)memset(buffer, 0, sizeof(vg_lite_buffer_t));
+	buffer->width = image->width;
+	buffer->height = image->height;
+	buffer->tiled = VG_LITE_LINEAR;
+	buffer->image_mode = VG_LITE_MULTIPLY_IMAGE_MODE;
+	buffer->transparency_mode = VG_LITE_IMAGE_TRANSPARENT;
+
+	if ((uint32_t)0 != indexed_bpp) {
+		// the CLUT is a GPU state: it is pushed in the command buffer before the blit
+		ret = (VG_LITE_SUCCESS == vg_lite_set_CLUT((uint32_t)1 << indexed_bpp, DISPLAY_VGLITE_get_clut(image)));
+		buffer->format = ((uint32_t)2 == indexed_bpp) ? VG_LITE_INDEX_2 : (((uint32_t)4 == indexed_bpp) ? VG_LITE_INDEX_4 : VG_LITE_INDEX_8);
+		buffer->stride = DISPLAY_VGLITE_INDEXED_STRIDE(image->width, indexed_bpp);
+		buffer->memory = (void*)DISPLAY_VGLITE_get_indexes(image);
+	}
+	else if ((uint32_t)0 != premultiplied_bpp) {
+		// vg_lite_blit() flags the RGBA sources as premultiplied (no PE premultiply feature)
+		buffer->format = (DISPLAY_VGLITE_IMAGE_FORMAT_ARGB8888_PRE == image_format) ? VG_LITE_RGBA8888
+				: ((DISPLAY_VGLITE_IMAGE_FORMAT_ARGB4444_PRE == image_format) ? VG_LITE_RGBA4444 : VG_LITE_RGBA5551);
+		buffer->stride = DISPLAY_VGLITE_PREMULTIPLIED_STRIDE(image->width, premultiplied_bpp);
+		buffer->memory = (void*)LLUI_DISPLAY_getBufferAddress(image);
+	}
+	else {
+		buffer->format = __convert_format(image_format);
+		buffer->stride = LLUI_DISPLAY_getStrideInBytes(image);
+		buffer->memory = (void*)LLUI_DISPLAY_getBufferAddress(image);
+		ret = (VG_LITE_UNKNOWN_FORMAT != buffer->format);
+	}
+
+	if (ret) {
+		__map_source(buffer);
+	}
+
+	return ret;
+}
+
+// See the header file for the function documentation
+void DISPLAY_VGLITE_start_operation(bool wakeup_graphics_engine) {
+	(void)vg_lite_finish();
+
+	if (wakeup_graphics_engine) {
+		LLUI_DISPLAY_notifyAsynchronousDrawingEnd(false);
+	}
+}
+
+// See the header file for the function documentation (same as display_vglite.c)
+uint32_t DISPLAY_VGLITE_porter_duff_workaround_ARGB8888(uint32_t color) {
+	uint8_t alpha = COLOR_GET_CHANNEL(color, ARGB8888, ALPHA);
+	uint32_t ret;
+
+	if (alpha == (uint8_t)0) {
+		ret = 0;
+	}
+	else if(alpha == (uint8_t)0xff) {
+		ret = color;
+	}
+	else {
+		uint8_t red = (uint8_t)(
+				(uint32_t)(alpha * COLOR_GET_CHANNEL(color, ARGB8888, RED))
+				/ (uint32_t)0xff);
+		uint8_t green = (uint8_t)(
+				(uint32_t)(alpha * COLOR_GET_CHANNEL(color, ARGB8888, GREEN))
+				/ (uint32_t)0xff);
+		uint8_t blue = (uint8_t)(
+				(uint32_t)(alpha * COLOR_GET_CHANNEL(color, ARGB8888, BLUE))
+				/ (uint32_t)0xff);
+		ret = COLOR_SET_COLOR(alpha, red, green, blue, ARGB8888);
+	}
+	return ret;
+}
+
+// -----------------------------------------------------------------------------
+// display_impl.h functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void DISPLAY_IMPL_error(bool critical, const char* format, ...) {
+	va_list arg;
+	va_start(arg, format);
+	(void)vfprintf(stderr, format, arg);
+	va_end(arg);
+	(void)fputc('\n', stderr);
+	if (critical) {
+		abort();
+	}
+}
+
+// See the header file for the function documentation
+void DISPLAY_IMPL_notify_drawing(void) {
+	// no power governor on the host
+}
+
+// -----------------------------------------------------------------------------
+// vg_lite.c functions
+// -----------------------------------------------------------------------------
+
+/*
+ * Updates current Graphics Context with vglite's rendering area
+ */
+void vg_lite_draw_notify_render_area(uint32_t x, uint32_t y, uint32_t right, uint32_t bottom) {
+	LLUI_DISPLAY_setDrawingLimits(x, y, right, bottom);
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
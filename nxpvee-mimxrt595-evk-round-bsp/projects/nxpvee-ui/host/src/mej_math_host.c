@@ -0,0 +1,38 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host build: mej_math.h implemented with the C library instead of the
+ * PowerQuad coprocessor (see mej_math.c).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <math.h>
+
+#include "mej_math.h"
+
+// -----------------------------------------------------------------------------
+// mej_math.h functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+float32_t mej_tan_f32(float32_t value) {
+	return tanf(value);
+}
+
+// See the header file for the function documentation
+float32_t mej_sqrt_f32(float32_t value) {
+	return sqrtf(value);
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,51 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host build: the functions of microvg_helper.h that do not depend on the
+ * font layout (FreeType and HarfBuzz are not part of the host build), same as
+ * microvg_helper.c.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <LLVG_MATRIX_impl.h>
+
+#include "microvg_helper.h"
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+
+static jfloat g_identity_matrix[LLVG_MATRIX_SIZE];
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void MICROVG_HELPER_initialize(void) {
+	LLVG_MATRIX_IMPL_identity(g_identity_matrix);
+}
+
+// See the header file for the function documentation
+jfloat* MICROVG_HELPER_check_matrix(jfloat* matrix) {
+	return (NULL == matrix) ? g_identity_matrix : matrix;
+}
+
+// See the header file for the function documentation
+uint32_t MICROVG_HELPER_apply_alpha(uint32_t color, uint32_t alpha) {
+	uint32_t color_alpha = (((color >> 24) & (uint32_t)0xff) * alpha) / (uint32_t)255;
+	return (color &  (uint32_t)0xffffff) | (color_alpha << 24);
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
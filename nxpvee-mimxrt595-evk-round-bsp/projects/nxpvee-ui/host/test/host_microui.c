@@ -0,0 +1,252 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host build: the MicroUI runtime functions on a single RGB565 buffer, see
+ * host_microui.h.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include <LLUI_DISPLAY.h>
+#include <ui_drawing.h>
+#include <ui_drawing_soft.h>
+#include <dw_drawing_soft.h>
+
+#include "host_microui.h"
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+uint32_t HOST_MICROUI_soft_drawings;
+uint32_t HOST_MICROUI_gpu_drawings;
+
+/*
+ * @brief The buffer of the graphics context (only one at any time).
+ */
+static uint16_t* __pixels;
+
+/*
+ * @brief The images with their own data.
+ */
+static MICROUI_Image* __images[HOST_MICROUI_MAX_IMAGES];
+static void* __images_data[HOST_MICROUI_MAX_IMAGES];
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+static uint32_t __to_argb8888(uint16_t pixel) {
+	uint32_t red = ((uint32_t)pixel >> 11) & 0x1fu;
+	uint32_t green = ((uint32_t)pixel >> 5) & 0x3fu;
+	uint32_t blue = (uint32_t)pixel & 0x1fu;
+	return 0xff000000u | (((red << 3) | (red >> 2)) << 16) | (((green << 2) | (green >> 4)) << 8) | ((blue << 3) | (blue >> 2));
+}
+
+static uint16_t __to_rgb565(uint32_t color) {
+	return (uint16_t)(((color >> 8) & 0xf800u) | ((color >> 5) & 0x07e0u) | ((color >> 3) & 0x001fu));
+}
+
+static uint32_t __get_image_index(MICROUI_Image* image) {
+	uint32_t index = 0;
+	while ((index < HOST_MICROUI_MAX_IMAGES) && (image != __images[index])) {
+		index++;
+	}
+	return index;
+}
+
+static uint32_t __get_bits_per_pixel(MICROUI_Image* image) {
+	uint32_t bpp;
+	switch ((MICROUI_ImageFormat)(uint8_t)image->format) {
+	case MICROUI_IMAGE_FORMAT_ARGB8888:
+		bpp = 32;
+		break;
+	case MICROUI_IMAGE_FORMAT_RGB888:
+		bpp = 24;
+		break;
+	case MICROUI_IMAGE_FORMAT_A8:
+		bpp = 8;
+		break;
+	case MICROUI_IMAGE_FORMAT_A4:
+		bpp = 4;
+		break;
+	default:
+		bpp = 16;
+		break;
+	}
+	return bpp;
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void HOST_MICROUI_init(MICROUI_GraphicsContext* gc, uint16_t* pixels, jchar width, jchar height) {
+	__pixels = pixels;
+	gc->image.width = width;
+	gc->image.height = height;
+	gc->image.format = (jbyte)MICROUI_IMAGE_FORMAT_RGB565;
+	gc->foreground_color = 0;
+	gc->background_color = 0;
+	HOST_MICROUI_set_clip(gc, 0, 0, (jint)width - 1, (jint)height - 1);
+}
+
+// See the header file for the function documentation
+void HOST_MICROUI_set_clip(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2) {
+	gc->clip_x1 = x1;
+	gc->clip_y1 = y1;
+	gc->clip_x2 = x2;
+	gc->clip_y2 = y2;
+}
+
+// See the header file for the function documentation
+void HOST_MICROUI_set_image_data(MICROUI_Image* image, void* data) {
+	uint32_t index = __get_image_index(image);
+	if (HOST_MICROUI_MAX_IMAGES == index) {
+		// new image
+		index = __get_image_index(NULL);
+	}
+	if (HOST_MICROUI_MAX_IMAGES == index) {
+		abort();
+	}
+	__images[index] = (NULL != data) ? image : NULL;
+	__images_data[index] = data;
+}
+
+// -----------------------------------------------------------------------------
+// LLUI_DISPLAY.h functions
+// -----------------------------------------------------------------------------
+
+uint8_t* LLUI_DISPLAY_getBufferAddress(MICROUI_Image* image) {
+	uint32_t index = __get_image_index(image);
+	return (HOST_MICROUI_MAX_IMAGES == index) ? (uint8_t*)__pixels : (uint8_t*)__images_data[index];
+}
+
+uint32_t LLUI_DISPLAY_getStrideInBytes(MICROUI_Image* image) {
+	return (((uint32_t)image->width * __get_bits_per_pixel(image)) + 7u) / 8u;
+}
+
+uint32_t LLUI_DISPLAY_getStrideInPixels(MICROUI_Image* image) {
+	return image->width;
+}
+
+bool LLUI_DISPLAY_isTransparent(MICROUI_Image* image) {
+	(void)image;
+	return false;
+}
+
+uint32_t LLUI_DISPLAY_readPixel(MICROUI_Image* image, jint x, jint y) {
+	return __to_argb8888(__pixels[((uint32_t)y * image->width) + (uint32_t)x]);
+}
+
+uint32_t LLUI_DISPLAY_blend(uint32_t foreground, uint32_t background, uint32_t alpha) {
+	uint32_t result = 0xff000000u;
+	for (uint32_t shift = 0; shift < 24u; shift += 8u) {
+		uint32_t f = (foreground >> shift) & 0xffu;
+		uint32_t b = (background >> shift) & 0xffu;
+		result |= (((f * alpha) + (b * (255u - alpha)) + 127u) / 255u) << shift;
+	}
+	return result;
+}
+
+bool LLUI_DISPLAY_isClipEnabled(MICROUI_GraphicsContext* gc) {
+	return (0 != gc->clip_x1) || (0 != gc->clip_y1) || (((jint)gc->image.width - 1) != gc->clip_x2) || (((jint)gc->image.height - 1) != gc->clip_y2);
+}
+
+bool LLUI_DISPLAY_isPixelInClip(MICROUI_GraphicsContext* gc, jint x, jint y) {
+	return (x >= gc->clip_x1) && (x <= gc->clip_x2) && (y >= gc->clip_y1) && (y <= gc->clip_y2);
+}
+
+bool LLUI_DISPLAY_clipRectangle(MICROUI_GraphicsContext* gc, jint* x1, jint* y1, jint* x2, jint* y2) {
+	*x1 = (*x1 < gc->clip_x1) ? gc->clip_x1 : *x1;
+	*y1 = (*y1 < gc->clip_y1) ? gc->clip_y1 : *y1;
+	*x2 = (*x2 > gc->clip_x2) ? gc->clip_x2 : *x2;
+	*y2 = (*y2 > gc->clip_y2) ? gc->clip_y2 : *y2;
+	return (*x1 <= *x2) && (*y1 <= *y2);
+}
+
+void LLUI_DISPLAY_setDrawingLimits(jint x1, jint y1, jint x2, jint y2) {
+	(void)x1;
+	(void)y1;
+	(void)x2;
+	(void)y2;
+}
+
+void LLUI_DISPLAY_notifyAsynchronousDrawingEnd(bool from_isr) {
+	(void)from_isr;
+	HOST_MICROUI_gpu_drawings++;
+}
+
+bool LLUI_DISPLAY_requestDrawing(MICROUI_GraphicsContext* gc, SNI_callback callback) {
+	// the tests call the drawings directly
+	(void)gc;
+	(void)callback;
+	return true;
+}
+
+void LLUI_DISPLAY_setDrawingStatus(DRAWING_Status status) {
+	(void)status;
+}
+
+// -----------------------------------------------------------------------------
+// ui_drawing.h functions
+// -----------------------------------------------------------------------------
+
+DRAWING_Status UI_DRAWING_writePixel(MICROUI_GraphicsContext* gc, jint x, jint y) {
+	if (LLUI_DISPLAY_isPixelInClip(gc, x, y)) {
+		__pixels[((uint32_t)y * gc->image.width) + (uint32_t)x] = __to_rgb565((uint32_t)gc->foreground_color);
+	}
+	return DRAWING_DONE;
+}
+
+// -----------------------------------------------------------------------------
+// Software drawings: counted, not drawn
+// -----------------------------------------------------------------------------
+
+void UI_DRAWING_SOFT_drawImage() {
+	HOST_MICROUI_soft_drawings++;
+}
+
+void DW_DRAWING_SOFT_drawThickFadedLine() {
+	HOST_MICROUI_soft_drawings++;
+}
+
+void DW_DRAWING_SOFT_drawThickFadedCircleArc() {
+	HOST_MICROUI_soft_drawings++;
+}
+
+void DW_DRAWING_SOFT_drawFlippedImage() {
+	HOST_MICROUI_soft_drawings++;
+}
+
+void DW_DRAWING_SOFT_drawRotatedImageNearestNeighbor() {
+	HOST_MICROUI_soft_drawings++;
+}
+
+void DW_DRAWING_SOFT_drawRotatedImageBilinear() {
+	HOST_MICROUI_soft_drawings++;
+}
+
+void DW_DRAWING_SOFT_drawScaledImageNearestNeighbor() {
+	HOST_MICROUI_soft_drawings++;
+}
+
+void DW_DRAWING_SOFT_drawScaledImageBilinear() {
+	HOST_MICROUI_soft_drawings++;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,93 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined HOST_MICROUI_H
+#define HOST_MICROUI_H
+
+/*
+ * @file
+ * @brief Host build: the MicroUI runtime functions (LLUI_DISPLAY_*) and the
+ * software drawings (UI_DRAWING_SOFT_*, DW_DRAWING_SOFT_*) used by the drawings
+ * of the native layer (drawing_vglite.c), for the tests that draw in a RGB565
+ * buffer with the software VGLite HAL.
+ *
+ * The software drawings are not available on the host: they only count the
+ * drawings that are not done by the GPU.
+ *
+ * The images drawn in the graphics context (the sources) have their own data:
+ * see HOST_MICROUI_set_image_data().
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include <LLUI_DISPLAY.h>
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Maximal number of images with their own data.
+ */
+#define HOST_MICROUI_MAX_IMAGES (8u)
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Number of drawings done by the software algorithms.
+ */
+extern uint32_t HOST_MICROUI_soft_drawings;
+
+/*
+ * @brief Number of GPU drawings notified done (LLUI_DISPLAY_notifyAsynchronousDrawingEnd()).
+ */
+extern uint32_t HOST_MICROUI_gpu_drawings;
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Initializes a graphics context on a RGB565 buffer: black foreground,
+ * clip on the whole buffer.
+ *
+ * @param[out] gc: the graphics context
+ * @param[in] pixels: the buffer (width * height pixels, no padding)
+ * @param[in] width: the buffer width in pixels
+ * @param[in] height: the buffer height in pixels
+ */
+void HOST_MICROUI_init(MICROUI_GraphicsContext* gc, uint16_t* pixels, jchar width, jchar height);
+
+/*
+ * @brief Sets the clip of a graphics context.
+ *
+ * @param[in,out] gc: the graphics context
+ * @param[in] x1 ... y2: the clip bounds (inclusive)
+ */
+void HOST_MICROUI_set_clip(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2);
+
+/*
+ * @brief Sets the data of an image (LLUI_DISPLAY_getBufferAddress()): the layout
+ * of its format, the lines are not padded. The images without data are the buffer
+ * of the graphics context.
+ *
+ * @param[in] image: the image
+ * @param[in] data: the image data, NULL to forget the image
+ */
+void HOST_MICROUI_set_image_data(MICROUI_Image* image, void* data);
+
+#endif // !defined HOST_MICROUI_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
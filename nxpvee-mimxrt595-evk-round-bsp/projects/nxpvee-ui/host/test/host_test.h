@@ -0,0 +1,71 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined HOST_TEST_H
+#define HOST_TEST_H
+
+/*
+ * @file
+ * @brief Host build: checks and timings of the host tests (see ../CMakeLists.txt).
+ * The checks are kept in the release builds (assert() is not).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Fails the test when a condition is false.
+ */
+#define HOST_TEST_CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			(void)fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			exit(1); \
+		} \
+	} while (0)
+
+/*
+ * @brief Fails the test when two integers differ.
+ */
+#define HOST_TEST_CHECK_EQUAL(expected, actual) \
+	do { \
+		long long __e = (long long)(expected); \
+		long long __a = (long long)(actual); \
+		if (__e != __a) { \
+			(void)fprintf(stderr, "%s:%d: %s is %lld, expected %lld\n", __FILE__, __LINE__, #actual, __a, __e); \
+			exit(1); \
+		} \
+	} while (0)
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Gets the monotonic time in nanoseconds.
+ */
+static inline uint64_t HOST_TEST_now_ns(void) {
+	struct timespec now;
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000000000u) + (uint64_t)now.tv_nsec;
+}
+
+#endif // !defined HOST_TEST_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+#
+# Copyright 2023 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""Writes the images of test_vglite_image.c in a folder: for each test image,
+<name>.png, the expected straight ARGB8888 pixels (<name>.argb, little endian)
+and the conversion of the PNG by vglite_image.py in each format
+(<name>.<FORMAT>.bin). Also prints the asset memory report of the images.
+
+Usage: image_fixtures.py <folder>
+"""
+
+import os
+import struct
+import sys
+import zlib
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', '..', 'common', 'scripts'))
+import vglite_image  # noqa: E402
+
+# width not a multiple of 16 and odd: the last byte of a line is partially used
+WIDTH = 37
+HEIGHT = 11
+
+
+def colors(count):
+    """Returns count distinct colors: opaque, translucent and transparent."""
+    result = [(0, 0, 0, 0)]
+    for i in range(1, count):
+        alpha = 0xFF if (i % 3) != 0 else (i * 37) & 0xFF
+        result.append((alpha if alpha != 0 else 1, (i * 53) & 0xFF, (i * 101) & 0xFF, (i * 211 + 7) & 0xFF))
+    return result
+
+
+def indexed(count):
+    palette = colors(count)
+    return [palette[(x * 7 + y * 3) % count] for y in range(HEIGHT) for x in range(WIDTH)]
+
+
+def gradient():
+    return [(((x * 255) // (WIDTH - 1)), (y * 23) & 0xFF, (x * 7) & 0xFF, ((x + y) * 13) & 0xFF)
+            for y in range(HEIGHT) for x in range(WIDTH)]
+
+
+# name -> (pixels, formats)
+IMAGES = {
+    'index2': (indexed(4), ('INDEX2', 'INDEX4', 'INDEX8')),
+    'index4': (indexed(16), ('INDEX4', 'INDEX8')),
+    'index8': (indexed(200), ('INDEX8',)),
+    'gradient': (gradient(), ('ARGB8888', 'ARGB4444', 'ARGB1555', 'A4')),
+}
+
+
+def write_png(path, pixels):
+    raw = b''.join(b'\x00' + bytes(c for a, r, g, b in pixels[y * WIDTH:(y + 1) * WIDTH] for c in (r, g, b, a))
+                   for y in range(HEIGHT))
+
+    def chunk(kind, body):
+        return struct.pack('>I', len(body)) + kind + body + struct.pack('>I', zlib.crc32(kind + body) & 0xFFFFFFFF)
+
+    with open(path, 'wb') as f:
+        f.write(vglite_image.PNG_SIGNATURE)
+        f.write(chunk(b'IHDR', struct.pack('>IIBBBBB', WIDTH, HEIGHT, 8, 6, 0, 0, 0)))
+        f.write(chunk(b'IDAT', zlib.compress(raw)))
+        f.write(chunk(b'IEND', b''))
+
+
+def main(argv):
+    folder = argv[0]
+    os.makedirs(folder, exist_ok=True)
+    pngs = []
+    for name, (pixels, formats) in IMAGES.items():
+        png = os.path.join(folder, name + '.png')
+        write_png(png, pixels)
+        pngs.append(png)
+        with open(os.path.join(folder, name + '.argb'), 'wb') as f:
+            f.write(b''.join(struct.pack('<I', (a << 24) | (r << 16) | (g << 8) | b) for a, r, g, b in pixels))
+        for image_format in formats:
+            vglite_image.main([png, '--format', image_format, '-o', os.path.join(folder, '%s.%s.bin' % (name, image_format))])
+    return vglite_image.main(['--report'] + pngs)
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,35 @@
+#!/usr/bin/env python3
+#
+# Copyright 2023 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""Writes the visible pixels of the mask of the front panel (mask_392.png: the
+visible pixels are the ones that are not transparent) as a binary PGM image for
+test_display_mask.c: 255 for a visible pixel, 0 otherwise.
+
+Usage: mask_fixture.py <mask PNG> <PGM>
+"""
+
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', '..', 'common', 'scripts'))
+import vglite_image  # noqa: E402
+
+
+def main(argv):
+    with open(argv[0], 'rb') as f:
+        width, height, pixels = vglite_image.read_png(f.read())
+    folder = os.path.dirname(os.path.abspath(argv[1]))
+    os.makedirs(folder, exist_ok=True)
+    with open(argv[1], 'wb') as f:
+        f.write(b'P5\n%d %d\n255\n' % (width, height))
+        f.write(bytes(255 if a != 0 else 0 for a, r, g, b in pixels))
+    print('%s: %d x %d, %d visible pixels' % (argv[1], width, height, sum(1 for p in pixels if p[0] != 0)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
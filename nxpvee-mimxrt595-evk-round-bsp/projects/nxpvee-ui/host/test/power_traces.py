@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+#
+# Copyright 2023 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""Writes the workload traces replayed by test_power_governor.c in a folder, in
+the format of the console trace of the governor (POWER_GOVERNOR_TRACE_ENABLED,
+see power_governor.h): one "PG" line per frame, touch press and CPU load
+sample. A trace recorded on the board can be replayed the same way.
+
+The workloads are shaped after the demos: a watch face that redraws its hands
+once per second, a list scrolled by touch gestures and a continuous vector
+animation with heavier frames. The frames of a workload are recorded at the
+level of the profile applied at that time (0: power saving, half speed; 1: max
+performance), the replay converts them to the other levels.
+
+Usage: power_traces.py <folder>
+"""
+
+import os
+import random
+import sys
+
+# period of the CPU load samples (CPULOAD_SCHEDULE_TIME_MS)
+LOAD_PERIOD_US = 250000
+FRAME_PERIOD_US = 16667
+
+
+class Trace:
+    def __init__(self, level):
+        self.level = level
+        self.lines = []
+
+    def frame(self, time_us, render_us, flush_us):
+        self.lines.append((time_us, 'PG F %d %d %d %d' % (time_us & 0xFFFFFFFF, self.level, render_us, flush_us)))
+
+    def touch(self, time_us):
+        self.lines.append((time_us, 'PG T %d %d' % (time_us & 0xFFFFFFFF, self.level)))
+
+    def loads(self, start_us, end_us, idle_load):
+        """Adds a load sample per period: the frames plus an idle load."""
+        for time_us in range(start_us + LOAD_PERIOD_US, end_us + 1, LOAD_PERIOD_US):
+            busy_us = sum(int(line.split()[4]) + int(line.split()[5]) for t, line in self.lines
+                          if line.startswith('PG F') and (time_us - LOAD_PERIOD_US) < t <= time_us)
+            load = min(100, idle_load + (busy_us * 100) // LOAD_PERIOD_US)
+            self.lines.append((time_us, 'PG L %d %d %d' % (time_us & 0xFFFFFFFF, self.level, load)))
+
+    def write(self, path):
+        with open(path, 'w') as file:
+            # console lines that are not governor inputs are ignored
+            file.write('[PowerManagement] Switching to Max Performance Profile\n')
+            for _, line in sorted(self.lines, key=lambda line: line[0]):
+                file.write(line + '\n')
+
+
+def watch_face(start_us):
+    """One minute of a watch face redrawn once per second (power saving profile)."""
+    trace = Trace(0)
+    for second in range(60):
+        trace.frame(start_us + second * 1000000 + 12000, 6000, 4000)
+    trace.loads(start_us, start_us + 60 * 1000000, 3)
+    return trace
+
+
+def scroll(start_us, rng):
+    """Twenty gestures: a touch press, one second of 60 fps frames, two seconds still."""
+    trace = Trace(1)
+    time_us = start_us
+    for _ in range(20):
+        trace.touch(time_us)
+        for _ in range(60):
+            time_us += FRAME_PERIOD_US
+            trace.frame(time_us, rng.randint(4000, 9000), 2500)
+        time_us += 2000000
+    trace.loads(start_us, time_us, 4)
+    return trace
+
+
+def animation(start_us, rng):
+    """Thirty seconds of a 30 fps vector animation with a heavy frame from time to time."""
+    trace = Trace(1)
+    time_us = start_us
+    for i in range(900):
+        time_us += 2 * FRAME_PERIOD_US
+        render_us = rng.randint(9000, 12000) if (i % 97) < 6 else rng.randint(3000, 5500)
+        trace.frame(time_us, render_us, 1500)
+    trace.loads(start_us, time_us, 6)
+    return trace
+
+
+def main(folder):
+    os.makedirs(folder, exist_ok=True)
+    rng = random.Random(27)
+    # the 32-bit time of the board wraps during the scroll trace
+    traces = {
+        'watch_face': watch_face(5000000),
+        'scroll': scroll(0xFFFFFFFF - 10000000, rng),
+        'animation': animation(0, rng),
+    }
+    for name, trace in traces.items():
+        trace.write(os.path.join(folder, name + '.trace'))
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 2:
+        sys.exit(__doc__)
+    main(sys.argv[1])
@@ -0,0 +1,328 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host test of the sampling allocation profiler (alloc_profiler.c) with
+ * synthetic allocation streams:
+ *
+ * - unbiasedness: the estimated allocations and bytes of each site are within
+ * 4 standard deviations of the real ones (tiny objects, mid-size arrays, buffers
+ * larger than the sampling interval, mixed sizes), and the mean of the estimates
+ * over many seeds converges to the real value for a rare site;
+ * - the allocated bytes are exact;
+ * - aggregation: the samples of the table and the dropped samples add up, the
+ * top list holds the sites that allocate the most bytes, the most first;
+ * - stop, restart, reset and the allocation rate.
+ *
+ * The module is included (not linked) to give it a fake time and to set the
+ * seed of its random generator.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "host_test.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+static int64_t __time_ms;
+
+#define ALLOC_PROFILER_ENABLED 1
+#define ALLOC_PROFILER_GET_TIME_MS() (__time_ms)
+
+#include "alloc_profiler.c"
+
+#define INTERVAL (8u * 1024u)
+
+#define SITES (4u)
+
+// runs of the mean estimate of a rare site
+#define SEEDS (1000u)
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+
+typedef struct {
+	const char* name;
+	uint32_t min_size;          // sizes drawn in [min_size, max_size]
+	uint32_t max_size;
+	uint32_t weight;            // share of the allocations
+	uint64_t count;             // real allocations
+	uint64_t bytes;             // real bytes
+} test_site_t;
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+// the addresses of the types and methods
+static uint8_t __types[256];
+static uint8_t __methods[256];
+
+static uint32_t __stream_state;
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+// the random generator of the stream (not the one of the profiler)
+static uint32_t __stream_random(void) {
+	__stream_state = (__stream_state * 1664525u) + 1013904223u;
+	return __stream_state >> 8;
+}
+
+static void __restart(uint32_t seed, uint32_t sampling_interval) {
+	ALLOC_PROFILER_stop();
+	random_state = seed;
+	__time_ms = 0;
+	ALLOC_PROFILER_reset();
+	ALLOC_PROFILER_start(sampling_interval);
+}
+
+// replays a stream: returns the real number of bytes
+static uint64_t __replay(test_site_t* sites, uint32_t site_count, uint64_t bytes) {
+	uint32_t total_weight = 0;
+	for (uint32_t s = 0; s < site_count; s++) {
+		sites[s].count = 0;
+		sites[s].bytes = 0;
+		total_weight += sites[s].weight;
+	}
+
+	uint64_t allocated = 0;
+	while (allocated < bytes) {
+		uint32_t w = __stream_random() % total_weight;
+		uint32_t s = 0;
+		while (w >= sites[s].weight) {
+			w -= sites[s].weight;
+			s++;
+		}
+		test_site_t* site = &sites[s];
+		uint32_t size = site->min_size + (__stream_random() % (site->max_size - site->min_size + 1u));
+		(void)ALLOC_PROFILER_on_allocate(&__types[s], (int32_t)size, &__methods[s]);
+		site->count++;
+		site->bytes += size;
+		allocated += size;
+	}
+	return allocated;
+}
+
+static const alloc_profiler_entry_t* __find(uint32_t s) {
+	for (uint32_t i = 0; i < (uint32_t)ALLOC_PROFILER_TABLE_SIZE; i++) {
+		if ((table[i].type == &__types[s]) && (table[i].method == &__methods[s])) {
+			return &table[i];
+		}
+	}
+	return NULL;
+}
+
+static void __check_estimate(const char* name, const char* what, double estimate, double real, double samples) {
+	// a sample accounts for interval bytes at most: the standard deviation of the
+	// estimate is about real / sqrt(samples)
+	double tolerance = 4.0 / sqrt(samples);
+	double error = (estimate - real) / real;
+	(void)printf("  %-8s %-5s real %12.0f estimate %12.0f error %+6.2f%% (tolerance %5.2f%%)\n", name, what, real, estimate,
+			error * 100.0, tolerance * 100.0);
+	HOST_TEST_CHECK(fabs(error) <= tolerance);
+}
+
+static void __test_unbiased(void) {
+	test_site_t sites[SITES] = {
+		{ "objects", 12, 24, 1000, 0, 0 },
+		{ "arrays", 200, 2000, 100, 0, 0 },
+		{ "buffers", 20000, 70000, 1, 0, 0 },
+		{ "mixed", 4, 9000, 30, 0, 0 },
+	};
+
+	__stream_state = 1;
+	__restart(ALLOC_PROFILER_SEED, INTERVAL);
+	uint64_t bytes = __replay(sites, SITES, 256u * 1024u * 1024u);
+
+	ALLOC_PROFILER_stats_t stats;
+	ALLOC_PROFILER_get_stats(&stats);
+	// exact
+	HOST_TEST_CHECK_EQUAL(bytes, stats.allocated);
+	HOST_TEST_CHECK_EQUAL(SITES, stats.sites);
+	HOST_TEST_CHECK_EQUAL(0u, stats.dropped);
+	HOST_TEST_CHECK_EQUAL(INTERVAL, stats.interval);
+	(void)printf("unbiased: %llu bytes, %u samples (%llu expected)\n", (unsigned long long)bytes, stats.samples,
+			(unsigned long long)(bytes / INTERVAL));
+
+	uint32_t sampled = 0;
+	for (uint32_t s = 0; s < SITES; s++) {
+		const alloc_profiler_entry_t* entry = __find(s);
+		HOST_TEST_CHECK(NULL != entry);
+		sampled += entry->samples;
+
+		// the samples of a site: one per interval bytes, or one per allocation when larger
+		double expected_samples = (double)sites[s].bytes / INTERVAL;
+		if (expected_samples > (double)sites[s].count) {
+			expected_samples = (double)sites[s].count;
+		}
+		__check_estimate(sites[s].name, "bytes", (double)entry->bytes, (double)sites[s].bytes, expected_samples);
+		__check_estimate(sites[s].name, "count", (double)entry->count / (double)(1u << ALLOC_PROFILER_COUNT_SHIFT),
+				(double)sites[s].count, expected_samples);
+	}
+	HOST_TEST_CHECK_EQUAL(stats.samples, sampled);
+
+	// the top list: the most bytes first
+	ALLOC_PROFILER_site_t top_sites[ALLOC_PROFILER_TOP];
+	HOST_TEST_CHECK_EQUAL(SITES, ALLOC_PROFILER_get_top(top_sites, ALLOC_PROFILER_TOP));
+	for (uint32_t i = 1; i < SITES; i++) {
+		HOST_TEST_CHECK(top_sites[i - 1u].bytes >= top_sites[i].bytes);
+	}
+}
+
+static void __test_rare_site(void) {
+	// a site that allocates about 1/6 of the interval per run: sampled in a few
+	// runs only, the mean of its estimates is still its real number of bytes
+	test_site_t sites[2] = {
+		{ "common", 16, 16, 10000, 0, 0 },
+		{ "rare", 256, 256, 1, 0, 0 },
+	};
+	double sum = 0.0;
+	double real = 0.0;
+	uint32_t runs_sampled = 0;
+
+	__stream_state = 7;
+	for (uint32_t seed = 1; seed <= SEEDS; seed++) {
+		__restart(seed * 2654435761u, INTERVAL);
+		(void)__replay(sites, 2, 100u * INTERVAL);
+		const alloc_profiler_entry_t* entry = __find(1);
+		if (NULL != entry) {
+			sum += (double)entry->bytes;
+			runs_sampled++;
+		}
+		real += (double)sites[1].bytes;
+	}
+
+	(void)printf("rare site: sampled in %u of %u runs\n", runs_sampled, SEEDS);
+	// sampled about real / interval times in all the runs
+	__check_estimate("rare", "bytes", sum, real, real / INTERVAL);
+}
+
+static void __test_aggregation(void) {
+	// every allocation is sampled (interval of 1 byte): more sites than entries
+	__restart(ALLOC_PROFILER_SEED, 1);
+	uint32_t site_total = 100u;
+	for (uint32_t s = 0; s < site_total; s++) {
+		// the site s allocates (s + 1) times 10 bytes
+		for (uint32_t a = 0; a <= s; a++) {
+			HOST_TEST_CHECK(ALLOC_PROFILER_on_allocate(&__types[s], 10, &__methods[s]));
+		}
+	}
+
+	ALLOC_PROFILER_stats_t stats;
+	ALLOC_PROFILER_get_stats(&stats);
+	HOST_TEST_CHECK_EQUAL((site_total * (site_total + 1u)) / 2u, stats.samples);
+	HOST_TEST_CHECK_EQUAL(ALLOC_PROFILER_TABLE_SIZE, stats.sites);
+	uint32_t in_table = 0;
+	for (uint32_t i = 0; i < (uint32_t)ALLOC_PROFILER_TABLE_SIZE; i++) {
+		in_table += table[i].samples;
+	}
+	HOST_TEST_CHECK_EQUAL(stats.samples, in_table + stats.dropped);
+	// the first sites fit in the table, the next ones are dropped
+	HOST_TEST_CHECK_EQUAL(stats.samples - ((ALLOC_PROFILER_TABLE_SIZE * (ALLOC_PROFILER_TABLE_SIZE + 1)) / 2), stats.dropped);
+
+	// the top list: the last sites of the table, the most bytes first
+	ALLOC_PROFILER_site_t top_sites[ALLOC_PROFILER_TOP + 1];
+	HOST_TEST_CHECK_EQUAL(ALLOC_PROFILER_TOP, ALLOC_PROFILER_get_top(top_sites, ALLOC_PROFILER_TOP + 1));
+	for (uint32_t i = 0; i < (uint32_t)ALLOC_PROFILER_TOP; i++) {
+		uint32_t s = ALLOC_PROFILER_TABLE_SIZE - 1u - i;
+		HOST_TEST_CHECK(&__types[s] == top_sites[i].type);
+		HOST_TEST_CHECK(&__methods[s] == top_sites[i].method);
+		HOST_TEST_CHECK_EQUAL(s + 1u, top_sites[i].samples);
+		// p = 1 - exp(-10): almost 1
+		HOST_TEST_CHECK_EQUAL(s + 1u, top_sites[i].count);
+		HOST_TEST_CHECK(top_sites[i].bytes >= ((s + 1u) * 10u));
+		HOST_TEST_CHECK(top_sites[i].bytes <= ((s + 1u) * 11u));
+	}
+	HOST_TEST_CHECK_EQUAL(2u, ALLOC_PROFILER_get_top(top_sites, 2));
+
+	// a site out of the list that overtakes the last one enters the list
+	for (uint32_t a = 0; a < 100u; a++) {
+		(void)ALLOC_PROFILER_on_allocate(&__types[0], 10, &__methods[0]);
+	}
+	HOST_TEST_CHECK_EQUAL(ALLOC_PROFILER_TOP, ALLOC_PROFILER_get_top(top_sites, ALLOC_PROFILER_TOP));
+	HOST_TEST_CHECK(&__types[0] == top_sites[0].type);
+	HOST_TEST_CHECK_EQUAL(101u, top_sites[0].samples);
+	HOST_TEST_CHECK(&__types[ALLOC_PROFILER_TABLE_SIZE - 1] == top_sites[1].type);
+}
+
+static void __test_control(void) {
+	ALLOC_PROFILER_stats_t stats;
+
+	// the rate: 1 MB in 2 seconds
+	__restart(ALLOC_PROFILER_SEED, 1024);
+	for (uint32_t i = 0; i < 1024u; i++) {
+		__time_ms = (int64_t)((i * 2000u) / 1024u);
+		(void)ALLOC_PROFILER_on_allocate(&__types[0], 1024, &__methods[0]);
+	}
+	ALLOC_PROFILER_get_stats(&stats);
+	HOST_TEST_CHECK_EQUAL(1024u * 1024u, stats.allocated);
+	HOST_TEST_CHECK(stats.rate >= 500000u);
+	HOST_TEST_CHECK(stats.rate <= 560000u);
+	// no sample since more than two periods: the rate falls
+	__time_ms += 10000;
+	ALLOC_PROFILER_get_stats(&stats);
+	HOST_TEST_CHECK(stats.rate < 100000u);
+
+	// stopped: nothing is sampled nor counted, the statistics are kept
+	ALLOC_PROFILER_stop();
+	uint32_t samples_before = stats.samples;
+	for (uint32_t i = 0; i < 10000u; i++) {
+		HOST_TEST_CHECK(!ALLOC_PROFILER_on_allocate(&__types[1], 1024, &__methods[1]));
+	}
+	ALLOC_PROFILER_get_stats(&stats);
+	HOST_TEST_CHECK(!stats.running);
+	HOST_TEST_CHECK_EQUAL(1024u * 1024u, stats.allocated);
+	HOST_TEST_CHECK_EQUAL(samples_before, stats.samples);
+	// the countdown has only been decreased
+	HOST_TEST_CHECK_EQUAL(INT32_MAX - (10000 * 1024), ALLOC_PROFILER_state.countdown);
+
+	// restarted: the bytes are counted again from the previous total
+	ALLOC_PROFILER_start(0);
+	(void)ALLOC_PROFILER_on_allocate(&__types[1], 100, &__methods[1]);
+	ALLOC_PROFILER_get_stats(&stats);
+	HOST_TEST_CHECK(stats.running);
+	HOST_TEST_CHECK_EQUAL(ALLOC_PROFILER_SAMPLING_INTERVAL, stats.interval);
+	HOST_TEST_CHECK_EQUAL((1024u * 1024u) + 100u, stats.allocated);
+
+	// reset while running: the bytes of the current interval are counted from now
+	ALLOC_PROFILER_reset();
+	(void)ALLOC_PROFILER_on_allocate(&__types[1], 50, &__methods[1]);
+	ALLOC_PROFILER_get_stats(&stats);
+	HOST_TEST_CHECK_EQUAL(50u, stats.allocated);
+	HOST_TEST_CHECK_EQUAL(0u, stats.samples);
+	HOST_TEST_CHECK_EQUAL(0u, stats.sites);
+	ALLOC_PROFILER_dump();
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(void) {
+	__test_unbiased();
+	__test_rare_site();
+	__test_aggregation();
+	__test_control();
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
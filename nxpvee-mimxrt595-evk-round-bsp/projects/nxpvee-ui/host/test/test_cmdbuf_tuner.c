@@ -0,0 +1,409 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host test of the command buffer sizing (cmdbuf_tuner.c):
+ *
+ * - per-frame (bytes, flushes, forced flushes, peak) traces replayed through
+ * cmdbuf_tuner_on_frame(): the size doubles at a forced flush, shrinks to the
+ * peak of the last shrink_hold_frames frames plus the headroom, and is always a
+ * multiple of the granule between the minimum and the maximum; the statistics;
+ * - workloads drawn frame per frame with the vg_lite API on the software VGLite
+ * HAL, the size returned by the tuner applied between the frames as
+ * DISPLAY_VGLITE_frame_done() does: the command buffer memory and the forced
+ * flushes of each workload are printed for fixed sizes and for the tuner (with
+ * the limits of cmdbuf_tuner_configuration.h).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "cmdbuf_tuner.h"
+#include "vg_lite.h"
+#include "host_test.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define KB (1024u)
+
+// the workloads are laid out on the round display
+#define WIDTH (392)
+#define HEIGHT (392)
+
+// and drawn in a smaller target: the commands are the same, the software
+// rendering is faster
+#define TARGET_SCALE (4)
+
+// tessellation window of vg_lite_init() (display_vglite.c)
+#define TESSELLATION_SIZE (256)
+
+// frames of a workload: longer than CMDBUF_TUNER_SHRINK_HOLD_FRAMES to see the shrink
+#define WORKLOAD_FRAMES (360)
+
+// points of the polygon of a disc
+#define DISC_POINTS (48)
+
+// S16 words of a polygon: move, lines, close, end
+#define POLYGON_WORDS(points) (((points) * 3) + 2)
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+
+typedef struct {
+	const char* name;
+	void (*draw)(uint32_t frame);
+} test_workload_t;
+
+typedef struct {
+	const char* name;
+	uint32_t size;      // fixed size, 0 for the tuner
+} test_policy_t;
+
+typedef struct {
+	uint32_t average_size;
+	uint32_t forced_flushes;
+} test_result_t;
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+static uint16_t __pixels[(WIDTH / TARGET_SCALE) * (HEIGHT / TARGET_SCALE)];
+static vg_lite_buffer_t __target;
+
+static int16_t __disc_data[POLYGON_WORDS(DISC_POINTS)];
+static vg_lite_path_t __disc;
+
+// the limits of the target (cmdbuf_tuner_configuration.h)
+static const cmdbuf_tuner_config_t __config = {
+		.min_size = CMDBUF_TUNER_MIN_SIZE,
+		.max_size = CMDBUF_TUNER_MAX_SIZE,
+		.granule = CMDBUF_TUNER_GRANULE,
+		.headroom_percent = CMDBUF_TUNER_HEADROOM_PERCENT,
+		.shrink_hold_frames = CMDBUF_TUNER_SHRINK_HOLD_FRAMES,
+};
+
+// -----------------------------------------------------------------------------
+// Internal function definitions: traces
+// -----------------------------------------------------------------------------
+
+// replays a frame without forced flush
+static uint32_t __calm(cmdbuf_tuner_t* tuner, uint32_t peak) {
+	return cmdbuf_tuner_on_frame(tuner, peak * 2u, 2, 0, peak);
+}
+
+// replays a frame with a forced flush
+static uint32_t __forced(cmdbuf_tuner_t* tuner, uint32_t size) {
+	return cmdbuf_tuner_on_frame(tuner, size * 3u, 3, 2, size);
+}
+
+static void __test_grow(void) {
+	cmdbuf_tuner_t tuner;
+
+	cmdbuf_tuner_init(&tuner, &__config, 64u * KB);
+	HOST_TEST_CHECK_EQUAL(64u * KB, __calm(&tuner, 40u * KB));
+
+	// doubles at each frame with a forced flush, up to the maximum
+	HOST_TEST_CHECK_EQUAL(128u * KB, __forced(&tuner, 64u * KB));
+	HOST_TEST_CHECK_EQUAL(192u * KB, __forced(&tuner, 128u * KB));
+	HOST_TEST_CHECK_EQUAL(192u * KB, __forced(&tuner, 192u * KB));
+
+	cmdbuf_tuner_stats_t stats;
+	cmdbuf_tuner_get_stats(&tuner, &stats);
+	HOST_TEST_CHECK_EQUAL(2, stats.grows);
+	HOST_TEST_CHECK_EQUAL(0, stats.shrinks);
+	HOST_TEST_CHECK_EQUAL(4, stats.frames);
+	HOST_TEST_CHECK_EQUAL(11, stats.flushes);
+	HOST_TEST_CHECK_EQUAL(6, stats.forced_flushes);
+	HOST_TEST_CHECK_EQUAL(192u * KB, stats.peak_usage);
+	HOST_TEST_CHECK_EQUAL(576u * KB, stats.max_frame_bytes);
+	HOST_TEST_CHECK_EQUAL((80u + 192u + 384u + 576u) * KB, stats.bytes);
+	HOST_TEST_CHECK_EQUAL(192u * KB, stats.size);
+
+	// a size outside the limits (given at startup) is brought back within them
+	cmdbuf_tuner_init(&tuner, &__config, 120u * KB);
+	HOST_TEST_CHECK_EQUAL(192u * KB, __forced(&tuner, 120u * KB));
+	cmdbuf_tuner_init(&tuner, &__config, 8u * KB);
+	HOST_TEST_CHECK_EQUAL(32u * KB, __forced(&tuner, 8u * KB));
+}
+
+static void __test_shrink(void) {
+	cmdbuf_tuner_t tuner;
+	uint32_t peak = 50000u;
+
+	cmdbuf_tuner_init(&tuner, &__config, 192u * KB);
+
+	// the size is kept until shrink_hold_frames frames without forced flush
+	for (uint32_t i = 1; i < CMDBUF_TUNER_SHRINK_HOLD_FRAMES; i++) {
+		HOST_TEST_CHECK_EQUAL(192u * KB, __calm(&tuner, (1u == i) ? peak : 1000u));
+	}
+	// the peak of the window plus the headroom, rounded up to the granule:
+	// 50000 * 1.5 = 75000 -> 81920
+	HOST_TEST_CHECK_EQUAL(80u * KB, __calm(&tuner, 1000u));
+
+	// a new window: the peak of the previous one is forgotten, and the size
+	// does not go below the minimum
+	for (uint32_t i = 1; i < CMDBUF_TUNER_SHRINK_HOLD_FRAMES; i++) {
+		HOST_TEST_CHECK_EQUAL(80u * KB, __calm(&tuner, 1000u));
+	}
+	HOST_TEST_CHECK_EQUAL(32u * KB, __calm(&tuner, 1000u));
+
+	// a forced flush restarts the window
+	cmdbuf_tuner_init(&tuner, &__config, 128u * KB);
+	for (uint32_t i = 1; i < CMDBUF_TUNER_SHRINK_HOLD_FRAMES; i++) {
+		(void)__calm(&tuner, 1000u);
+	}
+	HOST_TEST_CHECK_EQUAL(192u * KB, __forced(&tuner, 128u * KB));
+	for (uint32_t i = 1; i < CMDBUF_TUNER_SHRINK_HOLD_FRAMES; i++) {
+		HOST_TEST_CHECK_EQUAL(192u * KB, __calm(&tuner, 1000u));
+	}
+	HOST_TEST_CHECK_EQUAL(32u * KB, __calm(&tuner, 1000u));
+
+	// the peak above the maximum (impossible, but clamped anyway)
+	cmdbuf_tuner_init(&tuner, &__config, 192u * KB);
+	for (uint32_t i = 0; i < CMDBUF_TUNER_SHRINK_HOLD_FRAMES; i++) {
+		HOST_TEST_CHECK_EQUAL(192u * KB, __calm(&tuner, 300u * KB));
+	}
+
+	cmdbuf_tuner_stats_t stats;
+	cmdbuf_tuner_get_stats(&tuner, &stats);
+	HOST_TEST_CHECK_EQUAL(0, stats.shrinks);
+	HOST_TEST_CHECK_EQUAL(0, stats.grows);
+}
+
+static void __test_granule(void) {
+	static const cmdbuf_tuner_config_t config = {
+			.min_size = 12000,
+			.max_size = 100000,
+			.granule = 4000,
+			.headroom_percent = 25,
+			.shrink_hold_frames = 1,
+	};
+	cmdbuf_tuner_t tuner;
+
+	// the limits are not multiples of the granule: they win
+	cmdbuf_tuner_init(&tuner, &config, 60000);
+	HOST_TEST_CHECK_EQUAL(100000, __forced(&tuner, 60000));
+	HOST_TEST_CHECK_EQUAL(100000, __forced(&tuner, 100000));
+	HOST_TEST_CHECK_EQUAL(12000, __calm(&tuner, 4000));
+
+	// 25% of headroom rounded up to the granule
+	cmdbuf_tuner_init(&tuner, &config, 100000);
+	HOST_TEST_CHECK_EQUAL(40000, __calm(&tuner, 32000));    // 40000
+	cmdbuf_tuner_init(&tuner, &config, 100000);
+	HOST_TEST_CHECK_EQUAL(44000, __calm(&tuner, 32001));    // 40001.25
+	HOST_TEST_CHECK_EQUAL(44000, __calm(&tuner, 36000));    // 45000: does not grow
+	HOST_TEST_CHECK_EQUAL(88000, __forced(&tuner, 44000));
+
+	// the size actually applied (the allocation failed)
+	cmdbuf_tuner_set_size(&tuner, 44000);
+	HOST_TEST_CHECK_EQUAL(88000, __forced(&tuner, 44000));
+}
+
+// -----------------------------------------------------------------------------
+// Internal function definitions: workloads
+// -----------------------------------------------------------------------------
+
+static void __build_disc(void) {
+	uint32_t index = 0;
+	for (uint32_t i = 0; i < DISC_POINTS; i++) {
+		// a 32-pixel radius disc around (0, 0)
+		float angle = (6.2831853f * (float)i) / (float)DISC_POINTS;
+		__disc_data[index] = (0u == i) ? VLC_OP_MOVE : VLC_OP_LINE;
+		__disc_data[index + 1u] = (int16_t)(32.0f * cosf(angle));
+		__disc_data[index + 2u] = (int16_t)(32.0f * sinf(angle));
+		index += 3u;
+	}
+	__disc_data[index] = VLC_OP_CLOSE;
+	__disc_data[index + 1u] = VLC_OP_END;
+
+	(void)memset(&__disc, 0, sizeof(__disc));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_init_path(&__disc, VG_LITE_S16, VG_LITE_HIGH, sizeof(__disc_data), __disc_data,
+			-32.0f, -32.0f, 32.0f, 32.0f));
+}
+
+// draws the disc scaled (a radius of 32 * scale pixels) around (x, y)
+static void __draw_disc(float x, float y, float scale, uint32_t color) {
+	vg_lite_matrix_t matrix;
+	vg_lite_identity(&matrix);
+	vg_lite_scale(1.0f / (float)TARGET_SCALE, 1.0f / (float)TARGET_SCALE, &matrix);
+	vg_lite_translate(x, y, &matrix);
+	vg_lite_scale(scale, scale, &matrix);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_draw(&__target, &__disc, VG_LITE_FILL_NON_ZERO, &matrix, VG_LITE_BLEND_SRC_OVER, color));
+}
+
+static void __clear(void) {
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_clear(&__target, NULL, 0xff000000u));
+}
+
+// a watch face: the dial, 60 ticks and the hands (a light and constant load)
+static void __draw_watch_face(uint32_t frame) {
+	__clear();
+	__draw_disc(196.0f, 196.0f, 6.0f, 0xff202040u);
+	for (uint32_t i = 0; i < 60u; i++) {
+		float angle = (6.2831853f * (float)i) / 60.0f;
+		__draw_disc(196.0f + (180.0f * cosf(angle)), 196.0f + (180.0f * sinf(angle)), 0.08f, 0xffc0c0c0u);
+	}
+	for (uint32_t i = 0; i < 3u; i++) {
+		float angle = (6.2831853f * (float)(frame * (i + 1u))) / 360.0f;
+		__draw_disc(196.0f + (100.0f * cosf(angle)), 196.0f + (100.0f * sinf(angle)), 0.3f, 0xffff4040u);
+	}
+}
+
+// a scrolled list: rows of icons, the number of visible icons depends on the scroll
+static void __draw_list(uint32_t frame) {
+	int32_t offset = (int32_t)((frame * 7u) % 120u);
+	__clear();
+	for (int32_t row = -1; row < 8; row++) {
+		float y = (float)((row * 56) + offset);
+		uint32_t icons = 8u + (uint32_t)((row + (int32_t)(frame / 40u)) & 7);
+		for (uint32_t i = 0; i < icons; i++) {
+			__draw_disc(20.0f + ((float)i * 22.0f), y, 0.3f, 0xff40c040u);
+			__draw_disc(20.0f + ((float)i * 22.0f), y + 20.0f, 0.15f, 0xffffffffu);
+		}
+	}
+}
+
+// an idle screen with a heavy transition (particles) every 180 frames
+static void __draw_transition(uint32_t frame) {
+	uint32_t phase = frame % 180u;
+	__clear();
+	__draw_disc(196.0f, 196.0f, 2.0f, 0xff4040ffu);
+	if (phase < 20u) {
+		uint32_t particles = 100u + (phase * 20u);
+		for (uint32_t i = 0; i < particles; i++) {
+			uint32_t hash = (i * 2654435761u) ^ (frame * 40503u);
+			__draw_disc((float)(hash % WIDTH), (float)((hash >> 12) % HEIGHT), 0.1f, 0xffffff00u | (hash & 0xffu));
+		}
+	}
+}
+
+// draws the workload with a policy, prints the command buffer memory and the forced flushes
+static test_result_t __run(const test_workload_t* workload, const test_policy_t* policy) {
+	vg_lite_command_stats_t command_stats;
+	cmdbuf_tuner_t tuner;
+	uint64_t size_sum = 0;
+	uint32_t max_size = 0;
+	uint32_t forced_frames = 0;
+
+	uint32_t size = (0u == policy->size) ? (64u * KB) : policy->size;
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_set_command_buffer_size(size));
+	(void)vg_lite_get_command_stats(&command_stats, 1);
+	HOST_TEST_CHECK_EQUAL(size, command_stats.size);
+	cmdbuf_tuner_init(&tuner, &__config, command_stats.size);
+
+	for (uint32_t frame = 0; frame < WORKLOAD_FRAMES; frame++) {
+		workload->draw(frame);
+		HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_finish());
+
+		// DISPLAY_VGLITE_frame_done()
+		(void)vg_lite_get_command_stats(&command_stats, 1);
+		size_sum += command_stats.size;
+		max_size = (command_stats.size > max_size) ? command_stats.size : max_size;
+		forced_frames += (command_stats.forced_flushes > 0u) ? 1u : 0u;
+		size = cmdbuf_tuner_on_frame(&tuner, command_stats.bytes, command_stats.flushes, command_stats.forced_flushes,
+				command_stats.peak_usage);
+		if ((0u == policy->size) && (size != command_stats.size)) {
+			HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_set_command_buffer_size(size));
+			(void)vg_lite_get_command_stats(&command_stats, 1);
+			cmdbuf_tuner_set_size(&tuner, command_stats.size);
+		}
+	}
+
+	cmdbuf_tuner_stats_t stats;
+	cmdbuf_tuner_get_stats(&tuner, &stats);
+	HOST_TEST_CHECK_EQUAL(WORKLOAD_FRAMES, stats.frames);
+	HOST_TEST_CHECK(stats.peak_usage <= max_size);
+	(void)printf("  %-12s %-8s %6u %6u %8u %6u %6u %6u", workload->name, policy->name,
+			(uint32_t)(size_sum / WORKLOAD_FRAMES / KB), max_size / KB, (uint32_t)(stats.bytes / WORKLOAD_FRAMES),
+			stats.peak_usage, stats.forced_flushes, forced_frames);
+
+	if (0u != policy->size) {
+		(void)printf("      -\n");
+	}
+	else {
+		(void)printf(" %6u\n", stats.grows + stats.shrinks);
+		HOST_TEST_CHECK(max_size <= CMDBUF_TUNER_MAX_SIZE);
+		HOST_TEST_CHECK(0u == (max_size % CMDBUF_TUNER_GRANULE));
+	}
+
+	test_result_t result = { (uint32_t)(size_sum / WORKLOAD_FRAMES), stats.forced_flushes };
+	return result;
+}
+
+static void __test_workloads(void) {
+	static const test_workload_t workloads[] = {
+			{ "watch_face", __draw_watch_face },
+			{ "list", __draw_list },
+			{ "transition", __draw_transition },
+	};
+	// the tuner starts with the size of the driver (the second one) and ends the list
+	static const test_policy_t policies[] = {
+			{ "32 KB", 32u * KB },
+			{ "64 KB", 64u * KB },
+			{ "192 KB", 192u * KB },
+			{ "tuner", 0 },
+	};
+	const uint32_t policy_count = sizeof(policies) / sizeof(policies[0]);
+	test_result_t results[sizeof(policies) / sizeof(policies[0])];
+
+	(void)memset(&__target, 0, sizeof(__target));
+	__target.width = WIDTH / TARGET_SCALE;
+	__target.height = HEIGHT / TARGET_SCALE;
+	__target.stride = (WIDTH / TARGET_SCALE) * (int32_t)sizeof(uint16_t);
+	__target.format = VG_LITE_RGB565;
+	__target.tiled = VG_LITE_LINEAR;
+	__target.memory = __pixels;
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_map(&__target));
+	__build_disc();
+
+	(void)printf("command buffers of %u frames: workload, policy, average and largest size (KB), bytes per frame,\n"
+			"peak usage, forced flushes, frames with a forced flush, resizes\n", WORKLOAD_FRAMES);
+	for (uint32_t w = 0; w < (sizeof(workloads) / sizeof(workloads[0])); w++) {
+		for (uint32_t p = 0; p < policy_count; p++) {
+			results[p] = __run(&workloads[w], &policies[p]);
+		}
+
+		// fewer forced flushes than the startup size, less memory than the largest size
+		const test_result_t* tuner = &results[policy_count - 1u];
+		HOST_TEST_CHECK(tuner->forced_flushes <= results[1].forced_flushes);
+		HOST_TEST_CHECK(tuner->average_size < results[policy_count - 2u].average_size);
+	}
+
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_unmap(&__target));
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(void) {
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_init(TESSELLATION_SIZE, TESSELLATION_SIZE));
+
+	__test_grow();
+	__test_shrink();
+	__test_granule();
+	__test_workloads();
+
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_close());
+	(void)printf("cmdbuf tuner: OK\n");
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,239 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host test of the ring of command buffers of vg_lite.c on a simulated GPU:
+ * the software VGLite HAL defers the execution of the command buffers until the
+ * test runs them (vg_lite_soft_run()), at the rate of the test.
+ *
+ * - The fences are signaled in their submission order, each one when the GPU has
+ * executed its command buffer (and not before).
+ * - The CPU stalls only when the next command buffer of the ring is in flight.
+ * - The stalls per ring depth are measured for several GPU rates; the table is
+ * printed and motivates VG_LITE_COMMAND_BUFFER_COUNT (vglite_support.c).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "vg_lite.h"
+#include "vg_lite_hal.h"
+#include "vg_lite_platform.h"
+#include "host_test.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define TESSELLATION_SIZE (256)
+#define FRAMES (240u)
+#define MAX_COMPLETIONS (16u)
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Number of command buffers executed by the GPU in each frame (the pattern
+ * is repeated), or a negative value for the MicroUI usage: the CPU waits for the
+ * end of the drawing before recording the next one; and the stalls expected for
+ * 1 to 4 command buffers in the ring.
+ */
+typedef struct {
+	const char* name;
+	int32_t runs[4];
+	uint32_t stalls[4];
+} gpu_rate_t;
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+static vg_lite_buffer_t __target;
+
+// fences signaled by the GPU interrupts, and the target pixel at that time
+static vg_lite_fence_t __completions[MAX_COMPLETIONS];
+static uint16_t __pixels[MAX_COMPLETIONS];
+static uint32_t __completion_count;
+
+static const gpu_rate_t __rates[] = {
+	// a single command buffer always waits for the GPU
+	{ "GPU twice as fast", { 2, 2, 2, 2 }, { FRAMES, 0, 0, 0 } },
+	{ "GPU as fast", { 1, 1, 1, 1 }, { FRAMES, 0, 0, 0 } },
+	// the ring absorbs the jitter when it is deeper than the GPU delay
+	{ "GPU as fast, jitter", { 0, 0, 2, 2 }, { FRAMES, FRAMES / 2u, FRAMES / 4u, 0 } },
+	// the ring only delays the first stall
+	{ "GPU twice as slow", { 1, 0, 1, 0 }, { FRAMES, (FRAMES / 2u) - 1u, (FRAMES / 2u) - 2u, (FRAMES / 2u) - 3u } },
+	{ "MicroUI (wait for the drawing)", { -1, -1, -1, -1 }, { FRAMES, 0, 0, 0 } },
+};
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+static void __gpu_irq_callback(void) {
+	vg_lite_queue_stats_t stats;
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_get_queue_stats(&stats));
+	if ((__completion_count < MAX_COMPLETIONS) && ((0u == __completion_count) || (stats.completed != __completions[__completion_count - 1u]))) {
+		__completions[__completion_count] = stats.completed;
+		__pixels[__completion_count] = *(uint16_t*)__target.memory;
+		__completion_count++;
+	}
+}
+
+static void __init(uint32_t count) {
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_set_command_buffer_count(count));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_init(TESSELLATION_SIZE, TESSELLATION_SIZE));
+	(void)memset(&__target, 0, sizeof(__target));
+	__target.width = 16;
+	__target.height = 16;
+	__target.format = VG_LITE_RGB565;
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_allocate(&__target));
+	// the initialization commands
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_finish());
+	__completion_count = 0;
+}
+
+static void __close(void) {
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_finish());
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_free(&__target));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_close());
+}
+
+// records a frame (a clear with a color that identifies it) and flushes it
+static vg_lite_fence_t __frame(uint32_t index) {
+	vg_lite_fence_t fence;
+	// opaque red levels: the red field of the RGB565 pixel is the index
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_clear(&__target, NULL, 0xff000000u | ((index & 0x1fu) << 19)));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_flush_async(&fence));
+	return fence;
+}
+
+static void __test_fence_ordering(void) {
+	vg_lite_queue_stats_t stats;
+	vg_lite_fence_t fences[5];
+
+	vg_lite_soft_set_deferred(1);
+	__init(4);
+
+	// 3 command buffers in flight: no stall
+	for (uint32_t i = 0; i < 3u; i++) {
+		fences[i] = __frame(i + 1u);
+	}
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_get_queue_stats(&stats));
+	HOST_TEST_CHECK_EQUAL(3, stats.depth);
+	HOST_TEST_CHECK_EQUAL(0, stats.stalls);
+	for (uint32_t i = 0; i < 3u; i++) {
+		HOST_TEST_CHECK(0 == vg_lite_fence_is_signaled(fences[i]));
+		HOST_TEST_CHECK((0u == i) || (fences[i] == (fences[i - 1u] + 1u)));
+	}
+	HOST_TEST_CHECK_EQUAL(0, __completion_count);
+
+	// the GPU executes the first one only
+	HOST_TEST_CHECK_EQUAL(1, vg_lite_soft_run(1));
+	HOST_TEST_CHECK(0 != vg_lite_fence_is_signaled(fences[0]));
+	HOST_TEST_CHECK(0 == vg_lite_fence_is_signaled(fences[1]));
+
+	// the 4th flush swaps to the command buffer of the 1st one: executed, no stall
+	fences[3] = __frame(4);
+	// the 5th flush swaps to the command buffer of the 2nd one: the CPU waits
+	fences[4] = __frame(5);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_get_queue_stats(&stats));
+	HOST_TEST_CHECK_EQUAL(1, stats.stalls);
+	HOST_TEST_CHECK(0 != vg_lite_fence_is_signaled(fences[1]));
+	HOST_TEST_CHECK(0 == vg_lite_fence_is_signaled(fences[2]));
+	HOST_TEST_CHECK_EQUAL(3, stats.depth);
+
+	// waiting for a fence executes the command buffers up to it, not the next ones
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_wait_fence(fences[3], 0));
+	HOST_TEST_CHECK(0 != vg_lite_fence_is_signaled(fences[3]));
+	HOST_TEST_CHECK(0 == vg_lite_fence_is_signaled(fences[4]));
+
+	HOST_TEST_CHECK_EQUAL(1, vg_lite_soft_run(10));
+	HOST_TEST_CHECK_EQUAL(0, vg_lite_soft_run(10));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_get_queue_stats(&stats));
+	HOST_TEST_CHECK_EQUAL(0, stats.depth);
+	HOST_TEST_CHECK_EQUAL(4, stats.max_depth);
+	HOST_TEST_CHECK_EQUAL(fences[4], stats.completed);
+
+	// one interrupt per command buffer, in the submission order, each one after its clear
+	HOST_TEST_CHECK_EQUAL(5, __completion_count);
+	for (uint32_t i = 0; i < 5u; i++) {
+		HOST_TEST_CHECK_EQUAL(fences[i], __completions[i]);
+		HOST_TEST_CHECK_EQUAL(i + 1u, __pixels[i] >> 11);
+	}
+
+	__close();
+	vg_lite_soft_set_deferred(0);
+}
+
+static uint32_t __stalls(uint32_t count, const gpu_rate_t* rate) {
+	vg_lite_queue_stats_t stats;
+	uint32_t stalls;
+
+	vg_lite_soft_set_deferred(1);
+	__init(count);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_get_queue_stats(&stats));
+	stalls = stats.stalls;
+
+	for (uint32_t frame = 0; frame < FRAMES; frame++) {
+		int32_t runs = rate->runs[frame % 4u];
+		vg_lite_fence_t fence = __frame(frame);
+		if (runs < 0) {
+			// the drawing ends when its fence is signaled
+			while (0 == vg_lite_fence_is_signaled(fence)) {
+				HOST_TEST_CHECK_EQUAL(1, vg_lite_soft_run(1));
+			}
+		}
+		else {
+			(void)vg_lite_soft_run((uint32_t)runs);
+		}
+	}
+
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_get_queue_stats(&stats));
+	stalls = stats.stalls - stalls;
+	__close();
+	vg_lite_soft_set_deferred(0);
+	return stalls;
+}
+
+static void __test_ring_depth(void) {
+	(void)printf("\n%-32s %30s\n", "stalls per 240 frames", "command buffers in the ring");
+	(void)printf("%-32s %7u %7u %7u %7u\n", "", 1u, 2u, 3u, 4u);
+	for (uint32_t r = 0; r < (sizeof(__rates) / sizeof(__rates[0])); r++) {
+		uint32_t stalls[4];
+		for (uint32_t count = 1; count <= 4u; count++) {
+			stalls[count - 1u] = __stalls(count, &__rates[r]);
+		}
+		(void)printf("%-32s %7u %7u %7u %7u\n", __rates[r].name, stalls[0], stalls[1], stalls[2], stalls[3]);
+		for (uint32_t i = 0; i < 4u; i++) {
+			HOST_TEST_CHECK_EQUAL(__rates[r].stalls[i], stalls[i]);
+		}
+	}
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(void) {
+	vg_lite_hal_register_irq_callback(&__gpu_irq_callback);
+
+	__test_fence_ordering();
+	__test_ring_depth();
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
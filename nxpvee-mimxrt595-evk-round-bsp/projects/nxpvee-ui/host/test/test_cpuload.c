@@ -0,0 +1,296 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host test of the per-task CPU load:
+ *
+ * - the run-time clock (cpuload_runtime.c) on a fake cycle counter: the wrap
+ * around of the cycle counter, the conversion of short intervals without loss,
+ * the change of the core clock and the sleep compensation;
+ * - the windows (cpuload_tasks.c): the 32-bit run-time counters of the tasks
+ * that wrap around, the sums over windows of 1 to CPULOAD_TASKS_SAMPLES periods,
+ * the new, deleted and dropped tasks;
+ * - both together: the loads of tasks that run and sleep across a change of
+ * the core clock.
+ *
+ * The run-time clock is included (not linked) to give it the fake cycle counter,
+ * core clock and RTC.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "host_test.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+typedef struct {
+	uint32_t DEMCR;
+} test_core_debug_t;
+
+typedef struct {
+	uint32_t CTRL;
+	uint32_t CYCCNT;
+} test_dwt_t;
+
+static test_core_debug_t __core_debug;
+static test_dwt_t __dwt;
+static uint32_t SystemCoreClock;
+static int64_t __rtc_us;
+static uint32_t __irq_disabled;
+
+#define CoreDebug (&__core_debug)
+#define CoreDebug_DEMCR_TRCENA_Msk (1u << 24)
+#define DWT (&__dwt)
+#define DWT_CTRL_CYCCNTENA_Msk (1u << 0)
+
+static uint32_t DisableGlobalIRQ(void) {
+	return __irq_disabled++;
+}
+
+static void EnableGlobalIRQ(uint32_t primask) {
+	__irq_disabled = primask;
+}
+
+int64_t time_hardware_timer_getTimeUs(void) {
+	return __rtc_us;
+}
+
+#include "cpuload_runtime.c"
+#include "cpuload_tasks.h"
+
+#define MHZ (1000000u)
+
+// units of the run-time clock per millisecond
+#define UNITS_PER_MS (CPULOAD_RUNTIME_FREQUENCY_HZ / 1000u)
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+static cpuload_tasks_t __tasks;
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+// runs the core for a number of cycles
+static void __run(uint64_t cycles) {
+	__dwt.CYCCNT += (uint32_t)cycles;
+	__rtc_us += (int64_t)((cycles * MHZ) / SystemCoreClock);
+}
+
+// sleeps: the cycle counter stops, the RTC goes on
+static void __sleep(int64_t us) {
+	cpuload_runtime_enter_sleep();
+	__rtc_us += us;
+	cpuload_runtime_exit_sleep();
+}
+
+static void __test_runtime(void) {
+	SystemCoreClock = 200u * MHZ;
+	// the cycle counter wraps around during the test
+	__dwt.CYCCNT = UINT32_MAX - 1000u;
+	cpuload_runtime_initialize();
+	HOST_TEST_CHECK(0u != (__dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk));
+	HOST_TEST_CHECK_EQUAL(0u, cpuload_runtime_get_counter64());
+
+	// 1 s in steps of 30 cycles (a context switch every 150 ns): nothing is lost
+	// in the conversion of the short intervals
+	for (uint32_t i = 0; i < ((200u * MHZ) / 30u); i++) {
+		__run(30);
+		(void)cpuload_runtime_get_counter();
+	}
+	uint64_t expected = ((uint64_t)((200u * MHZ) / 30u) * 30u * CPULOAD_RUNTIME_FREQUENCY_HZ) / (200u * MHZ);
+	uint64_t counter = cpuload_runtime_get_counter64();
+	HOST_TEST_CHECK(counter <= expected);
+	HOST_TEST_CHECK(counter >= (expected - 1u));
+	HOST_TEST_CHECK_EQUAL(0u, __irq_disabled);
+
+	// 10 s without a read would wrap the cycle counter: read every 5 s
+	for (uint32_t i = 0; i < 2u; i++) {
+		__run(1000u * MHZ);
+		(void)cpuload_runtime_get_counter();
+	}
+	HOST_TEST_CHECK_EQUAL(counter + (10u * CPULOAD_RUNTIME_FREQUENCY_HZ), cpuload_runtime_get_counter64());
+
+	// the core clock goes down to 48 MHz after 1 ms at 200 MHz: the cycles run
+	// before the change are converted at 200 MHz
+	counter = cpuload_runtime_get_counter64();
+	__run(200000u);
+	SystemCoreClock = 48u * MHZ;
+	cpuload_runtime_clock_changed();
+	HOST_TEST_CHECK_EQUAL(counter + UNITS_PER_MS, cpuload_runtime_get_counter64());
+	__run(48000u);
+	HOST_TEST_CHECK_EQUAL(counter + (2u * UNITS_PER_MS), cpuload_runtime_get_counter64());
+
+	// a sleep of 3 ms is added, the cycles run before the sleep too
+	__run(48000u);
+	counter = cpuload_runtime_get_counter64();
+	__run(4800u);
+	__sleep(3000);
+	HOST_TEST_CHECK_EQUAL(counter + (UNITS_PER_MS / 10u) + (3u * UNITS_PER_MS), cpuload_runtime_get_counter64());
+
+	// an aborted sleep: the cycle counter went on longer than the sleep time
+	counter = cpuload_runtime_get_counter64();
+	cpuload_runtime_enter_sleep();
+	__run(4800u);
+	cpuload_runtime_exit_sleep();
+	HOST_TEST_CHECK_EQUAL(counter + (UNITS_PER_MS / 10u), cpuload_runtime_get_counter64());
+
+	// the 32-bit counter wraps around every 2^32 units, not the 64-bit one
+	counter = cpuload_runtime_get_counter64();
+	uint32_t low = cpuload_runtime_get_counter();
+	__sleep(500ll * MHZ);
+	HOST_TEST_CHECK_EQUAL(counter + (500ull * CPULOAD_RUNTIME_FREQUENCY_HZ), cpuload_runtime_get_counter64());
+	HOST_TEST_CHECK_EQUAL((uint32_t)(500ull * CPULOAD_RUNTIME_FREQUENCY_HZ), cpuload_runtime_get_counter() - low);
+}
+
+static void __sample(uint32_t total, const uint32_t* runtimes, uint32_t count) {
+	static const char* names[] = { "IDLE", "MicroJvm", "Tmr Svc", "CPU load" };
+	cpuload_tasks_start_sample(&__tasks, total);
+	for (uint32_t t = 0; t < count; t++) {
+		cpuload_tasks_add(&__tasks, 10u + t, names[t % 4u], runtimes[t]);
+	}
+	cpuload_tasks_end_sample(&__tasks);
+}
+
+static void __test_windows(void) {
+	// periods of 100 ms, the counters wrap around after 5 periods
+	uint32_t period = 100u * UNITS_PER_MS;
+	uint32_t total = UINT32_MAX - (5u * period) + 1u;
+	uint32_t runtimes[3] = { total, total - 12345u, 7u };
+
+	cpuload_tasks_init(&__tasks);
+	__sample(total, runtimes, 3);
+	HOST_TEST_CHECK_EQUAL(-1, cpuload_tasks_get_load(&__tasks, 0, 1));
+
+	// 30 periods: 25% / 75% / 0%, then 10 periods: 50% / 40% / 10%
+	for (uint32_t p = 0; p < 40u; p++) {
+		uint32_t loads[3] = { 250u, 750u, 0u };
+		if (p >= 30u) {
+			loads[0] = 500u;
+			loads[1] = 400u;
+			loads[2] = 100u;
+		}
+		total += period;
+		for (uint32_t t = 0; t < 3u; t++) {
+			runtimes[t] += (period / 1000u) * loads[t];
+		}
+		__sample(total, runtimes, 3);
+	}
+	HOST_TEST_CHECK_EQUAL(CPULOAD_TASKS_SAMPLES, __tasks.count);
+	HOST_TEST_CHECK_EQUAL(500, cpuload_tasks_get_load(&__tasks, 0, 1));
+	HOST_TEST_CHECK_EQUAL(500, cpuload_tasks_get_load(&__tasks, 0, 10));
+	// (30 * 250 + 10 * 500) / 40
+	HOST_TEST_CHECK_EQUAL(312, cpuload_tasks_get_load(&__tasks, 0, 40));
+	HOST_TEST_CHECK_EQUAL(312, cpuload_tasks_get_load(&__tasks, 0, 1000));
+	// (10 * 750 + 10 * 400) / 20
+	HOST_TEST_CHECK_EQUAL(575, cpuload_tasks_get_load(&__tasks, 1, 20));
+	HOST_TEST_CHECK_EQUAL(25, cpuload_tasks_get_load(&__tasks, 2, 40));
+
+	// a longer period (modulo 2^32): the windows are weighted by the periods
+	total += 3u * period;
+	runtimes[0] += 3u * period;
+	__sample(total, runtimes, 3);
+	HOST_TEST_CHECK_EQUAL(1000, cpuload_tasks_get_load(&__tasks, 0, 1));
+	// (3 * 1000 + 500) / 4
+	HOST_TEST_CHECK_EQUAL(875, cpuload_tasks_get_load(&__tasks, 0, 2));
+
+	// a task that reports more than the period is clamped, a deleted task is
+	// forgotten, a new task starts from its creation
+	total += period;
+	runtimes[0] += 2u * period;
+	runtimes[1] = 5u;
+	runtimes[2] = 0u;
+	cpuload_tasks_start_sample(&__tasks, total);
+	cpuload_tasks_add(&__tasks, 10u, "IDLE", runtimes[0]);
+	cpuload_tasks_add(&__tasks, 99u, "new", period / 2u);
+	cpuload_tasks_end_sample(&__tasks);
+	HOST_TEST_CHECK_EQUAL(1000, cpuload_tasks_get_load(&__tasks, 0, 1));
+	// the entries of the deleted tasks are freed at the end of the sample
+	HOST_TEST_CHECK(NULL != cpuload_tasks_get(&__tasks, 3));
+	HOST_TEST_CHECK_EQUAL(99u, cpuload_tasks_get(&__tasks, 3)->id);
+	HOST_TEST_CHECK_EQUAL(500, cpuload_tasks_get_load(&__tasks, 3, 1));
+	HOST_TEST_CHECK(NULL == cpuload_tasks_get(&__tasks, 1));
+	HOST_TEST_CHECK(NULL == cpuload_tasks_get(&__tasks, 2));
+	HOST_TEST_CHECK_EQUAL(-1, cpuload_tasks_get_load(&__tasks, 2, 1));
+
+	// more tasks than entries
+	cpuload_tasks_init(&__tasks);
+	for (uint32_t s = 0; s < 2u; s++) {
+		cpuload_tasks_start_sample(&__tasks, s * period);
+		for (uint32_t t = 0; t < (CPULOAD_TASKS_MAX + 3u); t++) {
+			cpuload_tasks_add(&__tasks, t, "task", 0u);
+		}
+		cpuload_tasks_end_sample(&__tasks);
+	}
+	HOST_TEST_CHECK_EQUAL(6u, __tasks.dropped);
+	HOST_TEST_CHECK(NULL != cpuload_tasks_get(&__tasks, CPULOAD_TASKS_MAX - 1u));
+	HOST_TEST_CHECK_EQUAL(0, cpuload_tasks_get_load(&__tasks, CPULOAD_TASKS_MAX - 1u, 1));
+}
+
+static void __test_profiles(void) {
+	// every 100 ms: a task runs 20 ms at 200 MHz then 50 ms at 48 MHz, the idle
+	// task runs 10 ms then sleeps: the loads are shares of time (in cycles, the
+	// periods at 200 MHz would weigh four times more)
+	uint32_t task = 0;
+	uint32_t idle = 0;
+	SystemCoreClock = 200u * MHZ;
+	cpuload_runtime_initialize();
+	cpuload_tasks_init(&__tasks);
+
+	for (uint32_t p = 0; p <= 20u; p++) {
+		uint32_t runtimes[2] = { idle, task };
+		__sample(cpuload_runtime_get_counter(), runtimes, 2);
+		if (10u == p) {
+			SystemCoreClock = 48u * MHZ;
+			cpuload_runtime_clock_changed();
+		}
+
+		uint32_t start = cpuload_runtime_get_counter();
+		uint32_t task_ms = (p < 10u) ? 20u : 50u;
+		__run(((uint64_t)SystemCoreClock * task_ms) / 1000u);
+		uint32_t now = cpuload_runtime_get_counter();
+		task += now - start;
+		start = now;
+		__run((uint64_t)SystemCoreClock / 100u);
+		__sleep((int64_t)(90u - task_ms) * 1000);
+		idle += cpuload_runtime_get_counter() - start;
+	}
+	(void)printf("profiles: task %d permille, idle %d permille over %u periods\n",
+			cpuload_tasks_get_load(&__tasks, 1, 20), cpuload_tasks_get_load(&__tasks, 0, 20), __tasks.count);
+	// the units are rounded down: 1 permille less at most
+	int32_t load = cpuload_tasks_get_load(&__tasks, 1, 20);
+	HOST_TEST_CHECK((349 <= load) && (load <= 350));
+	load = cpuload_tasks_get_load(&__tasks, 0, 20);
+	HOST_TEST_CHECK((649 <= load) && (load <= 650));
+	load = cpuload_tasks_get_load(&__tasks, 1, 10);
+	HOST_TEST_CHECK((499 <= load) && (load <= 500));
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(void) {
+	__test_runtime();
+	__test_windows();
+	__test_profiles();
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
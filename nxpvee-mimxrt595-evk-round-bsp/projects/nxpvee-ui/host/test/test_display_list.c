@@ -0,0 +1,374 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host test of the display list (display_list.c): frames are recorded with
+ * DISPLAY_LIST_RECORD() as the painters do, dumped over RTT and read back from the
+ * RTT up buffer as the debug probe does, then parsed with DISPLAY_LIST_parse():
+ *
+ * - the frame headers (number, records, flags) and every record (drawing, target,
+ * clip, color, arguments) are the recorded ones;
+ * - the hash of a frame is the hash of its parsed records, the same frames have
+ * the same hash and a frame that differs by a color has another one;
+ * - a frame larger than the buffer is flagged truncated (its hash still covers
+ * all its drawings), a drawing in an image flags the frame foreign;
+ * - the parsing stops at the first corrupted or incomplete frame and returns the
+ * size of the complete frames before it.
+ *
+ * The module is included (not linked) to enable the recording and the dump.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "host_microui.h"
+#include "host_test.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define DISPLAY_LIST_ENABLED 1
+#define DISPLAY_LIST_DUMP_ENABLED 1
+// seven rectangles (a header and four arguments) fit
+#define DISPLAY_LIST_BUFFER_SIZE (256)
+
+#include "display_list.c"
+
+// identifiers of the LOG_DRAW events (LLUI_PAINTER_impl.c)
+#define OP_DRAW_LINE (2)
+#define OP_FILL_RECTANGLE (6)
+
+#define WIDTH (64)
+#define HEIGHT (64)
+
+#define MAX_RECORDS (64)
+#define MAX_ARGS (8)
+#define MAX_FRAMES (8)
+
+// records a drawing like the painters and remembers it to check the dump
+#define RECORD(op, gc, ...) \
+	do { \
+		const int32_t expected_args[] = { __VA_ARGS__ }; \
+		DISPLAY_LIST_RECORD((op), (gc), __VA_ARGS__); \
+		__expect((op), (gc), expected_args, sizeof(expected_args) / sizeof(int32_t)); \
+	} while (false)
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+
+typedef struct {
+	DISPLAY_LIST_record_t record;
+	int32_t args[MAX_ARGS];
+	uint32_t count;
+} test_record_t;
+
+typedef struct {
+	DISPLAY_LIST_frame_t frames[MAX_FRAMES];
+	uint32_t frame_count;
+	uint32_t hashes[MAX_FRAMES];            // hash of the parsed records of each frame
+	test_record_t records[MAX_RECORDS];
+	uint32_t record_count;
+} test_parsed_t;
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+static uint16_t __pixels[WIDTH * HEIGHT];
+static uint16_t __image_pixels[WIDTH * HEIGHT];
+
+// the records of the frames, in order
+static test_record_t __expected[MAX_RECORDS];
+static uint32_t __expected_count;
+
+// the dump read from RTT (32-bit aligned, as DISPLAY_LIST_parse() requires)
+static uint32_t __dump[DISPLAY_LIST_DUMP_RTT_BUFFER_SIZE / sizeof(uint32_t)];
+
+static test_parsed_t __parsed;
+
+// a path of a MicroVG drawing: recorded as the hash of its content
+static const float __path_data[] = { 0.0f, 0.0f, 10.0f, 0.0f, 10.0f, 10.0f };
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+static void __expect(uint16_t op, MICROUI_GraphicsContext* gc, const int32_t* args, uint32_t count) {
+	HOST_TEST_CHECK(__expected_count < MAX_RECORDS);
+	HOST_TEST_CHECK(count <= MAX_ARGS);
+	test_record_t* expected = &__expected[__expected_count];
+	(void)memset(expected, 0, sizeof(test_record_t));
+	expected->record.op = op;
+	expected->record.size = (uint16_t)(sizeof(DISPLAY_LIST_record_t) + (count * sizeof(int32_t)));
+	expected->record.target = (uint32_t)(uintptr_t)LLUI_DISPLAY_getBufferAddress(&gc->image);
+	expected->record.clip_x1 = (int16_t)gc->clip_x1;
+	expected->record.clip_y1 = (int16_t)gc->clip_y1;
+	expected->record.clip_x2 = (int16_t)gc->clip_x2;
+	expected->record.clip_y2 = (int16_t)gc->clip_y2;
+	expected->record.color = (uint32_t)gc->foreground_color;
+	(void)memcpy(expected->args, args, count * sizeof(int32_t));
+	expected->count = count;
+	__expected_count++;
+}
+
+// reads the dump from the RTT up buffer, as the debug probe does
+static uint32_t __read_rtt(void) {
+	SEGGER_RTT_BUFFER_UP* up = &_SEGGER_RTT.aUp[DISPLAY_LIST_DUMP_RTT_CHANNEL];
+	uint8_t* dest = (uint8_t*)__dump;
+	uint32_t size = 0;
+
+	while (up->RdOff != up->WrOff) {
+		HOST_TEST_CHECK(size < sizeof(__dump));
+		dest[size] = (uint8_t)up->pBuffer[up->RdOff];
+		size++;
+		up->RdOff = (up->RdOff + 1u) % up->SizeOfBuffer;
+	}
+	return size;
+}
+
+static void __on_frame(const DISPLAY_LIST_frame_t* frame, void* user) {
+	test_parsed_t* parsed = (test_parsed_t*)user;
+	HOST_TEST_CHECK(parsed->frame_count < MAX_FRAMES);
+	parsed->frames[parsed->frame_count] = *frame;
+	parsed->hashes[parsed->frame_count] = FNV_OFFSET_BASIS;
+	parsed->frame_count++;
+}
+
+static void __on_record(const DISPLAY_LIST_record_t* record, const int32_t* args, uint32_t count, void* user) {
+	test_parsed_t* parsed = (test_parsed_t*)user;
+	HOST_TEST_CHECK(parsed->record_count < MAX_RECORDS);
+	HOST_TEST_CHECK(count <= MAX_ARGS);
+	test_record_t* dest = &parsed->records[parsed->record_count];
+	(void)memset(dest, 0, sizeof(test_record_t));
+	dest->record = *record;
+	(void)memcpy(dest->args, args, count * sizeof(int32_t));
+	dest->count = count;
+	parsed->record_count++;
+
+	// the hash of the frame, as recorded
+	uint32_t* hash = &parsed->hashes[parsed->frame_count - 1u];
+	*hash = __display_list_hash(*hash, record, sizeof(DISPLAY_LIST_record_t));
+	*hash = __display_list_hash(*hash, args, count * sizeof(int32_t));
+}
+
+static uint32_t __parse(const uint8_t* data, uint32_t size) {
+	static const DISPLAY_LIST_visitor_t visitor = { __on_frame, __on_record };
+	(void)memset(&__parsed, 0, sizeof(__parsed));
+	return DISPLAY_LIST_parse(data, size, &visitor, &__parsed);
+}
+
+static void __check_record(const test_record_t* expected, const test_record_t* actual) {
+	HOST_TEST_CHECK_EQUAL(expected->record.op, actual->record.op);
+	HOST_TEST_CHECK_EQUAL(expected->record.size, actual->record.size);
+	HOST_TEST_CHECK_EQUAL(expected->record.target, actual->record.target);
+	HOST_TEST_CHECK_EQUAL(expected->record.clip_x1, actual->record.clip_x1);
+	HOST_TEST_CHECK_EQUAL(expected->record.clip_y1, actual->record.clip_y1);
+	HOST_TEST_CHECK_EQUAL(expected->record.clip_x2, actual->record.clip_x2);
+	HOST_TEST_CHECK_EQUAL(expected->record.clip_y2, actual->record.clip_y2);
+	HOST_TEST_CHECK_EQUAL(expected->record.color, actual->record.color);
+	HOST_TEST_CHECK_EQUAL(expected->count, actual->count);
+	HOST_TEST_CHECK(0 == memcmp(expected->args, actual->args, expected->count * sizeof(int32_t)));
+}
+
+// a frame of a watch face: the background, a line and a path
+static void __draw_scene(MICROUI_GraphicsContext* gc, uint32_t hand_color) {
+	gc->foreground_color = 0x202020;
+	RECORD(OP_FILL_RECTANGLE, gc, 0, 0, WIDTH, HEIGHT);
+	gc->foreground_color = (jint)hand_color;
+	HOST_MICROUI_set_clip(gc, 8, 8, WIDTH - 9, HEIGHT - 9);
+	RECORD(OP_DRAW_LINE, gc, 32, 32, 32, 10);
+	RECORD(DISPLAY_LIST_OP_VG_PATH, gc, (int32_t)DISPLAY_LIST_hash(__path_data, sizeof(__path_data)), 20, 20,
+			DISPLAY_LIST_float(1.5f), 0, 3, (int32_t)0xff00ff00u);
+	HOST_MICROUI_set_clip(gc, 0, 0, WIDTH - 1, HEIGHT - 1);
+}
+
+static void __test_record_and_parse(void) {
+	MICROUI_GraphicsContext gc;
+	MICROUI_GraphicsContext image_gc;
+	uint32_t frame_records[MAX_FRAMES];
+
+	HOST_MICROUI_init(&gc, __pixels, WIDTH, HEIGHT);
+	image_gc = gc;
+	HOST_MICROUI_set_image_data(&image_gc.image, __image_pixels);
+
+	DISPLAY_LIST_dump(6);
+
+	// 0 and 1: the same frame
+	for (uint32_t i = 0; i < 2u; i++) {
+		DISPLAY_LIST_start_frame((const uint8_t*)__pixels);
+		__draw_scene(&gc, 0xff0000);
+		DISPLAY_LIST_end_frame();
+		frame_records[i] = 3;
+	}
+
+	// 2: the hand in another color
+	DISPLAY_LIST_start_frame((const uint8_t*)__pixels);
+	__draw_scene(&gc, 0x0000ff);
+	DISPLAY_LIST_end_frame();
+	frame_records[2] = 3;
+
+	// 3: a drawing in an image
+	DISPLAY_LIST_start_frame((const uint8_t*)__pixels);
+	image_gc.foreground_color = 0x00ff00;
+	RECORD(OP_FILL_RECTANGLE, &image_gc, 1, 2, 3, 4);
+	RECORD(DISPLAY_LIST_OP_VG_BUFFERED_IMAGE_CLEAR, &image_gc, 0);
+	__draw_scene(&gc, 0xff0000);
+	DISPLAY_LIST_end_frame();
+	frame_records[3] = 5;
+
+	// 4: more drawings than the buffer holds (twelve rectangles of 36 bytes)
+	DISPLAY_LIST_start_frame((const uint8_t*)__pixels);
+	uint32_t truncated_hash = FNV_OFFSET_BASIS;
+	for (int32_t i = 0; i < 12; i++) {
+		gc.foreground_color = i;
+		RECORD(OP_FILL_RECTANGLE, &gc, i, i, 10, 10);
+		const test_record_t* expected = &__expected[__expected_count - 1u];
+		truncated_hash = __display_list_hash(truncated_hash, &expected->record, sizeof(DISPLAY_LIST_record_t));
+		truncated_hash = __display_list_hash(truncated_hash, expected->args, expected->count * sizeof(int32_t));
+	}
+	DISPLAY_LIST_end_frame();
+	frame_records[4] = 12;
+
+	// 5: nothing drawn
+	DISPLAY_LIST_start_frame((const uint8_t*)__pixels);
+	DISPLAY_LIST_end_frame();
+	frame_records[5] = 0;
+
+	// 6: not dumped
+	DISPLAY_LIST_start_frame((const uint8_t*)__pixels);
+	__draw_scene(&gc, 0xff0000);
+	DISPLAY_LIST_end_frame();
+
+	DISPLAY_LIST_stats_t stats;
+	DISPLAY_LIST_get_stats(&stats);
+	HOST_TEST_CHECK_EQUAL(7, stats.frames);
+	HOST_TEST_CHECK_EQUAL(1, stats.truncated_frames);
+	HOST_TEST_CHECK_EQUAL(6, stats.dumped_frames);
+	HOST_TEST_CHECK_EQUAL(12, stats.max_records);
+	HOST_TEST_CHECK_EQUAL(7u * 36u, stats.max_size);
+
+	uint32_t size = __read_rtt();
+	HOST_TEST_CHECK_EQUAL(size, __parse((const uint8_t*)__dump, size));
+	HOST_TEST_CHECK_EQUAL(6, __parsed.frame_count);
+
+	// the frames and their records: all the recorded ones but the truncated ones
+	uint32_t expected_index = 0;
+	uint32_t parsed_index = 0;
+	uint32_t dump_size = 0;
+	for (uint32_t f = 0; f < __parsed.frame_count; f++) {
+		const DISPLAY_LIST_frame_t* frame = &__parsed.frames[f];
+		uint32_t kept = (4u == f) ? 7u : frame_records[f];
+
+		HOST_TEST_CHECK_EQUAL(DISPLAY_LIST_MAGIC, frame->magic);
+		HOST_TEST_CHECK_EQUAL(f, frame->frame);
+		HOST_TEST_CHECK_EQUAL(frame_records[f], frame->records);
+		HOST_TEST_CHECK_EQUAL((3u == f) ? DISPLAY_LIST_FLAG_FOREIGN : ((4u == f) ? DISPLAY_LIST_FLAG_TRUNCATED : 0u), frame->flags);
+		for (uint32_t r = 0; r < kept; r++) {
+			__check_record(&__expected[expected_index + r], &__parsed.records[parsed_index + r]);
+		}
+		expected_index += frame_records[f];
+		parsed_index += kept;
+		dump_size += sizeof(DISPLAY_LIST_frame_t) + frame->size;
+
+		if (4u == f) {
+			// the hash covers the records that are not dumped
+			HOST_TEST_CHECK_EQUAL(truncated_hash, frame->hash);
+			HOST_TEST_CHECK(__parsed.hashes[f] != frame->hash);
+		}
+		else {
+			HOST_TEST_CHECK_EQUAL(__parsed.hashes[f], frame->hash);
+		}
+	}
+	HOST_TEST_CHECK_EQUAL(parsed_index, __parsed.record_count);
+	HOST_TEST_CHECK_EQUAL(size, dump_size);
+
+	// the repeated frame is detected by its hash, the changed color too
+	HOST_TEST_CHECK_EQUAL(__parsed.frames[0].hash, __parsed.frames[1].hash);
+	HOST_TEST_CHECK(__parsed.frames[0].hash != __parsed.frames[2].hash);
+	HOST_TEST_CHECK_EQUAL(FNV_OFFSET_BASIS, __parsed.frames[5].hash);
+
+	(void)printf("%u frames dumped in %u bytes, frame hashes:", __parsed.frame_count, size);
+	for (uint32_t f = 0; f < __parsed.frame_count; f++) {
+		(void)printf(" %08x", __parsed.frames[f].hash);
+	}
+	(void)printf("\n");
+}
+
+// the parsing of damaged dumps: uses the dump of __test_record_and_parse()
+static void __test_damaged(void) {
+	static uint32_t damaged[sizeof(__dump) / sizeof(uint32_t)];
+	uint32_t size = 0;
+	uint32_t frame_offsets[MAX_FRAMES];
+
+	// the offsets of the frames of the dump
+	uint32_t frame_count = 0;
+	while (frame_count < 6u) {
+		DISPLAY_LIST_frame_t frame;
+		frame_offsets[frame_count] = size;
+		(void)memcpy(&frame, &((const uint8_t*)__dump)[size], sizeof(frame));
+		size += sizeof(DISPLAY_LIST_frame_t) + frame.size;
+		frame_count++;
+	}
+
+	// incomplete last frame (the RTT buffer was read in the middle of a frame)
+	HOST_TEST_CHECK_EQUAL(frame_offsets[4], __parse((const uint8_t*)__dump, frame_offsets[5] - 4u));
+	HOST_TEST_CHECK_EQUAL(4, __parsed.frame_count);
+	HOST_TEST_CHECK_EQUAL(frame_offsets[5], __parse((const uint8_t*)__dump, frame_offsets[5] + sizeof(DISPLAY_LIST_frame_t) - 1u));
+	HOST_TEST_CHECK_EQUAL(5, __parsed.frame_count);
+
+	// wrong magic: the frames before it
+	(void)memcpy(damaged, __dump, size);
+	damaged[frame_offsets[3] / sizeof(uint32_t)] ^= 1u;
+	HOST_TEST_CHECK_EQUAL(frame_offsets[3], __parse((const uint8_t*)damaged, size));
+	HOST_TEST_CHECK_EQUAL(3, __parsed.frame_count);
+
+	// a record size that is not a multiple of 4 bytes or that overflows its frame:
+	// the frame is visited up to the bad record, the frames before it are complete
+	uint32_t record_offset = frame_offsets[2] + sizeof(DISPLAY_LIST_frame_t) + 36u;
+	(void)memcpy(damaged, __dump, size);
+	((uint8_t*)damaged)[record_offset + offsetof(DISPLAY_LIST_record_t, size)] += 2u;
+	HOST_TEST_CHECK_EQUAL(frame_offsets[2], __parse((const uint8_t*)damaged, size));
+	HOST_TEST_CHECK_EQUAL(3, __parsed.frame_count);
+	HOST_TEST_CHECK_EQUAL(7, __parsed.record_count);
+
+	(void)memcpy(damaged, __dump, size);
+	((uint8_t*)damaged)[record_offset + offsetof(DISPLAY_LIST_record_t, size)] = 0xf0;
+	HOST_TEST_CHECK_EQUAL(frame_offsets[2], __parse((const uint8_t*)damaged, size));
+
+	(void)memcpy(damaged, __dump, size);
+	((uint8_t*)damaged)[record_offset + offsetof(DISPLAY_LIST_record_t, size)] = 4u;
+	HOST_TEST_CHECK_EQUAL(frame_offsets[2], __parse((const uint8_t*)damaged, size));
+
+	// nothing to parse
+	HOST_TEST_CHECK_EQUAL(0, __parse((const uint8_t*)__dump, 0));
+	HOST_TEST_CHECK_EQUAL(0, __parsed.frame_count);
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(void) {
+	__test_record_and_parse();
+	__test_damaged();
+
+	(void)printf("display list: OK\n");
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,163 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host check of the visible area of the round display (display_mask.c)
+ * against the mask of the front panel (mask_392.png, converted by
+ * mask_fixture.py):
+ *
+ * - every visible pixel of the mask is in the span of its row (nothing visible is
+ * culled nor left out of the back buffer restore);
+ * - the spans do not include more than 1% of hidden pixels (the cost of the
+ * pixels touched by the circle but hidden by the mask);
+ * - DISPLAY_MASK_clip() culls the rectangles of the corners and narrows the
+ * others to the bounding box of their visible pixels.
+ *
+ * Usage: test_display_mask <mask PGM of mask_fixture.py>
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "display_configuration.h"
+#include "display_mask.h"
+#include "host_test.h"
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+static uint8_t __mask[FRAME_BUFFER_HEIGHT][FRAME_BUFFER_WIDTH];
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+static void __load(const char* path) {
+	unsigned int width;
+	unsigned int height;
+	unsigned int max;
+	FILE* file = fopen(path, "rb");
+	if (NULL == file) {
+		(void)fprintf(stderr, "%s: not found (run mask_fixture.py)\n", path);
+		exit(1);
+	}
+	HOST_TEST_CHECK(3 == fscanf(file, "P5 %u %u %u", &width, &height, &max));
+	HOST_TEST_CHECK_EQUAL(FRAME_BUFFER_WIDTH, width);
+	HOST_TEST_CHECK_EQUAL(FRAME_BUFFER_HEIGHT, height);
+	HOST_TEST_CHECK_EQUAL(255, max);
+	(void)fgetc(file);
+	HOST_TEST_CHECK(sizeof(__mask) == fread(__mask, 1, sizeof(__mask), file));
+	(void)fclose(file);
+}
+
+static void __test_spans(void) {
+	uint32_t visible = 0;
+	uint32_t hidden = 0;
+
+	for (int32_t y = 0; y < FRAME_BUFFER_HEIGHT; y++) {
+		DISPLAY_MASK_span_t span = DISPLAY_MASK_get_span(y);
+		for (int32_t x = 0; x < FRAME_BUFFER_WIDTH; x++) {
+			bool in_span = (x >= span.xmin) && (x <= span.xmax);
+			if (0u != __mask[y][x]) {
+				if (!in_span) {
+					(void)fprintf(stderr, "visible pixel (%d,%d) outside the span [%d,%d]\n", x, y, span.xmin, span.xmax);
+					exit(1);
+				}
+				visible++;
+			}
+			else if (in_span) {
+				hidden++;
+			}
+		}
+	}
+
+	(void)printf("visible pixels: %u, hidden pixels in the spans: %u (%.2f%%), pixels out of the spans: %u\n",
+			visible, hidden, (100.0 * hidden) / visible, (FRAME_BUFFER_WIDTH * FRAME_BUFFER_HEIGHT) - visible - hidden);
+	HOST_TEST_CHECK(hidden <= (visible / 100u));
+}
+
+static void __test_clip(void) {
+	int x1;
+	int y1;
+	int x2;
+	int y2;
+
+	// a corner: culled, not modified
+	x1 = 0;
+	y1 = 0;
+	x2 = 40;
+	y2 = 40;
+	HOST_TEST_CHECK(!DISPLAY_MASK_clip(&x1, &y1, &x2, &y2));
+	HOST_TEST_CHECK_EQUAL(40, x2);
+
+	// the whole buffer: the first and last rows and columns are visible
+	x1 = 0;
+	y1 = 0;
+	x2 = FRAME_BUFFER_WIDTH - 1;
+	y2 = FRAME_BUFFER_HEIGHT - 1;
+	HOST_TEST_CHECK(DISPLAY_MASK_clip(&x1, &y1, &x2, &y2));
+	HOST_TEST_CHECK_EQUAL(0, x1);
+	HOST_TEST_CHECK_EQUAL(0, y1);
+	HOST_TEST_CHECK_EQUAL(FRAME_BUFFER_WIDTH - 1, x2);
+	HOST_TEST_CHECK_EQUAL(FRAME_BUFFER_HEIGHT - 1, y2);
+
+	// a band at the top: narrowed to the widest visible row of the band (its bottom row)
+	x1 = 0;
+	y1 = 0;
+	x2 = FRAME_BUFFER_WIDTH - 1;
+	y2 = 20;
+	HOST_TEST_CHECK(DISPLAY_MASK_clip(&x1, &y1, &x2, &y2));
+	HOST_TEST_CHECK_EQUAL(DISPLAY_MASK_get_span(20).xmin, x1);
+	HOST_TEST_CHECK_EQUAL(DISPLAY_MASK_get_span(20).xmax, x2);
+	HOST_TEST_CHECK_EQUAL(0, y1);
+	HOST_TEST_CHECK_EQUAL(20, y2);
+
+	// a column on the left side: the top and bottom rows that do not reach it are removed
+	x1 = 0;
+	y1 = 0;
+	x2 = 10;
+	y2 = FRAME_BUFFER_HEIGHT - 1;
+	HOST_TEST_CHECK(DISPLAY_MASK_clip(&x1, &y1, &x2, &y2));
+	HOST_TEST_CHECK(DISPLAY_MASK_get_span(y1).xmin <= 10);
+	HOST_TEST_CHECK(DISPLAY_MASK_get_span(y1 - 1).xmin > 10);
+	HOST_TEST_CHECK(DISPLAY_MASK_get_span(y2).xmin <= 10);
+	HOST_TEST_CHECK(DISPLAY_MASK_get_span(y2 + 1).xmin > 10);
+	// the mask agrees: no visible pixel of the column above or below
+	for (int32_t x = 0; x <= 10; x++) {
+		HOST_TEST_CHECK(0u == __mask[y1 - 1][x]);
+		HOST_TEST_CHECK(0u == __mask[y2 + 1][x]);
+	}
+
+	DISPLAY_MASK_stats_t stats;
+	DISPLAY_MASK_get_stats(&stats);
+	HOST_TEST_CHECK_EQUAL(1, stats.culled);
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+	HOST_TEST_CHECK(2 == argc);
+	__load(argv[1]);
+
+	DISPLAY_MASK_initialize();
+	__test_spans();
+	__test_clip();
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,391 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host test and benchmark of the thick faded drawings of drawing_vglite.c on
+ * the software VGLite HAL: the pixels are compared with an ideal linear fade of the
+ * same shape (supersampled: the alpha decreases from 1 on the edge of the thick
+ * shape to 0 at the fade distance), the culling of the faded arcs is checked on each
+ * side of the clip and the drawing time is printed per fade.
+ *
+ * The software algorithms (DW_DRAWING_SOFT_*) are part of the Graphics Engine,
+ * which is not in the host build: the ideal fade is the reference, and the
+ * drawings that fall back on the software algorithms are only counted.
+ *
+ * White is drawn on black: the alpha of a pixel is its green channel.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <LLUI_DISPLAY.h>
+#include <dw_drawing.h>
+
+#include "display_vglite.h"
+#include "host_microui.h"
+#include "host_test.h"
+#include "vg_lite.h"
+#include "vg_lite_platform.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define WIDTH (128)
+#define HEIGHT (128)
+
+#define WHITE (0xffffff)
+
+// samples per pixel of the ideal fade (in each direction)
+#define SUPERSAMPLING (8)
+
+/*
+ * Tolerances of the one-pixel bands, in alpha levels. Where a band edge crosses a
+ * pixel, the GPU antialiasing blends the second band over the first one: the
+ * pixel is darker than the mean of both bands (by up to a quarter of their alpha
+ * product). The mean error is about 15 levels, the worst pixels are on the edges.
+ */
+#define BANDS_MAX_MEAN_ERROR (28.0)
+#define BANDS_MAX_ERROR (112u)
+
+// tolerances of the linear gradient (no band)
+#define GRADIENT_MAX_MEAN_ERROR (4.0)
+#define GRADIENT_MAX_ERROR (16u)
+
+#define BENCHMARK_LOOPS (200)
+
+#define PI (3.14159265358979f)
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief A thick shape: its distance to a point and the fade.
+ */
+typedef struct shape shape_t;
+struct shape {
+	float (*distance)(const shape_t* shape, float x, float y);
+	float x1, y1, x2, y2;   // center or line ends
+	float radius;           // arcs and circles
+	float start, arc;       // arcs, in radians
+	float half_thickness;
+	float fade;
+};
+
+/*
+ * @brief Difference between the drawn pixels and the ideal fade, in alpha levels.
+ */
+typedef struct {
+	double mean;
+	uint32_t max;
+	uint32_t pixels;
+} difference_t;
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+static uint16_t __pixels[WIDTH * HEIGHT];
+static MICROUI_GraphicsContext __gc;
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+static float __distance_to_point(float x, float y, float px, float py) {
+	return sqrtf(((x - px) * (x - px)) + ((y - py) * (y - py)));
+}
+
+// distance to the circle arc, the ends included (rounded caps)
+static float __distance_to_arc(const shape_t* shape, float x, float y) {
+	float dx = x - shape->x1;
+	float dy = shape->y1 - y; // y axis upwards: the angles are counterclockwise
+	float angle = atan2f(dy, dx) - shape->start;
+	while (angle < 0.0f) {
+		angle += 2.0f * PI;
+	}
+	float ret;
+	if (angle <= shape->arc) {
+		ret = fabsf(sqrtf((dx * dx) + (dy * dy)) - shape->radius);
+	}
+	else {
+		float end = shape->start + shape->arc;
+		float d1 = __distance_to_point(x, y, shape->x1 + (shape->radius * cosf(shape->start)), shape->y1 - (shape->radius * sinf(shape->start)));
+		float d2 = __distance_to_point(x, y, shape->x1 + (shape->radius * cosf(end)), shape->y1 - (shape->radius * sinf(end)));
+		ret = (d1 < d2) ? d1 : d2;
+	}
+	return ret;
+}
+
+// distance to the segment, the ends included (rounded caps)
+static float __distance_to_segment(const shape_t* shape, float x, float y) {
+	float lx = shape->x2 - shape->x1;
+	float ly = shape->y2 - shape->y1;
+	float t = (((x - shape->x1) * lx) + ((y - shape->y1) * ly)) / ((lx * lx) + (ly * ly));
+	t = (t < 0.0f) ? 0.0f : ((t > 1.0f) ? 1.0f : t);
+	return __distance_to_point(x, y, shape->x1 + (t * lx), shape->y1 + (t * ly));
+}
+
+static float __ideal_alpha(const shape_t* shape, uint32_t x, uint32_t y) {
+	float sum = 0.0f;
+	for (uint32_t sy = 0; sy < SUPERSAMPLING; sy++) {
+		for (uint32_t sx = 0; sx < SUPERSAMPLING; sx++) {
+			float px = (float)x + (((float)sx + 0.5f) / (float)SUPERSAMPLING);
+			float py = (float)y + (((float)sy + 0.5f) / (float)SUPERSAMPLING);
+			float outside = shape->distance(shape, px, py) - shape->half_thickness;
+			float alpha = 1.0f - (outside / shape->fade);
+			sum += (alpha > 1.0f) ? 1.0f : ((alpha < 0.0f) ? 0.0f : alpha);
+		}
+	}
+	return sum / (float)(SUPERSAMPLING * SUPERSAMPLING);
+}
+
+static uint32_t __alpha(uint32_t x, uint32_t y) {
+	uint32_t green = ((uint32_t)__pixels[(y * WIDTH) + x] >> 5) & 0x3fu;
+	return (green << 2) | (green >> 4);
+}
+
+static void __clear(void) {
+	(void)memset(__pixels, 0, sizeof(__pixels));
+	HOST_MICROUI_init(&__gc, __pixels, WIDTH, HEIGHT);
+	__gc.foreground_color = WHITE;
+}
+
+/*
+ * Compares the drawn pixels with the ideal fade, the pixels whose ordinate along
+ * the line is not in [min_t, max_t] excepted (the flat ends of a line).
+ */
+static difference_t __compare(const shape_t* shape, float min_t, float max_t) {
+	difference_t difference = { 0.0, 0, 0 };
+	double sum = 0.0;
+	for (uint32_t y = 0; y < HEIGHT; y++) {
+		for (uint32_t x = 0; x < WIDTH; x++) {
+			if (__distance_to_segment == shape->distance) {
+				float lx = shape->x2 - shape->x1;
+				float ly = shape->y2 - shape->y1;
+				float t = ((((float)x + 0.5f - shape->x1) * lx) + (((float)y + 0.5f - shape->y1) * ly)) / ((lx * lx) + (ly * ly));
+				if ((t < min_t) || (t > max_t)) {
+					continue;
+				}
+			}
+			uint32_t expected = (uint32_t)((__ideal_alpha(shape, x, y) * 255.0f) + 0.5f);
+			uint32_t actual = __alpha(x, y);
+			if ((0u != expected) || (0u != actual)) {
+				uint32_t error = (expected > actual) ? (expected - actual) : (actual - expected);
+				difference.max = (error > difference.max) ? error : difference.max;
+				sum += (double)error;
+				difference.pixels++;
+			}
+		}
+	}
+	difference.mean = (difference.pixels > 0u) ? (sum / (double)difference.pixels) : 0.0;
+	return difference;
+}
+
+static void __check_difference(const char* name, difference_t difference, double max_mean, uint32_t max) {
+	(void)printf("%-28s %5u pixels, mean error %5.2f, max error %3u (alpha levels)\n", name, difference.pixels, difference.mean, difference.max);
+	HOST_TEST_CHECK(difference.pixels > 0u);
+	HOST_TEST_CHECK(difference.mean <= max_mean);
+	HOST_TEST_CHECK(difference.max <= max);
+}
+
+/*
+ * Same geometry as __draw_faded_circle_arc(): the center of the diameter + 1
+ * circle, the thickness + 1 minus half a pixel on the inner edge (the inner radius
+ * of VGLITE_PATH_compute_thick_shape_ellipse_arc() is one half pixel longer).
+ */
+static shape_t __arc_shape(jint x, jint y, jint diameter, jfloat start, jfloat arc, jint thickness, jint fade) {
+	shape_t shape;
+	(void)memset(&shape, 0, sizeof(shape));
+	shape.distance = __distance_to_arc;
+	shape.x1 = (float)(x + ((diameter + 1) / 2));
+	shape.y1 = (float)(y + ((diameter + 1) / 2));
+	shape.radius = ((float)(diameter + 1) / 2.0f) + 0.25f;
+	shape.start = start * PI / 180.0f;
+	shape.arc = arc * PI / 180.0f;
+	shape.half_thickness = ((float)(thickness + 1) / 2.0f) - 0.25f;
+	shape.fade = (float)fade;
+	return shape;
+}
+
+static void __test_arc(const char* name, jint diameter, jfloat start, jfloat arc, jint thickness, jint fade, DRAWING_Cap caps) {
+	jint x = (WIDTH - diameter) / 2;
+	jint y = (HEIGHT - diameter) / 2;
+	shape_t shape = __arc_shape(x, y, diameter, start, arc, thickness, fade);
+
+	__clear();
+	HOST_TEST_CHECK_EQUAL(DRAWING_RUNNING, DW_DRAWING_drawThickFadedCircleArc(&__gc, x, y, diameter, start, arc, thickness, fade, caps, caps));
+	__check_difference(name, __compare(&shape, 0.0f, 0.0f), BANDS_MAX_MEAN_ERROR, BANDS_MAX_ERROR);
+}
+
+static void __test_line(const char* name, jint x1, jint y1, jint x2, jint y2, jint thickness, jint fade, DRAWING_Cap caps) {
+	shape_t shape;
+	(void)memset(&shape, 0, sizeof(shape));
+	shape.distance = __distance_to_segment;
+	shape.x1 = (float)x1;
+	shape.y1 = (float)y1;
+	shape.x2 = (float)x2;
+	shape.y2 = (float)y2;
+	shape.half_thickness = (float)thickness / 2.0f;
+	shape.fade = (float)fade;
+
+	__clear();
+	HOST_TEST_CHECK_EQUAL(DRAWING_RUNNING, DW_DRAWING_drawThickFadedLine(&__gc, x1, y1, x2, y2, thickness, fade, caps, caps));
+	if (DRAWING_ENDOFLINE_ROUNDED == caps) {
+		__check_difference(name, __compare(&shape, -1.0f, 2.0f), BANDS_MAX_MEAN_ERROR, BANDS_MAX_ERROR);
+	}
+	else {
+		// the ends are flat: only the fade across the line is compared
+		__check_difference(name, __compare(&shape, 0.1f, 0.9f), GRADIENT_MAX_MEAN_ERROR, GRADIENT_MAX_ERROR);
+	}
+}
+
+static void __test_circle(const char* name, jint diameter, jint thickness, jint fade) {
+	jint x = (WIDTH - diameter) / 2;
+	jint y = (HEIGHT - diameter) / 2;
+	shape_t shape = __arc_shape(x, y, diameter, 0.0f, 360.0f, thickness, fade);
+	// same geometry as __draw_faded_ellipse()
+	shape.x1 = (float)x + ((float)diameter / 2.0f);
+	shape.y1 = (float)y + ((float)diameter / 2.0f);
+	shape.radius = (float)diameter / 2.0f;
+	shape.half_thickness = (float)thickness / 2.0f;
+
+	__clear();
+	HOST_TEST_CHECK_EQUAL(DRAWING_RUNNING, DW_DRAWING_drawThickFadedCircle(&__gc, x, y, diameter, thickness, fade));
+	__check_difference(name, __compare(&shape, 0.0f, 0.0f), BANDS_MAX_MEAN_ERROR, BANDS_MAX_ERROR);
+}
+
+/*
+ * The drawn pixels fit the bounds checked by __draw_faded_circle_arc() (the same
+ * on each side of the center) and the arc is culled when the clip is just
+ * outside them, drawn when the clip touches them.
+ */
+static void __test_arc_culling(jint diameter, jint thickness, jint fade) {
+	jint x = 30;
+	jint y = 25;
+	jint center_x = x + ((diameter + 1) / 2);
+	jint center_y = y + ((diameter + 1) / 2);
+	jint extent = (((diameter + 1) + (thickness + 1) + 1) / 2) + fade;
+
+	__clear();
+	HOST_TEST_CHECK_EQUAL(DRAWING_RUNNING, DW_DRAWING_drawThickFadedCircleArc(&__gc, x, y, diameter, 0.0f, 360.0f, thickness, fade, DRAWING_ENDOFLINE_NONE, DRAWING_ENDOFLINE_NONE));
+	jint min_x = WIDTH;
+	jint min_y = HEIGHT;
+	jint max_x = -1;
+	jint max_y = -1;
+	for (jint py = 0; py < HEIGHT; py++) {
+		for (jint px = 0; px < WIDTH; px++) {
+			if (0u != __alpha((uint32_t)px, (uint32_t)py)) {
+				min_x = (px < min_x) ? px : min_x;
+				min_y = (py < min_y) ? py : min_y;
+				max_x = (px > max_x) ? px : max_x;
+				max_y = (py > max_y) ? py : max_y;
+			}
+		}
+	}
+	HOST_TEST_CHECK(min_x >= (center_x - extent));
+	HOST_TEST_CHECK(min_y >= (center_y - extent));
+	HOST_TEST_CHECK(max_x <= (center_x + extent));
+	HOST_TEST_CHECK(max_y <= (center_y + extent));
+	// symmetric: the drawing is as far from the bounds on each side
+	HOST_TEST_CHECK(abs((min_x - (center_x - extent)) - ((center_x + extent) - max_x)) <= 1);
+	HOST_TEST_CHECK(abs((min_y - (center_y - extent)) - ((center_y + extent) - max_y)) <= 1);
+
+	// clip just outside the bounds, then touching them: left, top, right, bottom
+	jint outside[4][4] = {
+			{ 0, 0, center_x - extent - 1, HEIGHT - 1 },
+			{ 0, 0, WIDTH - 1, center_y - extent - 1 },
+			{ center_x + extent + 1, 0, WIDTH - 1, HEIGHT - 1 },
+			{ 0, center_y + extent + 1, WIDTH - 1, HEIGHT - 1 },
+	};
+	jint touching[4][4] = {
+			{ 0, 0, center_x - extent, HEIGHT - 1 },
+			{ 0, 0, WIDTH - 1, center_y - extent },
+			{ center_x + extent, 0, WIDTH - 1, HEIGHT - 1 },
+			{ 0, center_y + extent, WIDTH - 1, HEIGHT - 1 },
+	};
+	for (uint32_t side = 0; side < 4u; side++) {
+		uint32_t drawings = HOST_MICROUI_gpu_drawings;
+		HOST_MICROUI_set_clip(&__gc, outside[side][0], outside[side][1], outside[side][2], outside[side][3]);
+		HOST_TEST_CHECK_EQUAL(DRAWING_DONE, DW_DRAWING_drawThickFadedCircleArc(&__gc, x, y, diameter, 0.0f, 360.0f, thickness, fade, DRAWING_ENDOFLINE_NONE, DRAWING_ENDOFLINE_NONE));
+		HOST_TEST_CHECK_EQUAL(drawings, HOST_MICROUI_gpu_drawings);
+
+		HOST_MICROUI_set_clip(&__gc, touching[side][0], touching[side][1], touching[side][2], touching[side][3]);
+		HOST_TEST_CHECK_EQUAL(DRAWING_RUNNING, DW_DRAWING_drawThickFadedCircleArc(&__gc, x, y, diameter, 0.0f, 360.0f, thickness, fade, DRAWING_ENDOFLINE_NONE, DRAWING_ENDOFLINE_NONE));
+		HOST_TEST_CHECK_EQUAL(drawings + 1u, HOST_MICROUI_gpu_drawings);
+	}
+}
+
+static void __test_software_fallback(void) {
+	__clear();
+	uint32_t soft_drawings = HOST_MICROUI_soft_drawings;
+	// the inner bands would cross the center
+	HOST_TEST_CHECK_EQUAL(DRAWING_DONE, DW_DRAWING_drawThickFadedCircleArc(&__gc, 40, 40, 20, 0.0f, 90.0f, 8, 6, DRAWING_ENDOFLINE_ROUNDED, DRAWING_ENDOFLINE_ROUNDED));
+	HOST_TEST_CHECK_EQUAL(soft_drawings + 1u, HOST_MICROUI_soft_drawings);
+	// rounded caps are drawn by the GPU
+	HOST_TEST_CHECK_EQUAL(DRAWING_RUNNING, DW_DRAWING_drawThickFadedLine(&__gc, 10, 10, 100, 60, 6, 4, DRAWING_ENDOFLINE_ROUNDED, DRAWING_ENDOFLINE_NONE));
+	HOST_TEST_CHECK_EQUAL(soft_drawings + 1u, HOST_MICROUI_soft_drawings);
+}
+
+static void __benchmark(void) {
+	(void)printf("\n%-34s %6s %12s %12s\n", "drawing (software GPU)", "fade", "paths", "us/drawing");
+	for (jint fade = 2; fade <= 8; fade *= 2) {
+		for (uint32_t kind = 0; kind < 2u; kind++) {
+			vg_lite_soft_profile_t profile;
+			__clear();
+			vg_lite_soft_reset_profile();
+			uint64_t start = HOST_TEST_now_ns();
+			for (uint32_t i = 0; i < BENCHMARK_LOOPS; i++) {
+				if (0u == kind) {
+					(void)DW_DRAWING_drawThickFadedCircleArc(&__gc, 24, 24, 80, 30.0f, 240.0f, 6, fade, DRAWING_ENDOFLINE_ROUNDED, DRAWING_ENDOFLINE_ROUNDED);
+				}
+				else {
+					(void)DW_DRAWING_drawThickFadedLine(&__gc, 20, 30, 100, 90, 6, fade, DRAWING_ENDOFLINE_ROUNDED, DRAWING_ENDOFLINE_ROUNDED);
+				}
+			}
+			uint64_t elapsed = HOST_TEST_now_ns() - start;
+			vg_lite_soft_get_profile(&profile);
+			uint32_t paths = profile.primitives[VG_LITE_SOFT_DRAW].calls + profile.primitives[VG_LITE_SOFT_PATTERN].calls;
+			(void)printf("%-34s %6d %12u %12.1f\n", (0u == kind) ? "arc 240 deg, rounded caps" : "line, rounded caps",
+					(int)fade, paths / BENCHMARK_LOOPS, (double)elapsed / (1000.0 * (double)BENCHMARK_LOOPS));
+		}
+	}
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(void) {
+	DISPLAY_VGLITE_init();
+
+	__test_arc("arc 360 deg, fade 4", 80, 0.0f, 360.0f, 6, 4, DRAWING_ENDOFLINE_NONE);
+	__test_arc("arc 360 deg, fade 8", 60, 0.0f, 360.0f, 4, 8, DRAWING_ENDOFLINE_NONE);
+	__test_arc("arc 170 deg rounded, fade 6", 80, 30.0f, 170.0f, 8, 6, DRAWING_ENDOFLINE_ROUNDED);
+	__test_arc("arc 300 deg rounded, fade 3", 90, 200.0f, 300.0f, 5, 3, DRAWING_ENDOFLINE_ROUNDED);
+	__test_line("line rounded, fade 5", 20, 30, 100, 90, 6, 5, DRAWING_ENDOFLINE_ROUNDED);
+	__test_line("line gradient, fade 5", 20, 30, 100, 90, 6, 5, DRAWING_ENDOFLINE_NONE);
+	__test_circle("circle, fade 4", 70, 6, 4);
+
+	__test_arc_culling(61, 6, 4);
+	__test_arc_culling(40, 3, 8);
+	__test_software_fallback();
+
+	__benchmark();
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,557 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host test and benchmark of the glyph runs of the FreeType VGLite renderer
+ * (ftvector.c, VG_FEATURE_FONT_GLYPH_RUN).
+ *
+ * The test includes ftvector.c and replaces VG_DRAWER_draw_path() to record the
+ * drawings before drawing them on the software VGLite HAL. The strings are laid
+ * out like LLVG_FONT_PAINTER_freetype_vglite.c does, with and without glyph run
+ * (the two branches of VG_FEATURE_FONT_GLYPH_RUN): no font file is part of the
+ * tree, the glyphs are synthesized outlines (conic rings, boxes, COLR layers) in
+ * font units, loaded like FT_LOAD_NO_SCALE does.
+ *
+ * For each string, the drawings with glyph run are compared with the ones
+ * expected from the glyphs drawn one by one: the glyphs are gathered in FP32 runs
+ * up to FT_VGLITE_RUN_MAX_SIZE, a color change (COLR layers) draws the pending run,
+ * the even-odd and oversized glyphs are drawn alone. The pixels of both drawings
+ * are compared. The numbers of drawings are printed.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <LLVG_MATRIX_impl.h>
+
+#include "vg_lite.h"
+#include "microvg_vglite_helper.h"
+#include "host_test.h"
+
+// the GPU operations are not traced (trace_platform.h depends on the board)
+#define __TRACE_PLATFORM_H__
+#define TRACE_PLATFORM_START_U32(subgroup, event_id, v1)
+#define TRACE_PLATFORM_END_VOID(subgroup, event_id)
+
+// the renderer under test
+#include "ftvector/ftvector.c"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define WIDTH (392)
+#define HEIGHT (160)
+
+// the synthesized font
+#define UNITS_PER_EM (2048)
+#define ASCENDER (1600)
+#define BEARING (100)
+
+#define MAX_POINTS (1280)
+#define MAX_CONTOURS (4)
+
+#define MAX_DRAWS (128)
+
+#define COLOR (0xff202020u)
+
+// COLR palette of the color glyph
+#define RED (0xffe02020u)
+#define BLUE (0xff2020e0u)
+
+// glyphs of the test strings that are not letters
+#define GLYPH_SPACE ' '
+#define GLYPH_COLON ':'
+#define GLYPH_COLOR '*'       // 3 COLR layers: red, red, blue
+#define GLYPH_OVERSIZED '#'   // larger than FT_VGLITE_RUN_MAX_SIZE once converted
+#define GLYPH_EVEN_ODD '%'    // FT_OUTLINE_EVEN_ODD_FILL
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+
+typedef struct {
+	vg_lite_format_t format;
+	uint32_t length;
+	vg_lite_fill_t fill_rule;
+	vg_lite_color_t color;
+} test_draw_t;
+
+typedef struct {
+	const char* name;
+	const char* text;
+	float x;
+	float y;
+	float size;
+	float radius;
+} test_string_t;
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+static vg_lite_buffer_t __target;
+static uint8_t* __reference;
+
+// the drawings of a string
+static test_draw_t __draws[MAX_DRAWS];
+static uint32_t __draw_count;
+
+// the glyph slot, loaded by __load_glyph()
+static FT_Vector __points[MAX_POINTS];
+static char __tags[MAX_POINTS];
+static short __contours[MAX_CONTOURS];
+static FT_GlyphSlotRec __slot;
+
+static FT_RendererRec __renderer;
+
+static const vg_lite_color_t __palette[] = { RED, BLUE };
+
+// -----------------------------------------------------------------------------
+// FreeType system and VG drawer
+// -----------------------------------------------------------------------------
+
+static void* __ft_alloc(FT_Memory memory, long size) {
+	(void)memory;
+	return malloc((size_t)size);
+}
+
+static void __ft_free(FT_Memory memory, void* block) {
+	(void)memory;
+	free(block);
+}
+
+static void* __ft_realloc(FT_Memory memory, long cur_size, long new_size, void* block) {
+	(void)memory;
+	(void)cur_size;
+	return realloc(block, (size_t)new_size);
+}
+
+static struct FT_MemoryRec_ __memory = { NULL, __ft_alloc, __ft_free, __ft_realloc };
+
+// the fonts are not loaded from files (ftsystem.c uses the FreeType heap of the target)
+FT_BASE_DEF(FT_Error) FT_Stream_Open(FT_Stream stream, const char* filepathname) {
+	(void)stream;
+	(void)filepathname;
+	return FT_Err_Cannot_Open_Resource;
+}
+
+void VG_DRAWER_update_color(void* target, vg_lite_color_t* color, vg_lite_blend_t blend) {
+	(void)target;
+	(void)color;
+	(void)blend;
+}
+
+void VG_DRAWER_update_gradient(void* target, vg_lite_linear_gradient_t* gradient, vg_lite_blend_t blend) {
+	(void)target;
+	(void)gradient;
+	(void)blend;
+}
+
+vg_lite_error_t VG_DRAWER_draw_path(void* target, vg_lite_path_t* path, vg_lite_fill_t fill_rule, vg_lite_matrix_t* matrix,
+		vg_lite_blend_t blend, vg_lite_color_t color) {
+	HOST_TEST_CHECK(__draw_count < MAX_DRAWS);
+	test_draw_t* draw = &__draws[__draw_count];
+	draw->format = path->format;
+	draw->length = path->path_length;
+	draw->fill_rule = fill_rule;
+	draw->color = color;
+	__draw_count++;
+	return vg_lite_draw((vg_lite_buffer_t*)target, path, fill_rule, matrix, blend, color);
+}
+
+vg_lite_error_t VG_DRAWER_draw_gradient(void* target, vg_lite_path_t* path, vg_lite_fill_t fill_rule, vg_lite_matrix_t* matrix,
+		vg_lite_linear_gradient_t* gradient, vg_lite_blend_t blend) {
+	(void)target;
+	(void)path;
+	(void)fill_rule;
+	(void)matrix;
+	(void)gradient;
+	(void)blend;
+	HOST_TEST_CHECK(false);
+	return VG_LITE_NOT_SUPPORT;
+}
+
+// -----------------------------------------------------------------------------
+// Internal function definitions: synthesized font
+// -----------------------------------------------------------------------------
+
+static void __end_contour(FT_Outline* outline) {
+	HOST_TEST_CHECK(outline->n_contours < MAX_CONTOURS);
+	outline->contours[outline->n_contours] = (short)(outline->n_points - 1);
+	outline->n_contours++;
+}
+
+static void __add_point(FT_Outline* outline, float x, float y, char tag) {
+	HOST_TEST_CHECK(outline->n_points < MAX_POINTS);
+	outline->points[outline->n_points].x = (FT_Pos)lroundf(x);
+	outline->points[outline->n_points].y = (FT_Pos)lroundf(y);
+	outline->tags[outline->n_points] = tag;
+	outline->n_points++;
+}
+
+// an ellipse of conic arcs, clockwise or not
+static void __add_ring(FT_Outline* outline, float cx, float cy, float rx, float ry, uint32_t segments, bool clockwise) {
+	float step = (clockwise ? -6.2831853f : 6.2831853f) / (float)segments;
+	float control = 1.0f / cosf(3.1415927f / (float)segments);
+	for (uint32_t i = 0; i < segments; i++) {
+		float angle = step * (float)i;
+		__add_point(outline, cx + (rx * cosf(angle)), cy + (ry * sinf(angle)), FT_CURVE_TAG_ON);
+		angle += step / 2.0f;
+		__add_point(outline, cx + (rx * control * cosf(angle)), cy + (ry * control * sinf(angle)), FT_CURVE_TAG_CONIC);
+	}
+	__end_contour(outline);
+}
+
+static void __add_box(FT_Outline* outline, float x1, float y1, float x2, float y2) {
+	__add_point(outline, x1, y1, FT_CURVE_TAG_ON);
+	__add_point(outline, x1, y2, FT_CURVE_TAG_ON);
+	__add_point(outline, x2, y2, FT_CURVE_TAG_ON);
+	__add_point(outline, x2, y1, FT_CURVE_TAG_ON);
+	__end_contour(outline);
+}
+
+// loads the outline of a glyph (or of a COLR layer) in the slot, in font units
+static void __load_glyph(char glyph, int layer) {
+	FT_Outline* outline = &__slot.outline;
+	FT_Pos width;
+	FT_Pos height = 1000;
+	int code = (int)(unsigned char)glyph;
+
+	outline->n_points = 0;
+	outline->n_contours = 0;
+	outline->flags = 0;
+
+	if (GLYPH_SPACE == glyph) {
+		width = 300;
+	}
+	else if (GLYPH_COLON == glyph) {
+		width = 200;
+		__add_box(outline, BEARING, 0, BEARING + width, 200);
+		__add_box(outline, BEARING, 700, BEARING + width, 900);
+	}
+	else if (GLYPH_COLOR == glyph) {
+		// a red disc, a red ring and a blue mouth
+		width = 1200;
+		if (0 == layer) {
+			__add_ring(outline, BEARING + 600, 600, 600, 600, 12, true);
+		}
+		else if (1 == layer) {
+			__add_ring(outline, BEARING + 600, 600, 500, 500, 12, true);
+			__add_ring(outline, BEARING + 600, 600, 400, 400, 12, false);
+		}
+		else {
+			__add_box(outline, BEARING + 300, 250, BEARING + 900, 350);
+		}
+	}
+	else if (GLYPH_OVERSIZED == glyph) {
+		width = 1000;
+		__add_ring(outline, BEARING + 500, 700, 500, 700, 320, true);
+		__add_ring(outline, BEARING + 500, 700, 350, 550, 320, false);
+	}
+	else if (GLYPH_EVEN_ODD == glyph) {
+		// both rings in the same direction: the hole comes from the fill rule
+		width = 900;
+		outline->flags = FT_OUTLINE_EVEN_ODD_FILL;
+		__add_ring(outline, BEARING + 450, 700, 450, 700, 8, true);
+		__add_ring(outline, BEARING + 450, 700, 250, 450, 8, true);
+	}
+	else {
+		// a letter or a digit: a ring of a shape that depends on the character
+		width = 700 + ((code % 4) * 100);
+		if (((glyph >= 'A') && (glyph <= 'Z')) || ((glyph >= '0') && (glyph <= '9'))) {
+			height = 1400;
+		}
+		__add_ring(outline, BEARING + (width / 2), height / 2, width / 2, height / 2, 4u + (uint32_t)(code % 9), true);
+		__add_ring(outline, BEARING + (width / 2), height / 2, (width / 2) - 150, (height / 2) - 150, 4u + (uint32_t)(code % 5), false);
+	}
+
+	__slot.format = FT_GLYPH_FORMAT_OUTLINE;
+	__slot.metrics.width = (0 == outline->n_points) ? 0 : width;
+	__slot.metrics.height = height;
+	__slot.metrics.horiBearingX = BEARING;
+	__slot.metrics.horiBearingY = height;
+	__slot.metrics.horiAdvance = width + (2 * BEARING);
+}
+
+// -----------------------------------------------------------------------------
+// Internal function definitions: painter
+// -----------------------------------------------------------------------------
+
+static void __set_mode(FT_ULong tag, void* data) {
+	HOST_TEST_CHECK_EQUAL(FT_Err_Ok, ft_vglite_set_mode(&__renderer, tag, data));
+}
+
+static void __render_slot(void) {
+	HOST_TEST_CHECK_EQUAL(FT_Err_Ok, ft_vglite_render(&__renderer, &__slot, FT_RENDER_MODE_NORMAL, NULL));
+}
+
+// same as __render_glyph() of the painter: the COLR layers change the color
+static void __render_glyph(char glyph, vg_lite_color_t color) {
+	if (GLYPH_COLOR == glyph) {
+		for (int layer = 0; layer < 3; layer++) {
+			__set_mode(FT_PARAM_TAG_VGLITE_COLOR, (void*)(uintptr_t)__palette[(2 == layer) ? 1 : 0]);
+			__load_glyph(glyph, layer);
+			__render_slot();
+		}
+		__set_mode(FT_PARAM_TAG_VGLITE_COLOR, (void*)(uintptr_t)color);
+	}
+	else {
+		__render_slot();
+	}
+}
+
+// same layout as __draw_string() of the painter, with or without glyph run
+static uint32_t __draw_string(const test_string_t* string, bool run) {
+	float scale = string->size / (float)UNITS_PER_EM;
+	float radius_scaled = string->radius / scale;
+	int advance_x = 0;
+	vg_lite_matrix_t local_matrix;
+	vg_lite_matrix_t glyph_matrix;
+	jfloat* local = MAP_VGLITE_MATRIX(&local_matrix);
+	jfloat* glyph = MAP_VGLITE_MATRIX(&glyph_matrix);
+
+	__draw_count = 0;
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_clear(&__target, NULL, 0xffffffffu));
+
+	LLVG_MATRIX_IMPL_setTranslate(local, string->x, string->y);
+	LLVG_MATRIX_IMPL_scale(local, scale, scale);
+
+	// __set_renderer()
+	__set_mode(FT_PARAM_TAG_VGLITE_DESTINATION, &__target);
+	__set_mode(FT_PARAM_TAG_VGLITE_MATRIX, &glyph_matrix);
+	__set_mode(FT_PARAM_TAG_VGLITE_QUALITY, (void*)VG_LITE_HIGH);
+	__set_mode(FT_PARAM_TAG_VGLITE_FORMAT, (void*)VG_LITE_S16);
+	__set_mode(FT_PARAM_TAG_VGLITE_BLEND, (void*)VG_LITE_BLEND_SRC_OVER);
+	__set_mode(FT_PARAM_TAG_VGLITE_COLOR, (void*)(uintptr_t)COLOR);
+	__set_mode(FT_PARAM_TAG_VGLITE_GRADIENT, (void*)MICROVG_HELPER_NULL_GRADIENT);
+	if (run) {
+		__set_mode(FT_PARAM_TAG_VGLITE_RUN, &local_matrix);
+	}
+
+	for (const char* c = string->text; '\0' != *c; c++) {
+		__load_glyph(*c, 0);
+		int char_width = (int)__slot.metrics.horiAdvance;
+
+		if (c == string->text) {
+			// first glyph: remove the first blank line
+			advance_x -= (0 == __slot.metrics.width) ? char_width : (int)__slot.metrics.horiBearingX;
+		}
+
+		if (run) {
+			LLVG_MATRIX_IMPL_identity(glyph);
+		}
+		else {
+			LLVG_MATRIX_IMPL_copy(glyph, local);
+		}
+
+		if (0.f == string->radius) {
+			LLVG_MATRIX_IMPL_translate(glyph, (float)advance_x, (float)ASCENDER);
+		}
+		else {
+			float angle = 90.0f + ((((float)advance_x / radius_scaled) + (((float)char_width / 2.0f) / radius_scaled)) * 180.0f / 3.1415927f);
+			LLVG_MATRIX_IMPL_rotate(glyph, angle);
+			LLVG_MATRIX_IMPL_translate(glyph, (float)(-char_width / 2), -radius_scaled);
+		}
+
+		__render_glyph(*c, COLOR);
+		advance_x += char_width;
+	}
+
+	if (run) {
+		__set_mode(FT_PARAM_TAG_VGLITE_RUN, NULL);
+	}
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_finish());
+	return __draw_count;
+}
+
+// -----------------------------------------------------------------------------
+// Internal function definitions: checks
+// -----------------------------------------------------------------------------
+
+static void __expect_run(test_draw_t* expected, uint32_t* count, uint32_t* run_length, vg_lite_color_t color) {
+	if (0u != *run_length) {
+		HOST_TEST_CHECK(*count < MAX_DRAWS);
+		expected[*count].format = VG_LITE_FP32;
+		// the run ends with an end command
+		expected[*count].length = *run_length + sizeof(uint32_t);
+		expected[*count].fill_rule = VG_LITE_FILL_NON_ZERO;
+		expected[*count].color = color;
+		(*count)++;
+		*run_length = 0;
+	}
+}
+
+/*
+ * the drawings expected with glyph run, from the ones of the glyphs drawn one by
+ * one: each S16 glyph path takes twice its size in the run without its end command
+ */
+static uint32_t __expect(const test_draw_t* glyphs, uint32_t glyph_count, test_draw_t* expected) {
+	uint32_t count = 0;
+	uint32_t run_length = 0;
+	vg_lite_color_t color = COLOR;
+
+	for (uint32_t i = 0; i < glyph_count; i++) {
+		const test_draw_t* glyph = &glyphs[i];
+		uint32_t length = (glyph->length - (uint32_t)sizeof(path_end_16_t)) * 2u;
+
+		HOST_TEST_CHECK_EQUAL(VG_LITE_S16, glyph->format);
+		if (glyph->color != color) {
+			__expect_run(expected, &count, &run_length, color);
+			color = glyph->color;
+		}
+		if ((VG_LITE_FILL_NON_ZERO != glyph->fill_rule) || ((length + sizeof(uint32_t)) > FT_VGLITE_RUN_MAX_SIZE)) {
+			// drawn alone
+			__expect_run(expected, &count, &run_length, color);
+			HOST_TEST_CHECK(count < MAX_DRAWS);
+			expected[count] = *glyph;
+			count++;
+		}
+		else {
+			if ((run_length + length + sizeof(uint32_t)) > FT_VGLITE_RUN_MAX_SIZE) {
+				__expect_run(expected, &count, &run_length, color);
+			}
+			run_length += length;
+		}
+	}
+	__expect_run(expected, &count, &run_length, color);
+	return count;
+}
+
+static uint32_t __count_glyph_draws(const char* text) {
+	uint32_t count = 0;
+	for (const char* c = text; '\0' != *c; c++) {
+		count += (GLYPH_COLOR == *c) ? 3u : 1u;
+	}
+	return count;
+}
+
+// draws the string with and without glyph run: returns the drawings with run
+static uint32_t __test_string(const test_string_t* string, uint32_t* glyph_draws, uint32_t* drawn_pixels,
+		uint32_t* different_pixels, int* max_difference) {
+	static test_draw_t glyphs[MAX_DRAWS];
+	static test_draw_t expected[MAX_DRAWS];
+	uint32_t size = __target.stride * __target.height;
+
+	*glyph_draws = __draw_string(string, false);
+	HOST_TEST_CHECK_EQUAL(__count_glyph_draws(string->text), *glyph_draws);
+	(void)memcpy(glyphs, __draws, *glyph_draws * sizeof(test_draw_t));
+	(void)memcpy(__reference, __target.memory, size);
+
+	uint32_t run_draws = __draw_string(string, true);
+	uint32_t expected_draws = __expect(glyphs, *glyph_draws, expected);
+	HOST_TEST_CHECK_EQUAL(expected_draws, run_draws);
+	for (uint32_t i = 0; (i < run_draws) && (i < expected_draws); i++) {
+		HOST_TEST_CHECK_EQUAL(expected[i].format, __draws[i].format);
+		HOST_TEST_CHECK_EQUAL(expected[i].length, __draws[i].length);
+		HOST_TEST_CHECK_EQUAL(expected[i].fill_rule, __draws[i].fill_rule);
+		HOST_TEST_CHECK_EQUAL(expected[i].color, __draws[i].color);
+		HOST_TEST_CHECK(__draws[i].length <= FT_VGLITE_RUN_MAX_SIZE);
+	}
+
+	// the glyphs are drawn at the same place
+	*drawn_pixels = 0;
+	*different_pixels = 0;
+	*max_difference = 0;
+	const uint8_t* pixels = (const uint8_t*)__target.memory;
+	for (uint32_t i = 0; i < size; i += 4u) {
+		int difference = 0;
+		for (uint32_t channel = 0; channel < 4u; channel++) {
+			int channel_difference = abs((int)pixels[i + channel] - (int)__reference[i + channel]);
+			difference = (channel_difference > difference) ? channel_difference : difference;
+		}
+		*drawn_pixels += (0xffffffffu != *(const uint32_t*)&__reference[i]) ? 1u : 0u;
+		*different_pixels += (0 != difference) ? 1u : 0u;
+		*max_difference = (difference > *max_difference) ? difference : *max_difference;
+	}
+	return run_draws;
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(void) {
+	static const test_string_t strings[] = {
+			{ "time", "12:45", 20, 20, 64, 0 },
+			{ "label", "Heart rate 72 bpm", 10, 40, 32, 0 },
+			{ "pangram", "The quick brown fox jumps over the lazy dog 0123456789", 4, 60, 12, 0 },
+			{ "circle", "Heart rate 72 bpm", 196, 196, 24, 150 },
+			{ "COLR", "ab*cd**ef", 10, 40, 40, 0 },
+			{ "alone", "ab#cd%ef", 10, 40, 40, 0 },
+	};
+	uint32_t draws[sizeof(strings) / sizeof(strings[0])];
+
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_init(256, 256));
+	(void)memset(&__target, 0, sizeof(__target));
+	__target.width = WIDTH;
+	__target.height = HEIGHT;
+	__target.format = VG_LITE_RGBA8888;
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_allocate(&__target));
+	__reference = malloc(__target.stride * __target.height);
+	HOST_TEST_CHECK(NULL != __reference);
+
+	FT_Raster raster;
+	HOST_TEST_CHECK_EQUAL(FT_Err_Ok, vglite_new(&__memory, &raster));
+	__renderer.clazz = (FT_Renderer_Class*)&ft_vglite_renderer_class;
+	__renderer.glyph_format = FT_GLYPH_FORMAT_OUTLINE;
+	__renderer.raster = raster;
+	__renderer.raster_render = (FT_Raster_RenderFunc)vglite_render;
+	__slot.outline.points = __points;
+	__slot.outline.tags = __tags;
+	__slot.outline.contours = __contours;
+
+	(void)printf("glyph runs: string, glyphs, drawings (glyph by glyph, run), drawn pixels, different pixels (largest difference)\n");
+	for (uint32_t i = 0; i < (sizeof(strings) / sizeof(strings[0])); i++) {
+		uint32_t glyph_draws;
+		uint32_t drawn_pixels;
+		uint32_t different_pixels;
+		int max_difference;
+		draws[i] = __test_string(&strings[i], &glyph_draws, &drawn_pixels, &different_pixels, &max_difference);
+		(void)printf("  %-8s %3u %3u %3u %6u %4u (%d)\n", strings[i].name, (uint32_t)strlen(strings[i].text), glyph_draws,
+				draws[i], drawn_pixels, different_pixels, max_difference);
+		HOST_TEST_CHECK(drawn_pixels > 0u);
+		// FP32 coordinates in the run, S16 glyph by glyph: a few edge pixels may differ
+		HOST_TEST_CHECK(different_pixels <= 2u);
+		HOST_TEST_CHECK(max_difference <= 16);
+	}
+
+	// a string in a single drawing, on a circle too (the rotation is in the coordinates)
+	HOST_TEST_CHECK_EQUAL(1, draws[0]);
+	HOST_TEST_CHECK_EQUAL(1, draws[1]);
+	HOST_TEST_CHECK_EQUAL(1, draws[3]);
+	// split at FT_VGLITE_RUN_MAX_SIZE
+	HOST_TEST_CHECK(draws[2] > 1u);
+	// the layers of the same color share a drawing: 2 drawings per color glyph
+	// (red layers, blue layer) and the text between them
+	HOST_TEST_CHECK_EQUAL(9, draws[4]);
+	// the oversized glyph and the even-odd glyph are drawn alone: [ab] # [cd] % [ef]
+	HOST_TEST_CHECK_EQUAL(5, draws[5]);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_S16, __draws[1].format);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_S16, __draws[3].format);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_FILL_EVEN_ODD, __draws[3].fill_rule);
+
+	vglite_done(raster);
+	free(__reference);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_free(&__target));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_close());
+	(void)printf("glyph run: OK\n");
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
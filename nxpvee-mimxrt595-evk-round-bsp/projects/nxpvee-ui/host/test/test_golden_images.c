@@ -0,0 +1,355 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host golden images of the software VGLite HAL: each scene is drawn with
+ * the vg_lite API in a MicroUI ARGB8888 buffer (VG_LITE_RGBA8888, as the MicroUI
+ * images; the colors are 0xAARRGGBB) and compared byte per byte with its golden
+ * image (PAM, RGB_ALPHA) of the golden folder. The images are drawn as the MicroUI
+ * drawings do: the sources are configured by DISPLAY_VGLITE_configure_source().
+ *
+ * A scene that differs is written as <name>.actual.pam in the current folder.
+ * After a wanted change of the rendering, the golden images are written again
+ * with the option --update (and reviewed before being committed).
+ *
+ * Usage: test_golden_images <golden folder> [--update]
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <LLUI_DISPLAY.h>
+
+#include "display_vglite.h"
+#include "vg_lite.h"
+#include "host_microui.h"
+#include "host_test.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define WIDTH (64u)
+#define HEIGHT (64u)
+
+#define PAM_HEADER "P7\nWIDTH 64\nHEIGHT 64\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n"
+#define PAM_SIZE ((sizeof(PAM_HEADER) - 1u) + (WIDTH * HEIGHT * 4u))
+
+// the opacities of the images (premultiplied white)
+#define OPAQUE (0xffffffffu)
+#define HALF_OPAQUE (0x80808080u)
+
+// source images
+#define IMAGE_SIZE (16u)
+#define INDEXED_WIDTH (16u)
+#define INDEXED_HEIGHT (8u)
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+static const char* __folder;
+static bool __update;
+static uint32_t __failures;
+
+// the drawing target: 0xAARRGGBB words
+static uint32_t __pixels[WIDTH * HEIGHT];
+static vg_lite_buffer_t __target;
+
+// a five-pointed star (S16): crosses itself
+static const int16_t __star[] = {
+	VLC_OP_MOVE, 12, 0,
+	VLC_OP_LINE, 19, 22,
+	VLC_OP_LINE, 0, 8,
+	VLC_OP_LINE, 24, 8,
+	VLC_OP_LINE, 5, 22,
+	VLC_OP_END,
+};
+
+// a rectangle with a rounded side (S16)
+static const int16_t __rounded[] = {
+	VLC_OP_MOVE, 0, 0,
+	VLC_OP_LINE, 32, 0,
+	VLC_OP_CUBIC, 50, 0, 50, 28, 32, 28,
+	VLC_OP_LINE, 0, 28,
+	VLC_OP_CLOSE,
+	VLC_OP_END,
+};
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+static void __begin(void) {
+	(void)memset(&__target, 0, sizeof(__target));
+	__target.width = (int32_t)WIDTH;
+	__target.height = (int32_t)HEIGHT;
+	__target.stride = (int32_t)(WIDTH * sizeof(uint32_t));
+	__target.format = VG_LITE_RGBA8888;
+	__target.tiled = VG_LITE_LINEAR;
+	__target.memory = __pixels;
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_map(&__target));
+
+	// opaque light gray
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_clear(&__target, NULL, 0xffe0e0e0u));
+}
+
+static void __write(const char* path, const uint8_t* image) {
+	FILE* file = fopen(path, "wb");
+	HOST_TEST_CHECK(NULL != file);
+	HOST_TEST_CHECK(PAM_SIZE == fwrite(image, 1, PAM_SIZE, file));
+	(void)fclose(file);
+}
+
+static bool __read(const char* path, uint8_t* image) {
+	FILE* file = fopen(path, "rb");
+	bool ret = false;
+	if (NULL != file) {
+		ret = (PAM_SIZE == fread(image, 1, PAM_SIZE, file)) && (EOF == fgetc(file));
+		(void)fclose(file);
+	}
+	return ret;
+}
+
+// ends the scene: compares the pixels with the golden image
+static void __end(const char* name) {
+	static uint8_t actual[PAM_SIZE];
+	static uint8_t golden[PAM_SIZE];
+	char path[512];
+
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_finish());
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_unmap(&__target));
+
+	(void)memcpy(actual, PAM_HEADER, sizeof(PAM_HEADER) - 1u);
+	uint8_t* rgba = actual + (sizeof(PAM_HEADER) - 1u);
+	for (uint32_t i = 0; i < (WIDTH * HEIGHT); i++) {
+		uint32_t pixel = __pixels[i];
+		rgba[(i * 4u) + 0u] = (uint8_t)(pixel >> 16);
+		rgba[(i * 4u) + 1u] = (uint8_t)(pixel >> 8);
+		rgba[(i * 4u) + 2u] = (uint8_t)pixel;
+		rgba[(i * 4u) + 3u] = (uint8_t)(pixel >> 24);
+	}
+
+	(void)snprintf(path, sizeof(path), "%s/%s.pam", __folder, name);
+	if (__update) {
+		__write(path, actual);
+		(void)printf("%s: written\n", path);
+	}
+	else if (!__read(path, golden)) {
+		(void)fprintf(stderr, "%s: missing or invalid golden image (run with --update)\n", path);
+		__failures++;
+	}
+	else if (0 != memcmp(actual, golden, PAM_SIZE)) {
+		uint32_t count = 0;
+		uint32_t first = 0;
+		for (uint32_t i = WIDTH * HEIGHT; i > 0u; i--) {
+			uint32_t offset = (sizeof(PAM_HEADER) - 1u) + ((i - 1u) * 4u);
+			if (0 != memcmp(actual + offset, golden + offset, 4)) {
+				count++;
+				first = i - 1u;
+			}
+		}
+		(void)snprintf(path, sizeof(path), "%s.actual.pam", name);
+		__write(path, actual);
+		(void)fprintf(stderr, "%s: %u pixels differ, the first one at (%u,%u); see %s\n", name, count, first % WIDTH, first / WIDTH, path);
+		__failures++;
+	}
+	else {
+		(void)printf("%s: identical\n", name);
+	}
+}
+
+static void __init_path(vg_lite_path_t* path, const int16_t* data, uint32_t size, vg_lite_float_t max_x, vg_lite_float_t max_y) {
+	(void)memset(path, 0, sizeof(vg_lite_path_t));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_init_path(path, VG_LITE_S16, VG_LITE_HIGH, size, (void*)data, 0.0f, 0.0f, max_x, max_y));
+}
+
+static void __scene_clear(void) {
+	__begin();
+	vg_lite_rectangle_t red = { 4, 4, 40, 24 };
+	vg_lite_rectangle_t blue = { 20, 30, 40, 20 };
+	vg_lite_rectangle_t outside = { 50, 52, 30, 30 };
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_clear(&__target, &red, 0xffff0000u));
+	// no blending: the pixels are replaced, alpha included
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_clear(&__target, &blue, 0x80000080u));
+	// clipped by the target
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_clear(&__target, &outside, 0xff00ff00u));
+	__end("clear");
+}
+
+static void __scene_blit(void) {
+	static uint32_t pixels[IMAGE_SIZE * IMAGE_SIZE];
+	MICROUI_Image image = { .width = IMAGE_SIZE, .height = IMAGE_SIZE, .format = (jbyte)MICROUI_IMAGE_FORMAT_ARGB8888 };
+	vg_lite_buffer_t source;
+	vg_lite_matrix_t matrix;
+	uint32_t rectangle[4] = { 4, 4, 8, 8 };
+
+	// red and green ramps, a translucent diagonal
+	for (uint32_t y = 0; y < IMAGE_SIZE; y++) {
+		for (uint32_t x = 0; x < IMAGE_SIZE; x++) {
+			uint32_t alpha = (x == y) ? 0x80u : 0xffu;
+			pixels[(y * IMAGE_SIZE) + x] = (alpha << 24) | ((x * 17u) << 16) | ((y * 17u) << 8) | 0x40u;
+		}
+	}
+	HOST_MICROUI_set_image_data(&image, pixels);
+
+	__begin();
+	HOST_TEST_CHECK(DISPLAY_VGLITE_configure_source(&source, &image));
+
+	// multiply image mode: the image is mixed with the opacity (premultiplied), as the MicroUI drawings do
+	vg_lite_identity(&matrix);
+	vg_lite_translate(2.0f, 2.0f, &matrix);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_blit(&__target, &source, &matrix, VG_LITE_BLEND_SRC_OVER, OPAQUE, VG_LITE_FILTER_POINT));
+
+	vg_lite_identity(&matrix);
+	vg_lite_translate(40.0f, 6.0f, &matrix);
+	vg_lite_rotate(30.0f, &matrix);
+	vg_lite_scale(1.5f, 1.5f, &matrix);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_blit(&__target, &source, &matrix, VG_LITE_BLEND_SRC_OVER, OPAQUE, VG_LITE_FILTER_BI_LINEAR));
+
+	vg_lite_identity(&matrix);
+	vg_lite_translate(8.0f, 40.0f, &matrix);
+	vg_lite_scale(2.0f, 2.0f, &matrix);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_blit_rect(&__target, &source, rectangle, &matrix, VG_LITE_BLEND_SRC_OVER, HALF_OPAQUE, VG_LITE_FILTER_POINT));
+	__end("blit");
+
+	HOST_MICROUI_set_image_data(&image, NULL);
+}
+
+static void __scene_fill(void) {
+	vg_lite_path_t path;
+	vg_lite_matrix_t matrix;
+
+	__begin();
+	__init_path(&path, __star, sizeof(__star), 24.0f, 22.0f);
+
+	// the center of the star is filled with the non-zero rule only
+	vg_lite_identity(&matrix);
+	vg_lite_translate(4.0f, 4.0f, &matrix);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_draw(&__target, &path, VG_LITE_FILL_NON_ZERO, &matrix, VG_LITE_BLEND_SRC_OVER, 0xff2020c0u));
+	vg_lite_identity(&matrix);
+	vg_lite_translate(34.0f, 4.0f, &matrix);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_draw(&__target, &path, VG_LITE_FILL_EVEN_ODD, &matrix, VG_LITE_BLEND_SRC_OVER, 0xff2020c0u));
+
+	// rotated, scaled and translucent (premultiplied color)
+	vg_lite_identity(&matrix);
+	vg_lite_translate(30.0f, 30.0f, &matrix);
+	vg_lite_rotate(20.0f, &matrix);
+	vg_lite_scale(1.25f, 1.25f, &matrix);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_draw(&__target, &path, VG_LITE_FILL_EVEN_ODD, &matrix, VG_LITE_BLEND_SRC_OVER, 0x80008000u));
+	__end("fill");
+}
+
+static void __scene_gradient(void) {
+	static vg_lite_linear_gradient_t gradient;
+	uint32_t colors[] = { 0xffff0000u, 0xffffff00u, 0x800000ffu };
+	uint32_t stops[] = { 0, 128, 255 };
+	vg_lite_path_t path;
+	vg_lite_matrix_t matrix;
+
+	(void)memset(&gradient, 0, sizeof(gradient));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_init_grad(&gradient));
+	// as the MicroUI drawings: the colors are ARGB
+	gradient.image.format = VG_LITE_RGBA8888;
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_set_grad(&gradient, 3, colors, stops));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_update_grad(&gradient));
+
+	__begin();
+	__init_path(&path, __rounded, sizeof(__rounded), 46.0f, 28.0f);
+
+	// horizontal gradient from x = 8 to x = 54
+	vg_lite_matrix_t* gradient_matrix = vg_lite_get_grad_matrix(&gradient);
+	vg_lite_identity(gradient_matrix);
+	vg_lite_translate(8.0f, 0.0f, gradient_matrix);
+	vg_lite_scale(46.0f / 256.0f, 1.0f, gradient_matrix);
+	vg_lite_identity(&matrix);
+	vg_lite_translate(8.0f, 4.0f, &matrix);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_draw_gradient(&__target, &path, VG_LITE_FILL_EVEN_ODD, &matrix, &gradient, VG_LITE_BLEND_SRC_OVER));
+
+	// vertical gradient
+	vg_lite_identity(gradient_matrix);
+	vg_lite_translate(0.0f, 34.0f, gradient_matrix);
+	vg_lite_rotate(90.0f, gradient_matrix);
+	vg_lite_scale(28.0f / 256.0f, 1.0f, gradient_matrix);
+	vg_lite_identity(&matrix);
+	vg_lite_translate(8.0f, 34.0f, &matrix);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_draw_gradient(&__target, &path, VG_LITE_FILL_NON_ZERO, &matrix, &gradient, VG_LITE_BLEND_SRC_OVER));
+	__end("gradient");
+
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_clear_grad(&gradient));
+}
+
+static void __scene_clut(void) {
+	// CLUT then indexes (display_vglite.h): uint32_t for the alignment
+	static uint32_t data[(DISPLAY_VGLITE_CLUT_SIZE(4) + (INDEXED_HEIGHT * DISPLAY_VGLITE_INDEXED_STRIDE(INDEXED_WIDTH, 4))) / sizeof(uint32_t)];
+	MICROUI_Image image = { .width = INDEXED_WIDTH, .height = INDEXED_HEIGHT, .format = (jbyte)DISPLAY_VGLITE_IMAGE_FORMAT_INDEX4 };
+	vg_lite_buffer_t source;
+	vg_lite_matrix_t matrix;
+
+	HOST_MICROUI_set_image_data(&image, data);
+	uint32_t* clut = DISPLAY_VGLITE_get_clut(&image);
+	for (uint32_t i = 0; i < 16u; i++) {
+		// opaque hues, the last color is transparent
+		clut[i] = (15u == i) ? 0u : (0xff000000u | ((i * 16u) << 16) | ((255u - (i * 16u)) << 8) | ((i & 3u) * 80u));
+	}
+	uint8_t* indexes = DISPLAY_VGLITE_get_indexes(&image);
+	for (uint32_t y = 0; y < INDEXED_HEIGHT; y++) {
+		for (uint32_t x = 0; x < INDEXED_WIDTH; x += 2u) {
+			// the first pixel in the least significant bits
+			indexes[(y * DISPLAY_VGLITE_INDEXED_STRIDE(INDEXED_WIDTH, 4)) + (x / 2u)] = (uint8_t)(((x + y) & 15u) | (((x + 1u + y) & 15u) << 4));
+		}
+	}
+
+	__begin();
+	HOST_TEST_CHECK(DISPLAY_VGLITE_configure_source(&source, &image));
+
+	vg_lite_identity(&matrix);
+	vg_lite_translate(4.0f, 4.0f, &matrix);
+	vg_lite_scale(3.0f, 3.0f, &matrix);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_blit(&__target, &source, &matrix, VG_LITE_BLEND_SRC_OVER, OPAQUE, VG_LITE_FILTER_POINT));
+
+	vg_lite_identity(&matrix);
+	vg_lite_translate(8.0f, 36.0f, &matrix);
+	vg_lite_scale(3.0f, 2.5f, &matrix);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_blit(&__target, &source, &matrix, VG_LITE_BLEND_SRC_OVER, HALF_OPAQUE, VG_LITE_FILTER_BI_LINEAR));
+	__end("clut");
+
+	HOST_MICROUI_set_image_data(&image, NULL);
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(int argc, char* argv[]) {
+	HOST_TEST_CHECK((2 == argc) || ((3 == argc) && (0 == strcmp("--update", argv[2]))));
+	__folder = argv[1];
+	__update = (3 == argc);
+
+	DISPLAY_VGLITE_init();
+
+	__scene_clear();
+	__scene_blit();
+	__scene_fill();
+	__scene_gradient();
+	__scene_clut();
+
+	HOST_TEST_CHECK_EQUAL(0, __failures);
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
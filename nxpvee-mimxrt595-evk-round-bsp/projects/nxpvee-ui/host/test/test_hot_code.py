@@ -0,0 +1,225 @@
+#!/usr/bin/env python3
+#
+# Copyright 2023 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""Unit tests of hot_code.py: the map file and profile parsing, the ranking of
+the functions by samples per byte, the packing into the SRAM budget and the
+generated linker script fragment.
+
+Usage: test_hot_code.py (or python3 -m unittest test_hot_code)
+"""
+
+import contextlib
+import io
+import os
+import shutil
+import sys
+import tempfile
+import unittest
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', '..', 'common', 'scripts'))
+import hot_code  # noqa: E402
+
+# Excerpt of a GNU ld map file: a discarded section (ignored), a section name
+# split on two lines, an archive member, an empty section and two static
+# functions with the same name.
+MAP = '''\
+Archive member included to satisfy reference by file (symbol)
+
+Discarded input sections
+
+ .text.unused   0x00000000       0x10 CMakeFiles/bsp.dir/src/a.c.obj
+
+Memory Configuration
+
+Name             Origin             Length             Attributes
+QSPI_FLASH       0x08001000         0x007ff000         xr
+SRAM             0x20080000         0x00180000         xrw
+
+Linker script and memory map
+
+ .text.hot      0x08002000       0x40 CMakeFiles/bsp.dir/src/a.c.obj
+                0x08002000                hot
+ .text.a_function_with_a_very_long_name_that_is_split
+                0x08002040      0x100 CMakeFiles/bsp.dir/src/b.c.obj
+ .text.memcpy   0x08002140       0x22 /opt/gcc/lib/thumb/libc_nano.a(libc_a-memcpy.o)
+ .text.cold     0x08002164       0x80 CMakeFiles/bsp.dir/src/a.c.obj
+ .text.empty    0x080021e4        0x0 CMakeFiles/bsp.dir/src/a.c.obj
+ .text.helper   0x080021e4       0x10 CMakeFiles/bsp.dir/src/a.c.obj
+ .text.helper   0x080021f4       0x10 CMakeFiles/bsp.dir/src/c.c.obj
+'''
+
+LONG = 'a_function_with_a_very_long_name_that_is_split'
+
+# PC samples (the Thumb bit set as in the sampling logs) with and without count
+PC_PROFILE = '''\
+# J-Link PC sampling
+0x08002001 40
+08002010 8
+0x08002041 30
+0x08002140
+0x08002141 5
+0x08002170 2
+0x00001000 15
+'''
+
+# function samples (CSV export), with a header
+CSV_PROFILE = '''\
+function,samples
+helper,10
+not_in_the_map,7
+'''
+
+
+def _sections():
+    return hot_code.parse_map(MAP.splitlines(True))
+
+
+def _candidates(pc_profile=PC_PROFILE, csv_profile=CSV_PROFILE):
+    pcs, _ = hot_code.parse_profile(pc_profile.splitlines(True))
+    _, functions = hot_code.parse_profile(csv_profile.splitlines(True))
+    return hot_code.attribute_samples(_sections(), pcs, functions)
+
+
+def _by_function(candidates):
+    result = {}
+    for candidate in candidates:
+        result.setdefault(candidate.section.function, []).append(candidate)
+    return result
+
+
+class ParseTest(unittest.TestCase):
+
+    def test_map(self):
+        sections = _sections()
+        # the discarded and empty sections are not candidates
+        self.assertEqual(['hot', LONG, 'memcpy', 'cold', 'helper', 'helper'], [s.function for s in sections])
+        long_section = sections[1]
+        self.assertEqual('.text.' + LONG, long_section.name)
+        self.assertEqual(0x08002040, long_section.address)
+        self.assertEqual(0x100, long_section.size)
+        self.assertEqual('CMakeFiles/bsp.dir/src/b.c.obj', long_section.obj)
+
+    def test_map_without_memory_map(self):
+        self.assertEqual([], hot_code.parse_map(MAP.split('Linker script')[0].splitlines(True)))
+
+    def test_pc_profile(self):
+        pcs, functions = hot_code.parse_profile(PC_PROFILE.splitlines(True))
+        self.assertEqual({}, dict(functions))
+        self.assertEqual(40, pcs[0x08002001])
+        self.assertEqual(8, pcs[0x08002010])
+        self.assertEqual(1, pcs[0x08002140])
+        self.assertEqual(101, sum(pcs.values()))
+
+    def test_csv_profile(self):
+        pcs, functions = hot_code.parse_profile(CSV_PROFILE.splitlines(True))
+        self.assertEqual({}, dict(pcs))
+        self.assertEqual({'helper': 10, 'not_in_the_map': 7}, dict(functions))
+
+    def test_invalid_profile(self):
+        with self.assertRaises(ValueError):
+            hot_code.parse_profile(['0x08002000 10\n', 'hot\n'])
+
+    def test_size(self):
+        self.assertEqual(32 * 1024, hot_code.parse_size('32K'))
+        self.assertEqual(1024 * 1024, hot_code.parse_size('1m'))
+        self.assertEqual(100, hot_code.parse_size('100'))
+
+
+class RankingTest(unittest.TestCase):
+
+    def test_attribution(self):
+        candidates, total, unresolved = _candidates()
+        functions = _by_function(candidates)
+        self.assertEqual(48, functions['hot'][0].samples)
+        self.assertEqual(30, functions[LONG][0].samples)
+        # the Thumb bit is cleared: 0x08002141 is memcpy
+        self.assertEqual(6, functions['memcpy'][0].samples)
+        self.assertEqual(2, functions['cold'][0].samples)
+        # the static functions with the same name share the samples
+        self.assertEqual([5, 5], [c.samples for c in functions['helper']])
+        # outside the image, and a function that is not in the map
+        self.assertEqual(101 + 17, total)
+        self.assertEqual(15 + 7, unresolved)
+
+    def test_aligned_size(self):
+        functions = _by_function(_candidates()[0])
+        self.assertEqual(0x24, functions['memcpy'][0].size)
+        self.assertEqual(0x40, functions['hot'][0].size)
+
+    def test_ranking(self):
+        candidates = _candidates()[0]
+        selection, used = hot_code.select(candidates, 1024 * 1024)
+        # samples per byte: hot 48/64, helper 5/16 (lowest address first), memcpy 6/36, LONG 30/256, cold 2/128
+        self.assertEqual(['hot', 'helper', 'helper', 'memcpy', LONG, 'cold'], [c.section.function for c in selection])
+        self.assertEqual([0x080021e4, 0x080021f4], [c.section.address for c in selection[1:3]])
+        self.assertEqual(0x40 + 0x10 + 0x10 + 0x24 + 0x100 + 0x80, used)
+
+    def test_budget_packing(self):
+        candidates = _candidates()[0]
+        # LONG does not fit after hot, helper, helper and memcpy: skipped, cold still fits
+        budget = 0x40 + 0x10 + 0x10 + 0x24 + 0x80
+        selection, used = hot_code.select(candidates, budget)
+        self.assertEqual(['hot', 'helper', 'helper', 'memcpy', 'cold'], [c.section.function for c in selection])
+        self.assertEqual(budget, used)
+        selection, used = hot_code.select(candidates, 0x3f)
+        self.assertEqual(['helper', 'helper'], [c.section.function for c in selection])
+        self.assertEqual(0x20, used)
+
+    def test_excludes(self):
+        selection, _ = hot_code.select(_candidates()[0], 1024, excludes=['mem*', 'h?lper'])
+        self.assertEqual(['hot', LONG, 'cold'], [c.section.function for c in selection])
+
+    def test_no_sample(self):
+        selection, _ = hot_code.select(_candidates(PC_PROFILE, '')[0], 1024)
+        self.assertNotIn('helper', [c.section.function for c in selection])
+
+    def test_expected_gain(self):
+        self.assertAlmostEqual(0.25, hot_code.expected_gain(0.5, 2.0))
+        self.assertAlmostEqual(0.0, hot_code.expected_gain(0.0, 4.0))
+
+
+class FragmentTest(unittest.TestCase):
+
+    def test_fragment(self):
+        candidates, total, _ = _candidates()
+        selection, _ = hot_code.select(candidates, 0x40 + 0x24, excludes=['helper'])
+        out = io.StringIO()
+        hot_code.write_fragment(out, selection, 0x40 + 0x24, total)
+        self.assertEqual('/*\n'
+                         ' * Generated by projects/common/scripts/hot_code.py: do not edit.\n'
+                         ' * 2 functions, 100 bytes (budget 100 bytes), 45.8% of the samples.\n'
+                         ' */\n'
+                         '        *a.c.obj(.text.hot)\n'
+                         '        *libc_nano.a:libc_a-memcpy.o(.text.memcpy)\n', out.getvalue())
+
+    def test_main(self):
+        folder = tempfile.mkdtemp()
+        try:
+            paths = {}
+            for name, text in (('bsp.map', MAP), ('pc.log', PC_PROFILE), ('profile.csv', CSV_PROFILE)):
+                paths[name] = os.path.join(folder, name)
+                with open(paths[name], 'w') as f:
+                    f.write(text)
+            output = os.path.join(folder, 'hot_code.ld')
+            report = io.StringIO()
+            with contextlib.redirect_stdout(report):
+                self.assertEqual(0, hot_code.main(['--map', paths['bsp.map'], '--profile', paths['pc.log'],
+                                                   '--profile', paths['profile.csv'], '--budget', '1K',
+                                                   '--exclude', 'cold', '--output', output]))
+            self.assertIn('selected:   5 functions, 388 / 1024 bytes of SRAM', report.getvalue())
+            self.assertIn('samples:    118, 22 outside the movable functions', report.getvalue())
+            with open(output) as f:
+                lines = f.read().splitlines()
+            self.assertEqual(['*a.c.obj(.text.hot)', '*a.c.obj(.text.helper)', '*c.c.obj(.text.helper)',
+                              '*libc_nano.a:libc_a-memcpy.o(.text.memcpy)', '*b.c.obj(.text.%s)' % LONG],
+                             [line.strip() for line in lines[4:]])
+        finally:
+            shutil.rmtree(folder)
+
+
+if __name__ == '__main__':
+    unittest.main()
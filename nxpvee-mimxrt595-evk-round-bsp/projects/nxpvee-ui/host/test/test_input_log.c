@@ -0,0 +1,226 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host test of the lock-free ring of the input log (input_log.c):
+ *
+ * - in one thread: the ring full (the records dropped, the peak), the wrap
+ * around of the positions at 2^32, the sample time and the lost events;
+ * - a producer thread (INPUT_LOG_record()) and a consumer thread
+ * (INPUT_LOG_read()) that runs in bursts, the positions starting just before
+ * 2^32: every record read is complete (never torn), the records are read in
+ * order, the missing ones are exactly the dropped ones.
+ *
+ * The module is included (not linked) to give it a fake time and to set its
+ * positions.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "host_test.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+static uint32_t __now;
+
+#define INPUT_LOG_ENABLED 1
+#define INPUT_LOG_GET_TIME_US() (__now)
+
+#include "input_log.c"
+
+// records of the producer thread
+#define RECORDS (2000000u)
+
+// the producer yields every PRODUCER_BURST records, except during a long burst
+// (longer than the ring) every PRODUCER_PERIOD records; the consumer yields after
+// CONSUMER_BURST records at most
+#define PRODUCER_BURST (32u)
+#define PRODUCER_LONG_BURST (512u)
+#define PRODUCER_PERIOD (8192u)
+#define CONSUMER_BURST (64u)
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+static volatile bool __producer_done;
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+static void __reset(uint32_t position) {
+	ring_head = position;
+	ring_tail = position;
+	ring_dropped = 0;
+	ring_peak = 0;
+	ring_lost = 0;
+	INPUT_LOG_source_time = 0;
+}
+
+// the fields of a record are all derived from its sequence number
+static void __record(uint32_t sequence) {
+	__now = sequence * 3u;
+	INPUT_LOG_set_source_time(~sequence);
+	INPUT_LOG_record(INPUT_LOG_KIND_EVENT, sequence, sequence & 0xFFFFu, sequence % 300u);
+}
+
+static void __check_record(const INPUT_LOG_record_t* record) {
+	uint32_t sequence = record->data;
+	HOST_TEST_CHECK_EQUAL(sequence * 3u, record->time);
+	HOST_TEST_CHECK_EQUAL(~sequence, record->source);
+	HOST_TEST_CHECK_EQUAL(sequence & 0xFFFFu, record->index);
+	HOST_TEST_CHECK_EQUAL(INPUT_LOG_KIND_EVENT, record->kind);
+	// 255 at most
+	HOST_TEST_CHECK_EQUAL(((sequence % 300u) > 255u) ? 255u : (sequence % 300u), record->remaining);
+}
+
+static void __test_single_thread(void) {
+	INPUT_LOG_record_t record;
+	INPUT_LOG_stats_t stats;
+
+	// the ring is filled across the wrap around of the positions
+	uint32_t start = UINT32_MAX - 10u;
+	__reset(start);
+	HOST_TEST_CHECK(!INPUT_LOG_read(&record));
+	for (uint32_t s = 0; s < ((uint32_t)INPUT_LOG_SIZE + 5u); s++) {
+		__record(s);
+	}
+	INPUT_LOG_get_stats(&stats);
+	HOST_TEST_CHECK_EQUAL(start + (uint32_t)INPUT_LOG_SIZE, stats.logged);
+	HOST_TEST_CHECK_EQUAL(5u, stats.dropped);
+	HOST_TEST_CHECK_EQUAL(INPUT_LOG_SIZE, stats.peak);
+
+	// one record read: room for one record
+	HOST_TEST_CHECK(INPUT_LOG_read(&record));
+	__check_record(&record);
+	HOST_TEST_CHECK_EQUAL(0u, record.data);
+	__record(1000u);
+	__record(1001u);
+	INPUT_LOG_get_stats(&stats);
+	HOST_TEST_CHECK_EQUAL(6u, stats.dropped);
+	HOST_TEST_CHECK_EQUAL(start + 1u, stats.drained);
+
+	// the records kept, in order, then the one recorded after the read
+	for (uint32_t s = 1; s < (uint32_t)INPUT_LOG_SIZE; s++) {
+		HOST_TEST_CHECK(INPUT_LOG_read(&record));
+		__check_record(&record);
+		HOST_TEST_CHECK_EQUAL(s, record.data);
+	}
+	HOST_TEST_CHECK(INPUT_LOG_read(&record));
+	HOST_TEST_CHECK_EQUAL(1000u, record.data);
+	HOST_TEST_CHECK(!INPUT_LOG_read(&record));
+	INPUT_LOG_get_stats(&stats);
+	HOST_TEST_CHECK_EQUAL(stats.logged, stats.drained);
+	HOST_TEST_CHECK(stats.logged < start);
+
+	// the sample time is recorded with the next event or replaced element only,
+	// once; a lost event is counted even when the ring is full
+	__reset(0);
+	INPUT_LOG_set_source_time(77u);
+	INPUT_LOG_record(INPUT_LOG_KIND_DATA, 1u, 0u, 0u);
+	INPUT_LOG_record(INPUT_LOG_KIND_REPLACE, 2u, 0u, 0u);
+	INPUT_LOG_record(INPUT_LOG_KIND_EVENT, 3u, 0u, 0u);
+	HOST_TEST_CHECK(INPUT_LOG_read(&record));
+	HOST_TEST_CHECK_EQUAL(0u, record.source);
+	HOST_TEST_CHECK(INPUT_LOG_read(&record));
+	HOST_TEST_CHECK_EQUAL(77u, record.source);
+	HOST_TEST_CHECK(INPUT_LOG_read(&record));
+	HOST_TEST_CHECK_EQUAL(0u, record.source);
+	for (uint32_t s = 0; s < ((uint32_t)INPUT_LOG_SIZE + 1u); s++) {
+		INPUT_LOG_record(INPUT_LOG_KIND_FULL, 0u, 0u, 0u);
+	}
+	INPUT_LOG_get_stats(&stats);
+	HOST_TEST_CHECK_EQUAL(INPUT_LOG_SIZE + 1, stats.lost);
+	HOST_TEST_CHECK_EQUAL(1u, stats.dropped);
+}
+
+static void* __producer(void* arg) {
+	(void)arg;
+	for (uint32_t s = 0; s < RECORDS; s++) {
+		__record(s);
+		if ((0u == (s % PRODUCER_BURST)) && ((s % PRODUCER_PERIOD) >= PRODUCER_LONG_BURST)) {
+			// let the consumer catch up
+			(void)sched_yield();
+		}
+	}
+	__atomic_store_n(&__producer_done, true, __ATOMIC_RELEASE);
+	return NULL;
+}
+
+static void __test_threads(void) {
+	INPUT_LOG_record_t record;
+	INPUT_LOG_stats_t stats;
+	pthread_t producer;
+
+	// 2^32 is crossed after a few records
+	uint32_t start = UINT32_MAX - 1000u;
+	__reset(start);
+	__producer_done = false;
+	HOST_TEST_CHECK(0 == pthread_create(&producer, NULL, __producer, NULL));
+
+	uint32_t read = 0;
+	uint32_t missing = 0;
+	uint32_t expected = 0;
+	bool done = false;
+	while (!done) {
+		// the end is checked before the last reads
+		done = __atomic_load_n(&__producer_done, __ATOMIC_ACQUIRE);
+		uint32_t burst = 0;
+		while ((burst < CONSUMER_BURST) && INPUT_LOG_read(&record)) {
+			__check_record(&record);
+			// in order: the missing records have been dropped
+			HOST_TEST_CHECK(record.data >= expected);
+			missing += record.data - expected;
+			expected = record.data + 1u;
+			read++;
+			burst++;
+		}
+		if (CONSUMER_BURST == burst) {
+			done = false;
+		}
+		(void)sched_yield();
+	}
+	HOST_TEST_CHECK(0 == pthread_join(producer, NULL));
+	HOST_TEST_CHECK(!INPUT_LOG_read(&record));
+
+	INPUT_LOG_get_stats(&stats);
+	missing += RECORDS - expected;
+	(void)printf("threads: %u records, %u read, %u dropped, peak %u / %u\n", RECORDS, read, stats.dropped, stats.peak,
+			INPUT_LOG_SIZE);
+	HOST_TEST_CHECK_EQUAL(RECORDS, read + stats.dropped);
+	HOST_TEST_CHECK_EQUAL(stats.dropped, missing);
+	HOST_TEST_CHECK_EQUAL(start + read, stats.logged);
+	HOST_TEST_CHECK_EQUAL(stats.logged, stats.drained);
+	HOST_TEST_CHECK(stats.peak <= (uint32_t)INPUT_LOG_SIZE);
+	// the consumer runs in bursts: the ring has been full
+	HOST_TEST_CHECK(stats.dropped > 0u);
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(void) {
+	__test_single_thread();
+	__test_threads();
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
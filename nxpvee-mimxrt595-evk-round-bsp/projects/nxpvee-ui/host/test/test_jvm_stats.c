@@ -0,0 +1,285 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host test of the Java thread CPU accounting and GC pause statistics
+ * (jvm_stats.c), replayed with a fake cycle counter (1 MHz: one cycle per
+ * microsecond): running times, preemption without notification, ready to
+ * running latencies, GC pauses excluded from the running time, histogram and
+ * worst pauses, reuse of the entries, reset, and the extension of the 32-bit
+ * counter across its wrap.
+ *
+ * The module is included (not linked) to give it the fake cycle counter and to
+ * reset its private state between the tests.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <string.h>
+
+#include "host_test.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+static uint32_t __cycles;
+static int64_t __time_ms;
+
+#define JVM_STATS_ENABLED 1
+#define JVM_STATS_GET_CYCLES() (__cycles)
+#define JVM_STATS_GET_FREQUENCY() (1000000u)
+#define JVM_STATS_START_CYCLES() do { } while (0)
+#define JVM_STATS_GET_TIME_MS() (__time_ms)
+
+#include "jvm_stats.c"
+
+#define THREAD_A (10)
+#define THREAD_B (11)
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+static void __start(uint32_t cycles) {
+	(void)memset(threads, 0, sizeof(threads));
+	(void)memset(&gc, 0, sizeof(gc));
+	running = NULL;
+	gc_running = false;
+	cycles_high = 0;
+	__cycles = cycles;
+	__time_ms = 0;
+	JVM_STATS_initialize();
+}
+
+static void __state(uint32_t cycles, int32_t thread_id, int32_t state) {
+	__cycles = cycles;
+	JVM_STATS_on_thread_state_changed(thread_id, state);
+}
+
+static JVM_STATS_thread_t __get(int32_t thread_id) {
+	JVM_STATS_thread_t thread;
+	HOST_TEST_CHECK(JVM_STATS_get_thread(thread_id, &thread));
+	return thread;
+}
+
+static void __test_running_time(void) {
+	__start(0);
+	JVM_STATS_on_thread_create(THREAD_A);
+	JVM_STATS_on_thread_create(THREAD_B);
+
+	__state(100, THREAD_A, JVM_STATS_STATE_RUNNING);
+	__state(1100, THREAD_A, JVM_STATS_STATE_READY);
+	HOST_TEST_CHECK_EQUAL(1000u, __get(THREAD_A).running_time);
+	HOST_TEST_CHECK_EQUAL(1u, __get(THREAD_A).scheduled);
+
+	// B waits 300 us for the CPU
+	__state(1100, THREAD_B, JVM_STATS_STATE_READY);
+	__state(1400, THREAD_B, JVM_STATS_STATE_RUNNING);
+	HOST_TEST_CHECK_EQUAL(1u, __get(THREAD_B).latency_count);
+	HOST_TEST_CHECK_EQUAL(300u, __get(THREAD_B).latency_total);
+
+	// the current running period is counted by a query, without a state change
+	__cycles = 1900;
+	HOST_TEST_CHECK_EQUAL(500u, __get(THREAD_B).running_time);
+
+	// A runs without a notification that B has been preempted: B stops at 2000
+	__state(2000, THREAD_A, JVM_STATS_STATE_RUNNING);
+	HOST_TEST_CHECK_EQUAL(600u, __get(THREAD_B).running_time);
+	HOST_TEST_CHECK_EQUAL(900u, __get(THREAD_A).latency_max);
+	__cycles = 2500;
+	HOST_TEST_CHECK_EQUAL(600u, __get(THREAD_B).running_time);
+	HOST_TEST_CHECK_EQUAL(1500u, __get(THREAD_A).running_time);
+
+	// a second ready state does not restart the latency
+	__state(2500, THREAD_B, JVM_STATS_STATE_READY);
+	__state(2600, THREAD_B, JVM_STATS_STATE_READY);
+	__state(2700, THREAD_B, JVM_STATS_STATE_RUNNING);
+	HOST_TEST_CHECK_EQUAL(2u, __get(THREAD_B).latency_count);
+	HOST_TEST_CHECK_EQUAL(500u, __get(THREAD_B).latency_total);
+	HOST_TEST_CHECK_EQUAL(2u, __get(THREAD_B).scheduled);
+
+	// a waiting thread is not ready: no latency
+	__state(2800, THREAD_B, JVM_STATS_STATE_WAITING);
+	__state(3000, THREAD_B, JVM_STATS_STATE_RUNNING);
+	HOST_TEST_CHECK_EQUAL(2u, __get(THREAD_B).latency_count);
+
+	JVM_STATS_thread_t all[4];
+	HOST_TEST_CHECK_EQUAL(2u, JVM_STATS_get_threads(all, 4));
+	HOST_TEST_CHECK_EQUAL(1u, JVM_STATS_get_threads(all, 1));
+	HOST_TEST_CHECK(!JVM_STATS_get_thread(99, &all[0]));
+}
+
+static void __test_gc(void) {
+	__start(0);
+	JVM_STATS_on_thread_create(THREAD_A);
+	__state(1000, THREAD_A, JVM_STATS_STATE_RUNNING);
+
+	// a 400 us pause in the running period of A is not counted
+	__cycles = 1500;
+	__time_ms = 42;
+	JVM_STATS_on_gc_start();
+	__cycles = 1700;
+	HOST_TEST_CHECK_EQUAL(500u, __get(THREAD_A).running_time);
+	__cycles = 1900;
+	JVM_STATS_on_gc_stop();
+	__state(2000, THREAD_A, JVM_STATS_STATE_WAITING);
+	HOST_TEST_CHECK_EQUAL(600u, __get(THREAD_A).running_time);
+
+	JVM_STATS_gc_t g;
+	JVM_STATS_get_gc(&g);
+	HOST_TEST_CHECK_EQUAL(1u, g.count);
+	HOST_TEST_CHECK_EQUAL(400u, g.total_time);
+	HOST_TEST_CHECK_EQUAL(1u, g.histogram[8]);
+	HOST_TEST_CHECK_EQUAL(400u, g.worst[0].duration);
+	HOST_TEST_CHECK_EQUAL(42, g.worst[0].time);
+
+	// a thread that stops during a GC: its running time was counted at the GC start
+	__state(3000, THREAD_A, JVM_STATS_STATE_RUNNING);
+	__cycles = 3100;
+	JVM_STATS_on_gc_start();
+	__state(3300, THREAD_A, JVM_STATS_STATE_WAITING);
+	__cycles = 3400;
+	JVM_STATS_on_gc_stop();
+	HOST_TEST_CHECK_EQUAL(700u, __get(THREAD_A).running_time);
+
+	// a stop without start is ignored
+	JVM_STATS_on_gc_stop();
+
+	// the histogram (the first and last buckets count the shorter and longer
+	// pauses) and the worst pauses, the longest first
+	static const uint32_t pauses[] = { 0u, 1u, 3u, 1000u, 5000000u, 2u };
+	for (uint32_t i = 0; i < (sizeof(pauses) / sizeof(pauses[0])); i++) {
+		__cycles += 10u;
+		__time_ms = 100 + (int64_t)i;
+		JVM_STATS_on_gc_start();
+		__cycles += pauses[i];
+		JVM_STATS_on_gc_stop();
+	}
+	JVM_STATS_get_gc(&g);
+	HOST_TEST_CHECK_EQUAL(8u, g.count);
+	HOST_TEST_CHECK_EQUAL(400u + 300u + 0u + 1u + 3u + 1000u + 5000000u + 2u, g.total_time);
+	HOST_TEST_CHECK_EQUAL(2u, g.histogram[0]);
+	HOST_TEST_CHECK_EQUAL(2u, g.histogram[1]);
+	HOST_TEST_CHECK_EQUAL(1u, g.histogram[9]);
+	HOST_TEST_CHECK_EQUAL(1u, g.histogram[JVM_STATS_GC_BUCKETS - 1]);
+	HOST_TEST_CHECK_EQUAL(5000000u, g.worst[0].duration);
+	HOST_TEST_CHECK_EQUAL(104, g.worst[0].time);
+	HOST_TEST_CHECK_EQUAL(1000u, g.worst[1].duration);
+	HOST_TEST_CHECK_EQUAL(400u, g.worst[2].duration);
+	HOST_TEST_CHECK_EQUAL(300u, g.worst[3].duration);
+}
+
+static void __test_entries(void) {
+	__start(0);
+	for (int32_t id = 0; id < JVM_STATS_MAX_THREADS; id++) {
+		JVM_STATS_on_thread_create(id);
+	}
+	// no entry left
+	JVM_STATS_on_thread_create(100);
+	JVM_STATS_thread_t thread;
+	HOST_TEST_CHECK(!JVM_STATS_get_thread(100, &thread));
+
+	// the entry of a terminated thread is reused
+	__state(10, 3, JVM_STATS_STATE_RUNNING);
+	__state(20, 3, JVM_STATS_STATE_TERMINATED);
+	HOST_TEST_CHECK(__get(3).terminated);
+	HOST_TEST_CHECK_EQUAL(10u, __get(3).running_time);
+	JVM_STATS_on_thread_create(100);
+	HOST_TEST_CHECK(!JVM_STATS_get_thread(3, &thread));
+	HOST_TEST_CHECK_EQUAL(0u, __get(100).running_time);
+
+	// the identifier of a terminated thread is reused: new statistics
+	__state(30, 5, JVM_STATS_STATE_RUNNING);
+	__state(50, 5, JVM_STATS_STATE_TERMINATED);
+	JVM_STATS_on_thread_create(5);
+	HOST_TEST_CHECK(!__get(5).terminated);
+	HOST_TEST_CHECK_EQUAL(0u, __get(5).scheduled);
+
+	// a terminated thread that was running is not running anymore
+	__state(60, 6, JVM_STATS_STATE_RUNNING);
+	__state(70, 6, JVM_STATS_STATE_TERMINATED);
+	__cycles = 1000;
+	HOST_TEST_CHECK_EQUAL(10u, __get(6).running_time);
+
+	// a state change of an unknown thread creates its entry (when an entry is free
+	// or terminated), not its termination
+	__state(80, 6, JVM_STATS_STATE_TERMINATED);
+	JVM_STATS_on_thread_create(6);
+	__state(90, 200, JVM_STATS_STATE_TERMINATED);
+	HOST_TEST_CHECK(!JVM_STATS_get_thread(200, &thread));
+	__state(90, 201, JVM_STATS_STATE_READY);
+	HOST_TEST_CHECK(!JVM_STATS_get_thread(201, &thread));
+	__state(95, 8, JVM_STATS_STATE_TERMINATED);
+	__state(95, 201, JVM_STATS_STATE_READY);
+	HOST_TEST_CHECK(JVM_STATS_get_thread(201, &thread));
+	HOST_TEST_CHECK(!JVM_STATS_get_thread(8, &thread));
+
+	// reset: the threads are kept, their statistics are cleared
+	__state(100, 7, JVM_STATS_STATE_RUNNING);
+	__cycles = 150;
+	JVM_STATS_reset();
+	__cycles = 170;
+	HOST_TEST_CHECK_EQUAL(20u, __get(7).running_time);
+	HOST_TEST_CHECK_EQUAL(0u, __get(7).scheduled);
+	JVM_STATS_gc_t g;
+	JVM_STATS_get_gc(&g);
+	HOST_TEST_CHECK_EQUAL(0u, g.count);
+}
+
+static void __test_wrap(void) {
+	// the 32-bit counter wraps during a running period
+	__start(0xFFFFF000u);
+	JVM_STATS_on_thread_create(THREAD_A);
+	__state(0xFFFFFF00u, THREAD_A, JVM_STATS_STATE_RUNNING);
+
+	// a query does not extend the counter but sees the wrap
+	__cycles = 0x00000100u;
+	HOST_TEST_CHECK_EQUAL(0x200u, __get(THREAD_A).running_time);
+	HOST_TEST_CHECK_EQUAL(0x200u, __get(THREAD_A).running_time);
+
+	__state(0x00000300u, THREAD_A, JVM_STATS_STATE_READY);
+	HOST_TEST_CHECK_EQUAL(0x400u, __get(THREAD_A).running_time);
+
+	// the latency across the wrap
+	__state(0xFFFFFFF0u, THREAD_B, JVM_STATS_STATE_READY);
+	__state(0x00000010u, THREAD_B, JVM_STATS_STATE_RUNNING);
+	HOST_TEST_CHECK_EQUAL(0x20u, __get(THREAD_B).latency_max);
+
+	// 64-bit times: a GC pause across the third wrap
+	__state(0x80000000u, THREAD_B, JVM_STATS_STATE_WAITING);
+	__cycles = 0xFFFFFF9Cu;
+	JVM_STATS_on_gc_start();
+	__cycles = 0x00000064u;
+	JVM_STATS_on_gc_stop();
+	JVM_STATS_gc_t g;
+	JVM_STATS_get_gc(&g);
+	HOST_TEST_CHECK_EQUAL(200u, g.worst[0].duration);
+	HOST_TEST_CHECK_EQUAL((uint64_t)3u << 32, cycles_high);
+	HOST_TEST_CHECK_EQUAL(0x80000000u - 0x10u, __get(THREAD_B).running_time);
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(void) {
+	__test_running_time();
+	__test_gc();
+	__test_entries();
+	__test_wrap();
+	JVM_STATS_dump();
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
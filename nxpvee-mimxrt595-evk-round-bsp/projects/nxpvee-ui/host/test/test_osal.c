@@ -0,0 +1,222 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host test of the POSIX OSAL (osal_posix.c): timeouts, queue order and
+ * capacity, mutual exclusion, task deletion and event flags.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include "host_test.h"
+#include "osal.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define QUEUE_SIZE (8u)
+#define MESSAGES (10000u)
+#define INCREMENTS (10000u)
+#define EVENTS (100000u)
+
+#define EVENT_ODD (1u << 0)
+#define EVENT_EVEN (1u << 1)
+#define EVENT_END (1u << 2)
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+static OSAL_queue_handle_t __queue;
+static OSAL_counter_semaphore_handle_t __done;
+static OSAL_binary_semaphore_handle_t __binary;
+static OSAL_mutex_handle_t __mutex;
+static OSAL_event_handle_t __event;
+
+// read by the task that deletes itself after the test returns
+static OSAL_task_handle_t __self_deleting_task;
+
+static volatile uint32_t __shared;
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+static uint64_t __now_ms(void) {
+	return HOST_TEST_now_ns() / 1000000u;
+}
+
+static void* __producer(void* args) {
+	for (uintptr_t i = 1; i <= MESSAGES; i++) {
+		// a post never blocks on the host: retry while the queue is full
+		while (OSAL_OK != OSAL_queue_post(&__queue, (void*)i)) {
+			(void)OSAL_sleep(0);
+		}
+	}
+	(void)OSAL_counter_semaphore_give(&__done);
+	return args;
+}
+
+static void* __incrementer(void* args) {
+	for (uint32_t i = 0; i < INCREMENTS; i++) {
+		HOST_TEST_CHECK(OSAL_OK == OSAL_mutex_take(&__mutex, OSAL_INFINITE_TIME));
+		__shared++;
+		HOST_TEST_CHECK(OSAL_OK == OSAL_mutex_give(&__mutex));
+	}
+	(void)OSAL_counter_semaphore_give(&__done);
+	return args;
+}
+
+static void* __self_deleting(void* args) {
+	(void)OSAL_binary_semaphore_give(&__binary);
+	(void)OSAL_task_delete((OSAL_task_handle_t*)args);
+	HOST_TEST_CHECK(0); // not reached
+	return NULL;
+}
+
+static void* __event_setter(void* args) {
+	for (uint32_t i = 0; i < EVENTS; i++) {
+		(void)OSAL_event_set_from_isr(&__event, (0u != (i & 1u)) ? EVENT_ODD : EVENT_EVEN);
+	}
+	(void)OSAL_event_set(&__event, EVENT_END);
+	(void)OSAL_counter_semaphore_give(&__done);
+	return args;
+}
+
+static void __test_timeouts(void) {
+	void* message;
+	uint64_t start = __now_ms();
+	HOST_TEST_CHECK(OSAL_ERROR == OSAL_queue_fetch(&__queue, &message, 100));
+	HOST_TEST_CHECK((__now_ms() - start) >= 99u);
+	HOST_TEST_CHECK(OSAL_ERROR == OSAL_queue_fetch(&__queue, &message, 0));
+
+	HOST_TEST_CHECK(OSAL_ERROR == OSAL_binary_semaphore_take(&__binary, 50));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_binary_semaphore_give(&__binary));
+	HOST_TEST_CHECK(OSAL_ERROR == OSAL_binary_semaphore_give(&__binary));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_binary_semaphore_take(&__binary, 0));
+
+	start = __now_ms();
+	HOST_TEST_CHECK(OSAL_OK == OSAL_sleep(30));
+	HOST_TEST_CHECK((__now_ms() - start) >= 30u);
+}
+
+static void __test_queue(void) {
+	void* message;
+	for (uintptr_t i = 0; i < QUEUE_SIZE; i++) {
+		HOST_TEST_CHECK(OSAL_OK == OSAL_queue_post(&__queue, (void*)i));
+	}
+	HOST_TEST_CHECK(OSAL_NOMEM == OSAL_queue_post(&__queue, NULL));
+	for (uintptr_t i = 0; i < QUEUE_SIZE; i++) {
+		HOST_TEST_CHECK(OSAL_OK == OSAL_queue_fetch(&__queue, &message, 0));
+		HOST_TEST_CHECK((void*)i == message);
+	}
+}
+
+static void __test_mutex(void) {
+	// not recursive: a timed take fails while the mutex is held
+	HOST_TEST_CHECK(OSAL_OK == OSAL_mutex_take(&__mutex, 0));
+	HOST_TEST_CHECK(OSAL_ERROR == OSAL_mutex_take(&__mutex, 20));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_mutex_give(&__mutex));
+#if !defined(__SANITIZE_THREAD__)
+	// TSan reports the unlock of an unlocked mutex before OSAL_mutex_give() fails
+	HOST_TEST_CHECK(OSAL_ERROR == OSAL_mutex_give(&__mutex));
+#endif
+}
+
+static void __test_tasks(void) {
+	OSAL_task_stack_declare(stack, 16 * 1024);
+	OSAL_task_handle_t producer;
+	OSAL_task_handle_t incrementer1;
+	OSAL_task_handle_t incrementer2;
+	void* message;
+
+	HOST_TEST_CHECK(OSAL_OK == OSAL_task_create(__producer, (uint8_t*)"producer-with-a-long-name", stack, 5, NULL, &producer));
+	for (uintptr_t i = 1; i <= MESSAGES; i++) {
+		HOST_TEST_CHECK(OSAL_OK == OSAL_queue_fetch(&__queue, &message, OSAL_INFINITE_TIME));
+		HOST_TEST_CHECK((void*)i == message);
+	}
+
+	HOST_TEST_CHECK(OSAL_OK == OSAL_task_create(__incrementer, (uint8_t*)"incrementer1", stack, 5, NULL, &incrementer1));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_task_create(__incrementer, (uint8_t*)"incrementer2", stack, 5, NULL, &incrementer2));
+	for (int i = 0; i < 3; i++) {
+		HOST_TEST_CHECK(OSAL_OK == OSAL_counter_semaphore_take(&__done, 2000));
+	}
+	HOST_TEST_CHECK_EQUAL(2u * INCREMENTS, __shared);
+	HOST_TEST_CHECK(OSAL_OK == OSAL_task_delete(&producer));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_task_delete(&incrementer1));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_task_delete(&incrementer2));
+
+	HOST_TEST_CHECK(OSAL_OK == OSAL_task_create(__self_deleting, (uint8_t*)"self", stack, 5, &__self_deleting_task, &__self_deleting_task));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_binary_semaphore_take(&__binary, OSAL_INFINITE_TIME));
+
+	// recursive
+	HOST_TEST_CHECK(OSAL_OK == OSAL_disable_context_switching());
+	HOST_TEST_CHECK(OSAL_OK == OSAL_disable_context_switching());
+	HOST_TEST_CHECK(OSAL_OK == OSAL_enable_context_switching());
+	HOST_TEST_CHECK(OSAL_OK == OSAL_enable_context_switching());
+}
+
+static void __test_events(void) {
+	OSAL_task_stack_declare(stack, 16 * 1024);
+	OSAL_task_handle_t setter;
+	uint32_t received;
+
+	HOST_TEST_CHECK(OSAL_ERROR == OSAL_event_wait(&__event, EVENT_ODD, &received, 0));
+	HOST_TEST_CHECK_EQUAL(0, received);
+	HOST_TEST_CHECK(OSAL_ERROR == OSAL_event_wait(&__event, EVENT_ODD, &received, 20));
+	HOST_TEST_CHECK_EQUAL(0, received);
+
+	// only the waited flags are received and cleared
+	HOST_TEST_CHECK(OSAL_OK == OSAL_event_set(&__event, EVENT_ODD | EVENT_EVEN));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_event_wait(&__event, EVENT_ODD, &received, 0));
+	HOST_TEST_CHECK_EQUAL(EVENT_ODD, received);
+	HOST_TEST_CHECK(OSAL_OK == OSAL_event_wait(&__event, EVENT_EVEN | EVENT_END, &received, 0));
+	HOST_TEST_CHECK_EQUAL(EVENT_EVEN, received);
+
+	// the flags set while the waiter runs are not lost
+	HOST_TEST_CHECK(OSAL_OK == OSAL_task_create(__event_setter, (uint8_t*)"setter", stack, 5, NULL, &setter));
+	do {
+		HOST_TEST_CHECK(OSAL_OK == OSAL_event_wait(&__event, EVENT_ODD | EVENT_EVEN | EVENT_END, &received, OSAL_INFINITE_TIME));
+	} while (0u == (received & EVENT_END));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_counter_semaphore_take(&__done, 2000));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_task_delete(&setter));
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(void) {
+	HOST_TEST_CHECK(OSAL_OK == OSAL_queue_create((uint8_t*)"queue", QUEUE_SIZE, &__queue));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_counter_semaphore_create((uint8_t*)"done", 0, 10, &__done));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_binary_semaphore_create((uint8_t*)"binary", 0, &__binary));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_mutex_create((uint8_t*)"mutex", &__mutex));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_event_create((uint8_t*)"event", &__event));
+
+	__test_timeouts();
+	__test_queue();
+	__test_mutex();
+	__test_tasks();
+	__test_events();
+
+	HOST_TEST_CHECK(OSAL_OK == OSAL_queue_delete(&__queue));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_counter_semaphore_delete(&__done));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_binary_semaphore_delete(&__binary));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_mutex_delete(&__mutex));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_event_delete(&__event));
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,327 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host test of the power governor decisions (power_governor.c): going
+ * up on a late frame, going down after the hold frames, touch boost, idle
+ * screen and energy accounting, replayed with synthetic frame times.
+ *
+ * The traces given on the command line (console trace of the governor inputs,
+ * see POWER_GOVERNOR_TRACE_ENABLED) are replayed with several policies: the
+ * frame times and CPU loads are converted from the level they were recorded at
+ * to the level chosen by the policy. The missed deadlines and the energy of
+ * each policy are printed.
+ *
+ * Usage: test_power_governor [<trace>...]
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "power_governor.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define LEVEL_SLOW (0u)
+#define LEVEL_FAST (1u)
+
+#define FRAME_PERIOD_US (16667)
+
+#define MAX_LINE (256u)
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+
+// an input of the governor read from a trace
+typedef struct {
+	char kind;          // 'F', 'T' or 'L'
+	int64_t time_us;
+	uint8_t level;      // level of the profile applied when the input was measured
+	uint32_t value1;    // render_us or load_percent
+	uint32_t value2;    // flush_us
+} test_event_t;
+
+// a policy replayed on the traces
+typedef struct {
+	const char* name;
+	uint8_t first_level;    // the levels of the policy in __levels
+	uint8_t level_count;
+	uint32_t target_load_percent;
+	uint32_t down_hold_frames;
+	uint32_t touch_boost_us;
+} test_policy_t;
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+// same levels and tuning as the target (power_governor_impl_FreeRTOS.c)
+static const power_governor_level_t __levels[] = {
+		{ 0x00, 50, 35 },
+		{ 0xFF, 100, 100 },
+};
+
+static const power_governor_config_t __config = {
+		.levels = __levels,
+		.level_count = sizeof(__levels) / sizeof(__levels[0]),
+		.frame_deadline_us = POWER_GOVERNOR_FRAME_DEADLINE_US,
+		.target_load_percent = POWER_GOVERNOR_TARGET_LOAD_PERCENT,
+		.down_hold_frames = POWER_GOVERNOR_DOWN_HOLD_FRAMES,
+		.touch_boost_us = POWER_GOVERNOR_TOUCH_BOOST_US,
+		.idle_timeout_us = POWER_GOVERNOR_IDLE_TIMEOUT_US,
+		.idle_load_percent = POWER_GOVERNOR_IDLE_LOAD_PERCENT,
+};
+
+static power_governor_t __governor;
+static int64_t __now_us;
+
+static const test_policy_t __policies[] = {
+		{ "slow", LEVEL_SLOW, 1, POWER_GOVERNOR_TARGET_LOAD_PERCENT, POWER_GOVERNOR_DOWN_HOLD_FRAMES, POWER_GOVERNOR_TOUCH_BOOST_US },
+		{ "fast", LEVEL_FAST, 1, POWER_GOVERNOR_TARGET_LOAD_PERCENT, POWER_GOVERNOR_DOWN_HOLD_FRAMES, POWER_GOVERNOR_TOUCH_BOOST_US },
+		{ "governor", LEVEL_SLOW, 2, POWER_GOVERNOR_TARGET_LOAD_PERCENT, POWER_GOVERNOR_DOWN_HOLD_FRAMES, POWER_GOVERNOR_TOUCH_BOOST_US },
+		{ "hold 10", LEVEL_SLOW, 2, POWER_GOVERNOR_TARGET_LOAD_PERCENT, 10, POWER_GOVERNOR_TOUCH_BOOST_US },
+		{ "target 70%", LEVEL_SLOW, 2, 70, POWER_GOVERNOR_DOWN_HOLD_FRAMES, POWER_GOVERNOR_TOUCH_BOOST_US },
+		{ "boost 0 ms", LEVEL_SLOW, 2, POWER_GOVERNOR_TARGET_LOAD_PERCENT, POWER_GOVERNOR_DOWN_HOLD_FRAMES, 0 },
+};
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+static uint8_t __frame(uint32_t render_us, uint32_t flush_us) {
+	__now_us += FRAME_PERIOD_US;
+	return power_governor_on_frame(&__governor, __now_us, render_us, flush_us);
+}
+
+static void __test_down_after_hold(void) {
+	power_governor_init(&__governor, &__config, LEVEL_FAST, __now_us);
+
+	// 5 ms at full speed takes 10 ms at half speed: fits in 85% of the deadline
+	for (uint32_t i = 1; i < POWER_GOVERNOR_DOWN_HOLD_FRAMES; i++) {
+		HOST_TEST_CHECK_EQUAL(LEVEL_FAST, __frame(4000, 1000));
+	}
+	HOST_TEST_CHECK_EQUAL(LEVEL_SLOW, __frame(4000, 1000));
+
+	// a frame that does not fit breaks the hold
+	power_governor_init(&__governor, &__config, LEVEL_FAST, __now_us);
+	for (uint32_t i = 1; i < POWER_GOVERNOR_DOWN_HOLD_FRAMES; i++) {
+		HOST_TEST_CHECK_EQUAL(LEVEL_FAST, __frame(4000, 1000));
+	}
+	HOST_TEST_CHECK_EQUAL(LEVEL_FAST, __frame(7000, 1000));
+	HOST_TEST_CHECK_EQUAL(LEVEL_FAST, __frame(4000, 1000));
+}
+
+static void __test_up_at_once(void) {
+	power_governor_stats_t stats;
+
+	power_governor_init(&__governor, &__config, LEVEL_SLOW, __now_us);
+	HOST_TEST_CHECK_EQUAL(LEVEL_SLOW, __frame(8000, 1000));
+	// 15 ms: in the deadline but over the target load
+	HOST_TEST_CHECK_EQUAL(LEVEL_FAST, __frame(14000, 1000));
+	power_governor_get_stats(&__governor, __now_us, &stats);
+	HOST_TEST_CHECK_EQUAL(2, stats.frames);
+	HOST_TEST_CHECK_EQUAL(0, stats.missed_deadlines);
+	HOST_TEST_CHECK_EQUAL(1, stats.level_switches);
+
+	HOST_TEST_CHECK_EQUAL(LEVEL_FAST, __frame(16000, 1000));
+	power_governor_get_stats(&__governor, __now_us, &stats);
+	HOST_TEST_CHECK_EQUAL(1, stats.missed_deadlines);
+}
+
+static void __test_touch_boost(void) {
+	power_governor_stats_t stats;
+
+	power_governor_init(&__governor, &__config, LEVEL_SLOW, __now_us);
+	HOST_TEST_CHECK_EQUAL(LEVEL_FAST, power_governor_on_touch(&__governor, __now_us));
+	int64_t boost_end_us = __now_us + POWER_GOVERNOR_TOUCH_BOOST_US;
+
+	// light frames do not count for the hold during the boost
+	while ((__now_us + FRAME_PERIOD_US) < boost_end_us) {
+		HOST_TEST_CHECK_EQUAL(LEVEL_FAST, __frame(1000, 1000));
+	}
+	for (uint32_t i = 1; i < POWER_GOVERNOR_DOWN_HOLD_FRAMES; i++) {
+		HOST_TEST_CHECK_EQUAL(LEVEL_FAST, __frame(1000, 1000));
+	}
+	HOST_TEST_CHECK_EQUAL(LEVEL_SLOW, __frame(1000, 1000));
+
+	power_governor_get_stats(&__governor, __now_us, &stats);
+	HOST_TEST_CHECK_EQUAL(1, stats.touch_boosts);
+	HOST_TEST_CHECK_EQUAL(2, stats.level_switches);
+
+	// no boost counted when already at the fastest level
+	(void)power_governor_on_touch(&__governor, __now_us);
+	(void)power_governor_on_touch(&__governor, __now_us);
+	power_governor_get_stats(&__governor, __now_us, &stats);
+	HOST_TEST_CHECK_EQUAL(2, stats.touch_boosts);
+}
+
+static void __test_idle(void) {
+	power_governor_init(&__governor, &__config, LEVEL_FAST, __now_us);
+	(void)__frame(1000, 1000);
+
+	// too early, then too loaded
+	HOST_TEST_CHECK_EQUAL(LEVEL_FAST, power_governor_on_load(&__governor, __now_us + POWER_GOVERNOR_IDLE_TIMEOUT_US - 1, 0));
+	HOST_TEST_CHECK_EQUAL(LEVEL_FAST, power_governor_on_load(&__governor, __now_us + POWER_GOVERNOR_IDLE_TIMEOUT_US, POWER_GOVERNOR_IDLE_LOAD_PERCENT));
+	HOST_TEST_CHECK_EQUAL(LEVEL_SLOW, power_governor_on_load(&__governor, __now_us + POWER_GOVERNOR_IDLE_TIMEOUT_US, POWER_GOVERNOR_IDLE_LOAD_PERCENT - 1));
+
+	// not during a touch boost
+	__now_us += POWER_GOVERNOR_IDLE_TIMEOUT_US;
+	(void)power_governor_on_touch(&__governor, __now_us);
+	HOST_TEST_CHECK_EQUAL(LEVEL_FAST, power_governor_on_load(&__governor, __now_us + POWER_GOVERNOR_TOUCH_BOOST_US - 1, 0));
+	HOST_TEST_CHECK_EQUAL(LEVEL_SLOW, power_governor_on_load(&__governor, __now_us + POWER_GOVERNOR_TOUCH_BOOST_US, 0));
+	__now_us += POWER_GOVERNOR_TOUCH_BOOST_US;
+}
+
+static void __test_energy(void) {
+	power_governor_stats_t stats;
+
+	power_governor_init(&__governor, &__config, LEVEL_FAST, __now_us);
+	// fast until the idle timeout (a busy sample in between), then 200 ms slow
+	(void)power_governor_on_load(&__governor, __now_us + 100000, 100);
+	HOST_TEST_CHECK_EQUAL(LEVEL_SLOW, power_governor_on_load(&__governor, __now_us + POWER_GOVERNOR_IDLE_TIMEOUT_US, 0));
+	power_governor_get_stats(&__governor, __now_us + POWER_GOVERNOR_IDLE_TIMEOUT_US + 200000, &stats);
+	HOST_TEST_CHECK_EQUAL((POWER_GOVERNOR_IDLE_TIMEOUT_US / 1000) * 100 + 200 * 35, stats.energy);
+}
+
+// reads the governor inputs of a console trace, the 32-bit times unwrapped
+static test_event_t* __read_trace(const char* path, uint32_t* count) {
+	char line[MAX_LINE];
+	uint32_t capacity = 1024;
+	test_event_t* events = malloc(capacity * sizeof(test_event_t));
+	uint32_t previous = 0;
+	int64_t time_us = 0;
+	FILE* file = fopen(path, "r");
+	HOST_TEST_CHECK(NULL != file);
+	HOST_TEST_CHECK(NULL != events);
+
+	*count = 0;
+	while (NULL != fgets(line, sizeof(line), file)) {
+		test_event_t event;
+		unsigned int time;
+		unsigned int level;
+		unsigned int value1 = 0;
+		unsigned int value2 = 0;
+		int fields = sscanf(line, "PG %c %u %u %u %u", &event.kind, &time, &level, &value1, &value2);
+		if (3 > fields) {
+			// another console output
+			continue;
+		}
+		HOST_TEST_CHECK(level < (sizeof(__levels) / sizeof(__levels[0])));
+		HOST_TEST_CHECK((('F' == event.kind) && (5 == fields)) || (('T' == event.kind) && (3 == fields)) || (('L' == event.kind) && (4 == fields)));
+		time_us = (0u == *count) ? (int64_t)time : (time_us + (uint32_t)(time - previous));
+		previous = time;
+		event.time_us = time_us;
+		event.level = (uint8_t)level;
+		event.value1 = value1;
+		event.value2 = value2;
+		if (*count == capacity) {
+			capacity *= 2u;
+			events = realloc(events, capacity * sizeof(test_event_t));
+			HOST_TEST_CHECK(NULL != events);
+		}
+		events[*count] = event;
+		(*count)++;
+	}
+	(void)fclose(file);
+	HOST_TEST_CHECK(0u < *count);
+	return events;
+}
+
+// a time measured at a level converted to another level
+static uint32_t __convert(uint32_t value, uint8_t from, uint32_t to_speed_percent) {
+	return (uint32_t)(((uint64_t)value * __levels[from].speed_percent) / to_speed_percent);
+}
+
+static void __replay(const test_event_t* events, uint32_t count, const test_policy_t* policy, power_governor_stats_t* stats) {
+	power_governor_config_t config = __config;
+	config.levels = &__levels[policy->first_level];
+	config.level_count = policy->level_count;
+	config.target_load_percent = policy->target_load_percent;
+	config.down_hold_frames = policy->down_hold_frames;
+	config.touch_boost_us = policy->touch_boost_us;
+
+	// boot profile: the fastest level
+	power_governor_t governor;
+	uint8_t level = config.level_count - 1u;
+	power_governor_init(&governor, &config, level, events[0].time_us);
+
+	for (uint32_t i = 0; i < count; i++) {
+		const test_event_t* event = &events[i];
+		uint32_t speed = config.levels[level].speed_percent;
+		if ('F' == event->kind) {
+			level = power_governor_on_frame(&governor, event->time_us, __convert(event->value1, event->level, speed),
+					__convert(event->value2, event->level, speed));
+		}
+		else if ('T' == event->kind) {
+			level = power_governor_on_touch(&governor, event->time_us);
+		}
+		else {
+			uint32_t load = __convert(event->value1, event->level, speed);
+			level = power_governor_on_load(&governor, event->time_us, (load > 100u) ? 100u : load);
+		}
+	}
+	power_governor_get_stats(&governor, events[count - 1u].time_us, stats);
+}
+
+static void __test_trace(const char* path) {
+	uint32_t count;
+	test_event_t* events = __read_trace(path, &count);
+	power_governor_stats_t stats[sizeof(__policies) / sizeof(__policies[0])];
+
+	(void)printf("%s: %.1f s\n", path, (double)(events[count - 1u].time_us - events[0].time_us) / 1e6);
+	(void)printf("  %-12s %8s %8s %10s %8s\n", "policy", "frames", "missed", "energy", "switches");
+	for (uint32_t p = 0; p < (sizeof(__policies) / sizeof(__policies[0])); p++) {
+		__replay(events, count, &__policies[p], &stats[p]);
+	}
+	// the energy relative to the fastest level
+	for (uint32_t p = 0; p < (sizeof(__policies) / sizeof(__policies[0])); p++) {
+		(void)printf("  %-12s %8u %8u %9.1f%% %8u\n", __policies[p].name, stats[p].frames, stats[p].missed_deadlines,
+				(100.0 * (double)stats[p].energy) / (double)stats[1].energy, stats[p].level_switches);
+	}
+
+	// any policy is between the fixed levels: energy and missed deadlines
+	for (uint32_t p = 2; p < (sizeof(__policies) / sizeof(__policies[0])); p++) {
+		HOST_TEST_CHECK(stats[p].energy >= stats[0].energy);
+		HOST_TEST_CHECK(stats[p].energy <= stats[1].energy);
+		HOST_TEST_CHECK(stats[p].missed_deadlines >= stats[1].missed_deadlines);
+		HOST_TEST_CHECK(stats[p].missed_deadlines <= stats[0].missed_deadlines);
+	}
+	free(events);
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(int argc, char* argv[]) {
+	__now_us = 1000000;
+
+	__test_down_after_hold();
+	__test_up_at_once();
+	__test_touch_boost();
+	__test_idle();
+	__test_energy();
+	for (int i = 1; i < argc; i++) {
+		__test_trace(argv[i]);
+	}
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
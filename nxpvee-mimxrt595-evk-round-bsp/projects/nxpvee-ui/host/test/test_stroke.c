@@ -0,0 +1,660 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host check of the stroke generation of the VGLite driver
+ * (vg_lite_update_stroke(): _flatten_path(), _create_stroke_path() and the
+ * conversion of the round joins and caps to quadratic curves).
+ *
+ * The outline of the stroke (its quadratic curves flattened) is compared with
+ * the exact center line of the path (its curves sampled every 0.1 pixel):
+ *
+ * - every point of the outline is at most at half the line width (the miter
+ * limit times half the line width for the miter joins) of the center line;
+ * - the points at less than half the line width of the center line are inside
+ * the outline (nonzero rule);
+ * - with round caps and joins, the stroke is the set of points at less than half
+ * the line width of the center line (of its dashes): the points around the
+ * center line are inside or outside the outline as expected.
+ *
+ * The stroke cache shares the stroke of the paths with the same data (in other
+ * buffers) and generates a new stroke when the data changes but not its length
+ * nor the stroke parameters: byte-identical to a fresh stroke of the new data.
+ *
+ * The largest errors are printed, followed by the throughput of the stroke
+ * generation (the stroke cache is purged before each stroke): the path
+ * segments and the outline segments per second.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "vg_lite.h"
+#include "host_test.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+// tessellation buffer of vg_lite_init() (unused: no drawing)
+#define TESSELLATION_SIZE (64)
+
+// distance between the samples of the center line (pixels)
+#define CENTER_STEP (0.1f)
+
+// distance between the tested points along the center line (pixels)
+#define PROBE_STEP (1.0f)
+
+// margin of the inside / outside checks (pixels): the flattening of the path
+// is allowed to move the outline by this distance
+#define MARGIN (0.25f)
+
+// largest distance of an outline point beyond half the line width (pixels)
+#define TOLERANCE (0.1f)
+
+// segments of a quadratic curve of the outline
+#define QUAD_STEPS (16)
+
+#define MAX_DATA_WORDS (64)
+#define MAX_CENTER_POINTS (16384)
+#define MAX_OUTLINE_POINTS (32768)
+#define MAX_OUTLINE_POLYGONS (256)
+
+// stroke generations of the benchmark
+#define BENCH_ITERATIONS (500)
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+
+typedef struct {
+	const char* name;
+	void (*build)(void);
+} test_path_t;
+
+typedef struct {
+	vg_lite_cap_style_t cap;
+	vg_lite_join_style_t join;
+	float width;
+	bool dashed;
+} test_stroke_t;
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+// the path data (FP32): one opcode byte in a 32-bit word, then the coordinates
+static uint32_t __data[MAX_DATA_WORDS];
+static uint32_t __data_words;
+static uint32_t __data_segments;
+static bool __closed;
+
+// the exact center line: samples and their distance along the path
+static float __center_x[MAX_CENTER_POINTS];
+static float __center_y[MAX_CENTER_POINTS];
+static float __center_s[MAX_CENTER_POINTS];
+static uint32_t __center_count;
+
+// the center line that is drawn (the dashes): __center_on[i] for the segment [i, i + 1]
+static bool __center_on[MAX_CENTER_POINTS];
+
+// the outline: closed polygons
+static float __outline_x[MAX_OUTLINE_POINTS];
+static float __outline_y[MAX_OUTLINE_POINTS];
+static uint32_t __outline_start[MAX_OUTLINE_POLYGONS + 1];
+static uint32_t __outline_polygons;
+static uint32_t __outline_segments;
+
+static float __dash[] = { 12.0f, 6.0f };
+
+// the largest errors of all the strokes
+static float __max_outside_error;
+static uint32_t __probes;
+
+// -----------------------------------------------------------------------------
+// Internal function definitions: the path and its center line
+// -----------------------------------------------------------------------------
+
+static void __add_op(uint8_t op) {
+	HOST_TEST_CHECK(__data_words < MAX_DATA_WORDS);
+	__data[__data_words] = op;
+	__data_words++;
+}
+
+static void __add_coordinate(float value) {
+	HOST_TEST_CHECK(__data_words < MAX_DATA_WORDS);
+	(void)memcpy(&__data[__data_words], &value, sizeof(value));
+	__data_words++;
+}
+
+static void __add_center_point(float x, float y) {
+	HOST_TEST_CHECK(__center_count < MAX_CENTER_POINTS);
+	float s = 0.0f;
+	if (0u != __center_count) {
+		uint32_t last = __center_count - 1u;
+		s = __center_s[last] + hypotf(x - __center_x[last], y - __center_y[last]);
+	}
+	__center_x[__center_count] = x;
+	__center_y[__center_count] = y;
+	__center_s[__center_count] = s;
+	__center_count++;
+}
+
+// samples a cubic curve (a quadratic or a line is given as a cubic)
+static void __add_center_curve(float x0, float y0, float x1, float y1, float x2, float y2, float x3, float y3) {
+	float length = hypotf(x1 - x0, y1 - y0) + hypotf(x2 - x1, y2 - y1) + hypotf(x3 - x2, y3 - y2);
+	uint32_t steps = (uint32_t)ceilf(length / CENTER_STEP);
+	for (uint32_t i = 1; i <= steps; i++) {
+		float t = (float)i / (float)steps;
+		float u = 1.0f - t;
+		float x = (u * u * u * x0) + (3.0f * u * u * t * x1) + (3.0f * u * t * t * x2) + (t * t * t * x3);
+		float y = (u * u * u * y0) + (3.0f * u * u * t * y1) + (3.0f * u * t * t * y2) + (t * t * t * y3);
+		__add_center_point(x, y);
+	}
+}
+
+static void __move(float x, float y) {
+	__data_words = 0;
+	__data_segments = 0;
+	__center_count = 0;
+	__closed = false;
+	__add_op(VLC_OP_MOVE);
+	__add_coordinate(x);
+	__add_coordinate(y);
+	__add_center_point(x, y);
+}
+
+static void __line(float x, float y) {
+	float x0 = __center_x[__center_count - 1u];
+	float y0 = __center_y[__center_count - 1u];
+	__add_op(VLC_OP_LINE);
+	__add_coordinate(x);
+	__add_coordinate(y);
+	__add_center_curve(x0, y0, x0 + ((x - x0) / 3.0f), y0 + ((y - y0) / 3.0f), x - ((x - x0) / 3.0f), y - ((y - y0) / 3.0f), x, y);
+	__data_segments++;
+}
+
+static void __quad(float cx, float cy, float x, float y) {
+	float x0 = __center_x[__center_count - 1u];
+	float y0 = __center_y[__center_count - 1u];
+	__add_op(VLC_OP_QUAD);
+	__add_coordinate(cx);
+	__add_coordinate(cy);
+	__add_coordinate(x);
+	__add_coordinate(y);
+	__add_center_curve(x0, y0, x0 + ((2.0f * (cx - x0)) / 3.0f), y0 + ((2.0f * (cy - y0)) / 3.0f),
+			x + ((2.0f * (cx - x)) / 3.0f), y + ((2.0f * (cy - y)) / 3.0f), x, y);
+	__data_segments++;
+}
+
+static void __cubic(float c1x, float c1y, float c2x, float c2y, float x, float y) {
+	float x0 = __center_x[__center_count - 1u];
+	float y0 = __center_y[__center_count - 1u];
+	__add_op(VLC_OP_CUBIC);
+	__add_coordinate(c1x);
+	__add_coordinate(c1y);
+	__add_coordinate(c2x);
+	__add_coordinate(c2y);
+	__add_coordinate(x);
+	__add_coordinate(y);
+	__add_center_curve(x0, y0, c1x, c1y, c2x, c2y, x, y);
+	__data_segments++;
+}
+
+// the stroker of the driver closes the path on VLC_OP_END (an open path has no
+// VLC_OP_END: its length stops before)
+static void __close(void) {
+	float x0 = __center_x[__center_count - 1u];
+	float y0 = __center_y[__center_count - 1u];
+	float x = __center_x[0];
+	float y = __center_y[0];
+	__add_op(VLC_OP_END);
+	if ((x != x0) || (y != y0)) {
+		__add_center_curve(x0, y0, x0 + ((x - x0) / 3.0f), y0 + ((y - y0) / 3.0f), x - ((x - x0) / 3.0f), y - ((y - y0) / 3.0f), x, y);
+		__data_segments++;
+	}
+	__closed = true;
+}
+
+// sharp corners (acute and obtuse)
+static void __build_polyline(void) {
+	__move(20.0f, 20.0f);
+	__line(120.0f, 30.0f);
+	__line(60.0f, 90.0f);
+	__line(150.0f, 140.0f);
+}
+
+static void __build_quad(void) {
+	__move(20.0f, 150.0f);
+	__quad(100.0f, 20.0f, 180.0f, 150.0f);
+}
+
+static void __build_cubic(void) {
+	__move(20.0f, 100.0f);
+	__cubic(60.0f, 0.0f, 140.0f, 200.0f, 180.0f, 100.0f);
+}
+
+// starts with a horizontal tangent then turns
+static void __build_cubic_horizontal(void) {
+	__move(20.0f, 100.0f);
+	__cubic(80.0f, 100.0f, 120.0f, 40.0f, 180.0f, 40.0f);
+}
+
+static void __build_rounded_rectangle(void) {
+	__move(40.0f, 20.0f);
+	__line(160.0f, 20.0f);
+	__quad(180.0f, 20.0f, 180.0f, 40.0f);
+	__line(180.0f, 160.0f);
+	__quad(180.0f, 180.0f, 160.0f, 180.0f);
+	__line(40.0f, 180.0f);
+	__quad(20.0f, 180.0f, 20.0f, 160.0f);
+	__line(20.0f, 40.0f);
+	__quad(20.0f, 20.0f, 40.0f, 20.0f);
+	__close();
+}
+
+static void __build_triangle(void) {
+	__move(100.0f, 20.0f);
+	__line(180.0f, 170.0f);
+	__line(20.0f, 170.0f);
+	__close();
+}
+
+static const test_path_t __paths[] = {
+	{ "polyline", __build_polyline },
+	{ "quad", __build_quad },
+	{ "cubic", __build_cubic },
+	{ "cubic horizontal", __build_cubic_horizontal },
+	{ "rounded rectangle", __build_rounded_rectangle },
+	{ "triangle", __build_triangle },
+};
+
+static const test_stroke_t __strokes[] = {
+	{ VG_LITE_CAP_ROUND, VG_LITE_JOIN_ROUND, 1.0f, false },
+	{ VG_LITE_CAP_ROUND, VG_LITE_JOIN_ROUND, 4.0f, false },
+	{ VG_LITE_CAP_ROUND, VG_LITE_JOIN_ROUND, 11.5f, false },
+	{ VG_LITE_CAP_ROUND, VG_LITE_JOIN_ROUND, 4.0f, true },
+	{ VG_LITE_CAP_ROUND, VG_LITE_JOIN_ROUND, 11.5f, true },
+	{ VG_LITE_CAP_BUTT, VG_LITE_JOIN_BEVEL, 4.0f, false },
+	{ VG_LITE_CAP_BUTT, VG_LITE_JOIN_BEVEL, 11.5f, false },
+	{ VG_LITE_CAP_BUTT, VG_LITE_JOIN_MITER, 4.0f, false },
+	{ VG_LITE_CAP_BUTT, VG_LITE_JOIN_MITER, 11.5f, false },
+	{ VG_LITE_CAP_BUTT, VG_LITE_JOIN_ROUND, 4.0f, true },
+};
+
+// the miter limit of the strokes
+#define MITER_LIMIT (4.0f)
+
+static void __set_dashes(bool dashed) {
+	float period = __dash[0] + __dash[1];
+	for (uint32_t i = 0; (i + 1u) < __center_count; i++) {
+		float s = (__center_s[i] + __center_s[i + 1u]) / 2.0f;
+		__center_on[i] = !dashed || (fmodf(s, period) < __dash[0]);
+	}
+}
+
+// distance to the center line (to its dashes only when on_only)
+static float __distance_to_center(float x, float y, bool on_only) {
+	float best = INFINITY;
+	for (uint32_t i = 0; (i + 1u) < __center_count; i++) {
+		if (on_only && !__center_on[i]) {
+			continue;
+		}
+		float ax = __center_x[i];
+		float ay = __center_y[i];
+		float dx = __center_x[i + 1u] - ax;
+		float dy = __center_y[i + 1u] - ay;
+		float length2 = (dx * dx) + (dy * dy);
+		float t = (length2 > 0.0f) ? ((((x - ax) * dx) + ((y - ay) * dy)) / length2) : 0.0f;
+		t = (t < 0.0f) ? 0.0f : ((t > 1.0f) ? 1.0f : t);
+		float d = hypotf(x - (ax + (t * dx)), y - (ay + (t * dy)));
+		best = (d < best) ? d : best;
+	}
+	return best;
+}
+
+// -----------------------------------------------------------------------------
+// Internal function definitions: the outline
+// -----------------------------------------------------------------------------
+
+static void __add_outline_point(float x, float y) {
+	HOST_TEST_CHECK(__outline_start[__outline_polygons] < MAX_OUTLINE_POINTS);
+	__outline_x[__outline_start[__outline_polygons]] = x;
+	__outline_y[__outline_start[__outline_polygons]] = y;
+	__outline_start[__outline_polygons]++;
+}
+
+static void __end_outline_polygon(void) {
+	HOST_TEST_CHECK(__outline_polygons < MAX_OUTLINE_POLYGONS);
+	__outline_polygons++;
+	__outline_start[__outline_polygons] = __outline_start[__outline_polygons - 1u];
+}
+
+static float __get_float(const uint8_t* data, uint32_t* offset) {
+	float value;
+	(void)memcpy(&value, data + *offset, sizeof(value));
+	*offset += sizeof(value);
+	return value;
+}
+
+// flattens the stroke path: one opcode byte, the coordinates aligned on 32 bits
+static void __read_outline(const vg_lite_path_t* path) {
+	const uint8_t* data = (const uint8_t*)path->stroke_path_data;
+	uint32_t offset = 0;
+	bool end = false;
+	float x = 0.0f;
+	float y = 0.0f;
+
+	__outline_polygons = 0;
+	__outline_start[0] = 0;
+	__outline_segments = 0;
+	while (!end && (offset < path->stroke_path_size)) {
+		uint8_t op = data[offset];
+		offset++;
+		if ((VLC_OP_MOVE == op) || (VLC_OP_LINE == op) || (VLC_OP_QUAD == op)) {
+			offset = (offset + 3u) & ~3u;
+		}
+		switch (op) {
+		case VLC_OP_END:
+		case VLC_OP_CLOSE:
+			__end_outline_polygon();
+			end = (VLC_OP_END == op);
+			break;
+		case VLC_OP_MOVE:
+			x = __get_float(data, &offset);
+			y = __get_float(data, &offset);
+			__add_outline_point(x, y);
+			break;
+		case VLC_OP_LINE:
+			x = __get_float(data, &offset);
+			y = __get_float(data, &offset);
+			__add_outline_point(x, y);
+			__outline_segments++;
+			break;
+		case VLC_OP_QUAD: {
+			float cx = __get_float(data, &offset);
+			float cy = __get_float(data, &offset);
+			float x1 = __get_float(data, &offset);
+			float y1 = __get_float(data, &offset);
+			for (uint32_t i = 1; i <= QUAD_STEPS; i++) {
+				float t = (float)i / (float)QUAD_STEPS;
+				float u = 1.0f - t;
+				__add_outline_point((u * u * x) + (2.0f * u * t * cx) + (t * t * x1), (u * u * y) + (2.0f * u * t * cy) + (t * t * y1));
+			}
+			x = x1;
+			y = y1;
+			__outline_segments++;
+			break;
+		}
+		default:
+			(void)fprintf(stderr, "unexpected stroke opcode %u at %u\n", op, offset - 1u);
+			HOST_TEST_CHECK(false);
+			break;
+		}
+	}
+	HOST_TEST_CHECK(end);
+}
+
+// winding number of the outline around a point (the polygons are closed)
+static int32_t __winding(float x, float y) {
+	int32_t winding = 0;
+	for (uint32_t p = 0; p < __outline_polygons; p++) {
+		uint32_t start = (0u == p) ? 0u : __outline_start[p - 1u];
+		uint32_t end = __outline_start[p];
+		for (uint32_t i = start; i < end; i++) {
+			uint32_t j = ((i + 1u) < end) ? (i + 1u) : start;
+			float x0 = __outline_x[i];
+			float y0 = __outline_y[i];
+			float x1 = __outline_x[j];
+			float y1 = __outline_y[j];
+			float side = ((x1 - x0) * (y - y0)) - ((x - x0) * (y1 - y0));
+			if ((y0 <= y) && (y1 > y) && (side > 0.0f)) {
+				winding++;
+			}
+			else if ((y0 > y) && (y1 <= y) && (side < 0.0f)) {
+				winding--;
+			}
+		}
+	}
+	return winding;
+}
+
+static void __check_inside(float x, float y, bool expected, const char* name) {
+	bool inside = (0 != __winding(x, y));
+	if (inside != expected) {
+		(void)fprintf(stderr, "%s: (%.2f, %.2f) expected %s the stroke\n", name, x, y, expected ? "inside" : "outside");
+		HOST_TEST_CHECK(inside == expected);
+	}
+	__probes++;
+}
+
+// -----------------------------------------------------------------------------
+// Internal function definitions: the checks
+// -----------------------------------------------------------------------------
+
+static void __check_stroke(const test_path_t* test_path, const test_stroke_t* stroke) {
+	vg_lite_path_t path;
+	char name[128];
+	float half_width = stroke->width / 2.0f;
+
+	test_path->build();
+	(void)snprintf(name, sizeof(name), "%s, width %.1f, cap %d, join %d%s", test_path->name, stroke->width, stroke->cap,
+			stroke->join, stroke->dashed ? ", dashed" : "");
+
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_init_path(&path, VG_LITE_FP32, VG_LITE_HIGH,
+			__data_words * sizeof(uint32_t), __data, 0.0f, 0.0f, 200.0f, 200.0f));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_set_stroke(&path, stroke->cap, stroke->join, stroke->width, MITER_LIMIT,
+			stroke->dashed ? __dash : NULL, stroke->dashed ? 2u : 0u, 0.0f, 0xff000000u));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_update_stroke(&path));
+	__read_outline(&path);
+	__set_dashes(stroke->dashed);
+
+	// the outline is around the center line
+	float bound = half_width;
+	if (VG_LITE_JOIN_MITER == stroke->join) {
+		bound *= MITER_LIMIT;
+	}
+	float max_error = -INFINITY;
+	for (uint32_t i = 0; i < __outline_start[__outline_polygons]; i++) {
+		float error = __distance_to_center(__outline_x[i], __outline_y[i], false) - bound;
+		max_error = (error > max_error) ? error : max_error;
+	}
+	if (max_error > TOLERANCE) {
+		(void)fprintf(stderr, "%s: an outline point is %.3f pixels beyond the stroke\n", name, max_error);
+		HOST_TEST_CHECK(max_error <= TOLERANCE);
+	}
+	if (VG_LITE_JOIN_MITER != stroke->join) {
+		__max_outside_error = (max_error > __max_outside_error) ? max_error : __max_outside_error;
+	}
+
+	// the points around the center line (its dashes)
+	bool minkowski = (VG_LITE_CAP_ROUND == stroke->cap) && (VG_LITE_JOIN_ROUND == stroke->join);
+	float s_end = __center_s[__center_count - 1u];
+	float next_probe = 0.0f;
+	for (uint32_t i = 0; (i + 1u) < __center_count; i++) {
+		if (__center_s[i] < next_probe) {
+			continue;
+		}
+		next_probe += PROBE_STEP;
+
+		float x = __center_x[i];
+		float y = __center_y[i];
+		float dx = __center_x[i + 1u] - x;
+		float dy = __center_y[i + 1u] - y;
+		float length = hypotf(dx, dy);
+		if (0.0f == length) {
+			continue;
+		}
+		float nx = -dy / length;
+		float ny = dx / length;
+
+		if (minkowski) {
+			// the stroke is the set of points at less than half the width of the drawn center line
+			static const float offsets[] = { 0.0f, -0.5f, 0.5f, -1.5f, 1.5f };
+			for (uint32_t k = 0; k < (sizeof(offsets) / sizeof(offsets[0])); k++) {
+				float px = x + (nx * offsets[k] * half_width);
+				float py = y + (ny * offsets[k] * half_width);
+				float d = __distance_to_center(px, py, true);
+				if (d < (half_width - MARGIN)) {
+					__check_inside(px, py, true, name);
+				}
+				else if (d > (half_width + MARGIN)) {
+					__check_inside(px, py, false, name);
+				}
+			}
+		}
+		else if (!stroke->dashed && (__closed || ((__center_s[i] > MARGIN) && (__center_s[i] < (s_end - MARGIN))))) {
+			// the rectangle of each segment is drawn whatever the caps and joins
+			float offset = half_width - MARGIN;
+			if (offset > 0.0f) {
+				__check_inside(x + (nx * offset), y + (ny * offset), true, name);
+				__check_inside(x - (nx * offset), y - (ny * offset), true, name);
+			}
+		}
+	}
+
+	(void)printf("%-64s %5u outline segments, max distance beyond half the width: %+.3f\n", name, __outline_segments, max_error);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_clear_path(&path));
+}
+
+static void __stroke(vg_lite_path_t* path, uint32_t* data, const test_stroke_t* stroke) {
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_init_path(path, VG_LITE_FP32, VG_LITE_HIGH,
+			__data_words * sizeof(uint32_t), data, 0.0f, 0.0f, 200.0f, 200.0f));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_set_stroke(path, stroke->cap, stroke->join, stroke->width, MITER_LIMIT,
+			stroke->dashed ? __dash : NULL, stroke->dashed ? 2u : 0u, 0.0f, 0xff000000u));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_update_stroke(path));
+}
+
+static void __test_cache(void) {
+	static const test_stroke_t stroke = { VG_LITE_CAP_ROUND, VG_LITE_JOIN_ROUND, 4.0f, true };
+	static uint32_t data[2][MAX_DATA_WORDS];
+	static uint8_t expected[MAX_OUTLINE_POINTS];
+	vg_lite_path_t cached;
+	vg_lite_path_t path;
+	vg_lite_stroke_cache_stats_t stats;
+
+	__build_cubic();
+	(void)memcpy(data[0], __data, sizeof(__data));
+	(void)memcpy(data[1], __data, sizeof(__data));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_purge_stroke_cache());
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_get_stroke_cache_stats(&stats, 1));
+
+	// the same data in another buffer: the cached stroke
+	__stroke(&cached, data[0], &stroke);
+	__stroke(&path, data[1], &stroke);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_get_stroke_cache_stats(&stats, 0));
+	HOST_TEST_CHECK_EQUAL(1, stats.misses);
+	HOST_TEST_CHECK_EQUAL(1, stats.hits);
+	HOST_TEST_CHECK(path.stroke_path_data == cached.stroke_path_data);
+	// the copy of the path data and of the dash pattern is part of the budget
+	HOST_TEST_CHECK_EQUAL((uint32_t)cached.stroke_path_size + (__data_words * sizeof(uint32_t)) + sizeof(__dash), stats.bytes);
+
+	// another end point, same length and parameters: a new stroke, not the cached one
+	float x = 170.0f;
+	(void)memcpy(&data[1][__data_words - 2u], &x, sizeof(x));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_update_stroke(&path));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_get_stroke_cache_stats(&stats, 0));
+	HOST_TEST_CHECK_EQUAL(2, stats.misses);
+	HOST_TEST_CHECK_EQUAL(1, stats.hits);
+	HOST_TEST_CHECK(path.stroke_path_data != cached.stroke_path_data);
+	HOST_TEST_CHECK((size_t)path.stroke_path_size <= sizeof(expected));
+	int32_t size = path.stroke_path_size;
+	(void)memcpy(expected, path.stroke_path_data, (size_t)size);
+
+	// byte-identical to a fresh stroke of the new data (not in the cache)
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_clear_path(&path));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_purge_stroke_cache());
+	__stroke(&path, data[1], &stroke);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_get_stroke_cache_stats(&stats, 0));
+	HOST_TEST_CHECK_EQUAL(3, stats.misses);
+	HOST_TEST_CHECK_EQUAL(size, path.stroke_path_size);
+	HOST_TEST_CHECK(0 == memcmp(expected, path.stroke_path_data, (size_t)size));
+
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_clear_path(&path));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_clear_path(&cached));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_purge_stroke_cache());
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_get_stroke_cache_stats(&stats, 0));
+	HOST_TEST_CHECK_EQUAL(0, stats.entries);
+	HOST_TEST_CHECK_EQUAL(0, stats.bytes);
+}
+
+static void __bench(const test_path_t* test_path, const test_stroke_t* stroke) {
+	vg_lite_path_t path;
+	uint64_t elapsed = 0;
+	uint64_t outline_segments = 0;
+	vg_lite_stroke_cache_stats_t stats;
+
+	test_path->build();
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_get_stroke_cache_stats(&stats, 1));
+	for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+		// a new stroke each time: not the cached one
+		HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_purge_stroke_cache());
+		HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_init_path(&path, VG_LITE_FP32, VG_LITE_HIGH,
+				__data_words * sizeof(uint32_t), __data, 0.0f, 0.0f, 200.0f, 200.0f));
+		HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_set_stroke(&path, stroke->cap, stroke->join, stroke->width, MITER_LIMIT,
+				stroke->dashed ? __dash : NULL, stroke->dashed ? 2u : 0u, 0.0f, 0xff000000u));
+
+		uint64_t start = HOST_TEST_now_ns();
+		HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_update_stroke(&path));
+		elapsed += HOST_TEST_now_ns() - start;
+
+		__read_outline(&path);
+		outline_segments += __outline_segments;
+		HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_clear_path(&path));
+	}
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_get_stroke_cache_stats(&stats, 0));
+	HOST_TEST_CHECK_EQUAL(0, stats.hits);
+
+	double seconds = (double)elapsed / 1e9;
+	(void)printf("bench %-18s width %4.1f%s: %8.2f us per stroke, %10.0f path segments/s, %10.0f outline segments/s\n",
+			test_path->name, stroke->width, stroke->dashed ? " dashed" : "       ", (seconds * 1e6) / BENCH_ITERATIONS,
+			((double)__data_segments * BENCH_ITERATIONS) / seconds, (double)outline_segments / seconds);
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(void) {
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_init(TESSELLATION_SIZE, TESSELLATION_SIZE));
+
+	__max_outside_error = -INFINITY;
+	for (uint32_t p = 0; p < (sizeof(__paths) / sizeof(__paths[0])); p++) {
+		for (uint32_t s = 0; s < (sizeof(__strokes) / sizeof(__strokes[0])); s++) {
+			__check_stroke(&__paths[p], &__strokes[s]);
+		}
+	}
+	(void)printf("%u points checked, largest distance of an outline point beyond half the width: %+.3f pixels\n",
+			__probes, __max_outside_error);
+
+	__test_cache();
+
+	static const test_stroke_t bench_strokes[] = {
+		{ VG_LITE_CAP_ROUND, VG_LITE_JOIN_ROUND, 4.0f, false },
+		{ VG_LITE_CAP_ROUND, VG_LITE_JOIN_ROUND, 4.0f, true },
+	};
+	for (uint32_t p = 0; p < (sizeof(__paths) / sizeof(__paths[0])); p++) {
+		for (uint32_t s = 0; s < (sizeof(bench_strokes) / sizeof(bench_strokes[0])); s++) {
+			__bench(&__paths[p], &bench_strokes[s]);
+		}
+	}
+
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_close());
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,535 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host test and benchmark of the tessellation window sizing:
+ *
+ * - tess_tuner_on_frame(): the window grows to cover a split drawing when it
+ * saves passes, is kept under TESS_TUNER_MAX_BYTES by tessellating the drawing
+ * by horizontal bands, shrinks to the largest drawing after shrink_hold_frames
+ * frames without split drawing, and stays between the limits; the statistics;
+ * - vg_lite_get_tessellation_stats(): the workloads (a full screen disc, a watch
+ * face, icons) are drawn on the software VGLite HAL with the 1 MB VGLite heap of
+ * the target at each window size. The passes of each drawing (one per window
+ * covering its bounding box, clipped to the target) are compared with the ones
+ * reported by the driver, the buffer size with tess_tuner_bytes(). The passes
+ * and the buffer size of each window are printed;
+ * - the tuner fed by the driver statistics of the watch face, as
+ * DISPLAY_VGLITE_frame_done() does.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "tess_tuner.h"
+#include "vg_lite.h"
+#include "vg_lite_platform.h"
+#include "host_test.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define KB (1024u)
+
+// VGLite heap of the target (LLUI_DISPLAY_impl.c)
+#define VGLITE_HEAP_SIZE (0x100000u)
+
+// the round display
+#define WIDTH (FRAME_BUFFER_WIDTH)
+#define HEIGHT (FRAME_BUFFER_HEIGHT)
+
+// points of the polygon of a disc
+#define DISC_POINTS (48)
+
+// radius of the disc path
+#define DISC_RADIUS (32)
+
+#define MAX_DRAWINGS (64)
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+
+typedef struct {
+	vg_lite_path_t* path;
+	vg_lite_matrix_t matrix;
+} test_drawing_t;
+
+typedef struct {
+	const char* name;
+	void (*build)(void);
+} test_workload_t;
+
+typedef struct {
+	uint32_t width;
+	uint32_t height;
+} test_window_t;
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+static uint16_t __pixels[WIDTH * HEIGHT];
+static vg_lite_buffer_t __target;
+
+// a disc around (0, 0)
+static int16_t __disc_data[(DISC_POINTS * 3) + 2];
+static vg_lite_path_t __disc;
+
+// a hand: a rectangle from (0, -1) to (32, 1)
+static const int16_t __hand_data[] = {
+	VLC_OP_MOVE, 0, -1,
+	VLC_OP_LINE, 32, -1,
+	VLC_OP_LINE, 32, 1,
+	VLC_OP_LINE, 0, 1,
+	VLC_OP_CLOSE,
+	VLC_OP_END,
+};
+static vg_lite_path_t __hand;
+
+// the drawings of the workload
+static test_drawing_t __drawings[MAX_DRAWINGS];
+static uint32_t __drawing_count;
+
+// the limits of the target (tess_tuner_configuration.h)
+static const tess_tuner_config_t __config = {
+		.min_size = TESS_TUNER_MIN_SIZE,
+		.max_width = TESS_TUNER_MAX_WIDTH,
+		.max_height = TESS_TUNER_MAX_HEIGHT,
+		.max_bytes = TESS_TUNER_MAX_BYTES,
+		.shrink_hold_frames = TESS_TUNER_SHRINK_HOLD_FRAMES,
+};
+
+// -----------------------------------------------------------------------------
+// Internal function definitions: tuner
+// -----------------------------------------------------------------------------
+
+// replays a frame with a drawing of this size, split or not in the current window
+static void __frame(tess_tuner_t* tuner, uint32_t draw_width, uint32_t draw_height, uint32_t* width, uint32_t* height) {
+	uint32_t passes = ((draw_width + tuner->width - 1u) / tuner->width) * ((draw_height + tuner->height - 1u) / tuner->height);
+	tess_tuner_on_frame(tuner, 1, passes, (passes > 1u) ? 1u : 0u, passes, draw_width, draw_height, width, height);
+}
+
+static void __test_bytes(void) {
+	// 8 bytes per pixel, the stride aligned on 64 bytes and the height on 16 lines,
+	// plus 1 bit per 64 bytes aligned on 64 bytes
+	HOST_TEST_CHECK_EQUAL((64u * 64u * 8u) + 64u, tess_tuner_bytes(64, 64));
+	HOST_TEST_CHECK_EQUAL((256u * 256u * 8u) + 1024u, tess_tuner_bytes(256, 256));
+	HOST_TEST_CHECK_EQUAL(tess_tuner_bytes(64, 64), tess_tuner_bytes(57, 50));
+	HOST_TEST_CHECK_EQUAL((400u * 144u * 8u) + 960u, tess_tuner_bytes(400, 144));
+	// the window that covers the display does not fit in the budget
+	HOST_TEST_CHECK(tess_tuner_bytes(TESS_TUNER_MAX_WIDTH, TESS_TUNER_MAX_HEIGHT) > TESS_TUNER_MAX_BYTES);
+	HOST_TEST_CHECK(tess_tuner_bytes(256, 256) > TESS_TUNER_MAX_BYTES);
+}
+
+static void __test_grow(void) {
+	tess_tuner_t tuner;
+	uint32_t width;
+	uint32_t height;
+
+	// a drawing that fits: nothing changes
+	tess_tuner_init(&tuner, &__config, 256, 256);
+	__frame(&tuner, 200, 256, &width, &height);
+	HOST_TEST_CHECK_EQUAL(256, width);
+	HOST_TEST_CHECK_EQUAL(256, height);
+
+	// a split drawing: the smallest window that covers it (16-pixel granule)
+	__frame(&tuner, 300, 100, &width, &height);
+	HOST_TEST_CHECK_EQUAL(304, width);
+	HOST_TEST_CHECK_EQUAL(112, height);
+
+	// the full screen does not fit in TESS_TUNER_MAX_BYTES: the window keeps the
+	// width of the drawing and takes the smallest height of the same number of
+	// bands (392 / 3 -> 144, 400x160 would fit but also takes 3 bands)
+	__frame(&tuner, WIDTH, HEIGHT, &width, &height);
+	HOST_TEST_CHECK_EQUAL(TESS_TUNER_MAX_WIDTH, width);
+	HOST_TEST_CHECK_EQUAL(144, height);
+	HOST_TEST_CHECK(tess_tuner_bytes(width, height) <= TESS_TUNER_MAX_BYTES);
+	HOST_TEST_CHECK(tess_tuner_bytes(width, 176) > TESS_TUNER_MAX_BYTES);
+
+	// no grow when the new window does not save passes (3 bands both)
+	tess_tuner_init(&tuner, &__config, 400, 160);
+	__frame(&tuner, WIDTH, HEIGHT, &width, &height);
+	HOST_TEST_CHECK_EQUAL(400, width);
+	HOST_TEST_CHECK_EQUAL(160, height);
+
+	tess_tuner_stats_t stats;
+	tess_tuner_get_stats(&tuner, &stats);
+	HOST_TEST_CHECK_EQUAL(0, stats.grows);
+	HOST_TEST_CHECK_EQUAL(1, stats.split_draws);
+	HOST_TEST_CHECK_EQUAL(3, stats.max_passes);
+
+	// a window smaller than the minimum (given at startup) and a tiny split drawing
+	tess_tuner_init(&tuner, &__config, 16, 16);
+	__frame(&tuner, 20, 20, &width, &height);
+	HOST_TEST_CHECK_EQUAL(TESS_TUNER_MIN_SIZE, width);
+	HOST_TEST_CHECK_EQUAL(TESS_TUNER_MIN_SIZE, height);
+
+	// a drawing larger than the display (not clipped): clamped to the largest window
+	tess_tuner_init(&tuner, &__config, 64, 64);
+	__frame(&tuner, 1000, 40, &width, &height);
+	HOST_TEST_CHECK_EQUAL(TESS_TUNER_MAX_WIDTH, width);
+	HOST_TEST_CHECK_EQUAL(TESS_TUNER_MIN_SIZE, height);
+}
+
+static void __test_banding(void) {
+	static const tess_tuner_config_t config = {
+			.min_size = 64,
+			.max_width = 400,
+			.max_height = 400,
+			.max_bytes = 100 * KB,
+			.shrink_hold_frames = 1,
+	};
+	tess_tuner_t tuner;
+	uint32_t width;
+	uint32_t height;
+
+	// 400 * 8 bytes per line: 32 lines fit in 100 KB, but the height cannot go
+	// below the minimum: then the width is reduced too
+	tess_tuner_init(&tuner, &config, 64, 64);
+	__frame(&tuner, 400, 400, &width, &height);
+	HOST_TEST_CHECK_EQUAL(64, height);
+	HOST_TEST_CHECK(tess_tuner_bytes(width, height) <= config.max_bytes);
+	HOST_TEST_CHECK(tess_tuner_bytes(width + 16u, height) > config.max_bytes);
+	HOST_TEST_CHECK_EQUAL(192, width);
+
+	// a band of the same number of passes with the smallest height
+	tess_tuner_init(&tuner, &config, 64, 64);
+	__frame(&tuner, 150, 200, &width, &height);
+	HOST_TEST_CHECK_EQUAL(160, width);
+	// 160x80 is just over the budget (cache level included): 4 bands of 64 lines
+	HOST_TEST_CHECK_EQUAL(64, height);
+	HOST_TEST_CHECK(tess_tuner_bytes(width, 80) > config.max_bytes);
+	HOST_TEST_CHECK(tess_tuner_bytes(width, height) <= config.max_bytes);
+}
+
+static void __test_shrink(void) {
+	tess_tuner_t tuner;
+	uint32_t width;
+	uint32_t height;
+
+	tess_tuner_init(&tuner, &__config, 400, 144);
+
+	// kept during shrink_hold_frames frames, then the largest drawing of these frames
+	for (uint32_t i = 1; i < TESS_TUNER_SHRINK_HOLD_FRAMES; i++) {
+		__frame(&tuner, (10u == i) ? 130u : 40u, (20u == i) ? 90u : 40u, &width, &height);
+		HOST_TEST_CHECK_EQUAL(400, width);
+		HOST_TEST_CHECK_EQUAL(144, height);
+	}
+	__frame(&tuner, 40, 40, &width, &height);
+	HOST_TEST_CHECK_EQUAL(144, width);
+	HOST_TEST_CHECK_EQUAL(96, height);
+
+	// a split drawing restarts the window (and grows)
+	for (uint32_t i = 1; i < TESS_TUNER_SHRINK_HOLD_FRAMES; i++) {
+		__frame(&tuner, 40, 40, &width, &height);
+	}
+	__frame(&tuner, 200, 60, &width, &height);
+	HOST_TEST_CHECK_EQUAL(208, width);
+	HOST_TEST_CHECK_EQUAL(TESS_TUNER_MIN_SIZE, height);
+	for (uint32_t i = 1; i < TESS_TUNER_SHRINK_HOLD_FRAMES; i++) {
+		__frame(&tuner, 10, 10, &width, &height);
+		HOST_TEST_CHECK_EQUAL(208, width);
+	}
+	// down to the minimum
+	__frame(&tuner, 10, 10, &width, &height);
+	HOST_TEST_CHECK_EQUAL(TESS_TUNER_MIN_SIZE, width);
+	HOST_TEST_CHECK_EQUAL(TESS_TUNER_MIN_SIZE, height);
+
+	tess_tuner_stats_t stats;
+	tess_tuner_get_stats(&tuner, &stats);
+	HOST_TEST_CHECK_EQUAL(1, stats.grows);
+	HOST_TEST_CHECK_EQUAL(2, stats.shrinks);
+	HOST_TEST_CHECK_EQUAL(3u * TESS_TUNER_SHRINK_HOLD_FRAMES, stats.frames);
+	HOST_TEST_CHECK_EQUAL(3u * TESS_TUNER_SHRINK_HOLD_FRAMES, stats.draws);
+	HOST_TEST_CHECK_EQUAL(1, stats.split_draws);
+	HOST_TEST_CHECK_EQUAL(TESS_TUNER_MIN_SIZE, stats.width);
+	HOST_TEST_CHECK_EQUAL(tess_tuner_bytes(TESS_TUNER_MIN_SIZE, TESS_TUNER_MIN_SIZE), stats.bytes);
+
+	// the window actually applied
+	tess_tuner_set_size(&tuner, 128, 128);
+	__frame(&tuner, 100, 100, &width, &height);
+	HOST_TEST_CHECK_EQUAL(128, width);
+	HOST_TEST_CHECK_EQUAL(128, height);
+}
+
+// -----------------------------------------------------------------------------
+// Internal function definitions: workloads
+// -----------------------------------------------------------------------------
+
+static void __build_paths(void) {
+	uint32_t index = 0;
+	for (uint32_t i = 0; i < DISC_POINTS; i++) {
+		float angle = (6.2831853f * (float)i) / (float)DISC_POINTS;
+		__disc_data[index] = (0u == i) ? VLC_OP_MOVE : VLC_OP_LINE;
+		__disc_data[index + 1u] = (int16_t)lroundf((float)DISC_RADIUS * cosf(angle));
+		__disc_data[index + 2u] = (int16_t)lroundf((float)DISC_RADIUS * sinf(angle));
+		index += 3u;
+	}
+	__disc_data[index] = VLC_OP_CLOSE;
+	__disc_data[index + 1u] = VLC_OP_END;
+
+	(void)memset(&__disc, 0, sizeof(__disc));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_init_path(&__disc, VG_LITE_S16, VG_LITE_HIGH, sizeof(__disc_data), __disc_data,
+			-DISC_RADIUS, -DISC_RADIUS, DISC_RADIUS, DISC_RADIUS));
+	(void)memset(&__hand, 0, sizeof(__hand));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_init_path(&__hand, VG_LITE_S16, VG_LITE_HIGH, sizeof(__hand_data), (void*)__hand_data,
+			0.0f, -1.0f, 32.0f, 1.0f));
+}
+
+static void __add_disc(float x, float y, float radius) {
+	HOST_TEST_CHECK(__drawing_count < MAX_DRAWINGS);
+	test_drawing_t* drawing = &__drawings[__drawing_count];
+	drawing->path = &__disc;
+	vg_lite_identity(&drawing->matrix);
+	vg_lite_translate(x, y, &drawing->matrix);
+	vg_lite_scale(radius / (float)DISC_RADIUS, radius / (float)DISC_RADIUS, &drawing->matrix);
+	__drawing_count++;
+}
+
+static void __add_hand(float length, float thickness, float angle) {
+	HOST_TEST_CHECK(__drawing_count < MAX_DRAWINGS);
+	test_drawing_t* drawing = &__drawings[__drawing_count];
+	drawing->path = &__hand;
+	vg_lite_identity(&drawing->matrix);
+	vg_lite_translate((float)WIDTH / 2.0f, (float)HEIGHT / 2.0f, &drawing->matrix);
+	vg_lite_rotate(angle, &drawing->matrix);
+	vg_lite_scale(length / 32.0f, thickness / 2.0f, &drawing->matrix);
+	__drawing_count++;
+}
+
+// a disc that covers the display
+static void __build_full_screen_disc(void) {
+	__add_disc((float)WIDTH / 2.0f, (float)HEIGHT / 2.0f, (float)WIDTH / 2.0f);
+}
+
+// the dial, the hour marks, the hands and their axis
+static void __build_watch_face(void) {
+	__add_disc((float)WIDTH / 2.0f, (float)HEIGHT / 2.0f, (float)WIDTH / 2.0f);
+	for (uint32_t i = 0; i < 12u; i++) {
+		float angle = (6.2831853f * (float)i) / 12.0f;
+		__add_disc(((float)WIDTH / 2.0f) + (170.0f * cosf(angle)), ((float)HEIGHT / 2.0f) + (170.0f * sinf(angle)), 6.0f);
+	}
+	__add_hand(100.0f, 8.0f, 40.0f);
+	__add_hand(150.0f, 6.0f, 160.0f);
+	__add_hand(175.0f, 2.0f, 260.0f);
+	__add_disc((float)WIDTH / 2.0f, (float)HEIGHT / 2.0f, 10.0f);
+}
+
+// a grid of 40 icons
+static void __build_icons(void) {
+	for (uint32_t i = 0; i < 40u; i++) {
+		__add_disc(56.0f + ((float)(i % 8u) * 40.0f), 116.0f + ((float)(i / 8u) * 40.0f), 16.0f);
+	}
+}
+
+// the passes of a drawing, as counted by the driver: the bounding box of the
+// path transformed and clipped to the target, one pass per window covering it
+static uint32_t __passes(const test_drawing_t* drawing, uint32_t width, uint32_t height, uint32_t* box_width, uint32_t* box_height) {
+	const vg_lite_matrix_t* m = &drawing->matrix;
+	const float* box = drawing->path->bounding_box;
+	int32_t min_x = INT32_MAX;
+	int32_t min_y = INT32_MAX;
+	int32_t max_x = INT32_MIN;
+	int32_t max_y = INT32_MIN;
+
+	for (uint32_t corner = 0; corner < 4u; corner++) {
+		float x = box[((corner == 1u) || (corner == 2u)) ? 2 : 0];
+		float y = box[(corner >= 2u) ? 3 : 1];
+		int32_t tx = (int32_t)((x * m->m[0][0]) + (y * m->m[0][1]) + m->m[0][2]);
+		int32_t ty = (int32_t)((x * m->m[1][0]) + (y * m->m[1][1]) + m->m[1][2]);
+		min_x = (tx < min_x) ? tx : min_x;
+		min_y = (ty < min_y) ? ty : min_y;
+		max_x = (tx > max_x) ? tx : max_x;
+		max_y = (ty > max_y) ? ty : max_y;
+	}
+	min_x = (min_x < 0) ? 0 : min_x;
+	min_y = (min_y < 0) ? 0 : min_y;
+	max_x = (max_x > WIDTH) ? WIDTH : max_x;
+	max_y = (max_y > HEIGHT) ? HEIGHT : max_y;
+
+	*box_width = (uint32_t)(max_x - min_x);
+	*box_height = (uint32_t)(max_y - min_y);
+	return ((*box_width + width - 1u) / width) * ((*box_height + height - 1u) / height);
+}
+
+// draws the workload with the current window: checks and returns the statistics of the driver
+static vg_lite_tessellation_stats_t __draw(uint32_t width, uint32_t height) {
+	vg_lite_tessellation_stats_t stats;
+	uint32_t passes = 0;
+	uint32_t split_draws = 0;
+	uint32_t max_passes = 0;
+	uint32_t max_width = 0;
+	uint32_t max_height = 0;
+
+	(void)vg_lite_get_tessellation_stats(&stats, 1);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_clear(&__target, NULL, 0xff000000u));
+	for (uint32_t i = 0; i < __drawing_count; i++) {
+		test_drawing_t* drawing = &__drawings[i];
+		uint32_t box_width;
+		uint32_t box_height;
+		uint32_t draw_passes = __passes(drawing, width, height, &box_width, &box_height);
+
+		passes += draw_passes;
+		split_draws += (draw_passes > 1u) ? 1u : 0u;
+		max_passes = (draw_passes > max_passes) ? draw_passes : max_passes;
+		max_width = (box_width > max_width) ? box_width : max_width;
+		max_height = (box_height > max_height) ? box_height : max_height;
+		HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_draw(&__target, drawing->path, VG_LITE_FILL_NON_ZERO, &drawing->matrix,
+				VG_LITE_BLEND_SRC_OVER, 0xffc0c0c0u));
+	}
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_finish());
+
+	(void)vg_lite_get_tessellation_stats(&stats, 1);
+	HOST_TEST_CHECK_EQUAL(width, stats.width);
+	HOST_TEST_CHECK_EQUAL(height, stats.height);
+	HOST_TEST_CHECK_EQUAL(tess_tuner_bytes(width, height), stats.bytes);
+	HOST_TEST_CHECK_EQUAL(__drawing_count, stats.draws);
+	HOST_TEST_CHECK_EQUAL(passes, stats.passes);
+	HOST_TEST_CHECK_EQUAL(split_draws, stats.split_draws);
+	HOST_TEST_CHECK_EQUAL(max_passes, stats.max_passes);
+	HOST_TEST_CHECK_EQUAL(max_width, stats.max_width);
+	HOST_TEST_CHECK_EQUAL(max_height, stats.max_height);
+	return stats;
+}
+
+static void __test_workloads(void) {
+	static const test_workload_t workloads[] = {
+			{ "full screen disc", __build_full_screen_disc },
+			{ "watch face", __build_watch_face },
+			{ "40 icons", __build_icons },
+	};
+	static const test_window_t windows[] = {
+			{ 64, 64 }, { 128, 128 }, { 256, 256 }, { 400, 112 }, { 400, 144 },
+	};
+	// passes of the full screen disc and of the icons at each window size
+	static const uint32_t disc_passes[] = { 49, 16, 4, 4, 3 };
+	const uint32_t window_count = sizeof(windows) / sizeof(windows[0]);
+	const uint32_t workload_count = sizeof(workloads) / sizeof(workloads[0]);
+
+	(void)printf("tessellation passes: window, buffer (KB),");
+	for (uint32_t w = 0; w < workload_count; w++) {
+		(void)printf(" %s,", workloads[w].name);
+	}
+	(void)printf(" split drawings of the watch face\n");
+
+	for (uint32_t i = 0; i < window_count; i++) {
+		const test_window_t* window = &windows[i];
+		uint32_t watch_face_splits = 0;
+
+		HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_set_tessellation_size((int32_t)window->width, (int32_t)window->height));
+		(void)printf("  %3ux%-3u %6u", window->width, window->height, tess_tuner_bytes(window->width, window->height) / KB);
+		for (uint32_t w = 0; w < workload_count; w++) {
+			__drawing_count = 0;
+			workloads[w].build();
+			vg_lite_tessellation_stats_t stats = __draw(window->width, window->height);
+			(void)printf(" %8u", stats.passes);
+
+			if (0u == w) {
+				HOST_TEST_CHECK_EQUAL(disc_passes[i], stats.passes);
+			}
+			else if (1u == w) {
+				watch_face_splits = stats.split_draws;
+			}
+			else {
+				HOST_TEST_CHECK_EQUAL(40, stats.passes);
+			}
+		}
+		(void)printf(" %8u\n", watch_face_splits);
+	}
+
+	// the window of the whole display does not fit in the VGLite heap with the
+	// command buffers: the previous window is kept
+	HOST_TEST_CHECK_EQUAL(VG_LITE_OUT_OF_MEMORY, vg_lite_set_tessellation_size(WIDTH, HEIGHT));
+	vg_lite_tessellation_stats_t stats;
+	(void)vg_lite_get_tessellation_stats(&stats, 1);
+	HOST_TEST_CHECK_EQUAL(400, stats.width);
+	HOST_TEST_CHECK_EQUAL(144, stats.height);
+	(void)printf("  %3ux%-3u %6u: out of memory\n", (uint32_t)TESS_TUNER_MAX_WIDTH, (uint32_t)TESS_TUNER_MAX_HEIGHT,
+			tess_tuner_bytes(TESS_TUNER_MAX_WIDTH, TESS_TUNER_MAX_HEIGHT) / KB);
+}
+
+// the tuner fed with the statistics of the watch face (DISPLAY_VGLITE_frame_done())
+static void __test_closed_loop(void) {
+	tess_tuner_t tuner;
+	uint32_t width;
+	uint32_t height;
+
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_set_tessellation_size(256, 256));
+	tess_tuner_init(&tuner, &__config, 256, 256);
+	__drawing_count = 0;
+	__build_watch_face();
+
+	uint32_t first_passes = 0;
+	uint32_t last_passes = 0;
+	for (uint32_t frame = 0; frame < 3u; frame++) {
+		vg_lite_tessellation_stats_t stats = __draw(tuner.width, tuner.height);
+		first_passes = (0u == frame) ? stats.passes : first_passes;
+		last_passes = stats.passes;
+		tess_tuner_on_frame(&tuner, stats.draws, stats.passes, stats.split_draws, stats.max_passes, stats.max_width,
+				stats.max_height, &width, &height);
+		if ((width != stats.width) || (height != stats.height)) {
+			HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_set_tessellation_size((int32_t)width, (int32_t)height));
+			(void)vg_lite_get_tessellation_stats(&stats, 1);
+			tess_tuner_set_size(&tuner, stats.width, stats.height);
+		}
+	}
+
+	// the 256x256 window (513 KB) is over the budget: the tuner brings it under
+	tess_tuner_stats_t stats;
+	tess_tuner_get_stats(&tuner, &stats);
+	HOST_TEST_CHECK_EQUAL(1, stats.grows);
+	HOST_TEST_CHECK_EQUAL(400, stats.width);
+	HOST_TEST_CHECK_EQUAL(144, stats.height);
+	HOST_TEST_CHECK(stats.bytes <= TESS_TUNER_MAX_BYTES);
+	HOST_TEST_CHECK(last_passes <= first_passes);
+	(void)printf("watch face with the tuner: 256x256 (%u passes) -> %ux%u (%u passes)\n", first_passes, stats.width,
+			stats.height, last_passes);
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(void) {
+	__test_bytes();
+	__test_grow();
+	__test_banding();
+	__test_shrink();
+
+	vg_lite_init_mem(0, 0, NULL, VGLITE_HEAP_SIZE);
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_init(256, 256));
+	(void)memset(&__target, 0, sizeof(__target));
+	__target.width = WIDTH;
+	__target.height = HEIGHT;
+	__target.stride = WIDTH * (int32_t)sizeof(uint16_t);
+	__target.format = VG_LITE_RGB565;
+	__target.tiled = VG_LITE_LINEAR;
+	__target.memory = __pixels;
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_map(&__target));
+	__build_paths();
+
+	__test_workloads();
+	__test_closed_loop();
+
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_unmap(&__target));
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_close());
+	(void)printf("tess tuner: OK\n");
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,458 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host test of the touch moves (touch_filter.c and touch_helper.c),
+ * replayed with press/move/release traces of gestures sampled like the touch
+ * controller does (integer pixels with a +/-1 pixel jitter, 100 Hz):
+ *
+ * - the jitter of a still finger sends no move (FIRST_MOVE_PIXEL_LIMIT and
+ * MOVE_PIXEL_LIMIT);
+ * - the prediction error of each filter mode at the display time of the moves,
+ * against the true positions of the gestures;
+ * - the coalescing of the moves between two flushes at several frame rates:
+ * one move sent per flush at most, the moves held without flush released after
+ * TOUCH_COALESCING_MAX_HOLD_US, the touch-to-flush latency;
+ * - an event is marked as waiting for a flush before it is sent to MicroUI, and
+ * a lost press does not keep the marker.
+ *
+ * The helper is included (not linked) to give it a fake time and event
+ * generator, and to reset its state between the traces.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "host_test.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define INPUT_LOG_ENABLED 0
+
+#include "touch_helper.c"
+
+#define SAMPLE_PERIOD_US (10000)
+
+#define MAX_SAMPLES (256u)
+#define MAX_MOVES (256u)
+
+// display time of the moves for the filter checks: a 60 fps frame after the sample
+#define DISPLAY_DELAY_US (16667)
+
+#define PI (3.14159265f)
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+
+// a gesture: the true position of the finger
+typedef struct {
+	const char* name;
+	int64_t duration_us;
+	void (*position)(int64_t t_us, float* x, float* y);
+} test_gesture_t;
+
+// a sample of the touch controller
+typedef struct {
+	int64_t t_us;
+	int32_t x;
+	int32_t y;
+} test_sample_t;
+
+// a move sent to MicroUI
+typedef struct {
+	int32_t x;
+	int32_t y;
+	int64_t sent_us;
+} test_move_t;
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+static int64_t __now_us;
+
+static uint32_t __seed;
+
+static test_sample_t __samples[MAX_SAMPLES];
+static uint32_t __sample_count;
+
+static test_move_t __moves[MAX_MOVES];
+static uint32_t __move_count;
+static uint32_t __presses;
+static uint32_t __releases;
+// the MicroUI events queue is full
+static bool __queue_full;
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+int64_t time_hardware_timer_getTimeUs(void) {
+	return __now_us;
+}
+
+int32_t EVENT_GENERATOR_touch_pressed(int32_t x, int32_t y) {
+	(void)x;
+	(void)y;
+	// a flush that ends now finds the marker
+	HOST_TEST_CHECK(TOUCH_HELPER_is_waiting_flush());
+	if (!__queue_full) {
+		__presses++;
+	}
+	return __queue_full ? LLUI_INPUT_NOK : LLUI_INPUT_OK;
+}
+
+int32_t EVENT_GENERATOR_touch_moved(int32_t x, int32_t y) {
+	HOST_TEST_CHECK(TOUCH_HELPER_is_waiting_flush());
+	HOST_TEST_CHECK(__move_count < MAX_MOVES);
+	__moves[__move_count].x = x;
+	__moves[__move_count].y = y;
+	__moves[__move_count].sent_us = __now_us;
+	__move_count++;
+	return LLUI_INPUT_OK;
+}
+
+int32_t EVENT_GENERATOR_touch_released(void) {
+	__releases++;
+	return LLUI_INPUT_OK;
+}
+
+static void __still(int64_t t_us, float* x, float* y) {
+	(void)t_us;
+	*x = 200.0f;
+	*y = 150.0f;
+}
+
+// 1 pixel per millisecond, diagonal
+static void __swipe(int64_t t_us, float* x, float* y) {
+	*x = 50.0f + ((float)t_us * 0.001f);
+	*y = 300.0f - ((float)t_us * 0.0005f);
+}
+
+// 2 pixels per millisecond, decelerating to a stop in 400 ms
+static void __fling(int64_t t_us, float* x, float* y) {
+	float t = ((float)t_us > 400000.0f) ? 400000.0f : (float)t_us;
+	*x = 20.0f + (0.002f * t) - ((0.002f / 800000.0f) * t * t);
+	*y = 196.0f;
+}
+
+// a circle of 100 pixels in one second
+static void __circle(int64_t t_us, float* x, float* y) {
+	float angle = (2.0f * PI * (float)t_us) / 1e6f;
+	*x = 196.0f + (100.0f * cosf(angle));
+	*y = 196.0f + (100.0f * sinf(angle));
+}
+
+static const test_gesture_t __gestures[] = {
+		{ "still", 500000, __still },
+		{ "swipe", 300000, __swipe },
+		{ "fling", 500000, __fling },
+		{ "circle", 1000000, __circle },
+};
+
+static int32_t __jitter(void) {
+	__seed = (__seed * 1664525u) + 1013904223u;
+	return (int32_t)((__seed >> 16) % 3u) - 1;
+}
+
+// samples a gesture like the touch controller: integer pixels, +/-1 pixel of jitter
+static void __sample(const test_gesture_t* gesture, int64_t start_us) {
+	__sample_count = 0;
+	for (int64_t t_us = 0; t_us <= gesture->duration_us; t_us += SAMPLE_PERIOD_US) {
+		float x;
+		float y;
+		HOST_TEST_CHECK(__sample_count < MAX_SAMPLES);
+		gesture->position(t_us, &x, &y);
+		__samples[__sample_count].t_us = start_us + t_us;
+		__samples[__sample_count].x = (int32_t)lroundf(x) + __jitter();
+		__samples[__sample_count].y = (int32_t)lroundf(y) + __jitter();
+		__sample_count++;
+	}
+}
+
+static float __error(const test_gesture_t* gesture, int64_t t_us, int32_t x, int32_t y) {
+	float true_x;
+	float true_y;
+	gesture->position(t_us, &true_x, &true_y);
+	return hypotf((float)x - true_x, (float)y - true_y);
+}
+
+static void __reset_helper(touch_filter_mode_t mode) {
+	touch_pressed = MICROEJ_FALSE;
+	touch_moved = MICROEJ_FALSE;
+	pending_move = MICROEJ_FALSE;
+	unflushed_timestamp_us = 0;
+	waiting_flush = MICROEJ_FALSE;
+	last_move_sent_us = 0;
+	(void)memset(&latency_stats, 0, sizeof(latency_stats));
+	touch_filter.mode = mode;
+	__move_count = 0;
+	__presses = 0;
+	__releases = 0;
+	__queue_full = false;
+}
+
+static void __test_jitter(void) {
+	const test_gesture_t* still = &__gestures[0];
+	__reset_helper(TOUCH_FILTER_NONE);
+	__sample(still, 1000000);
+
+	for (uint32_t i = 0; i < __sample_count; i++) {
+		__now_us = __samples[i].t_us;
+		TOUCH_HELPER_pressed_at(__samples[i].x, __samples[i].y, __samples[i].t_us);
+		TOUCH_HELPER_flushed(__now_us + 1000);
+	}
+	TOUCH_HELPER_released();
+	HOST_TEST_CHECK_EQUAL(1, __presses);
+	HOST_TEST_CHECK_EQUAL(0, __move_count);
+	HOST_TEST_CHECK_EQUAL(1, __releases);
+
+	// after a first move, the jitter around the new position is rejected too
+	__reset_helper(TOUCH_FILTER_NONE);
+	__now_us += 1000000;
+	TOUCH_HELPER_pressed_at(100, 100, __now_us);
+	__now_us += SAMPLE_PERIOD_US;
+	TOUCH_HELPER_pressed_at(100 + FIRST_MOVE_PIXEL_LIMIT, 100, __now_us);
+	HOST_TEST_CHECK_EQUAL(0, __move_count);
+	TOUCH_HELPER_pressed_at(100 + FIRST_MOVE_PIXEL_LIMIT + 1, 100, __now_us);
+	HOST_TEST_CHECK_EQUAL(1, __move_count);
+	for (int32_t i = 0; i < 20; i++) {
+		TOUCH_HELPER_flushed(__now_us);
+		__now_us += SAMPLE_PERIOD_US;
+		TOUCH_HELPER_pressed_at(100 + FIRST_MOVE_PIXEL_LIMIT + 1 + __jitter() + __jitter(), 100 + __jitter() + __jitter(), __now_us);
+	}
+	HOST_TEST_CHECK_EQUAL(1, __move_count);
+	TOUCH_HELPER_released();
+}
+
+// prediction error of the filter alone at the display time of each sample
+static float __filter_error(const test_gesture_t* gesture, touch_filter_mode_t mode) {
+	touch_filter_t filter = touch_filter;
+	float error = 0.0f;
+	filter.mode = mode;
+
+	touch_filter_reset(&filter, __samples[0].x, __samples[0].y, __samples[0].t_us);
+	for (uint32_t i = 1; i < __sample_count; i++) {
+		int32_t x;
+		int32_t y;
+		touch_filter_update(&filter, __samples[i].x, __samples[i].y, __samples[i].t_us);
+		touch_filter_predict(&filter, __samples[i].t_us + DISPLAY_DELAY_US, &x, &y);
+		error += __error(gesture, __samples[i].t_us - __samples[0].t_us + DISPLAY_DELAY_US, x, y);
+	}
+	return error / (float)(__sample_count - 1u);
+}
+
+static void __test_prediction(void) {
+	(void)printf("prediction error at +%d us (pixels): none / linear / alpha-beta\n", DISPLAY_DELAY_US);
+	for (uint32_t g = 1; g < (sizeof(__gestures) / sizeof(__gestures[0])); g++) {
+		const test_gesture_t* gesture = &__gestures[g];
+		__sample(gesture, 0);
+		float none = __filter_error(gesture, TOUCH_FILTER_NONE);
+		float linear = __filter_error(gesture, TOUCH_FILTER_LINEAR);
+		float alpha_beta = __filter_error(gesture, TOUCH_FILTER_ALPHA_BETA);
+		(void)printf("  %-8s %6.2f %6.2f %6.2f\n", gesture->name, (double)none, (double)linear, (double)alpha_beta);
+		// the displayed position lags by the distance moved during the delay
+		HOST_TEST_CHECK(linear < (none * 0.5f));
+		HOST_TEST_CHECK(alpha_beta < (none * 0.5f));
+	}
+
+	// the extrapolation stops at max_horizon_us
+	touch_filter_t filter = touch_filter;
+	int32_t x;
+	int32_t y;
+	filter.mode = TOUCH_FILTER_LINEAR;
+	touch_filter_reset(&filter, 100, 100, 0);
+	touch_filter_update(&filter, 110, 100, 10000);
+	touch_filter_predict(&filter, 10000 + filter.max_horizon_us, &x, &y);
+	HOST_TEST_CHECK_EQUAL(110 + (filter.max_horizon_us / 1000), x);
+	touch_filter_predict(&filter, 10000000, &x, &y);
+	HOST_TEST_CHECK_EQUAL(110 + (filter.max_horizon_us / 1000), x);
+	HOST_TEST_CHECK_EQUAL(100, y);
+	// no prediction before the second sample, nor in the past
+	touch_filter_reset(&filter, 100, 100, 0);
+	touch_filter_predict(&filter, 20000, &x, &y);
+	HOST_TEST_CHECK_EQUAL(100, x);
+	touch_filter_update(&filter, 110, 100, 10000);
+	touch_filter_predict(&filter, 0, &x, &y);
+	HOST_TEST_CHECK_EQUAL(110, x);
+}
+
+/*
+ * Replays a gesture through the helper with a display that flushes every
+ * flush_period_us (0: no flush): returns the largest number of moves sent between
+ * two flushes and the mean error of the moves at the time they are displayed.
+ */
+static uint32_t __replay(const test_gesture_t* gesture, touch_filter_mode_t mode, int64_t flush_period_us, float* error) {
+	int64_t start_us = 10000000;
+	int64_t next_flush_us = start_us + flush_period_us;
+	uint32_t displayed = 0;
+	uint32_t max_per_flush = 0;
+	uint32_t moves_before_flush = 0;
+	float error_sum = 0.0f;
+
+	__reset_helper(mode);
+	__sample(gesture, start_us);
+	for (uint32_t i = 0; i < __sample_count; i++) {
+		while ((0 != flush_period_us) && (next_flush_us <= __samples[i].t_us)) {
+			__now_us = next_flush_us;
+			// the moves sent before this flush are displayed by it
+			for (; displayed < __move_count; displayed++) {
+				error_sum += __error(gesture, __now_us - start_us, __moves[displayed].x, __moves[displayed].y);
+			}
+			uint32_t sent = __move_count - moves_before_flush;
+			max_per_flush = (sent > max_per_flush) ? sent : max_per_flush;
+			if (TOUCH_HELPER_is_waiting_flush()) {
+				TOUCH_HELPER_flushed(__now_us);
+			}
+			moves_before_flush = __move_count;
+			next_flush_us += flush_period_us;
+		}
+		__now_us = __samples[i].t_us;
+		TOUCH_HELPER_pressed_at(__samples[i].x, __samples[i].y, __samples[i].t_us);
+	}
+
+	// the last position is sent before the release
+	uint32_t moves = __move_count;
+	bool pending = (MICROEJ_TRUE == pending_move);
+	TOUCH_HELPER_released();
+	HOST_TEST_CHECK_EQUAL(moves + (pending ? 1u : 0u), __move_count);
+	HOST_TEST_CHECK_EQUAL(1, __releases);
+
+	*error = (0u == displayed) ? 0.0f : (error_sum / (float)displayed);
+	return max_per_flush;
+}
+
+static void __test_coalescing(void) {
+	const test_gesture_t* swipe = &__gestures[1];
+	static const int64_t periods_us[] = { 16667, 33333, 66667 };
+	float error;
+
+	(void)printf("coalescing of a %u Hz swipe: frame period, moves sent, coalesced, max per flush, latency avg/max (us)\n",
+			(unsigned int)(1000000 / SAMPLE_PERIOD_US));
+	for (uint32_t p = 0; p < (sizeof(periods_us) / sizeof(periods_us[0])); p++) {
+		uint32_t max_per_flush = __replay(swipe, TOUCH_FILTER_NONE, periods_us[p], &error);
+		(void)printf("  %6d %6u %6u %6u %8u %8u\n", (int)periods_us[p], __move_count, latency_stats.coalesced_moves, max_per_flush,
+				latency_stats.average_us, latency_stats.max_us);
+		// one move per frame (the held one, sent when the previous one is displayed),
+		// plus one per TOUCH_COALESCING_MAX_HOLD_US on a slower display
+		HOST_TEST_CHECK(max_per_flush <= (1u + (uint32_t)(periods_us[p] / TOUCH_COALESCING_MAX_HOLD_US)));
+		// all the samples are sent or coalesced (every sample of the swipe is a move)
+		HOST_TEST_CHECK_EQUAL(__sample_count - 1u, __move_count + latency_stats.coalesced_moves);
+		// a move waits for one frame at most, sampled one period before
+		HOST_TEST_CHECK(latency_stats.max_us <= (uint32_t)(periods_us[p] + SAMPLE_PERIOD_US));
+	}
+	// a slower display gets fewer moves
+	(void)__replay(swipe, TOUCH_FILTER_NONE, 16667, &error);
+	uint32_t moves_60fps = __move_count;
+	(void)__replay(swipe, TOUCH_FILTER_NONE, 33333, &error);
+	HOST_TEST_CHECK(__move_count < moves_60fps);
+
+	// no flush: a held move is sent with the first sample after TOUCH_COALESCING_MAX_HOLD_US
+	(void)__replay(swipe, TOUCH_FILTER_NONE, 0, &error);
+	HOST_TEST_CHECK_EQUAL(0, latency_stats.samples);
+	for (uint32_t i = 1; i < (__move_count - 1u); i++) {
+		int64_t gap_us = __moves[i].sent_us - __moves[i - 1u].sent_us;
+		HOST_TEST_CHECK(gap_us >= TOUCH_COALESCING_MAX_HOLD_US);
+		HOST_TEST_CHECK(gap_us < (TOUCH_COALESCING_MAX_HOLD_US + SAMPLE_PERIOD_US));
+	}
+	// or by the touch task timeout (the first move is not held: no move sent recently)
+	__reset_helper(TOUCH_FILTER_NONE);
+	TOUCH_HELPER_pressed_at(10, 10, __now_us);
+	TOUCH_HELPER_pressed_at(30, 10, __now_us);
+	TOUCH_HELPER_pressed_at(40, 10, __now_us);
+	TOUCH_HELPER_pressed_at(50, 10, __now_us);
+	HOST_TEST_CHECK_EQUAL(1, __move_count);
+	HOST_TEST_CHECK_EQUAL(1, latency_stats.coalesced_moves);
+	__now_us += TOUCH_COALESCING_MAX_HOLD_US;
+	TOUCH_HELPER_flush_timeout(__now_us);
+	HOST_TEST_CHECK_EQUAL(2, __move_count);
+	HOST_TEST_CHECK_EQUAL(50, __moves[1].x);
+	HOST_TEST_CHECK(TOUCH_HELPER_is_waiting_flush());
+	TOUCH_HELPER_flushed(__now_us);
+	HOST_TEST_CHECK(!TOUCH_HELPER_is_waiting_flush());
+	TOUCH_HELPER_released();
+
+	// end to end: the moves sent with a prediction are closer to the finger when displayed
+	(void)printf("displayed move error at 30 fps (pixels): none / linear / alpha-beta\n");
+	for (uint32_t g = 1; g < (sizeof(__gestures) / sizeof(__gestures[0])); g++) {
+		float none;
+		float linear;
+		float alpha_beta;
+		(void)__replay(&__gestures[g], TOUCH_FILTER_NONE, 33333, &none);
+		(void)__replay(&__gestures[g], TOUCH_FILTER_LINEAR, 33333, &linear);
+		(void)__replay(&__gestures[g], TOUCH_FILTER_ALPHA_BETA, 33333, &alpha_beta);
+		(void)printf("  %-8s %6.2f %6.2f %6.2f\n", __gestures[g].name, (double)none, (double)linear, (double)alpha_beta);
+		HOST_TEST_CHECK(linear < none);
+		HOST_TEST_CHECK(alpha_beta < none);
+	}
+}
+
+static void __test_waiting_flush(void) {
+	__reset_helper(TOUCH_FILTER_NONE);
+	HOST_TEST_CHECK(!TOUCH_HELPER_is_waiting_flush());
+
+	// a lost press is not waiting for a flush
+	__queue_full = true;
+	TOUCH_HELPER_pressed_at(10, 10, __now_us);
+	HOST_TEST_CHECK_EQUAL(0, __presses);
+	HOST_TEST_CHECK(!TOUCH_HELPER_is_waiting_flush());
+
+	// the press waits for the next flush, which measures its latency
+	__queue_full = false;
+	TOUCH_HELPER_pressed_at(10, 10, __now_us);
+	HOST_TEST_CHECK_EQUAL(1, __presses);
+	HOST_TEST_CHECK(TOUCH_HELPER_is_waiting_flush());
+	TOUCH_HELPER_flushed(__now_us + 12000);
+	HOST_TEST_CHECK(!TOUCH_HELPER_is_waiting_flush());
+	HOST_TEST_CHECK_EQUAL(1, latency_stats.samples);
+	HOST_TEST_CHECK_EQUAL(12000, latency_stats.last_us);
+
+	// a move held behind an unflushed one keeps the first sample time
+	__now_us += 20000;
+	TOUCH_HELPER_pressed_at(30, 10, __now_us);
+	int64_t first_us = __now_us;
+	__now_us += SAMPLE_PERIOD_US;
+	TOUCH_HELPER_pressed_at(40, 10, __now_us);
+	HOST_TEST_CHECK_EQUAL(1, __move_count);
+	HOST_TEST_CHECK(TOUCH_HELPER_is_waiting_flush());
+	TOUCH_HELPER_flushed(__now_us + 5000);
+	HOST_TEST_CHECK_EQUAL(__now_us + 5000 - first_us, latency_stats.last_us);
+	// the held move has been sent: waiting for the next flush
+	HOST_TEST_CHECK_EQUAL(2, __move_count);
+	HOST_TEST_CHECK(TOUCH_HELPER_is_waiting_flush());
+	TOUCH_HELPER_flushed(__now_us + 20000);
+	HOST_TEST_CHECK(!TOUCH_HELPER_is_waiting_flush());
+	TOUCH_HELPER_released();
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(void) {
+	__seed = 29;
+	__now_us = 1000000;
+
+	__test_jitter();
+	__test_prediction();
+	__test_coalescing();
+	__test_waiting_flush();
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
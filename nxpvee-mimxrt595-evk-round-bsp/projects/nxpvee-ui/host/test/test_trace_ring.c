@@ -0,0 +1,290 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host test of the lock-free recording of the trace ring (trace_ring.c),
+ * the signal handlers standing for the interrupt handlers:
+ *
+ * - the cycle counter raises a signal in the middle of some reservations: the
+ * handler records events between the read of the reservation word and its
+ * compare and swap (and again from a nested handler), the interrupted
+ * reservation must retry;
+ * - an interval timer raises signals at any point of the recordings.
+ *
+ * The ring is then decoded: every event of the main loop is present once, in
+ * order, with its values; every event of the handlers is present once; the
+ * times rebuilt from the deltas never go back; the records that cross a sync
+ * point hold an absolute time; the committed count matches the reservations.
+ *
+ * A microbenchmark prints the cost of an event (TSC cycles of the host, not the
+ * cycles of the Cortex-M33) for 0 to 10 values.
+ *
+ * The module is included (not linked) to give it the cycle counter and context
+ * of the test and to reset its private state between the runs.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include <x86intrin.h>
+
+#include "host_test.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+static uint32_t __timestamp(void);
+static volatile sig_atomic_t __depth;
+
+#define TRACE_RING_ENABLED 1
+#define TRACE_RING_GET_TIMESTAMP() __timestamp()
+#define TRACE_RING_GET_FREQUENCY() (1000000000u)
+#define TRACE_RING_START_TIMESTAMP() do { } while (0)
+// the exception number of the handler, 0 in the main loop
+#define TRACE_RING_GET_CONTEXT() ((0 != __depth) ? (uint32_t)(15 + __depth) : 0u)
+
+#include "trace_ring.c"
+
+#define GROUP_MAIN (0u)
+#define GROUP_HANDLER (1u)
+
+// a signal is raised in the middle of one reservation out of RAISE_PERIOD
+#define RAISE_PERIOD (7u)
+
+// period of the interval timer (microseconds)
+#define TIMER_PERIOD_US (20)
+
+// the main loop stops recording before the ring is full (no record is overwritten)
+#define RUN_RECORDS ((uint32_t)TRACE_RING_SIZE - 64u)
+
+#define RUNS (300u)
+
+#define MAX_HANDLER_EVENTS (1u << 16)
+
+#define BENCH_EVENTS (200000u)
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+static volatile bool __raise;
+static volatile uint32_t __timestamp_calls;
+static volatile uint32_t __handler_sequence;
+static uint32_t __raised;
+static volatile uint32_t __timer_signals;
+static uint8_t __handler_seen[MAX_HANDLER_EVENTS];
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+static uint32_t __timestamp(void) {
+	uint32_t now = (uint32_t)__rdtsc();
+	__timestamp_calls++;
+	// interrupt the reservation (twice nested at most)
+	if (__raise && (__depth < 2) && (0u == (__timestamp_calls % RAISE_PERIOD))) {
+		__raised++;
+		(void)raise(SIGUSR1);
+	}
+	return now;
+}
+
+static void __handler(int signal) {
+	__depth++;
+	if (SIGALRM == signal) {
+		__timer_signals++;
+	}
+	uint32_t sequence = __atomic_fetch_add(&__handler_sequence, 1u, __ATOMIC_RELAXED);
+	uint32_t values[2] = { sequence, ~sequence };
+	TRACE_RING_record(TRACE_RING_KIND_START, GROUP_HANDLER, 1u, values, 2u);
+	__depth--;
+}
+
+static void __reset(void) {
+	(void)memset(&TRACE_RING_image, 0, sizeof(TRACE_RING_image));
+	ring_state = 0;
+	ring_last = 0;
+	TRACE_RING_initialize();
+}
+
+static uint32_t __main_value(uint32_t sequence, uint32_t v) {
+	return (sequence << 4) | v;
+}
+
+// decodes the ring of a run: returns the number of events of the main loop
+static uint32_t __check_run(uint32_t first_sequence, uint32_t main_events, uint32_t* handler_events) {
+	uint32_t committed = TRACE_RING_image.header.committed;
+	HOST_TEST_CHECK(committed <= (uint32_t)TRACE_RING_SIZE);
+	// every reservation has been committed
+	HOST_TEST_CHECK_EQUAL(committed & INDEX_MASK, ring_state & INDEX_MASK);
+
+	uint32_t sequence = first_sequence;
+	uint32_t time = 0;
+	uint32_t position = 0;
+	while (position < committed) {
+		const TRACE_RING_record_t* record = &TRACE_RING_image.records[position];
+		uint32_t type = record->event.type;
+		uint32_t kind = type & 0x7u;
+		uint32_t count = type >> TRACE_RING_COUNT_SHIFT;
+		uint32_t records = 1u + ((count + 1u) / 3u);
+		bool absolute = 0u != (type & TRACE_RING_FLAG_ABSOLUTE);
+		HOST_TEST_CHECK_EQUAL(TRACE_RING_KIND_START, kind);
+		HOST_TEST_CHECK((position + records) <= committed);
+
+		// the time never goes back; a record that crosses a sync point is absolute
+		if (absolute) {
+			HOST_TEST_CHECK((0u == position) || ((int32_t)(record->event.time - time) >= 0));
+			time = record->event.time;
+		}
+		else {
+			HOST_TEST_CHECK(0u != position);
+			HOST_TEST_CHECK(record->event.time < TIME_MASK);
+			time += record->event.time;
+		}
+		if (__trace_ring_crosses_sync(position, records)) {
+			HOST_TEST_CHECK(absolute);
+		}
+
+		// the values
+		uint32_t values[TRACE_RING_MAX_VALUES];
+		values[0] = record->event.value;
+		for (uint32_t r = 1; r < records; r++) {
+			const TRACE_RING_record_t* more = &TRACE_RING_image.records[position + r];
+			HOST_TEST_CHECK_EQUAL(TRACE_RING_KIND_VALUES, more->values.type);
+			for (uint32_t v = 0; v < 3u; v++) {
+				uint32_t index = 1u + ((r - 1u) * 3u) + v;
+				if (index < count) {
+					values[index] = more->values.values[v];
+				}
+			}
+		}
+
+		if (GROUP_MAIN == record->event.group) {
+			// in order, once
+			HOST_TEST_CHECK_EQUAL(0u, record->event.context);
+			HOST_TEST_CHECK_EQUAL(sequence % (TRACE_RING_MAX_VALUES + 1u), count);
+			for (uint32_t v = 0; v < count; v++) {
+				HOST_TEST_CHECK_EQUAL(__main_value(sequence, v), values[v]);
+			}
+			sequence++;
+		}
+		else {
+			// once, in any order (a nested handler records first)
+			HOST_TEST_CHECK_EQUAL(GROUP_HANDLER, record->event.group);
+			HOST_TEST_CHECK(0u != record->event.context);
+			HOST_TEST_CHECK_EQUAL(2u, count);
+			HOST_TEST_CHECK_EQUAL(~values[0], values[1]);
+			HOST_TEST_CHECK(values[0] < MAX_HANDLER_EVENTS);
+			HOST_TEST_CHECK_EQUAL(0u, __handler_seen[values[0]]);
+			__handler_seen[values[0]] = 1u;
+			(*handler_events)++;
+		}
+		position += records;
+	}
+	HOST_TEST_CHECK_EQUAL(committed, position);
+	HOST_TEST_CHECK_EQUAL(first_sequence + main_events, sequence);
+	return sequence - first_sequence;
+}
+
+static void __test_stress(void) {
+	struct sigaction action;
+	(void)memset(&action, 0, sizeof(action));
+	action.sa_handler = __handler;
+	// the handlers nest as the interrupts of different priorities
+	action.sa_flags = SA_NODEFER;
+	HOST_TEST_CHECK(0 == sigaction(SIGUSR1, &action, NULL));
+	HOST_TEST_CHECK(0 == sigaction(SIGALRM, &action, NULL));
+
+	struct itimerval timer = { { 0, TIMER_PERIOD_US }, { 0, TIMER_PERIOD_US } };
+	struct itimerval stop = { { 0, 0 }, { 0, 0 } };
+	sigset_t signals;
+	(void)sigemptyset(&signals);
+	(void)sigaddset(&signals, SIGALRM);
+	(void)sigaddset(&signals, SIGUSR1);
+
+	uint32_t sequence = 0;
+	uint32_t handler_events = 0;
+	for (uint32_t run = 0; run < RUNS; run++) {
+		__reset();
+		uint32_t first_sequence = sequence;
+		uint32_t main_events = 0;
+
+		HOST_TEST_CHECK(0 == setitimer(ITIMER_REAL, &timer, NULL));
+		__raise = true;
+		while (TRACE_RING_image.header.committed < RUN_RECORDS) {
+			uint32_t values[TRACE_RING_MAX_VALUES];
+			uint32_t count = sequence % (TRACE_RING_MAX_VALUES + 1u);
+			for (uint32_t v = 0; v < count; v++) {
+				values[v] = __main_value(sequence, v);
+			}
+			TRACE_RING_record(TRACE_RING_KIND_START, GROUP_MAIN, 1u, values, count);
+			sequence++;
+			main_events++;
+		}
+		__raise = false;
+		HOST_TEST_CHECK(0 == sigprocmask(SIG_BLOCK, &signals, NULL));
+		HOST_TEST_CHECK(0 == setitimer(ITIMER_REAL, &stop, NULL));
+
+		(void)__check_run(first_sequence, main_events, &handler_events);
+
+		// a pending timer signal is dropped
+		(void)signal(SIGALRM, SIG_IGN);
+		HOST_TEST_CHECK(0 == sigprocmask(SIG_UNBLOCK, &signals, NULL));
+		HOST_TEST_CHECK(0 == sigaction(SIGALRM, &action, NULL));
+	}
+
+	// every handler event has been found
+	HOST_TEST_CHECK_EQUAL(__handler_sequence, handler_events);
+	for (uint32_t e = 0; e < handler_events; e++) {
+		HOST_TEST_CHECK_EQUAL(1u, __handler_seen[e]);
+	}
+	(void)printf("stress: %u runs, %u main events, %u handler events (%u raised in a reservation, %u timer signals)\n",
+			RUNS, sequence, handler_events, __raised, __timer_signals);
+	HOST_TEST_CHECK(__raised > 0u);
+}
+
+static void __bench(void) {
+	static const uint32_t counts[] = { 0u, 1u, 4u, 10u };
+	uint32_t values[TRACE_RING_MAX_VALUES] = { 0 };
+
+	for (uint32_t c = 0; c < (sizeof(counts) / sizeof(counts[0])); c++) {
+		__reset();
+		uint64_t start_ns = HOST_TEST_now_ns();
+		uint64_t start = __rdtsc();
+		for (uint32_t e = 0; e < BENCH_EVENTS; e++) {
+			values[0] = e;
+			TRACE_RING_record(TRACE_RING_KIND_START, GROUP_MAIN, 2u, values, counts[c]);
+		}
+		uint64_t cycles = __rdtsc() - start;
+		uint64_t ns = HOST_TEST_now_ns() - start_ns;
+		(void)printf("bench: %2u values, %2u records: %6.1f TSC cycles, %6.1f ns per event\n", counts[c],
+				1u + ((counts[c] + 1u) / 3u), (double)cycles / BENCH_EVENTS, (double)ns / BENCH_EVENTS);
+	}
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(void) {
+	__test_stress();
+	__bench();
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
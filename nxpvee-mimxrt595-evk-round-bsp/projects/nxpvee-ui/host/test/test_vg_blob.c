@@ -0,0 +1,534 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host test of the drawing of the animated vector images compiled by
+ * vg_compiler.py (vg_blob.c) against the reference evaluation of the script
+ * (vg_compiler.py --dump), at several times of the animations:
+ *
+ * - VG_BLOB_draw() queues the same drawings as the element list of the
+ * reference: paths, matrices, colors and fill rules (the paths of the reference
+ * are built with LLVG_PATH_IMPL_append*() like the MicroVG runtime does);
+ * - the gradient ramps and matrices are bit-identical to the ones of
+ * vg_lite_init_grad() + vg_lite_set_grad() + VGLITE_PATH_update_gradient();
+ * - the pixels drawn by the software VGLite HAL are the same, but for a few
+ * anti-aliased pixels;
+ * - VG_BLOB_check() rejects the blobs that do not fit the configuration.
+ *
+ * The blobs are compiled at build time in vg_blob_images.c. The module is
+ * included (not linked) to record its drawings. A benchmark prints the cost of
+ * VG_BLOB_find() and of the evaluation of a frame (no GPU drawing).
+ *
+ * Usage: test_vg_blob <python> <vg_compiler.py> <resources folder> <image>...
+ * (the images relative to the resources folder, e.g. images/mascot.xml)
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <LLVG_MATRIX_impl.h>
+#include <LLVG_PATH_impl.h>
+
+#include "host_microui.h"
+#include "host_test.h"
+#include "vg_drawer.h"
+#include "vglite_path.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define VG_DRAWER_update_color __record_update_color
+#define VG_DRAWER_update_gradient __record_update_gradient
+#define VG_DRAWER_draw_path __record_draw_path
+#define VG_DRAWER_draw_gradient __record_draw_gradient
+
+static void __record_update_color(void* target, vg_lite_color_t* color, vg_lite_blend_t blend);
+static void __record_update_gradient(void* target, vg_lite_linear_gradient_t* gradient, vg_lite_blend_t blend);
+static vg_lite_error_t __record_draw_path(void* target, vg_lite_path_t* path, vg_lite_fill_t fill_rule,
+		vg_lite_matrix_t* matrix, vg_lite_blend_t blend, vg_lite_color_t color);
+static vg_lite_error_t __record_draw_gradient(void* target, vg_lite_path_t* path, vg_lite_fill_t fill_rule,
+		vg_lite_matrix_t* matrix, vg_lite_linear_gradient_t* gradient, vg_lite_blend_t blend);
+
+#include "vg_blob.c"
+
+#define WIDTH (400u)
+#define HEIGHT (400u)
+
+#define MAX_ELEMENTS (128u)
+#define MAX_PATH_SIZE (4096u)
+#define MAX_LINE (65536u)
+
+// relative errors of the parameters computed in float
+#define TOLERANCE (1e-4f)
+
+// pixels that differ in a frame, and by how much (5-bit red): the anti-aliased
+// edges of the paths morphed in float (33 pixels and 3 at most measured)
+#define MAX_PIXELS (64u)
+#define MAX_RED_DELTA (4u)
+
+#define BENCH_FINDS (100000u)
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+
+// a drawing of VG_BLOB_draw()
+typedef struct {
+	uint8_t path[MAX_PATH_SIZE];
+	uint32_t path_length;
+	float bounds[4];
+	float matrix[LLVG_MATRIX_SIZE];
+	uint32_t color;
+	bool gradient;
+	bool even_odd;
+	uint32_t ramp[VLC_GRADBUFFER_WIDTH];
+	float gradient_matrix[LLVG_MATRIX_SIZE];
+} test_drawing_t;
+
+// an element of the reference evaluation
+typedef struct {
+	uint32_t color;
+	int32_t gradient;
+	bool even_odd;
+	float matrix[LLVG_MATRIX_SIZE];
+	jbyte* path;
+} test_element_t;
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+static const char* __python;
+static const char* __compiler;
+static const char* __folder;
+
+static test_drawing_t __drawings[MAX_ELEMENTS];
+static uint32_t __drawing_count;
+static bool __recording;
+static bool __drawing;
+
+static test_element_t __elements[MAX_ELEMENTS];
+static uint32_t __element_count;
+// drawing of each visible element
+static uint32_t __drawing_of[MAX_ELEMENTS];
+
+static uint16_t __blob_pixels[WIDTH * HEIGHT];
+static uint16_t __reference_pixels[WIDTH * HEIGHT];
+
+static uint32_t __ramps_checked;
+
+// the times of the frames (ms)
+static const int32_t __times[] = { 0, 1, 150, 500, 799, 800, 1250, 2501, 4999, 7000 };
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+static void __record_update_color(void* target, vg_lite_color_t* color, vg_lite_blend_t blend) {
+	(void)target;
+	VGLITE_PATH_update_color(color, blend);
+}
+
+static void __record_update_gradient(void* target, vg_lite_linear_gradient_t* gradient, vg_lite_blend_t blend) {
+	(void)target;
+	VGLITE_PATH_update_gradient(gradient, blend);
+}
+
+static test_drawing_t* __record(vg_lite_path_t* path, vg_lite_matrix_t* matrix, vg_lite_fill_t fill_rule) {
+	HOST_TEST_CHECK(__drawing_count < MAX_ELEMENTS);
+	HOST_TEST_CHECK((uint32_t)path->path_length <= MAX_PATH_SIZE);
+	test_drawing_t* drawing = &__drawings[__drawing_count];
+	__drawing_count++;
+	(void)memcpy(drawing->path, path->path, (size_t)path->path_length);
+	drawing->path_length = (uint32_t)path->path_length;
+	(void)memcpy(drawing->bounds, path->bounding_box, sizeof(drawing->bounds));
+	(void)memcpy(drawing->matrix, matrix->m, sizeof(drawing->matrix));
+	drawing->even_odd = VG_LITE_FILL_EVEN_ODD == fill_rule;
+	return drawing;
+}
+
+static vg_lite_error_t __record_draw_path(void* target, vg_lite_path_t* path, vg_lite_fill_t fill_rule,
+		vg_lite_matrix_t* matrix, vg_lite_blend_t blend, vg_lite_color_t color) {
+	vg_lite_error_t ret = VG_LITE_SUCCESS;
+	if (__recording) {
+		test_drawing_t* drawing = __record(path, matrix, fill_rule);
+		drawing->color = color;
+		drawing->gradient = false;
+	}
+	if (__drawing) {
+		ret = vg_lite_draw((vg_lite_buffer_t*)target, path, fill_rule, matrix, blend, color);
+	}
+	return ret;
+}
+
+static vg_lite_error_t __record_draw_gradient(void* target, vg_lite_path_t* path, vg_lite_fill_t fill_rule,
+		vg_lite_matrix_t* matrix, vg_lite_linear_gradient_t* gradient, vg_lite_blend_t blend) {
+	vg_lite_error_t ret = VG_LITE_SUCCESS;
+	if (__recording) {
+		test_drawing_t* drawing = __record(path, matrix, fill_rule);
+		drawing->gradient = true;
+		(void)memcpy(drawing->ramp, gradient->image.memory, sizeof(drawing->ramp));
+		(void)memcpy(drawing->gradient_matrix, gradient->matrix.m, sizeof(drawing->gradient_matrix));
+	}
+	if (__drawing) {
+		if (NULL == gradient->image.handle) {
+			// the ramps of the blob are not mapped: a host address does not fit in
+			// the 32-bit GPU address
+			vg_lite_linear_gradient_t mapped = *gradient;
+			mapped.image.address = 0;
+			HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_map(&mapped.image));
+			ret = vg_lite_draw_gradient((vg_lite_buffer_t*)target, path, fill_rule, matrix, &mapped, blend);
+			HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_finish());
+			HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_unmap(&mapped.image));
+		}
+		else {
+			ret = vg_lite_draw_gradient((vg_lite_buffer_t*)target, path, fill_rule, matrix, gradient, blend);
+		}
+	}
+	return ret;
+}
+
+// the MicroVG path of a "path" line of the dump (absolute commands), closed at the end
+static jbyte* __parse_path(const char* line) {
+	jbyte* path = malloc(MAX_PATH_SIZE);
+	HOST_TEST_CHECK(NULL != path);
+	HOST_TEST_CHECK_EQUAL(LLVG_SUCCESS, LLVG_PATH_IMPL_initializePath(path, MAX_PATH_SIZE));
+	float xmin = INFINITY;
+	float ymin = INFINITY;
+	float xmax = -INFINITY;
+	float ymax = -INFINITY;
+	char command[2];
+	int length;
+
+	while (1 == sscanf(line, " %1s%n", command, &length)) {
+		line += length;
+		uint32_t count = ('C' == command[0]) ? 6u : (('Q' == command[0]) ? 4u : 2u);
+		float v[6];
+		for (uint32_t i = 0; i < count; i++) {
+			HOST_TEST_CHECK(1 == sscanf(line, " %f%n", &v[i], &length));
+			line += length;
+		}
+		for (uint32_t i = 0; i < count; i += 2u) {
+			xmin = fminf(xmin, v[i]);
+			xmax = fmaxf(xmax, v[i]);
+			ymin = fminf(ymin, v[i + 1u]);
+			ymax = fmaxf(ymax, v[i + 1u]);
+		}
+		jint result;
+		if ('M' == command[0]) {
+			result = LLVG_PATH_IMPL_appendPathCommand1(path, MAX_PATH_SIZE, LLVG_PATH_CMD_MOVE, v[0], v[1]);
+		}
+		else if ('L' == command[0]) {
+			result = LLVG_PATH_IMPL_appendPathCommand1(path, MAX_PATH_SIZE, LLVG_PATH_CMD_LINE, v[0], v[1]);
+		}
+		else if ('Q' == command[0]) {
+			result = LLVG_PATH_IMPL_appendPathCommand2(path, MAX_PATH_SIZE, LLVG_PATH_CMD_QUAD, v[0], v[1], v[2], v[3]);
+		}
+		else {
+			HOST_TEST_CHECK('C' == command[0]);
+			result = LLVG_PATH_IMPL_appendPathCommand3(path, MAX_PATH_SIZE, LLVG_PATH_CMD_CUBIC, v[0], v[1], v[2], v[3], v[4], v[5]);
+		}
+		HOST_TEST_CHECK_EQUAL(LLVG_SUCCESS, result);
+	}
+	HOST_TEST_CHECK_EQUAL(LLVG_SUCCESS, LLVG_PATH_IMPL_appendPathCommand2(path, MAX_PATH_SIZE, LLVG_PATH_CMD_CLOSE, xmin, ymin, xmax, ymax));
+	return path;
+}
+
+// the reference evaluation of an image at a time
+static void __dump(const char* image, int32_t time) {
+	static char line[MAX_LINE];
+	char command[1024];
+	(void)snprintf(command, sizeof(command), "\"%s\" \"%s\" --dump %d \"%s/%s\"", __python, __compiler, (int)time, __folder, image);
+	FILE* dump = popen(command, "r");
+	HOST_TEST_CHECK(NULL != dump);
+
+	__element_count = 0;
+	while (NULL != fgets(line, sizeof(line), dump)) {
+		if (0 == strncmp(line, "element", 7)) {
+			HOST_TEST_CHECK(__element_count < MAX_ELEMENTS);
+			test_element_t* element = &__elements[__element_count];
+			float* m = element->matrix;
+			int even_odd;
+			HOST_TEST_CHECK(12 == sscanf(line, "element %*d color %x gradient %d fill %d matrix %f %f %f %f %f %f %f %f %f",
+					&element->color, &element->gradient, &even_odd, &m[0], &m[1], &m[2], &m[3], &m[4], &m[5], &m[6], &m[7], &m[8]));
+			element->even_odd = 0 != even_odd;
+		}
+		else if (0 == strncmp(line, "path", 4)) {
+			__elements[__element_count].path = __parse_path(line + 4);
+			__element_count++;
+		}
+		else {
+			// header line
+		}
+	}
+	HOST_TEST_CHECK(0 == pclose(dump));
+	HOST_TEST_CHECK(0u < __element_count);
+}
+
+static float __max_relative_error(const float* actual, const float* expected, uint32_t count) {
+	float ret = 0.0f;
+	for (uint32_t i = 0; i < count; i++) {
+		float error = fabsf(actual[i] - expected[i]) / fmaxf(1.0f, fabsf(expected[i]));
+		ret = fmaxf(ret, error);
+	}
+	return ret;
+}
+
+static void __to_path(vg_lite_path_t* path, jbyte* data) {
+	__to_vglite_path(path, (const MICROVG_PATH_HEADER_t*)(const void*)data);
+}
+
+// compares the drawings of the blob with the elements of the reference
+static void __check_drawings(const float* global) {
+	uint32_t visible = 0;
+	for (uint32_t i = 0; i < __element_count; i++) {
+		if (0u != (__elements[i].color >> 24)) {
+			__drawing_of[i] = visible;
+			visible++;
+		}
+	}
+	HOST_TEST_CHECK_EQUAL(visible, __drawing_count);
+
+	for (uint32_t i = 0; i < __element_count; i++) {
+		const test_element_t* element = &__elements[i];
+		if (0u == (element->color >> 24)) {
+			continue;
+		}
+		const test_drawing_t* drawing = &__drawings[__drawing_of[i]];
+		const MICROVG_PATH_HEADER_t* header = (const MICROVG_PATH_HEADER_t*)(const void*)element->path;
+
+		// the same commands, the parameters within the float rounding (morphing)
+		HOST_TEST_CHECK_EQUAL(header->data_size, drawing->path_length);
+		const uint8_t* data = ((const uint8_t*)element->path) + header->data_offset;
+		float expected[MAX_PATH_SIZE / sizeof(float)];
+		float actual[MAX_PATH_SIZE / sizeof(float)];
+		(void)memcpy(expected, data, drawing->path_length);
+		(void)memcpy(actual, drawing->path, drawing->path_length);
+		HOST_TEST_CHECK(__max_relative_error(actual, expected, drawing->path_length / sizeof(float)) <= TOLERANCE);
+
+		// the bounds of a morphed path hold the bounds of both paths (LLVG_PATH_IMPL_mergePaths())
+		float bounds[4] = { header->bounds_xmin, header->bounds_ymin, header->bounds_xmax, header->bounds_ymax };
+		for (uint32_t k = 0; k < 4u; k++) {
+			float outside = ((k < 2u) ? (drawing->bounds[k] - bounds[k]) : (bounds[k] - drawing->bounds[k])) / fmaxf(1.0f, fabsf(bounds[k]));
+			HOST_TEST_CHECK(outside <= TOLERANCE);
+		}
+
+		float matrix[LLVG_MATRIX_SIZE];
+		LLVG_MATRIX_IMPL_copy(matrix, (jfloat*)global);
+		LLVG_MATRIX_IMPL_concatenate(matrix, (jfloat*)element->matrix);
+		HOST_TEST_CHECK(__max_relative_error(drawing->matrix, matrix, LLVG_MATRIX_SIZE) <= TOLERANCE);
+		HOST_TEST_CHECK_EQUAL(element->even_odd, drawing->even_odd);
+		HOST_TEST_CHECK_EQUAL(element->gradient >= 0, drawing->gradient);
+
+		if (element->gradient < 0) {
+			uint32_t color = DISPLAY_VGLITE_porter_duff_workaround_ARGB8888(element->color);
+			for (uint32_t shift = 0; shift < 32u; shift += 8u) {
+				int32_t delta = (int32_t)((color >> shift) & 0xffu) - (int32_t)((drawing->color >> shift) & 0xffu);
+				HOST_TEST_CHECK(abs(delta) <= 1);
+			}
+		}
+	}
+}
+
+// draws the reference as the MicroVG runtime does: the paths built at runtime, a
+// gradient initialized and filled for each drawing
+static void __draw_reference(MICROUI_GraphicsContext* gc, const VG_BLOB_header_t* blob, const float* global) {
+	vg_lite_buffer_t* target = DISPLAY_VGLITE_configure_destination(gc);
+	const VG_BLOB_gradient_t* gradients = BLOB_AT(blob, blob->gradients_offset, VG_BLOB_gradient_t);
+
+	for (uint32_t i = 0; i < __element_count; i++) {
+		const test_element_t* element = &__elements[i];
+		if (0u == (element->color >> 24)) {
+			continue;
+		}
+		vg_lite_path_t path;
+		vg_lite_matrix_t matrix;
+		__to_path(&path, element->path);
+		LLVG_MATRIX_IMPL_copy(MAP_VGLITE_MATRIX(&matrix), (jfloat*)global);
+		LLVG_MATRIX_IMPL_concatenate(MAP_VGLITE_MATRIX(&matrix), (jfloat*)element->matrix);
+		vg_lite_fill_t fill_rule = element->even_odd ? VG_LITE_FILL_EVEN_ODD : VG_LITE_FILL_NON_ZERO;
+
+		if (element->gradient < 0) {
+			vg_lite_color_t color = element->color;
+			VGLITE_PATH_update_color(&color, BLOB_BLEND);
+			HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_draw(target, &path, fill_rule, &matrix, BLOB_BLEND, color));
+		}
+		else {
+			const VG_BLOB_gradient_t* gradient = &gradients[element->gradient];
+			vg_lite_linear_gradient_t vg_lite_gradient;
+			uint32_t colors[VLC_MAX_GRAD];
+			(void)memset(&vg_lite_gradient, 0, sizeof(vg_lite_gradient));
+			for (uint32_t k = 0; k < gradient->count; k++) {
+				colors[k] = MICROVG_HELPER_apply_alpha(gradient->colors[k], element->color >> 24);
+			}
+			HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_init_grad(&vg_lite_gradient));
+			vg_lite_gradient.image.format = VG_LITE_RGBA8888;
+			HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_set_grad(&vg_lite_gradient, gradient->count, colors, (uint32_t*)gradient->stops));
+			VGLITE_PATH_update_gradient(&vg_lite_gradient, BLOB_BLEND);
+			LLVG_MATRIX_IMPL_copy(MAP_VGLITE_GRADIENT_MATRIX(&vg_lite_gradient), MAP_VGLITE_MATRIX(&matrix));
+			LLVG_MATRIX_IMPL_concatenate(MAP_VGLITE_GRADIENT_MATRIX(&vg_lite_gradient), (jfloat*)gradient->matrix);
+
+			// the ramp in the flash (or the static ramp) and the matrix of the blob drawing
+			const test_drawing_t* drawing = &__drawings[__drawing_of[i]];
+			HOST_TEST_CHECK(0 == memcmp(vg_lite_gradient.image.memory, drawing->ramp, sizeof(drawing->ramp)));
+			HOST_TEST_CHECK(__max_relative_error(drawing->gradient_matrix, (float*)vg_lite_gradient.matrix.m, LLVG_MATRIX_SIZE) <= TOLERANCE);
+			__ramps_checked++;
+
+			HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_draw_gradient(target, &path, fill_rule, &matrix, &vg_lite_gradient, BLOB_BLEND));
+			HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_finish());
+			HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_clear_grad(&vg_lite_gradient));
+		}
+	}
+	HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_finish());
+}
+
+static void __test_image(const char* image) {
+	char name[256];
+	MICROUI_GraphicsContext gc;
+	(void)snprintf(name, sizeof(name), "/%s", image);
+	const VG_BLOB_header_t* blob = VG_BLOB_find(name);
+	HOST_TEST_CHECK(NULL != blob);
+
+	float global[LLVG_MATRIX_SIZE];
+	LLVG_MATRIX_IMPL_setScale(global, (float)WIDTH / blob->width, (float)HEIGHT / blob->height);
+
+	for (uint32_t t = 0; t < (sizeof(__times) / sizeof(__times[0])); t++) {
+		__dump(image, __times[t]);
+
+		// the blob drawing, recorded
+		(void)memset(__blob_pixels, 0, sizeof(__blob_pixels));
+		HOST_MICROUI_init(&gc, __blob_pixels, WIDTH, HEIGHT);
+		__recording = true;
+		__drawing = true;
+		__drawing_count = 0;
+		HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, VG_BLOB_draw(DISPLAY_VGLITE_configure_destination(&gc), blob, global, __times[t], 0xffu));
+		HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, vg_lite_finish());
+		__recording = false;
+		__check_drawings(global);
+
+		// the pixels of the reference drawing
+		(void)memset(__reference_pixels, 0, sizeof(__reference_pixels));
+		HOST_MICROUI_init(&gc, __reference_pixels, WIDTH, HEIGHT);
+		__draw_reference(&gc, blob, global);
+		uint32_t pixels = 0;
+		uint32_t max_delta = 0;
+		for (uint32_t i = 0; i < (WIDTH * HEIGHT); i++) {
+			if (__blob_pixels[i] != __reference_pixels[i]) {
+				uint32_t delta = (uint32_t)abs((int32_t)(__blob_pixels[i] >> 11) - (int32_t)(__reference_pixels[i] >> 11));
+				max_delta = (delta > max_delta) ? delta : max_delta;
+				pixels++;
+			}
+		}
+		(void)printf("%s t=%5d: %2u drawings, %u pixels differ (red delta %u)\n", image, (int)__times[t], __drawing_count, pixels, max_delta);
+		HOST_TEST_CHECK(pixels <= MAX_PIXELS);
+		HOST_TEST_CHECK(max_delta <= MAX_RED_DELTA);
+
+		for (uint32_t i = 0; i < __element_count; i++) {
+			free(__elements[i].path);
+		}
+	}
+}
+
+static void __test_check(void) {
+	uint32_t count;
+	const VG_BLOB_image_t* images = VG_BLOB_get_images(&count);
+	static uint8_t copy[1u << 20] __attribute__((aligned(64)));
+	bool gradient_checked = false;
+
+	for (uint32_t i = 0; i < count; i++) {
+		const VG_BLOB_header_t* blob = (const VG_BLOB_header_t*)(const void*)images[i].blob;
+		HOST_TEST_CHECK(VG_BLOB_check(blob));
+		HOST_TEST_CHECK(blob->size <= sizeof(copy));
+		VG_BLOB_header_t* header = (VG_BLOB_header_t*)(void*)copy;
+
+		(void)memcpy(copy, blob, blob->size);
+		header->max_depth = VG_BLOB_MAX_DEPTH + 1u;
+		HOST_TEST_CHECK(!VG_BLOB_check(header));
+		(void)memcpy(copy, blob, blob->size);
+		header->max_path_size = VG_BLOB_MORPH_BUFFER_SIZE + 1u;
+		HOST_TEST_CHECK(!VG_BLOB_check(header));
+
+		// a gradient with more colors than VG_BLOB_draw() copies
+		for (uint32_t g = 0; g < blob->gradient_count; g++) {
+			VG_BLOB_gradient_t* gradient = &((VG_BLOB_gradient_t*)(void*)(copy + blob->gradients_offset))[g];
+			(void)memcpy(copy, blob, blob->size);
+			gradient->count = VLC_MAX_GRAD;
+			HOST_TEST_CHECK(VG_BLOB_check(header));
+			gradient->count = VLC_MAX_GRAD + 1u;
+			HOST_TEST_CHECK(!VG_BLOB_check(header));
+			gradient->count = 0u;
+			HOST_TEST_CHECK(!VG_BLOB_check(header));
+			gradient_checked = true;
+		}
+	}
+	HOST_TEST_CHECK(gradient_checked);
+}
+
+static void __bench(const char* image) {
+	char name[256];
+	MICROUI_GraphicsContext gc;
+	(void)snprintf(name, sizeof(name), "/%s", image);
+	HOST_MICROUI_init(&gc, __blob_pixels, WIDTH, HEIGHT);
+	vg_lite_buffer_t* target = DISPLAY_VGLITE_configure_destination(&gc);
+
+	uint64_t start = HOST_TEST_now_ns();
+	const VG_BLOB_header_t* blob = NULL;
+	for (uint32_t i = 0; i < BENCH_FINDS; i++) {
+		blob = VG_BLOB_find(name);
+		__asm__ volatile("" ::: "memory");
+	}
+	uint64_t find_ns = HOST_TEST_now_ns() - start;
+
+	float global[LLVG_MATRIX_SIZE];
+	LLVG_MATRIX_IMPL_setScale(global, (float)WIDTH / blob->width, (float)HEIGHT / blob->height);
+	uint32_t frames = 0;
+	__drawing = false;
+	start = HOST_TEST_now_ns();
+	for (int32_t t = 0; t < (int32_t)blob->duration; t += 7) {
+		HOST_TEST_CHECK_EQUAL(VG_LITE_SUCCESS, VG_BLOB_draw(target, blob, global, t, 0xffu));
+		frames++;
+	}
+	uint64_t frame_ns = HOST_TEST_now_ns() - start;
+	__drawing = true;
+	(void)printf("bench %s: find %.0f ns, frame evaluation %.1f us, %u bytes\n", image, (double)find_ns / BENCH_FINDS,
+			(double)frame_ns / frames / 1000.0, blob->size);
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(int argc, char* argv[]) {
+	HOST_TEST_CHECK(5 <= argc);
+	__python = argv[1];
+	__compiler = argv[2];
+	__folder = argv[3];
+
+	DISPLAY_VGLITE_init();
+	__test_check();
+	for (int i = 4; i < argc; i++) {
+		__test_image(argv[i]);
+	}
+	(void)printf("%u gradient ramps checked\n", __ramps_checked);
+	HOST_TEST_CHECK(0u < __ramps_checked);
+	for (int i = 4; i < argc; i++) {
+		__bench(argv[i]);
+	}
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
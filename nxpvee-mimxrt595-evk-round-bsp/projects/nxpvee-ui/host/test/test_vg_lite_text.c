@@ -0,0 +1,305 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host test and benchmark of the raster text rendering of vg_lite_text.c:
+ * the glyphs drawn from the span cache are the glyphs decoded by mcufont, a glyph
+ * is decoded once per draw at most, and the glyphs that cannot be cached (too
+ * many spans, too large) do not evict the cached ones.
+ *
+ * The font is synthetic: its glyphs are 4-bit bitmaps decoded pixel by pixel into
+ * runs of the same alpha, like the mcufont RLE decoder does.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <string.h>
+
+#include "host_test.h"
+
+// the static functions are tested
+#include "vg_lite_text.c"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define GLYPH_WIDTH (12)
+#define GLYPH_HEIGHT (16)
+
+/*
+ * @brief A glyph with more spans than a cache entry holds (a checkerboard).
+ */
+#define GLYPH_COMPLEX ('#')
+
+/*
+ * @brief A glyph drawn further than a span of the cache can address.
+ */
+#define GLYPH_FAR ('@')
+#define GLYPH_FAR_OFFSET (300)
+
+#define BUFFER_WIDTH (1024)
+#define BUFFER_HEIGHT (64)
+
+#define TEXT "The quick brown fox jumps over the lazy dog 0123456789"
+#define BENCHMARK_LOOPS (2000)
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+static uint32_t __decodes;
+static uint32_t __buffer_cached[BUFFER_WIDTH * BUFFER_HEIGHT];
+static uint32_t __buffer_decoded[BUFFER_WIDTH * BUFFER_HEIGHT];
+
+// -----------------------------------------------------------------------------
+// Synthetic font
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Gets the 4-bit alpha of a pixel of a glyph.
+ */
+static uint8_t __glyph_pixel(mf_char character, int x, int y) {
+	uint8_t ret;
+	if (GLYPH_COMPLEX == character) {
+		ret = (0 != ((x + y) & 1)) ? 15u : 7u;
+	}
+	else {
+		// a bar with antialiased edges whose extent depends on the character
+		int left = (int)(character % 4u);
+		int right = GLYPH_WIDTH - 1 - (int)(character % 3u);
+		ret = ((x < left) || (x > right)) ? 0u : (((x == left) || (x == right)) ? (uint8_t)(5u + (character % 7u)) : 15u);
+	}
+	return ret;
+}
+
+static uint8_t __character_width(const struct mf_font_s* font, mf_char character) {
+	(void)font;
+	(void)character;
+	return GLYPH_WIDTH;
+}
+
+static uint8_t __render_character(const struct mf_font_s* font, int16_t x0, int16_t y0, mf_char character,
+		mf_pixel_callback_t callback, void* state) {
+	(void)font;
+	__decodes++;
+	if (GLYPH_FAR == character) {
+		x0 += GLYPH_FAR_OFFSET;
+	}
+	for (int y = 0; y < GLYPH_HEIGHT; y++) {
+		int x = 0;
+		while (x < GLYPH_WIDTH) {
+			uint8_t alpha = __glyph_pixel(character, x, y);
+			int start = x;
+			while ((x < GLYPH_WIDTH) && (__glyph_pixel(character, x, y) == alpha)) {
+				x++;
+			}
+			if (0u != alpha) {
+				callback(x0 + start, y0 + y, (uint8_t)(x - start), (uint8_t)(alpha * 17u), state);
+			}
+		}
+	}
+	return GLYPH_WIDTH;
+}
+
+static const struct mf_font_s __font = {
+	.full_name = "synthetic",
+	.short_name = "synthetic",
+	.width = GLYPH_WIDTH,
+	.height = GLYPH_HEIGHT,
+	.min_x_advance = GLYPH_WIDTH,
+	.max_x_advance = GLYPH_WIDTH,
+	.line_height = GLYPH_HEIGHT,
+	.fallback_character = '?',
+	.character_width = __character_width,
+	.render_character = __render_character,
+};
+
+// -----------------------------------------------------------------------------
+// Font registry and vector fonts (not tested)
+// -----------------------------------------------------------------------------
+
+struct mf_font_s* _vg_lite_get_raster_font(vg_lite_font_t font) {
+	(void)font;
+	return (struct mf_font_s*)&__font;
+}
+
+int vg_lite_is_font_valid(vg_lite_font_t font) {
+	(void)font;
+	return 0;
+}
+
+vg_lite_error_t vg_lite_load_font_data(vg_lite_font_t font, int font_height) {
+	(void)font;
+	(void)font_height;
+	return VG_LITE_SUCCESS;
+}
+
+void vft_unload(font_face_desc_t* font_face) {
+	(void)font_face;
+}
+
+int vg_lite_vtf_draw_text(vg_lite_buffer_t* rt, int x, int y, vg_lite_blend_t blend, vg_lite_font_t font,
+		vg_lite_matrix_t* matrix, vg_lite_font_attributes_t* attributes, char* text) {
+	(void)rt; (void)x; (void)y; (void)blend; (void)font; (void)matrix; (void)attributes; (void)text;
+	return VG_LITE_NOT_SUPPORT;
+}
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+static void __init_context(text_context_t* context, uint32_t* buffer) {
+	(void)memset(context, 0, sizeof(text_context_t));
+	context->buffer.memory = buffer;
+	context->buffer.stride = BUFFER_WIDTH; // in pixels while rendering
+	context->width = BUFFER_WIDTH;
+	context->height = BUFFER_HEIGHT;
+	context->rcd_font = &__font;
+}
+
+/*
+ * @brief Draws a text with the glyph cache (character_callback).
+ */
+static void __draw_cached(const char* text, int16_t y) {
+	text_context_t context;
+	__init_context(&context, __buffer_cached);
+	int16_t x = 2;
+	for (const char* c = text; '\0' != *c; c++) {
+		x += character_callback(x, y, (mf_char)*c, &context);
+	}
+}
+
+/*
+ * @brief Draws a text decoding each glyph (no cache).
+ */
+static void __draw_decoded(const char* text, int16_t y) {
+	text_context_t context;
+	__init_context(&context, __buffer_decoded);
+	int16_t x = 2;
+	for (const char* c = text; '\0' != *c; c++) {
+		x += mf_render_character(&__font, x, y, (mf_char)*c, span_callback, &context);
+	}
+}
+
+static void __check_same_pixels(const char* text, int16_t y) {
+	(void)memset(__buffer_cached, 0, sizeof(__buffer_cached));
+	(void)memset(__buffer_decoded, 0, sizeof(__buffer_decoded));
+	__draw_cached(text, y);
+	__draw_decoded(text, y);
+	HOST_TEST_CHECK(0 == memcmp(__buffer_cached, __buffer_decoded, sizeof(__buffer_cached)));
+}
+
+static uint32_t __count_distinct(const char* text) {
+	uint32_t ret = 0;
+	for (const char* c = text; '\0' != *c; c++) {
+		if (strchr(text, *c) == c) {
+			ret++;
+		}
+	}
+	return ret;
+}
+
+static void __test_cache(void) {
+	vg_lite_text_glyph_cache_stats_t stats;
+
+	vg_lite_text_purge_glyph_cache();
+	(void)memset(&g_glyph_cache_stats, 0, sizeof(g_glyph_cache_stats));
+
+	// cold then warm: same pixels, each glyph decoded once
+	__decodes = 0;
+	__check_same_pixels("hello", 3);
+	HOST_TEST_CHECK_EQUAL(4u + 5u, __decodes); // 4 distinct glyphs cached + 5 decoded
+	__decodes = 0;
+	__check_same_pixels("hello", 3);
+	HOST_TEST_CHECK_EQUAL(5u, __decodes); // only the decoded drawing
+	vg_lite_text_get_glyph_cache_stats(&stats);
+	HOST_TEST_CHECK_EQUAL(4u, stats.misses);
+	HOST_TEST_CHECK_EQUAL(6u, stats.hits);
+	HOST_TEST_CHECK_EQUAL(0u, stats.overflows);
+
+	// clipped at the buffer edges
+	__check_same_pixels("hello", -5);
+	__check_same_pixels("hello", BUFFER_HEIGHT - 7);
+
+	// the glyphs that do not fit are decoded once per draw and evict nothing
+	for (int i = 0; i < 3; i++) {
+		__decodes = 0;
+		__draw_cached("h#@o", 3);
+		HOST_TEST_CHECK_EQUAL(2u, __decodes);
+	}
+	__check_same_pixels("h#@o", 3);
+	vg_lite_text_get_glyph_cache_stats(&stats);
+	HOST_TEST_CHECK_EQUAL(4u, stats.misses);
+	HOST_TEST_CHECK_EQUAL(2u * 4u, stats.overflows);
+	__decodes = 0;
+	__draw_cached("hello", 3);
+	HOST_TEST_CHECK_EQUAL(0u, __decodes);
+
+	// more glyphs than entries: the least recently used ones are replaced
+	__check_same_pixels(TEXT, 20);
+	vg_lite_text_purge_glyph_cache();
+	__decodes = 0;
+	__draw_cached(TEXT, 20);
+	HOST_TEST_CHECK(__count_distinct(TEXT) > VG_LITE_TEXT_GLYPH_CACHE_SIZE);
+	HOST_TEST_CHECK(__decodes >= __count_distinct(TEXT));
+}
+
+static void __benchmark(void) {
+	uint32_t glyphs = (uint32_t)strlen(TEXT) * BENCHMARK_LOOPS;
+
+	uint64_t start = HOST_TEST_now_ns();
+	for (int i = 0; i < BENCHMARK_LOOPS; i++) {
+		__draw_decoded(TEXT, 20);
+	}
+	uint64_t decoded = HOST_TEST_now_ns() - start;
+
+	// 35 distinct glyphs in 32 entries (worst case: some misses every drawing)
+	vg_lite_text_purge_glyph_cache();
+	start = HOST_TEST_now_ns();
+	for (int i = 0; i < BENCHMARK_LOOPS; i++) {
+		__draw_cached(TEXT, 20);
+	}
+	uint64_t cached = HOST_TEST_now_ns() - start;
+
+	const char* word = "hello world";
+	uint32_t word_glyphs = (uint32_t)strlen(word) * BENCHMARK_LOOPS;
+	start = HOST_TEST_now_ns();
+	for (int i = 0; i < BENCHMARK_LOOPS; i++) {
+		__draw_decoded(word, 20);
+	}
+	uint64_t word_decoded = HOST_TEST_now_ns() - start;
+	start = HOST_TEST_now_ns();
+	for (int i = 0; i < BENCHMARK_LOOPS; i++) {
+		__draw_cached(word, 20);
+	}
+	uint64_t word_cached = HOST_TEST_now_ns() - start;
+
+	(void)printf("raster text, ns per glyph (decoded / cached):\n");
+	(void)printf("  %-40s %7.1f / %7.1f\n", "54 glyphs, 35 distinct", (double)decoded / glyphs, (double)cached / glyphs);
+	(void)printf("  %-40s %7.1f / %7.1f\n", "11 glyphs, 8 distinct", (double)word_decoded / word_glyphs,
+			(double)word_cached / word_glyphs);
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(void) {
+	init_256pallet_color_table(0x00000000u, 0x00ffffffu);
+	__test_cache();
+	__benchmark();
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,340 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host round trip of the images of vglite_image.py: the PNG images of
+ * image_fixtures.py are converted by the script in each format, decoded with
+ * the layouts of display_vglite.h (display_vglite_image.c) and compared with the
+ * PNG pixels: exact for the indexed formats, within the quantization error for
+ * the premultiplied and A4 formats.
+ *
+ * The premultiplied pixels are then blended as the software drawing does
+ * (DISPLAY_VGLITE_scale_premultiplied() and DISPLAY_VGLITE_blend_premultiplied())
+ * with global alphas from 255 to 0 on several backgrounds, and compared with a
+ * floating-point blend of the decoded pixels (and of the PNG pixels for
+ * ARGB8888). A benchmark prints the pixels per second of the blit of each format,
+ * and of the blend of a straight ARGB8888 image (with divisions) for reference.
+ *
+ * Usage: test_vglite_image <folder of image_fixtures.py>
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <LLUI_DISPLAY.h>
+
+#include "display_vglite.h"
+#include "host_test.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+// same size as image_fixtures.py
+#define WIDTH (37u)
+#define HEIGHT (11u)
+
+// pixels blitted per benchmark
+#define BENCH_PIXELS (20000000u)
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+static const char* __folder;
+
+// data of the decoded image (LLUI_DISPLAY_getBufferAddress())
+static uint8_t* __data;
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+static uint8_t* __load(const char* name, size_t* size) {
+	char path[512];
+	(void)snprintf(path, sizeof(path), "%s/%s", __folder, name);
+	FILE* file = fopen(path, "rb");
+	if (NULL == file) {
+		(void)fprintf(stderr, "%s: not found (run image_fixtures.py)\n", path);
+		exit(1);
+	}
+	HOST_TEST_CHECK(0 == fseek(file, 0, SEEK_END));
+	long length = ftell(file);
+	HOST_TEST_CHECK(length > 0);
+	HOST_TEST_CHECK(0 == fseek(file, 0, SEEK_SET));
+	// malloc() alignment: the CLUT and the lines are read as uint32_t
+	uint8_t* data = malloc((size_t)length);
+	HOST_TEST_CHECK(NULL != data);
+	HOST_TEST_CHECK((size_t)length == fread(data, 1, (size_t)length, file));
+	(void)fclose(file);
+	*size = (size_t)length;
+	return data;
+}
+
+static uint32_t* __load_expected(const char* name) {
+	char file[64];
+	size_t size;
+	(void)snprintf(file, sizeof(file), "%s.argb", name);
+	uint32_t* pixels = (uint32_t*)__load(file, &size);
+	HOST_TEST_CHECK_EQUAL(WIDTH * HEIGHT * sizeof(uint32_t), size);
+	return pixels;
+}
+
+static uint8_t* __load_image(const char* name, const char* format, size_t expected_size) {
+	char file[64];
+	size_t size;
+	(void)snprintf(file, sizeof(file), "%s.%s.bin", name, format);
+	uint8_t* data = __load(file, &size);
+	HOST_TEST_CHECK_EQUAL(expected_size, size);
+	return data;
+}
+
+static uint32_t __channel_error(uint32_t color1, uint32_t color2) {
+	uint32_t error = 0;
+	for (uint32_t shift = 0; shift < 32u; shift += 8u) {
+		int32_t delta = (int32_t)((color1 >> shift) & 0xffu) - (int32_t)((color2 >> shift) & 0xffu);
+		uint32_t magnitude = (uint32_t)((delta < 0) ? -delta : delta);
+		if (magnitude > error) {
+			error = magnitude;
+		}
+	}
+	return error;
+}
+
+static uint32_t __premultiply(uint32_t color) {
+	uint32_t alpha = color >> 24;
+	uint32_t result = color & 0xff000000u;
+	for (uint32_t shift = 0; shift < 24u; shift += 8u) {
+		result |= ((((color >> shift) & 0xffu) * alpha + 127u) / 255u) << shift;
+	}
+	return result;
+}
+
+static void __test_indexed(const char* name, const char* format, MICROUI_ImageFormat image_format, uint32_t bpp) {
+	MICROUI_Image image = { .width = WIDTH, .height = HEIGHT, .format = (jbyte)image_format };
+	uint32_t* expected = __load_expected(name);
+	__data = __load_image(name, format, DISPLAY_VGLITE_CLUT_SIZE(bpp) + (HEIGHT * DISPLAY_VGLITE_INDEXED_STRIDE(WIDTH, bpp)));
+
+	HOST_TEST_CHECK_EQUAL(bpp, DISPLAY_VGLITE_get_indexed_bpp(&image));
+	for (uint32_t y = 0; y < HEIGHT; y++) {
+		for (uint32_t x = 0; x < WIDTH; x++) {
+			HOST_TEST_CHECK_EQUAL(expected[(y * WIDTH) + x], DISPLAY_VGLITE_read_indexed_pixel(&image, x, y));
+		}
+	}
+
+	free(__data);
+	free(expected);
+}
+
+// a pixel of __soft_draw_premultiplied_image() (drawing_vglite.c)
+static uint32_t __draw_premultiplied(uint32_t color, uint32_t background, uint32_t global_factor) {
+	uint32_t result = background;
+	if (256u != global_factor) {
+		color = DISPLAY_VGLITE_scale_premultiplied(color, global_factor);
+	}
+	uint32_t pixel_alpha = color >> 24;
+	if (0u != pixel_alpha) {
+		result = (0xffu != pixel_alpha) ? DISPLAY_VGLITE_blend_premultiplied(color, background) : color;
+	}
+	return result;
+}
+
+// a pixel of __soft_draw_indexed_image() (drawing_vglite.c): straight colors
+static uint32_t __draw_straight(uint32_t color, uint32_t background, uint32_t alpha) {
+	uint32_t result = background;
+	uint32_t pixel_alpha = ((color >> 24) * alpha) / 0xffu;
+	if (0u != pixel_alpha) {
+		result = (0xffu != pixel_alpha) ? LLUI_DISPLAY_blend(color, background, pixel_alpha) : color;
+	}
+	return result;
+}
+
+// floating-point blend: color premultiplied by color_alpha, then by alpha (0 to 1)
+static uint32_t __blend_reference(uint32_t color, double color_alpha, uint32_t background, double alpha) {
+	uint32_t result = 0;
+	for (uint32_t shift = 0; shift < 32u; shift += 8u) {
+		double c = (double)((color >> shift) & 0xffu) * ((24u == shift) ? 1.0 : color_alpha);
+		double b = (double)((background >> shift) & 0xffu);
+		double value = (c * alpha) + (b * (1.0 - (((double)(color >> 24) / 255.0) * alpha)));
+		result |= (uint32_t)lround(value) << shift;
+	}
+	return result;
+}
+
+static uint32_t __background(uint32_t index, uint32_t x, uint32_t y) {
+	static const uint32_t plain[] = { 0xff000000u, 0xffffffffu };
+	return (index < 2u) ? plain[index] : (0xff000000u | (((x * 7u) & 0xffu) << 16) | (((y * 23u) & 0xffu) << 8) | ((x * y) & 0xffu));
+}
+
+static void __test_blend(const char* format, MICROUI_ImageFormat image_format, uint32_t bpp) {
+	static const uint32_t alphas[] = { 255u, 128u, 1u, 0u };
+	MICROUI_Image image = { .width = WIDTH, .height = HEIGHT, .format = (jbyte)image_format };
+	uint32_t* expected = __load_expected("gradient");
+	__data = __load_image("gradient", format, HEIGHT * DISPLAY_VGLITE_PREMULTIPLIED_STRIDE(WIDTH, bpp));
+	uint32_t max_error = 0;
+	uint32_t max_png_error = 0;
+
+	for (uint32_t a = 0; a < (sizeof(alphas) / sizeof(alphas[0])); a++) {
+		uint32_t factor = DISPLAY_VGLITE_ALPHA_FACTOR(alphas[a]);
+		double alpha = (double)alphas[a] / 255.0;
+		for (uint32_t b = 0; b < 3u; b++) {
+			for (uint32_t y = 0; y < HEIGHT; y++) {
+				for (uint32_t x = 0; x < WIDTH; x++) {
+					uint32_t background = __background(b, x, y);
+					uint32_t pixel = DISPLAY_VGLITE_read_premultiplied_pixel(&image, x, y);
+					uint32_t result = __draw_premultiplied(pixel, background, factor);
+					uint32_t error = __channel_error(__blend_reference(pixel, 1.0, background, alpha), result);
+					max_error = (error > max_error) ? error : max_error;
+
+					if (DISPLAY_VGLITE_IMAGE_FORMAT_ARGB8888_PRE == image_format) {
+						uint32_t color = expected[(y * WIDTH) + x];
+						error = __channel_error(__blend_reference(color, (double)(color >> 24) / 255.0, background, alpha), result);
+						max_png_error = (error > max_png_error) ? error : max_png_error;
+					}
+				}
+			}
+		}
+	}
+	(void)printf("blend %s: error %u against the decoded pixels\n", format, max_error);
+	if (DISPLAY_VGLITE_IMAGE_FORMAT_ARGB8888_PRE == image_format) {
+		(void)printf("blend %s: error %u against the PNG\n", format, max_png_error);
+	}
+	HOST_TEST_CHECK(max_error <= 2u);
+	HOST_TEST_CHECK(max_png_error <= 2u);
+
+	free(__data);
+	free(expected);
+}
+
+static void __bench(const char* format, MICROUI_ImageFormat image_format, uint32_t bpp) {
+	MICROUI_Image image = { .width = WIDTH, .height = HEIGHT, .format = (jbyte)image_format };
+	uint32_t* straight = __load_expected("gradient");
+	__data = (0u != bpp) ? __load_image("gradient", format, HEIGHT * DISPLAY_VGLITE_PREMULTIPLIED_STRIDE(WIDTH, bpp)) : NULL;
+	volatile uint32_t sink = 0;
+
+	for (uint32_t alpha = 128u; alpha <= 255u; alpha += 127u) {
+		uint32_t factor = DISPLAY_VGLITE_ALPHA_FACTOR(alpha);
+		uint32_t checksum = 0;
+		uint64_t start = HOST_TEST_now_ns();
+		for (uint32_t i = 0; i < (BENCH_PIXELS / (WIDTH * HEIGHT)); i++) {
+			for (uint32_t y = 0; y < HEIGHT; y++) {
+				for (uint32_t x = 0; x < WIDTH; x++) {
+					uint32_t background = 0xff000000u | (i + x);
+					if (NULL != __data) {
+						checksum += __draw_premultiplied(DISPLAY_VGLITE_read_premultiplied_pixel(&image, x, y), background, factor);
+					}
+					else {
+						checksum += __draw_straight(straight[(y * WIDTH) + x], background, alpha);
+					}
+				}
+			}
+		}
+		uint64_t ns = HOST_TEST_now_ns() - start;
+		sink += checksum;
+		(void)printf("bench %-8s alpha %3u: %6.1f Mpixels/s\n", format, alpha, (double)BENCH_PIXELS * 1000.0 / (double)ns);
+	}
+	(void)sink;
+
+	free(__data);
+	free(straight);
+}
+
+static void __test_premultiplied(const char* format, MICROUI_ImageFormat image_format, uint32_t bpp, uint32_t tolerance) {
+	MICROUI_Image image = { .width = WIDTH, .height = HEIGHT, .format = (jbyte)image_format };
+	uint32_t* expected = __load_expected("gradient");
+	__data = __load_image("gradient", format, HEIGHT * DISPLAY_VGLITE_PREMULTIPLIED_STRIDE(WIDTH, bpp));
+
+	HOST_TEST_CHECK_EQUAL(bpp, DISPLAY_VGLITE_get_premultiplied_bpp(&image));
+	for (uint32_t y = 0; y < HEIGHT; y++) {
+		for (uint32_t x = 0; x < WIDTH; x++) {
+			uint32_t color = expected[(y * WIDTH) + x];
+			if (DISPLAY_VGLITE_IMAGE_FORMAT_ARGB1555_PRE == image_format) {
+				// 1-bit alpha: opaque from 128, transparent pixels are black
+				color = ((color >> 24) >= 128u) ? (color | 0xff000000u) : 0u;
+			}
+			HOST_TEST_CHECK(__channel_error(__premultiply(color), DISPLAY_VGLITE_read_premultiplied_pixel(&image, x, y)) <= tolerance);
+		}
+	}
+
+	free(__data);
+	free(expected);
+}
+
+static void __test_a4(void) {
+	uint32_t stride = ((WIDTH + 15u) & ~15u) / 2u;
+	uint32_t* expected = __load_expected("gradient");
+	uint8_t* data = __load_image("gradient", "A4", HEIGHT * stride);
+
+	for (uint32_t y = 0; y < HEIGHT; y++) {
+		for (uint32_t x = 0; x < WIDTH; x++) {
+			// the first pixel in the least significant bits
+			uint32_t alpha = (data[(y * stride) + (x / 2u)] >> ((x % 2u) * 4u)) & 0xfu;
+			HOST_TEST_CHECK(__channel_error(alpha * 0x11u, expected[(y * WIDTH) + x] >> 24) <= 8u);
+		}
+	}
+
+	free(data);
+	free(expected);
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+uint8_t* LLUI_DISPLAY_getBufferAddress(MICROUI_Image* image) {
+	(void)image;
+	return __data;
+}
+
+uint32_t LLUI_DISPLAY_blend(uint32_t foreground, uint32_t background, uint32_t alpha) {
+	uint32_t result = 0xff000000u;
+	for (uint32_t shift = 0; shift < 24u; shift += 8u) {
+		uint32_t f = (foreground >> shift) & 0xffu;
+		uint32_t b = (background >> shift) & 0xffu;
+		result |= (((f * alpha) + (b * (255u - alpha)) + 127u) / 255u) << shift;
+	}
+	return result;
+}
+
+int main(int argc, char* argv[]) {
+	HOST_TEST_CHECK(2 == argc);
+	__folder = argv[1];
+
+	__test_indexed("index2", "INDEX2", DISPLAY_VGLITE_IMAGE_FORMAT_INDEX2, 2);
+	__test_indexed("index2", "INDEX4", DISPLAY_VGLITE_IMAGE_FORMAT_INDEX4, 4);
+	__test_indexed("index2", "INDEX8", DISPLAY_VGLITE_IMAGE_FORMAT_INDEX8, 8);
+	__test_indexed("index4", "INDEX4", DISPLAY_VGLITE_IMAGE_FORMAT_INDEX4, 4);
+	__test_indexed("index4", "INDEX8", DISPLAY_VGLITE_IMAGE_FORMAT_INDEX8, 8);
+	__test_indexed("index8", "INDEX8", DISPLAY_VGLITE_IMAGE_FORMAT_INDEX8, 8);
+
+	__test_premultiplied("ARGB8888", DISPLAY_VGLITE_IMAGE_FORMAT_ARGB8888_PRE, 32, 1);
+	// 4 bits per channel: 17 levels per step, the color scaled by the rounded alpha
+	__test_premultiplied("ARGB4444", DISPLAY_VGLITE_IMAGE_FORMAT_ARGB4444_PRE, 16, 17);
+	__test_premultiplied("ARGB1555", DISPLAY_VGLITE_IMAGE_FORMAT_ARGB1555_PRE, 16, 4);
+	__test_a4();
+
+	__test_blend("ARGB8888", DISPLAY_VGLITE_IMAGE_FORMAT_ARGB8888_PRE, 32);
+	__test_blend("ARGB4444", DISPLAY_VGLITE_IMAGE_FORMAT_ARGB4444_PRE, 16);
+	__test_blend("ARGB1555", DISPLAY_VGLITE_IMAGE_FORMAT_ARGB1555_PRE, 16);
+
+	__bench("ARGB8888", DISPLAY_VGLITE_IMAGE_FORMAT_ARGB8888_PRE, 32);
+	__bench("ARGB4444", DISPLAY_VGLITE_IMAGE_FORMAT_ARGB4444_PRE, 16);
+	__bench("ARGB1555", DISPLAY_VGLITE_IMAGE_FORMAT_ARGB1555_PRE, 16);
+	__bench("straight", MICROUI_IMAGE_FORMAT_ARGB8888, 0);
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
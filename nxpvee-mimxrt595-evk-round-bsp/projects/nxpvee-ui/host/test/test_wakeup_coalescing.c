@@ -0,0 +1,190 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host simulation of the MicroJvm wake up coalescing
+ * (wakeup_coalescing.c): Java threads sleeping with periodic and jittered
+ * patterns are replayed with and without slack, and the wake ups, the added
+ * latency and the counters are compared.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include "host_test.h"
+#include "wakeup_coalescing.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+#define SIMULATION_MS (60000)
+#define THREADS (sizeof(__periods) / sizeof(__periods[0]))
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Result of a simulation.
+ */
+typedef struct {
+	uint32_t wakeups;
+	uint32_t runs;
+	int64_t max_latency_ms;
+} simulation_t;
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+// sleep periods of the Java threads (animation, clock, sensors, watchdog...)
+static const int64_t __periods[] = { 33, 100, 105, 250, 1000, 997 };
+
+static uint32_t __random = 1;
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+static int64_t __jitter(int64_t max) {
+	__random = (__random * 1103515245u) + 12345u;
+	return (int64_t)((__random >> 16) % (uint32_t)(max + 1));
+}
+
+static void __test_requests(void) {
+	wakeup_coalescing_t coalescing;
+
+	wakeup_coalescing_init(&coalescing, 10);
+	HOST_TEST_CHECK(wakeup_coalescing_request(&coalescing, 100));
+	// later: served by the armed wake up
+	HOST_TEST_CHECK(!wakeup_coalescing_request(&coalescing, 150));
+	// sooner by less than the slack: merged
+	HOST_TEST_CHECK(!wakeup_coalescing_request(&coalescing, 95));
+	HOST_TEST_CHECK(!wakeup_coalescing_request(&coalescing, 90));
+	// sooner by more than the slack: re-armed
+	HOST_TEST_CHECK(wakeup_coalescing_request(&coalescing, 89));
+	wakeup_coalescing_done(&coalescing);
+	HOST_TEST_CHECK(wakeup_coalescing_request(&coalescing, 200));
+
+	HOST_TEST_CHECK_EQUAL(6, coalescing.stats.requests);
+	HOST_TEST_CHECK_EQUAL(3, coalescing.stats.armed);
+	HOST_TEST_CHECK_EQUAL(2, coalescing.stats.avoided);
+	HOST_TEST_CHECK_EQUAL(15, coalescing.stats.added_latency_ms);
+	HOST_TEST_CHECK_EQUAL(10, coalescing.stats.max_latency_ms);
+
+	// no slack: every sooner request re-arms
+	wakeup_coalescing_init(&coalescing, 0);
+	HOST_TEST_CHECK(wakeup_coalescing_request(&coalescing, 100));
+	HOST_TEST_CHECK(!wakeup_coalescing_request(&coalescing, 100));
+	HOST_TEST_CHECK(wakeup_coalescing_request(&coalescing, 99));
+	HOST_TEST_CHECK_EQUAL(0, coalescing.stats.avoided);
+}
+
+/*
+ * Each thread sleeps until its next deadline; the threads whose deadline has
+ * been reached run at the armed wake up and request their next deadline.
+ * Before going idle, the MicroJvm requests its earliest deadline (the armed
+ * wake up has been consumed).
+ */
+static void __simulate(int64_t slack_ms, int64_t jitter_ms, simulation_t* simulation, wakeup_coalescing_stats_t* stats) {
+	wakeup_coalescing_t coalescing;
+	int64_t deadlines[THREADS];
+
+	__random = 1;
+	simulation->wakeups = 0;
+	simulation->runs = 0;
+	simulation->max_latency_ms = 0;
+	wakeup_coalescing_init(&coalescing, slack_ms);
+
+	for (uint32_t t = 0; t < THREADS; t++) {
+		deadlines[t] = __periods[t] + (int64_t)t;
+		(void)wakeup_coalescing_request(&coalescing, deadlines[t]);
+	}
+
+	while (coalescing.armed_time < SIMULATION_MS) {
+		int64_t now = coalescing.armed_time;
+		simulation->wakeups++;
+		wakeup_coalescing_done(&coalescing);
+
+		for (uint32_t t = 0; t < THREADS; t++) {
+			if (deadlines[t] <= now) {
+				int64_t latency = now - deadlines[t];
+				if (latency > simulation->max_latency_ms) {
+					simulation->max_latency_ms = latency;
+				}
+				simulation->runs++;
+				// the next sleep is computed from the actual run time
+				deadlines[t] = now + __periods[t] + __jitter(jitter_ms);
+				(void)wakeup_coalescing_request(&coalescing, deadlines[t]);
+			}
+		}
+
+		int64_t earliest = deadlines[0];
+		for (uint32_t t = 1; t < THREADS; t++) {
+			if (deadlines[t] < earliest) {
+				earliest = deadlines[t];
+			}
+		}
+		(void)wakeup_coalescing_request(&coalescing, earliest);
+
+		// a thread is never forgotten: the earliest deadline is armed
+		for (uint32_t t = 0; t < THREADS; t++) {
+			HOST_TEST_CHECK(deadlines[t] + slack_ms >= coalescing.armed_time);
+		}
+	}
+	*stats = coalescing.stats;
+}
+
+static void __test_simulation(int64_t jitter_ms) {
+	simulation_t reference;
+	wakeup_coalescing_stats_t reference_stats;
+
+	__simulate(0, jitter_ms, &reference, &reference_stats);
+	HOST_TEST_CHECK_EQUAL(0, reference.max_latency_ms);
+	HOST_TEST_CHECK_EQUAL(0, reference_stats.avoided);
+
+	int64_t slacks[] = { 5, 10, 20, 50 };
+	uint32_t wakeups = reference.wakeups;
+	for (uint32_t i = 0; i < (sizeof(slacks) / sizeof(slacks[0])); i++) {
+		simulation_t simulation;
+		wakeup_coalescing_stats_t stats;
+
+		__simulate(slacks[i], jitter_ms, &simulation, &stats);
+		HOST_TEST_CHECK(simulation.max_latency_ms <= slacks[i]);
+		HOST_TEST_CHECK(stats.max_latency_ms <= slacks[i]);
+		HOST_TEST_CHECK(stats.added_latency_ms <= (int64_t)stats.avoided * slacks[i]);
+		HOST_TEST_CHECK(stats.armed + stats.avoided <= stats.requests);
+		// a larger slack never costs more wake ups
+		HOST_TEST_CHECK(simulation.wakeups <= wakeups);
+		wakeups = simulation.wakeups;
+
+		(void)printf("jitter %2lld ms, slack %2lld ms: %5u wake ups (%5u without slack), %u runs, max latency %lld ms\n",
+				(long long)jitter_ms, (long long)slacks[i], simulation.wakeups, reference.wakeups,
+				simulation.runs, (long long)simulation.max_latency_ms);
+	}
+	HOST_TEST_CHECK(wakeups < reference.wakeups);
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(void) {
+	__test_requests();
+	__test_simulation(0);
+	__test_simulation(5);
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
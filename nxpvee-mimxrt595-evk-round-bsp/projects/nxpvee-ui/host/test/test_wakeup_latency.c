@@ -0,0 +1,246 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host test of the wake-up latency probes (wakeup_latency.c):
+ *
+ * - statistics recorded by WAKEUP_LATENCY_signal() and WAKEUP_LATENCY_woken()
+ * with a fake cycle counter at the frequency of the target;
+ * - the latency of the two wake-up paths of the POSIX OSAL, measured with the
+ * same probes on the monotonic clock: a simulated interrupt wakes up a waiting
+ * task with the binary semaphore (before the OSAL events) and with the event.
+ * The statistics of both paths are printed.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "osal.h"
+#include "host_test.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+// the cycle counter of the test
+#define WAKEUP_LATENCY_GET_CYCLES() (__get_cycles())
+#define WAKEUP_LATENCY_GET_FREQUENCY() (__frequency)
+#define WAKEUP_LATENCY_START_CYCLES() do { __started = true; } while (0)
+
+// frequency of the target core
+#define CORE_FREQUENCY (200000000u)
+
+// cycles of a number of microseconds at the frequency of the target
+#define US(us) ((uint32_t)(us) * (CORE_FREQUENCY / 1000000u))
+
+// wake-ups measured per path
+#define WAKEUPS (1000u)
+
+// time given to the task to block before the "interrupt"
+#define BLOCK_DELAY_NS (100000)
+
+#define EVENT_FLAG (1u << 0)
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+
+typedef enum {
+	PATH_SEMAPHORE,
+	PATH_EVENT,
+} test_path_t;
+
+// -----------------------------------------------------------------------------
+// Global Variables
+// -----------------------------------------------------------------------------
+
+static bool __started;
+static bool __real_clock;
+static uint32_t __fake_cycles;
+static uint32_t __frequency = CORE_FREQUENCY;
+
+static OSAL_binary_semaphore_handle_t __semaphore;
+static OSAL_event_handle_t __event;
+static OSAL_counter_semaphore_handle_t __ready;
+static test_path_t __path;
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+static uint32_t __get_cycles(void) {
+	return __real_clock ? (uint32_t)HOST_TEST_now_ns() : __fake_cycles;
+}
+
+// the module under test
+#include "wakeup_latency.c"
+
+static void __check_stats(WAKEUP_LATENCY_source_t source, uint32_t count, uint32_t min, uint32_t avg, uint32_t max) {
+	WAKEUP_LATENCY_stats_t stats;
+	WAKEUP_LATENCY_get_stats(source, &stats);
+	HOST_TEST_CHECK_EQUAL(count, stats.count);
+	HOST_TEST_CHECK_EQUAL(min, stats.min);
+	HOST_TEST_CHECK_EQUAL(avg, stats.avg);
+	HOST_TEST_CHECK_EQUAL(max, stats.max);
+}
+
+// an interrupt at a time, its task woken up after a latency (cycles)
+static void __wakeup(WAKEUP_LATENCY_source_t source, uint32_t time, uint32_t latency) {
+	__fake_cycles = time;
+	WAKEUP_LATENCY_signal(source);
+	__fake_cycles = time + latency;
+	WAKEUP_LATENCY_woken(source);
+}
+
+static void __test_stats(void) {
+	WAKEUP_LATENCY_initialize();
+	HOST_TEST_CHECK(__started);
+	for (uint32_t i = 0; i < (uint32_t)WAKEUP_LATENCY_SOURCES; i++) {
+		__check_stats((WAKEUP_LATENCY_source_t)i, 0, 0, 0, 0);
+	}
+
+	// a task woken up by another task is not measured
+	__fake_cycles = 5000;
+	WAKEUP_LATENCY_woken(WAKEUP_LATENCY_GPU);
+	__check_stats(WAKEUP_LATENCY_GPU, 0, 0, 0, 0);
+
+	__wakeup(WAKEUP_LATENCY_GPU, 1000, US(10));
+	__check_stats(WAKEUP_LATENCY_GPU, 1, 10, 10, 10);
+	__wakeup(WAKEUP_LATENCY_GPU, 90000, US(20));
+	__wakeup(WAKEUP_LATENCY_GPU, 200000, US(60));
+	__check_stats(WAKEUP_LATENCY_GPU, 3, 10, 30, 60);
+
+	// measured once per interrupt
+	WAKEUP_LATENCY_woken(WAKEUP_LATENCY_GPU);
+	__check_stats(WAKEUP_LATENCY_GPU, 3, 10, 30, 60);
+
+	// several interrupts before the task runs: measured from the last one
+	__fake_cycles = 1000000;
+	WAKEUP_LATENCY_signal(WAKEUP_LATENCY_TOUCH);
+	__fake_cycles += US(50);
+	WAKEUP_LATENCY_signal(WAKEUP_LATENCY_TOUCH);
+	__fake_cycles += US(5);
+	WAKEUP_LATENCY_woken(WAKEUP_LATENCY_TOUCH);
+	__check_stats(WAKEUP_LATENCY_TOUCH, 1, 5, 5, 5);
+
+	// the sources are independent
+	__check_stats(WAKEUP_LATENCY_VM, 0, 0, 0, 0);
+	__check_stats(WAKEUP_LATENCY_GRAPHICS, 0, 0, 0, 0);
+	__fake_cycles = 2000000;
+	WAKEUP_LATENCY_signal(WAKEUP_LATENCY_VM);
+	__wakeup(WAKEUP_LATENCY_GRAPHICS, 2000100, US(3));
+	__fake_cycles = 2000000 + US(7);
+	WAKEUP_LATENCY_woken(WAKEUP_LATENCY_VM);
+	__check_stats(WAKEUP_LATENCY_VM, 1, 7, 7, 7);
+	__check_stats(WAKEUP_LATENCY_GRAPHICS, 1, 3, 3, 3);
+	__check_stats(WAKEUP_LATENCY_GPU, 3, 10, 30, 60);
+
+	// the counter wraps around between the interrupt and the task
+	WAKEUP_LATENCY_reset();
+	__wakeup(WAKEUP_LATENCY_GPU, UINT32_MAX - US(1), US(4));
+	__check_stats(WAKEUP_LATENCY_GPU, 1, 4, 4, 4);
+
+	// below a microsecond, truncated average
+	__wakeup(WAKEUP_LATENCY_GPU, 0, 100);
+	__wakeup(WAKEUP_LATENCY_GPU, 0, US(1));
+	__check_stats(WAKEUP_LATENCY_GPU, 3, 0, 1, 4);
+
+	WAKEUP_LATENCY_dump();
+	WAKEUP_LATENCY_reset();
+	__check_stats(WAKEUP_LATENCY_GPU, 0, 0, 0, 0);
+}
+
+// the "interrupt": wakes up the task once it is about to block
+static void* __interrupt(void* args) {
+	(void)args;
+	struct timespec delay = { 0, BLOCK_DELAY_NS };
+
+	for (uint32_t i = 0; i < WAKEUPS; i++) {
+		HOST_TEST_CHECK(OSAL_OK == OSAL_counter_semaphore_take(&__ready, OSAL_INFINITE_TIME));
+		(void)nanosleep(&delay, NULL);
+		WAKEUP_LATENCY_signal(WAKEUP_LATENCY_GPU);
+		if (PATH_SEMAPHORE == __path) {
+			HOST_TEST_CHECK(OSAL_OK == OSAL_binary_semaphore_give(&__semaphore));
+		}
+		else {
+			HOST_TEST_CHECK(OSAL_OK == OSAL_event_set_from_isr(&__event, EVENT_FLAG));
+		}
+	}
+	(void)OSAL_counter_semaphore_give(&__ready);
+	return NULL;
+}
+
+static void __measure(test_path_t path, const char* name) {
+	OSAL_task_stack_declare(stack, 16 * 1024);
+	OSAL_task_handle_t interrupt;
+	WAKEUP_LATENCY_stats_t stats;
+
+	__path = path;
+	WAKEUP_LATENCY_reset();
+	HOST_TEST_CHECK(OSAL_OK == OSAL_task_create(__interrupt, (uint8_t*)"interrupt", stack, 5, NULL, &interrupt));
+	for (uint32_t i = 0; i < WAKEUPS; i++) {
+		HOST_TEST_CHECK(OSAL_OK == OSAL_counter_semaphore_give(&__ready));
+		if (PATH_SEMAPHORE == path) {
+			HOST_TEST_CHECK(OSAL_OK == OSAL_binary_semaphore_take(&__semaphore, OSAL_INFINITE_TIME));
+		}
+		else {
+			uint32_t received;
+			HOST_TEST_CHECK(OSAL_OK == OSAL_event_wait(&__event, EVENT_FLAG, &received, OSAL_INFINITE_TIME));
+			HOST_TEST_CHECK_EQUAL(EVENT_FLAG, received);
+		}
+		WAKEUP_LATENCY_woken(WAKEUP_LATENCY_GPU);
+	}
+	HOST_TEST_CHECK(OSAL_OK == OSAL_counter_semaphore_take(&__ready, OSAL_INFINITE_TIME));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_task_delete(&interrupt));
+
+	WAKEUP_LATENCY_get_stats(WAKEUP_LATENCY_GPU, &stats);
+	HOST_TEST_CHECK_EQUAL(WAKEUPS, stats.count);
+	HOST_TEST_CHECK((stats.min <= stats.avg) && (stats.avg <= stats.max));
+	(void)printf("  %-16s %6u %7u %7u %7u\n", name, stats.count, stats.min, stats.avg, stats.max);
+}
+
+static void __test_osal_paths(void) {
+	HOST_TEST_CHECK(OSAL_OK == OSAL_binary_semaphore_create((uint8_t*)"semaphore", 0, &__semaphore));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_event_create((uint8_t*)"event", &__event));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_counter_semaphore_create((uint8_t*)"ready", 0, WAKEUPS, &__ready));
+
+	// the probes on the monotonic clock
+	__real_clock = true;
+	__frequency = 1000000000u;
+	(void)printf("wake-up latency on the POSIX OSAL: path, count, min(us), avg(us), max(us)\n");
+	__measure(PATH_SEMAPHORE, "binary semaphore");
+	__measure(PATH_EVENT, "event");
+	__measure(PATH_SEMAPHORE, "binary semaphore");
+	__measure(PATH_EVENT, "event");
+
+	HOST_TEST_CHECK(OSAL_OK == OSAL_binary_semaphore_delete(&__semaphore));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_event_delete(&__event));
+	HOST_TEST_CHECK(OSAL_OK == OSAL_counter_semaphore_delete(&__ready));
+}
+
+// -----------------------------------------------------------------------------
+// Public functions
+// -----------------------------------------------------------------------------
+
+int main(void) {
+	__test_stats();
+	__test_osal_paths();
+	(void)printf("wakeup latency: OK\n");
+	return 0;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -27,6 +27,29 @@
 
 #define CPULOAD_INIT_SCHEDULE_FRACTION 10
 
+/*
+ * @brief Lengths of the windows of the per-task loads, in scheduling periods
+ * (250 ms, 1 s and 10 s with the default period). The longest window must not
+ * exceed CPULOAD_TASKS_SAMPLES (see cpuload_tasks.h).
+ */
+#ifndef CPULOAD_WINDOWS
+#define CPULOAD_WINDOWS {1, 4, 40}
+#endif
+
+/*
+ * @brief Period of the per-task load report on RTT, 0 to disable the report.
+ */
+#ifndef CPULOAD_RTT_REPORT_PERIOD_MS
+#define CPULOAD_RTT_REPORT_PERIOD_MS 1000	// ms
+#endif
+
+/*
+ * @brief RTT up channel of the report (0: terminal of the RTT viewer).
+ */
+#ifndef CPULOAD_RTT_CHANNEL
+#define CPULOAD_RTT_CHANNEL 0
+#endif
+
 #define CPULOAD_OK 					 0
 #define CPULOAD_NOT_ENABLED			-1
 #define CPULOAD_INVALID_COUNTER 	-2
@@ -68,6 +91,23 @@ void cpuload_exit_sleep(void);
  */
 uint32_t cpuload_get(void);
 
+/*
+ * Return the number of tasks of the last per-task load sample
+ */
+uint32_t cpuload_get_task_count(void);
+
+/*
+ * Return the load of a task over a window, in permille of the time (the sleep
+ * time included, see cpuload_runtime.h).
+ *
+ * @param[in] task: the task, 0 to cpuload_get_task_count() - 1.
+ * @param[in] window: the window, index in CPULOAD_WINDOWS.
+ * @param[out] name: the task name (may be NULL).
+ *
+ * @return: the load in permille, -1 when the task or the window does not exist.
+ */
+int32_t cpuload_get_task_load(uint32_t task, uint32_t window, const char** name);
+
 // -----------------------------------------------------------------------------
 // Java APIs
 // -----------------------------------------------------------------------------
@@ -82,6 +122,18 @@ uint32_t cpuload_get(void);
 
 #endif
 
+#ifndef javaCPULoadGetTaskCount
+#define javaCPULoadGetTaskCount		Java_com_microej_util_Util_getCpuLoadTaskCount
+#endif
+
+#ifndef javaCPULoadGetTaskName
+#define javaCPULoadGetTaskName		Java_com_microej_util_Util_getCpuLoadTaskName
+#endif
+
+#ifndef javaCPULoadGetTaskLoad
+#define javaCPULoadGetTaskLoad		Java_com_microej_util_Util_getCpuLoadTaskLoad
+#endif
+
 #endif	// _CPULOAD_INTERN
 
 // -----------------------------------------------------------------------------
@@ -17,6 +17,7 @@
 // -----------------------------------------------------------------------------
 
 #include "cpuload.h"
+#include "cpuload_tasks.h"
 
 // -----------------------------------------------------------------------------
 // Project functions
@@ -54,6 +55,13 @@ int32_t cpuload_impl_start_task(void);
  */
 void cpuload_impl_sleep(uint32_t ms);
 
+/*
+ * Sample the run time of the OS tasks:
+ * cpuload_tasks_start_sample(), cpuload_tasks_add() for each task, cpuload_tasks_end_sample().
+ * Return 0 when no error
+ */
+int32_t cpuload_impl_sample_tasks(cpuload_tasks_t* tasks);
+
 #endif	// CPULOAD_ENABLED
 
 #endif	// _CPULOAD_IMPL
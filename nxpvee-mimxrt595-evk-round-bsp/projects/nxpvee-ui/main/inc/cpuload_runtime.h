@@ -0,0 +1,96 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _CPULOAD_RUNTIME_H
+#define _CPULOAD_RUNTIME_H
+
+/*
+ * @file
+ * @brief Clock of the FreeRTOS run-time statistics (configGENERATE_RUN_TIME_STATS).
+ *
+ * The clock counts time at CPULOAD_RUNTIME_FREQUENCY_HZ, measured by the DWT
+ * cycle counter: on each read (FreeRTOS reads it on each context switch), the
+ * cycles elapsed since the previous read are converted at the current core clock
+ * and added to a 64-bit count. The core clock changes with the power profile
+ * (see power_manager.h): the power manager calls cpuload_runtime_clock_changed()
+ * once SystemCoreClock is updated, so that the cycles run at the previous clock
+ * are converted at the previous rate. The loads are thus shares of time, whatever
+ * the profile.
+ *
+ * The cycle counter stops while the core sleeps: the tickless idle
+ * (vPortSuppressTicksAndSleep()) calls cpuload_runtime_enter_sleep() and
+ * cpuload_runtime_exit_sleep(), which add the sleep time measured by the RTC. The
+ * sleep time is thus accounted to the idle task.
+ *
+ * FreeRTOS keeps 32-bit run-time counters: the run time of each task wraps
+ * around every 2^32 units (429 seconds at 10 MHz). The loads are computed from
+ * the differences between two samples (see cpuload_tasks.h), taken more often.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Frequency of the run-time clock (Hz), lower than the core clock.
+ */
+#ifndef CPULOAD_RUNTIME_FREQUENCY_HZ
+#define CPULOAD_RUNTIME_FREQUENCY_HZ 10000000u
+#endif
+
+// -----------------------------------------------------------------------------
+// Project functions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Starts the cycle counter (portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()).
+ */
+void cpuload_runtime_initialize(void);
+
+/*
+ * @brief Gets the 64-bit run-time clock. May be called from an interrupt.
+ *
+ * @return the time since cpuload_runtime_initialize() (CPULOAD_RUNTIME_FREQUENCY_HZ), sleep included.
+ */
+uint64_t cpuload_runtime_get_counter64(void);
+
+/*
+ * @brief Gets the 32 low bits of the run-time clock (portGET_RUN_TIME_COUNTER_VALUE()).
+ *
+ * @return the time since cpuload_runtime_initialize() (CPULOAD_RUNTIME_FREQUENCY_HZ), modulo 2^32.
+ */
+uint32_t cpuload_runtime_get_counter(void);
+
+/*
+ * @brief Called by the tickless idle before the core sleeps, interrupts disabled.
+ */
+void cpuload_runtime_enter_sleep(void);
+
+/*
+ * @brief Called by the tickless idle after the core wakes up, interrupts disabled:
+ * adds the sleep time to the clock.
+ */
+void cpuload_runtime_exit_sleep(void);
+
+/*
+ * @brief Called after a change of the core clock, once SystemCoreClock is updated:
+ * converts the cycles elapsed since the last read at the previous clock, then
+ * converts the next ones at the new clock.
+ */
+void cpuload_runtime_clock_changed(void);
+
+#endif // _CPULOAD_RUNTIME_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,147 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _CPULOAD_TASKS_H
+#define _CPULOAD_TASKS_H
+
+/*
+ * @file
+ * @brief Per-task CPU load over sliding windows.
+ *
+ * The CPU load task samples the run time of each task (see cpuload_runtime.h)
+ * every CPULOAD_SCHEDULE_TIME_MS: cpuload_tasks_start_sample(), then
+ * cpuload_tasks_add() for each task, then cpuload_tasks_end_sample(). The
+ * module keeps the run time of each task during the last CPULOAD_TASKS_SAMPLES
+ * periods: the load of a task over a window of n periods is the sum of its run
+ * times divided by the sum of the periods.
+ *
+ * The run times are 32-bit counters that wrap around: each difference between
+ * two samples is computed modulo 2^32, so a sampling period must be shorter than
+ * 2^32 cycles. The sums are 64-bit.
+ *
+ * The module is OS independent. It is updated by the CPU load task only; the
+ * loads may be read from another task (a reading may be torn).
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cpuload_conf.h"
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Maximum number of tasks. The tasks that do not fit are counted as dropped.
+ */
+#ifndef CPULOAD_TASKS_MAX
+#define CPULOAD_TASKS_MAX 16
+#endif
+
+/*
+ * @brief Number of sampling periods kept: the longest window.
+ */
+#ifndef CPULOAD_TASKS_SAMPLES
+#define CPULOAD_TASKS_SAMPLES 40
+#endif
+
+/*
+ * @brief Maximum length of a task name, '\0' included (configMAX_TASK_NAME_LEN).
+ */
+#ifndef CPULOAD_TASKS_NAME_LENGTH
+#define CPULOAD_TASKS_NAME_LENGTH 20
+#endif
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief A task and its run time during the last periods.
+ */
+typedef struct {
+	bool used;                                  // true when the entry holds a task
+	bool seen;                                  // true when the task is in the current sample
+	uint32_t id;                                // task number given by the OS
+	char name[CPULOAD_TASKS_NAME_LENGTH];       // task name
+	uint32_t last_runtime;                      // run-time counter at the last sample
+	uint32_t runtime[CPULOAD_TASKS_SAMPLES];    // run time during each period
+} cpuload_tasks_task_t;
+
+/*
+ * @brief The tasks and the periods.
+ */
+typedef struct {
+	cpuload_tasks_task_t tasks[CPULOAD_TASKS_MAX];
+	uint32_t period[CPULOAD_TASKS_SAMPLES];     // duration of each period
+	uint32_t last_total;                        // run-time clock at the last sample
+	uint32_t head;                              // index of the current period
+	uint32_t count;                             // number of complete periods (CPULOAD_TASKS_SAMPLES at most)
+	uint32_t dropped;                           // number of tasks not sampled (table full)
+	bool started;                               // false until the first sample (baselines)
+} cpuload_tasks_t;
+
+// -----------------------------------------------------------------------------
+// Project functions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Clears the tasks and the periods.
+ */
+void cpuload_tasks_init(cpuload_tasks_t* tasks);
+
+/*
+ * @brief Starts a sample.
+ *
+ * @param[in] total: the run-time clock (portGET_RUN_TIME_COUNTER_VALUE()).
+ */
+void cpuload_tasks_start_sample(cpuload_tasks_t* tasks, uint32_t total);
+
+/*
+ * @brief Adds a task to the current sample.
+ *
+ * @param[in] id: the task number, unique while the task exists.
+ * @param[in] name: the task name.
+ * @param[in] runtime: the run-time counter of the task.
+ */
+void cpuload_tasks_add(cpuload_tasks_t* tasks, uint32_t id, const char* name, uint32_t runtime);
+
+/*
+ * @brief Ends the current sample: forgets the tasks that no longer exist.
+ */
+void cpuload_tasks_end_sample(cpuload_tasks_t* tasks);
+
+/*
+ * @brief Gets a task.
+ *
+ * @param[in] index: the entry index, 0 to CPULOAD_TASKS_MAX - 1.
+ *
+ * @return the task, NULL when the entry is free or out of range.
+ */
+const cpuload_tasks_task_t* cpuload_tasks_get(const cpuload_tasks_t* tasks, uint32_t index);
+
+/*
+ * @brief Gets the load of a task over the last periods.
+ *
+ * @param[in] index: the entry index.
+ * @param[in] samples: the window length in periods, 1 to CPULOAD_TASKS_SAMPLES
+ * (shortened to the number of periods sampled so far).
+ *
+ * @return the load in permille, -1 when the entry is free or no period is complete.
+ */
+int32_t cpuload_tasks_get_load(const cpuload_tasks_t* tasks, uint32_t index, uint32_t samples);
+
+#endif // _CPULOAD_TASKS_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
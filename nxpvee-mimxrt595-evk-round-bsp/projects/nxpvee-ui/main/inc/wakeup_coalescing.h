@@ -0,0 +1,116 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _WAKEUP_COALESCING_H
+#define _WAKEUP_COALESCING_H
+
+/*
+ * @file
+ * @brief Coalescing of the MicroJvm wake up requests.
+ *
+ * Each MicroJvm schedule request accepts to be served up to a slack after its
+ * requested time. A request that falls within the slack of an already armed
+ * wake up is merged into it instead of re-arming the timer earlier: with
+ * tickless idle, every avoided re-arm is one less wake up from (deep) sleep.
+ *
+ * This logic does not depend on the OS, so it can be driven on a host by
+ * synthetic Java timer patterns. It is not thread safe: the MicroJvm task
+ * (requests) and the wake up timer (done) must serialize their calls.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -----------------------------------------------------------------------------
+// Macros and Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Maximum delay (in ms) a MicroJvm wake up may be postponed to be
+ * merged with an already armed one. 0 disables the coalescing.
+ */
+#ifndef LLMJVM_WAKEUP_SLACK_MS
+#define LLMJVM_WAKEUP_SLACK_MS 0
+#endif
+
+/*
+ * @brief Wake up time meaning "no wake up armed".
+ */
+#define WAKEUP_COALESCING_NONE INT64_MAX
+
+// -----------------------------------------------------------------------------
+// Typedefs
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Coalescing counters.
+ */
+typedef struct {
+	uint32_t requests;          // schedule requests received
+	uint32_t armed;             // requests that (re-)armed the wake up timer
+	uint32_t avoided;           // requests merged into an armed wake up
+	int64_t added_latency_ms;   // sum of the delays added by the merges
+	int64_t max_latency_ms;     // maximum delay added by a merge
+} wakeup_coalescing_stats_t;
+
+/*
+ * @brief Coalescing state.
+ */
+typedef struct {
+	int64_t slack_ms;
+	int64_t armed_time;         // absolute time of the armed wake up
+	wakeup_coalescing_stats_t stats;
+} wakeup_coalescing_t;
+
+// -----------------------------------------------------------------------------
+// Project functions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Initializes the coalescing state with no wake up armed.
+ *
+ * @param[in] coalescing: the coalescing state.
+ * @param[in] slack_ms: the accepted delay, in milliseconds.
+ */
+void wakeup_coalescing_init(wakeup_coalescing_t* coalescing, int64_t slack_ms);
+
+/*
+ * @brief Handles a schedule request.
+ *
+ * @param[in] coalescing: the coalescing state.
+ * @param[in] absolute_time: the requested wake up time, in milliseconds.
+ *
+ * @return true when the wake up timer must be armed at the requested time,
+ * false when an armed wake up already serves the request.
+ */
+bool wakeup_coalescing_request(wakeup_coalescing_t* coalescing, int64_t absolute_time);
+
+/*
+ * @brief Notifies that the armed wake up has been consumed (the MicroJvm has
+ * been woken up).
+ *
+ * @param[in] coalescing: the coalescing state.
+ */
+void wakeup_coalescing_done(wakeup_coalescing_t* coalescing);
+
+/*
+ * @brief Gets the coalescing counters of the MicroJvm wake ups (implemented
+ * by the LLMJVM port).
+ *
+ * @param[out] stats: the counters.
+ */
+void LLMJVM_FREERTOS_get_wakeup_stats(wakeup_coalescing_stats_t* stats);
+
+#endif // _WAKEUP_COALESCING_H
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -23,12 +23,15 @@
 #include "FreeRTOS.h"
 #include "timers.h"
 #include "task.h"
-#include "semphr.h"
 
 #include "LLMJVM_impl.h"
 #include "microej.h"
+#include "osal.h"
 #include "time_hardware_timer.h"
 #include "interrupts.h"
+#include "os_support.h"
+#include "wakeup_coalescing.h"
+#include "wakeup_latency.h"
 
 #include "power_manager.h"
 
@@ -43,6 +46,9 @@
 // ID for the FreeRTOS Timer
 #define WAKE_UP_TIMER_ID	42
 
+// Flag of the microJVM wake-up event
+#define WAKE_UP_EVENT_FLAG	(1u << 0)
+
 // -----------------------------------------------------------------------------
 // Static Variables
 // -----------------------------------------------------------------------------
@@ -57,9 +63,12 @@
 static int64_t LLMJVM_FREERTOS_application_time_offset = 0;
 
 /*
- * @brief Absolute time in ticks at which timer will be launched
+ * @brief Absolute time at which timer will be launched and wake up coalescing counters
  */
-static int64_t LLMJVM_FREERTOS_next_wake_up_time = INT64_MAX;
+static wakeup_coalescing_t LLMJVM_FREERTOS_wake_up_coalescing = {
+		.slack_ms = LLMJVM_WAKEUP_SLACK_MS,
+		.armed_time = WAKEUP_COALESCING_NONE,
+};
 
 /*
  * @brief Timer for scheduling next alarm
@@ -67,9 +76,9 @@ static int64_t LLMJVM_FREERTOS_next_wake_up_time = INT64_MAX;
 static TimerHandle_t LLMJVM_FREERTOS_wake_up_timer;
 
 /*
- * @brief Binary semaphore to wakeup microJVM
+ * @brief Event to wakeup microJVM
  */
-static SemaphoreHandle_t LLMJVM_FREERTOS_Semaphore;
+static OSAL_event_handle_t LLMJVM_FREERTOS_event;
 
 // -----------------------------------------------------------------------------
 // Internal functions definition
@@ -116,17 +125,7 @@ int32_t LLMJVM_IMPL_initialize() {
 		return LLMJVM_ERROR;
 	}
 
-	vSemaphoreCreateBinary(LLMJVM_FREERTOS_Semaphore);
-
-	if(LLMJVM_FREERTOS_Semaphore == NULL) {
-		return LLMJVM_ERROR;
-	}
-
-	// Created semaphore is in a state such that the first call to 'take' the semaphore would pass.
-	// Just execute a take to init it at 0.
-	// Note: From FreeRTOS version 7.6.0, the function xSemaphoreCreateBinary can be used to avoid
-	// the call to xSemaphoreTake.
-	if (xSemaphoreTake(LLMJVM_FREERTOS_Semaphore, portMAX_DELAY) != pdTRUE) {
+	if(OSAL_event_create((uint8_t*)"MicroJvm", &LLMJVM_FREERTOS_event) != OSAL_OK) {
 		return LLMJVM_ERROR;
 	}
 
@@ -151,12 +150,14 @@ int32_t LLMJVM_IMPL_scheduleRequest(int64_t absoluteTime) {
 	portBASE_TYPE xTimerChangePeriodResult;
 	portBASE_TYPE xTimerStartResult;
 
-	//First check if absolute time is lower than current schedule time
-	if(absoluteTime < LLMJVM_FREERTOS_next_wake_up_time) {
-		// Save new alarm absolute time
-		LLMJVM_FREERTOS_next_wake_up_time = absoluteTime;
+	//First check if absolute time is lower than current schedule time (minus the accepted slack)
+	// (the timer callback consumes the armed wake up concurrently)
+	OS_SUPPORT_disable_context_switching();
+	bool arm = wakeup_coalescing_request(&LLMJVM_FREERTOS_wake_up_coalescing, absoluteTime);
+	OS_SUPPORT_enable_context_switching();
 
-		// Stop current timer (no delay)
+	if(arm) {
+		// New alarm absolute time has been saved: stop current timer (no delay)
 		xTimerStop(LLMJVM_FREERTOS_wake_up_timer, 0);
 
 		// Determine relative time/tick
@@ -178,35 +179,34 @@ int32_t LLMJVM_IMPL_scheduleRequest(int64_t absoluteTime) {
 			return LLMJVM_schedule();
 		}
 	}
-	// else : nothing to do. An sooner alarm is scheduled.
+	// else : nothing to do. An sooner alarm (or one late by less than the slack) is scheduled.
 
 	return LLMJVM_OK;
 }
 
 // See the header file for the function documentation
 int32_t LLMJVM_IMPL_idleVM() {
-	portBASE_TYPE res = xSemaphoreTake(LLMJVM_FREERTOS_Semaphore, portMAX_DELAY);
+	OSAL_status_t res = OSAL_event_wait(&LLMJVM_FREERTOS_event, WAKE_UP_EVENT_FLAG, NULL, OSAL_INFINITE_TIME);
+	WAKEUP_LATENCY_woken(WAKEUP_LATENCY_VM);
 
-	return res == pdTRUE ? LLMJVM_OK : LLMJVM_ERROR;
+	return res == OSAL_OK ? LLMJVM_OK : LLMJVM_ERROR;
 }
 
 // See the header file for the function documentation
 int32_t LLMJVM_IMPL_wakeupVM() {
-	portBASE_TYPE res;
+	OSAL_status_t res;
 	if(interrupt_is_in() == MICROEJ_TRUE) {
-		portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
-		res = xSemaphoreGiveFromISR(LLMJVM_FREERTOS_Semaphore, &xHigherPriorityTaskWoken);
-		if( xHigherPriorityTaskWoken != pdFALSE ) {
-			// Force a context switch here.
-			portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-		}
+		WAKEUP_LATENCY_signal(WAKEUP_LATENCY_VM);
+		res = OSAL_event_set_from_isr(&LLMJVM_FREERTOS_event, WAKE_UP_EVENT_FLAG);
 	} else {
-		res = xSemaphoreGive(LLMJVM_FREERTOS_Semaphore);
+		res = OSAL_event_set(&LLMJVM_FREERTOS_event, WAKE_UP_EVENT_FLAG);
 	}
 
-	LLMJVM_FREERTOS_next_wake_up_time = INT64_MAX;
+	OS_SUPPORT_disable_context_switching();
+	wakeup_coalescing_done(&LLMJVM_FREERTOS_wake_up_coalescing);
+	OS_SUPPORT_enable_context_switching();
 
-	return res == pdTRUE ? LLMJVM_OK : LLMJVM_ERROR;
+	return res == OSAL_OK ? LLMJVM_OK : LLMJVM_ERROR;
 }
 
 // See the header file for the function documentation
@@ -242,6 +242,13 @@ int32_t LLMJVM_IMPL_shutdown(void) {
 	return LLMJVM_OK;
 }
 
+// See the header file for the function documentation
+void LLMJVM_FREERTOS_get_wakeup_stats(wakeup_coalescing_stats_t* stats) {
+	OS_SUPPORT_disable_context_switching();
+	*stats = LLMJVM_FREERTOS_wake_up_coalescing.stats;
+	OS_SUPPORT_enable_context_switching();
+}
+
 // -----------------------------------------------------------------------------
 // Internal functions
 // -----------------------------------------------------------------------------
@@ -9,15 +9,22 @@
 // Includes
 // -----------------------------------------------------------------------------
 
+#include <stdio.h>
+#include <string.h>
+
 #include "fsl_common.h"
 #include "fsl_debug_console.h"
 
+#include "sni.h"
+#include "SEGGER_RTT.h"
+
 #include "cpuload_impl.h"
 
 #include "mej_log.h"
 #include "mej_math.h"
 
 #include "time_hardware_timer.h"
+#include "power_governor.h"
 
 // -----------------------------------------------------------------------------
 // Static Variables
@@ -31,8 +38,48 @@ static volatile uint32_t cpuload_idle_counter;
 static volatile uint32_t cpuload_sleep_counter;
 static volatile uint32_t cpuload_ask_counter;
 static volatile int64_t sleep_start;
+
+/*
+ * @brief Run time of the tasks during the last CPULOAD_TASKS_SAMPLES periods.
+ */
+static cpuload_tasks_t cpuload_tasks;
+
+/*
+ * @brief Lengths of the windows in periods.
+ */
+static const uint32_t cpuload_windows[] = CPULOAD_WINDOWS;
+#define CPULOAD_WINDOWS_COUNT (sizeof(cpuload_windows) / sizeof(cpuload_windows[0]))
+
+#if CPULOAD_RTT_REPORT_PERIOD_MS != 0
+/*
+ * @brief Time since the last RTT report (ms).
+ */
+static uint32_t cpuload_report_time;
+#endif
 #endif
 
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+#if CPULOAD_ENABLED == 1
+
+/*
+ * @brief Gets the entry of the n-th task of the last sample.
+ *
+ * @return the entry index, CPULOAD_TASKS_MAX when there is no such task.
+ */
+static uint32_t _cpuload_get_task_entry(uint32_t task);
+
+#if CPULOAD_RTT_REPORT_PERIOD_MS != 0
+/*
+ * @brief Writes the load of each task over each window on RTT.
+ */
+static void _cpuload_report(void);
+#endif
+
+#endif	// CPULOAD_ENABLED == 1
+
 // -----------------------------------------------------------------------------
 // Project functions
 // -----------------------------------------------------------------------------
@@ -86,6 +133,7 @@ int32_t cpuload_init(void) {
 	cpuload_last_load = 0;
 	cpuload_ask_counter = 0;
 	cpuload_sleep_counter = 0;
+	cpuload_tasks_init(&cpuload_tasks);
 
 	// create task
 	if (cpuload_impl_start_task() != 0) {
@@ -134,13 +182,112 @@ void cpuload_task(void) {
 		cpuload_ask_counter++;
 		cpuload_last_load = (average_compute + last_average) / cpuload_ask_counter;
 
+		power_governor_notify_load(last_average);
+
 		// reset cpuload counter
 		cpuload_idle_counter = 0;
 		cpuload_sleep_counter = 0;
+
+		// per-task load
+		(void)cpuload_impl_sample_tasks(&cpuload_tasks);
+#if CPULOAD_RTT_REPORT_PERIOD_MS != 0
+		cpuload_report_time += cpuload_schedule_time;
+		if (cpuload_report_time >= CPULOAD_RTT_REPORT_PERIOD_MS) {
+			cpuload_report_time = 0;
+			_cpuload_report();
+		}
+#endif
+	}
+#endif
+}
+
+// See the header file for the function documentation
+uint32_t cpuload_get_task_count(void) {
+	uint32_t count = 0;
+#if CPULOAD_ENABLED == 1
+	for (uint32_t i = 0; i < CPULOAD_TASKS_MAX; i++) {
+		if (NULL != cpuload_tasks_get(&cpuload_tasks, i)) {
+			count++;
+		}
+	}
+#endif
+	return count;
+}
+
+// See the header file for the function documentation
+int32_t cpuload_get_task_load(uint32_t task, uint32_t window, const char** name) {
+#if CPULOAD_ENABLED == 1
+	uint32_t entry = _cpuload_get_task_entry(task);
+	const cpuload_tasks_task_t* t = cpuload_tasks_get(&cpuload_tasks, entry);
+
+	if ((NULL == t) || (window >= CPULOAD_WINDOWS_COUNT)) {
+		return -1;
+	}
+	if (NULL != name) {
+		*name = t->name;
 	}
+	return cpuload_tasks_get_load(&cpuload_tasks, entry, cpuload_windows[window]);
+#else
+	return -1;
 #endif
 }
 
+// -----------------------------------------------------------------------------
+// Internal functions
+// -----------------------------------------------------------------------------
+
+#if CPULOAD_ENABLED == 1
+
+// See the section 'Internal function definitions' for the function documentation
+static uint32_t _cpuload_get_task_entry(uint32_t task) {
+	uint32_t entry;
+	uint32_t n = 0;
+	for (entry = 0; entry < CPULOAD_TASKS_MAX; entry++) {
+		if (NULL != cpuload_tasks_get(&cpuload_tasks, entry)) {
+			if (n == task) {
+				break;
+			}
+			n++;
+		}
+	}
+	return entry;
+}
+
+#if CPULOAD_RTT_REPORT_PERIOD_MS != 0
+// See the section 'Internal function definitions' for the function documentation
+static void _cpuload_report(void) {
+	char line[CPULOAD_TASKS_NAME_LENGTH + (CPULOAD_WINDOWS_COUNT * 8) + 2];
+	int length = snprintf(line, sizeof(line), "%-*s", CPULOAD_TASKS_NAME_LENGTH, "task");
+	for (uint32_t w = 0; w < CPULOAD_WINDOWS_COUNT; w++) {
+		length += snprintf(line + length, sizeof(line) - length, " %5ums", (unsigned int)(cpuload_windows[w] * cpuload_schedule_time));
+	}
+	length += snprintf(line + length, sizeof(line) - length, "\n");
+	(void)SEGGER_RTT_Write(CPULOAD_RTT_CHANNEL, line, strlen(line));
+
+	for (uint32_t i = 0; i < CPULOAD_TASKS_MAX; i++) {
+		const cpuload_tasks_task_t* task = cpuload_tasks_get(&cpuload_tasks, i);
+		if (NULL != task) {
+			length = snprintf(line, sizeof(line), "%-*s", CPULOAD_TASKS_NAME_LENGTH, task->name);
+			for (uint32_t w = 0; w < CPULOAD_WINDOWS_COUNT; w++) {
+				int32_t load = cpuload_tasks_get_load(&cpuload_tasks, i, cpuload_windows[w]);
+				if (load < 0) {
+					load = 0;
+				}
+				length += snprintf(line + length, sizeof(line) - length, " %3u.%u%%", (unsigned int)(load / 10), (unsigned int)(load % 10));
+			}
+			length += snprintf(line + length, sizeof(line) - length, "\n");
+			(void)SEGGER_RTT_Write(CPULOAD_RTT_CHANNEL, line, strlen(line));
+		}
+	}
+	if (0u != cpuload_tasks.dropped) {
+		length = snprintf(line, sizeof(line), "dropped %u\n", (unsigned int)cpuload_tasks.dropped);
+		(void)SEGGER_RTT_Write(CPULOAD_RTT_CHANNEL, line, strlen(line));
+	}
+}
+#endif
+
+#endif	// CPULOAD_ENABLED == 1
+
 // -----------------------------------------------------------------------------
 // Project functions
 // -----------------------------------------------------------------------------
@@ -163,6 +310,54 @@ uint32_t javaCPULoadGet(void) {
 	return cpuload_get();
 }
 
+/*
+ * @brief Java API to get the number of tasks of the per-task CPU load
+ *
+ * @returns: see cpuload_get_task_count documentation
+ */
+jint javaCPULoadGetTaskCount(void) {
+	return (jint)cpuload_get_task_count();
+}
+
+/*
+ * @brief Java API to get the name of a task of the per-task CPU load
+ *
+ * @param[in] task: the task, 0 to getCpuLoadTaskCount() - 1
+ * @param[out] name: the name (ASCII), truncated to the array length
+ *
+ * @returns: the name length, -1 when the task does not exist
+ */
+jint javaCPULoadGetTaskName(jint task, jbyte* name) {
+	const char* task_name;
+	jint ret = -1;
+	if ((task >= 0) && (cpuload_get_task_load((uint32_t)task, 0, &task_name) >= 0)) {
+		size_t length = strnlen(task_name, CPULOAD_TASKS_NAME_LENGTH);
+		size_t max = (size_t)SNI_getArrayLength(name);
+		if (length > max) {
+			length = max;
+		}
+		(void)memcpy(name, task_name, length);
+		ret = (jint)length;
+	}
+	return ret;
+}
+
+/*
+ * @brief Java API to get the CPU load of a task over a window
+ *
+ * @param[in] task: the task, 0 to getCpuLoadTaskCount() - 1
+ * @param[in] window: the window, index in CPULOAD_WINDOWS (0: 250 ms, 1: 1 s, 2: 10 s)
+ *
+ * @returns: see cpuload_get_task_load documentation
+ */
+jint javaCPULoadGetTaskLoad(jint task, jint window) {
+	jint ret = -1;
+	if ((task >= 0) && (window >= 0)) {
+		ret = (jint)cpuload_get_task_load((uint32_t)task, (uint32_t)window, NULL);
+	}
+	return ret;
+}
+
 // -----------------------------------------------------------------------------
 // EOF
 // -----------------------------------------------------------------------------
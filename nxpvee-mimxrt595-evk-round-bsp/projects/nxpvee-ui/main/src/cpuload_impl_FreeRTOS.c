@@ -16,6 +16,8 @@
 #include "FreeRTOS.h"
 
 #include "cpuload_conf.h"
+#include "trace_ring.h"
+#include "input_log.h"
 #if CPULOAD_ENABLED == 1
 
 #include "FreeRTOS.h"
@@ -25,16 +27,32 @@
 #if (configUSE_IDLE_HOOK == 0)
 	#error configUSE_IDLE_HOOK must be defined in FreeRTOSConfig.h and equals to 1 when CPULOAD_ENABLED defined.
 #endif
+#if (configGENERATE_RUN_TIME_STATS == 0) || (configUSE_TRACE_FACILITY == 0)
+	#error configGENERATE_RUN_TIME_STATS and configUSE_TRACE_FACILITY must be defined in FreeRTOSConfig.h and equal to 1 when CPULOAD_ENABLED defined.
+#endif
 #endif	// CPULOAD_ENABLED == 1
 
 // -----------------------------------------------------------------------------
 // Macros and Defines
 // -----------------------------------------------------------------------------
 
-#define CPULOAD_STACK_SIZE			( 512 )
+#define CPULOAD_STACK_SIZE			( 1024 )	// the RTT report uses snprintf
 #define CPULOAD_TASK_PRIORITY		( configTIMER_TASK_PRIORITY - 1 )
 #define CPULOAD_TASK_STACK_SIZE		CPULOAD_STACK_SIZE/4
 
+// -----------------------------------------------------------------------------
+// Static Variables
+// -----------------------------------------------------------------------------
+
+#if CPULOAD_ENABLED == 1
+
+/*
+ * @brief Status of the tasks, filled by cpuload_impl_sample_tasks().
+ */
+static TaskStatus_t cpuload_task_status[CPULOAD_TASKS_MAX];
+
+#endif	// CPULOAD_ENABLED == 1
+
 // -----------------------------------------------------------------------------
 // Internal function definitions
 // -----------------------------------------------------------------------------
@@ -79,9 +97,34 @@ void cpuload_impl_sleep(uint32_t ms) {
 	vTaskDelay(ticks ? ticks : 1);          /* Minimum delay = 1 tick */
 }
 
+// See the header file for the function documentation
+int32_t cpuload_impl_sample_tasks(cpuload_tasks_t* tasks) {
+	uint32_t total;
+	// 0 when there are more than CPULOAD_TASKS_MAX tasks
+	UBaseType_t count = uxTaskGetSystemState(cpuload_task_status, CPULOAD_TASKS_MAX, &total);
+
+	if (0u == count) {
+		tasks->dropped++;
+		return -1;
+	}
+
+	cpuload_tasks_start_sample(tasks, total);
+	for (UBaseType_t i = 0; i < count; i++) {
+		cpuload_tasks_add(tasks, cpuload_task_status[i].xTaskNumber, cpuload_task_status[i].pcTaskName, cpuload_task_status[i].ulRunTimeCounter);
+	}
+	cpuload_tasks_end_sample(tasks);
+	return 0;
+}
+
 // See the header file for the function documentation
 void vApplicationIdleHook(void) {
 	cpuload_idle();
+#if (TRACE_RING_ENABLED == 1) && (TRACE_RING_DRAIN_ON_IDLE == 1)
+	TRACE_RING_drain();
+#endif
+#if (INPUT_LOG_ENABLED == 1) && (INPUT_LOG_DRAIN_ON_IDLE == 1)
+	INPUT_LOG_drain();
+#endif
 }
 
 #else
@@ -94,6 +137,12 @@ void vApplicationIdleHook(void) {
 # if configUSE_IDLE_HOOK != 0
 // See the header file for the function documentation
 void vApplicationIdleHook(void) {
+#if (TRACE_RING_ENABLED == 1) && (TRACE_RING_DRAIN_ON_IDLE == 1)
+	TRACE_RING_drain();
+#endif
+#if (INPUT_LOG_ENABLED == 1) && (INPUT_LOG_DRAIN_ON_IDLE == 1)
+	INPUT_LOG_drain();
+#endif
 }
 # endif
 
@@ -0,0 +1,147 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Clock of the FreeRTOS run-time statistics on the DWT cycle counter.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include "fsl_common.h"
+
+#include "cpuload_runtime.h"
+#include "time_hardware_timer.h"
+
+// -----------------------------------------------------------------------------
+// Static Variables
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Run-time clock at the last update (CPULOAD_RUNTIME_FREQUENCY_HZ).
+ */
+static uint64_t cpuload_runtime_counter;
+
+/*
+ * @brief Fraction of a unit of the run-time clock at the last update (1 / 2^32).
+ */
+static uint32_t cpuload_runtime_fraction;
+
+/*
+ * @brief Units per cycle of the current core clock (1 / 2^32).
+ */
+static uint32_t cpuload_runtime_scale;
+
+/*
+ * @brief Value of the cycle counter at the last update.
+ */
+static uint32_t cpuload_runtime_last_cycles;
+
+/*
+ * @brief RTC time when the core went to sleep (us).
+ */
+static int64_t cpuload_runtime_sleep_start_us;
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Adds the time of the cycles elapsed since the last update, or the sleep
+ * time when it is longer (the cycle counter stops while the core sleeps).
+ * Interrupts disabled.
+ *
+ * @param[in] slept: the sleep time (CPULOAD_RUNTIME_FREQUENCY_HZ), 0 when the core did not sleep.
+ *
+ * @return the updated run-time clock.
+ */
+static uint64_t __cpuload_runtime_update(uint64_t slept);
+
+/*
+ * @brief Computes the units per cycle of the current core clock.
+ */
+static void __cpuload_runtime_set_scale(void);
+
+// -----------------------------------------------------------------------------
+// Project functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void cpuload_runtime_initialize(void) {
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	cpuload_runtime_last_cycles = DWT->CYCCNT;
+	cpuload_runtime_counter = 0;
+	cpuload_runtime_fraction = 0;
+	__cpuload_runtime_set_scale();
+}
+
+// See the header file for the function documentation
+uint64_t cpuload_runtime_get_counter64(void) {
+	uint32_t regPrimask = DisableGlobalIRQ();
+	uint64_t counter = __cpuload_runtime_update(0);
+	EnableGlobalIRQ(regPrimask);
+	return counter;
+}
+
+// See the header file for the function documentation
+uint32_t cpuload_runtime_get_counter(void) {
+	return (uint32_t)cpuload_runtime_get_counter64();
+}
+
+// See the header file for the function documentation
+void cpuload_runtime_enter_sleep(void) {
+	(void)__cpuload_runtime_update(0);
+	cpuload_runtime_sleep_start_us = time_hardware_timer_getTimeUs();
+}
+
+// See the header file for the function documentation
+void cpuload_runtime_exit_sleep(void) {
+	uint64_t slept_us = (uint64_t)(time_hardware_timer_getTimeUs() - cpuload_runtime_sleep_start_us);
+	(void)__cpuload_runtime_update((slept_us * CPULOAD_RUNTIME_FREQUENCY_HZ) / 1000000u);
+}
+
+// See the header file for the function documentation
+void cpuload_runtime_clock_changed(void) {
+	uint32_t regPrimask = DisableGlobalIRQ();
+	(void)__cpuload_runtime_update(0);
+	__cpuload_runtime_set_scale();
+	EnableGlobalIRQ(regPrimask);
+}
+
+// -----------------------------------------------------------------------------
+// Internal functions
+// -----------------------------------------------------------------------------
+
+// See the section 'Internal function definitions' for the function documentation
+static uint64_t __cpuload_runtime_update(uint64_t slept) {
+	uint32_t cycles = DWT->CYCCNT;
+	// modulo 2^32: the counter is read more often than it wraps around
+	uint32_t elapsed_cycles = cycles - cpuload_runtime_last_cycles;
+	// the fraction is carried over: no time is lost in the conversion of short intervals
+	uint64_t elapsed = ((uint64_t)elapsed_cycles * cpuload_runtime_scale) + cpuload_runtime_fraction;
+
+	cpuload_runtime_last_cycles = cycles;
+	if (slept > (elapsed >> 32)) {
+		cpuload_runtime_counter += slept;
+	} else {
+		cpuload_runtime_counter += elapsed >> 32;
+		cpuload_runtime_fraction = (uint32_t)elapsed;
+	}
+	return cpuload_runtime_counter;
+}
+
+// See the section 'Internal function definitions' for the function documentation
+static void __cpuload_runtime_set_scale(void) {
+	cpuload_runtime_scale = (uint32_t)(((uint64_t)CPULOAD_RUNTIME_FREQUENCY_HZ << 32) / SystemCoreClock);
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,151 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Per-task CPU load over sliding windows.
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <string.h>
+
+#include "cpuload_tasks.h"
+
+// -----------------------------------------------------------------------------
+// Internal function definitions
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Gets the entry of a task, allocates one for a new task.
+ *
+ * @return the entry, NULL when the table is full.
+ */
+static cpuload_tasks_task_t* __cpuload_tasks_find(cpuload_tasks_t* tasks, uint32_t id);
+
+// -----------------------------------------------------------------------------
+// Project functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void cpuload_tasks_init(cpuload_tasks_t* tasks) {
+	(void)memset(tasks, 0, sizeof(cpuload_tasks_t));
+}
+
+// See the header file for the function documentation
+void cpuload_tasks_start_sample(cpuload_tasks_t* tasks, uint32_t total) {
+	if (tasks->started) {
+		tasks->head = (tasks->head + 1u) % CPULOAD_TASKS_SAMPLES;
+		// modulo 2^32
+		tasks->period[tasks->head] = total - tasks->last_total;
+		if (tasks->count < CPULOAD_TASKS_SAMPLES) {
+			tasks->count++;
+		}
+	}
+	tasks->last_total = total;
+
+	for (uint32_t i = 0; i < CPULOAD_TASKS_MAX; i++) {
+		tasks->tasks[i].seen = false;
+		tasks->tasks[i].runtime[tasks->head] = 0;
+	}
+}
+
+// See the header file for the function documentation
+void cpuload_tasks_add(cpuload_tasks_t* tasks, uint32_t id, const char* name, uint32_t runtime) {
+	cpuload_tasks_task_t* task = __cpuload_tasks_find(tasks, id);
+
+	if (NULL == task) {
+		tasks->dropped++;
+	} else {
+		if (!task->used) {
+			// new task: it has run since its creation, during the last period at most
+			task->used = true;
+			task->id = id;
+			task->last_runtime = 0;
+			(void)memset(task->runtime, 0, sizeof(task->runtime));
+		}
+		(void)strncpy(task->name, name, CPULOAD_TASKS_NAME_LENGTH - 1);
+		task->name[CPULOAD_TASKS_NAME_LENGTH - 1] = '\0';
+		task->seen = true;
+
+		if (tasks->started) {
+			// modulo 2^32
+			uint32_t delta = runtime - task->last_runtime;
+			uint32_t period = tasks->period[tasks->head];
+			task->runtime[tasks->head] = (delta > period) ? period : delta;
+		}
+		task->last_runtime = runtime;
+	}
+}
+
+// See the header file for the function documentation
+void cpuload_tasks_end_sample(cpuload_tasks_t* tasks) {
+	for (uint32_t i = 0; i < CPULOAD_TASKS_MAX; i++) {
+		if (!tasks->tasks[i].seen) {
+			tasks->tasks[i].used = false;
+		}
+	}
+	tasks->started = true;
+}
+
+// See the header file for the function documentation
+const cpuload_tasks_task_t* cpuload_tasks_get(const cpuload_tasks_t* tasks, uint32_t index) {
+	const cpuload_tasks_task_t* ret = NULL;
+	if ((index < (uint32_t)CPULOAD_TASKS_MAX) && tasks->tasks[index].used) {
+		ret = &tasks->tasks[index];
+	}
+	return ret;
+}
+
+// See the header file for the function documentation
+int32_t cpuload_tasks_get_load(const cpuload_tasks_t* tasks, uint32_t index, uint32_t samples) {
+	const cpuload_tasks_task_t* task = cpuload_tasks_get(tasks, index);
+	int32_t ret = -1;
+
+	if ((NULL != task) && (0u != tasks->count)) {
+		uint32_t n = (samples > tasks->count) ? tasks->count : samples;
+		uint64_t runtime = 0;
+		uint64_t total = 0;
+		uint32_t s = tasks->head;
+
+		for (uint32_t i = 0; i < n; i++) {
+			runtime += task->runtime[s];
+			total += tasks->period[s];
+			s = (0u == s) ? (CPULOAD_TASKS_SAMPLES - 1u) : (s - 1u);
+		}
+		ret = (0u == total) ? 0 : (int32_t)((runtime * 1000u) / total);
+	}
+	return ret;
+}
+
+// -----------------------------------------------------------------------------
+// Internal functions
+// -----------------------------------------------------------------------------
+
+// See the section 'Internal function definitions' for the function documentation
+static cpuload_tasks_task_t* __cpuload_tasks_find(cpuload_tasks_t* tasks, uint32_t id) {
+	cpuload_tasks_task_t* free_task = NULL;
+
+	for (uint32_t i = 0; i < CPULOAD_TASKS_MAX; i++) {
+		cpuload_tasks_task_t* task = &tasks->tasks[i];
+		if (task->used) {
+			if (task->id == id) {
+				return task;
+			}
+		} else if (NULL == free_task) {
+			free_task = task;
+		}
+	}
+	return free_task;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -22,6 +22,8 @@
 
 #include "monitor.h"
 #include "trace_platform.h"
+#include "trace_ring.h"
+#include "wakeup_latency.h"
 #include "touch_manager.h"
 #include "buttons_manager.h"
 #include "display_support.h"
@@ -31,6 +33,7 @@
 #include "mej_log.h"
 
 #include "power_manager.h"
+#include "power_governor.h"
 
 #if (ENABLE_SVIEW == 1)
 #include "SEGGER_SYSVIEW.h"
@@ -104,6 +107,7 @@ int main(void) {
 
 	/* Initialize power management. */
 	power_manager_init();
+	power_governor_start();
 
 	/* Use 48 MHz clock for the FLEXCOMM4 */
 	CLOCK_AttachClk(kFRO_DIV4_to_FLEXCOMM4);
@@ -126,6 +130,12 @@ int main(void) {
 	MEJ_LOG_MODULE_INFO(MAIN, "Silicon revision: %X.%X\n", silicon_rev_major, silicon_rev_minor);
 
 	/* Enable Trace */
+#if (TRACE_RING_ENABLED == 1)
+	TRACE_RING_initialize();
+#endif
+#if (WAKEUP_LATENCY_ENABLED == 1)
+	WAKEUP_LATENCY_initialize();
+#endif
 #if (ENABLE_SVIEW == 1)
 	SEGGER_SYSVIEW_Conf();
 	trace_platform_initialize();
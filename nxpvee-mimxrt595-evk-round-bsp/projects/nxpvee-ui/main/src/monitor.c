@@ -17,6 +17,9 @@
 #include "monitor.h"
 
 #include "buttons_manager.h"
+#include "jvm_stats.h"
+#include "alloc_profiler.h"
+#include "wakeup_latency.h"
 
 // -----------------------------------------------------------------------------
 // Macros and Defines
@@ -88,6 +91,18 @@ static void _monitor_task(void * pvParameters) {
 #endif
 
 		PRINTF("\n");
+
+#if JVM_STATS_ENABLED == 1
+		JVM_STATS_dump();
+#endif
+
+#if ALLOC_PROFILER_ENABLED == 1
+		ALLOC_PROFILER_dump();
+#endif
+
+#if WAKEUP_LATENCY_ENABLED == 1
+		WAKEUP_LATENCY_dump();
+#endif
 	}
 }
 
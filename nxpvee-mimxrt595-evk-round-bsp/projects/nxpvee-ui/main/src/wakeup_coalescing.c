@@ -0,0 +1,59 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+// -----------------------------------------------------------------------------
+// Includes
+// -----------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "wakeup_coalescing.h"
+
+// -----------------------------------------------------------------------------
+// Project functions
+// -----------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void wakeup_coalescing_init(wakeup_coalescing_t* coalescing, int64_t slack_ms) {
+	(void)memset(coalescing, 0, sizeof(wakeup_coalescing_t));
+	coalescing->slack_ms = slack_ms;
+	coalescing->armed_time = WAKEUP_COALESCING_NONE;
+}
+
+// See the header file for the function documentation
+bool wakeup_coalescing_request(wakeup_coalescing_t* coalescing, int64_t absolute_time) {
+	coalescing->stats.requests++;
+
+	if (absolute_time >= coalescing->armed_time) {
+		// a sooner wake up is armed: the request will be served by it
+		return false;
+	}
+
+	int64_t delay = coalescing->armed_time - absolute_time;
+	if (delay <= coalescing->slack_ms) {
+		// the armed wake up is late by less than the slack: merge
+		coalescing->stats.avoided++;
+		coalescing->stats.added_latency_ms += delay;
+		if (delay > coalescing->stats.max_latency_ms) {
+			coalescing->stats.max_latency_ms = delay;
+		}
+		return false;
+	}
+
+	coalescing->stats.armed++;
+	coalescing->armed_time = absolute_time;
+	return true;
+}
+
+// See the header file for the function documentation
+void wakeup_coalescing_done(wakeup_coalescing_t* coalescing) {
+	coalescing->armed_time = WAKEUP_COALESCING_NONE;
+}
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
@@ -0,0 +1,31 @@
+/*
+ * C
+ *
+ * Copyright 2023 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file
+ * @brief Host implementation of the VGLite OS layer, used with the software
+ * VGLite HAL (VGLiteKernel/soft). Like the HAL, it only supports the single
+ * thread driver: the driver only needs the memory allocation.
+ */
+
+#include <stdlib.h>
+
+#include "vg_lite_os.h"
+
+#if !defined(VG_DRIVER_SINGLE_THREAD)
+#error "The host VGLite OS layer only supports the single thread driver (VG_DRIVER_SINGLE_THREAD)."
+#endif /* VG_DRIVER_SINGLE_THREAD */
+
+void * vg_lite_os_malloc(uint32_t size)
+{
+    return malloc(size);
+}
+
+void vg_lite_os_free(void * memory)
+{
+    free(memory);
+}
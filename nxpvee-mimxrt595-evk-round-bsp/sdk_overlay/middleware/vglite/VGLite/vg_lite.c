@@ -28,6 +28,23 @@
 *    Copyright 2020-2022 MicroEJ Corp. This file has been modified by MicroEJ Corp.
 *    1. Add a weak the function "vg_lite_draw_notify_render_area()"
 *    2. Add "vg_lite_get_scissor()"
+*    3. Pipeline a ring of command buffers with fences: add
+*       "vg_lite_flush_async()", "vg_lite_wait_fence()",
+*       "vg_lite_fence_is_signaled()", "vg_lite_get_queue_stats()" and
+*       "vg_lite_set_command_buffer_count()"
+*    4. Add "vg_lite_get_command_stats()" and allow resizing the command
+*       buffers after the initialization
+*    5. Cache the stroke paths: add "vg_lite_get_stroke_cache_stats()" and
+*       "vg_lite_purge_stroke_cache()"
+*    6. Add "vg_lite_set_tessellation_size()" and
+*       "vg_lite_get_tessellation_stats()"
+*    7. Speed up the stroke generation (points allocated by blocks, arcs
+*       converted with a rotation recurrence). The trigonometry stays on the
+*       single precision libm functions: lookup tables or CMSIS-DSP are out
+*       of scope because this file is also built by the host HAL. No caller
+*       of "vg_lite_set_stroke()" / "vg_lite_update_stroke()" in the native
+*       layer: the strokes are checked and measured by the host test
+*       test_stroke.c.
 *
 *****************************************************************************/
 
@@ -148,6 +165,10 @@ goto ErrorHandler
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
 
 static uint32_t command_buffer_size = VG_LITE_COMMAND_BUFFER_SIZE;
+#if defined(VG_DRIVER_SINGLE_THREAD)
+/* Two command buffers like the original driver; CMDBUF_COUNT only bounds vg_lite_set_command_buffer_count(). */
+static uint32_t command_buffer_count = (CMDBUF_COUNT < 2) ? CMDBUF_COUNT : 2;
+#endif /* VG_DRIVER_SINGLE_THREAD */
 
 #define FORMAT_ALIGNMENT(stride,align) \
     { \
@@ -173,13 +194,13 @@ static uint32_t command_buffer_size = VG_LITE_COMMAND_BUFFER_SIZE;
 #define PI                           3.141592653589793238462643383279502f
 #define SINF(x)                      ((vg_lite_float_t) sin(x))
 #define COSF(x)                      ((vg_lite_float_t) cos(x))
-#define FABSF(x)                     ((vg_lite_float_t) fabs(x))
-#define SQRTF(x)                     ((vg_lite_float_t) sqrt(x))
+#define FABSF(x)                     ((vg_lite_float_t) fabsf(x))
+#define SQRTF(x)                     ((vg_lite_float_t) sqrtf(x))
 #define CLAMP(x, min, max)           (((x) < (min)) ? (min) : \
                                            ((x) > (max)) ? (max) : (x))
 #define ACOSF(x)                     ((vg_lite_float_t) acos(x))
 #define FMODF(x, y)                  ((vg_lite_float_t) fmod((x), (y)))
-#define CEILF(x)                     ((vg_lite_float_t) ceil(x))
+#define CEILF(x)                     ((vg_lite_float_t) ceilf(x))
 #define FALSE                        0
 #define TURE                         1
 #define SIZEOF(a) \
@@ -235,6 +256,10 @@ typedef uintptr_t               UINTPTR_T;
 #define FLOAT_PI_EIGHTH             0.3926990817f
 /* cos(PI/8) */
 #define FLOAT_COS_PI_EIGHTH         0.9238795325f
+/* cos(PI/4) = sin(PI/4) */
+#define FLOAT_COS_PI_QUARTER        0.7071067812f
+/* tan(PI/8) */
+#define FLOAT_TAN_PI_EIGHTH         0.4142135624f
 
 #define centerX                     tangentX
 #define centerY                     tangentY
@@ -315,7 +340,22 @@ typedef struct vg_lite_context {
     uint32_t                    command_buffer_size;
     uint32_t                    command_offset[CMDBUF_COUNT];
     uint32_t                    command_buffer_current;
-#if !defined(VG_DRIVER_SINGLE_THREAD)
+#if defined(VG_DRIVER_SINGLE_THREAD)
+    uint32_t                    command_buffer_count;         /* Number of command buffers in the ring. */
+    uint32_t                    command_fence[CMDBUF_COUNT];  /* Fence of the last submission of each command buffer. */
+    uint32_t                    last_fence;                   /* Fence of the last submitted command buffer. */
+    uint32_t                    stalls;                       /* Number of times the next command buffer was still in use. */
+    uint32_t                    submitted_bytes;              /* Command bytes submitted since the last statistics reset. */
+    uint32_t                    flushes;                      /* Command buffers submitted since the last statistics reset. */
+    uint32_t                    forced_flushes;               /* Command buffers submitted because they were full. */
+    uint32_t                    peak_usage;                   /* Largest command buffer submitted since the last statistics reset. */
+    uint32_t                    ts_draws;                     /* Tessellated drawings since the last statistics reset. */
+    uint32_t                    ts_passes;                    /* Tessellation passes of these drawings. */
+    uint32_t                    ts_split_draws;               /* Drawings larger than the tessellation window. */
+    uint32_t                    ts_max_passes;                /* Largest number of passes of a drawing. */
+    uint32_t                    ts_max_width;                 /* Largest bounding box of a drawing (clipped). */
+    uint32_t                    ts_max_height;
+#else
     uint8_t                   * context_buffer[CMDBUF_COUNT];
     uint32_t                    context_buffer_size;
     uint32_t                    context_buffer_offset[CMDBUF_COUNT];
@@ -525,8 +565,6 @@ FILE * fp;
 char filename[30];
 #endif
 
-int submit_flag = 0;
-
 static vg_lite_float_t _GetS8_NS_NB(int8_t * Data)
 {
     int8_t x0 = *((int8_t *) Data);
@@ -593,6 +631,360 @@ static uint32_t _commandSize_float[] =
     COMMANDSIZE(5, vg_lite_float_t),              /*   17: LCWARC_REL     */
 };
 
+#if defined(VG_DRIVER_SINGLE_THREAD)
+/* The stroker allocates a point per flattened segment and per stroke vertex: the points
+ * are allocated by blocks and recycled through a free list instead of using the heap for
+ * each point. The blocks are kept until vg_lite_close(). */
+#ifndef VG_LITE_POINT_BLOCK_SIZE
+#define VG_LITE_POINT_BLOCK_SIZE    64
+#endif
+
+typedef struct vg_lite_point_block {
+    struct vg_lite_point_block *    next;
+    vg_lite_path_point_t            points[VG_LITE_POINT_BLOCK_SIZE];
+} vg_lite_point_block_t;
+
+static vg_lite_point_block_t * point_blocks = NULL;
+static vg_lite_path_point_ptr free_points = NULL;
+
+static vg_lite_path_point_ptr _alloc_point(void)
+{
+    vg_lite_path_point_ptr point;
+
+    if (free_points == NULL)
+    {
+        uint32_t i;
+        vg_lite_point_block_t * block = (vg_lite_point_block_t *)vg_lite_os_malloc(sizeof(*block));
+        if (!block)
+            return NULL;
+
+        block->next = point_blocks;
+        point_blocks = block;
+        for (i = 0; i < VG_LITE_POINT_BLOCK_SIZE; i++)
+        {
+            block->points[i].next = free_points;
+            free_points = &block->points[i];
+        }
+    }
+
+    point = free_points;
+    free_points = point->next;
+    memset(point, 0, sizeof(*point));
+
+    return point;
+}
+
+static void _free_point(vg_lite_path_point_ptr point)
+{
+    if (point)
+    {
+        point->next = free_points;
+        free_points = point;
+    }
+}
+
+static void _release_points(void)
+{
+    while (point_blocks)
+    {
+        vg_lite_point_block_t * block = point_blocks;
+        point_blocks = block->next;
+        vg_lite_os_free(block);
+    }
+    free_points = NULL;
+}
+#else
+static vg_lite_path_point_ptr _alloc_point(void)
+{
+    vg_lite_path_point_ptr point = (vg_lite_path_point_ptr)vg_lite_os_malloc(sizeof(*point));
+    if (point)
+        memset(point, 0, sizeof(*point));
+
+    return point;
+}
+
+static void _free_point(vg_lite_path_point_ptr point)
+{
+    vg_lite_os_free(point);
+}
+#endif /* VG_DRIVER_SINGLE_THREAD */
+
+#if defined(VG_DRIVER_SINGLE_THREAD)
+/* The stroke paths are kept in a bounded LRU cache: vg_lite_update_stroke() reuses the
+ * stroke of an identical path (same path data and stroke parameters) instead of
+ * generating it again. The strokes are generated in the path coordinates: they do not
+ * depend on the matrix given to vg_lite_draw(). A cached stroke is shared by the paths
+ * that use it and is only freed when no path uses it anymore. An entry keeps a copy of
+ * the path data and of the dash pattern: a hit compares them, not only their hash. */
+#ifndef VG_LITE_STROKE_CACHE_ENTRIES
+#define VG_LITE_STROKE_CACHE_ENTRIES    16
+#endif
+
+#ifndef VG_LITE_STROKE_CACHE_SIZE
+#define VG_LITE_STROKE_CACHE_SIZE       (32 * 1024)
+#endif
+
+#define STROKE_HASH_OFFSET_BASIS        0xcbf29ce484222325ULL
+#define STROKE_HASH_PRIME               0x00000100000001b3ULL
+
+typedef struct vg_lite_stroke_key {
+    uint64_t                hash;           /* Path data and dash pattern. */
+    int32_t                 path_length;
+    vg_lite_format_t        format;
+    vg_lite_cap_style_t     cap_style;
+    vg_lite_join_style_t    join_style;
+    vg_lite_float_t         line_width;
+    vg_lite_float_t         miter_limit;
+    vg_lite_float_t         dash_phase;
+    uint32_t                dash_count;
+} vg_lite_stroke_key_t;
+
+typedef struct vg_lite_stroke_entry {
+    vg_lite_stroke_key_t    key;
+    void *                  data;           /* NULL when the entry is free. */
+    int32_t                 size;
+    void *                  source;         /* Path data then dash pattern of the key. */
+    uint32_t                source_size;
+    uint32_t                refs;           /* Paths that use the stroke. */
+    uint32_t                last_use;
+} vg_lite_stroke_entry_t;
+
+#if VG_LITE_STROKE_CACHE_ENTRIES > 0
+static vg_lite_stroke_entry_t stroke_cache[VG_LITE_STROKE_CACHE_ENTRIES];
+#else
+static vg_lite_stroke_entry_t * const stroke_cache = NULL;
+#endif
+static uint32_t stroke_cache_clock = 0;
+static vg_lite_stroke_cache_stats_t stroke_cache_stats = { 0 };
+
+static uint64_t _stroke_hash(uint64_t hash, const void * data, uint32_t size)
+{
+    const uint8_t * bytes = (const uint8_t *)data;
+    uint32_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= STROKE_HASH_PRIME;
+    }
+
+    return hash;
+}
+
+static void _get_stroke_key(vg_lite_path_t * path, vg_lite_stroke_key_t * key)
+{
+    vg_lite_stroke_conversion_t * stroke_conversion = &path->stroke_conversion;
+
+    /* Cleared to compare the keys with memcmp(). */
+    memset(key, 0, sizeof(*key));
+    key->path_length = path->path_length;
+    key->format = path->format;
+    key->cap_style = stroke_conversion->stroke_cap_style;
+    key->join_style = stroke_conversion->stroke_join_style;
+    key->line_width = stroke_conversion->stroke_line_width;
+    key->miter_limit = stroke_conversion->stroke_miter_limit;
+    key->hash = _stroke_hash(STROKE_HASH_OFFSET_BASIS, path->path, (uint32_t)path->path_length);
+
+    if (stroke_conversion->stroke_dash_pattern && stroke_conversion->stroke_dash_pattern_count)
+    {
+        key->dash_phase = stroke_conversion->stroke_dash_phase;
+        key->dash_count = stroke_conversion->stroke_dash_pattern_count;
+        key->hash = _stroke_hash(key->hash, stroke_conversion->stroke_dash_pattern,
+                                 key->dash_count * sizeof(vg_lite_float_t));
+    }
+}
+
+static uint32_t _get_stroke_source_size(vg_lite_stroke_key_t * key)
+{
+    return (uint32_t)key->path_length + (key->dash_count * sizeof(vg_lite_float_t));
+}
+
+/* Compares the path data and the dash pattern of the path with the copy of an entry
+ * (the key of the entry is the key of the path). */
+static int _is_stroke_source(vg_lite_stroke_entry_t * entry, vg_lite_path_t * path)
+{
+    const uint8_t * source = (const uint8_t *)entry->source;
+
+    if (memcmp(source, path->path, (size_t)path->path_length))
+        return 0;
+
+    return !entry->key.dash_count
+        || !memcmp(source + path->path_length, path->stroke_conversion.stroke_dash_pattern,
+                   entry->key.dash_count * sizeof(vg_lite_float_t));
+}
+
+static void _free_stroke_entry(vg_lite_stroke_entry_t * entry)
+{
+    stroke_cache_stats.entries--;
+    stroke_cache_stats.bytes -= (uint32_t)entry->size + entry->source_size;
+    vg_lite_os_free(entry->data);
+    vg_lite_os_free(entry->source);
+    entry->data = NULL;
+    entry->source = NULL;
+}
+
+/* Gives the cached stroke of the key to the path. */
+static int _use_cached_stroke(vg_lite_stroke_key_t * key, vg_lite_path_t * path)
+{
+    int32_t i;
+
+    for (i = 0; i < VG_LITE_STROKE_CACHE_ENTRIES; i++)
+    {
+        vg_lite_stroke_entry_t * entry = &stroke_cache[i];
+        if (entry->data && !memcmp(&entry->key, key, sizeof(*key)) && _is_stroke_source(entry, path))
+        {
+            entry->refs++;
+            entry->last_use = ++stroke_cache_clock;
+            path->stroke_path_data = entry->data;
+            path->stroke_path_size = entry->size;
+            stroke_cache_stats.hits++;
+            return 1;
+        }
+    }
+
+    stroke_cache_stats.misses++;
+    return 0;
+}
+
+/* Moves the stroke of the path to the cache with a copy of its path data and dash pattern;
+ * the least recently used strokes that are not used by a path are evicted to respect the
+ * budget (the copies are part of it). The stroke stays owned by the path when it does not
+ * fit. */
+static void _cache_stroke(vg_lite_stroke_key_t * key, vg_lite_path_t * path)
+{
+    vg_lite_stroke_entry_t * slot = NULL;
+    uint32_t source_size = _get_stroke_source_size(key);
+    uint32_t size;
+    uint8_t * source;
+    int32_t i;
+
+    size = (uint32_t)path->stroke_path_size + source_size;
+    if (!path->stroke_path_data || size > VG_LITE_STROKE_CACHE_SIZE)
+        return;
+
+    for (;;)
+    {
+        vg_lite_stroke_entry_t * lru = NULL;
+
+        slot = NULL;
+        for (i = 0; i < VG_LITE_STROKE_CACHE_ENTRIES; i++)
+        {
+            vg_lite_stroke_entry_t * entry = &stroke_cache[i];
+            if (!entry->data)
+            {
+                slot = entry;
+            }
+            else if (!entry->refs && (!lru || entry->last_use < lru->last_use))
+            {
+                lru = entry;
+            }
+        }
+
+        if (slot && stroke_cache_stats.bytes + size <= VG_LITE_STROKE_CACHE_SIZE)
+            break;
+
+        if (!lru)
+            return;
+
+        _free_stroke_entry(lru);
+        stroke_cache_stats.evictions++;
+    }
+
+    source = (uint8_t *)vg_lite_os_malloc(source_size);
+    if (!source)
+        return;
+
+    memcpy(source, path->path, (size_t)path->path_length);
+    if (key->dash_count)
+        memcpy(source + path->path_length, path->stroke_conversion.stroke_dash_pattern,
+               key->dash_count * sizeof(vg_lite_float_t));
+
+    slot->key = *key;
+    slot->data = path->stroke_path_data;
+    slot->size = path->stroke_path_size;
+    slot->source = source;
+    slot->source_size = source_size;
+    slot->refs = 1;
+    slot->last_use = ++stroke_cache_clock;
+    stroke_cache_stats.entries++;
+    stroke_cache_stats.bytes += size;
+}
+
+/* Frees the stroke of a path, or releases it when it is cached. */
+static void _release_stroke_data(void * data)
+{
+    int32_t i;
+
+    for (i = 0; i < VG_LITE_STROKE_CACHE_ENTRIES; i++)
+    {
+        if (stroke_cache[i].data == data)
+        {
+            stroke_cache[i].refs--;
+            return;
+        }
+    }
+
+    vg_lite_os_free(data);
+}
+
+static void _purge_stroke_cache(void)
+{
+    int32_t i;
+
+    for (i = 0; i < VG_LITE_STROKE_CACHE_ENTRIES; i++)
+    {
+        if (stroke_cache[i].data && !stroke_cache[i].refs)
+            _free_stroke_entry(&stroke_cache[i]);
+    }
+}
+#else
+static void _release_stroke_data(void * data)
+{
+    vg_lite_os_free(data);
+}
+#endif /* VG_DRIVER_SINGLE_THREAD */
+
+/* Frees the temporary points of the stroke generation. */
+static void _free_stroke_points(vg_lite_stroke_conversion_t * stroke_conversion)
+{
+    vg_lite_path_point_ptr temp_point;
+    vg_lite_sub_path_ptr temp_sub_path;
+
+    while(stroke_conversion->path_point_list) {
+        temp_point = stroke_conversion->path_point_list->next;
+        _free_point(stroke_conversion->path_point_list);
+        stroke_conversion->path_point_list = temp_point;
+    }
+
+    while(stroke_conversion->stroke_sub_path_list) {
+        temp_sub_path = stroke_conversion->stroke_sub_path_list->next;
+        while(stroke_conversion->stroke_sub_path_list->point_list) {
+            temp_point = stroke_conversion->stroke_sub_path_list->point_list->next;
+            _free_point(stroke_conversion->stroke_sub_path_list->point_list);
+            stroke_conversion->stroke_sub_path_list->point_list = temp_point;
+        }
+        vg_lite_os_free(stroke_conversion->stroke_sub_path_list);
+        stroke_conversion->stroke_sub_path_list = temp_sub_path;
+    }
+
+    /* Reset the generation state (the stroke parameters are kept). */
+    memset(&stroke_conversion->path_point_list, 0,
+           sizeof(*stroke_conversion) - offsetof(vg_lite_stroke_conversion_t, path_point_list));
+}
+
+/* Frees the stroke of a path. */
+static void _free_stroke(vg_lite_path_t * path)
+{
+    _free_stroke_points(&path->stroke_conversion);
+
+    if (path->stroke_path_data)
+    {
+        _release_stroke_data(path->stroke_path_data);
+        path->stroke_path_data = NULL;
+    }
+    path->stroke_path_size = 0;
+}
+
 /* Special sqrt(1.0f + x) for quick calculation when 0 <= x <= 1. */
 static vg_lite_float_t _Sqrt(
     vg_lite_float_t X
@@ -726,13 +1118,11 @@ static vg_lite_error_t _add_point_to_point_list_wdelta(
         return VG_LITE_INVALID_ARGUMENT;
 
     last_point = stroke_conversion->path_last_point;
-    point = (vg_lite_path_point_ptr)vg_lite_os_malloc(sizeof(*point));
+    point = _alloc_point();
 
     if(!point)
         return VG_LITE_OUT_OF_RESOURCES;
 
-    memset(point, 0, sizeof(*point));
-
     point->x = X;
     point->y = Y;
     point->flatten_flag = flatten_flag;
@@ -748,7 +1138,7 @@ static vg_lite_error_t _add_point_to_point_list_wdelta(
     return error;
 ErrorHandler:
 
-    vg_lite_os_free(point);
+    _free_point(point);
     point = NULL;
     return error;
 }
@@ -770,10 +1160,9 @@ static vg_lite_error_t _add_point_to_point_list(
     last_point = stroke_conversion->path_last_point;
     if (last_point == NULL)
     {
-        point = (vg_lite_path_point_ptr)vg_lite_os_malloc(sizeof(*point));
+        point = _alloc_point();
         if(!point)
             return VG_LITE_OUT_OF_RESOURCES;
-        memset(point, 0, sizeof(*point));
 
         point->x = X;
         point->y = Y;
@@ -922,7 +1311,7 @@ _flatten_quad_bezier(
         {
             upper_bound *= stroke_conversion->stroke_line_width;
         }
-        n = (uint32_t) ceil(upper_bound);
+        n = (uint32_t) CEILF(upper_bound);
     }
     else
     {
@@ -949,7 +1338,6 @@ _flatten_quad_bezier(
     if (n > 1)
     {
         vg_lite_float_t d, dsquare, dx, dy, ddx, ddy;
-        vg_lite_float_t ratioX, ratioY;
         uint32_t i;
 
         /* Step 2: Calculate deltas. */
@@ -971,11 +1359,10 @@ _flatten_quad_bezier(
         ddy += ddy;
 
         /* Step 3: Add points. */
-        ratioX = dx / X0;
-        if (ratioX < 0.0f) ratioX = -ratioX;
-        ratioY = dy / Y0;
-        if (ratioY < 0.0f) ratioY = -ratioY;
-        if (ratioX > 1.0e-6f && ratioY > 1.0e-6f)
+        /* Forward differencing, unless the steps are too small for the precision of the
+         * coordinates. Checking both axes separately would reject the segments that start
+         * horizontally or vertically (e.g. the quarters of circles). */
+        if (FABSF(dx) + FABSF(dy) > 1.0e-6f * (FABSF(X0) + FABSF(Y0)))
         {
             x = X0;
             y = Y0;
@@ -1094,7 +1481,7 @@ _flatten_cubic_bezier(
     {
         upper_bound *= stroke_conversion->stroke_line_width;
     }
-    n = (uint32_t) ceil(upper_bound);
+    n = (uint32_t) CEILF(upper_bound);
 
     if (n == 0 || n > 256)
     {
@@ -1125,7 +1512,6 @@ _flatten_cubic_bezier(
     if (n > 1)
     {
         vg_lite_float_t d, dsquare, dcube, dx, dy, ddx, ddy, dddx, dddy;
-        vg_lite_float_t ratioX, ratioY;
         uint32_t i;
 
         /* Step 2: Calculate deltas */
@@ -1154,11 +1540,10 @@ _flatten_cubic_bezier(
         ddy  += dddy;
 
         /* Step 3: Add points. */
-        ratioX = dx / X0;
-        if (ratioX < 0.0f) ratioX = -ratioX;
-        ratioY = dy / Y0;
-        if (ratioY < 0.0f) ratioY = -ratioY;
-        if (ratioX > 1.0e-6f && ratioY > 1.0e-6f)
+        /* Forward differencing, unless the steps are too small for the precision of the
+         * coordinates. Checking both axes separately would reject the segments that start
+         * horizontally or vertically (e.g. the quarters of circles). */
+        if (FABSF(dx) + FABSF(dy) > 1.0e-6f * (FABSF(X0) + FABSF(Y0)))
         {
             x = X0;
             y = Y0;
@@ -1463,12 +1848,10 @@ _add_point_to_right_stroke_point_list_tail(
     if(!stroke_conversion)
         return VG_LITE_INVALID_ARGUMENT;
 
-    point = (vg_lite_path_point_ptr)vg_lite_os_malloc(sizeof(*point));
+    point = _alloc_point();
     if(!point)
         return VG_LITE_OUT_OF_RESOURCES;
 
-    memset(point, 0, sizeof(*point));
-
     point->x = X;
     point->y = Y;
     point->curve_type = CURVE_LINE;
@@ -1496,13 +1879,11 @@ _add_point_to_left_stroke_point_list_head(
     if(!stroke_conversion)
         return VG_LITE_INVALID_ARGUMENT;
 
-    point = (vg_lite_path_point_ptr)vg_lite_os_malloc(sizeof(*point));
+    point = _alloc_point();
 
     if(!point)
         return VG_LITE_OUT_OF_RESOURCES;
 
-    memset(point, 0, sizeof(*point));
-
     point->x = X;
     point->y = Y;
     point->curve_type = CURVE_LINE;
@@ -1588,11 +1969,10 @@ _add_zero_length_stroke_sub_path(
             dy = -Point->tangentX * half_width;
         }
 
-        new_point = (vg_lite_path_point_ptr)vg_lite_os_malloc(sizeof(*new_point));
+        new_point = _alloc_point();
 
         if(!new_point)
             return VG_LITE_OUT_OF_RESOURCES;
-        memset(new_point, 0, sizeof(*new_point));
 
         new_point->x = Point->x + dx + dy;
         new_point->y = Point->y - dx + dy;
@@ -1612,11 +1992,10 @@ _add_zero_length_stroke_sub_path(
     else
     {
         /* Draw a circle. */
-        new_point = (vg_lite_path_point_ptr)vg_lite_os_malloc(sizeof(*new_point));
+        new_point = _alloc_point();
 
         if(!new_point)
             return VG_LITE_OUT_OF_RESOURCES;
-        memset(new_point, 0, sizeof(*new_point));
 
         new_point->x = Point->x + half_width;
         new_point->y = Point->y;
@@ -1753,9 +2132,9 @@ _convert_circle_arc(
     /*gceVGCMD segmentCommand;*/
     vg_lite_float_t theta1, theta_span;
     uint32_t segs;
-    vg_lite_float_t theta, theta_half, theta2;
-    vg_lite_float_t cos_theta_half;
-    vg_lite_float_t control_ratio;
+    vg_lite_float_t theta, theta_half;
+    vg_lite_float_t cos_theta, sin_theta, tan_theta_half;
+    vg_lite_float_t ux, uy, tx, length;
     vg_lite_float_t controlX, controlY, anchorX, anchorY;
     /*gctFLOAT lastX, lastY;*/
     vg_lite_path_point_ptr point, start_point, last_point;
@@ -1764,17 +2143,17 @@ _convert_circle_arc(
         return VG_LITE_INVALID_ARGUMENT;
 
     /* Converting. */
-    theta1 = _Angle(StartX - CenterX, StartY - CenterY, Radius);
     if (Half_circle)
     {
-        theta_span = FLOAT_PI;
+        /* Constant rotation of PI/4 per segment. */
         segs = 4;
-        theta = FLOAT_PI_QUARTER;
-        theta_half = FLOAT_PI_EIGHTH;
-        cos_theta_half = FLOAT_COS_PI_EIGHTH;
+        cos_theta = FLOAT_COS_PI_QUARTER;
+        sin_theta = FLOAT_COS_PI_QUARTER;
+        tan_theta_half = FLOAT_TAN_PI_EIGHTH;
     }
     else
     {
+        theta1 = _Angle(StartX - CenterX, StartY - CenterY, Radius);
         theta_span = _Angle(EndX - CenterX, EndY - CenterY, Radius) - theta1;
         if (theta_span == 0.0f)
         {
@@ -1798,28 +2177,39 @@ _convert_circle_arc(
 
         theta = theta_span / segs;
         theta_half = theta / 2.0f;
-        cos_theta_half = _Cos(theta_half);
+        cos_theta = _Cos(theta);
+        sin_theta = _Sine(theta);
+        tan_theta_half = _Sine(theta_half) / _Cos(theta_half);
     }
 
     /* Determine the segment command. */
     /*egmentCommand = gcvVGCMD_ARC_QUAD;*/
 
-    /* Generate quadratic Bezier curves. */
+    /* Radius vector of the start point. */
+    ux = StartX - CenterX;
+    uy = StartY - CenterY;
+    length = SQRTF(ux * ux + uy * uy);
+    if (length == 0.0f)
+    {
+        *point_list = NULL;
+        return error;
+    }
+    ux *= Radius / length;
+    uy *= Radius / length;
+
+    /* Generate quadratic Bezier curves: the radius vector is rotated by theta for each
+     * anchor, the control point is the intersection of the tangents at both anchors. */
     start_point = last_point = NULL;
-    control_ratio = Radius / cos_theta_half;
     while (segs-- > 0)
     {
-        theta1 += theta;
-
-        theta2 = theta1 - theta_half;
-        if (theta2 > FLOAT_PI) theta2 -= FLOAT_PI_TWO;
-        controlX = CenterX + _Cos(theta2)  * control_ratio;
-        controlY = CenterY + _Sine(theta2) * control_ratio;
+        controlX = CenterX + ux - uy * tan_theta_half;
+        controlY = CenterY + uy + ux * tan_theta_half;
 
-        theta2 = theta1;
-        if (theta2 > FLOAT_PI) theta2 -= FLOAT_PI_TWO;
-        anchorX = CenterX + _Cos(theta2)  * Radius;
-        anchorY = CenterY + _Sine(theta2) * Radius;
+        tx = ux * cos_theta - uy * sin_theta;
+        uy = ux * sin_theta + uy * cos_theta;
+        ux = tx;
+        anchorX = CenterX + ux;
+        anchorY = CenterY + uy;
 
         if (segs == 0)
         {
@@ -1829,13 +2219,11 @@ _convert_circle_arc(
         }
 
         /* Add control point. */
-        point = (vg_lite_path_point_ptr)vg_lite_os_malloc(sizeof(*point));
+        point = _alloc_point();
 
         if(!point)
             return VG_LITE_OUT_OF_RESOURCES;
 
-        memset(point, 0, sizeof(*point));
-
         point->x = controlX;
         point->y = controlY;
         point->curve_type = CURVE_QUAD_CONTROL;
@@ -1850,15 +2238,13 @@ _convert_circle_arc(
         }
 
         /* Add anchor point. */
-        point = (vg_lite_path_point_ptr)vg_lite_os_malloc(sizeof(*point));
+        point = _alloc_point();
 
         if(!point) {
             error = VG_LITE_OUT_OF_RESOURCES;
             goto ErrorHandler;
         }
 
-        memset(point, 0, sizeof(*point));
-
         point->x = anchorX;
         point->y = anchorY;
         point->curve_type = CURVE_QUAD_ANCHOR;
@@ -1876,7 +2262,7 @@ ErrorHandler:
     {
         point = start_point;
         start_point = start_point->next;
-        vg_lite_os_free(point);
+        _free_point(point);
     }
     start_point = last_point = point = NULL;
     return error;
@@ -1903,11 +2289,10 @@ _start_new_stroke_sub_path(
 
     VG_LITE_ERROR_HANDLER(_add_stroke_sub_path(stroke_conversion, &stroke_sub_path));
 
-    new_point = (vg_lite_path_point_ptr)vg_lite_os_malloc(sizeof(*new_point));
+    new_point = _alloc_point();
     if(!new_point)
         return VG_LITE_OUT_OF_RESOURCES;
 
-    memset(new_point, 0, sizeof(*new_point));
     new_point->x = X + Dx;
     new_point->y = Y + Dy;
     new_point->prev = NULL;
@@ -1916,11 +2301,10 @@ _start_new_stroke_sub_path(
 
     stroke_sub_path->point_list = stroke_conversion->last_right_stroke_point = new_point;
 
-    new_point = (vg_lite_path_point_ptr)vg_lite_os_malloc(sizeof(*new_point));
+    new_point = _alloc_point();
     if(!new_point)
         return VG_LITE_OUT_OF_RESOURCES;
 
-    memset(new_point, 0, sizeof(*new_point));
     new_point->x = X - Dx;
     new_point->y = Y - Dy;
     new_point->curve_type = CURVE_LINE;
@@ -3013,10 +3397,9 @@ _create_stroke_path(
 
                 /* Add curve. */
                 /* Add extra point to the beginning with end point's coordinates. */
-                point = (vg_lite_path_point_ptr)vg_lite_os_malloc(sizeof(*point));
+                point = _alloc_point();
                 if(!point)
                     return VG_LITE_INVALID_ARGUMENT;
-                memset(point, 0, sizeof(*point));
 
                 point->x = last_stroke_sub_path->last_point->x;
                 point->y = last_stroke_sub_path->last_point->y;
@@ -3199,8 +3582,8 @@ static vg_lite_error_t _copy_stroke_path(
                         *pfloat++ = p2->x;
                         *pfloat++ = p2->y;
                         real_size += _commandSize_float[VLC_OP_QUAD];
-                        vg_lite_os_free(p);
-                        vg_lite_os_free(p2);
+                        _free_point(p);
+                        _free_point(p2);
                     }
                 }
                 else
@@ -3250,8 +3633,7 @@ static vg_lite_error_t _initialize_stroke_dash_parameters(
     vg_lite_error_t error = VG_LITE_SUCCESS;
     uint32_t count;
     uint32_t i;
-    vg_lite_float_t *pattern_src;
-    vg_lite_float_t *pattern,*temp_pattern;
+    vg_lite_float_t *pattern;
     vg_lite_float_t length;
 
     if(!stroke_conversion)
@@ -3266,32 +3648,21 @@ static vg_lite_error_t _initialize_stroke_dash_parameters(
     /* The last pattern is ignored if the number is odd. */
     if (count & 0x1) count--;
 
-    pattern = (vg_lite_float_t *)vg_lite_os_malloc(count * sizeof(vg_lite_float_t));
-    if(!pattern)
-        return VG_LITE_OUT_OF_RESOURCES;
-
-    temp_pattern = pattern;
+    /* Sum the pattern (negative lengths count as 0): no need for a temporary copy. */
     stroke_conversion->stroke_dash_pattern_length = 0.0f;
-    pattern_src = stroke_conversion->stroke_dash_pattern;
+    pattern = stroke_conversion->stroke_dash_pattern;
 
-    for (i = 0; i < count; i++, pattern++, pattern_src++)
+    for (i = 0; i < count; i++, pattern++)
     {
-        if (*pattern_src < 0.0f)
-        {
-            *pattern = 0.0f;
-        }
-        else
+        if (*pattern > 0.0f)
         {
-            *pattern = *pattern_src;
+            stroke_conversion->stroke_dash_pattern_length += *pattern;
         }
-        stroke_conversion->stroke_dash_pattern_length += *pattern;
     }
 
     if (stroke_conversion->stroke_dash_pattern_length < FLOAT_EPSILON)
     {
         stroke_conversion->stroke_dash_pattern_count = 0;
-        vg_lite_os_free(temp_pattern);
-        temp_pattern = NULL;
         return error;
     }
 
@@ -3316,9 +3687,6 @@ static vg_lite_error_t _initialize_stroke_dash_parameters(
     stroke_conversion->stroke_dash_initial_index = i;
     stroke_conversion->stroke_dash_initial_length = *pattern - length;
 
-    vg_lite_os_free(temp_pattern);
-    temp_pattern = NULL;
-
     return error;
 }
 
@@ -3328,19 +3696,24 @@ vg_lite_error_t vg_lite_update_stroke(
 {
     vg_lite_error_t error = VG_LITE_SUCCESS;
     vg_lite_stroke_conversion_t * stroke_conversion;
+#if defined(VG_DRIVER_SINGLE_THREAD)
+    vg_lite_stroke_key_t key;
+#endif /* VG_DRIVER_SINGLE_THREAD */
 
     if(!path)
         return VG_LITE_INVALID_ARGUMENT;
 
     stroke_conversion = &path->stroke_conversion;
 
-    /* Free the stroke. */
-    if (path->stroke_path_data)
-    {
-        vg_lite_os_free(path->stroke_path_data);
-        /* Reset the stroke. */
-        path->stroke_path_data = NULL;
-    }
+    /* Free the previous stroke. */
+    _free_stroke(path);
+
+#if defined(VG_DRIVER_SINGLE_THREAD)
+    /* Reuse the stroke of an identical path. */
+    _get_stroke_key(path, &key);
+    if (_use_cached_stroke(&key, path))
+        return error;
+#endif /* VG_DRIVER_SINGLE_THREAD */
 
     if (stroke_conversion->stroke_line_width >= FLOAT_FAT_LINE_WIDTH
         &&  stroke_conversion->stroke_line_width >= 1.0f)
@@ -3352,6 +3725,13 @@ vg_lite_error_t vg_lite_update_stroke(
     VG_LITE_RETURN_ERROR(_create_stroke_path(stroke_conversion));
     VG_LITE_RETURN_ERROR(_copy_stroke_path(stroke_conversion, path));
 
+    /* Only the stroke path is needed to draw. */
+    _free_stroke_points(stroke_conversion);
+
+#if defined(VG_DRIVER_SINGLE_THREAD)
+    _cache_stroke(&key, path);
+#endif /* VG_DRIVER_SINGLE_THREAD */
+
     return error;
 }
 
@@ -3689,30 +4069,28 @@ vg_lite_error_t _allocate_command_buffer(uint32_t size)
 {
     vg_lite_kernel_allocate_t allocate;
     vg_lite_error_t error = VG_LITE_SUCCESS;
+    uint32_t i;
 
     if(size == 0)
         return VG_LITE_SUCCESS;
 
     allocate.bytes = size;
     allocate.contiguous = 1;
-    VG_LITE_RETURN_ERROR(vg_lite_kernel(VG_LITE_ALLOCATE, &allocate));
 
-    s_context.context.command_buffer[0] = allocate.memory_handle;
-    s_context.context.command_buffer_logical[0] = allocate.memory;
-    s_context.context.command_buffer_physical[0] = allocate.memory_gpu;
-
-    VG_LITE_RETURN_ERROR(vg_lite_kernel(VG_LITE_ALLOCATE, &allocate));
+    for (i = 0; i < command_buffer_count; i++) {
+        VG_LITE_RETURN_ERROR(vg_lite_kernel(VG_LITE_ALLOCATE, &allocate));
 
-    s_context.context.command_buffer[1] = allocate.memory_handle;
-    s_context.context.command_buffer_logical[1] = allocate.memory;
-    s_context.context.command_buffer_physical[1] = allocate.memory_gpu;
+        s_context.context.command_buffer[i] = allocate.memory_handle;
+        s_context.context.command_buffer_logical[i] = allocate.memory;
+        s_context.context.command_buffer_physical[i] = allocate.memory_gpu;
 
-    s_context.command_buffer[0] = s_context.context.command_buffer_logical[0];
-    s_context.command_buffer[1] = s_context.context.command_buffer_logical[1];
+        s_context.command_buffer[i] = s_context.context.command_buffer_logical[i];
+        s_context.command_offset[i] = 0;
+        s_context.command_fence[i] = 0;
+    }
 
     s_context.command_buffer_size = size;
-    s_context.command_offset[0] = 0;
-    s_context.command_offset[1] = 0;
+    s_context.command_buffer_count = command_buffer_count;
     s_context.command_buffer_current = 0;
 
     return error;
@@ -3722,19 +4100,16 @@ vg_lite_error_t _free_command_buffer()
 {
     vg_lite_kernel_free_t free;
     vg_lite_error_t error = VG_LITE_SUCCESS;
+    uint32_t i;
 
-    if(s_context.context.command_buffer[0]){
-        free.memory_handle = s_context.context.command_buffer[0];
-        VG_LITE_RETURN_ERROR(vg_lite_kernel(VG_LITE_FREE, &free));
-        s_context.context.command_buffer[0] = 0;
-        s_context.context.command_buffer_logical[0] = 0;
-    }
-
-    if(s_context.context.command_buffer[1]){
-        free.memory_handle = s_context.context.command_buffer[1];
-        VG_LITE_RETURN_ERROR(vg_lite_kernel(VG_LITE_FREE, &free));
-        s_context.context.command_buffer[1] = 0;
-        s_context.context.command_buffer_logical[1] = 0;
+    for (i = 0; i < CMDBUF_COUNT; i++) {
+        if(s_context.context.command_buffer[i]){
+            free.memory_handle = s_context.context.command_buffer[i];
+            VG_LITE_RETURN_ERROR(vg_lite_kernel(VG_LITE_FREE, &free));
+            s_context.context.command_buffer[i] = 0;
+            s_context.context.command_buffer_logical[i] = 0;
+            s_context.command_buffer[i] = NULL;
+        }
     }
 
     return error;
@@ -4600,6 +4975,8 @@ static vg_lite_error_t flush(vg_lite_context_t *context);
 static vg_lite_error_t submit(vg_lite_context_t * context);
 #if defined(VG_DRIVER_SINGLE_THREAD)
 static vg_lite_error_t stall(vg_lite_context_t * context, uint32_t time_ms, uint32_t mask);
+static vg_lite_error_t swap_command_buffer(vg_lite_context_t * context);
+static vg_lite_error_t submit_full_command_buffer(vg_lite_context_t * context);
 #else
 static vg_lite_error_t stall(vg_lite_context_t * context, uint32_t time_ms);
 #endif /* VG_DRIVER_SINGLE_THREAD */
@@ -4703,8 +5080,7 @@ static vg_lite_error_t push_states(vg_lite_context_t * context, uint32_t address
         return VG_LITE_NO_CONTEXT;
 
     if (CMDBUF_OFFSET(*context) + 8 + VG_LITE_ALIGN(count + 1, 2) * 4 >= CMDBUF_SIZE(*context)) {
-        VG_LITE_RETURN_ERROR(submit(context));
-        VG_LITE_RETURN_ERROR(stall(context, 0, (uint32_t)~0));
+        VG_LITE_RETURN_ERROR(submit_full_command_buffer(context));
     }
 
     ((uint32_t *) (CMDBUF_BUFFER(*context) + CMDBUF_OFFSET(*context)))[0] = VG_LITE_STATES(count, address);
@@ -4729,8 +5105,7 @@ static vg_lite_error_t push_state(vg_lite_context_t * context, uint32_t address,
         return VG_LITE_NO_CONTEXT;
 
     if (CMDBUF_OFFSET(*context) + 16 >= CMDBUF_SIZE(*context)) {
-        VG_LITE_RETURN_ERROR(submit(context));
-        VG_LITE_RETURN_ERROR(stall(context, 0, (uint32_t)~0));
+        VG_LITE_RETURN_ERROR(submit_full_command_buffer(context));
     }
 
     ((uint32_t *) (CMDBUF_BUFFER(*context) + CMDBUF_OFFSET(*context)))[0] = VG_LITE_STATE(address);
@@ -4750,8 +5125,7 @@ static vg_lite_error_t push_state_ptr(vg_lite_context_t * context, uint32_t addr
         return VG_LITE_NO_CONTEXT;
 
     if (CMDBUF_OFFSET(*context) + 16 >= CMDBUF_SIZE(*context)) {
-        VG_LITE_RETURN_ERROR(submit(context));
-        VG_LITE_RETURN_ERROR(stall(context, 0, (uint32_t)~0));
+        VG_LITE_RETURN_ERROR(submit_full_command_buffer(context));
     }
 
     ((uint32_t *) (CMDBUF_BUFFER(*context) + CMDBUF_OFFSET(*context)))[0] = VG_LITE_STATE(address);
@@ -4770,8 +5144,7 @@ static vg_lite_error_t push_call(vg_lite_context_t * context, uint32_t address,
         return VG_LITE_NO_CONTEXT;
 
     if (CMDBUF_OFFSET(*context) + 16 >= CMDBUF_SIZE(*context)) {
-        VG_LITE_RETURN_ERROR(submit(context));
-        VG_LITE_RETURN_ERROR(stall(context, 0, (uint32_t)~0));
+        VG_LITE_RETURN_ERROR(submit_full_command_buffer(context));
     }
 
     ((uint32_t *) (CMDBUF_BUFFER(*context) + CMDBUF_OFFSET(*context)))[0] = VG_LITE_CALL((bytes + 7) / 8);
@@ -4790,8 +5163,7 @@ static vg_lite_error_t push_rectangle(vg_lite_context_t * context, int x, int y,
         return VG_LITE_NO_CONTEXT;
 
     if (CMDBUF_OFFSET(*context) + 16 >= CMDBUF_SIZE(*context)) {
-        VG_LITE_RETURN_ERROR(submit(context));
-        VG_LITE_RETURN_ERROR(stall(context, 0, (uint32_t)~0));
+        VG_LITE_RETURN_ERROR(submit_full_command_buffer(context));
     }
 
     ((uint32_t *) (CMDBUF_BUFFER(*context) + CMDBUF_OFFSET(*context)))[0] = VG_LITE_DATA(1);
@@ -4816,8 +5188,7 @@ static vg_lite_error_t push_data(vg_lite_context_t * context, int size, void * d
         return VG_LITE_NO_CONTEXT;
 
     if (CMDBUF_OFFSET(*context) + 16 + bytes >= CMDBUF_SIZE(*context)) {
-        VG_LITE_RETURN_ERROR(submit(context));
-        VG_LITE_RETURN_ERROR(stall(context, 0, (uint32_t)~0));
+        VG_LITE_RETURN_ERROR(submit_full_command_buffer(context));
     }
 
     ((uint64_t *) (CMDBUF_BUFFER(*context) + CMDBUF_OFFSET(*context)))[(bytes / 8)] = 0;
@@ -4838,8 +5209,7 @@ static vg_lite_error_t push_stall(vg_lite_context_t * context, uint32_t module)
         return VG_LITE_NO_CONTEXT;
 
     if (CMDBUF_OFFSET(*context) + 16 >= CMDBUF_SIZE(*context)) {
-        VG_LITE_RETURN_ERROR(submit(context));
-        VG_LITE_RETURN_ERROR(stall(context, 0, (uint32_t)~0));
+        VG_LITE_RETURN_ERROR(submit_full_command_buffer(context));
     }
 
     ((uint32_t *) (CMDBUF_BUFFER(*context) + CMDBUF_OFFSET(*context)))[0] = VG_LITE_SEMAPHORE(module);
@@ -4905,14 +5275,16 @@ static vg_lite_error_t submit(vg_lite_context_t *context)
     submit.command_size = CMDBUF_OFFSET(*context);
     submit.command_id = CMDBUF_INDEX(*context);
 
-    /* Wait if GPU has not completed previous CMD buffer */
-    if (submit_flag)
-    {
-        VG_LITE_RETURN_ERROR(stall(&s_context, 0, (uint32_t)~0));
-    }
+    /* Queued behind the previous command buffers if the GPU is still busy. */
     VG_LITE_RETURN_ERROR(vg_lite_kernel(VG_LITE_SUBMIT, &submit));
 
-    submit_flag = 1;
+    context->command_fence[CMDBUF_INDEX(*context)] = submit.fence;
+    context->last_fence = submit.fence;
+
+    context->submitted_bytes += submit.command_size;
+    context->flushes++;
+    if (submit.command_size > context->peak_usage)
+        context->peak_usage = submit.command_size;
 
     vglitemDUMP_BUFFER("command", (unsigned int)CMDBUF_BUFFER(*context),
         submit.context->command_buffer_logical[CMDBUF_INDEX(*context)], 0, submit.command_size);
@@ -4924,19 +5296,60 @@ static vg_lite_error_t submit(vg_lite_context_t *context)
     return error;
 }
 
-/* Wait for the HW to finish the current execution. */
-static vg_lite_error_t stall(vg_lite_context_t * context, uint32_t time_ms, uint32_t mask)
+/* Wait for the HW to execute the command buffer identified by the fence. */
+static vg_lite_error_t wait_fence(vg_lite_context_t * context, uint32_t fence, uint32_t time_ms, uint32_t mask)
 {
     vg_lite_error_t error;
     vg_lite_kernel_wait_t wait;
-    
+
+    /* Nothing has been submitted. */
+    if (fence == 0)
+        return VG_LITE_SUCCESS;
+
     vglitemDUMP("@[stall]");
     /* Wait until GPU is ready. */
     wait.context = &context->context;
     wait.timeout_ms = time_ms > 0 ? time_ms : VG_LITE_INFINITE;
     wait.event_mask = mask;
+    wait.fence = fence;
     VG_LITE_RETURN_ERROR(vg_lite_kernel(VG_LITE_WAIT, &wait));
-    submit_flag = 0;
+    return VG_LITE_SUCCESS;
+}
+
+/* Wait for the HW to finish the current execution. */
+static vg_lite_error_t stall(vg_lite_context_t * context, uint32_t time_ms, uint32_t mask)
+{
+    return wait_fence(context, context->last_fence, time_ms, mask);
+}
+
+/* Move to the next command buffer of the ring, waiting for the HW to release it if needed. */
+static vg_lite_error_t swap_command_buffer(vg_lite_context_t * context)
+{
+    vg_lite_error_t error;
+    uint32_t fence;
+
+    context->command_buffer_current = (context->command_buffer_current + 1) % context->command_buffer_count;
+    CMDBUF_OFFSET(*context) = 0;
+
+    fence = context->command_fence[CMDBUF_INDEX(*context)];
+    if ((fence != 0) && !vg_lite_fence_is_signaled(fence)) {
+        /* The CPU is a whole ring ahead of the GPU. */
+        context->stalls++;
+        VG_LITE_RETURN_ERROR(wait_fence(context, fence, 0, (uint32_t)~0));
+    }
+
+    return VG_LITE_SUCCESS;
+}
+
+/* Submit the command buffer that is full in the middle of a drawing and continue in the next one. */
+static vg_lite_error_t submit_full_command_buffer(vg_lite_context_t * context)
+{
+    vg_lite_error_t error;
+
+    context->forced_flushes++;
+    VG_LITE_RETURN_ERROR(submit(context));
+    VG_LITE_RETURN_ERROR(swap_command_buffer(context));
+
     return VG_LITE_SUCCESS;
 }
 
@@ -7539,11 +7952,28 @@ static vg_lite_error_t program_tessellation(vg_lite_context_t *context)
 }
 
 #if defined(VG_DRIVER_SINGLE_THREAD)
+static void _set_tessellation_states(vg_lite_kernel_initialize_t * initialize)
+{
+    s_context.tsbuffer.tessellation_buffer_gpu[0] = initialize->tessellation_buffer_gpu[0];
+    s_context.tsbuffer.tessellation_buffer_gpu[1] = initialize->tessellation_buffer_gpu[1];
+    s_context.tsbuffer.tessellation_buffer_gpu[2] = initialize->tessellation_buffer_gpu[2];
+    s_context.tsbuffer.tessellation_buffer_logic[0] = initialize->tessellation_buffer_logic[0];
+    s_context.tsbuffer.tessellation_buffer_logic[1] = initialize->tessellation_buffer_logic[1];
+    s_context.tsbuffer.tessellation_buffer_logic[2] = initialize->tessellation_buffer_logic[2];
+    s_context.tsbuffer.tessellation_stride = initialize->tessellation_stride;
+    s_context.tsbuffer.tessellation_width_height = initialize->tessellation_width_height;
+    s_context.tsbuffer.tessellation_buffer_size[0] = initialize->tessellation_buffer_size[0];
+    s_context.tsbuffer.tessellation_buffer_size[1] = initialize->tessellation_buffer_size[1];
+    s_context.tsbuffer.tessellation_buffer_size[2] = initialize->tessellation_buffer_size[2];
+    s_context.tsbuffer.tessellation_shift          = initialize->tessellation_shift;
+}
+
 vg_lite_error_t vg_lite_init(int32_t tessellation_width,
                              int32_t tessellation_height)
 {
     vg_lite_error_t error;
     vg_lite_kernel_initialize_t initialize;
+    uint32_t i;
 
     s_context.rtbuffer = (vg_lite_buffer_t *)malloc(sizeof(vg_lite_buffer_t));
     if(!s_context.rtbuffer)
@@ -7572,6 +8002,7 @@ vg_lite_error_t vg_lite_init(int32_t tessellation_width,
 
     /* Allocate a command buffer and a tessellation buffer. */
     initialize.command_buffer_size = command_buffer_size;
+    initialize.command_buffer_count = command_buffer_count;
     initialize.tessellation_width = tessellation_width;
     initialize.tessellation_height = tessellation_height;
     initialize.context = &s_context.context;
@@ -7579,28 +8010,21 @@ vg_lite_error_t vg_lite_init(int32_t tessellation_width,
 
     /* Save draw context. */
     s_context.capabilities = initialize.capabilities;
-    s_context.command_buffer[0] = (uint8_t *)initialize.command_buffer[0];
-    s_context.command_buffer[1] = (uint8_t *)initialize.command_buffer[1];
+    for (i = 0; i < command_buffer_count; i++) {
+        s_context.command_buffer[i] = (uint8_t *)initialize.command_buffer[i];
+        s_context.command_offset[i] = 0;
+        s_context.command_fence[i] = 0;
+    }
     s_context.command_buffer_size = initialize.command_buffer_size;
-    s_context.command_offset[0] = 0;
-    s_context.command_offset[1] = 0;
+    s_context.command_buffer_count = command_buffer_count;
+    s_context.command_buffer_current = 0;
+    s_context.last_fence = 0;
 
     if ((tessellation_width  > 0) &&
         (tessellation_height > 0))
     {
         /* Set and Program Tessellation Buffer states. */
-        s_context.tsbuffer.tessellation_buffer_gpu[0] = initialize.tessellation_buffer_gpu[0];
-        s_context.tsbuffer.tessellation_buffer_gpu[1] = initialize.tessellation_buffer_gpu[1];
-        s_context.tsbuffer.tessellation_buffer_gpu[2] = initialize.tessellation_buffer_gpu[2];
-        s_context.tsbuffer.tessellation_buffer_logic[0] = initialize.tessellation_buffer_logic[0];
-        s_context.tsbuffer.tessellation_buffer_logic[1] = initialize.tessellation_buffer_logic[1];
-        s_context.tsbuffer.tessellation_buffer_logic[2] = initialize.tessellation_buffer_logic[2];
-        s_context.tsbuffer.tessellation_stride = initialize.tessellation_stride;
-        s_context.tsbuffer.tessellation_width_height = initialize.tessellation_width_height;
-        s_context.tsbuffer.tessellation_buffer_size[0] = initialize.tessellation_buffer_size[0];
-        s_context.tsbuffer.tessellation_buffer_size[1] = initialize.tessellation_buffer_size[1];
-        s_context.tsbuffer.tessellation_buffer_size[2] = initialize.tessellation_buffer_size[2];
-        s_context.tsbuffer.tessellation_shift          = initialize.tessellation_shift;
+        _set_tessellation_states(&initialize);
 
         VG_LITE_RETURN_ERROR(program_tessellation(&s_context));
     }
@@ -7631,6 +8055,9 @@ vg_lite_error_t vg_lite_init(int32_t tessellation_width,
     vg_lite_text_init();
 #endif /* VG_RENDER_TEXT */
 
+    /* The command buffers can now only be resized by reallocating them (added by MicroEJ). */
+    s_context.init = 1;
+
     return VG_LITE_SUCCESS;
 }
 #else
@@ -7765,6 +8192,35 @@ void __attribute__((weak)) vg_lite_draw_notify_render_area(uint32_t x, uint32_t
     return;
 }
 
+/* Count the tessellation passes of a drawing: the path is tessellated once per window
+ * covering its bounding box, twice when it is both filled and stroked. */
+static void _count_tessellation(vg_lite_point_t * point_min, vg_lite_point_t * point_max,
+                                int32_t width, int32_t height, vg_lite_draw_path_type_t path_type)
+{
+    uint32_t passes = 0;
+
+    if ((point_max->x > point_min->x) && (point_max->y > point_min->y)) {
+        int32_t bbox_width = point_max->x - point_min->x;
+        int32_t bbox_height = point_max->y - point_min->y;
+
+        passes = (uint32_t)(((bbox_width + width - 1) / width) * ((bbox_height + height - 1) / height));
+        if (path_type == VG_LITE_DRAW_FILL_STROKE_PATH)
+            passes *= 2;
+
+        if ((uint32_t)bbox_width > s_context.ts_max_width)
+            s_context.ts_max_width = (uint32_t)bbox_width;
+        if ((uint32_t)bbox_height > s_context.ts_max_height)
+            s_context.ts_max_height = (uint32_t)bbox_height;
+    }
+
+    s_context.ts_draws++;
+    s_context.ts_passes += passes;
+    if (passes > 1)
+        s_context.ts_split_draws++;
+    if (passes > s_context.ts_max_passes)
+        s_context.ts_max_passes = passes;
+}
+
 vg_lite_error_t vg_lite_draw(vg_lite_buffer_t * target,
                              vg_lite_path_t * path,
                              vg_lite_fill_t fill_rule,
@@ -8001,6 +8457,9 @@ vg_lite_error_t vg_lite_draw(vg_lite_buffer_t * target,
     /* Notify rendering area (added by MicroEJ) */
     vg_lite_draw_notify_render_area(point_min.x, point_min.y, point_max.x, point_max.y);
 
+    /* Count the tessellation passes (added by MicroEJ) */
+    _count_tessellation(&point_min, &point_max, width, height, path->path_type);
+
     /* Finialize command buffer. */
     VG_LITE_RETURN_ERROR(push_state(&s_context, 0x0A34, 0));
     return error;
@@ -8024,14 +8483,16 @@ vg_lite_error_t vg_lite_close(void)
     if(s_context.rtbuffer)
         free(s_context.rtbuffer);
 
-    submit_flag = 0;
-
     /* Reset the draw context. */
     _memset(&s_context, 0, sizeof(s_context));
 
     /* Reset the s_ftable. */
     _memset(&s_ftable, 0, sizeof(s_ftable));
 
+    /* Release the stroke points and the cached strokes. */
+    _release_points();
+    _purge_stroke_cache();
+
     s_context.init = 0;
 #if DUMP_CAPTURE
     _SetDumpFileInfo();
@@ -8825,7 +9286,8 @@ vg_lite_error_t vg_lite_finish()
     /* Return if there is nothing to submit. */
     if (CMDBUF_OFFSET(s_context) == 0)
     {
-        if(submit_flag)
+        /* Wait for the command buffers flushed before. */
+        if (!vg_lite_fence_is_signaled(s_context.last_fence))
             VG_LITE_RETURN_ERROR(stall(&s_context, 0, (uint32_t)~0));
         return VG_LITE_SUCCESS;
     }
@@ -8844,33 +9306,148 @@ vg_lite_error_t vg_lite_finish()
     }
 #endif
 
-    CMDBUF_SWAP(s_context);
     /* Reset command buffer. */
-    CMDBUF_OFFSET(s_context) = 0;
+    VG_LITE_RETURN_ERROR(swap_command_buffer(&s_context));
 
     return VG_LITE_SUCCESS;
 }
 
 vg_lite_error_t vg_lite_flush(void)
+{
+    return vg_lite_flush_async(NULL);
+}
+
+// added by MicroEJ
+vg_lite_error_t vg_lite_flush_async(vg_lite_fence_t * fence)
 {
     vg_lite_error_t error;
 
-    /* Return if there is nothing to submit. */
-    if (CMDBUF_OFFSET(s_context) == 0)
-        return VG_LITE_SUCCESS;
+    if (CMDBUF_OFFSET(s_context) != 0) {
+        /* Submit the current command buffer: it is queued if the GPU is still busy. */
+        VG_LITE_RETURN_ERROR(flush_target());
+        VG_LITE_RETURN_ERROR(submit(&s_context));
 
-    /* Wait if GPU has not completed previous CMD buffer */
-    if (submit_flag)
-    {
-        VG_LITE_RETURN_ERROR(stall(&s_context, 0, (uint32_t)~0));
+        /* Only waits when all the command buffers of the ring are in flight. */
+        VG_LITE_RETURN_ERROR(swap_command_buffer(&s_context));
     }
+    /* else: nothing to submit, the last fence covers the previous flushes. */
 
-    /* Submit the current command buffer. */
-    VG_LITE_RETURN_ERROR(flush_target());
-    VG_LITE_RETURN_ERROR(submit(&s_context));
-    CMDBUF_SWAP(s_context);
-    /* Reset command buffer. */
-    CMDBUF_OFFSET(s_context) = 0;
+    if (fence != NULL)
+        *fence = s_context.last_fence;
+
+    return VG_LITE_SUCCESS;
+}
+
+// added by MicroEJ
+vg_lite_error_t vg_lite_wait_fence(vg_lite_fence_t fence, uint32_t timeout_ms)
+{
+    return wait_fence(&s_context, fence, timeout_ms, (uint32_t)~0);
+}
+
+// added by MicroEJ
+int32_t vg_lite_fence_is_signaled(vg_lite_fence_t fence)
+{
+    vg_lite_kernel_queue_info_t info;
+
+    if (fence == 0)
+        return 1;
+
+    (void)vg_lite_kernel(VG_LITE_QUERY_QUEUE, &info);
+    return (int32_t)(info.completed - fence) >= 0;
+}
+
+// added by MicroEJ
+vg_lite_error_t vg_lite_get_queue_stats(vg_lite_queue_stats_t * stats)
+{
+    vg_lite_kernel_queue_info_t info;
+
+    if (stats == NULL)
+        return VG_LITE_INVALID_ARGUMENT;
+
+    (void)vg_lite_kernel(VG_LITE_QUERY_QUEUE, &info);
+    stats->submitted = info.submitted;
+    stats->completed = info.completed;
+    stats->depth = info.depth;
+    stats->max_depth = info.max_depth;
+    stats->stalls = s_context.stalls;
+
+    return VG_LITE_SUCCESS;
+}
+
+// added by MicroEJ
+vg_lite_error_t vg_lite_get_command_stats(vg_lite_command_stats_t * stats, int32_t reset)
+{
+    if (stats == NULL)
+        return VG_LITE_INVALID_ARGUMENT;
+
+    stats->size = s_context.command_buffer_size;
+    stats->bytes = s_context.submitted_bytes;
+    stats->flushes = s_context.flushes;
+    stats->forced_flushes = s_context.forced_flushes;
+    stats->peak_usage = s_context.peak_usage;
+
+    if (reset) {
+        s_context.submitted_bytes = 0;
+        s_context.flushes = 0;
+        s_context.forced_flushes = 0;
+        s_context.peak_usage = 0;
+    }
+
+    return VG_LITE_SUCCESS;
+}
+
+// added by MicroEJ
+vg_lite_error_t vg_lite_get_tessellation_stats(vg_lite_tessellation_stats_t * stats, int32_t reset)
+{
+    if (stats == NULL)
+        return VG_LITE_INVALID_ARGUMENT;
+
+    stats->width = s_context.tsbuffer.tessellation_width_height & 0xFFFF;
+    stats->height = s_context.tsbuffer.tessellation_width_height >> 16;
+    stats->bytes = s_context.tsbuffer.tessellation_buffer_size[0]
+                 + s_context.tsbuffer.tessellation_buffer_size[1]
+                 + s_context.tsbuffer.tessellation_buffer_size[2];
+    stats->draws = s_context.ts_draws;
+    stats->passes = s_context.ts_passes;
+    stats->split_draws = s_context.ts_split_draws;
+    stats->max_passes = s_context.ts_max_passes;
+    stats->max_width = s_context.ts_max_width;
+    stats->max_height = s_context.ts_max_height;
+
+    if (reset) {
+        s_context.ts_draws = 0;
+        s_context.ts_passes = 0;
+        s_context.ts_split_draws = 0;
+        s_context.ts_max_passes = 0;
+        s_context.ts_max_width = 0;
+        s_context.ts_max_height = 0;
+    }
+
+    return VG_LITE_SUCCESS;
+}
+
+// added by MicroEJ
+vg_lite_error_t vg_lite_get_stroke_cache_stats(vg_lite_stroke_cache_stats_t * stats, int32_t reset)
+{
+    if (stats == NULL)
+        return VG_LITE_INVALID_ARGUMENT;
+
+    *stats = stroke_cache_stats;
+    stats->size = VG_LITE_STROKE_CACHE_SIZE;
+
+    if (reset) {
+        stroke_cache_stats.hits = 0;
+        stroke_cache_stats.misses = 0;
+        stroke_cache_stats.evictions = 0;
+    }
+
+    return VG_LITE_SUCCESS;
+}
+
+// added by MicroEJ
+vg_lite_error_t vg_lite_purge_stroke_cache(void)
+{
+    _purge_stroke_cache();
 
     return VG_LITE_SUCCESS;
 }
@@ -9393,43 +9970,7 @@ vg_lite_error_t vg_lite_clear_path(vg_lite_path_t * path)
     }
     path->path = NULL;
 
-    if(path->stroke_path_data) {
-        vg_lite_os_free(path->stroke_path_data);
-        path->stroke_path_data = NULL;
-
-        if(path->stroke_conversion.path_point_list) {
-            vg_lite_path_point_ptr temp_point;
-            while(path->stroke_conversion.path_point_list) {
-                temp_point = path->stroke_conversion.path_point_list->next;
-#if defined(VG_DRIVER_SINGLE_THREAD)
-                free(path->stroke_conversion.path_point_list);
-#else
-                vg_lite_os_free(path->stroke_conversion.path_point_list);
-#endif /* VG_DRIVER_SINGLE_THREAD */
-                path->stroke_conversion.path_point_list = temp_point;
-            }
-            temp_point = NULL;
-        }
-
-        if(path->stroke_conversion.stroke_sub_path_list) {
-            vg_lite_sub_path_ptr temp_sub_path;
-            while(path->stroke_conversion.stroke_sub_path_list) {
-                temp_sub_path = path->stroke_conversion.stroke_sub_path_list->next;
-                if(path->stroke_conversion.stroke_sub_path_list->point_list) {
-                    vg_lite_path_point_ptr temp_point;
-                    while(path->stroke_conversion.stroke_sub_path_list->point_list) {
-                        temp_point = path->stroke_conversion.stroke_sub_path_list->point_list->next;
-                        vg_lite_os_free(path->stroke_conversion.stroke_sub_path_list->point_list);
-                        path->stroke_conversion.stroke_sub_path_list->point_list = temp_point;
-                    }
-                    temp_point = NULL;
-                }
-                vg_lite_os_free(path->stroke_conversion.stroke_sub_path_list);
-                path->stroke_conversion.stroke_sub_path_list = temp_sub_path;
-            }
-            temp_sub_path = NULL;
-        }
-    }
+    _free_stroke(path);
 
     return VG_LITE_SUCCESS;
 }
@@ -9706,6 +10247,9 @@ vg_lite_error_t vg_lite_draw_pattern(vg_lite_buffer_t * target,
         }
     }
 
+    /* Count the tessellation passes (added by MicroEJ) */
+    _count_tessellation(&point_min, &point_max, width, height, path->path_type);
+
     /* Finialize command buffer. */
     VG_LITE_RETURN_ERROR(push_state(&s_context, 0x0A34, 0));
 
@@ -10041,6 +10585,9 @@ vg_lite_error_t vg_lite_draw_linear_gradient(vg_lite_buffer_t * target,
         }
     }
 
+    /* Count the tessellation passes (added by MicroEJ) */
+    _count_tessellation(&point_min, &point_max, width, height, path->path_type);
+
     /* Finialize command buffer. */
     VG_LITE_RETURN_ERROR(push_state(&s_context, 0x0A34, 0));
 
@@ -10618,6 +11165,9 @@ vg_lite_error_t vg_lite_draw_radial_gradient(vg_lite_buffer_t * target,
     /* Notify rendering area (added by MicroEJ) */
     vg_lite_draw_notify_render_area(point_min.x, point_min.y, point_max.x, point_max.y);
 
+    /* Count the tessellation passes (added by MicroEJ) */
+    _count_tessellation(&point_min, &point_max, width, height, path->path_type);
+
     /* Finialize command buffer. */
     VG_LITE_RETURN_ERROR(push_state(&s_context, 0x0A34, 0));
 
@@ -12859,7 +13409,7 @@ vg_lite_error_t vg_lite_update_grad(vg_lite_linear_gradient_t *grad)
             lg = g0 + dg * j / ds;
             lb = b0 + db * j / ds;
 
-            buffer[grad->stops[i] + j] = ARGB(la, lr, lg, lb);
+            buffer[grad->stops[i] + j] = ARGB((uint32_t)la, (uint32_t)lr, (uint32_t)lg, (uint32_t)lb);
         }
 
         a0 = a1;
@@ -12956,8 +13506,93 @@ vg_lite_error_t vg_lite_set_command_buffer_size(uint32_t size)
         command_buffer_size = size;
     }
     else{
+        uint32_t previous_size = s_context.command_buffer_size;
+        vg_lite_error_t result = VG_LITE_SUCCESS;
+
+        if(!size)
+            return VG_LITE_INVALID_ARGUMENT;
+
+        /* Submit the pending commands: the GPU must not execute the buffers to free. */
+        VG_LITE_RETURN_ERROR(vg_lite_finish());
+        VG_LITE_RETURN_ERROR(_free_command_buffer());
+        if (_allocate_command_buffer(size) != VG_LITE_SUCCESS) {
+            /* Not enough contiguous memory: restore the previous size (added by MicroEJ). */
+            VG_LITE_RETURN_ERROR(_free_command_buffer());
+            VG_LITE_RETURN_ERROR(_allocate_command_buffer(previous_size));
+            result = VG_LITE_OUT_OF_MEMORY;
+        }
+        command_buffer_size = s_context.command_buffer_size;
+        VG_LITE_RETURN_ERROR(program_tessellation(&s_context));
+        error = result;
+    }
+
+    return error;
+}
+
+// added by MicroEJ
+vg_lite_error_t vg_lite_set_tessellation_size(int32_t width, int32_t height)
+{
+    vg_lite_error_t error = VG_LITE_SUCCESS;
+    vg_lite_error_t result = VG_LITE_SUCCESS;
+    vg_lite_kernel_initialize_t initialize;
+    uint32_t previous_size = s_context.tsbuffer.tessellation_width_height;
+
+    if((width <= 0) || (height <= 0))
+        return VG_LITE_INVALID_ARGUMENT;
+
+    if(!s_context.init || !previous_size)
+        return VG_LITE_NO_CONTEXT;
+
+    width = VG_LITE_ALIGN(width, 16);
+    height = VG_LITE_ALIGN(height, 16);
+    if(((uint32_t)width | ((uint32_t)height << 16)) == previous_size)
+        return VG_LITE_SUCCESS;
+
+    /* Submit the pending commands: the GPU must not use the buffer to free. */
+    VG_LITE_RETURN_ERROR(vg_lite_finish());
+
+    memset(&initialize, 0, sizeof(initialize));
+    initialize.context = &s_context.context;
+    initialize.capabilities = s_context.capabilities;
+    initialize.tessellation_width = width;
+    initialize.tessellation_height = height;
+    if (vg_lite_kernel(VG_LITE_TESSELLATION, &initialize) != VG_LITE_SUCCESS) {
+        /* Not enough contiguous memory: restore the previous size. */
+        initialize.tessellation_width = (int32_t)(previous_size & 0xFFFF);
+        initialize.tessellation_height = (int32_t)(previous_size >> 16);
+        error = vg_lite_kernel(VG_LITE_TESSELLATION, &initialize);
+        if (error != VG_LITE_SUCCESS) {
+            /* No tessellation buffer anymore: the paths cannot be drawn. */
+            memset(&s_context.tsbuffer, 0, sizeof(s_context.tsbuffer));
+            return error;
+        }
+        result = VG_LITE_OUT_OF_MEMORY;
+    }
+
+    s_context.capabilities = initialize.capabilities;
+    _set_tessellation_states(&initialize);
+    VG_LITE_RETURN_ERROR(program_tessellation(&s_context));
+
+    return result;
+}
+
+// added by MicroEJ
+vg_lite_error_t vg_lite_set_command_buffer_count(uint32_t count)
+{
+    vg_lite_error_t error = VG_LITE_SUCCESS;
+
+    if((count == 0) || (count > CMDBUF_COUNT))
+        return VG_LITE_INVALID_ARGUMENT;
+
+    if(!s_context.init){
+        command_buffer_count = count;
+    }
+    else{
+        /* Submit the pending commands: the GPU must not execute the buffers to free. */
+        VG_LITE_RETURN_ERROR(vg_lite_finish());
         VG_LITE_RETURN_ERROR(_free_command_buffer());
-        VG_LITE_RETURN_ERROR(_allocate_command_buffer(size));
+        command_buffer_count = count;
+        VG_LITE_RETURN_ERROR(_allocate_command_buffer(s_context.command_buffer_size));
         VG_LITE_RETURN_ERROR(program_tessellation(&s_context));
     }
 
@@ -25,6 +25,8 @@
 *    Copyright 2020-2022 MicroEJ Corp. This file has been modified by MicroEJ Corp.
 *    1. Add callback mecanism to notify MicroEJ when a VGLite operation
 *       is complete
+*    2. Forward the interrupts to the kernel command buffer queue and add
+*       the critical section functions
 *
 *****************************************************************************/
 
@@ -488,6 +490,18 @@ void vg_lite_hal_register_irq_callback(vg_lite_irq_callback cb) {
 }
 #endif /* _VG_LITE_IRQ_CALLBACK */
 
+// added by MicroEJ
+void vg_lite_hal_enter_critical(void)
+{
+    taskENTER_CRITICAL();
+}
+
+// added by MicroEJ
+void vg_lite_hal_exit_critical(void)
+{
+    taskEXIT_CRITICAL();
+}
+
 #endif /* VG_DRIVER_SINGLE_THREAD */
 
 void vg_lite_IRQHandler(void)
@@ -500,6 +514,9 @@ void vg_lite_IRQHandler(void)
         /* Combine with current interrupt flags. */
         device->int_flags |= flags;
 
+        // added by MicroEJ: start the next queued command buffer before waking up the waiters
+        vg_lite_kernel_interrupt(flags);
+
         /* Wake up any waiters. */
         if(device->int_queue){
             xSemaphoreGiveFromISR(device->int_queue, &xHigherPriorityTaskWoken);
@@ -0,0 +1,1512 @@
+/*
+ * C
+ *
+ * Copyright 2022 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/*
+ * @file
+ * @brief Software implementation of the VGLite HAL: see vg_lite_platform.h.
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ */
+
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+#include "vg_lite_platform.h"
+#include "vg_lite_kernel.h"
+#include "vg_lite_hal.h"
+#include "vg_lite_hw.h"
+
+#if !defined(VG_DRIVER_SINGLE_THREAD)
+#error "The software VGLite HAL only supports the single thread driver (VG_DRIVER_SINGLE_THREAD)."
+#endif /* VG_DRIVER_SINGLE_THREAD */
+
+/* Values of the identification registers: GCNanoLite-V of the i.MX RT595. */
+#define SOFT_CHIP_REVISION      0x1311
+
+/* First address given to the host buffers mapped with vg_lite_map() (64-bit hosts only). */
+#define SOFT_MAPPING_BASE       0x40000000
+/* Address of the contiguous memory (64-bit hosts only). */
+#define SOFT_CONTIGUOUS_BASE    0x10000000
+
+/* The GPU states: from 0x0A00 to 0x0BFF. */
+#define SOFT_STATE_FIRST        0x0A00
+#define SOFT_STATE_COUNT        0x0200
+#define STATE(address)          (device->states[(address) - SOFT_STATE_FIRST])
+
+/* The kernel registers: from 0x000 to 0x7FF. */
+#define SOFT_REGISTER_COUNT     (0x800 / 4)
+
+/* Nesting of the command buffer calls (the uploaded paths). */
+#define SOFT_MAX_CALL_DEPTH     4
+
+/* Maximal number of segments used to approximate a curve. */
+#define SOFT_MAX_CURVE_SEGMENTS 256
+
+#define HEAP_NODE_USED          0xABBAF00D
+
+/* The channels of a pixel: same order as the bytes of vg_lite_color_t. */
+#define CHANNEL_R 0
+#define CHANNEL_G 1
+#define CHANNEL_B 2
+#define CHANNEL_A 3
+
+/* The pixel layouts. */
+typedef enum soft_kind {
+    SOFT_KIND_PACKED,       /* Channels packed in a 8, 16 or 32-bit word. */
+    SOFT_KIND_LUMINANCE,    /* 8-bit luminance. */
+    SOFT_KIND_INDEX,        /* 1, 2, 4 or 8-bit index in the CLUT. */
+    SOFT_KIND_UNSUPPORTED,
+} soft_kind_t;
+
+typedef struct soft_layout {
+    soft_kind_t kind;
+    uint32_t bpp;
+    uint8_t shift[4];
+    uint8_t width[4];
+    uint8_t opaque;         /* The alpha bits are ignored when reading (X8888). */
+    const uint32_t * clut;
+} soft_layout_t;
+
+typedef struct soft_pixel {
+    uint32_t c[4];
+} soft_pixel_t;
+
+/* The render target. */
+typedef struct soft_target {
+    uint8_t * memory;
+    uint32_t stride;
+    soft_layout_t layout;
+    int32_t right;
+    int32_t bottom;
+} soft_target_t;
+
+/* The image read by the blits and the patterns. */
+typedef struct soft_image {
+    const uint8_t * memory;
+    uint32_t stride;
+    soft_layout_t layout;
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+    uint32_t filter;
+    int pad;
+    int premultiply;
+    soft_pixel_t border;
+} soft_image_t;
+
+/* An edge of a flattened path: y0 < y1. */
+typedef struct soft_edge {
+    float x0, y0, x1, y1;
+    int32_t direction;
+} soft_edge_t;
+
+typedef struct soft_crossing {
+    float x;
+    int32_t direction;
+} soft_crossing_t;
+
+typedef struct soft_mapping {
+    void * logical;
+    uint32_t address;
+    uint32_t bytes;
+} soft_mapping_t;
+
+/* Implementation of list. ****************************************/
+typedef struct list_head {
+    struct list_head *next;
+    struct list_head *prev;
+}list_head_t;
+
+typedef struct heap_node {
+    list_head_t list;
+    uint32_t offset;
+    unsigned long size;
+    uint32_t status;
+}heap_node_t;
+
+struct vg_lite_device {
+    uint8_t * contiguous;
+    uint32_t physical;
+    uint32_t size;
+    uint32_t free;
+    list_head_t heap;
+
+    uint32_t registers[SOFT_REGISTER_COUNT];
+    uint32_t states[SOFT_STATE_COUNT];
+
+    uint32_t int_status;        /* Interrupts raised and not yet handled. */
+    uint32_t int_flags;         /* Interrupts handled and not yet waited for. */
+    int critical;
+    int delivering;
+
+    /* Command buffer kicked off and not executed yet (deferred execution). */
+    int pending;
+    uint32_t pending_address;
+    uint32_t pending_bytes;
+
+    soft_mapping_t mappings[VG_LITE_SOFT_MAX_MAPPINGS];
+    uint32_t next_mapping;
+
+    soft_edge_t * edges;
+    uint32_t edge_count;
+    uint32_t edge_capacity;
+    soft_crossing_t * crossings;
+    uint32_t crossing_capacity;
+    uint16_t * samples;
+    uint8_t * coverage;
+    uint32_t span_capacity;
+
+    /* The drawing call in progress. */
+    vg_lite_soft_primitive_t primitive;
+    uint64_t start_ns;
+    uint32_t pixels;
+};
+
+static uint8_t * contiguousMem = NULL;
+static uint32_t gpuMemBase = 0;
+static uint32_t heap_size = MAX_CONTIGUOUS_SIZE;
+
+static struct vg_lite_device Device, * device;
+
+static vg_lite_irq_callback __irq_callback = NULL;
+static vg_lite_soft_profile_t __profile;
+static vg_lite_soft_trace_t __trace = NULL;
+static int __deferred = 0;
+
+void vg_lite_init_mem(uint32_t register_mem_base,
+          uint32_t gpu_mem_base,
+          volatile void * contiguous_mem_base,
+          uint32_t contiguous_mem_size)
+{
+    (void) register_mem_base;
+    gpuMemBase      = gpu_mem_base;
+    contiguousMem   = (uint8_t *)contiguous_mem_base;
+    heap_size       = contiguous_mem_size;
+}
+
+// -----------------------------------------------------------------------------
+// Profiler
+// -----------------------------------------------------------------------------
+
+uint64_t __attribute__((weak)) vg_lite_soft_clock_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000u) + (uint64_t)now.tv_nsec;
+}
+
+void vg_lite_soft_get_profile(vg_lite_soft_profile_t * profile)
+{
+    *profile = __profile;
+}
+
+void vg_lite_soft_reset_profile(void)
+{
+    memset(&__profile, 0, sizeof(__profile));
+}
+
+void vg_lite_soft_set_trace(vg_lite_soft_trace_t trace)
+{
+    __trace = trace;
+}
+
+void vg_lite_soft_set_deferred(int deferred)
+{
+    __deferred = deferred;
+}
+
+static void __soft_begin(vg_lite_soft_primitive_t primitive)
+{
+    device->primitive = primitive;
+    device->pixels = 0;
+    device->start_ns = vg_lite_soft_clock_ns();
+}
+
+static void __soft_end(void)
+{
+    vg_lite_soft_counter_t * counter = &__profile.primitives[device->primitive];
+    uint64_t time = vg_lite_soft_clock_ns() - device->start_ns;
+
+    counter->calls++;
+    counter->pixels += device->pixels;
+    counter->time_ns += time;
+    if (time > counter->max_time_ns) {
+        counter->max_time_ns = time;
+    }
+    if (__trace != NULL) {
+        __trace(device->primitive, device->pixels, time);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Memory
+// -----------------------------------------------------------------------------
+
+/* Gets the host memory of a GPU address range, NULL when it is not mapped. */
+static void * __soft_translate(uint32_t address, uint32_t bytes)
+{
+    uint32_t i;
+
+    if ((address - device->physical) < device->size && bytes <= device->size - (address - device->physical)) {
+        return device->contiguous + (address - device->physical);
+    }
+    for (i = 0; i < VG_LITE_SOFT_MAX_MAPPINGS; i++) {
+        soft_mapping_t * mapping = &device->mappings[i];
+        if ((mapping->logical != NULL) && ((address - mapping->address) < mapping->bytes)
+            && (bytes <= mapping->bytes - (address - mapping->address))) {
+            return (uint8_t *)mapping->logical + (address - mapping->address);
+        }
+    }
+    if ((sizeof(void *) == sizeof(uint32_t)) && (address != 0)) {
+        /* The GPU addresses are the host addresses (e.g. set by the MicroEJ display buffers). */
+        return (void *)(uintptr_t)address;
+    }
+    return NULL;
+}
+
+static inline void add_list(list_head_t *to_add, list_head_t *head)
+{
+    to_add->next = head;
+    to_add->prev = head->prev;
+    head->prev->next = to_add;
+    head->prev = to_add;
+}
+
+static inline void delete_list(list_head_t *entry)
+{
+    entry->prev->next = entry->next;
+    entry->next->prev = entry->prev;
+}
+
+vg_lite_error_t vg_lite_hal_allocate_contiguous(unsigned long size, void ** logical, uint32_t * physical,void ** node)
+{
+    unsigned long aligned_size;
+    heap_node_t * pos;
+
+    /* Align the size to 64 bytes. */
+    aligned_size = (size + 63) & ~63;
+
+    if (aligned_size > device->free) {
+        return VG_LITE_OUT_OF_MEMORY;
+    }
+
+    /* First fit: the nodes are sorted by offset. */
+    for (pos = (heap_node_t *)device->heap.next;
+         &pos->list != &device->heap;
+         pos = (heap_node_t *)pos->list.next) {
+        if (pos->status == 0 && pos->size >= aligned_size) {
+            if (pos->size > aligned_size) {
+                heap_node_t * split = (heap_node_t *)malloc(sizeof(heap_node_t));
+                if (split == NULL) {
+                    return VG_LITE_OUT_OF_RESOURCES;
+                }
+                split->offset = pos->offset + aligned_size;
+                split->size = pos->size - aligned_size;
+                split->status = 0;
+                /* Insert the remaining free memory behind the current node. */
+                add_list(&split->list, pos->list.next);
+                pos->size = aligned_size;
+            }
+            pos->status = HEAP_NODE_USED;
+            *logical = device->contiguous + pos->offset;
+            *physical = device->physical + pos->offset;
+            device->free -= aligned_size;
+            *node = pos;
+            return VG_LITE_SUCCESS;
+        }
+    }
+
+    return VG_LITE_OUT_OF_MEMORY;
+}
+
+void vg_lite_hal_free_contiguous(void * memory_handle)
+{
+    heap_node_t * node = (heap_node_t *)memory_handle;
+    heap_node_t * next;
+    heap_node_t * prev;
+
+    if (node == NULL || node->status != HEAP_NODE_USED) {
+        return;
+    }
+
+    node->status = 0;
+    device->free += node->size;
+
+    /* Merge with the next node. */
+    next = (heap_node_t *)node->list.next;
+    if (&next->list != &device->heap && next->status == 0) {
+        node->size += next->size;
+        delete_list(&next->list);
+        free(next);
+    }
+
+    /* Merge with the previous node. */
+    prev = (heap_node_t *)node->list.prev;
+    if (&prev->list != &device->heap && prev->status == 0) {
+        prev->size += node->size;
+        delete_list(&node->list);
+        free(node);
+    }
+}
+
+void vg_lite_hal_free_os_heap(void)
+{
+    heap_node_t * pos;
+    heap_node_t * n;
+
+    if (device != NULL && device->heap.next != NULL) {
+        for (pos = (heap_node_t *)device->heap.next, n = (heap_node_t *)pos->list.next;
+             &pos->list != &device->heap;
+             pos = n, n = (heap_node_t *)n->list.next) {
+            delete_list(&pos->list);
+            free(pos);
+        }
+    }
+}
+
+vg_lite_error_t vg_lite_hal_query_mem(vg_lite_kernel_mem_t *mem)
+{
+    if(device != NULL){
+        mem->bytes  = device->free;
+        return VG_LITE_SUCCESS;
+    }
+    mem->bytes = 0;
+    return VG_LITE_NO_CONTEXT;
+}
+
+void * vg_lite_hal_map(unsigned long bytes, void * logical, uint32_t physical, uint32_t * gpu)
+{
+    uint32_t i;
+
+    if (logical == NULL) {
+        /* Already a GPU address. */
+        *gpu = physical;
+        return NULL;
+    }
+
+    for (i = 0; i < VG_LITE_SOFT_MAX_MAPPINGS; i++) {
+        soft_mapping_t * mapping = &device->mappings[i];
+        if (mapping->logical == NULL) {
+            mapping->logical = logical;
+            mapping->bytes = (uint32_t)bytes;
+            if (sizeof(void *) == sizeof(uint32_t)) {
+                mapping->address = (uint32_t)(uintptr_t)logical;
+            }
+            else {
+                /* Give an address that does not overlap the previous mappings. */
+                mapping->address = device->next_mapping;
+                device->next_mapping += ((uint32_t)bytes + 63) & ~63;
+            }
+            *gpu = mapping->address;
+            return mapping;
+        }
+    }
+
+    *gpu = 0;
+    return NULL;
+}
+
+void vg_lite_hal_unmap(void * handle)
+{
+    soft_mapping_t * mapping = (soft_mapping_t *)handle;
+
+    if (mapping != NULL) {
+        mapping->logical = NULL;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Pixels
+// -----------------------------------------------------------------------------
+
+/* Rounded a * b / 255. */
+static inline uint32_t __soft_mul(uint32_t a, uint32_t b)
+{
+    uint32_t t = (a * b) + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+static inline uint32_t __soft_min255(uint32_t value)
+{
+    return (value > 255) ? 255 : value;
+}
+
+static void __soft_color(uint32_t color, soft_pixel_t * pixel)
+{
+    pixel->c[CHANNEL_R] = color & 0xFF;
+    pixel->c[CHANNEL_G] = (color >> 8) & 0xFF;
+    pixel->c[CHANNEL_B] = (color >> 16) & 0xFF;
+    pixel->c[CHANNEL_A] = color >> 24;
+}
+
+/*
+ * Computes the layout of a packed format: the channels are listed from the low bits,
+ * swizzle 0: B G R A, 1: A B G R, 2: R G B A, 3: A R G B.
+ */
+static void __soft_packed_layout(soft_layout_t * layout, uint32_t bpp, uint32_t swizzle,
+                                 uint32_t r, uint32_t g, uint32_t b, uint32_t a)
+{
+    static const uint8_t order[4][4] = {
+        { CHANNEL_B, CHANNEL_G, CHANNEL_R, CHANNEL_A },
+        { CHANNEL_A, CHANNEL_B, CHANNEL_G, CHANNEL_R },
+        { CHANNEL_R, CHANNEL_G, CHANNEL_B, CHANNEL_A },
+        { CHANNEL_A, CHANNEL_R, CHANNEL_G, CHANNEL_B },
+    };
+    uint32_t i;
+    uint32_t shift = 0;
+
+    memset(layout, 0, sizeof(*layout));
+    layout->kind = SOFT_KIND_PACKED;
+    layout->bpp = bpp;
+    layout->width[CHANNEL_R] = (uint8_t)r;
+    layout->width[CHANNEL_G] = (uint8_t)g;
+    layout->width[CHANNEL_B] = (uint8_t)b;
+    layout->width[CHANNEL_A] = (uint8_t)a;
+    for (i = 0; i < 4; i++) {
+        uint32_t channel = order[swizzle & 3][i];
+        layout->shift[channel] = (uint8_t)shift;
+        shift += layout->width[channel];
+    }
+}
+
+/* Decodes the target format state (0x0A10). */
+static void __soft_target_layout(uint32_t format, soft_layout_t * layout)
+{
+    uint32_t swizzle = (format >> 4) & 3;
+
+    switch (format & 0xF) {
+    case 0x0: __soft_packed_layout(layout, 8, 0, 0, 0, 0, 8); break;
+    case 0x1: __soft_packed_layout(layout, 16, swizzle, 5, 6, 5, 0); break;
+    case 0x2: __soft_packed_layout(layout, 32, swizzle, 8, 8, 8, 8); layout->opaque = 1; break;
+    case 0x3: __soft_packed_layout(layout, 32, swizzle, 8, 8, 8, 8); break;
+    case 0x4: __soft_packed_layout(layout, 16, swizzle, 4, 4, 4, 4); break;
+    case 0x5: __soft_packed_layout(layout, 16, swizzle, 5, 5, 5, 1); break;
+    case 0x6: memset(layout, 0, sizeof(*layout)); layout->kind = SOFT_KIND_LUMINANCE; layout->bpp = 8; break;
+    case 0x7: __soft_packed_layout(layout, 8, swizzle, 2, 2, 2, 2); break;
+    default: memset(layout, 0, sizeof(*layout)); layout->kind = SOFT_KIND_UNSUPPORTED; break;
+    }
+}
+
+/* Decodes the image format state (0x0A25). */
+static void __soft_image_layout(uint32_t format, soft_layout_t * layout)
+{
+    static const uint32_t clut_states[4] = { 0x0A98, 0x0A9C, 0x0AA0, 0x0B00 };
+    static const uint32_t index_bpp[4] = { 1, 2, 4, 8 };
+    uint32_t swizzle = (format >> 4) & 3;
+    uint32_t extended = (format >> 9) & 7;
+
+    if (extended >= 1 && extended <= 4) {
+        memset(layout, 0, sizeof(*layout));
+        layout->kind = SOFT_KIND_INDEX;
+        layout->bpp = index_bpp[extended - 1];
+        layout->clut = &STATE(clut_states[extended - 1]);
+        return;
+    }
+    if (extended == 5) {
+        __soft_packed_layout(layout, 8, swizzle, 2, 2, 2, 2);
+        return;
+    }
+
+    switch (format & 0xF) {
+    case 0x0: memset(layout, 0, sizeof(*layout)); layout->kind = SOFT_KIND_LUMINANCE; layout->bpp = 8; break;
+    case 0x1: __soft_packed_layout(layout, 4, 0, 0, 0, 0, 4); break;
+    case 0x2: __soft_packed_layout(layout, 8, 0, 0, 0, 0, 8); break;
+    case 0x3: __soft_packed_layout(layout, 16, swizzle, 4, 4, 4, 4); break;
+    case 0x4: __soft_packed_layout(layout, 16, swizzle, 5, 5, 5, 1); break;
+    case 0x5: __soft_packed_layout(layout, 16, swizzle, 5, 6, 5, 0); break;
+    case 0x6: __soft_packed_layout(layout, 32, swizzle, 8, 8, 8, 8); layout->opaque = 1; break;
+    case 0x7: __soft_packed_layout(layout, 32, swizzle, 8, 8, 8, 8); break;
+    default: memset(layout, 0, sizeof(*layout)); layout->kind = SOFT_KIND_UNSUPPORTED; break;
+    }
+}
+
+static uint32_t __soft_read_word(const uint8_t * row, int32_t x, uint32_t bpp)
+{
+    switch (bpp) {
+    case 32: return ((const uint32_t *)row)[x];
+    case 16: return ((const uint16_t *)row)[x];
+    case 8: return row[x];
+    default:
+        /* The first pixel is in the low bits of the byte. */
+        return (row[((uint32_t)x * bpp) / 8] >> (((uint32_t)x * bpp) % 8)) & ((1u << bpp) - 1);
+    }
+}
+
+static void __soft_write_word(uint8_t * row, int32_t x, uint32_t bpp, uint32_t value)
+{
+    switch (bpp) {
+    case 32: ((uint32_t *)row)[x] = value; break;
+    case 16: ((uint16_t *)row)[x] = (uint16_t)value; break;
+    case 8: row[x] = (uint8_t)value; break;
+    default: {
+        uint32_t shift = ((uint32_t)x * bpp) % 8;
+        uint32_t mask = ((1u << bpp) - 1) << shift;
+        uint8_t * byte = &row[((uint32_t)x * bpp) / 8];
+        *byte = (uint8_t)((*byte & ~mask) | ((value << shift) & mask));
+        break;
+    }
+    }
+}
+
+/* Reads a pixel: the channels missing in the layout are set to 255. */
+static void __soft_read_pixel(const soft_layout_t * layout, const uint8_t * row, int32_t x, soft_pixel_t * pixel)
+{
+    uint32_t word = __soft_read_word(row, x, layout->bpp);
+    uint32_t i;
+
+    switch (layout->kind) {
+    case SOFT_KIND_PACKED:
+        for (i = 0; i < 4; i++) {
+            uint32_t width = layout->width[i];
+            if (width == 0) {
+                pixel->c[i] = 255;
+            }
+            else {
+                uint32_t max = (1u << width) - 1;
+                uint32_t value = (word >> layout->shift[i]) & max;
+                pixel->c[i] = (value * 255 + (max / 2)) / max;
+            }
+        }
+        if (layout->opaque) {
+            pixel->c[CHANNEL_A] = 255;
+        }
+        break;
+    case SOFT_KIND_LUMINANCE:
+        pixel->c[CHANNEL_R] = pixel->c[CHANNEL_G] = pixel->c[CHANNEL_B] = word;
+        pixel->c[CHANNEL_A] = 255;
+        break;
+    case SOFT_KIND_INDEX:
+        /* The CLUT entries have the layout of the color state. */
+        __soft_color(layout->clut[word], pixel);
+        break;
+    default:
+        memset(pixel, 0, sizeof(*pixel));
+        break;
+    }
+}
+
+static void __soft_write_pixel(const soft_layout_t * layout, uint8_t * row, int32_t x, const soft_pixel_t * pixel)
+{
+    uint32_t word = 0;
+    uint32_t i;
+
+    if (layout->kind == SOFT_KIND_LUMINANCE) {
+        word = ((pixel->c[CHANNEL_R] * 77) + (pixel->c[CHANNEL_G] * 150) + (pixel->c[CHANNEL_B] * 29) + 128) >> 8;
+    }
+    else {
+        for (i = 0; i < 4; i++) {
+            uint32_t width = layout->width[i];
+            if (width != 0) {
+                uint32_t max = (1u << width) - 1;
+                uint32_t value = ((i == CHANNEL_A) && layout->opaque) ? 255 : pixel->c[i];
+                word |= ((value * max + 127) / 255) << layout->shift[i];
+            }
+        }
+    }
+    __soft_write_word(row, x, layout->bpp, word);
+}
+
+/* Blends the premultiplied source over the premultiplied destination. */
+static void __soft_blend(uint32_t mode, const soft_pixel_t * s, soft_pixel_t * d, uint32_t coverage)
+{
+    uint32_t sa = s->c[CHANNEL_A];
+    uint32_t da = d->c[CHANNEL_A];
+    uint32_t i;
+
+    for (i = 0; i < 4; i++) {
+        uint32_t sc = s->c[i];
+        uint32_t dc = d->c[i];
+        uint32_t result;
+
+        switch (mode) {
+        case 0x1: result = sc + __soft_mul(dc, 255 - sa); break;
+        case 0x2: result = __soft_mul(sc, 255 - da) + dc; break;
+        case 0x3: result = __soft_mul(sc, da); break;
+        case 0x4: result = __soft_mul(dc, sa); break;
+        case 0x5: result = __soft_mul(sc, 255 - da) + __soft_mul(dc, 255 - sa) + __soft_mul(sc, dc); break;
+        case 0x6: result = sc + dc - __soft_mul(sc, dc); break;
+        case 0x9: result = sc + dc; break;
+        case 0xA: result = __soft_mul(dc, 255 - sc); break;
+        default: result = sc; break;
+        }
+        result = __soft_min255(result);
+
+        if (coverage != 255) {
+            result = __soft_mul(result, coverage) + __soft_mul(dc, 255 - coverage);
+        }
+        d->c[i] = result;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Paint
+// -----------------------------------------------------------------------------
+
+static int __soft_setup_target(soft_target_t * target)
+{
+    uint32_t clip = STATE(0x0A13);
+    uint32_t stride = STATE(0x0A12);
+
+    __soft_target_layout(STATE(0x0A10), &target->layout);
+    target->right = (int32_t)(clip & 0xFFFF);
+    target->bottom = (int32_t)(clip >> 16);
+    target->stride = stride & 0x0FFFFFFF;
+    target->memory = (uint8_t *)__soft_translate(STATE(0x0A11), target->stride * (uint32_t)target->bottom);
+
+    return (target->memory != NULL) && (target->layout.kind != SOFT_KIND_UNSUPPORTED) && ((stride & 0x10000000) == 0);
+}
+
+static int __soft_setup_image(soft_image_t * image)
+{
+    uint32_t format = STATE(0x0A25);
+    uint32_t stride = STATE(0x0A2B);
+    uint32_t origin = STATE(0x0A2D);
+    uint32_t size = STATE(0x0A2F);
+
+    __soft_image_layout(format, &image->layout);
+    image->x = (int32_t)(origin & 0xFFFF);
+    image->y = (int32_t)(origin >> 16);
+    image->width = (int32_t)(size & 0xFFFF);
+    image->height = (int32_t)(size >> 16);
+    image->stride = stride & 0x0FFFFFFF;
+    image->filter = (format >> 16) & 3;
+    image->pad = (format & 0x1000) != 0;
+    image->premultiply = (format & 0x100) == 0;
+    __soft_color(STATE(0x0A27), &image->border);
+    image->memory = (const uint8_t *)__soft_translate(STATE(0x0A29), image->stride * (uint32_t)(image->y + image->height));
+
+    return (image->memory != NULL) && (image->layout.kind != SOFT_KIND_UNSUPPORTED) && ((stride & 0x10000000) == 0)
+        && (image->width > 0) && (image->height > 0);
+}
+
+/* Fetches a premultiplied texel; the texels outside the image are padded or replaced by the pattern color. */
+static void __soft_fetch(const soft_image_t * image, int32_t x, int32_t y, soft_pixel_t * texel)
+{
+    uint32_t alpha;
+
+    if (x < 0 || y < 0 || x >= image->width || y >= image->height) {
+        if (!image->pad) {
+            *texel = image->border;
+            return;
+        }
+        x = (x < 0) ? 0 : ((x >= image->width) ? image->width - 1 : x);
+        y = (y < 0) ? 0 : ((y >= image->height) ? image->height - 1 : y);
+    }
+    __soft_read_pixel(&image->layout, image->memory + ((uint32_t)(image->y + y) * image->stride), image->x + x, texel);
+
+    alpha = texel->c[CHANNEL_A];
+    if (image->premultiply && alpha != 255) {
+        texel->c[CHANNEL_R] = __soft_mul(texel->c[CHANNEL_R], alpha);
+        texel->c[CHANNEL_G] = __soft_mul(texel->c[CHANNEL_G], alpha);
+        texel->c[CHANNEL_B] = __soft_mul(texel->c[CHANNEL_B], alpha);
+    }
+}
+
+static void __soft_lerp(soft_pixel_t * a, const soft_pixel_t * b, uint32_t weight)
+{
+    uint32_t i;
+
+    /* weight: 0 (a) to 256 (b). */
+    for (i = 0; i < 4; i++) {
+        a->c[i] = ((a->c[i] * (256 - weight)) + (b->c[i] * weight) + 128) >> 8;
+    }
+}
+
+static float __soft_float(uint32_t address)
+{
+    float value;
+    uint32_t bits = STATE(address);
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/* Samples the image at the center of a pixel; returns 0 when the pixel is culled. */
+static int __soft_sample(const soft_image_t * image, int32_t x, int32_t y, soft_pixel_t * texel)
+{
+    float fx = (float)x;
+    float fy = (float)y;
+    float u = __soft_float(0x0A18) + (__soft_float(0x0A1C) * fx) + (__soft_float(0x0A20) * fy);
+    float v = __soft_float(0x0A19) + (__soft_float(0x0A1D) * fx) + (__soft_float(0x0A21) * fy);
+    float w = __soft_float(0x0A1A) + (__soft_float(0x0A1E) * fx) + (__soft_float(0x0A22) * fy);
+    float tx;
+    float ty;
+
+    if (w != 1.0f) {
+        if (w <= 0.0f) {
+            return 0;
+        }
+        u /= w;
+        v /= w;
+    }
+    tx = u * (float)image->width;
+    ty = v * (float)image->height;
+
+    if ((STATE(0x0A00) & 0x8000) != 0) {
+        /* Border culling: the pixels outside the image are not drawn. */
+        if (tx < 0.0f || ty < 0.0f || tx >= (float)image->width || ty >= (float)image->height) {
+            return 0;
+        }
+    }
+
+    if (image->filter == 0) {
+        __soft_fetch(image, (int32_t)floorf(tx), (int32_t)floorf(ty), texel);
+    }
+    else {
+        soft_pixel_t right;
+        float x0 = floorf(tx - 0.5f);
+        int32_t ix = (int32_t)x0;
+        uint32_t wx = (uint32_t)(((tx - 0.5f - x0) * 256.0f) + 0.5f);
+
+        if (image->filter == 1) {
+            /* Linear: interpolated along the X axis only (gradients). */
+            int32_t iy = (int32_t)floorf(ty);
+            __soft_fetch(image, ix, iy, texel);
+            __soft_fetch(image, ix + 1, iy, &right);
+            __soft_lerp(texel, &right, wx);
+        }
+        else {
+            soft_pixel_t bottom;
+            float y0 = floorf(ty - 0.5f);
+            int32_t iy = (int32_t)y0;
+            uint32_t wy = (uint32_t)(((ty - 0.5f - y0) * 256.0f) + 0.5f);
+
+            __soft_fetch(image, ix, iy, texel);
+            __soft_fetch(image, ix + 1, iy, &right);
+            __soft_lerp(texel, &right, wx);
+            __soft_fetch(image, ix, iy + 1, &bottom);
+            __soft_fetch(image, ix + 1, iy + 1, &right);
+            __soft_lerp(&bottom, &right, wx);
+            __soft_lerp(texel, &bottom, wy);
+        }
+    }
+    return 1;
+}
+
+/*
+ * Fills a span of a row with the paint. The coverage is NULL for a full coverage, else
+ * it gives the coverage (0 to 255) of each pixel of the span.
+ */
+static void __soft_shade_span(const soft_target_t * target, const soft_image_t * image,
+                              int32_t y, int32_t x0, int32_t x1, const uint8_t * coverage)
+{
+    uint32_t control = STATE(0x0A00);
+    uint32_t blend = (control >> 8) & 0xF;
+    uint32_t image_mode = control & 0x3000;
+    uint8_t * row = target->memory + ((uint32_t)y * target->stride);
+    soft_pixel_t color;
+    soft_pixel_t paint;
+    soft_pixel_t pixel;
+    int32_t x;
+
+    __soft_color(STATE(0x0A02), &color);
+    paint = color;
+
+    for (x = x0; x < x1; x++) {
+        uint32_t cov = (coverage != NULL) ? coverage[x - x0] : 255;
+        if (cov == 0) {
+            continue;
+        }
+        if (image_mode != 0) {
+            if (!__soft_sample(image, x, y, &paint)) {
+                continue;
+            }
+            if (image_mode == 0x2000) {
+                /* Multiply image mode: the color modulates the image. */
+                uint32_t i;
+                for (i = 0; i < 4; i++) {
+                    paint.c[i] = __soft_mul(paint.c[i], color.c[i]);
+                }
+            }
+        }
+        __soft_read_pixel(&target->layout, row, x, &pixel);
+        __soft_blend(blend, &paint, &pixel, cov);
+        __soft_write_pixel(&target->layout, row, x, &pixel);
+        device->pixels++;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Rectangles
+// -----------------------------------------------------------------------------
+
+/* Clear (no image mode) and blit: the rectangle is drawn with the paint. */
+static void __soft_draw_rectangle(const uint8_t * data)
+{
+    soft_target_t target;
+    soft_image_t image;
+    uint16_t rectangle[4];
+    int32_t x0, y0, x1, y1, y;
+    int image_paint = (STATE(0x0A00) & 0x3000) != 0;
+
+    __soft_begin(image_paint ? VG_LITE_SOFT_BLIT : VG_LITE_SOFT_CLEAR);
+
+    memcpy(rectangle, data, sizeof(rectangle));
+    x0 = rectangle[0];
+    y0 = rectangle[1];
+    x1 = x0 + rectangle[2];
+    y1 = y0 + rectangle[3];
+
+    if (!__soft_setup_target(&target) || (image_paint && !__soft_setup_image(&image))) {
+        __profile.errors++;
+    }
+    else {
+        x1 = (x1 > target.right) ? target.right : x1;
+        y1 = (y1 > target.bottom) ? target.bottom : y1;
+        for (y = y0; y < y1; y++) {
+            __soft_shade_span(&target, &image, y, x0, x1, NULL);
+        }
+    }
+
+    __soft_end();
+}
+
+// -----------------------------------------------------------------------------
+// Paths
+// -----------------------------------------------------------------------------
+
+static int __soft_reserve(void ** array, uint32_t * capacity, uint32_t count, uint32_t element)
+{
+    if (count > *capacity) {
+        uint32_t new_capacity = (count > *capacity * 2) ? count : *capacity * 2;
+        void * new_array = realloc(*array, (size_t)new_capacity * element);
+        if (new_array == NULL) {
+            return 0;
+        }
+        *array = new_array;
+        *capacity = new_capacity;
+    }
+    return 1;
+}
+
+static void __soft_add_edge(float x0, float y0, float x1, float y1)
+{
+    soft_edge_t * edge;
+
+    if (y0 == y1) {
+        /* Horizontal edges never cross a sample row. */
+        return;
+    }
+    if (!__soft_reserve((void **)&device->edges, &device->edge_capacity, device->edge_count + 1, sizeof(soft_edge_t))) {
+        return;
+    }
+    edge = &device->edges[device->edge_count++];
+    if (y0 < y1) {
+        edge->x0 = x0; edge->y0 = y0; edge->x1 = x1; edge->y1 = y1;
+        edge->direction = 1;
+    }
+    else {
+        edge->x0 = x1; edge->y0 = y1; edge->x1 = x0; edge->y1 = y0;
+        edge->direction = -1;
+    }
+}
+
+static void __soft_transform(float x, float y, float * out)
+{
+    float scale = __soft_float(0x0A3B);
+    float bias = __soft_float(0x0A3C);
+
+    x = (x * scale) + bias;
+    y = (y * scale) + bias;
+    out[0] = (__soft_float(0x0A40) * x) + (__soft_float(0x0A41) * y) + __soft_float(0x0A42);
+    out[1] = (__soft_float(0x0A43) * x) + (__soft_float(0x0A44) * y) + __soft_float(0x0A45);
+}
+
+/* Number of segments so that the segments are closer to the curve than the tolerance. */
+static uint32_t __soft_segments(float deviation, float factor)
+{
+    float n = sqrtf((deviation * factor) / VG_LITE_SOFT_CURVE_TOLERANCE);
+    uint32_t count = (uint32_t)ceilf(n);
+
+    return (count < 1) ? 1 : ((count > SOFT_MAX_CURVE_SEGMENTS) ? SOFT_MAX_CURVE_SEGMENTS : count);
+}
+
+static void __soft_add_quad(const float * p0, const float * p1, const float * p2)
+{
+    float dx = p0[0] - (2.0f * p1[0]) + p2[0];
+    float dy = p0[1] - (2.0f * p1[1]) + p2[1];
+    uint32_t count = __soft_segments(sqrtf((dx * dx) + (dy * dy)), 0.25f);
+    float x = p0[0];
+    float y = p0[1];
+    uint32_t i;
+
+    for (i = 1; i <= count; i++) {
+        float t = (float)i / (float)count;
+        float mt = 1.0f - t;
+        float nx = (mt * mt * p0[0]) + (2.0f * mt * t * p1[0]) + (t * t * p2[0]);
+        float ny = (mt * mt * p0[1]) + (2.0f * mt * t * p1[1]) + (t * t * p2[1]);
+        __soft_add_edge(x, y, nx, ny);
+        x = nx;
+        y = ny;
+    }
+}
+
+static void __soft_add_cubic(const float * p0, const float * p1, const float * p2, const float * p3)
+{
+    float dx0 = p0[0] - (2.0f * p1[0]) + p2[0];
+    float dy0 = p0[1] - (2.0f * p1[1]) + p2[1];
+    float dx1 = p1[0] - (2.0f * p2[0]) + p3[0];
+    float dy1 = p1[1] - (2.0f * p2[1]) + p3[1];
+    float d0 = (dx0 * dx0) + (dy0 * dy0);
+    float d1 = (dx1 * dx1) + (dy1 * dy1);
+    uint32_t count = __soft_segments(sqrtf((d0 > d1) ? d0 : d1), 0.75f);
+    float x = p0[0];
+    float y = p0[1];
+    uint32_t i;
+
+    for (i = 1; i <= count; i++) {
+        float t = (float)i / (float)count;
+        float mt = 1.0f - t;
+        float a = mt * mt * mt;
+        float b = 3.0f * mt * mt * t;
+        float c = 3.0f * mt * t * t;
+        float d = t * t * t;
+        float nx = (a * p0[0]) + (b * p1[0]) + (c * p2[0]) + (d * p3[0]);
+        float ny = (a * p0[1]) + (b * p1[1]) + (c * p2[1]) + (d * p3[1]);
+        __soft_add_edge(x, y, nx, ny);
+        x = nx;
+        y = ny;
+    }
+}
+
+static float __soft_coordinate(const uint8_t * data, uint32_t format)
+{
+    switch (format) {
+    case 0: return (float)*(const int8_t *)data;
+    case 1: { int16_t v; memcpy(&v, data, sizeof(v)); return (float)v; }
+    case 2: { int32_t v; memcpy(&v, data, sizeof(v)); return (float)v; }
+    default: { float v; memcpy(&v, data, sizeof(v)); return v; }
+    }
+}
+
+/* Flattens the path data into edges, in the target coordinates. */
+static void __soft_flatten(const uint8_t * data, uint32_t bytes)
+{
+    static const uint8_t data_count[] = { 0, 0, 2, 2, 2, 2, 4, 4, 6, 6, 5, 5, 5, 5, 5, 5, 5, 5 };
+    static const uint32_t data_size[] = { 1, 2, 4, 4 };
+    uint32_t format = (STATE(0x0A34) >> 20) & 3;
+    uint32_t size = data_size[format];
+    uint32_t offset = 0;
+    float start[2] = { 0.0f, 0.0f };     /* Sub-path start (path coordinates). */
+    float current[2] = { 0.0f, 0.0f };   /* Current point (path coordinates). */
+    float from[2];
+    float to[2];
+
+    device->edge_count = 0;
+
+    while (offset < bytes) {
+        uint8_t op = data[offset++];
+        float c[6];
+        float p[3][2];
+        uint32_t count;
+        uint32_t i;
+        int relative;
+
+        if (op >= sizeof(data_count)) {
+            __profile.errors++;
+            break;
+        }
+        count = data_count[op];
+        if (count == 0) {
+            /* END and CLOSE: the fill closes the sub-path. */
+            __soft_transform(current[0], current[1], from);
+            __soft_transform(start[0], start[1], to);
+            __soft_add_edge(from[0], from[1], to[0], to[1]);
+            current[0] = start[0];
+            current[1] = start[1];
+            continue;
+        }
+
+        offset = (offset + size - 1) & ~(size - 1);
+        if (offset + (count * size) > bytes) {
+            break;
+        }
+        for (i = 0; i < count; i++) {
+            c[i] = __soft_coordinate(&data[offset], format);
+            offset += size;
+        }
+
+        relative = (op & 1) != 0;
+        if (op >= 0x0A) {
+            /* Arcs (rh, rv, rot, x, y): approximated by the segment to their end point. */
+            c[0] = c[3];
+            c[1] = c[4];
+            count = 2;
+        }
+        if (relative) {
+            for (i = 0; i < count; i += 2) {
+                c[i] += current[0];
+                c[i + 1] += current[1];
+            }
+        }
+
+        __soft_transform(current[0], current[1], from);
+        for (i = 0; i < count / 2; i++) {
+            __soft_transform(c[i * 2], c[(i * 2) + 1], p[i]);
+        }
+
+        switch (op & ~1) {
+        case 0x02:
+            /* Move: closes the previous sub-path. */
+            __soft_transform(start[0], start[1], to);
+            __soft_add_edge(from[0], from[1], to[0], to[1]);
+            start[0] = c[0];
+            start[1] = c[1];
+            break;
+        case 0x06:
+            __soft_add_quad(from, p[0], p[1]);
+            break;
+        case 0x08:
+            __soft_add_cubic(from, p[0], p[1], p[2]);
+            break;
+        default:
+            __soft_add_edge(from[0], from[1], p[(count / 2) - 1][0], p[(count / 2) - 1][1]);
+            break;
+        }
+        current[0] = c[count - 2];
+        current[1] = c[count - 1];
+    }
+
+    /* Close the last sub-path. */
+    __soft_transform(current[0], current[1], from);
+    __soft_transform(start[0], start[1], to);
+    __soft_add_edge(from[0], from[1], to[0], to[1]);
+}
+
+static int __soft_compare_edges(const void * a, const void * b)
+{
+    float ya = ((const soft_edge_t *)a)->y0;
+    float yb = ((const soft_edge_t *)b)->y0;
+    return (ya < yb) ? -1 : ((ya > yb) ? 1 : 0);
+}
+
+/* Rasterizes the flattened path in the tessellation window. */
+static void __soft_fill(const soft_target_t * target, const soft_image_t * image)
+{
+    static const uint32_t columns[4] = { 1, 2, 2, 4 };
+    static const uint32_t rows[4] = { 1, 2, 4, 4 };
+    uint32_t control = STATE(0x0A34);
+    uint32_t quality = control & 3;
+    uint32_t cols = columns[quality];
+    uint32_t samples_rows = rows[quality];
+    uint32_t total = cols * samples_rows;
+    int even_odd = (control & 0x10) != 0;
+    uint32_t origin = STATE(0x0A39);
+    uint32_t size = STATE(0x0A3A);
+    int32_t x0 = (int32_t)(origin & 0xFFFF);
+    int32_t y0 = (int32_t)(origin >> 16);
+    int32_t x1 = x0 + (int32_t)(size & 0xFFFF);
+    int32_t y1 = y0 + (int32_t)(size >> 16);
+    float min_y;
+    float max_y;
+    uint32_t width;
+    uint32_t i;
+    int32_t y;
+
+    if (device->edge_count == 0) {
+        return;
+    }
+
+    x1 = (x1 > target->right) ? target->right : x1;
+    y1 = (y1 > target->bottom) ? target->bottom : y1;
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+    width = (uint32_t)(x1 - x0);
+    if (!__soft_reserve((void **)&device->samples, &device->span_capacity, width, sizeof(uint16_t) + sizeof(uint8_t))) {
+        return;
+    }
+    device->coverage = (uint8_t *)(device->samples + device->span_capacity);
+    if (!__soft_reserve((void **)&device->crossings, &device->crossing_capacity, device->edge_count, sizeof(soft_crossing_t))) {
+        return;
+    }
+
+    qsort(device->edges, device->edge_count, sizeof(soft_edge_t), __soft_compare_edges);
+    min_y = device->edges[0].y0;
+    max_y = device->edges[0].y1;
+    for (i = 1; i < device->edge_count; i++) {
+        max_y = (device->edges[i].y1 > max_y) ? device->edges[i].y1 : max_y;
+    }
+    y0 = ((float)y0 < floorf(min_y)) ? (int32_t)floorf(min_y) : y0;
+    y1 = ((float)y1 > ceilf(max_y)) ? (int32_t)ceilf(max_y) : y1;
+
+    for (y = y0; y < y1; y++) {
+        uint32_t row;
+        int32_t first = (int32_t)width;
+        int32_t last = -1;
+
+        memset(device->samples, 0, width * sizeof(uint16_t));
+
+        for (row = 0; row < samples_rows; row++) {
+            float sy = (float)y + (((float)row + 0.5f) / (float)samples_rows);
+            uint32_t count = 0;
+            int32_t winding = 0;
+
+            /* Crossings of the sample row, sorted by abscissa. */
+            for (i = 0; (i < device->edge_count) && (device->edges[i].y0 <= sy); i++) {
+                const soft_edge_t * edge = &device->edges[i];
+                if (sy < edge->y1) {
+                    float x = edge->x0 + (((sy - edge->y0) * (edge->x1 - edge->x0)) / (edge->y1 - edge->y0));
+                    uint32_t j = count++;
+                    while (j > 0 && device->crossings[j - 1].x > x) {
+                        device->crossings[j] = device->crossings[j - 1];
+                        j--;
+                    }
+                    device->crossings[j].x = x;
+                    device->crossings[j].direction = edge->direction;
+                }
+            }
+
+            for (i = 0; i + 1 < count; i++) {
+                winding += device->crossings[i].direction;
+                if (even_odd ? ((winding & 1) != 0) : (winding != 0)) {
+                    /* The samples of the row are at (k + 0.5) / cols. */
+                    int32_t k0 = (int32_t)ceilf((device->crossings[i].x * (float)cols) - 0.5f);
+                    int32_t k1 = (int32_t)ceilf((device->crossings[i + 1].x * (float)cols) - 0.5f);
+                    int32_t min_k = x0 * (int32_t)cols;
+                    int32_t max_k = x1 * (int32_t)cols;
+
+                    k0 = (k0 < min_k) ? min_k : k0;
+                    k1 = (k1 > max_k) ? max_k : k1;
+                    while (k0 < k1) {
+                        int32_t pixel = k0 / (int32_t)cols;
+                        int32_t end = (pixel + 1) * (int32_t)cols;
+                        end = (end > k1) ? k1 : end;
+                        device->samples[pixel - x0] += (uint16_t)(end - k0);
+                        first = ((pixel - x0) < first) ? (pixel - x0) : first;
+                        last = ((pixel - x0) > last) ? (pixel - x0) : last;
+                        k0 = end;
+                    }
+                }
+            }
+        }
+
+        if (last >= first) {
+            int32_t x;
+            for (x = first; x <= last; x++) {
+                device->coverage[x] = (uint8_t)(((device->samples[x] * 255u) + (total / 2)) / total);
+            }
+            __soft_shade_span(target, image, y, x0 + first, x0 + last + 1, &device->coverage[first]);
+        }
+    }
+}
+
+/* Draws the path data in the current tessellation window. */
+static void __soft_draw_path(const uint8_t * data, uint32_t bytes)
+{
+    soft_target_t target;
+    soft_image_t image;
+    int image_paint = (STATE(0x0A00) & 0x3000) != 0;
+
+    if (!__soft_setup_target(&target) || (image_paint && !__soft_setup_image(&image))) {
+        __profile.errors++;
+        return;
+    }
+    __soft_flatten(data, bytes);
+    __soft_fill(&target, &image);
+}
+
+// -----------------------------------------------------------------------------
+// Command buffers
+// -----------------------------------------------------------------------------
+
+static void __soft_deliver(void);
+
+/* Raises interrupts: they are handled when the kernel leaves its critical section. */
+static void __soft_raise(uint32_t flags)
+{
+    device->int_status |= flags;
+    if (device->critical == 0 && !device->delivering) {
+        __soft_deliver();
+    }
+}
+
+static void __soft_set_state(uint32_t address, uint32_t value)
+{
+    if (address >= SOFT_STATE_FIRST && address < SOFT_STATE_FIRST + SOFT_STATE_COUNT) {
+        if (address == 0x0A34) {
+            /* A path drawing starts with a tessellation control and ends by clearing it. */
+            if (STATE(0x0A34) == 0 && value != 0) {
+                __soft_begin(((value & 0x400) != 0) ? VG_LITE_SOFT_PATTERN : VG_LITE_SOFT_DRAW);
+            }
+            else if (STATE(0x0A34) != 0 && value == 0) {
+                __soft_end();
+            }
+        }
+        STATE(address) = value;
+    }
+    /* else: state not used by the software GPU. */
+}
+
+static void __soft_execute(uint32_t address, uint32_t bytes, uint32_t depth)
+{
+    const uint32_t * commands = (const uint32_t *)__soft_translate(address, bytes);
+    uint32_t count = bytes / 4;
+    uint32_t i = 0;
+
+    if (commands == NULL || depth > SOFT_MAX_CALL_DEPTH) {
+        __profile.errors++;
+        return;
+    }
+
+    while (i < count) {
+        uint32_t command = commands[i];
+
+        switch (command >> 28) {
+        case 0x0:
+            /* End: raises the interrupt. */
+            __soft_raise(1u << (command & 0x1F));
+            return;
+        case 0x1:
+        case 0x2:
+            /* Semaphore and stall: the commands are executed in order. */
+            i += 2;
+            break;
+        case 0x3: {
+            uint32_t states = (command >> 16) & 0xFFF;
+            uint32_t state = command & 0xFFFF;
+            uint32_t j;
+            if (i + 1 + states > count) {
+                __profile.errors++;
+                return;
+            }
+            for (j = 0; j < states; j++) {
+                __soft_set_state(state + j, commands[i + 1 + j]);
+            }
+            /* Aligned on 64 bits. */
+            i += (states + 2) & ~1u;
+            break;
+        }
+        case 0x4: {
+            uint32_t data_bytes = (command & 0x0FFFFFFF) * 8;
+            const uint8_t * data = (const uint8_t *)&commands[i + 2];
+            if (i + 2 + (data_bytes / 4) > count) {
+                __profile.errors++;
+                return;
+            }
+            if (STATE(0x0A34) != 0) {
+                __soft_draw_path(data, data_bytes);
+            }
+            else if (data_bytes >= 8) {
+                __soft_draw_rectangle(data);
+            }
+            i += 2 + (data_bytes / 4);
+            break;
+        }
+        case 0x6:
+            /* Call: the uploaded paths. */
+            __soft_execute(commands[i + 1], (command & 0x0FFFFFFF) * 8, depth + 1);
+            i += 2;
+            break;
+        case 0x7:
+            /* Return. */
+            return;
+        case 0x8:
+            /* Nop. */
+            i += 2;
+            break;
+        default:
+            __profile.errors++;
+            return;
+        }
+    }
+}
+
+/* Executes a command buffer kicked off by the kernel. */
+static void __soft_run_command_buffer(uint32_t address, uint32_t bytes)
+{
+    __profile.command_buffers++;
+    __profile.command_bytes += bytes;
+    __soft_execute(address, bytes, 0);
+}
+
+uint32_t vg_lite_soft_run(uint32_t count)
+{
+    uint32_t executed = 0;
+
+    /* The END interrupt of each command buffer kicks off the next queued one. */
+    while ((executed < count) && device->pending) {
+        device->pending = 0;
+        __soft_run_command_buffer(device->pending_address, device->pending_bytes);
+        executed++;
+    }
+    return executed;
+}
+
+/* Handles the raised interrupts like the hardware IRQ handler. */
+static void __soft_deliver(void)
+{
+    device->delivering = 1;
+    while (device->int_status != 0) {
+        uint32_t flags = device->int_status;
+        device->int_status = 0;
+        device->int_flags |= flags;
+
+        /* Start the next queued command buffer: executed (and raised) in this loop. */
+        vg_lite_kernel_interrupt(flags);
+
+#if _VG_LITE_IRQ_CALLBACK == 1
+        if (__irq_callback != NULL) {
+            __irq_callback();
+        }
+#endif /* _VG_LITE_IRQ_CALLBACK */
+    }
+    device->delivering = 0;
+}
+
+// -----------------------------------------------------------------------------
+// HAL
+// -----------------------------------------------------------------------------
+
+void * vg_lite_hal_alloc(unsigned long size)
+{
+    return malloc(size);
+}
+
+void vg_lite_hal_free(void * memory)
+{
+    free(memory);
+}
+
+void vg_lite_hal_delay(uint32_t ms)
+{
+    /* The software GPU is never busy. */
+    (void) ms;
+}
+
+void vg_lite_hal_barrier(void)
+{
+    /* The command buffers are executed by the calling thread. */
+}
+
+void vg_lite_hal_initialize(void)
+{
+    device = &Device;
+    memset(device, 0, sizeof(struct vg_lite_device));
+
+    if (contiguousMem == NULL) {
+        contiguousMem = (uint8_t *)malloc(heap_size);
+    }
+    device->contiguous = contiguousMem;
+    device->size = (contiguousMem != NULL) ? heap_size : 0;
+    device->free = device->size;
+    if (sizeof(void *) == sizeof(uint32_t)) {
+        device->physical = gpuMemBase + (uint32_t)(uintptr_t)device->contiguous;
+    }
+    else {
+        device->physical = SOFT_CONTIGUOUS_BASE;
+    }
+    device->next_mapping = SOFT_MAPPING_BASE;
+
+    device->heap.next = device->heap.prev = &device->heap;
+    if (device->size != 0) {
+        heap_node_t * node = (heap_node_t *)malloc(sizeof(heap_node_t));
+        if (node != NULL) {
+            node->offset = 0;
+            node->size = device->size;
+            node->status = 0;
+            add_list(&node->list, &device->heap);
+        }
+    }
+}
+
+void vg_lite_hal_deinitialize(void)
+{
+    free(device->edges);
+    free(device->crossings);
+    free(device->samples);
+    device->edges = NULL;
+    device->crossings = NULL;
+    device->samples = NULL;
+    device->edge_capacity = device->crossing_capacity = device->span_capacity = 0;
+}
+
+uint32_t vg_lite_hal_peek(uint32_t address)
+{
+    uint32_t value;
+
+    switch (address) {
+    case VG_LITE_HW_IDLE:
+        value = VG_LITE_HW_IDLE_STATE;
+        break;
+    case VG_LITE_INTR_STATUS:
+        /* Cleared when read. */
+        value = device->int_status;
+        device->int_status = 0;
+        break;
+    case VG_LITE_HW_CHIP_ID:
+        value = GPU_CHIP_ID_GCNanoliteV;
+        break;
+    case 0x24:
+        value = SOFT_CHIP_REVISION;
+        break;
+    case 0x30:
+        value = VG_LITE_SOFT_CID;
+        break;
+    default:
+        value = (address < SOFT_REGISTER_COUNT * 4) ? device->registers[address / 4] : 0;
+        break;
+    }
+    return value;
+}
+
+void vg_lite_hal_poke(uint32_t address, uint32_t data)
+{
+    if (address < SOFT_REGISTER_COUNT * 4) {
+        device->registers[address / 4] = data;
+    }
+    if (address == VG_LITE_HW_CMDBUF_SIZE) {
+        /* Writing the size kicks off the command buffer. */
+        uint32_t bytes = data * 8;
+        if (__deferred) {
+            /* Executed by vg_lite_soft_run() or when the CPU waits for the GPU. */
+            device->pending = 1;
+            device->pending_address = device->registers[VG_LITE_HW_CMDBUF_ADDRESS / 4];
+            device->pending_bytes = bytes;
+        }
+        else {
+            __soft_run_command_buffer(device->registers[VG_LITE_HW_CMDBUF_ADDRESS / 4], bytes);
+        }
+    }
+}
+
+void vg_lite_hal_register_irq_callback(vg_lite_irq_callback cb) {
+    __irq_callback = cb;
+}
+
+void vg_lite_hal_enter_critical(void)
+{
+    device->critical++;
+}
+
+void vg_lite_hal_exit_critical(void)
+{
+    device->critical--;
+    if (device->critical == 0 && device->int_status != 0 && !device->delivering) {
+        __soft_deliver();
+    }
+}
+
+int32_t vg_lite_hal_wait_interrupt(uint32_t timeout, uint32_t mask, uint32_t * value)
+{
+    (void) timeout;
+
+    if ((device->int_flags == 0) && device->pending) {
+        /* The CPU waits until the GPU has executed the command buffer. */
+        (void)vg_lite_soft_run(1);
+    }
+    if (device->int_flags == 0) {
+        /* Nothing is executing: the interrupt would never come. */
+        return 0;
+    }
+    if (value != NULL) {
+        *value = device->int_flags & mask;
+    }
+    device->int_flags = 0;
+    return 1;
+}
@@ -0,0 +1,152 @@
+/*
+ * C
+ *
+ * Copyright 2022 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/*
+ * @file
+ * @brief Software implementation of the VGLite HAL: the command buffers built by the
+ * VGLite driver are executed by a reference CPU rasterizer that writes to the host
+ * memory. It allows to run and profile the drawing stack on a workstation.
+ *
+ * The software HAL replaces the folder "VGLiteKernel/rtos" in the build: the driver
+ * (vg_lite.c) and the kernel (vg_lite_kernel.c) are used unchanged and must be compiled
+ * with VG_DRIVER_SINGLE_THREAD=1 (and EMULATOR=1 on Linux).
+ *
+ * The command buffers are executed synchronously when the kernel kicks them off; the
+ * END interrupt is raised as soon as the critical section of the kernel is left. To
+ * simulate a GPU running in parallel with the CPU, the execution can be deferred: see
+ * vg_lite_soft_set_deferred().
+ *
+ * Reference model (the documented behavior of the GCNanoLite-V):
+ * - the color register is used as-is, as a premultiplied color (the MicroEJ drawers
+ *   premultiply the colors, see DISPLAY_VGLITE_porter_duff_workaround_ARGB8888());
+ * - the image pixels are premultiplied when read, unless the image format state flags
+ *   them as already premultiplied (vg_lite_disable_premultiply());
+ * - the target stores premultiplied pixels;
+ * - the paths are flattened with a tolerance of VG_LITE_SOFT_CURVE_TOLERANCE pixel and
+ *   sampled with 1 (low), 4 (medium), 8 (upper) or 16 (high) samples per pixel;
+ * - the arcs are drawn as a segment to their end point;
+ * - the tiled and YUV layouts are not supported: the operations using them are skipped
+ *   and counted in vg_lite_soft_profile_t.errors.
+ *
+ * All the computations are done in the same order for a given command stream: the
+ * rendering is reproducible and can be compared pixel by pixel with reference images.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ */
+
+#ifndef _VG_LITE_PLATFORM_H
+#define _VG_LITE_PLATFORM_H
+
+#include "stdint.h"
+#include "stdlib.h"
+
+#define _BAREMETAL 0
+
+/* Value returned by the CID register: selects the features of the RT595 GPU (index formats, 8x quality). */
+#ifndef VG_LITE_SOFT_CID
+#define VG_LITE_SOFT_CID 0x40a
+#endif
+
+/* Maximal number of host buffers mapped with vg_lite_map() at the same time. */
+#ifndef VG_LITE_SOFT_MAX_MAPPINGS
+#define VG_LITE_SOFT_MAX_MAPPINGS 32
+#endif
+
+/* Maximal distance (in pixels) between a curve and the segments that approximate it. */
+#ifndef VG_LITE_SOFT_CURVE_TOLERANCE
+#define VG_LITE_SOFT_CURVE_TOLERANCE 0.25f
+#endif
+
+/*!
+@brief The primitives measured by the profiler.
+*/
+typedef enum vg_lite_soft_primitive {
+    VG_LITE_SOFT_CLEAR,     /*! Rectangle filled with the color: vg_lite_clear(). */
+    VG_LITE_SOFT_BLIT,      /*! Rectangle filled with an image: vg_lite_blit(), vg_lite_blit_rect(). */
+    VG_LITE_SOFT_DRAW,      /*! Path filled with the color: vg_lite_draw(). */
+    VG_LITE_SOFT_PATTERN,   /*! Path filled with an image: vg_lite_draw_pattern(), vg_lite_draw_gradient(). */
+    VG_LITE_SOFT_PRIMITIVE_COUNT,
+} vg_lite_soft_primitive_t;
+
+/*!
+@brief The counters of a primitive.
+*/
+typedef struct vg_lite_soft_counter {
+    uint32_t calls;         /*! Number of drawing calls. */
+    uint64_t pixels;        /*! Number of pixels written (the partially covered ones included). */
+    uint64_t time_ns;       /*! Cumulated execution time. */
+    uint64_t max_time_ns;   /*! Longest execution time of a call. */
+} vg_lite_soft_counter_t;
+
+/*!
+@brief The profile of the executed command buffers.
+*/
+typedef struct vg_lite_soft_profile {
+    vg_lite_soft_counter_t primitives[VG_LITE_SOFT_PRIMITIVE_COUNT];
+    uint32_t command_buffers;   /*! Number of command buffers executed. */
+    uint64_t command_bytes;     /*! Size of the command buffers executed. */
+    uint32_t errors;            /*! Number of commands that have not been executed. */
+} vg_lite_soft_profile_t;
+
+/*!
+@brief Notified after each drawing call with its primitive, its number of pixels and its execution time.
+*/
+typedef void (* vg_lite_soft_trace_t)(vg_lite_soft_primitive_t primitive, uint32_t pixels, uint64_t time_ns);
+
+/*!
+@brief Initialize the memory setting.
+
+The register memory base is ignored. The contiguous memory is allocated in the host heap
+when contiguous_mem_base is NULL.
+*/
+void vg_lite_init_mem(uint32_t register_mem_base,
+                      uint32_t gpu_mem_base,
+                      volatile void * contiguous_mem_base,
+                      uint32_t contiguous_mem_size);
+
+/*!
+@brief Get the profile of the command buffers executed since the start or the last reset.
+*/
+void vg_lite_soft_get_profile(vg_lite_soft_profile_t * profile);
+
+/*!
+@brief Reset the profile.
+*/
+void vg_lite_soft_reset_profile(void);
+
+/*!
+@brief Set the function notified after each drawing call (NULL to disable it).
+*/
+void vg_lite_soft_set_trace(vg_lite_soft_trace_t trace);
+
+/*!
+@brief Defer the execution of the command buffers (disabled by default).
+
+When enabled, a command buffer kicked off by the kernel is executed by vg_lite_soft_run(): the
+caller sets the rate of the GPU. When the driver waits for a GPU interrupt, the pending command
+buffer is executed first (the CPU stalls until the GPU is done).
+*/
+void vg_lite_soft_set_deferred(int deferred);
+
+/*!
+@brief Execute the command buffers kicked off in the deferred mode, in their submission order.
+
+@param count The maximal number of command buffers to execute.
+@result Returns the number of command buffers executed.
+*/
+uint32_t vg_lite_soft_run(uint32_t count);
+
+/*!
+@brief Get a monotonic time in nanoseconds used by the profiler.
+
+The default implementation uses the POSIX monotonic clock. It is defined as a weak function
+and may be overridden (e.g. to count the CPU cycles).
+*/
+uint64_t vg_lite_soft_clock_ns(void);
+
+#endif
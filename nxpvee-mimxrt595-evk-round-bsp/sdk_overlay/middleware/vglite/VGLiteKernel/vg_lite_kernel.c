@@ -22,6 +22,11 @@
 *    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
 *    DEALINGS IN THE SOFTWARE.
 *
+*    Copyright 2022 MicroEJ Corp. This file has been modified by MicroEJ Corp.
+*    1. Queue the command buffers submitted while the GPU is busy and track
+*       their execution with fences
+*    2. Allow replacing the tessellation buffer after the initialization
+*
 *****************************************************************************/
 
 #include "vg_lite_platform.h"
@@ -41,6 +46,29 @@ static vg_lite_kernel_initialize_t ts_initialize = {0};
 static uint8_t ts_init = 0;
 #endif /* not defined(VG_DRIVER_SINGLE_THREAD) */
 
+#if defined(VG_DRIVER_SINGLE_THREAD)
+/* Command buffers submitted while the GPU is busy, in submission order (added by MicroEJ).
+ * The END interrupt of the running command buffer starts the next one. */
+typedef struct vg_lite_kernel_queue
+{
+    uint32_t address[CMDBUF_COUNT];
+    uint32_t size[CMDBUF_COUNT];
+    uint32_t fence[CMDBUF_COUNT];
+    uint32_t head;
+    uint32_t count;
+
+    /* Fence of the command buffer being executed, 0 when the GPU is idle. */
+    uint32_t running;
+
+    volatile uint32_t submitted;
+    volatile uint32_t completed;
+    uint32_t max_depth;
+}
+vg_lite_kernel_queue_t;
+
+static vg_lite_kernel_queue_t s_queue;
+#endif /* VG_DRIVER_SINGLE_THREAD */
+
 static vg_lite_error_t do_terminate(vg_lite_kernel_terminate_t * data);
 
 static void soft_reset(void);
@@ -122,6 +150,65 @@ static vg_lite_error_t init_3rd(vg_lite_kernel_initialize_t * data)
 }
 
 #if defined(VG_DRIVER_SINGLE_THREAD)
+/* Allocate the tessellation buffer of the requested size (added by MicroEJ). */
+static vg_lite_error_t allocate_tessellation(vg_lite_kernel_context_t * context, vg_lite_kernel_initialize_t * data)
+{
+    vg_lite_error_t error;
+    int width = data->tessellation_width;
+    int height = 0;
+    uint32_t chip_id;
+    unsigned long stride, buffer_size, l1_size, l2_size;
+
+    height = VG_LITE_ALIGN(data->tessellation_height, 16);
+
+    chip_id = vg_lite_hal_peek(0x20);
+    if(chip_id == GPU_CHIP_ID_GC355)
+        width = VG_LITE_ALIGN(width, 128);
+    /* Check if we can used tiled tessellation (128x16). */
+    if (((width & 127) == 0) && ((height & 15) == 0)) {
+        data->capabilities.cap.tiled = 0x3;
+    } else {
+        data->capabilities.cap.tiled = 0x2;
+    }
+
+    /* Compute tessellation buffer size. */
+    stride = VG_LITE_ALIGN(width * 8, 64);
+    buffer_size = VG_LITE_ALIGN(stride * height, 64);
+    /* Each bit in the L1 cache represents 64 bytes of tessellation data. */
+    l1_size = VG_LITE_ALIGN(VG_LITE_ALIGN(buffer_size / 64, 64) / 8, 64);
+    /* Each bit in the L2 cache represents 32 bytes of L1 data. */
+    l2_size = data->capabilities.cap.l2_cache ? VG_LITE_ALIGN(VG_LITE_ALIGN(l1_size / 32, 64) / 8, 64) : 0;
+
+    /* Allocate the memory. */
+    error = vg_lite_hal_allocate_contiguous(buffer_size + l1_size + l2_size,
+                                            &context->tessellation_buffer_logical,
+                                            &context->tessellation_buffer_physical,
+                                            &context->tessellation_buffer);
+    if (error != VG_LITE_SUCCESS) {
+        context->tessellation_buffer = NULL;
+        return error;
+    }
+
+    /* Return the tessellation buffer pointers and GPU addresses. */
+    data->tessellation_buffer_gpu[0] = context->tessellation_buffer_physical;
+    data->tessellation_buffer_gpu[1] = context->tessellation_buffer_physical + buffer_size;
+    data->tessellation_buffer_gpu[2] = (l2_size ? data->tessellation_buffer_gpu[1] + l1_size
+                                        : data->tessellation_buffer_gpu[1]);
+    data->tessellation_buffer_logic[0] = (uint8_t *)context->tessellation_buffer_logical;
+    data->tessellation_buffer_logic[1] = data->tessellation_buffer_logic[0] + buffer_size;
+    data->tessellation_buffer_logic[2] = (l2_size ? data->tessellation_buffer_logic[1] + l1_size
+                                          : data->tessellation_buffer_logic[1]);
+    data->tessellation_buffer_size[0] = buffer_size;
+    data->tessellation_buffer_size[1] = l1_size;
+    data->tessellation_buffer_size[2] = l2_size;
+
+    data->tessellation_stride = stride;
+    data->tessellation_width_height = width | (height << 16);
+    data->tessellation_shift = 0;
+
+    return error;
+}
+
 static vg_lite_error_t init_vglite(vg_lite_kernel_initialize_t * data)
 {
     vg_lite_error_t error = VG_LITE_SUCCESS;
@@ -129,7 +216,6 @@ static vg_lite_error_t init_vglite(vg_lite_kernel_initialize_t * data)
     vg_lite_kernel_context_t * context;
     uint32_t id;
     int      i;
-    uint32_t chip_id = 0;
 
 #if defined(__linux__) && !EMULATOR
     vg_lite_kernel_context_t __user * context_usr;
@@ -158,6 +244,10 @@ static vg_lite_error_t init_vglite(vg_lite_kernel_initialize_t * data)
     }
 #endif
 
+    if ((data->command_buffer_count == 0) || (data->command_buffer_count > CMDBUF_COUNT)) {
+        return VG_LITE_INVALID_ARGUMENT;
+    }
+
     /* Zero out all pointers. */
     for (i = 0; i < CMDBUF_COUNT; i++){
         context->command_buffer[i]          = NULL;
@@ -170,6 +260,9 @@ static vg_lite_error_t init_vglite(vg_lite_kernel_initialize_t * data)
 
     /* Increment reference counter. */
     if (s_reference++ == 0) {
+        /* Nothing is in flight: restart the fences. */
+        s_queue = (vg_lite_kernel_queue_t){0};
+
         /* Initialize the SOC. */
         vg_lite_hal_initialize();
 
@@ -187,7 +280,7 @@ static vg_lite_error_t init_vglite(vg_lite_kernel_initialize_t * data)
     /* Allocate the command buffer. */
     if (data->command_buffer_size) {
         int32_t i;
-        for (i = 0; i < 2; i ++)
+        for (i = 0; i < (int32_t)data->command_buffer_count; i ++)
         {
             /* Allocate the memory. */
             error = vg_lite_hal_allocate_contiguous(data->command_buffer_size,
@@ -212,35 +305,7 @@ static vg_lite_error_t init_vglite(vg_lite_kernel_initialize_t * data)
     /* Allocate the tessellation buffer. */
     if ((data->tessellation_width > 0) && (data->tessellation_height > 0)) 
     {
-        int width = data->tessellation_width;
-        int height = 0;
-        unsigned long stride, buffer_size, l1_size, l2_size;
-
-        height = VG_LITE_ALIGN(data->tessellation_height, 16);
-
-        chip_id = vg_lite_hal_peek(0x20);
-        if(chip_id == GPU_CHIP_ID_GC355)
-            width = VG_LITE_ALIGN(width, 128);
-        /* Check if we can used tiled tessellation (128x16). */
-        if (((width & 127) == 0) && ((height & 15) == 0)) {
-            data->capabilities.cap.tiled = 0x3;
-        } else {
-            data->capabilities.cap.tiled = 0x2;
-        }
-
-        /* Compute tessellation buffer size. */
-        stride = VG_LITE_ALIGN(width * 8, 64);
-        buffer_size = VG_LITE_ALIGN(stride * height, 64);
-        /* Each bit in the L1 cache represents 64 bytes of tessellation data. */
-        l1_size = VG_LITE_ALIGN(VG_LITE_ALIGN(buffer_size / 64, 64) / 8, 64);
-        /* Each bit in the L2 cache represents 32 bytes of L1 data. */
-        l2_size = data->capabilities.cap.l2_cache ? VG_LITE_ALIGN(VG_LITE_ALIGN(l1_size / 32, 64) / 8, 64) : 0;
-
-        /* Allocate the memory. */
-        error = vg_lite_hal_allocate_contiguous(buffer_size + l1_size + l2_size,
-                                                                       &context->tessellation_buffer_logical,
-                                                                       &context->tessellation_buffer_physical,
-                                                                       &context->tessellation_buffer);
+        error = allocate_tessellation(context, data);
         if (error != VG_LITE_SUCCESS) {
             /* Free any allocated memory. */
             vg_lite_kernel_terminate_t terminate = { context };
@@ -249,23 +314,6 @@ static vg_lite_error_t init_vglite(vg_lite_kernel_initialize_t * data)
             /* Out of memory. */
             return error;
         }
-
-        /* Return the tessellation buffer pointers and GPU addresses. */
-        data->tessellation_buffer_gpu[0] = context->tessellation_buffer_physical;
-        data->tessellation_buffer_gpu[1] = context->tessellation_buffer_physical + buffer_size;
-        data->tessellation_buffer_gpu[2] = (l2_size ? data->tessellation_buffer_gpu[1] + l1_size
-                                            : data->tessellation_buffer_gpu[1]);
-        data->tessellation_buffer_logic[0] = (uint8_t *)context->tessellation_buffer_logical;
-        data->tessellation_buffer_logic[1] = data->tessellation_buffer_logic[0] + buffer_size;
-        data->tessellation_buffer_logic[2] = (l2_size ? data->tessellation_buffer_logic[1] + l1_size
-                                              : data->tessellation_buffer_logic[1]);
-        data->tessellation_buffer_size[0] = buffer_size;
-        data->tessellation_buffer_size[1] = l1_size;
-        data->tessellation_buffer_size[2] = l2_size;
-
-        data->tessellation_stride = stride;
-        data->tessellation_width_height = width | (height << 16);
-        data->tessellation_shift = 0;
     }
 
     /* Enable all interrupts. */
@@ -559,6 +607,7 @@ static vg_lite_error_t do_initialize(vg_lite_kernel_initialize_t * data)
 static vg_lite_error_t terminate_vglite(vg_lite_kernel_terminate_t * data)
 {
     vg_lite_kernel_context_t *context = NULL;
+    int32_t i;
 #if defined(__linux__) && !EMULATOR
     vg_lite_kernel_context_t mycontext = {0};
     if (copy_from_user(&mycontext, data->context, sizeof(vg_lite_kernel_context_t)) != 0) {
@@ -570,16 +619,12 @@ static vg_lite_error_t terminate_vglite(vg_lite_kernel_terminate_t * data)
 #endif
 
     /* Free any allocated memory for the context. */
-    if (context->command_buffer[0]) {
-        /* Free the command buffer. */
-        vg_lite_hal_free_contiguous(context->command_buffer[0]);
-        context->command_buffer[0] = NULL;
-    }
-
-    if (context->command_buffer[1]) {
-        /* Free the command buffer. */
-        vg_lite_hal_free_contiguous(context->command_buffer[1]);
-        context->command_buffer[1] = NULL;
+    for (i = 0; i < CMDBUF_COUNT; i++) {
+        if (context->command_buffer[i]) {
+            /* Free the command buffer. */
+            vg_lite_hal_free_contiguous(context->command_buffer[i]);
+            context->command_buffer[i] = NULL;
+        }
     }
 
     if (context->tessellation_buffer) {
@@ -724,9 +769,23 @@ static vg_lite_error_t do_free(vg_lite_kernel_free_t * data)
 }
 
 #if defined(VG_DRIVER_SINGLE_THREAD)
+/* Write the registers to kick off the command execution (CMDBUF_SIZE). */
+static void kick_off(uint32_t address, uint32_t size)
+{
+    vg_lite_hal_poke(VG_LITE_HW_CMDBUF_ADDRESS, address);
+    vg_lite_hal_poke(VG_LITE_HW_CMDBUF_SIZE, (size + 7) / 8);
+}
+
+/* Fences are increasing sequence numbers: compare them modulo 2^32. */
+static int is_fence_signaled(uint32_t fence)
+{
+    return (int32_t)(s_queue.completed - fence) >= 0;
+}
+
 static vg_lite_error_t do_submit(vg_lite_kernel_submit_t * data)
 {
     uint32_t offset;
+    uint32_t fence;
     vg_lite_kernel_context_t *context = NULL;
     uint32_t physical = data->context->command_buffer_physical[data->command_id];
 
@@ -760,17 +819,51 @@ static vg_lite_error_t do_submit(vg_lite_kernel_submit_t * data)
     }
 #endif
 
-    /* Write the registers to kick off the command execution (CMDBUF_SIZE). */
-    vg_lite_hal_poke(VG_LITE_HW_CMDBUF_ADDRESS, physical + offset);
-    vg_lite_hal_poke(VG_LITE_HW_CMDBUF_SIZE, (data->command_size + 7) / 8);
+    vg_lite_hal_enter_critical();
+
+    fence = ++s_queue.submitted;
+    if (fence == 0) {
+        /* 0 means no fence. */
+        fence = ++s_queue.submitted;
+    }
+    if (s_queue.running == 0) {
+        /* GPU is idle: kick off the command execution right now. */
+        s_queue.running = fence;
+        kick_off(physical + offset, data->command_size);
+    }
+    else {
+        /* GPU is busy: the END interrupt of the running command buffer will kick off this one. */
+        uint32_t index = (s_queue.head + s_queue.count) % CMDBUF_COUNT;
+        s_queue.address[index] = physical + offset;
+        s_queue.size[index] = data->command_size;
+        s_queue.fence[index] = fence;
+        s_queue.count++;
+    }
+
+    if (s_queue.count + 1 > s_queue.max_depth) {
+        s_queue.max_depth = s_queue.count + 1;
+    }
+
+    vg_lite_hal_exit_critical();
+
+    data->fence = fence;
 
     return VG_LITE_SUCCESS;
 }
 
 static vg_lite_error_t do_wait(vg_lite_kernel_wait_t * data)
 {
-    /* Wait for interrupt. */
-    if (!vg_lite_hal_wait_interrupt(data->timeout_ms, data->event_mask, &data->event_got)) {
+    int32_t received = 1;
+
+    /* Wait for interrupt, or for interrupts until the fence is signaled. */
+    do {
+        if ((data->fence != 0) && is_fence_signaled(data->fence)) {
+            break;
+        }
+        received = vg_lite_hal_wait_interrupt(data->timeout_ms, data->event_mask, &data->event_got);
+    } while (received && (data->fence != 0));
+
+    if (!received) {
         /* Timeout. */
 #if defined(PRINT_DEBUG_REGISTER)
         unsigned int debug;
@@ -900,6 +993,57 @@ static vg_lite_error_t do_query_mem(vg_lite_kernel_mem_t * data)
     return error;
 }
 
+#if defined(VG_DRIVER_SINGLE_THREAD)
+/* Replace the tessellation buffer; the GPU must be idle (added by MicroEJ). */
+static vg_lite_error_t do_tessellation(vg_lite_kernel_initialize_t * data)
+{
+    vg_lite_kernel_context_t * context = data->context;
+
+    if ((data->tessellation_width <= 0) || (data->tessellation_height <= 0))
+        return VG_LITE_INVALID_ARGUMENT;
+
+    if (context->tessellation_buffer) {
+        /* Free the current tessellation buffer first: both may not fit in the memory. */
+        vg_lite_hal_free_contiguous(context->tessellation_buffer);
+        context->tessellation_buffer = NULL;
+        context->tessellation_buffer_logical = NULL;
+        context->tessellation_buffer_physical = 0;
+    }
+
+    return allocate_tessellation(context, data);
+}
+
+/* No critical section: may be called from the GPU interrupt callback. */
+static vg_lite_error_t do_query_queue(vg_lite_kernel_queue_info_t * data)
+{
+    data->submitted = s_queue.submitted;
+    data->completed = s_queue.completed;
+    data->depth = s_queue.count + (s_queue.running != 0 ? 1 : 0);
+    data->max_depth = s_queue.max_depth;
+
+    return VG_LITE_SUCCESS;
+}
+
+void vg_lite_kernel_interrupt(uint32_t flags)
+{
+    if ((flags & (1U << EVENT_END)) && (s_queue.running != 0)) {
+        /* The running command buffer is done. */
+        s_queue.completed = s_queue.running;
+
+        if (s_queue.count > 0) {
+            uint32_t index = s_queue.head;
+            s_queue.head = (s_queue.head + 1) % CMDBUF_COUNT;
+            s_queue.count--;
+            s_queue.running = s_queue.fence[index];
+            kick_off(s_queue.address[index], s_queue.size[index]);
+        }
+        else {
+            s_queue.running = 0;
+        }
+    }
+}
+#endif /* VG_DRIVER_SINGLE_THREAD */
+
 #if !defined(VG_DRIVER_SINGLE_THREAD)
 static vg_lite_error_t do_query_context_switch(vg_lite_kernel_context_switch_t * data)
 {
@@ -989,6 +1133,14 @@ vg_lite_error_t vg_lite_kernel(vg_lite_kernel_command_t command, void * data)
         case VG_LITE_QUERY_MEM:
             return do_query_mem(data);
 
+#if defined(VG_DRIVER_SINGLE_THREAD)
+        case VG_LITE_QUERY_QUEUE:
+            return do_query_queue(data);
+
+        case VG_LITE_TESSELLATION:
+            return do_tessellation(data);
+#endif /* VG_DRIVER_SINGLE_THREAD */
+
 #if !defined(VG_DRIVER_SINGLE_THREAD)
         case VG_LITE_LOCK:
             /* Mutex lock */
@@ -22,6 +22,10 @@
 *    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
 *    DEALINGS IN THE SOFTWARE.
 *
+*    Copyright 2022 MicroEJ Corp. This file has been modified by MicroEJ Corp.
+*    1. Add a queue of submitted command buffers tracked with fences
+*    2. Add the command VG_LITE_TESSELLATION
+*
 *****************************************************************************/
 
 #ifndef _vg_lite_kernel_h_
@@ -43,7 +47,10 @@
 #if !defined(VG_DRIVER_SINGLE_THREAD)
 #define VG_LITE_MAX_WAIT_TIME  0x130000
 #endif /* not defined(VG_DRIVER_SINGLE_THREAD) */
+#ifndef CMDBUF_COUNT
+/* Maximum number of command buffers (ring depth). */
 #define CMDBUF_COUNT        2
+#endif
 
 #define VG_LITE_ALIGN(number, alignment)    \
         (((number) + ((alignment) - 1)) & ~((alignment) - 1))
@@ -163,6 +170,14 @@ typedef enum vg_lite_kernel_command
     /* Query mem. */
     VG_LITE_QUERY_MEM,
 
+#if defined(VG_DRIVER_SINGLE_THREAD)
+    /* Query the command buffer queue (added by MicroEJ). */
+    VG_LITE_QUERY_QUEUE,
+
+    /* Replace the tessellation buffer, see vg_lite_kernel_initialize_t (added by MicroEJ). */
+    VG_LITE_TESSELLATION,
+#endif /* VG_DRIVER_SINGLE_THREAD */
+
 #if !defined(VG_DRIVER_SINGLE_THREAD)
     /* Mutex lock. */
     VG_LITE_LOCK,
@@ -223,7 +238,10 @@ typedef struct vg_lite_kernel_initialize
     /* Command buffer size. */
     uint32_t command_buffer_size;
 
-#if !defined(VG_DRIVER_SINGLE_THREAD)
+#if defined(VG_DRIVER_SINGLE_THREAD)
+    /* Number of command buffers to allocate (at most CMDBUF_COUNT). */
+    uint32_t command_buffer_count;
+#else
     /* Context buffer size. */
     uint32_t context_buffer_size;
 #endif /* not defined(VG_DRIVER_SINGLE_THREAD) */
@@ -324,6 +342,13 @@ typedef struct vg_lite_kernel_submit
 
     /* Command Buffer ID. */
     uint32_t command_id;
+
+#if defined(VG_DRIVER_SINGLE_THREAD)
+    /* OUTPUT */
+
+    /* Fence signaled when the GPU has executed the command buffer. */
+    uint32_t fence;
+#endif /* VG_DRIVER_SINGLE_THREAD */
 }
 vg_lite_kernel_submit_t;
 
@@ -341,6 +366,9 @@ typedef struct vg_lite_kernel_wait
 
     /* The event(s) got after waiting. */
     uint32_t event_got;
+
+    /* Fence to wait for, 0 to wait for the next interrupt. */
+    uint32_t fence;
 #else
     /* Command Buffer ID. */
     uint32_t command_id;
@@ -429,6 +457,24 @@ typedef struct vg_lite_kernel_mem
 }
 vg_lite_kernel_mem_t;
 
+#if defined(VG_DRIVER_SINGLE_THREAD)
+typedef struct vg_lite_kernel_queue_info
+{
+    /* Fence of the last submitted command buffer. */
+    uint32_t submitted;
+
+    /* Fence of the last command buffer executed by the GPU. */
+    uint32_t completed;
+
+    /* Number of command buffers running or waiting for the GPU. */
+    uint32_t depth;
+
+    /* Highest depth reached since the initialization. */
+    uint32_t max_depth;
+}
+vg_lite_kernel_queue_info_t;
+#endif /* VG_DRIVER_SINGLE_THREAD */
+
 #if !defined(VG_DRIVER_SINGLE_THREAD)
 typedef struct vg_lite_kernel_context_switch
 {
@@ -440,6 +486,12 @@ vg_lite_kernel_context_switch_t;
 
 vg_lite_error_t vg_lite_kernel(vg_lite_kernel_command_t command, void * data);
 
+#if defined(VG_DRIVER_SINGLE_THREAD)
+/* Called by the HAL interrupt handler with the interrupt status (added by MicroEJ):
+ * retires the running command buffer and starts the next queued one. */
+void vg_lite_kernel_interrupt(uint32_t flags);
+#endif /* VG_DRIVER_SINGLE_THREAD */
+
 #ifdef  __cplusplus
 }
 #endif
@@ -683,6 +683,9 @@ int free_rle_font_memory(struct mf_font_s** font)
 {
     struct mf_rlefont_s* mfont = (struct mf_rlefont_s*)(*font);
 
+    /* Cached glyph spans are keyed by font address */
+    vg_lite_text_purge_glyph_cache();
+
     RCD_FREE(mfont->font.full_name);
     RCD_FREE(mfont->font.short_name);
     RCD_FREE(mfont->dictionary_data);
@@ -88,33 +88,248 @@ int init_256pallet_color_table(unsigned int bg_color, unsigned int fg_color)
     r = ( ((bg_r * mult2)>>10) +((fg_r * mult)>>10) );
     g = ( ((bg_g * mult2)>>10) +((fg_g * mult)>>10) );
     b = ( ((bg_b * mult2)>>10) +((fg_b * mult)>>10) );
-    g_index_table[i] = ((a) + (r<<8) + (g<<16)+(b<<24));
+    g_index_table[i] = ((unsigned int)a + ((unsigned int)r<<8) + ((unsigned int)g<<16) + ((unsigned int)b<<24));
   }
   return 0;
 }
 
-/* Callback to write to a memory buffer. */
-static void pixel_callback(int16_t x, int16_t y, uint8_t count, uint8_t alpha,
-                           void *state)
+/* Bytes used by a row of `width` pixels of the raster text buffer. */
+static int raster_row_bytes(int width)
+{
+#if (VG_LITE_TEXT_RASTER_FORMAT == VG_LITE_TEXT_RASTER_A4)
+    return (width + 1) / 2;
+#elif (VG_LITE_TEXT_RASTER_FORMAT == VG_LITE_TEXT_RASTER_A8)
+    return width;
+#else
+    return width * 4;
+#endif
+}
+
+/* Writes one horizontal span of `count` pixels of the same alpha.
+ * The span is clipped to the buffer rather than rejected, and is filled
+ * with word (or byte) stores instead of one indexed store per pixel. */
+static void span_callback(int16_t x, int16_t y, uint8_t count, uint8_t alpha,
+                          void *state)
 {
     text_context_t *s = (text_context_t*)state;
-    uint32_t pos;
-    uint32_t value;
-    uint32_t *raw_pixel_buffer = (uint32_t *)s->buffer.memory;
-    int stride = s->buffer.stride;
+    int32_t x0 = x;
+    int32_t x1 = x0 + count;
+    uint8_t *row;
 
     if (y < 0 || y >= s->height) return;
-    if (x < 0 || x + count >= s->width) return;
+    if (x0 < 0) x0 = 0;
+    if (x1 > s->width) x1 = s->width;
+    if (x0 >= x1) return;
+
+    /* During rendering, stride is expressed in pixels. */
+    row = (uint8_t *)s->buffer.memory + raster_row_bytes(s->buffer.stride) * y;
 
-    while (count--)
+#if (VG_LITE_TEXT_RASTER_FORMAT == VG_LITE_TEXT_RASTER_A4)
     {
-        pos = (uint32_t)stride * y + x;
-        value = g_index_table[alpha];
-        
-        raw_pixel_buffer[pos] = value;
+        uint8_t a4 = alpha >> 4;
+        /* Pixel 2n is the low nibble of byte n. */
+        if (x0 & 1) {
+            row[x0 >> 1] = (row[x0 >> 1] & 0x0F) | (uint8_t)(a4 << 4);
+            x0++;
+        }
+        if (x0 + 1 < x1) {
+            int32_t pairs = (x1 - x0) >> 1;
+            memset(row + (x0 >> 1), a4 | (a4 << 4), pairs);
+            x0 += pairs << 1;
+        }
+        if (x0 < x1) {
+            row[x0 >> 1] = (row[x0 >> 1] & 0xF0) | a4;
+        }
+    }
+#elif (VG_LITE_TEXT_RASTER_FORMAT == VG_LITE_TEXT_RASTER_A8)
+    memset(row + x0, alpha, x1 - x0);
+#else
+    {
+        uint32_t *p = (uint32_t *)row + x0;
+        uint32_t *end = (uint32_t *)row + x1;
+        uint32_t value = g_index_table[alpha];
+
+        while (end - p >= 4) {
+            p[0] = value;
+            p[1] = value;
+            p[2] = value;
+            p[3] = value;
+            p += 4;
+        }
+        while (p < end) {
+            *p++ = value;
+        }
+    }
+#endif
+}
+
+#if (VG_LITE_TEXT_GLYPH_CACHE_SIZE > 0)
+
+/* One decoded span of a glyph, relative to the glyph origin. */
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+    uint8_t count;
+    uint8_t alpha;
+} glyph_span_t;
+
+/* Decoded spans of one (font, character). */
+typedef struct {
+    const struct mf_font_s *font;
+    mf_char character;
+    uint8_t width;
+    uint16_t span_count;
+    uint32_t last_use;
+    glyph_span_t spans[VG_LITE_TEXT_GLYPH_CACHE_SPANS];
+} glyph_cache_entry_t;
+
+/* A glyph that cannot be cached (too many spans, or a span outside the
+ * 255x255 pixels a glyph_span_t can address). */
+typedef struct {
+    const struct mf_font_s *font;
+    mf_char character;
+} glyph_uncached_t;
+
+/* State of the decoding of a glyph on a cache miss: the spans are drawn and
+ * recorded at the same time, so a glyph is decoded once even when it cannot
+ * be cached. */
+typedef struct {
+    text_context_t *text;
+    int16_t x;
+    int16_t y;
+    bool overflow;
+} glyph_record_t;
+
+static glyph_cache_entry_t g_glyph_cache[VG_LITE_TEXT_GLYPH_CACHE_SIZE];
+static glyph_uncached_t g_glyph_uncached[VG_LITE_TEXT_GLYPH_CACHE_UNCACHED];
+static uint32_t g_glyph_uncached_next;
+static uint32_t g_glyph_cache_clock;
+static vg_lite_text_glyph_cache_stats_t g_glyph_cache_stats;
+
+/* The entry the spans of a missed glyph are recorded in: the least recently
+ * used entry is only replaced once the glyph is known to fit. */
+static glyph_cache_entry_t g_glyph_cache_fill;
+
+/* Callback to draw the spans of a glyph and to record them relative to the
+ * glyph origin. */
+static void record_span_callback(int16_t x, int16_t y, uint8_t count, uint8_t alpha,
+                                 void *state)
+{
+    glyph_record_t *r = (glyph_record_t*)state;
+    glyph_cache_entry_t *e = &g_glyph_cache_fill;
+    int32_t dx = x - r->x;
+    int32_t dy = y - r->y;
+
+    span_callback(x, y, count, alpha, r->text);
+
+    if (r->overflow) {
+        return;
+    }
+    if (e->span_count >= VG_LITE_TEXT_GLYPH_CACHE_SPANS
+        || dx < 0 || dx > UINT8_MAX || dy < 0 || dy > UINT8_MAX) {
+        r->overflow = true;
+        return;
+    }
+    e->spans[e->span_count].x = (uint8_t)dx;
+    e->spans[e->span_count].y = (uint8_t)dy;
+    e->spans[e->span_count].count = count;
+    e->spans[e->span_count].alpha = alpha;
+    e->span_count++;
+}
 
-        x++;
+/* Tells whether a glyph is known not to fit in a cache entry. */
+static bool glyph_cache_is_uncached(const struct mf_font_s *font, mf_char character)
+{
+    int i;
+
+    for (i = 0; i < VG_LITE_TEXT_GLYPH_CACHE_UNCACHED; i++) {
+        if (g_glyph_uncached[i].font == font && g_glyph_uncached[i].character == character) {
+            return true;
+        }
     }
+    return false;
+}
+
+/* Draws a character with its cached spans, decoding them on a miss.
+ * Returns the character width. */
+static uint8_t glyph_cache_draw(text_context_t *s, int16_t x, int16_t y,
+                                mf_char character)
+{
+    const struct mf_font_s *font = s->rcd_font;
+    glyph_cache_entry_t *victim = &g_glyph_cache[0];
+    glyph_record_t record;
+    int i;
+
+    g_glyph_cache_clock++;
+    for (i = 0; i < VG_LITE_TEXT_GLYPH_CACHE_SIZE; i++) {
+        glyph_cache_entry_t *e = &g_glyph_cache[i];
+        if (e->font == font && e->character == character) {
+            const glyph_span_t *span = e->spans;
+            const glyph_span_t *end = e->spans + e->span_count;
+
+            g_glyph_cache_stats.hits++;
+            e->last_use = g_glyph_cache_clock;
+            for (; span < end; span++) {
+                span_callback(x + span->x, y + span->y, span->count, span->alpha, s);
+            }
+            return e->width;
+        }
+        if (e->font == NULL || (victim->font != NULL && e->last_use < victim->last_use)) {
+            /* Least recently used entry (empty entries first) */
+            victim = e;
+        }
+    }
+
+    if (glyph_cache_is_uncached(font, character)) {
+        g_glyph_cache_stats.overflows++;
+        return mf_render_character(font, x, y, character, span_callback, s);
+    }
+
+    record.text = s;
+    record.x = x;
+    record.y = y;
+    record.overflow = false;
+    g_glyph_cache_fill.span_count = 0;
+    g_glyph_cache_fill.width = mf_render_character(font, x, y, character, record_span_callback, &record);
+
+    if (record.overflow) {
+        /* Remembered so that the next draws neither record it nor evict an entry */
+        g_glyph_cache_stats.overflows++;
+        g_glyph_uncached[g_glyph_uncached_next].font = font;
+        g_glyph_uncached[g_glyph_uncached_next].character = character;
+        g_glyph_uncached_next = (g_glyph_uncached_next + 1) % VG_LITE_TEXT_GLYPH_CACHE_UNCACHED;
+    } else {
+        g_glyph_cache_stats.misses++;
+        memcpy(victim->spans, g_glyph_cache_fill.spans,
+               g_glyph_cache_fill.span_count * sizeof(glyph_span_t));
+        victim->span_count = g_glyph_cache_fill.span_count;
+        victim->width = g_glyph_cache_fill.width;
+        victim->font = font;
+        victim->character = character;
+        victim->last_use = g_glyph_cache_clock;
+    }
+    return g_glyph_cache_fill.width;
+}
+
+#endif /* VG_LITE_TEXT_GLYPH_CACHE_SIZE > 0 */
+
+void vg_lite_text_purge_glyph_cache(void)
+{
+#if (VG_LITE_TEXT_GLYPH_CACHE_SIZE > 0)
+    memset(g_glyph_cache, 0, sizeof(g_glyph_cache));
+    memset(g_glyph_uncached, 0, sizeof(g_glyph_uncached));
+    g_glyph_uncached_next = 0;
+    g_glyph_cache_clock = 0;
+#endif
+}
+
+void vg_lite_text_get_glyph_cache_stats(vg_lite_text_glyph_cache_stats_t *stats)
+{
+#if (VG_LITE_TEXT_GLYPH_CACHE_SIZE > 0)
+    *stats = g_glyph_cache_stats;
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
 }
 
 /* Callback to render characters. */
@@ -122,7 +337,11 @@ static uint8_t character_callback(int16_t x, int16_t y, mf_char character,
                                   void *state)
 {
     text_context_t *s = (text_context_t*)state;
-    return mf_render_character(s->rcd_font, x, y, character, pixel_callback, state);
+#if (VG_LITE_TEXT_GLYPH_CACHE_SIZE > 0)
+    return glyph_cache_draw(s, x, y, character);
+#else
+    return mf_render_character(s->rcd_font, x, y, character, span_callback, state);
+#endif
 }
 
 /* Callback to render lines. */
@@ -166,7 +385,13 @@ vg_lite_error_t alloc_font_buffer(vg_lite_buffer_t *buffer, int width , int heig
     /* Allocate memory from VGLITE space */
     buffer->width  = width;
     buffer->height = height;
+#if (VG_LITE_TEXT_RASTER_FORMAT == VG_LITE_TEXT_RASTER_A4)
+    buffer->format = VG_LITE_A4;
+#elif (VG_LITE_TEXT_RASTER_FORMAT == VG_LITE_TEXT_RASTER_A8)
+    buffer->format = VG_LITE_A8;
+#else
     buffer->format = VG_LITE_ARGB8888;
+#endif
     buffer->stride = 0;
     error = vg_lite_allocate(buffer);
     buffer->stride = width;
@@ -245,7 +470,9 @@ vg_lite_error_t vg_lite_draw_text(vg_lite_buffer_t *target,
 
     // Dynamic decision
     if ( attributes->is_vector_font == 0 ) {
+#if (VG_LITE_TEXT_RASTER_FORMAT == VG_LITE_TEXT_RASTER_ARGB8888)
         init_256pallet_color_table(attributes->bg_color, attributes->text_color);
+#endif
 
         /* Application specifies actual font by reading proper rcd file */
         ctx_text.rcd_font = _vg_lite_get_raster_font(font);
@@ -298,10 +525,7 @@ vg_lite_error_t vg_lite_draw_text(vg_lite_buffer_t *target,
 
         /* Initialize vg_lite buffer with transperant color */
         /* Due to alignment requirement of vg_lite, font buffer can be larger */
-        if ( ctx_text.buffer.format == VG_LITE_ARGB8888 )
-          text_img_size = ctx_text.buffer.width * ctx_text.buffer.height * 4;
-        else
-          text_img_size = ctx_text.buffer.width * ctx_text.buffer.height;
+        text_img_size = raster_row_bytes(ctx_text.buffer.width) * ctx_text.buffer.height;
         memset(ctx_text.buffer.memory, 0,
                text_img_size);
 
@@ -314,11 +538,17 @@ vg_lite_error_t vg_lite_draw_text(vg_lite_buffer_t *target,
         matrix_multiply(&m_text, matrix);
         vg_lite_translate(x, y, &m_text);
         vg_lite_scale(1.0, 1.0, &m_text);
-        if ( ctx_text.buffer.format == VG_LITE_ARGB8888 )
-          ctx_text.buffer.stride = ctx_text.width*4;
+        ctx_text.buffer.stride = raster_row_bytes(ctx_text.width);
 
+#if (VG_LITE_TEXT_RASTER_FORMAT == VG_LITE_TEXT_RASTER_ARGB8888)
         error = vg_lite_blit(target, &ctx_text.buffer, &m_text, blend,
                     0, VG_LITE_FILTER_POINT);
+#else
+        /* Alpha only buffer: the GPU multiplies it by the opaque text color */
+        ctx_text.buffer.image_mode = VG_LITE_MULTIPLY_IMAGE_MODE;
+        error = vg_lite_blit(target, &ctx_text.buffer, &m_text, blend,
+                    attributes->text_color | 0xFF000000, VG_LITE_FILTER_POINT);
+#endif
         if ( error != VG_LITE_SUCCESS) {
             printf("WARNING: vg_lite_blit failed(%d).\r\n",error);
         }
@@ -27,6 +27,10 @@
 *
 *    Copyright 2022 MicroEJ Corp. This file has been modified by MicroEJ Corp.
 *    1. Add "vg_lite_get_scissor()"
+*    2. Add the fences and the command buffer ring functions
+*    3. Add "vg_lite_get_command_stats()"
+*    4. Add the stroke cache functions
+*    5. Add "vg_lite_set_tessellation_size()" and "vg_lite_get_tessellation_stats()"
 *
 *****************************************************************************/
 
@@ -554,6 +558,50 @@ extern "C" {
         uint32_t  reserved;             /*! Reserved for future use. */
     } vg_lite_info_t;
 
+    /* Identifies a flushed command buffer; 0 means "no command buffer" (added by MicroEJ). */
+    typedef uint32_t vg_lite_fence_t;
+
+    /* This structure is used to query the command buffer queue counters (added by MicroEJ) */
+    typedef struct vg_lite_queue_stats {
+        uint32_t  submitted;            /*! Fence of the last submitted command buffer. */
+        uint32_t  completed;            /*! Fence of the last command buffer executed by the GPU. */
+        uint32_t  depth;                /*! Command buffers running or waiting for the GPU. */
+        uint32_t  max_depth;            /*! Highest depth reached. */
+        uint32_t  stalls;               /*! Times the CPU waited for a command buffer of the ring to be released. */
+    } vg_lite_queue_stats_t;
+
+    /* This structure is used to query the command buffer usage (added by MicroEJ) */
+    typedef struct vg_lite_command_stats {
+        uint32_t  size;                 /*! Size of each command buffer. */
+        uint32_t  bytes;                /*! Command bytes submitted. */
+        uint32_t  flushes;              /*! Command buffers submitted. */
+        uint32_t  forced_flushes;       /*! Command buffers submitted in the middle of a drawing because they were full. */
+        uint32_t  peak_usage;           /*! Largest command buffer submitted, in bytes. */
+    } vg_lite_command_stats_t;
+
+    /* This structure is used to query the tessellation window usage (added by MicroEJ) */
+    typedef struct vg_lite_tessellation_stats {
+        uint32_t  width;                /*! Width of the tessellation window. */
+        uint32_t  height;               /*! Height of the tessellation window. */
+        uint32_t  bytes;                /*! Contiguous memory used by the tessellation buffer. */
+        uint32_t  draws;                /*! Path drawings. */
+        uint32_t  passes;               /*! Tessellation passes of these drawings (one per window covering a drawing). */
+        uint32_t  split_draws;          /*! Drawings that needed more than one pass. */
+        uint32_t  max_passes;           /*! Largest number of passes of a drawing. */
+        uint32_t  max_width;            /*! Largest bounding box width of a drawing, clipped to the target and the scissor. */
+        uint32_t  max_height;           /*! Largest bounding box height of a drawing, clipped to the target and the scissor. */
+    } vg_lite_tessellation_stats_t;
+
+    /* This structure is used to query the stroke cache counters (added by MicroEJ) */
+    typedef struct vg_lite_stroke_cache_stats {
+        uint32_t  hits;                 /*! Strokes reused by vg_lite_update_stroke(). */
+        uint32_t  misses;               /*! Strokes generated by vg_lite_update_stroke(). */
+        uint32_t  evictions;            /*! Strokes removed from the cache to store newer ones. */
+        uint32_t  entries;              /*! Strokes in the cache. */
+        uint32_t  bytes;                /*! Memory used by the strokes in the cache and the copies of their path data. */
+        uint32_t  size;                 /*! Maximal memory used by the strokes in the cache. */
+    } vg_lite_stroke_cache_stats_t;
+
     /*!
      @abstract A 3x3 matrix.
 
@@ -1053,6 +1101,85 @@ extern "C" {
      */
     vg_lite_error_t vg_lite_flush(void);
 
+    /*!
+     @abstract This api submits the command buffer to GPU and returns the fence signaled when the GPU has executed it (added by MicroEJ).
+
+     @discussion
+     The command buffer is queued behind the ones still executed by the GPU: this api only waits when all the command buffers
+     of the ring are in flight. When there is nothing to submit, the fence of the last submitted command buffer is returned.
+
+     @param fence
+     Pointer to the fence to fill, may be NULL.
+
+     @result
+     Returns the status as defined by <code>vg_lite_error_t</code>.
+     */
+    vg_lite_error_t vg_lite_flush_async(vg_lite_fence_t * fence);
+
+    /*!
+     @abstract Wait until the GPU has executed the command buffer identified by the fence (added by MicroEJ).
+
+     @param fence
+     The fence returned by {@link vg_lite_flush_async}.
+
+     @param timeout_ms
+     The number of milliseconds to wait between two GPU interrupts, 0 to wait forever.
+
+     @result
+     Returns the status as defined by <code>vg_lite_error_t</code>.
+     */
+    vg_lite_error_t vg_lite_wait_fence(vg_lite_fence_t fence, uint32_t timeout_ms);
+
+    /*!
+     @abstract Check whether the GPU has executed the command buffer identified by the fence (added by MicroEJ).
+
+     @discussion
+     This api can be called from the GPU interrupt callback.
+
+     @result
+     Returns 1 when the fence is signaled, 0 otherwise.
+     */
+    int32_t vg_lite_fence_is_signaled(vg_lite_fence_t fence);
+
+    /*!
+     @abstract Get the command buffer queue counters (added by MicroEJ).
+
+     @result
+     Returns the status as defined by <code>vg_lite_error_t</code>.
+     */
+    vg_lite_error_t vg_lite_get_queue_stats(vg_lite_queue_stats_t * stats);
+
+    /*!
+     @abstract Get the command buffer usage since the last reset (added by MicroEJ).
+
+     @param stats
+     Pointer to the usage to fill.
+
+     @param reset
+     Non-zero to restart the counting (e.g. at each frame).
+
+     @result
+     Returns the status as defined by <code>vg_lite_error_t</code>.
+     */
+    vg_lite_error_t vg_lite_get_command_stats(vg_lite_command_stats_t * stats, int32_t reset);
+
+    /*!
+     @abstract Get the tessellation window usage since the last reset (added by MicroEJ).
+
+     @discussion
+     A path is tessellated once for each window of the tessellation buffer that covers its bounding box.
+
+     @param stats
+     Pointer to the usage to fill.
+
+     @param reset
+     Non-zero to restart the counting (e.g. at each frame).
+
+     @result
+     Returns the status as defined by <code>vg_lite_error_t</code>.
+     */
+    vg_lite_error_t vg_lite_get_tessellation_stats(vg_lite_tessellation_stats_t * stats, int32_t reset);
+
     /*!
      @abstract Draw a path to a target buffer.
 
@@ -1164,6 +1291,35 @@ extern "C" {
      */
     vg_lite_error_t vg_lite_update_stroke(vg_lite_path_t *path);
 
+    /*!
+     @abstract Get the stroke cache counters (added by MicroEJ).
+
+     @discussion
+     vg_lite_update_stroke() reuses the stroke of a path that has the same path data and the same
+     stroke parameters as a previous one (the matrix given to the drawing functions is not part of the stroke);
+     the cache keeps a copy of the path data and of the dash pattern of each stroke to compare them.
+     The cache is bounded by VG_LITE_STROKE_CACHE_ENTRIES strokes and VG_LITE_STROKE_CACHE_SIZE bytes; the
+     least recently used strokes that are not used by a path are evicted first.
+
+     @param stats
+     Pointer to the counters to fill.
+
+     @param reset
+     Non-zero to restart the counting of the hits, misses and evictions.
+
+     @result
+     Returns the status as defined by <code>vg_lite_error_t</code>.
+     */
+    vg_lite_error_t vg_lite_get_stroke_cache_stats(vg_lite_stroke_cache_stats_t * stats, int32_t reset);
+
+    /*!
+     @abstract Free the cached strokes that are not used by a path (added by MicroEJ).
+
+     @result
+     Returns the status as defined by <code>vg_lite_error_t</code>.
+     */
+    vg_lite_error_t vg_lite_purge_stroke_cache(void);
+
     /*!
      @abstract Set path type.
 
@@ -1932,12 +2088,43 @@ extern "C" {
 
      @discussion
      In the rt device, the memory was limited, need to set the command buffer
-     size by the chip.
+     size by the chip. After the initialization, the pending commands are executed and the command buffers are
+     reallocated; the previous size is kept when there is not enough memory (added by MicroEJ).
      @result
      Returns the status as defined by <code>vg_lite_error_t</code>.
      */
     vg_lite_error_t vg_lite_set_command_buffer_size(uint32_t size);
 
+    /*!
+     @abstract Set the size of the tessellation window after the initialization (added by MicroEJ).
+
+     @discussion
+     The pending commands are executed and the tessellation buffer is reallocated (the sizes are aligned on 16 pixels).
+     The previous size is kept when there is not enough memory. A drawing larger than the window is tessellated
+     in several passes.
+
+     @param width
+     Width of the tessellation window.
+
+     @param height
+     Height of the tessellation window.
+
+     @result
+     Returns the status as defined by <code>vg_lite_error_t</code>.
+     */
+    vg_lite_error_t vg_lite_set_tessellation_size(int32_t width, int32_t height);
+
+    /*!
+     @abstract Set the number of command buffers of the ring (added by MicroEJ).
+
+     @discussion
+     The CPU fills a command buffer while the GPU executes the ones flushed before. The count is between 1 and
+     <code>CMDBUF_COUNT</code>; each command buffer has the size set by {@link vg_lite_set_command_buffer_size}.
+     @result
+     Returns the status as defined by <code>vg_lite_error_t</code>.
+     */
+    vg_lite_error_t vg_lite_set_command_buffer_count(uint32_t count);
+
     /*!
      @abstract Set scissor used for render target's boundary.
 
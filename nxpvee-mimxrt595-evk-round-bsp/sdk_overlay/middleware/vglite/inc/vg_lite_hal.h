@@ -28,6 +28,7 @@
 *    Copyright 2020-2022 MicroEJ Corp. This file has been modified by MicroEJ Corp.
 *    1. Add callback mecanism to notify MicroEJ when a VGLite operation
 *       is complete
+*    2. Add the critical section functions
 *
 *****************************************************************************/
 
@@ -86,6 +87,19 @@ typedef void (* vg_lite_irq_callback) (void);
 void vg_lite_hal_register_irq_callback(vg_lite_irq_callback cb);
 #endif /* _VG_LITE_IRQ_CALLBACK */
 
+// added by MicroEJ
+/*
+ * @brief Enters a critical section protecting the data shared with the GPU
+ * interrupt handler (the command buffer queue)
+ */
+void vg_lite_hal_enter_critical(void);
+
+// added by MicroEJ
+/*
+ * @brief Exits the critical section entered with vg_lite_hal_enter_critical()
+ */
+void vg_lite_hal_exit_critical(void);
+
 #else
 vg_lite_error_t vg_lite_hal_initialize(void);
 #endif /* VG_DRIVER_SINGLE_THREAD */
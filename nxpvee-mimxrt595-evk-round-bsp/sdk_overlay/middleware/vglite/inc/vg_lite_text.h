@@ -41,6 +41,36 @@ extern "C" {
 #define VG_LITE_INVALID_FONT            (-1)
 #define INVALID_FONT_PROPERTY_IDX       (-1)
 
+/* Pixel formats of the intermediate buffer raster fonts are rendered into:
+ *   ARGB8888: glyphs pre-blended between bg_color and text_color.
+ *   A8, A4: alpha only, colorized with text_color by the GPU at blit time
+ *   (4 or 8 times less memory to fill and to fetch). */
+#define VG_LITE_TEXT_RASTER_ARGB8888    (0)
+#define VG_LITE_TEXT_RASTER_A8          (1)
+#define VG_LITE_TEXT_RASTER_A4          (2)
+
+#ifndef VG_LITE_TEXT_RASTER_FORMAT
+#define VG_LITE_TEXT_RASTER_FORMAT      VG_LITE_TEXT_RASTER_ARGB8888
+#endif
+
+/* Number of raster glyphs whose decoded spans are kept in cache (0 disables
+ * the cache). */
+#ifndef VG_LITE_TEXT_GLYPH_CACHE_SIZE
+#define VG_LITE_TEXT_GLYPH_CACHE_SIZE   (32)
+#endif
+
+/* Maximum number of spans of a cached glyph; glyphs with more spans (or
+ * larger than 256x256 pixels) are decoded each time they are drawn. */
+#ifndef VG_LITE_TEXT_GLYPH_CACHE_SPANS
+#define VG_LITE_TEXT_GLYPH_CACHE_SPANS  (96)
+#endif
+
+/* Number of glyphs remembered as not fitting in the cache: they are drawn
+ * without being recorded and do not evict cached glyphs. */
+#ifndef VG_LITE_TEXT_GLYPH_CACHE_UNCACHED
+#define VG_LITE_TEXT_GLYPH_CACHE_UNCACHED  (8)
+#endif
+
 /* Types **********************************************************************/
 
     /*!
@@ -117,6 +147,19 @@ extern "C" {
 
 /* Structures *****************************************************************/
 
+    /*!
+     @abstract Raster glyph cache statistics
+
+     @discussion
+     Counters of the raster glyph span cache used by
+     <code>vg_lite_draw_text</code>.
+     */
+    typedef struct vg_lite_text_glyph_cache_stats {
+        uint32_t hits;          /*! glyphs drawn from cached spans */
+        uint32_t misses;        /*! glyphs decoded and inserted in cache */
+        uint32_t overflows;     /*! glyphs drawn without cache (too complex) */
+    } vg_lite_text_glyph_cache_stats_t;
+
     /*!
      @abstract Font parameters 
 
@@ -360,6 +403,23 @@ extern "C" {
         eFontStyle_t   font_style,
         int font_height);
 
+    /*!
+     @abstract Drops all the raster glyphs kept in cache.
+
+     @discussion
+     Must be called when a raster font is unloaded: the cache entries are
+     keyed by font address.
+     */
+    void vg_lite_text_purge_glyph_cache(void);
+
+    /*!
+     @abstract Gets the raster glyph cache statistics.
+
+     @param stats
+     Pointer to the structure to fill.
+     */
+    void vg_lite_text_get_glyph_cache_stats(vg_lite_text_glyph_cache_stats_t *stats);
+
     /*!
      @abstract Initializes support for text drawing.
      */
@@ -0,0 +1,33 @@
+/*
+ * Copyright 2023 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package com.nxp.allocprofiler;
+
+/**
+ * Simulator implementation of the allocation profiler natives: no statistics are available.
+ */
+public class AllocProfilerNatives {
+
+	public static void start(int interval) {
+		// nothing to do
+	}
+
+	public static void stop() {
+		// nothing to do
+	}
+
+	public static void reset() {
+		// nothing to do
+	}
+
+	public static int getStats(long[] stats) {
+		return -1;
+	}
+
+	public static void dump() {
+		// nothing to do
+	}
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2023 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package com.nxp.jvmstats;
+
+/**
+ * Simulator implementation of the JVM statistics natives: no statistics are available.
+ */
+public class JvmStatsNatives {
+
+	public static int getThreadIds(int[] ids) {
+		return 0;
+	}
+
+	public static int getThreadStats(int threadId, long[] stats) {
+		return -1;
+	}
+
+	public static int getGcStats(long[] stats) {
+		return -1;
+	}
+
+	public static int getGcHistogram(int[] buckets) {
+		return 0;
+	}
+
+	public static int getWorstGcPauses(long[] durations, long[] times) {
+		return 0;
+	}
+
+	public static void reset() {
+		// nothing to do
+	}
+}
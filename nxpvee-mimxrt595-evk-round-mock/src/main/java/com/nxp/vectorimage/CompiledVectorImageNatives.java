@@ -0,0 +1,34 @@
+/*
+ * Copyright 2023 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package com.nxp.vectorimage;
+
+/**
+ * Simulator implementation of the compiled vector image natives: no image is compiled, the application draws the
+ * MicroVG images.
+ */
+public class CompiledVectorImageNatives {
+
+	public static int find(byte[] name) {
+		return -1;
+	}
+
+	public static float getWidth(int image) {
+		return 0;
+	}
+
+	public static float getHeight(int image) {
+		return 0;
+	}
+
+	public static int getDuration(int image) {
+		return 0;
+	}
+
+	public static int draw(byte[] gc, int x, int y, float[] matrix, int image, int elapsed, int alpha) {
+		return -1;
+	}
+}